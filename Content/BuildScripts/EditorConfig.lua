@@ -40,6 +40,8 @@ workspace "ShooterEngine"
     group "Tools"
         include "Module-Content"
         include "Module-Editor"
+        include "Module-LogDecoder"
+        include "Module-Tests"
     group "ThirdParty"
         include "Module-ImGui"
         include "Module-YamlCPP"
@@ -0,0 +1,35 @@
+--
+-- Copyright (c) 2024 Traian Avram. All rights reserved.
+-- SPDX-License-Identifier: Apache-2-0.
+--
+
+project "SE-LogDecoder"
+    location "%{wks.location}/Source/Tools/LogDecoder"
+    kind "ConsoleApp"
+    configure_default_settings()
+
+    begin_filter_configuration_editor()
+        kind "ConsoleApp"
+    end_filter()
+
+    begin_filter_configuration_game()
+        kind "None"
+    end_filter()
+
+    links
+    {
+        "SE-Engine"
+    }
+
+    files
+    {
+        "%{wks.location}/Source/Tools/LogDecoder/**.cpp",
+        "%{wks.location}/Source/Tools/LogDecoder/**.h"
+    }
+
+    includedirs
+    {
+        "%{wks.location}/Source/Tools/LogDecoder",
+        "%{wks.location}/Source/Runtime"
+    }
+-- endproject "SE-LogDecoder"
@@ -0,0 +1,46 @@
+--
+-- Copyright (c) 2024 Traian Avram. All rights reserved.
+-- SPDX-License-Identifier: Apache-2-0.
+--
+
+project "SE-Tests"
+    location "%{wks.location}/Source/Tests"
+    kind "ConsoleApp"
+    configure_default_settings()
+
+    begin_filter_configuration_editor()
+        kind "ConsoleApp"
+    end_filter()
+
+    begin_filter_configuration_game()
+        kind "None"
+    end_filter()
+
+    links
+    {
+        "SE-Engine",
+        "SE-YamlCPP"
+    }
+
+    files
+    {
+        "%{wks.location}/Source/Tests/**.cpp",
+        "%{wks.location}/Source/Tests/**.h",
+
+        -- The editor is an executable, so the editor sources that are tested are compiled as part of the tests.
+        "%{wks.location}/Source/Editor/Serialization/EditorSceneSerializer.cpp"
+    }
+
+    includedirs
+    {
+        "%{wks.location}/Source/Tests",
+        "%{wks.location}/Source/Runtime",
+        "%{wks.location}/Source/Editor",
+        "%{wks.location}/Source",
+
+        -- Third party includes.
+        "%{wks.location}/Source/ThirdParty/yaml-cpp/include"
+    }
+
+    defines { "YAML_CPP_STATIC_DEFINE" }
+-- endproject "SE-Tests"
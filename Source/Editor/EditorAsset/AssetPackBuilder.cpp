@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Asset/AssetPack.h>
+#include <Asset/TextureAsset.h>
+#include <Core/Containers/Vector.h>
+#include <Core/FileSystem/FileSystem.h>
+#include <Core/Log.h>
+#include <Core/Memory/Compression.h>
+#include <Core/Memory/MemoryOperations.h>
+#include <Core/String/StringBuilder.h>
+#include <EditorAsset/AssetPackBuilder.h>
+#include <EditorAsset/EditorAssetManager.h>
+#include <EditorAsset/TextureCooker.h>
+
+namespace SE
+{
+
+static u64 align_asset_pack_offset(u64 offset)
+{
+    return (offset + asset_pack_entry_alignment - 1) & ~(asset_pack_entry_alignment - 1);
+}
+
+bool AssetPackBuilder::build(const String& pack_filepath, const AssetPackBuildDescription& description)
+{
+    struct PackedAsset
+    {
+        AssetPackEntry entry;
+        String name;
+        // The data that is written to the pack, compressed or not, depending on the entry.
+        Buffer stored_data;
+    };
+    Vector<PackedAsset> packed_assets;
+
+    const Vector<AssetHandle> texture_handles = g_editor_asset_manager->get_asset_handles_of_type(AssetType::Texture);
+    for (const AssetHandle texture_handle : texture_handles)
+    {
+        const EditorAssetMetadata& metadata = g_editor_asset_manager->get_editor_metadata(texture_handle);
+        if (metadata.is_memory_only)
+            continue;
+
+        Buffer data;
+        if (!build_texture_entry_data(texture_handle, data))
+        {
+            SE_LOG_TAG_ERROR("Asset", "Failed to pack the texture '{}'!", metadata.filepath);
+            return false;
+        }
+
+        PackedAsset& packed_asset = packed_assets.emplace();
+        zero_memory(&packed_asset.entry, sizeof(AssetPackEntry));
+        packed_asset.entry.handle = texture_handle.value().value();
+        packed_asset.entry.type = AssetType::Texture;
+        packed_asset.entry.byte_count = data.byte_count();
+        packed_asset.name = metadata.filepath;
+
+        // NOTE: Uncompressed entries are read directly from the mapped file, so compressing an entry only pays off
+        //       if it reduces the number of bytes that have to be read from the disk significantly.
+        packed_asset.entry.compression = AssetPackCompression::None;
+        if (description.compress_entries && data.byte_count() > 0)
+        {
+            Buffer compressed_data = Buffer::create(get_lz4_max_compressed_byte_count(data.byte_count()));
+            const usize compressed_byte_count = compress_lz4(data.readonly_byte_span(), compressed_data.byte_span());
+            if (compressed_byte_count + compressed_byte_count / 8 < data.byte_count())
+            {
+                packed_asset.entry.compression = AssetPackCompression::LZ4;
+                data = Buffer::copy(compressed_data.bytes(), compressed_byte_count);
+            }
+        }
+
+        packed_asset.entry.stored_byte_count = data.byte_count();
+        packed_asset.stored_data = move(data);
+    }
+
+    packed_assets.sort(
+        [](const PackedAsset& lhs, const PackedAsset& rhs) -> ComparisonResult
+        {
+            if (lhs.entry.handle == rhs.entry.handle)
+                return ComparisonResult::Equal;
+            return (lhs.entry.handle < rhs.entry.handle) ? ComparisonResult::Less : ComparisonResult::Greater;
+        }
+    );
+
+    // The table of contents and the string table are placed right after the header, and the data of the entries after them.
+    AssetPackHeader header = {};
+    header.magic = asset_pack_magic;
+    header.version = asset_pack_version;
+    header.entry_count = static_cast<u32>(packed_assets.count());
+    header.toc_offset = sizeof(AssetPackHeader);
+    header.string_table_offset = header.toc_offset + packed_assets.count() * sizeof(AssetPackEntry);
+
+    u64 string_table_byte_count = 0;
+    for (PackedAsset& packed_asset : packed_assets)
+    {
+        packed_asset.entry.name_offset = static_cast<u32>(string_table_byte_count);
+        packed_asset.entry.name_byte_count = static_cast<u32>(packed_asset.name.byte_count());
+        string_table_byte_count += packed_asset.name.byte_count();
+    }
+    header.string_table_byte_count = string_table_byte_count;
+
+    u64 data_offset = align_asset_pack_offset(header.string_table_offset + header.string_table_byte_count);
+    for (PackedAsset& packed_asset : packed_assets)
+    {
+        packed_asset.entry.data_offset = data_offset;
+        data_offset = align_asset_pack_offset(data_offset + packed_asset.entry.stored_byte_count);
+    }
+
+    const String temporary_pack_filepath = StringBuilder::join({ pack_filepath.view(), ".tmp"sv });
+    FileWriter pack_file_writer;
+    if (pack_file_writer.open(temporary_pack_filepath) != FileError::Success)
+    {
+        SE_LOG_TAG_ERROR("Asset", "Failed to open the asset pack file '{}' for writing!", temporary_pack_filepath);
+        return false;
+    }
+
+    u8 padding[asset_pack_entry_alignment] = {};
+    u64 written_byte_count = 0;
+    auto write_bytes = [&](ReadonlyByteSpan bytes) -> bool
+    {
+        written_byte_count += bytes.count();
+        return (pack_file_writer.write(bytes) == FileError::Success);
+    };
+    auto write_padding = [&]() -> bool
+    {
+        const u64 padding_byte_count = align_asset_pack_offset(written_byte_count) - written_byte_count;
+        return write_bytes(ReadonlyByteSpan(padding, padding_byte_count));
+    };
+
+    bool has_written_pack = write_bytes(ReadonlyByteSpan(reinterpret_cast<ReadonlyBytes>(&header), sizeof(AssetPackHeader)));
+    for (const PackedAsset& packed_asset : packed_assets)
+        has_written_pack = has_written_pack && write_bytes(ReadonlyByteSpan(reinterpret_cast<ReadonlyBytes>(&packed_asset.entry), sizeof(AssetPackEntry)));
+    for (const PackedAsset& packed_asset : packed_assets)
+        has_written_pack = has_written_pack && write_bytes(packed_asset.name.byte_span());
+    for (const PackedAsset& packed_asset : packed_assets)
+    {
+        has_written_pack = has_written_pack && write_padding();
+        SE_ASSERT(!has_written_pack || written_byte_count == packed_asset.entry.data_offset);
+        has_written_pack = has_written_pack && write_bytes(packed_asset.stored_data.readonly_byte_span());
+    }
+    pack_file_writer.close();
+
+    if (!has_written_pack || !FileSystem::move_file(temporary_pack_filepath, pack_filepath))
+    {
+        SE_LOG_TAG_ERROR("Asset", "Failed to write the asset pack '{}'!", pack_filepath);
+        FileSystem::delete_file(temporary_pack_filepath);
+        return false;
+    }
+
+    SE_LOG_TAG_INFO("Asset", "Packed '{}' assets in '{}' ({} bytes).", packed_assets.count(), pack_filepath, written_byte_count);
+    return true;
+}
+
+bool AssetPackBuilder::build_texture_entry_data(AssetHandle texture_handle, Buffer& out_data)
+{
+    RefPtr<TextureAsset> texture_asset = g_asset_manager->get_asset_sync<TextureAsset>(texture_handle);
+    if (!texture_asset.is_valid())
+        return false;
+
+    //
+    // The pack stores the cooked texture, which is cooked now if it doesn't exist or is outdated.
+    // NOTE: The textures that are packed in an atlas in the editor are stored as individual textures, as the atlas
+    //       pages are not assets themselves.
+    //
+    const String& texture_filepath = texture_asset->get_texture_filepath();
+    if (TextureCooker::cook(texture_filepath, TextureCookDescription()) == TextureCookResult::Failed)
+        return false;
+
+    FileReader cooked_texture_file_reader;
+    if (cooked_texture_file_reader.open(TextureCooker::get_cooked_filepath(texture_filepath)) != FileError::Success)
+        return false;
+    return (cooked_texture_file_reader.read_entire_and_close(out_data) == FileError::Success);
+}
+
+} // namespace SE
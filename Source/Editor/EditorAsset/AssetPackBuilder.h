@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Asset/Asset.h>
+#include <Core/Memory/Buffer.h>
+#include <Core/String/String.h>
+
+namespace SE
+{
+
+struct AssetPackBuildDescription
+{
+    // Whether or not the entries are compressed. An entry is only stored compressed if that makes it significantly smaller.
+    bool compress_entries { true };
+};
+
+class AssetPackBuilder
+{
+public:
+    //
+    // Packs all the assets of the project (except the memory-only ones) in an asset pack, which can be loaded by the
+    // `PackedAssetManager`. The assets are stored in their runtime format (the textures are cooked, if they aren't already),
+    // so loading them from the pack doesn't require any processing. The pack is written to a temporary file first,
+    // which then replaces the given file, so a failed build never leaves a partially written pack behind.
+    //
+    static bool build(const String& pack_filepath, const AssetPackBuildDescription& description);
+
+private:
+    NODISCARD static bool build_texture_entry_data(AssetHandle texture_handle, Buffer& out_data);
+};
+
+} // namespace SE
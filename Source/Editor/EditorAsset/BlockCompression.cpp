@@ -0,0 +1,343 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/Assertions.h>
+#include <Core/Math/MathCore.h>
+#include <Core/Memory/MemoryOperations.h>
+#include <EditorAsset/BlockCompression.h>
+
+namespace SE
+{
+
+static constexpr u32 s_block_pixel_count = 16;
+
+//
+// Finds the segment that best fits the colors of the block, by projecting them on the principal axis of their
+// distribution. The axis is the dominant eigenvector of the covariance matrix, approximated via power iteration.
+// Only the first `channel_count` channels of the pixels are considered.
+//
+static void find_block_endpoints(ReadonlyBytes block_pixels, u32 channel_count, float* out_min_endpoint, float* out_max_endpoint)
+{
+    float mean[4] = {};
+    for (u32 pixel_index = 0; pixel_index < s_block_pixel_count; ++pixel_index)
+    {
+        for (u32 channel = 0; channel < channel_count; ++channel)
+            mean[channel] += static_cast<float>(block_pixels[4 * pixel_index + channel]);
+    }
+    for (u32 channel = 0; channel < channel_count; ++channel)
+        mean[channel] /= static_cast<float>(s_block_pixel_count);
+
+    float covariance[4][4] = {};
+    for (u32 pixel_index = 0; pixel_index < s_block_pixel_count; ++pixel_index)
+    {
+        float delta[4] = {};
+        for (u32 channel = 0; channel < channel_count; ++channel)
+            delta[channel] = static_cast<float>(block_pixels[4 * pixel_index + channel]) - mean[channel];
+
+        for (u32 row = 0; row < channel_count; ++row)
+        {
+            for (u32 column = 0; column < channel_count; ++column)
+                covariance[row][column] += delta[row] * delta[column];
+        }
+    }
+
+    // The iteration starts from the row of the channel with the largest variance, which is never orthogonal to the dominant eigenvector.
+    u32 largest_variance_channel = 0;
+    for (u32 channel = 1; channel < channel_count; ++channel)
+    {
+        if (covariance[channel][channel] > covariance[largest_variance_channel][largest_variance_channel])
+            largest_variance_channel = channel;
+    }
+
+    float axis[4] = {};
+    for (u32 channel = 0; channel < channel_count; ++channel)
+        axis[channel] = covariance[largest_variance_channel][channel];
+
+    for (u32 iteration = 0; iteration < 8; ++iteration)
+    {
+        float next_axis[4] = {};
+        float max_component = 0.0F;
+        for (u32 row = 0; row < channel_count; ++row)
+        {
+            for (u32 column = 0; column < channel_count; ++column)
+                next_axis[row] += covariance[row][column] * axis[column];
+            max_component = Math::max(max_component, (next_axis[row] < 0.0F) ? -next_axis[row] : next_axis[row]);
+        }
+
+        if (max_component == 0.0F)
+            break;
+        for (u32 channel = 0; channel < channel_count; ++channel)
+            axis[channel] = next_axis[channel] / max_component;
+    }
+
+    float axis_length_squared = 0.0F;
+    for (u32 channel = 0; channel < channel_count; ++channel)
+        axis_length_squared += axis[channel] * axis[channel];
+
+    // All the pixels of the block have the same color.
+    if (axis_length_squared == 0.0F)
+    {
+        for (u32 channel = 0; channel < channel_count; ++channel)
+        {
+            out_min_endpoint[channel] = mean[channel];
+            out_max_endpoint[channel] = mean[channel];
+        }
+        return;
+    }
+
+    float min_projection = 0.0F;
+    float max_projection = 0.0F;
+    for (u32 pixel_index = 0; pixel_index < s_block_pixel_count; ++pixel_index)
+    {
+        float projection = 0.0F;
+        for (u32 channel = 0; channel < channel_count; ++channel)
+            projection += (static_cast<float>(block_pixels[4 * pixel_index + channel]) - mean[channel]) * axis[channel];
+
+        min_projection = Math::min(min_projection, projection);
+        max_projection = Math::max(max_projection, projection);
+    }
+
+    for (u32 channel = 0; channel < channel_count; ++channel)
+    {
+        const float scale = axis[channel] / axis_length_squared;
+        out_min_endpoint[channel] = Math::clamp(mean[channel] + min_projection * scale, 0.0F, 255.0F);
+        out_max_endpoint[channel] = Math::clamp(mean[channel] + max_projection * scale, 0.0F, 255.0F);
+    }
+}
+
+// Returns the index of the palette entry that is the closest to the given pixel.
+static u32 find_closest_palette_index(ReadonlyBytes pixel, const i32 (*palette)[4], u32 palette_entry_count, u32 channel_count)
+{
+    u32 closest_index = 0;
+    i32 closest_distance = 0x7FFFFFFF;
+    for (u32 palette_index = 0; palette_index < palette_entry_count; ++palette_index)
+    {
+        i32 distance = 0;
+        for (u32 channel = 0; channel < channel_count; ++channel)
+        {
+            const i32 delta = static_cast<i32>(pixel[channel]) - palette[palette_index][channel];
+            distance += delta * delta;
+        }
+
+        if (distance < closest_distance)
+        {
+            closest_distance = distance;
+            closest_index = palette_index;
+        }
+    }
+    return closest_index;
+}
+
+//==============================================================================================================
+// BC1.
+//==============================================================================================================
+
+NODISCARD ALWAYS_INLINE static u16 pack_rgb565(const float* color)
+{
+    const u32 red = static_cast<u32>(color[0] * (31.0F / 255.0F) + 0.5F);
+    const u32 green = static_cast<u32>(color[1] * (63.0F / 255.0F) + 0.5F);
+    const u32 blue = static_cast<u32>(color[2] * (31.0F / 255.0F) + 0.5F);
+    return static_cast<u16>((red << 11) | (green << 5) | blue);
+}
+
+ALWAYS_INLINE static void unpack_rgb565(u16 packed_color, i32* out_color)
+{
+    const i32 red = (packed_color >> 11) & 0x1F;
+    const i32 green = (packed_color >> 5) & 0x3F;
+    const i32 blue = packed_color & 0x1F;
+    out_color[0] = (red << 3) | (red >> 2);
+    out_color[1] = (green << 2) | (green >> 4);
+    out_color[2] = (blue << 3) | (blue >> 2);
+    out_color[3] = 255;
+}
+
+void compress_bc1_block(ReadonlyBytes block_pixels, WriteonlyBytes out_block)
+{
+    float min_endpoint[3];
+    float max_endpoint[3];
+    find_block_endpoints(block_pixels, 3, min_endpoint, max_endpoint);
+
+    u16 color_0 = pack_rgb565(max_endpoint);
+    u16 color_1 = pack_rgb565(min_endpoint);
+    // The first color must be larger than the second one, otherwise the block is decoded in the 3-color (punch-through alpha) mode.
+    if (color_0 < color_1)
+    {
+        const u16 temporary = color_0;
+        color_0 = color_1;
+        color_1 = temporary;
+    }
+
+    u32 indices = 0;
+    if (color_0 != color_1)
+    {
+        i32 palette[4][4];
+        unpack_rgb565(color_0, palette[0]);
+        unpack_rgb565(color_1, palette[1]);
+        for (u32 channel = 0; channel < 3; ++channel)
+        {
+            palette[2][channel] = (2 * palette[0][channel] + palette[1][channel]) / 3;
+            palette[3][channel] = (palette[0][channel] + 2 * palette[1][channel]) / 3;
+        }
+
+        for (u32 pixel_index = 0; pixel_index < s_block_pixel_count; ++pixel_index)
+            indices |= find_closest_palette_index(block_pixels + 4 * pixel_index, palette, 4, 3) << (2 * pixel_index);
+    }
+
+    copy_memory(out_block + 0, &color_0, sizeof(u16));
+    copy_memory(out_block + 2, &color_1, sizeof(u16));
+    copy_memory(out_block + 4, &indices, sizeof(u32));
+}
+
+//==============================================================================================================
+// BC3.
+//==============================================================================================================
+
+// Encodes the alpha channel of the pixels as a BC4 block, always using the 8-value interpolation mode.
+static void compress_bc4_alpha_block(ReadonlyBytes block_pixels, WriteonlyBytes out_block)
+{
+    u8 max_alpha = 0;
+    u8 min_alpha = 255;
+    for (u32 pixel_index = 0; pixel_index < s_block_pixel_count; ++pixel_index)
+    {
+        max_alpha = Math::max(max_alpha, block_pixels[4 * pixel_index + 3]);
+        min_alpha = Math::min(min_alpha, block_pixels[4 * pixel_index + 3]);
+    }
+
+    u64 indices = 0;
+    if (max_alpha != min_alpha)
+    {
+        i32 palette[8][4] = {};
+        palette[0][0] = max_alpha;
+        palette[1][0] = min_alpha;
+        for (u32 palette_index = 2; palette_index < 8; ++palette_index)
+            palette[palette_index][0] = ((8 - palette_index) * max_alpha + (palette_index - 1) * min_alpha) / 7;
+
+        for (u32 pixel_index = 0; pixel_index < s_block_pixel_count; ++pixel_index)
+        {
+            const u64 index = find_closest_palette_index(block_pixels + 4 * pixel_index + 3, palette, 8, 1);
+            indices |= index << (3 * pixel_index);
+        }
+    }
+
+    out_block[0] = max_alpha;
+    out_block[1] = min_alpha;
+    // The 48 bits of indices are stored in little-endian order.
+    for (u32 byte_index = 0; byte_index < 6; ++byte_index)
+        out_block[2 + byte_index] = static_cast<u8>((indices >> (8 * byte_index)) & 0xFF);
+}
+
+void compress_bc3_block(ReadonlyBytes block_pixels, WriteonlyBytes out_block)
+{
+    compress_bc4_alpha_block(block_pixels, out_block);
+    // NOTE: The color block of BC3 is always decoded in the 4-color mode, so the endpoints ordering of BC1 is not required,
+    //       but it doesn't affect the quality either.
+    compress_bc1_block(block_pixels, out_block + 8);
+}
+
+//==============================================================================================================
+// BC7.
+//==============================================================================================================
+
+// Packs the fields of a BC7 block, starting from the least significant bit of the first byte.
+struct BC7BlockWriter
+{
+    u64 bits[2] = {};
+    u32 bit_offset = 0;
+
+    void write(u32 value, u32 bit_count)
+    {
+        for (u32 bit_index = 0; bit_index < bit_count; ++bit_index, ++bit_offset)
+            bits[bit_offset / 64] |= static_cast<u64>((value >> bit_index) & 1) << (bit_offset % 64);
+    }
+};
+
+static constexpr i32 s_bc7_4bit_index_weights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+//
+// Quantizes an endpoint to the 7 bits per channel and the shared p-bit of mode 6. Both values of the p-bit are tried,
+// and the one that reconstructs the endpoint with the smallest error is kept.
+//
+static void quantize_bc7_mode_6_endpoint(const float* endpoint, u32* out_quantized_endpoint, u32& out_p_bit, i32* out_reconstructed_endpoint)
+{
+    float smallest_error = 0.0F;
+    for (u32 p_bit = 0; p_bit < 2; ++p_bit)
+    {
+        u32 quantized_endpoint[4];
+        float error = 0.0F;
+        for (u32 channel = 0; channel < 4; ++channel)
+        {
+            const float quantized_value = (endpoint[channel] - static_cast<float>(p_bit)) * 0.5F + 0.5F;
+            quantized_endpoint[channel] = static_cast<u32>(Math::clamp(quantized_value, 0.0F, 127.0F));
+            const float delta = static_cast<float>((quantized_endpoint[channel] << 1) | p_bit) - endpoint[channel];
+            error += delta * delta;
+        }
+
+        if (p_bit == 0 || error < smallest_error)
+        {
+            smallest_error = error;
+            out_p_bit = p_bit;
+            for (u32 channel = 0; channel < 4; ++channel)
+            {
+                out_quantized_endpoint[channel] = quantized_endpoint[channel];
+                out_reconstructed_endpoint[channel] = static_cast<i32>((quantized_endpoint[channel] << 1) | p_bit);
+            }
+        }
+    }
+}
+
+void compress_bc7_block(ReadonlyBytes block_pixels, WriteonlyBytes out_block)
+{
+    float min_endpoint[4];
+    float max_endpoint[4];
+    find_block_endpoints(block_pixels, 4, min_endpoint, max_endpoint);
+
+    u32 quantized_endpoints[2][4];
+    u32 p_bits[2];
+    i32 reconstructed_endpoints[2][4];
+    quantize_bc7_mode_6_endpoint(min_endpoint, quantized_endpoints[0], p_bits[0], reconstructed_endpoints[0]);
+    quantize_bc7_mode_6_endpoint(max_endpoint, quantized_endpoints[1], p_bits[1], reconstructed_endpoints[1]);
+
+    i32 palette[16][4];
+    for (u32 palette_index = 0; palette_index < 16; ++palette_index)
+    {
+        const i32 weight = s_bc7_4bit_index_weights[palette_index];
+        for (u32 channel = 0; channel < 4; ++channel)
+            palette[palette_index][channel] = ((64 - weight) * reconstructed_endpoints[0][channel] + weight * reconstructed_endpoints[1][channel] + 32) >> 6;
+    }
+
+    u32 indices[s_block_pixel_count];
+    for (u32 pixel_index = 0; pixel_index < s_block_pixel_count; ++pixel_index)
+        indices[pixel_index] = find_closest_palette_index(block_pixels + 4 * pixel_index, palette, 16, 4);
+
+    // The most significant bit of the index of the first pixel (the anchor) is not stored, so it must be zero.
+    // Swapping the endpoints and inverting the indices produces the same block.
+    const u32 first_endpoint = (indices[0] >= 8) ? 1 : 0;
+    const u32 second_endpoint = 1 - first_endpoint;
+    if (first_endpoint == 1)
+    {
+        for (u32 pixel_index = 0; pixel_index < s_block_pixel_count; ++pixel_index)
+            indices[pixel_index] = 15 - indices[pixel_index];
+    }
+
+    BC7BlockWriter block_writer;
+    // Mode 6 is identified by 6 zero bits followed by a one bit.
+    block_writer.write(1 << 6, 7);
+    for (u32 channel = 0; channel < 4; ++channel)
+    {
+        block_writer.write(quantized_endpoints[first_endpoint][channel], 7);
+        block_writer.write(quantized_endpoints[second_endpoint][channel], 7);
+    }
+    block_writer.write(p_bits[first_endpoint], 1);
+    block_writer.write(p_bits[second_endpoint], 1);
+
+    block_writer.write(indices[0], 3);
+    for (u32 pixel_index = 1; pixel_index < s_block_pixel_count; ++pixel_index)
+        block_writer.write(indices[pixel_index], 4);
+
+    SE_ASSERT(block_writer.bit_offset == 128);
+    copy_memory(out_block, block_writer.bits, sizeof(block_writer.bits));
+}
+
+} // namespace SE
@@ -0,0 +1,31 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/CoreTypes.h>
+
+namespace SE
+{
+
+//
+// Encoders for the block compressed image formats. Each function compresses a block of 4x4 pixels, given as 16 RGBA8
+// pixels (64 bytes) in row-major order, and writes the encoded block to the given output.
+// https://learn.microsoft.com/en-us/windows/win32/direct3d11/texture-block-compression-in-direct3d-11
+//
+
+// Writes 8 bytes. The alpha channel of the pixels is ignored.
+void compress_bc1_block(ReadonlyBytes block_pixels, WriteonlyBytes out_block);
+
+// Writes 16 bytes: the alpha channel is encoded as a BC4 block, followed by the color channels encoded as a BC1 block.
+void compress_bc3_block(ReadonlyBytes block_pixels, WriteonlyBytes out_block);
+
+//
+// Writes 16 bytes. Only mode 6 of the format (a single subset, with RGBA endpoints and 4-bit indices) is used, as it
+// handles both opaque and transparent blocks with a quality close to the other modes, at a fraction of the encoding cost.
+//
+void compress_bc7_block(ReadonlyBytes block_pixels, WriteonlyBytes out_block);
+
+} // namespace SE
@@ -0,0 +1,407 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/Containers/Hash.h>
+#include <Core/Containers/Vector.h>
+#include <Core/FileSystem/FileSystem.h>
+#include <Core/Log.h>
+#include <Core/Memory/Compression.h>
+#include <Core/Memory/MemoryOperations.h>
+#include <Core/Platform/Thread.h>
+#include <Core/String/Format.h>
+#include <Core/String/StringBuilder.h>
+#include <EditorAsset/DerivedDataCache.h>
+
+namespace SE
+{
+
+// The characters 'SEDD' interpreted as a little-endian integer.
+static constexpr u32 derived_data_entry_magic = 0x44444553;
+static constexpr u32 derived_data_entry_version = 1;
+
+// The characters 'SEDI' interpreted as a little-endian integer.
+static constexpr u32 derived_data_index_magic = 0x49444553;
+static constexpr u32 derived_data_index_version = 1;
+
+struct DerivedDataEntryHeader
+{
+    u32 magic;
+    u32 version;
+    // The key of the entry, which is also encoded in the name of its file.
+    u64 key;
+    // The hash of the uncompressed data, which is used to detect corrupted entries.
+    u64 data_hash;
+    // The number of bytes of the uncompressed data.
+    u64 byte_count;
+    // The number of bytes that are stored after the header. If it differs from the byte count the data is LZ4-compressed.
+    u64 stored_byte_count;
+};
+static_assert(sizeof(DerivedDataEntryHeader) == 40);
+
+struct DerivedDataIndexHeader
+{
+    u32 magic;
+    u32 version;
+    u64 access_clock;
+    u64 entry_count;
+};
+static_assert(sizeof(DerivedDataIndexHeader) == 24);
+
+struct DerivedDataIndexEntry
+{
+    u64 key;
+    u64 file_byte_count;
+    u64 last_access;
+};
+static_assert(sizeof(DerivedDataIndexEntry) == 24);
+
+bool DerivedDataCache::initialize(const String& cache_directory, u64 max_byte_count)
+{
+    SE_ASSERT(!m_is_initialized);
+    m_cache_directory = cache_directory;
+    m_max_byte_count = max_byte_count;
+    m_total_byte_count = 0;
+    m_access_clock = 0;
+    m_entries.clear();
+
+    read_index();
+    m_is_initialized = true;
+
+    SE_LOG_TAG_INFO("Asset", "The derived-data cache contains '{}' entries ({} bytes).", m_entries.count(), m_total_byte_count);
+    return true;
+}
+
+void DerivedDataCache::shutdown()
+{
+    if (!m_is_initialized)
+        return;
+
+    write_index();
+    m_entries.clear_and_shrink();
+    m_is_initialized = false;
+}
+
+u64 DerivedDataCache::make_key(StringView builder_name, u32 builder_version, ReadonlyByteSpan build_settings, ReadonlyByteSpan source_bytes)
+{
+    u64 key = hash_memory(builder_name.byte_span(), builder_version);
+    key = hash_memory(build_settings, key);
+    key = hash_memory(source_bytes, key);
+    return key;
+}
+
+bool DerivedDataCache::get_or_build(u64 key, PFN_DerivedDataBuilder builder, Buffer& out_data)
+{
+    SE_ASSERT(m_is_initialized);
+
+    u64 file_byte_count;
+    if (read_entry(key, out_data, file_byte_count))
+    {
+        touch_entry(key, file_byte_count);
+        return true;
+    }
+
+    // The entry is either missing or corrupted, so its file (if any) is no longer tracked.
+    remove_entry(key);
+
+    out_data.release();
+    if (!builder(out_data))
+        return false;
+
+    // NOTE: Failing to store the entry is not an error, as the data has been built successfully. It will
+    //       simply be built again the next time it is requested.
+    if (write_entry(key, out_data.readonly_byte_span(), file_byte_count))
+    {
+        touch_entry(key, file_byte_count);
+        evict_least_recently_used_entries();
+    }
+
+    return true;
+}
+
+String DerivedDataCache::get_entry_filepath(u64 key) const
+{
+    // The name of the file is the key, written in hexadecimal.
+    char key_characters[16];
+    for (u32 digit_index = 0; digit_index < 16; ++digit_index)
+    {
+        const u8 digit = static_cast<u8>((key >> (60 - 4 * digit_index)) & 0xF);
+        key_characters[digit_index] = static_cast<char>((digit < 10) ? ('0' + digit) : ('A' + digit - 10));
+    }
+
+    const StringView key_string = StringView::unsafe_create_from_utf8(key_characters, sizeof(key_characters));
+    return StringBuilder::path_join({ m_cache_directory.view(), key_string });
+}
+
+String DerivedDataCache::get_index_filepath() const
+{
+    return StringBuilder::path_join({ m_cache_directory.view(), "DerivedDataIndex"sv });
+}
+
+bool DerivedDataCache::read_entry(u64 key, Buffer& out_data, u64& out_file_byte_count)
+{
+    const String entry_filepath = get_entry_filepath(key);
+    if (!FileSystem::exists(entry_filepath))
+        return false;
+
+    FileReader entry_file_reader;
+    Buffer entry_file;
+    if (entry_file_reader.open(entry_filepath) != FileError::Success)
+        return false;
+    if (entry_file_reader.read_entire_and_close(entry_file) != FileError::Success)
+        return false;
+
+    if (entry_file.byte_count() < sizeof(DerivedDataEntryHeader))
+        return false;
+
+    DerivedDataEntryHeader header;
+    copy_memory(&header, entry_file.bytes(), sizeof(DerivedDataEntryHeader));
+    if (header.magic != derived_data_entry_magic || header.version != derived_data_entry_version || header.key != key)
+        return false;
+    if (entry_file.byte_count() != sizeof(DerivedDataEntryHeader) + header.stored_byte_count)
+        return false;
+
+    const ReadonlyByteSpan stored_data = entry_file.readonly_byte_span().slice(sizeof(DerivedDataEntryHeader), header.stored_byte_count);
+    if (header.stored_byte_count == header.byte_count)
+    {
+        out_data = Buffer::copy(stored_data.elements(), stored_data.count());
+    }
+    else
+    {
+        out_data = Buffer::create(header.byte_count);
+        if (!decompress_lz4(stored_data, out_data.byte_span()))
+            return false;
+    }
+
+    if (hash_memory(out_data.readonly_byte_span()) != header.data_hash)
+    {
+        SE_LOG_TAG_WARN("Asset", "The derived-data cache entry '{}' is corrupted and will be rebuilt.", entry_filepath);
+        return false;
+    }
+
+    out_file_byte_count = entry_file.byte_count();
+    return true;
+}
+
+bool DerivedDataCache::write_entry(u64 key, ReadonlyByteSpan data, u64& out_file_byte_count)
+{
+    DerivedDataEntryHeader header = {};
+    header.magic = derived_data_entry_magic;
+    header.version = derived_data_entry_version;
+    header.key = key;
+    header.data_hash = hash_memory(data);
+    header.byte_count = data.count();
+    header.stored_byte_count = data.count();
+
+    // The data is only stored compressed if that makes the entry significantly smaller.
+    Buffer compressed_data;
+    ReadonlyByteSpan stored_data = data;
+    if (data.count() > 0)
+    {
+        compressed_data = Buffer::create(get_lz4_max_compressed_byte_count(data.count()));
+        const usize compressed_byte_count = compress_lz4(data, compressed_data.byte_span());
+        if (compressed_byte_count + compressed_byte_count / 8 < data.count())
+        {
+            header.stored_byte_count = compressed_byte_count;
+            stored_data = compressed_data.readonly_byte_span().slice(0, compressed_byte_count);
+        }
+    }
+
+    // NOTE: Multiple threads might build the same entry at the same time, so each of them writes its own temporary file.
+    const String entry_filepath = get_entry_filepath(key);
+    Optional<String> optional_temporary_entry_filepath = format("{}.{}.tmp"sv, entry_filepath, Thread::get_current_thread_id());
+    SE_ASSERT(optional_temporary_entry_filepath.has_value());
+    const String& temporary_entry_filepath = optional_temporary_entry_filepath.value();
+
+    FileWriter entry_file_writer;
+    if (entry_file_writer.open(temporary_entry_filepath) != FileError::Success)
+    {
+        SE_LOG_TAG_WARN("Asset", "Failed to open the derived-data cache entry '{}' for writing!", temporary_entry_filepath);
+        return false;
+    }
+
+    bool has_written_entry = (entry_file_writer.write(ReadonlyByteSpan(reinterpret_cast<ReadonlyBytes>(&header), sizeof(header))) == FileError::Success);
+    has_written_entry = has_written_entry && (entry_file_writer.write(stored_data) == FileError::Success);
+    entry_file_writer.close();
+
+    if (!has_written_entry || !FileSystem::move_file(temporary_entry_filepath, entry_filepath))
+    {
+        SE_LOG_TAG_WARN("Asset", "Failed to write the derived-data cache entry '{}'!", entry_filepath);
+        FileSystem::delete_file(temporary_entry_filepath);
+        return false;
+    }
+
+    out_file_byte_count = sizeof(DerivedDataEntryHeader) + stored_data.count();
+    return true;
+}
+
+void DerivedDataCache::touch_entry(u64 key, u64 file_byte_count)
+{
+    ScopedLock lock(m_entries_mutex);
+
+    Optional<Entry&> optional_entry = m_entries.get_if_exists(key);
+    if (optional_entry.has_value())
+    {
+        Entry& entry = optional_entry.value();
+        m_total_byte_count -= entry.file_byte_count;
+        entry.file_byte_count = file_byte_count;
+        entry.last_access = ++m_access_clock;
+    }
+    else
+    {
+        Entry entry;
+        entry.file_byte_count = file_byte_count;
+        entry.last_access = ++m_access_clock;
+        m_entries.add(key, entry);
+    }
+
+    m_total_byte_count += file_byte_count;
+}
+
+void DerivedDataCache::remove_entry(u64 key)
+{
+    {
+        ScopedLock lock(m_entries_mutex);
+        Optional<Entry&> optional_entry = m_entries.get_if_exists(key);
+        if (optional_entry.has_value())
+        {
+            m_total_byte_count -= optional_entry.value().file_byte_count;
+            m_entries.remove(key);
+        }
+    }
+
+    const String entry_filepath = get_entry_filepath(key);
+    if (FileSystem::exists(entry_filepath))
+        FileSystem::delete_file(entry_filepath);
+}
+
+void DerivedDataCache::evict_least_recently_used_entries()
+{
+    //
+    // The entries are evicted until the cache is a bit smaller than its maximum size, so the eviction doesn't
+    // run again every time a new entry is written.
+    // NOTE: The cache contains at most a few thousand entries, so sorting them by their last access would
+    //       cost more than the linear searches, as only a handful of entries are evicted at once.
+    //
+    Vector<u64> evicted_keys;
+    {
+        ScopedLock lock(m_entries_mutex);
+        if (m_total_byte_count <= m_max_byte_count)
+            return;
+
+        const u64 target_byte_count = m_max_byte_count - m_max_byte_count / 10;
+        while (m_total_byte_count > target_byte_count && m_entries.count() > 0)
+        {
+            u64 least_recently_used_key = 0;
+            u64 least_recent_access = ~0ULL;
+            for (const auto& bucket : m_entries)
+            {
+                if (bucket.value.last_access < least_recent_access)
+                {
+                    least_recently_used_key = bucket.key;
+                    least_recent_access = bucket.value.last_access;
+                }
+            }
+
+            m_total_byte_count -= m_entries.at(least_recently_used_key).file_byte_count;
+            m_entries.remove(least_recently_used_key);
+            evicted_keys.add(least_recently_used_key);
+        }
+    }
+
+    // The files are deleted after the entries are removed, so the other threads don't wait for the file system.
+    for (const u64 evicted_key : evicted_keys)
+        FileSystem::delete_file(get_entry_filepath(evicted_key));
+
+    SE_LOG_TAG_INFO("Asset", "Evicted '{}' entries from the derived-data cache.", evicted_keys.count());
+}
+
+void DerivedDataCache::read_index()
+{
+    const String index_filepath = get_index_filepath();
+    if (!FileSystem::exists(index_filepath))
+        return;
+
+    FileReader index_file_reader;
+    Buffer index_file;
+    if (index_file_reader.open(index_filepath) != FileError::Success)
+        return;
+    if (index_file_reader.read_entire_and_close(index_file) != FileError::Success)
+        return;
+
+    if (index_file.byte_count() < sizeof(DerivedDataIndexHeader))
+        return;
+
+    DerivedDataIndexHeader header;
+    copy_memory(&header, index_file.bytes(), sizeof(DerivedDataIndexHeader));
+    if (header.magic != derived_data_index_magic || header.version != derived_data_index_version)
+        return;
+    if (index_file.byte_count() != sizeof(DerivedDataIndexHeader) + header.entry_count * sizeof(DerivedDataIndexEntry))
+        return;
+
+    //
+    // The index is only a record of the sizes and access order of the entries, so losing it (or an entry missing
+    // from it) is not an error. The files of the entries that are not in the index are tracked again as soon as they
+    // are accessed, and the entries whose files no longer exist are removed when they are requested.
+    //
+    m_entries.reserve(header.entry_count);
+    m_access_clock = header.access_clock;
+    for (u64 entry_index = 0; entry_index < header.entry_count; ++entry_index)
+    {
+        const u64 index_entry_offset = sizeof(DerivedDataIndexHeader) + entry_index * sizeof(DerivedDataIndexEntry);
+        DerivedDataIndexEntry index_entry;
+        copy_memory(&index_entry, index_file.bytes() + index_entry_offset, sizeof(DerivedDataIndexEntry));
+        if (m_entries.get_if_exists(index_entry.key).has_value())
+            continue;
+
+        Entry entry;
+        entry.file_byte_count = index_entry.file_byte_count;
+        entry.last_access = index_entry.last_access;
+        m_entries.add(index_entry.key, entry);
+        m_total_byte_count += entry.file_byte_count;
+    }
+}
+
+void DerivedDataCache::write_index()
+{
+    DerivedDataIndexHeader header = {};
+    header.magic = derived_data_index_magic;
+    header.version = derived_data_index_version;
+    header.access_clock = m_access_clock;
+    header.entry_count = m_entries.count();
+
+    Vector<DerivedDataIndexEntry> index_entries;
+    index_entries.set_fixed_capacity(m_entries.count());
+    for (const auto& bucket : m_entries)
+    {
+        DerivedDataIndexEntry& index_entry = index_entries.emplace();
+        index_entry.key = bucket.key;
+        index_entry.file_byte_count = bucket.value.file_byte_count;
+        index_entry.last_access = bucket.value.last_access;
+    }
+
+    const String index_filepath = get_index_filepath();
+    const String temporary_index_filepath = StringBuilder::join({ index_filepath.view(), ".tmp"sv });
+
+    FileWriter index_file_writer;
+    if (index_file_writer.open(temporary_index_filepath) != FileError::Success)
+    {
+        SE_LOG_TAG_WARN("Asset", "Failed to open the derived-data cache index '{}' for writing!", temporary_index_filepath);
+        return;
+    }
+
+    const ReadonlyByteSpan index_entry_bytes =
+        ReadonlyByteSpan(reinterpret_cast<ReadonlyBytes>(index_entries.elements()), index_entries.count() * sizeof(DerivedDataIndexEntry));
+    bool has_written_index = (index_file_writer.write(ReadonlyByteSpan(reinterpret_cast<ReadonlyBytes>(&header), sizeof(header))) == FileError::Success);
+    has_written_index = has_written_index && (index_file_writer.write(index_entry_bytes) == FileError::Success);
+    index_file_writer.close();
+
+    if (!has_written_index || !FileSystem::move_file(temporary_index_filepath, index_filepath))
+    {
+        SE_LOG_TAG_WARN("Asset", "Failed to write the derived-data cache index '{}'!", index_filepath);
+        FileSystem::delete_file(temporary_index_filepath);
+    }
+}
+
+} // namespace SE
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/Containers/Function.h>
+#include <Core/Containers/HashMap.h>
+#include <Core/Containers/Span.h>
+#include <Core/Memory/Buffer.h>
+#include <Core/Platform/Thread.h>
+#include <Core/String/String.h>
+
+namespace SE
+{
+
+// Builds the derived data of an entry that is not in the cache. Returns false if the data can't be built.
+using PFN_DerivedDataBuilder = Function<bool(Buffer& out_data)>;
+
+//
+// Local cache of the data that is derived from the source files of the project (such as the decoded pixels of an image),
+// so that work is done only once for each version of a source file. The entries are addressed by their content: the key
+// is a hash of the source bytes, of the version of the code that builds the entry and of the settings used to build it,
+// so changing any of them results in a different entry and the cache never has to be invalidated explicitly.
+//
+// Each entry is stored in its own file, which is written to a temporary file first and then moved in place, so an entry is
+// either complete or missing. When the cache exceeds its maximum size, the least recently used entries are deleted.
+//
+// NOTE: Entries can be requested by multiple threads at the same time, but `initialize` and `shutdown` must only be
+//       called by the main thread, while no other thread is using the cache.
+//
+class DerivedDataCache
+{
+    SE_MAKE_NONCOPYABLE(DerivedDataCache);
+    SE_MAKE_NONMOVABLE(DerivedDataCache);
+
+public:
+    static constexpr u64 default_max_byte_count = 2ULL * 1024 * 1024 * 1024;
+
+public:
+    DerivedDataCache() = default;
+
+    bool initialize(const String& cache_directory, u64 max_byte_count = default_max_byte_count);
+    void shutdown();
+
+    //
+    // Calculates the key of an entry. The name and version identify the code that builds the entry, and the version must
+    // be incremented every time the format or the content of the entry changes.
+    //
+    NODISCARD static u64 make_key(StringView builder_name, u32 builder_version, ReadonlyByteSpan build_settings, ReadonlyByteSpan source_bytes);
+
+    //
+    // Returns the data of the entry with the given key. If the entry is not in the cache (or its file is corrupted) the
+    // builder is invoked and the built data is stored in the cache. Returns false only if the builder fails.
+    //
+    bool get_or_build(u64 key, PFN_DerivedDataBuilder builder, Buffer& out_data);
+
+private:
+    struct Entry
+    {
+        // The number of bytes occupied on the disk by the file of the entry.
+        u64 file_byte_count;
+        // The value of the access clock when the entry was last used.
+        u64 last_access;
+    };
+
+    NODISCARD String get_entry_filepath(u64 key) const;
+    NODISCARD String get_index_filepath() const;
+
+    bool read_entry(u64 key, Buffer& out_data, u64& out_file_byte_count);
+    bool write_entry(u64 key, ReadonlyByteSpan data, u64& out_file_byte_count);
+
+    void touch_entry(u64 key, u64 file_byte_count);
+    void remove_entry(u64 key);
+    void evict_least_recently_used_entries();
+
+    void read_index();
+    void write_index();
+
+private:
+    String m_cache_directory;
+    u64 m_max_byte_count { 0 };
+    u64 m_total_byte_count { 0 };
+    // Incremented on every access, so the order of the accesses is preserved between editor sessions.
+    u64 m_access_clock { 0 };
+    HashMap<u64, Entry> m_entries;
+    // Protects the entries, their total size and the access clock.
+    Mutex m_entries_mutex;
+    bool m_is_initialized { false };
+};
+
+} // namespace SE
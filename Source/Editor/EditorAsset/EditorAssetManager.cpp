@@ -3,8 +3,13 @@
  * SPDX-License-Identifier: Apache-2.0.
  */
 
+#include <Core/Containers/Hash.h>
 #include <Core/FileSystem/FileSystem.h>
 #include <Core/Log.h>
+#include <Core/Math/MathCore.h>
+#include <Core/Memory/MemoryOperations.h>
+#include <Core/Platform/Atomic.h>
+#include <Core/Platform/Thread.h>
 #include <Core/String/StringBuilder.h>
 #include <EditorAsset/EditorAssetManager.h>
 #include <EditorAsset/TextureSerializer.h>
@@ -21,6 +26,10 @@ bool EditorAssetManager::initialize()
     SE_ASSERT(g_editor_asset_manager == nullptr);
     g_editor_asset_manager = static_cast<EditorAssetManager*>(g_asset_manager);
 
+    const String derived_data_cache_directory =
+        StringBuilder::path_join({ g_editor_engine->context().get_project_root_directory().view(), "Intermediate"sv, "DDC"sv });
+    m_derived_data_cache.initialize(derived_data_cache_directory);
+
     initialize_asset_registry();
     initialize_asset_serializers();
 
@@ -38,6 +47,7 @@ void EditorAssetManager::shutdown()
 
     m_asset_serializers.clear_and_shrink();
     m_asset_registry.clear_and_shrink();
+    m_derived_data_cache.shutdown();
 
     g_editor_asset_manager = nullptr;
     // Required by the AssetManager specification.
@@ -46,6 +56,42 @@ void EditorAssetManager::shutdown()
 
 #define SE_ASSET_REGISTRY_FILENAME "AssetRegistry.se"sv
 
+// The characters 'SEAR' interpreted as a little-endian integer.
+static constexpr u32 asset_registry_index_magic = 0x52414553;
+static constexpr u32 asset_registry_index_version = 1;
+
+//
+// The binary index of the asset registry consists of the header, followed by the handles of the assets (sorted in
+// ascending order), the locations of their filepaths in the string table, their types and the string table itself.
+//
+struct AssetRegistryIndexHeader
+{
+    u32 magic;
+    u32 version;
+    u32 asset_count;
+    u32 reserved;
+    // The last write time, size and hash of the registry file the index was built from.
+    u64 registry_last_write_time;
+    u64 registry_byte_count;
+    u64 registry_hash;
+    // The hash of everything that follows the header, which is used to detect corrupted indices.
+    u64 content_hash;
+    u64 string_table_byte_count;
+};
+static_assert(sizeof(AssetRegistryIndexHeader) == 56);
+
+struct AssetRegistryIndexFilepath
+{
+    u32 offset;
+    u32 byte_count;
+};
+
+static u64 get_asset_registry_index_byte_count(u64 asset_count, u64 string_table_byte_count)
+{
+    const u64 asset_byte_count = sizeof(u64) + sizeof(AssetRegistryIndexFilepath) + sizeof(u8);
+    return sizeof(AssetRegistryIndexHeader) + asset_count * asset_byte_count + string_table_byte_count;
+}
+
 bool EditorAssetManager::initialize_asset_registry()
 {
     m_asset_registry.clear();
@@ -68,6 +114,11 @@ String EditorAssetManager::get_asset_registry_filepath()
     return StringBuilder::path_join({ g_editor_engine->context().get_project_root_directory().view(), SE_ASSET_REGISTRY_FILENAME });
 }
 
+String EditorAssetManager::get_asset_registry_index_filepath()
+{
+    return StringBuilder::path_join({ g_editor_engine->context().get_project_root_directory().view(), "Intermediate"sv, "AssetRegistry.seindex"sv });
+}
+
 bool EditorAssetManager::serialize_asset_registry()
 {
     YAML::Emitter out;
@@ -101,10 +152,16 @@ bool EditorAssetManager::serialize_asset_registry()
     out << YAML::EndMap;
     const StringView yaml_view = StringView::create_from_utf8(out.c_str());
 
+    const String asset_registry_filepath = get_asset_registry_filepath();
     FileWriter asset_registry_file_writer;
-    SE_CHECK_FILE_ERROR(asset_registry_file_writer.open(get_asset_registry_filepath()));
+    SE_CHECK_FILE_ERROR(asset_registry_file_writer.open(asset_registry_filepath));
     SE_CHECK_FILE_ERROR(asset_registry_file_writer.write_and_close(yaml_view.byte_span()));
 
+    // The index is rebuilt now, while the contents of the registry file are known, so the next session doesn't have to parse it.
+    const Optional<u64> asset_registry_last_write_time = FileSystem::get_file_last_write_time(asset_registry_filepath);
+    if (asset_registry_last_write_time.has_value())
+        serialize_asset_registry_index(*asset_registry_last_write_time, yaml_view.byte_count(), hash_memory(yaml_view.byte_span()));
+
     SE_LOG_TAG_INFO("Asset", "Serialized '{}' assets.", serialized_asset_count);
     return true;
 }
@@ -113,11 +170,57 @@ bool EditorAssetManager::deserialize_asset_registry()
 {
     SE_ASSERT(m_asset_registry.is_empty());
 
+    const String asset_registry_filepath = get_asset_registry_filepath();
+    const Optional<u64> asset_registry_last_write_time = FileSystem::get_file_last_write_time(asset_registry_filepath);
+    const Optional<usize> asset_registry_byte_count = FileSystem::get_file_size(asset_registry_filepath);
+
+    //
+    // If the registry file hasn't been written since the index was built, the index is loaded without even reading
+    // the registry file. Otherwise, the registry file is hashed, as its contents might still match the index (for
+    // example, after the file has been restored by the version control system).
+    //
+    Buffer index_file;
+    AssetRegistryIndexHeader index_header = {};
+    bool is_index_valid = false;
+    {
+        FileReader index_file_reader;
+        if (index_file_reader.open(get_asset_registry_index_filepath()) == FileError::Success &&
+            index_file_reader.read_entire_and_close(index_file) == FileError::Success && index_file.byte_count() >= sizeof(AssetRegistryIndexHeader))
+        {
+            copy_memory(&index_header, index_file.bytes(), sizeof(AssetRegistryIndexHeader));
+            is_index_valid = index_header.magic == asset_registry_index_magic && index_header.version == asset_registry_index_version &&
+                             index_file.byte_count() == get_asset_registry_index_byte_count(index_header.asset_count, index_header.string_table_byte_count) &&
+                             asset_registry_byte_count.has_value() && index_header.registry_byte_count == *asset_registry_byte_count;
+        }
+    }
+
+    if (is_index_valid && asset_registry_last_write_time.has_value() && index_header.registry_last_write_time == *asset_registry_last_write_time)
+    {
+        if (deserialize_asset_registry_index(index_file.readonly_byte_span()))
+            return true;
+        is_index_valid = false;
+    }
+
     FileReader asset_registry_reader;
-    SE_CHECK_FILE_ERROR(asset_registry_reader.open(get_asset_registry_filepath()));
+    SE_CHECK_FILE_ERROR(asset_registry_reader.open(asset_registry_filepath));
     String asset_registry_file;
     SE_CHECK_FILE_ERROR(asset_registry_reader.read_entire_to_string_and_close(asset_registry_file));
+    const u64 asset_registry_hash = hash_memory(asset_registry_file.byte_span());
+
+    if (!is_index_valid || index_header.registry_hash != asset_registry_hash || !deserialize_asset_registry_index(index_file.readonly_byte_span()))
+    {
+        m_asset_registry.clear();
+        if (!parse_asset_registry(asset_registry_file))
+            return false;
+    }
+
+    if (asset_registry_last_write_time.has_value())
+        serialize_asset_registry_index(*asset_registry_last_write_time, asset_registry_file.byte_count(), asset_registry_hash);
+    return true;
+}
 
+bool EditorAssetManager::parse_asset_registry(const String& asset_registry_file)
+{
     YAML::Node asset_registry_root = YAML::Load(asset_registry_file.characters());
     if (!asset_registry_root)
     {
@@ -186,6 +289,134 @@ bool EditorAssetManager::deserialize_asset_registry()
     return true;
 }
 
+bool EditorAssetManager::serialize_asset_registry_index(u64 registry_last_write_time, u64 registry_byte_count, u64 registry_hash)
+{
+    struct IndexedAsset
+    {
+        AssetHandle handle;
+        AssetType type;
+        const String* filepath;
+    };
+
+    Vector<IndexedAsset> indexed_assets;
+    indexed_assets.set_fixed_capacity(m_asset_registry.count());
+    u64 string_table_byte_count = 0;
+    for (const auto& bucket : m_asset_registry)
+    {
+        if (bucket.value.metadata.is_memory_only)
+            continue;
+
+        IndexedAsset& indexed_asset = indexed_assets.emplace();
+        indexed_asset.handle = bucket.key;
+        indexed_asset.type = bucket.value.metadata.type;
+        indexed_asset.filepath = &bucket.value.metadata.filepath;
+        string_table_byte_count += bucket.value.metadata.filepath.byte_count();
+    }
+
+    indexed_assets.sort(
+        [](const IndexedAsset& lhs, const IndexedAsset& rhs) -> ComparisonResult
+        {
+            if (lhs.handle.value().value() == rhs.handle.value().value())
+                return ComparisonResult::Equal;
+            return (lhs.handle.value().value() < rhs.handle.value().value()) ? ComparisonResult::Less : ComparisonResult::Greater;
+        }
+    );
+
+    const u64 asset_count = indexed_assets.count();
+    Buffer index_file = Buffer::create(get_asset_registry_index_byte_count(asset_count, string_table_byte_count));
+    WriteonlyBytes handles = index_file.bytes() + sizeof(AssetRegistryIndexHeader);
+    WriteonlyBytes filepaths = handles + asset_count * sizeof(u64);
+    WriteonlyBytes types = filepaths + asset_count * sizeof(AssetRegistryIndexFilepath);
+    WriteonlyBytes string_table = types + asset_count * sizeof(u8);
+
+    u64 string_table_offset = 0;
+    for (usize asset_index = 0; asset_index < indexed_assets.count(); ++asset_index)
+    {
+        const IndexedAsset& indexed_asset = indexed_assets[asset_index];
+        const u64 handle = indexed_asset.handle.value().value();
+        copy_memory(handles + asset_index * sizeof(u64), &handle, sizeof(u64));
+
+        AssetRegistryIndexFilepath filepath;
+        filepath.offset = static_cast<u32>(string_table_offset);
+        filepath.byte_count = static_cast<u32>(indexed_asset.filepath->byte_count());
+        copy_memory(filepaths + asset_index * sizeof(AssetRegistryIndexFilepath), &filepath, sizeof(AssetRegistryIndexFilepath));
+
+        types[asset_index] = static_cast<u8>(indexed_asset.type);
+        copy_memory(string_table + string_table_offset, indexed_asset.filepath->byte_span().elements(), filepath.byte_count);
+        string_table_offset += filepath.byte_count;
+    }
+
+    AssetRegistryIndexHeader header = {};
+    header.magic = asset_registry_index_magic;
+    header.version = asset_registry_index_version;
+    header.asset_count = static_cast<u32>(asset_count);
+    header.registry_last_write_time = registry_last_write_time;
+    header.registry_byte_count = registry_byte_count;
+    header.registry_hash = registry_hash;
+    header.content_hash = hash_memory(index_file.readonly_byte_span().slice(sizeof(AssetRegistryIndexHeader)));
+    header.string_table_byte_count = string_table_byte_count;
+    copy_memory(index_file.bytes(), &header, sizeof(AssetRegistryIndexHeader));
+
+    // The index is written to a temporary file first, so a partially written index never replaces a valid one.
+    const String index_filepath = get_asset_registry_index_filepath();
+    const String temporary_index_filepath = StringBuilder::join({ index_filepath.view(), ".tmp"sv });
+    FileWriter index_file_writer;
+    if (index_file_writer.open(temporary_index_filepath) != FileError::Success ||
+        index_file_writer.write_and_close(index_file.readonly_byte_span()) != FileError::Success ||
+        !FileSystem::move_file(temporary_index_filepath, index_filepath))
+    {
+        SE_LOG_TAG_WARN("Asset", "Failed to write the asset registry index '{}'!", index_filepath);
+        FileSystem::delete_file(temporary_index_filepath);
+        return false;
+    }
+
+    return true;
+}
+
+bool EditorAssetManager::deserialize_asset_registry_index(ReadonlyByteSpan index_file)
+{
+    SE_ASSERT(m_asset_registry.is_empty());
+
+    AssetRegistryIndexHeader header;
+    copy_memory(&header, index_file.elements(), sizeof(AssetRegistryIndexHeader));
+    if (hash_memory(index_file.slice(sizeof(AssetRegistryIndexHeader))) != header.content_hash)
+    {
+        SE_LOG_TAG_WARN("Asset", "The asset registry index is corrupted and will be rebuilt.");
+        return false;
+    }
+
+    const u64 asset_count = header.asset_count;
+    ReadonlyBytes handles = index_file.elements() + sizeof(AssetRegistryIndexHeader);
+    ReadonlyBytes filepaths = handles + asset_count * sizeof(u64);
+    ReadonlyBytes types = filepaths + asset_count * sizeof(AssetRegistryIndexFilepath);
+    ReadonlyBytes string_table = types + asset_count * sizeof(u8);
+
+    //
+    // The assets were validated when the index was built, and the handles are sorted (so they are unique), which
+    // means the assets are added to the registry without checking them again.
+    //
+    m_asset_registry.reserve(asset_count);
+    for (u64 asset_index = 0; asset_index < asset_count; ++asset_index)
+    {
+        u64 handle;
+        AssetRegistryIndexFilepath filepath;
+        copy_memory(&handle, handles + asset_index * sizeof(u64), sizeof(u64));
+        copy_memory(&filepath, filepaths + asset_index * sizeof(AssetRegistryIndexFilepath), sizeof(AssetRegistryIndexFilepath));
+        SE_ASSERT(static_cast<u64>(filepath.offset) + filepath.byte_count <= header.string_table_byte_count);
+
+        AssetSlot asset_slot;
+        asset_slot.metadata.type = static_cast<AssetType>(types[asset_index]);
+        asset_slot.metadata.state = AssetState::Unloaded;
+        asset_slot.metadata.handle = AssetHandle(UUID(handle));
+        asset_slot.metadata.filepath = StringView::unsafe_create_from_utf8(reinterpret_cast<const char*>(string_table + filepath.offset), filepath.byte_count);
+        asset_slot.metadata.is_memory_only = false;
+
+        m_asset_registry.add(AssetHandle(UUID(handle)), move(asset_slot));
+    }
+
+    return true;
+}
+
 RefPtr<Asset> EditorAssetManager::get_asset_sync(AssetHandle handle)
 {
     Optional<AssetSlot&> optional_asset_slot = m_asset_registry.get_if_exists(handle);
@@ -216,6 +447,127 @@ RefPtr<Asset> EditorAssetManager::get_asset_sync(AssetHandle handle)
     return asset_slot.asset;
 }
 
+struct AssetLoadJob
+{
+    AssetHandle handle;
+    const EditorAssetMetadata* metadata;
+    AssetSerializer* serializer;
+    OwnPtr<AssetLoadData> load_data;
+};
+
+// State shared by all the threads that read the files of a batch of assets.
+struct AssetLoadState
+{
+    Vector<AssetLoadJob>* jobs { nullptr };
+    Atomic<u32> next_job_index;
+};
+
+static void read_assets_worker(void* user_data)
+{
+    AssetLoadState& state = *static_cast<AssetLoadState*>(user_data);
+
+    while (true)
+    {
+        const u32 job_index = state.next_job_index.fetch_add(1, MemoryOrder::Relaxed);
+        if (job_index >= state.jobs->count())
+            break;
+
+        AssetLoadJob& job = (*state.jobs)[job_index];
+        job.load_data = job.serializer->read_asset(*job.metadata);
+    }
+}
+
+static ComparisonResult compare_asset_filepaths(const String& lhs, const String& rhs)
+{
+    const ReadonlyByteSpan lhs_bytes = lhs.byte_span();
+    const ReadonlyByteSpan rhs_bytes = rhs.byte_span();
+    const usize byte_count = Math::min(lhs_bytes.count(), rhs_bytes.count());
+    for (usize byte_offset = 0; byte_offset < byte_count; ++byte_offset)
+    {
+        if (lhs_bytes[byte_offset] != rhs_bytes[byte_offset])
+            return (lhs_bytes[byte_offset] < rhs_bytes[byte_offset]) ? ComparisonResult::Less : ComparisonResult::Greater;
+    }
+
+    if (lhs.byte_count() == rhs.byte_count())
+        return ComparisonResult::Equal;
+    return (lhs.byte_count() < rhs.byte_count()) ? ComparisonResult::Less : ComparisonResult::Greater;
+}
+
+void EditorAssetManager::load_assets(Span<const AssetHandle> handles)
+{
+    Vector<AssetLoadJob> jobs;
+    for (const AssetHandle handle : handles)
+    {
+        Optional<AssetSlot&> optional_asset_slot = m_asset_registry.get_if_exists(handle);
+        if (!optional_asset_slot.has_value())
+            continue;
+        const AssetSlot& asset_slot = *optional_asset_slot;
+        if (asset_slot.metadata.state == AssetState::Ready || asset_slot.metadata.is_memory_only)
+            continue;
+
+        Optional<OwnPtr<AssetSerializer>&> optional_serializer = m_asset_serializers.get_if_exists(asset_slot.metadata.type);
+        if (!optional_serializer.has_value() || !(*optional_serializer)->supports_concurrent_reads())
+        {
+            get_asset_sync(handle);
+            continue;
+        }
+
+        AssetLoadJob& job = jobs.emplace();
+        job.handle = handle;
+        job.metadata = &asset_slot.metadata;
+        job.serializer = optional_serializer->get();
+    }
+
+    if (jobs.is_empty())
+        return;
+
+    // NOTE: The registry is not modified while the files are read, so the jobs can reference the metadata of the assets.
+    jobs.sort(
+        [](const AssetLoadJob& lhs, const AssetLoadJob& rhs) -> ComparisonResult
+        {
+            return compare_asset_filepaths(lhs.metadata->filepath, rhs.metadata->filepath);
+        }
+    );
+
+    AssetLoadState load_state;
+    load_state.jobs = &jobs;
+    load_state.next_job_index.store(0, MemoryOrder::Relaxed);
+
+    // The calling thread reads files as well, so only the additional worker threads are started.
+    const u32 worker_thread_count = Math::min(Math::max(Thread::get_hardware_concurrency(), 1U), static_cast<u32>(jobs.count())) - 1;
+    Vector<OwnPtr<Thread>> worker_threads;
+    worker_threads.set_fixed_capacity(worker_thread_count);
+    for (u32 worker_index = 0; worker_index < worker_thread_count; ++worker_index)
+    {
+        OwnPtr<Thread> worker_thread = create_own<Thread>();
+        // If a worker can't be started its files are simply read by the other threads.
+        if (worker_thread->start(read_assets_worker, &load_state, "AssetLoadWorker"sv))
+            worker_threads.add(move(worker_thread));
+    }
+
+    read_assets_worker(&load_state);
+    for (OwnPtr<Thread>& worker_thread : worker_threads)
+        worker_thread->join();
+
+    // Creating an asset might register memory-only assets, so the slots are queried again instead of using the jobs' metadata.
+    for (AssetLoadJob& job : jobs)
+    {
+        AssetSlot& asset_slot = m_asset_registry.at(job.handle);
+        RefPtr<Asset> loaded_asset;
+        if (job.load_data.is_valid())
+            loaded_asset = job.serializer->create_asset(asset_slot.metadata, move(job.load_data));
+
+        if (!loaded_asset.is_valid())
+        {
+            SE_LOG_TAG_ERROR("Asset", "Failed to load asset with ID '{}'!", job.handle.value());
+            continue;
+        }
+
+        asset_slot.asset = move(loaded_asset);
+        asset_slot.metadata.state = AssetState::Ready;
+    }
+}
+
 AssetMetadata& EditorAssetManager::get_asset_metadata(AssetHandle handle)
 {
     Optional<AssetSlot&> optional_asset_slot = m_asset_registry.get_if_exists(handle);
@@ -234,6 +586,33 @@ EditorAssetMetadata& EditorAssetManager::get_editor_metadata(AssetHandle handle)
     return static_cast<EditorAssetMetadata&>(metadata);
 }
 
+Vector<AssetHandle> EditorAssetManager::get_asset_handles_of_type(AssetType type) const
+{
+    Vector<AssetHandle> asset_handles;
+    for (const auto& bucket : m_asset_registry)
+    {
+        if (bucket.value.metadata.type == type)
+            asset_handles.add(bucket.key);
+    }
+    return asset_handles;
+}
+
+bool EditorAssetManager::serialize_asset(AssetHandle handle)
+{
+    Optional<AssetSlot&> optional_asset_slot = m_asset_registry.get_if_exists(handle);
+    if (!optional_asset_slot.has_value())
+    {
+        SE_LOG_TAG_ERROR("Asset", "Querying an invalid asset ID ({})!", handle.value());
+        return false;
+    }
+
+    const AssetSlot& asset_slot = *optional_asset_slot;
+    SE_ASSERT(!asset_slot.metadata.is_memory_only);
+    SE_ASSERT(asset_slot.metadata.state == AssetState::Ready);
+
+    return m_asset_serializers.at(asset_slot.metadata.type)->serialize(handle);
+}
+
 void EditorAssetManager::register_memory_only_asset(RefPtr<Asset> asset)
 {
     const AssetHandle handle = AssetHandle::create();
@@ -10,7 +10,9 @@
 #include <Core/Containers/HashMap.h>
 #include <Core/Containers/OwnPtr.h>
 #include <Core/Containers/RefPtr.h>
+#include <Core/Containers/Vector.h>
 #include <Core/String/String.h>
+#include <EditorAsset/DerivedDataCache.h>
 
 namespace SE
 {
@@ -33,6 +35,15 @@ public:
 
     EditorAssetMetadata& get_editor_metadata(AssetHandle handle);
 
+    // Returns the handles of all assets of the given type that are stored in the registry (including memory-only ones).
+    Vector<AssetHandle> get_asset_handles_of_type(AssetType type) const;
+
+    // Writes the asset file of the given asset. The asset must be loaded and must not be memory-only.
+    bool serialize_asset(AssetHandle handle);
+
+    // The cache of the data that the asset serializers derive from the source files of the project.
+    NODISCARD ALWAYS_INLINE DerivedDataCache& get_derived_data_cache() { return m_derived_data_cache; }
+
     template<typename T, typename... Args>
     ALWAYS_INLINE RefPtr<T> create_memory_only_asset(Args&&... args)
     {
@@ -41,6 +52,14 @@ public:
         return asset;
     }
 
+protected:
+    //
+    // The files of the assets whose serializers support concurrent reads are read by multiple threads, in the order of
+    // their filepaths (so the files that are stored close to each other are read one after the other), and the assets
+    // are then created by the main thread. The other assets are loaded by the main thread, one at a time.
+    //
+    virtual void load_assets(Span<const AssetHandle> handles) override;
+
 private:
     bool initialize_asset_registry();
     void initialize_asset_serializers();
@@ -48,6 +67,15 @@ private:
     String get_asset_registry_filepath();
     bool serialize_asset_registry();
     bool deserialize_asset_registry();
+    bool parse_asset_registry(const String& asset_registry_file);
+
+    //
+    // The binary index of the asset registry is a copy of the registry file that can be loaded without any parsing.
+    // The registry file is the source of truth, so the index is only used while it matches the registry file.
+    //
+    String get_asset_registry_index_filepath();
+    bool serialize_asset_registry_index(u64 registry_last_write_time, u64 registry_byte_count, u64 registry_hash);
+    bool deserialize_asset_registry_index(ReadonlyByteSpan index_file);
 
     void register_memory_only_asset(RefPtr<Asset> asset);
 
@@ -62,6 +90,7 @@ private:
     AssetSlot m_empty_asset_slot;
 
     HashMap<AssetType, OwnPtr<AssetSerializer>> m_asset_serializers;
+    DerivedDataCache m_derived_data_cache;
 };
 
 extern EditorAssetManager* g_editor_asset_manager;
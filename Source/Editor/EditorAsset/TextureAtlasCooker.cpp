@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Asset/TextureAsset.h>
+#include <Core/Containers/Hash.h>
+#include <Core/FileSystem/FileSystem.h>
+#include <Core/Log.h>
+#include <Core/Memory/Buffer.h>
+#include <Core/Memory/MemoryOperations.h>
+#include <Core/String/Format.h>
+#include <Core/String/StringBuilder.h>
+#include <EditorAsset/EditorAssetManager.h>
+#include <EditorAsset/TextureAtlasCooker.h>
+#include <EditorAsset/TextureSerializer.h>
+#include <EditorEngine.h>
+
+namespace SE
+{
+
+bool TextureAtlasCooker::cook(Span<const AssetHandle> texture_handles, StringView atlas_name, const TextureAtlasDescription& atlas_description)
+{
+    TextureAtlasDescription offline_atlas_description = atlas_description;
+    offline_atlas_description.mode = TextureAtlasMode::Offline;
+    TextureAtlas atlas(offline_atlas_description);
+
+    struct CookedTexture
+    {
+        RefPtr<TextureAsset> asset;
+        AssetHandle handle;
+        TextureAtlasRegion region;
+        u64 source_hash;
+    };
+    Vector<CookedTexture> cooked_textures;
+
+    for (const AssetHandle texture_handle : texture_handles)
+    {
+        RefPtr<TextureAsset> texture_asset = g_asset_manager->get_asset_sync<TextureAsset>(texture_handle);
+        if (!texture_asset.is_valid())
+            continue;
+
+        // NOTE: The source image is always used, even if the texture is already packed in an atlas, so that cooking
+        //       the same textures multiple times doesn't accumulate the padding of the previous atlases.
+        Buffer image_file;
+        if (!TextureSerializer::read_image_file(texture_asset->get_texture_filepath(), image_file))
+            continue;
+
+        u32 image_width;
+        u32 image_height;
+        Buffer image_pixels;
+        if (!TextureSerializer::decode_image(image_file.readonly_byte_span(), texture_asset->get_texture_filepath(), image_width, image_height, image_pixels))
+            continue;
+
+        Optional<TextureAtlasRegion> region = atlas.add_image(image_width, image_height, image_pixels.readonly_byte_span());
+        if (!region.has_value())
+        {
+            SE_LOG_TAG_WARN(
+                "Asset", "The texture '{}' ({}x{}) doesn't fit in an atlas page. Skipping...", texture_asset->get_texture_filepath(), image_width, image_height
+            );
+            continue;
+        }
+
+        CookedTexture& cooked_texture = cooked_textures.emplace();
+        cooked_texture.asset = move(texture_asset);
+        cooked_texture.handle = texture_handle;
+        cooked_texture.region = region.value();
+        // Stored in the asset file, so the atlas page isn't used once the source image changes.
+        cooked_texture.source_hash = hash_memory(image_file.readonly_byte_span());
+    }
+
+    Vector<String> page_filepaths;
+    Vector<RefPtr<Texture2D>> page_textures;
+    for (u32 page_index = 0; page_index < atlas.get_page_count(); ++page_index)
+    {
+        Optional<String> page_filename = format("{}_Page{}.tga"sv, atlas_name, page_index);
+        SE_ASSERT(page_filename.has_value());
+
+        const String absolute_page_filepath =
+            StringBuilder::path_join({ g_editor_engine->context().get_project_content_directory().view(), page_filename->view() });
+        const u32 page_width = offline_atlas_description.page_width;
+        const u32 page_height = offline_atlas_description.page_height;
+        if (!write_atlas_page(absolute_page_filepath, page_width, page_height, atlas.get_page_pixels(page_index)))
+            return false;
+
+        // The pages are uploaded to the GPU as well, so the cooked textures can be used without reloading them.
+        Texture2DDescription page_texture_description = {};
+        page_texture_description.width = page_width;
+        page_texture_description.height = page_height;
+        page_texture_description.format = ImageFormat::RGBA8;
+        page_texture_description.data = atlas.get_page_pixels(page_index);
+
+        page_filepaths.add(page_filename.value());
+        page_textures.add(Texture2D::create(page_texture_description));
+
+        SE_LOG_TAG_INFO("Asset", "Cooked atlas page '{}' ({}% occupancy).", page_filepaths.last(), (u32)(atlas.get_page_occupancy(page_index) * 100.0F));
+    }
+
+    for (CookedTexture& cooked_texture : cooked_textures)
+    {
+        const u32 page_index = cooked_texture.region.page_index;
+        cooked_texture.asset->set_atlas_region(
+            page_textures[page_index], page_filepaths[page_index], cooked_texture.region.uv_rect, cooked_texture.source_hash
+        );
+
+        if (!g_editor_asset_manager->get_editor_metadata(cooked_texture.handle).is_memory_only)
+            g_editor_asset_manager->serialize_asset(cooked_texture.handle);
+    }
+
+    SE_LOG_TAG_INFO("Asset", "Packed '{}' textures in '{}' atlas pages.", cooked_textures.count(), atlas.get_page_count());
+    return true;
+}
+
+bool TextureAtlasCooker::write_atlas_page(const String& page_filepath, u32 page_width, u32 page_height, ReadonlyByteSpan page_pixels)
+{
+    //
+    // The pages are written as uncompressed 32-bit TGA files, as no image encoder is available and the format is trivial to write.
+    // The rows of the atlas are stored bottom-to-top (the same order as the textures loaded with a vertical flip), which
+    // is exactly the default origin of a TGA image, so only the red and blue channels have to be swapped.
+    // https://www.dca.fa.ulisboa.pt/cadeiras/gd/docs/tga_spec.pdf
+    //
+    constexpr usize header_byte_count = 18;
+    const usize pixel_count = static_cast<usize>(page_width) * static_cast<usize>(page_height);
+    SE_ASSERT(page_width <= 0xFFFF && page_height <= 0xFFFF);
+    SE_ASSERT(pixel_count * 4 == page_pixels.count());
+
+    Buffer page_file = Buffer::create(header_byte_count + pixel_count * 4);
+    ReadWriteBytes header = page_file.bytes();
+    zero_memory(header, header_byte_count);
+    // Uncompressed true-color image.
+    header[2] = 2;
+    header[12] = static_cast<u8>(page_width & 0xFF);
+    header[13] = static_cast<u8>((page_width >> 8) & 0xFF);
+    header[14] = static_cast<u8>(page_height & 0xFF);
+    header[15] = static_cast<u8>((page_height >> 8) & 0xFF);
+    // 32 bits per pixel, with 8 bits of alpha and the origin in the bottom-left corner.
+    header[16] = 32;
+    header[17] = 8;
+
+    ReadWriteBytes pixels = page_file.bytes() + header_byte_count;
+    for (usize pixel_index = 0; pixel_index < pixel_count; ++pixel_index)
+    {
+        pixels[4 * pixel_index + 0] = page_pixels[4 * pixel_index + 2];
+        pixels[4 * pixel_index + 1] = page_pixels[4 * pixel_index + 1];
+        pixels[4 * pixel_index + 2] = page_pixels[4 * pixel_index + 0];
+        pixels[4 * pixel_index + 3] = page_pixels[4 * pixel_index + 3];
+    }
+
+    FileWriter page_file_writer;
+    if (page_file_writer.open(page_filepath) != FileError::Success)
+    {
+        SE_LOG_TAG_ERROR("Asset", "Failed to open the atlas page file '{}' for writing!", page_filepath);
+        return false;
+    }
+
+    if (page_file_writer.write_and_close(page_file.readonly_byte_span()) != FileError::Success)
+    {
+        SE_LOG_TAG_ERROR("Asset", "Failed to write the atlas page file '{}'!", page_filepath);
+        return false;
+    }
+
+    return true;
+}
+
+} // namespace SE
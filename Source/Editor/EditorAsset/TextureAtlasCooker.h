@@ -0,0 +1,31 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Asset/Asset.h>
+#include <Core/Containers/Span.h>
+#include <Core/String/StringView.h>
+#include <Renderer/TextureAtlas.h>
+
+namespace SE
+{
+
+class TextureAtlasCooker
+{
+public:
+    //
+    // Packs the source images of the given texture assets into atlas pages and writes the pages to the project
+    // content directory, as '<atlas_name>_Page<index>.tga'. The texture assets are then updated to reference their
+    // region of the atlas and their asset files are serialized, so the next time they are loaded only the pages are read.
+    // Textures that don't fit in a page are skipped and keep using their dedicated texture.
+    //
+    static bool cook(Span<const AssetHandle> texture_handles, StringView atlas_name, const TextureAtlasDescription& atlas_description);
+
+private:
+    static bool write_atlas_page(const String& page_filepath, u32 page_width, u32 page_height, ReadonlyByteSpan page_pixels);
+};
+
+} // namespace SE
@@ -0,0 +1,347 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Asset/TextureAsset.h>
+#include <Core/Containers/Hash.h>
+#include <Core/Containers/OwnPtr.h>
+#include <Core/Containers/Vector.h>
+#include <Core/FileSystem/FileSystem.h>
+#include <Core/Log.h>
+#include <Core/Math/MathCore.h>
+#include <Core/Memory/MemoryOperations.h>
+#include <Core/Platform/Atomic.h>
+#include <Core/Platform/Thread.h>
+#include <Core/String/StringBuilder.h>
+#include <EditorAsset/BlockCompression.h>
+#include <EditorAsset/EditorAssetManager.h>
+#include <EditorAsset/TextureCooker.h>
+#include <EditorAsset/TextureSerializer.h>
+#include <EditorEngine.h>
+#include <Renderer/CookedTexture.h>
+
+namespace SE
+{
+
+// The number of rows of blocks compressed at once by a worker thread. Large enough to make the cost of fetching the
+// jobs insignificant, but small enough for the jobs to be evenly distributed between the workers.
+static constexpr u32 s_compression_job_block_row_count = 4;
+
+// For smaller textures starting the worker threads takes longer than compressing all the blocks on the calling thread.
+static constexpr usize s_parallel_compression_min_block_count = 4096;
+
+struct TextureCompressionJob
+{
+    u32 mip_index;
+    u32 first_block_row;
+    u32 block_row_count;
+};
+
+// State shared by all the threads that compress the mip chain of a texture.
+struct TextureCompressionState
+{
+    ImageFormat format { ImageFormat::Unknown };
+    u32 width { 0 };
+    u32 height { 0 };
+    // The offsets of each mip level in the uncompressed and compressed mip chains.
+    const Vector<usize>* mip_pixel_offsets { nullptr };
+    const Vector<usize>* mip_compressed_offsets { nullptr };
+    ReadonlyBytes mip_chain_pixels { nullptr };
+    // Each block has its own slot in the output, so the workers never write to the same bytes.
+    WriteonlyBytes compressed_pixels { nullptr };
+    const Vector<TextureCompressionJob>* jobs { nullptr };
+    Atomic<u32> next_job_index;
+};
+
+static void compress_texture_blocks(const TextureCompressionState& state, const TextureCompressionJob& job)
+{
+    const u32 mip_width = get_image_mip_dimension(state.width, job.mip_index);
+    const u32 mip_height = get_image_mip_dimension(state.height, job.mip_index);
+    const u32 block_byte_count = get_image_format_element_byte_count(state.format);
+    const u32 block_column_count = (mip_width + 3) / 4;
+    ReadonlyBytes mip_pixels = state.mip_chain_pixels + (*state.mip_pixel_offsets)[job.mip_index];
+    WriteonlyBytes mip_blocks = state.compressed_pixels + (*state.mip_compressed_offsets)[job.mip_index];
+
+    u8 block_pixels[16 * 4];
+    for (u32 block_row = job.first_block_row; block_row < job.first_block_row + job.block_row_count; ++block_row)
+    {
+        for (u32 block_column = 0; block_column < block_column_count; ++block_column)
+        {
+            // The mip levels smaller than 4x4 pixels still occupy a whole block, so the edge pixels are repeated.
+            for (u32 pixel_y = 0; pixel_y < 4; ++pixel_y)
+            {
+                const u32 source_y = Math::min(4 * block_row + pixel_y, mip_height - 1);
+                for (u32 pixel_x = 0; pixel_x < 4; ++pixel_x)
+                {
+                    const u32 source_x = Math::min(4 * block_column + pixel_x, mip_width - 1);
+                    const usize source_offset = 4 * (static_cast<usize>(source_y) * mip_width + source_x);
+                    copy_memory(block_pixels + 4 * (4 * pixel_y + pixel_x), mip_pixels + source_offset, 4);
+                }
+            }
+
+            WriteonlyBytes block = mip_blocks + (static_cast<usize>(block_row) * block_column_count + block_column) * block_byte_count;
+            switch (state.format)
+            {
+                case ImageFormat::BC1: compress_bc1_block(block_pixels, block); break;
+                case ImageFormat::BC3: compress_bc3_block(block_pixels, block); break;
+                case ImageFormat::BC7: compress_bc7_block(block_pixels, block); break;
+                default: SE_ASSERT(false); break;
+            }
+        }
+    }
+}
+
+static void compress_texture_blocks_worker(void* user_data)
+{
+    TextureCompressionState& state = *static_cast<TextureCompressionState*>(user_data);
+
+    while (true)
+    {
+        const u32 job_index = state.next_job_index.fetch_add(1, MemoryOrder::Relaxed);
+        if (job_index >= state.jobs->count())
+            break;
+
+        compress_texture_blocks(state, (*state.jobs)[job_index]);
+    }
+}
+
+TextureCookResult TextureCooker::cook(const String& texture_filepath, const TextureCookDescription& description)
+{
+    const String absolute_texture_filepath =
+        StringBuilder::path_join({ g_editor_engine->context().get_project_content_directory().view(), texture_filepath.view() });
+    const String cooked_texture_filepath = get_cooked_filepath(texture_filepath);
+
+    FileReader texture_file_reader;
+    Buffer texture_file;
+    if (texture_file_reader.open(absolute_texture_filepath) != FileError::Success ||
+        texture_file_reader.read_entire_and_close(texture_file) != FileError::Success)
+    {
+        SE_LOG_TAG_ERROR("Asset", "Failed to read the source image '{}'!", texture_filepath);
+        return TextureCookResult::Failed;
+    }
+
+    // Changing the settings (or the cooked format version) invalidates the cooked textures, the same as changing the source image.
+    const u32 cook_settings[] = { cooked_texture_version, static_cast<u32>(description.format), description.generate_mips ? 1U : 0U };
+    const u64 settings_hash = hash_memory(ReadonlyByteSpan(reinterpret_cast<ReadonlyBytes>(cook_settings), sizeof(cook_settings)));
+    const u64 source_hash = hash_memory(texture_file.readonly_byte_span());
+
+    const Optional<CookedTextureHeader> cooked_texture_header = CookedTexture::read_header(cooked_texture_filepath);
+    if (cooked_texture_header.has_value() && cooked_texture_header->source_hash == source_hash && cooked_texture_header->settings_hash == settings_hash)
+        return TextureCookResult::UpToDate;
+
+    u32 width;
+    u32 height;
+    Buffer pixels;
+    if (!TextureSerializer::decode_image(texture_file.readonly_byte_span(), texture_filepath, width, height, pixels))
+        return TextureCookResult::Failed;
+    texture_file.release();
+
+    ImageFormat format = description.format;
+    if (format == ImageFormat::Unknown)
+    {
+        format = ImageFormat::BC1;
+        for (usize pixel_index = 0; pixel_index < static_cast<usize>(width) * static_cast<usize>(height); ++pixel_index)
+        {
+            if (pixels.bytes()[4 * pixel_index + 3] != 255)
+            {
+                format = ImageFormat::BC3;
+                break;
+            }
+        }
+    }
+
+    if (is_image_format_block_compressed(format) && (width % 4 != 0 || height % 4 != 0))
+    {
+        SE_LOG_TAG_WARN(
+            "Asset", "The dimensions of the texture '{}' ({}x{}) are not multiples of 4, so it can't be block compressed.", texture_filepath, width, height
+        );
+        format = ImageFormat::RGBA8;
+    }
+
+    if (format != ImageFormat::RGBA8 && !is_image_format_block_compressed(format))
+    {
+        SE_LOG_TAG_ERROR("Asset", "The texture '{}' can't be cooked using the requested format!", texture_filepath);
+        return TextureCookResult::Failed;
+    }
+
+    const u32 mip_count = description.generate_mips ? get_image_full_mip_count(width, height) : 1;
+    Buffer mip_chain_pixels = Buffer::create(get_image_mip_chain_byte_count(ImageFormat::RGBA8, width, height, mip_count));
+    copy_memory(mip_chain_pixels.bytes(), pixels.bytes(), pixels.byte_count());
+    pixels.release();
+    generate_mip_chain(width, height, mip_count, mip_chain_pixels);
+
+    Buffer cooked_pixels;
+    if (is_image_format_block_compressed(format))
+        compress_mip_chain(format, width, height, mip_count, mip_chain_pixels.readonly_byte_span(), cooked_pixels);
+    else
+        cooked_pixels = move(mip_chain_pixels);
+
+    CookedTextureHeader header = {};
+    header.magic = cooked_texture_magic;
+    header.version = cooked_texture_version;
+    header.source_hash = source_hash;
+    header.settings_hash = settings_hash;
+    header.width = width;
+    header.height = height;
+    header.format = format;
+    header.mip_count = mip_count;
+    header.data_byte_count = cooked_pixels.byte_count();
+
+    FileWriter cooked_texture_file_writer;
+    if (cooked_texture_file_writer.open(cooked_texture_filepath) != FileError::Success ||
+        cooked_texture_file_writer.write(ReadonlyByteSpan(reinterpret_cast<ReadonlyBytes>(&header), sizeof(CookedTextureHeader))) != FileError::Success ||
+        cooked_texture_file_writer.write_and_close(cooked_pixels.readonly_byte_span()) != FileError::Success)
+    {
+        SE_LOG_TAG_ERROR("Asset", "Failed to write the cooked texture '{}'!", cooked_texture_filepath);
+        return TextureCookResult::Failed;
+    }
+
+    return TextureCookResult::Cooked;
+}
+
+bool TextureCooker::cook(Span<const AssetHandle> texture_handles, const TextureCookDescription& description)
+{
+    u32 cooked_texture_count = 0;
+    u32 up_to_date_texture_count = 0;
+    bool has_succeeded = true;
+
+    for (const AssetHandle texture_handle : texture_handles)
+    {
+        RefPtr<TextureAsset> texture_asset = g_asset_manager->get_asset_sync<TextureAsset>(texture_handle);
+        if (!texture_asset.is_valid() || texture_asset->is_packed_in_atlas())
+            continue;
+
+        switch (cook(texture_asset->get_texture_filepath(), description))
+        {
+            case TextureCookResult::Failed: has_succeeded = false; break;
+            case TextureCookResult::Cooked: ++cooked_texture_count; break;
+            case TextureCookResult::UpToDate: ++up_to_date_texture_count; break;
+        }
+    }
+
+    SE_LOG_TAG_INFO("Asset", "Cooked '{}' textures ('{}' were already up to date).", cooked_texture_count, up_to_date_texture_count);
+    return has_succeeded;
+}
+
+String TextureCooker::get_cooked_filepath(const String& texture_filepath)
+{
+    const String absolute_texture_filepath =
+        StringBuilder::path_join({ g_editor_engine->context().get_project_content_directory().view(), texture_filepath.view() });
+    return StringBuilder::join({ absolute_texture_filepath.view(), ".setexture"sv });
+}
+
+void TextureCooker::generate_mip_chain(u32 width, u32 height, u32 mip_count, Buffer& mip_chain_pixels)
+{
+    //
+    // Each mip level is generated from the previous one using a 2x2 box filter. When a dimension of the previous level is odd,
+    // its last row (or column) is sampled twice instead of reading outside of the image. The loops work on integers only and
+    // have no dependencies between iterations, so they are vectorized by the compiler.
+    //
+    usize source_offset = 0;
+    for (u32 mip_index = 1; mip_index < mip_count; ++mip_index)
+    {
+        const u32 source_width = get_image_mip_dimension(width, mip_index - 1);
+        const u32 source_height = get_image_mip_dimension(height, mip_index - 1);
+        const u32 mip_width = get_image_mip_dimension(width, mip_index);
+        const u32 mip_height = get_image_mip_dimension(height, mip_index);
+        const usize mip_offset = source_offset + get_image_byte_count(ImageFormat::RGBA8, source_width, source_height);
+
+        ReadonlyBytes source_pixels = mip_chain_pixels.bytes() + source_offset;
+        WriteonlyBytes mip_pixels = mip_chain_pixels.bytes() + mip_offset;
+
+        for (u32 y = 0; y < mip_height; ++y)
+        {
+            ReadonlyBytes source_row_0 = source_pixels + 4 * static_cast<usize>(Math::min(2 * y, source_height - 1)) * source_width;
+            ReadonlyBytes source_row_1 = source_pixels + 4 * static_cast<usize>(Math::min(2 * y + 1, source_height - 1)) * source_width;
+            WriteonlyBytes mip_row = mip_pixels + 4 * static_cast<usize>(y) * mip_width;
+
+            for (u32 x = 0; x < mip_width; ++x)
+            {
+                const u32 source_x_0 = 4 * Math::min(2 * x, source_width - 1);
+                const u32 source_x_1 = 4 * Math::min(2 * x + 1, source_width - 1);
+                for (u32 channel = 0; channel < 4; ++channel)
+                {
+                    const u32 sum = source_row_0[source_x_0 + channel] + source_row_0[source_x_1 + channel] + source_row_1[source_x_0 + channel] +
+                                    source_row_1[source_x_1 + channel];
+                    mip_row[4 * x + channel] = static_cast<u8>((sum + 2) / 4);
+                }
+            }
+        }
+
+        source_offset = mip_offset;
+    }
+}
+
+void TextureCooker::compress_mip_chain(
+    ImageFormat format, u32 width, u32 height, u32 mip_count, ReadonlyByteSpan mip_chain_pixels, Buffer& out_compressed_pixels
+)
+{
+    out_compressed_pixels = Buffer::create(get_image_mip_chain_byte_count(format, width, height, mip_count));
+
+    Vector<usize> mip_pixel_offsets;
+    Vector<usize> mip_compressed_offsets;
+    mip_pixel_offsets.set_fixed_capacity(mip_count);
+    mip_compressed_offsets.set_fixed_capacity(mip_count);
+
+    // The mip levels are split in jobs of a few rows of blocks, so all the levels are compressed by the same set of workers.
+    Vector<TextureCompressionJob> jobs;
+    usize mip_pixel_offset = 0;
+    usize mip_compressed_offset = 0;
+    usize block_count = 0;
+    for (u32 mip_index = 0; mip_index < mip_count; ++mip_index)
+    {
+        const u32 mip_width = get_image_mip_dimension(width, mip_index);
+        const u32 mip_height = get_image_mip_dimension(height, mip_index);
+        const u32 block_row_count = get_image_row_count(format, mip_height);
+
+        mip_pixel_offsets.add(mip_pixel_offset);
+        mip_compressed_offsets.add(mip_compressed_offset);
+        mip_pixel_offset += get_image_byte_count(ImageFormat::RGBA8, mip_width, mip_height);
+        mip_compressed_offset += get_image_byte_count(format, mip_width, mip_height);
+        block_count += static_cast<usize>(block_row_count) * static_cast<usize>((mip_width + 3) / 4);
+
+        for (u32 first_block_row = 0; first_block_row < block_row_count; first_block_row += s_compression_job_block_row_count)
+        {
+            TextureCompressionJob& job = jobs.emplace();
+            job.mip_index = mip_index;
+            job.first_block_row = first_block_row;
+            job.block_row_count = Math::min(s_compression_job_block_row_count, block_row_count - first_block_row);
+        }
+    }
+
+    SE_ASSERT(mip_pixel_offset == mip_chain_pixels.count());
+    SE_ASSERT(mip_compressed_offset == out_compressed_pixels.byte_count());
+
+    TextureCompressionState compression_state;
+    compression_state.format = format;
+    compression_state.width = width;
+    compression_state.height = height;
+    compression_state.mip_pixel_offsets = &mip_pixel_offsets;
+    compression_state.mip_compressed_offsets = &mip_compressed_offsets;
+    compression_state.mip_chain_pixels = mip_chain_pixels.elements();
+    compression_state.compressed_pixels = out_compressed_pixels.bytes();
+    compression_state.jobs = &jobs;
+    compression_state.next_job_index.store(0, MemoryOrder::Relaxed);
+
+    // The calling thread compresses blocks as well, so only the additional worker threads are started.
+    u32 worker_thread_count = 0;
+    if (block_count >= s_parallel_compression_min_block_count)
+        worker_thread_count = Math::min(Math::max(Thread::get_hardware_concurrency(), 1U), static_cast<u32>(jobs.count())) - 1;
+
+    Vector<OwnPtr<Thread>> worker_threads;
+    worker_threads.set_fixed_capacity(worker_thread_count);
+    for (u32 worker_index = 0; worker_index < worker_thread_count; ++worker_index)
+    {
+        OwnPtr<Thread> worker_thread = create_own<Thread>();
+        // If a worker can't be started its jobs are simply compressed by the other threads.
+        if (worker_thread->start(compress_texture_blocks_worker, &compression_state, "TextureCompressionWorker"sv))
+            worker_threads.add(move(worker_thread));
+    }
+
+    compress_texture_blocks_worker(&compression_state);
+    for (OwnPtr<Thread>& worker_thread : worker_threads)
+        worker_thread->join();
+}
+
+} // namespace SE
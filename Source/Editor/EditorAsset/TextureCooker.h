@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Asset/Asset.h>
+#include <Core/Containers/Span.h>
+#include <Core/Memory/Buffer.h>
+#include <Core/String/String.h>
+#include <Renderer/Image.h>
+
+namespace SE
+{
+
+struct TextureCookDescription
+{
+    // The format of the cooked texture. When unknown, opaque textures are compressed to BC1 and textures with transparent
+    // pixels to BC3. Textures whose dimensions are not multiples of 4 can't be block compressed, so they are always cooked as RGBA8.
+    ImageFormat format { ImageFormat::Unknown };
+    bool generate_mips { true };
+};
+
+enum class TextureCookResult : u8
+{
+    Failed,
+    Cooked,
+    // The cooked texture was created from the same source image, using the same settings.
+    UpToDate,
+};
+
+class TextureCooker
+{
+public:
+    //
+    // Cooks a source image, relative to the project content directory: the image is decoded, its mip chain is generated
+    // and block compressed, and the result is written next to the source image, in a file that is loaded by
+    // `CookedTexture::load` without any processing. The cooked texture stores the hash of the source image and of the
+    // settings, so a source image that hasn't changed since it was last cooked is not decoded again. The texture serializer
+    // compares the same source hash when loading the texture, so an outdated cooked texture is never used.
+    //
+    static TextureCookResult cook(const String& texture_filepath, const TextureCookDescription& description);
+
+    //
+    // Cooks the source images of the given texture assets. Textures that are packed in an atlas are skipped, so that sprites
+    // using them can still be rendered in the same batch. The cooked textures are used the next time the assets are loaded.
+    //
+    static bool cook(Span<const AssetHandle> texture_handles, const TextureCookDescription& description);
+
+    // Returns the absolute path of the cooked texture of the given source image, which is relative to the project content directory.
+    NODISCARD static String get_cooked_filepath(const String& texture_filepath);
+
+private:
+    static void generate_mip_chain(u32 width, u32 height, u32 mip_count, Buffer& mip_chain_pixels);
+    static void compress_mip_chain(ImageFormat format, u32 width, u32 height, u32 mip_count, ReadonlyByteSpan mip_chain_pixels, Buffer& out_compressed_pixels);
+};
+
+} // namespace SE
@@ -4,11 +4,17 @@
  */
 
 #include <Asset/TextureAsset.h>
+#include <Core/Containers/Hash.h>
 #include <Core/FileSystem/FileSystem.h>
 #include <Core/Log.h>
+#include <Core/Memory/MemoryOperations.h>
 #include <Core/String/StringBuilder.h>
+#include <EditorAsset/DerivedDataCache.h>
+#include <EditorAsset/EditorAssetManager.h>
+#include <EditorAsset/TextureCooker.h>
 #include <EditorAsset/TextureSerializer.h>
 #include <EditorEngine.h>
+#include <Renderer/CookedTexture.h>
 #include <ThirdParty/yaml-cpp/include/yaml-cpp/shooteryaml.h>
 
 #define STBI_ASSERT(x) SE_ASSERT(x)
@@ -28,6 +34,14 @@ bool TextureSerializer::serialize(AssetHandle handle)
     out << YAML::Key << "Type" << YAML::Value << get_asset_type_string(metadata.type).characters();
     out << YAML::Key << "Handle" << YAML::Value << metadata.handle.value();
     out << YAML::Key << "Filepath" << YAML::Value << asset->get_texture_filepath().characters();
+    // Textures that are packed in the dynamic atlas don't have an atlas page file, as the atlas is rebuilt at runtime.
+    if (!asset->get_atlas_page_filepath().is_empty())
+    {
+        out << YAML::Key << "AtlasPage" << YAML::Value << asset->get_atlas_page_filepath().characters();
+        out << YAML::Key << "UVMin" << YAML::Value << asset->get_uv_rect().min;
+        out << YAML::Key << "UVMax" << YAML::Value << asset->get_uv_rect().max;
+        out << YAML::Key << "SourceHash" << YAML::Value << asset->get_atlas_source_hash();
+    }
     out << YAML::EndMap;
     const StringView yaml_view = StringView::create_from_utf8(out.c_str());
 
@@ -42,7 +56,15 @@ bool TextureSerializer::serialize(AssetHandle handle)
 
 RefPtr<Asset> TextureSerializer::deserialize(AssetMetadata& metadata)
 {
-    EditorAssetMetadata& editor_metadata = static_cast<EditorAssetMetadata&>(metadata);
+    OwnPtr<AssetLoadData> load_data = read_asset(metadata);
+    if (!load_data.is_valid())
+        return {};
+    return create_asset(metadata, move(load_data));
+}
+
+OwnPtr<AssetLoadData> TextureSerializer::read_asset(const AssetMetadata& metadata)
+{
+    const EditorAssetMetadata& editor_metadata = static_cast<const EditorAssetMetadata&>(metadata);
 
     const String asset_metadata_filepath =
         StringBuilder::path_join({ g_editor_engine->context().get_project_content_directory().view(), editor_metadata.filepath.view() });
@@ -104,39 +126,248 @@ RefPtr<Asset> TextureSerializer::deserialize(AssetMetadata& metadata)
         return {};
     }
 
-    const String texture_filepath = StringView::create_from_utf8(texture_filepath_node.as<std::string>().c_str());
-    const String absolute_texture_filepath =
-        StringBuilder::path_join({ g_editor_engine->context().get_project_content_directory().view(), texture_filepath.view() });
+    OwnPtr<TextureLoadData> load_data = create_own<TextureLoadData>();
+    load_data->texture_filepath = StringView::create_from_utf8(texture_filepath_node.as<std::string>().c_str());
 
-    FileReader texture_file_reader;
+    //
+    // The source image is read even if the cooked data of the texture is used, as the cooked data is only valid if it was
+    // created from the current contents of the source image. Otherwise, the source image is decoded instead.
+    // NOTE: Hashing the source image is much cheaper than decoding it, so the cooked data is still worth using.
+    //
     Buffer texture_file;
-    SE_CHECK_FILE_ERROR(texture_file_reader.open(absolute_texture_filepath));
-    SE_CHECK_FILE_ERROR(texture_file_reader.read_entire_and_close(texture_file));
+    if (!read_image_file(load_data->texture_filepath, texture_file))
+        return {};
+    const u64 source_hash = hash_memory(texture_file.readonly_byte_span());
 
-    stbi_set_flip_vertically_on_load(true);
+    // The texture was packed in an atlas by the texture atlas cooker, so only the atlas page has to be loaded.
+    // NOTE: The atlas pages are shared between textures, so they are loaded by the main thread when the asset is created.
+    YAML::Node atlas_page_node = asset_metadata_root["AtlasPage"];
+    if (atlas_page_node)
+    {
+        YAML::Node uv_min_node = asset_metadata_root["UVMin"];
+        YAML::Node uv_max_node = asset_metadata_root["UVMax"];
+        if (!uv_min_node || !uv_max_node)
+        {
+            SE_LOG_TAG_ERROR("Asset", "Invalid or corrupted asset file: '{}'!", editor_metadata.filepath);
+            return {};
+        }
 
-    int width, height;
-    const u32 channel_count = 4;
-    stbi_uc* loaded_texture_bytes = stbi_load_from_memory(texture_file.bytes(), (int)(texture_file.byte_count()), &width, &height, nullptr, channel_count);
-    texture_file.release();
+        // Asset files that were written before the source hash was stored can't be validated, so their atlas page isn't used either.
+        YAML::Node source_hash_node = asset_metadata_root["SourceHash"];
+        if (source_hash_node && source_hash_node.as<u64>() == source_hash)
+        {
+            load_data->uv_rect.min = uv_min_node.as<Vector2>();
+            load_data->uv_rect.max = uv_max_node.as<Vector2>();
+            load_data->atlas_page_filepath = StringView::create_from_utf8(atlas_page_node.as<std::string>().c_str());
+            load_data->atlas_source_hash = source_hash;
+            return load_data.as<AssetLoadData>();
+        }
+
+        SE_LOG_TAG_WARN(
+            "Asset", "The source image of '{}' has changed since it was packed in an atlas. Loading the source image instead...", load_data->texture_filepath
+        );
+    }
+
+    // The texture was cooked offline, so its mip chain is uploaded as it is, without decoding the source image.
+    const String cooked_texture_filepath = TextureCooker::get_cooked_filepath(load_data->texture_filepath);
+    if (FileSystem::exists(cooked_texture_filepath))
+    {
+        FileReader cooked_texture_file_reader;
+        Buffer cooked_texture;
+        if (cooked_texture_file_reader.open(cooked_texture_filepath) == FileError::Success &&
+            cooked_texture_file_reader.read_entire_and_close(cooked_texture) == FileError::Success)
+        {
+            // NOTE: The rest of the header is validated when the texture is created, by `CookedTexture::create_from_memory`.
+            CookedTextureHeader cooked_texture_header;
+            const bool has_header = (cooked_texture.byte_count() >= sizeof(CookedTextureHeader));
+            if (has_header)
+                copy_memory(&cooked_texture_header, cooked_texture.bytes(), sizeof(CookedTextureHeader));
+
+            if (has_header && cooked_texture_header.source_hash == source_hash)
+            {
+                load_data->cooked_texture = move(cooked_texture);
+                return load_data.as<AssetLoadData>();
+            }
+
+            SE_LOG_TAG_WARN("Asset", "The cooked texture of '{}' is outdated. Loading the source image instead...", load_data->texture_filepath);
+        }
+        else
+        {
+            SE_LOG_TAG_WARN("Asset", "The cooked texture of '{}' can't be read. Loading the source image instead...", load_data->texture_filepath);
+        }
+    }
 
-    const usize loaded_texture_byte_count = (usize)(width) * (usize)(height) * (usize)(channel_count);
+    if (!decode_image(texture_file.readonly_byte_span(), load_data->texture_filepath, load_data->image_width, load_data->image_height, load_data->image_pixels))
+        return {};
+    return load_data.as<AssetLoadData>();
+}
 
-    const u32 texture_width = (u32)(width);
-    const u32 texture_height = (u32)(height);
-    const u32 texture_channel_count = channel_count;
+RefPtr<Asset> TextureSerializer::create_asset(AssetMetadata& metadata, OwnPtr<AssetLoadData> asset_load_data)
+{
+    OwnPtr<TextureLoadData> load_data = asset_load_data.as<TextureLoadData>();
+    const String& texture_filepath = load_data->texture_filepath;
+
+    if (!load_data->atlas_page_filepath.is_empty())
+    {
+        RefPtr<Texture2D> atlas_page_texture = get_or_load_atlas_page(load_data->atlas_page_filepath);
+        if (!atlas_page_texture.is_valid())
+            return {};
+
+        RefPtr<TextureAsset> asset = create_ref<TextureAsset>(RefPtr<Texture2D>(), texture_filepath);
+        asset->set_atlas_region(move(atlas_page_texture), move(load_data->atlas_page_filepath), load_data->uv_rect, load_data->atlas_source_hash);
+        return asset.as<Asset>();
+    }
+
+    if (load_data->cooked_texture.byte_count() > 0)
+    {
+        RefPtr<Texture2D> cooked_texture = CookedTexture::create_from_memory(load_data->cooked_texture.readonly_byte_span());
+        if (cooked_texture.is_valid())
+        {
+            RefPtr<TextureAsset> asset = create_ref<TextureAsset>(move(cooked_texture), texture_filepath);
+            return asset.as<Asset>();
+        }
+
+        SE_LOG_TAG_WARN("Asset", "The cooked texture of '{}' is corrupted. Loading the source image instead...", texture_filepath);
+        if (!load_image(texture_filepath, load_data->image_width, load_data->image_height, load_data->image_pixels))
+            return {};
+    }
+
+    const u32 texture_width = load_data->image_width;
+    const u32 texture_height = load_data->image_height;
+    const Buffer& texture_pixels = load_data->image_pixels;
+
+    // Small textures are packed in the dynamic atlas, instead of being uploaded to a dedicated texture.
+    if (texture_width <= max_dynamic_atlas_texture_size && texture_height <= max_dynamic_atlas_texture_size)
+    {
+        if (!m_dynamic_atlas.is_valid())
+            m_dynamic_atlas = create_own<TextureAtlas>(TextureAtlasDescription());
+
+        Optional<TextureAtlasRegion> region = m_dynamic_atlas->add_image(texture_width, texture_height, texture_pixels.readonly_byte_span());
+        if (region.has_value())
+        {
+            RefPtr<TextureAsset> asset = create_ref<TextureAsset>(RefPtr<Texture2D>(), texture_filepath);
+            asset->set_atlas_region(m_dynamic_atlas->get_page_texture(region->page_index), String(), region->uv_rect);
+            return asset.as<Asset>();
+        }
+    }
 
     Texture2DDescription renderer_texture_description = {};
     renderer_texture_description.width = texture_width;
-    renderer_texture_description.height = texture_width;
+    renderer_texture_description.height = texture_height;
     renderer_texture_description.format = ImageFormat::RGBA8;
-    renderer_texture_description.data = ReadonlyByteSpan(loaded_texture_bytes, loaded_texture_byte_count);
+    renderer_texture_description.data = texture_pixels.readonly_byte_span();
 
     RefPtr<Texture2D> renderer_texture = Texture2D::create(renderer_texture_description);
-    STBI_FREE(loaded_texture_bytes);
 
     RefPtr<TextureAsset> asset = create_ref<TextureAsset>(move(renderer_texture), texture_filepath);
     return asset.as<Asset>();
 }
 
+bool TextureSerializer::load_image(const String& image_filepath, u32& out_width, u32& out_height, Buffer& out_pixels)
+{
+    Buffer image_file;
+    if (!read_image_file(image_filepath, image_file))
+        return false;
+    return decode_image(image_file.readonly_byte_span(), image_filepath, out_width, out_height, out_pixels);
+}
+
+bool TextureSerializer::read_image_file(const String& image_filepath, Buffer& out_image_file)
+{
+    const String absolute_image_filepath =
+        StringBuilder::path_join({ g_editor_engine->context().get_project_content_directory().view(), image_filepath.view() });
+
+    FileReader image_file_reader;
+    if (image_file_reader.open(absolute_image_filepath) != FileError::Success || image_file_reader.read_entire_and_close(out_image_file) != FileError::Success)
+    {
+        SE_LOG_TAG_ERROR("Asset", "Failed to read the image '{}'!", image_filepath);
+        return false;
+    }
+    return true;
+}
+
+bool TextureSerializer::decode_image(ReadonlyByteSpan image_file, const String& image_filepath, u32& out_width, u32& out_height, Buffer& out_pixels)
+{
+    const u32 channel_count = 4;
+
+    //
+    // The decoded image is stored in the derived-data cache, so an image file is only decoded once for as long as
+    // its contents don't change. The data of the entry is the width and height of the image, followed by its pixels.
+    // NOTE: The version must be incremented every time the decoding (or the layout of the entry) changes.
+    //
+    const u32 decode_settings[] = { 1 /* Flip vertically. */, channel_count };
+    const u64 derived_data_key = DerivedDataCache::make_key(
+        "TextureImage"sv, 1, ReadonlyByteSpan(reinterpret_cast<ReadonlyBytes>(decode_settings), sizeof(decode_settings)), image_file
+    );
+
+    auto decode_image_data = [&](Buffer& out_data) -> bool
+    {
+        // NOTE: Images are decoded by the asset loading worker threads, so the flag is set only for the calling thread,
+        //       as the global flag would be written concurrently by all of them.
+        stbi_set_flip_vertically_on_load_thread(true);
+
+        int width, height;
+        stbi_uc* loaded_image_bytes = stbi_load_from_memory(image_file.elements(), (int)(image_file.count()), &width, &height, nullptr, channel_count);
+
+        if (loaded_image_bytes == nullptr)
+        {
+            SE_LOG_TAG_ERROR("Asset", "Failed to decode the image '{}'!", image_filepath);
+            return false;
+        }
+
+        const u32 image_dimensions[] = { (u32)(width), (u32)(height) };
+        const usize loaded_image_byte_count = (usize)(width) * (usize)(height) * (usize)(channel_count);
+        out_data = Buffer::create(sizeof(image_dimensions) + loaded_image_byte_count);
+        copy_memory(out_data.bytes(), image_dimensions, sizeof(image_dimensions));
+        copy_memory(out_data.bytes() + sizeof(image_dimensions), loaded_image_bytes, loaded_image_byte_count);
+
+        STBI_FREE(loaded_image_bytes);
+        return true;
+    };
+
+    Buffer image_data;
+    if (!g_editor_asset_manager->get_derived_data_cache().get_or_build(derived_data_key, decode_image_data, image_data))
+        return false;
+
+    u32 image_dimensions[2];
+    if (image_data.byte_count() < sizeof(image_dimensions))
+        return false;
+    copy_memory(image_dimensions, image_data.bytes(), sizeof(image_dimensions));
+
+    const usize image_byte_count = (usize)(image_dimensions[0]) * (usize)(image_dimensions[1]) * (usize)(channel_count);
+    if (image_data.byte_count() != sizeof(image_dimensions) + image_byte_count)
+        return false;
+
+    out_width = image_dimensions[0];
+    out_height = image_dimensions[1];
+    out_pixels = Buffer::copy(image_data.bytes() + sizeof(image_dimensions), image_byte_count);
+    return true;
+}
+
+RefPtr<Texture2D> TextureSerializer::get_or_load_atlas_page(const String& atlas_page_filepath)
+{
+    for (const AtlasPage& atlas_page : m_atlas_pages)
+    {
+        if (atlas_page.filepath == atlas_page_filepath)
+            return atlas_page.texture;
+    }
+
+    u32 page_width;
+    u32 page_height;
+    Buffer page_pixels;
+    if (!load_image(atlas_page_filepath, page_width, page_height, page_pixels))
+        return {};
+
+    Texture2DDescription page_texture_description = {};
+    page_texture_description.width = page_width;
+    page_texture_description.height = page_height;
+    page_texture_description.format = ImageFormat::RGBA8;
+    page_texture_description.data = page_pixels.readonly_byte_span();
+
+    AtlasPage atlas_page;
+    atlas_page.filepath = atlas_page_filepath;
+    atlas_page.texture = Texture2D::create(page_texture_description);
+    m_atlas_pages.add(move(atlas_page));
+    return m_atlas_pages.last().texture;
+}
+
 } // namespace SE
@@ -6,17 +6,73 @@
 #pragma once
 
 #include <Asset/AssetSerializer.h>
+#include <Core/Containers/OwnPtr.h>
 #include <Core/Containers/RefPtr.h>
+#include <Core/Containers/Vector.h>
+#include <Core/Memory/Buffer.h>
 #include <EditorAsset/EditorAssetManager.h>
+#include <Renderer/TextureAtlas.h>
 
 namespace SE
 {
 
 class TextureSerializer : public AssetSerializer
 {
+public:
+    // Textures that are not packed in a cooked atlas and whose dimensions don't exceed this value are packed
+    // in the dynamic atlas when they are loaded, so sprites that use them can be rendered in the same batch.
+    static constexpr u32 max_dynamic_atlas_texture_size = 256;
+
 public:
     virtual bool serialize(AssetHandle handle) override;
     virtual RefPtr<Asset> deserialize(AssetMetadata& metadata) override;
+
+    NODISCARD virtual bool supports_concurrent_reads() const override { return true; }
+    virtual OwnPtr<AssetLoadData> read_asset(const AssetMetadata& metadata) override;
+    virtual RefPtr<Asset> create_asset(AssetMetadata& metadata, OwnPtr<AssetLoadData> load_data) override;
+
+    //
+    // Loads an image file, relative to the project content directory, as RGBA8 pixels. The rows are flipped
+    // vertically, so the pixels can be passed directly to `Texture2D::create`.
+    //
+    NODISCARD static bool load_image(const String& image_filepath, u32& out_width, u32& out_height, Buffer& out_pixels);
+
+    // Reads an image file, relative to the project content directory, without decoding it.
+    NODISCARD static bool read_image_file(const String& image_filepath, Buffer& out_image_file);
+
+    // Decodes an image file that is already loaded in memory, the same way as `load_image`. The filepath is only used for logging.
+    NODISCARD static bool decode_image(ReadonlyByteSpan image_file, const String& image_filepath, u32& out_width, u32& out_height, Buffer& out_pixels);
+
+private:
+    NODISCARD RefPtr<Texture2D> get_or_load_atlas_page(const String& atlas_page_filepath);
+
+private:
+    struct TextureLoadData : public AssetLoadData
+    {
+        String texture_filepath;
+        // Set only if the texture is packed in an atlas page by the texture atlas cooker.
+        String atlas_page_filepath;
+        TextureUVRect uv_rect;
+        u64 atlas_source_hash { 0 };
+        // The contents of the cooked texture file, set only if the texture has been cooked.
+        Buffer cooked_texture;
+        // The decoded source image, set only if the texture is neither packed in an atlas page nor cooked.
+        u32 image_width { 0 };
+        u32 image_height { 0 };
+        Buffer image_pixels;
+    };
+
+    struct AtlasPage
+    {
+        String filepath;
+        RefPtr<Texture2D> texture;
+    };
+
+    // The atlas pages that are referenced by the loaded textures. A page is loaded only once, no matter
+    // how many textures are packed in it.
+    Vector<AtlasPage> m_atlas_pages;
+
+    OwnPtr<TextureAtlas> m_dynamic_atlas;
 };
 
 } // namespace SE
@@ -3,6 +3,7 @@
  * SPDX-License-Identifier: Apache-2.0.
  */
 
+#include <Asset/AssetManager.h>
 #include <Core/String/StringBuilder.h>
 #include <Core/FileSystem/FileSystem.h>
 #include <Core/Log.h>
@@ -17,7 +18,6 @@
 #include <Renderer/Renderer.h>
 #include <Renderer/RendererAPI.h>
 #include <Renderer/RenderingContext.h>
-#include <Serialization/EditorSceneSerializer.h>
 
 // ImGui includes.
 
@@ -51,6 +51,57 @@ struct WindowNativeEventData
 namespace SE
 {
 
+//
+// Deep copy of the ImGui draw data. The draw lists are owned by the ImGui context and they are overwritten by
+// the next frame, so the render thread must consume a copy of them.
+//
+class ClonedImGuiDrawData
+{
+    SE_MAKE_NONCOPYABLE(ClonedImGuiDrawData);
+
+public:
+    ALWAYS_INLINE explicit ClonedImGuiDrawData(const ImDrawData* draw_data)
+        : m_draw_data(*draw_data)
+    {
+        for (ImDrawList*& draw_list : m_draw_data.CmdLists)
+            draw_list = draw_list->CloneOutput();
+    }
+
+    ALWAYS_INLINE ClonedImGuiDrawData(ClonedImGuiDrawData&& other) noexcept
+        : m_draw_data(other.m_draw_data)
+    {
+        other.m_draw_data.CmdLists.clear();
+        other.m_draw_data.CmdListsCount = 0;
+    }
+
+    ALWAYS_INLINE ~ClonedImGuiDrawData()
+    {
+        for (ImDrawList* draw_list : m_draw_data.CmdLists)
+            IM_DELETE(draw_list);
+    }
+
+    NODISCARD ALWAYS_INLINE ImDrawData* get() { return &m_draw_data; }
+
+private:
+    ImDrawData m_draw_data;
+};
+
+static void submit_imgui_draw_data(ImDrawData* draw_data)
+{
+#if SE_RENDERER_API_SUPPORTED_D3D11
+    if (get_current_renderer_api() == RendererAPI::D3D11)
+    {
+        if (Renderer::get_threading_mode() == RendererThreadingMode::SingleThreaded)
+        {
+            ImGui_ImplDX11_RenderDrawData(draw_data);
+            return;
+        }
+
+        Renderer::submit([cloned_draw_data = ClonedImGuiDrawData(draw_data)]() mutable { ImGui_ImplDX11_RenderDrawData(cloned_draw_data.get()); });
+    }
+#endif // SE_RENDERER_API_SUPPORTED_D3D11
+}
+
 bool EditorContext::pre_initialize()
 {
     // The editor executable always has the working directory set to the engine root directory.
@@ -92,6 +143,10 @@ bool EditorContext::initialize()
     // Initialize the component registry.
     m_component_reflector_registry.initialize();
 
+    // The edits made to the scene are saved incrementally.
+    m_active_scene_journal = create_own<SceneJournal>(*m_active_scene, m_component_reflector_registry, "Save.sescene"sv);
+    on_open_scene();
+
     // Create the scene framebuffer and scene renderer.
     FramebufferDescription scene_framebuffer_description = {};
     scene_framebuffer_description.width = 1200;
@@ -170,6 +225,8 @@ bool EditorContext::post_initialize()
     m_entity_inspector_panel.set_scene_context(m_active_scene.get());
     m_entity_inspector_panel.set_component_reflector_registry_context(&m_component_reflector_registry);
 
+    m_output_log_panel.initialize();
+
     m_scene_hierarchy_panel.initialize();
     m_scene_hierarchy_panel.set_scene_context(m_active_scene.get());
     m_scene_hierarchy_panel.add_on_selection_changed_callback(
@@ -190,6 +247,8 @@ bool EditorContext::post_initialize()
             if (viewport_width == 0 || viewport_height == 0)
                 return;
 
+            // The render thread might still be rendering to (or sampling from) the current framebuffer images.
+            Renderer::flush();
             m_scene_framebuffer->invalidate(viewport_width, viewport_height);
             m_scene_renderer->on_resize(viewport_width, viewport_height);
             m_editor_camera.set_viewport_size(viewport_width, viewport_height);
@@ -252,6 +311,9 @@ bool EditorContext::post_initialize()
 
 void EditorContext::shutdown()
 {
+    // Ensure that the render thread has executed all commands before releasing the resources they use.
+    Renderer::flush();
+
     if (is_scene_in_play_state())
     {
         // End the scene play session before shutting down the editor context.
@@ -260,6 +322,7 @@ void EditorContext::shutdown()
 
     m_content_browser_panel.shutdown();
     m_entity_inspector_panel.shutdown();
+    m_output_log_panel.shutdown();
     m_scene_hierarchy_panel.shutdown();
     m_viewport_panel.shutdown();
     m_toolbar_panel.shutdown();
@@ -279,6 +342,7 @@ void EditorContext::shutdown()
     ImGui::DestroyContext();
 
     m_scene_renderer.release();
+    m_active_scene_journal.release();
     m_active_scene.release();
     m_component_reflector_registry.shutdown();
 
@@ -316,7 +380,7 @@ void EditorContext::on_update(float delta_time)
 
     // Submit the ImGui rendering data to the GPU.
     ImGui::Render();
-    ImGui_ImplDX11_RenderDrawData(ImGui::GetDrawData());
+    submit_imgui_draw_data(ImGui::GetDrawData());
     Renderer::end_render_pass();
 
     Renderer::end_frame();
@@ -389,6 +453,9 @@ String EditorContext::get_project_binaries_directory(BuildConfiguration build_co
 
 void EditorContext::on_update_logic(float delta_time)
 {
+    m_active_scene_journal->on_update();
+    g_asset_manager->update();
+
     if (is_scene_in_play_state())
     {
         if (get_scene_play_state() == ScenePlayState::Play)
@@ -441,6 +508,7 @@ void EditorContext::on_update_logic(float delta_time)
 
     m_content_browser_panel.on_update(delta_time);
     m_entity_inspector_panel.on_update(delta_time);
+    m_output_log_panel.on_update(delta_time);
     m_scene_hierarchy_panel.on_update(delta_time);
     m_viewport_panel.on_update(delta_time);
     m_toolbar_panel.on_update(delta_time);
@@ -450,6 +518,7 @@ void EditorContext::on_render_imgui()
 {
     m_content_browser_panel.on_render_imgui();
     m_entity_inspector_panel.on_render_imgui();
+    m_output_log_panel.on_render_imgui();
     m_scene_hierarchy_panel.on_render_imgui();
     m_viewport_panel.on_render_imgui();
     m_toolbar_panel.on_render_imgui();
@@ -489,8 +558,7 @@ void EditorContext::on_scene_camera_mode_set_to_game()
 
 void EditorContext::on_save_scene()
 {
-    EditorSceneSerializer serializer(*m_active_scene, m_component_reflector_registry);
-    if (!serializer.serialize("Save.sescene"sv))
+    if (!m_active_scene_journal->save())
     {
         SE_LOG_ERROR("Failed to serialize active scene to filepath '{}'!", "Save.sescene"sv);
         return;
@@ -498,6 +566,14 @@ void EditorContext::on_save_scene()
 }
 
 void EditorContext::on_open_scene()
-{}
+{
+    if (!m_active_scene_journal->load())
+        return;
+
+    // All the assets referenced by the scene are loaded before its first frame, instead of one at a time when they are first used.
+    Vector<AssetHandle> asset_handles;
+    m_component_reflector_registry.collect_asset_references(*m_active_scene, asset_handles);
+    g_asset_manager->preload(Span<const AssetHandle>(asset_handles.elements(), asset_handles.count()), AssetLoadPriority::Immediate);
+}
 
 } // namespace SE
@@ -10,6 +10,7 @@
 #include <EditorContext/EditorCamera.h>
 #include <EditorContext/Panels/ContentBrowserPanel.h>
 #include <EditorContext/Panels/EntityInspectorPanel.h>
+#include <EditorContext/Panels/OutputLogPanel.h>
 #include <EditorContext/Panels/SceneHierarchyPanel.h>
 #include <EditorContext/Panels/ToolbarPanel.h>
 #include <EditorContext/Panels/ViewportPanel.h>
@@ -20,6 +21,7 @@
 #include <Renderer/Pipeline.h>
 #include <Renderer/RenderPass.h>
 #include <Renderer/SceneRenderer.h>
+#include <Serialization/SceneJournal.h>
 
 namespace SE
 {
@@ -64,6 +66,7 @@ public:
 public:
     NODISCARD ALWAYS_INLINE ContentBrowserPanel& get_content_browser_panel() { return m_content_browser_panel; }
     NODISCARD ALWAYS_INLINE EntityInspectorPanel& get_entity_inspector_panel() { return m_entity_inspector_panel; }
+    NODISCARD ALWAYS_INLINE OutputLogPanel& get_output_log_panel() { return m_output_log_panel; }
     NODISCARD ALWAYS_INLINE SceneHierarchyPanel& get_scene_hierarchy_panel() { return m_scene_hierarchy_panel; }
     NODISCARD ALWAYS_INLINE ViewportPanel& get_viewport_panel() { return m_viewport_panel; }
     NODISCARD ALWAYS_INLINE ToolbarPanel& get_toolbar_panel() { return m_toolbar_panel; }
@@ -97,6 +100,7 @@ private:
     OwnPtr<Window> m_window;
 
     OwnPtr<Scene> m_active_scene;
+    OwnPtr<SceneJournal> m_active_scene_journal;
     EditorCamera m_editor_camera;
     ComponentReflectorRegistry m_component_reflector_registry;
 
@@ -109,6 +113,7 @@ private:
 
     ContentBrowserPanel m_content_browser_panel;
     EntityInspectorPanel m_entity_inspector_panel;
+    OutputLogPanel m_output_log_panel;
     SceneHierarchyPanel m_scene_hierarchy_panel;
     ViewportPanel m_viewport_panel;
     ToolbarPanel m_toolbar_panel;
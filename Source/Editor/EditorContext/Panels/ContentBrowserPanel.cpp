@@ -3,7 +3,13 @@
  * SPDX-License-Identifier: Apache-2.0.
  */
 
+#include <Core/String/StringBuilder.h>
+#include <EditorAsset/AssetPackBuilder.h>
+#include <EditorAsset/EditorAssetManager.h>
+#include <EditorAsset/TextureAtlasCooker.h>
+#include <EditorAsset/TextureCooker.h>
 #include <EditorContext/Panels/ContentBrowserPanel.h>
+#include <EditorEngine.h>
 #include <imgui.h>
 
 namespace SE
@@ -23,6 +29,25 @@ void ContentBrowserPanel::on_update(float delta_time)
 void ContentBrowserPanel::on_render_imgui()
 {
     ImGui::Begin("ContentBrowser");
+
+    if (ImGui::Button("Cook Texture Atlas"))
+    {
+        const Vector<AssetHandle> texture_handles = g_editor_asset_manager->get_asset_handles_of_type(AssetType::Texture);
+        TextureAtlasCooker::cook(texture_handles.span(), "TextureAtlas"sv, TextureAtlasDescription());
+    }
+
+    if (ImGui::Button("Cook Textures"))
+    {
+        const Vector<AssetHandle> texture_handles = g_editor_asset_manager->get_asset_handles_of_type(AssetType::Texture);
+        TextureCooker::cook(texture_handles.span(), TextureCookDescription());
+    }
+
+    if (ImGui::Button("Build Asset Pack"))
+    {
+        const String pack_filepath = StringBuilder::path_join({ g_editor_engine->context().get_project_root_directory().view(), "Content.sepak"sv });
+        AssetPackBuilder::build(pack_filepath, AssetPackBuildDescription());
+    }
+
     ImGui::End();
 }
 
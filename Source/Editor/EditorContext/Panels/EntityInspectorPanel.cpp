@@ -6,6 +6,7 @@
 #include <Core/Math/Color.h>
 #include <Core/Math/Vector.h>
 #include <Core/String/Format.h>
+#include <EditorAsset/EditorAssetManager.h>
 #include <EditorContext/Panels/EntityInspectorPanel.h>
 #include <Engine/Scene/Entity.h>
 #include <Engine/Scene/Reflection/ComponentReflectorRegistry.h>
@@ -196,6 +197,12 @@ void EntityInspectorPanel::draw_component(EntityComponent* component)
 
     if (is_tree_node_opened)
     {
+        // NOTE: The fields are modified directly in memory, so the scene has to be notified when a field
+        //       that might affect the entity bounds (such as the transform translation or scale) changes.
+        //       Any modification also has to be recorded, so the entity is saved with the next scene save.
+        bool has_modified_field = false;
+        bool has_modified_spatial_field = false;
+
         for (const ComponentField& field : reflector.fields)
         {
             switch (field.type_stack.first())
@@ -208,7 +215,7 @@ void EntityInspectorPanel::draw_component(EntityComponent* component)
                         display_value *= Math::degrees(1.0F);
 
                     if (ImGui::DragFloat(field.name.characters(), &display_value))
-                        display_value;
+                        has_modified_field = true;
 
                     if (field.metadata.has_flag(ComponentFieldFlag::DisplayInDegrees))
                         display_value *= Math::radians(1.0F);
@@ -224,7 +231,10 @@ void EntityInspectorPanel::draw_component(EntityComponent* component)
                         display_value *= Math::degrees(1.0F);
 
                     if (ImGui::DragFloat3(field.name.characters(), display_value.value_ptr()))
-                        display_value;
+                    {
+                        has_modified_field = true;
+                        has_modified_spatial_field = true;
+                    }
 
                     if (field.metadata.has_flag(ComponentFieldFlag::DisplayInDegrees))
                         display_value *= Math::radians(1.0F);
@@ -235,7 +245,8 @@ void EntityInspectorPanel::draw_component(EntityComponent* component)
                 case ComponentFieldType::Color4:
                 {
                     Color4& field_value = field.get_value<Color4>(component);
-                    ImGui::ColorEdit4(field.name.characters(), field_value.value_ptr());
+                    if (ImGui::ColorEdit4(field.name.characters(), field_value.value_ptr()))
+                        has_modified_field = true;
                 }
                 break;
 
@@ -248,12 +259,55 @@ void EntityInspectorPanel::draw_component(EntityComponent* component)
                     copy_memory_from_span(field_value_buffer, field_value.byte_span());
 
                     if (ImGui::InputText(field.name.characters(), field_value_buffer, sizeof(field_value_buffer)))
+                    {
                         field_value = StringView::create_from_utf8(field_value_buffer);
+                        has_modified_field = true;
+                    }
+                }
+                break;
+
+                case ComponentFieldType::AssetReferenceTexture:
+                {
+                    AssetHandle& field_value = field.get_value<AssetHandle>(component);
+                    const char* preview_label = "None";
+                    if (field_value.is_valid())
+                        preview_label = g_editor_asset_manager->get_editor_metadata(field_value).filepath.characters();
+
+                    if (ImGui::BeginCombo(field.name.characters(), preview_label))
+                    {
+                        if (ImGui::Selectable("None", !field_value.is_valid()))
+                        {
+                            field_value = AssetHandle::invalid();
+                            has_modified_field = true;
+                        }
+
+                        for (const AssetHandle texture_handle : g_editor_asset_manager->get_asset_handles_of_type(AssetType::Texture))
+                        {
+                            const EditorAssetMetadata& texture_metadata = g_editor_asset_manager->get_editor_metadata(texture_handle);
+                            // Memory-only textures can't be referenced, as they are not saved with the project.
+                            if (texture_metadata.is_memory_only)
+                                continue;
+
+                            ImGui::PushID(&texture_metadata);
+                            if (ImGui::Selectable(texture_metadata.filepath.characters(), texture_handle == field_value))
+                            {
+                                field_value = texture_handle;
+                                has_modified_field = true;
+                            }
+                            ImGui::PopID();
+                        }
+                        ImGui::EndCombo();
+                    }
                 }
                 break;
             }
         }
 
+        if (has_modified_spatial_field)
+            m_scene_context->update_entity_spatial_bounds(*component->parent_entity());
+        if (has_modified_field)
+            m_scene_context->mark_entity_modified(component->parent_entity()->uuid());
+
         ImGui::TreePop();
     }
 
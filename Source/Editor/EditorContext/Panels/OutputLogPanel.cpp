@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <EditorContext/Panels/OutputLogPanel.h>
+#include <imgui.h>
+
+namespace SE
+{
+
+// clang-format off
+static ImVec4 s_severity_color_table[5] = {
+    ImVec4(0.55F, 0.55F, 0.55F, 1.0F),
+    ImVec4(0.40F, 0.85F, 0.40F, 1.0F),
+    ImVec4(0.95F, 0.85F, 0.35F, 1.0F),
+    ImVec4(0.95F, 0.40F, 0.40F, 1.0F),
+    ImVec4(1.00F, 0.20F, 0.20F, 1.0F),
+};
+// clang-format on
+
+OutputLogPanel::OutputLogPanel()
+    : m_log_sink(max_message_count)
+{}
+
+bool OutputLogPanel::initialize()
+{
+    Logger::add_sink(&m_log_sink);
+    return true;
+}
+
+void OutputLogPanel::shutdown()
+{
+    Logger::remove_sink(&m_log_sink);
+}
+
+void OutputLogPanel::on_update(float delta_time)
+{}
+
+void OutputLogPanel::on_render_imgui()
+{
+    ImGui::Begin("Output Log");
+
+    if (ImGui::Button("Clear"))
+        m_log_sink.clear();
+    ImGui::SameLine();
+    ImGui::Checkbox("Auto-scroll", &m_auto_scroll);
+    ImGui::Separator();
+
+    ImGui::BeginChild("OutputLogMessages", ImVec2(0.0F, 0.0F), false, ImGuiWindowFlags_HorizontalScrollbar);
+    {
+        // NOTE: The sink is locked while its messages are rendered, so the logger thread can't modify them.
+        ScopedLock log_sink_lock(m_log_sink.get_mutex());
+
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int>(m_log_sink.get_entry_count()));
+        while (clipper.Step())
+        {
+            for (int entry_index = clipper.DisplayStart; entry_index < clipper.DisplayEnd; ++entry_index)
+            {
+                const MemoryLogSink::Entry& entry = m_log_sink.get_entry(static_cast<u32>(entry_index));
+                const char* line_begin = entry.line.characters();
+                ImGui::PushStyleColor(ImGuiCol_Text, s_severity_color_table[entry.severity]);
+                ImGui::TextUnformatted(line_begin, line_begin + entry.line.byte_count());
+                ImGui::PopStyleColor();
+            }
+        }
+
+        // Only scroll to the newest message if there are new messages, so the user can still scroll up while the auto-scroll is enabled.
+        if (m_auto_scroll && m_rendered_log_version != m_log_sink.get_version())
+            ImGui::SetScrollHereY(1.0F);
+        m_rendered_log_version = m_log_sink.get_version();
+    }
+    ImGui::EndChild();
+
+    ImGui::End();
+}
+
+} // namespace SE
@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/LogSinks.h>
+
+namespace SE
+{
+
+//
+// Displays the most recent messages that were logged, which are collected by an in-memory log sink.
+//
+class OutputLogPanel
+{
+public:
+    static constexpr u32 max_message_count = 2048;
+
+public:
+    OutputLogPanel();
+
+    bool initialize();
+    void shutdown();
+
+    void on_update(float delta_time);
+    void on_render_imgui();
+
+private:
+    MemoryLogSink m_log_sink;
+    // The version of the sink when the panel was last rendered, used to detect new messages.
+    u64 m_rendered_log_version { 0 };
+    bool m_auto_scroll { true };
+};
+
+} // namespace SE
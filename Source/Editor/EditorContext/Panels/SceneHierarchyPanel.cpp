@@ -63,6 +63,13 @@ void SceneHierarchyPanel::on_render_imgui()
             is_any_entry_clicked = is_any_entry_clicked || entry_is_clicked;
         }
 
+        if (m_entity_to_destroy_uuid.has_value())
+        {
+            // NOTE: The entity is destroyed only after all entries have been drawn, as the entries reference the entities directly.
+            m_scene_context->destroy_entity(m_entity_to_destroy_uuid.value());
+            m_entity_to_destroy_uuid.clear();
+        }
+
         if (!is_any_entry_clicked && ImGui::IsWindowHovered())
         {
             if (ImGui::IsMouseClicked(ImGuiMouseButton_Left))
@@ -143,8 +150,7 @@ bool SceneHierarchyPanel::draw_entity_entry(const EntityEntry& entry)
         ImGui::SeparatorText("Entity Options");
         if (ImGui::MenuItem("Remove Entity"))
         {
-            // TODO: Actually remove the entity from the scene.
-            // This function is not yet implemented as there is no API for removing entities from a scene.
+            m_entity_to_destroy_uuid = entry.entity.uuid();
             clear_selected_entity();
         }
         ImGui::EndPopup();
@@ -61,6 +61,7 @@ private:
     Scene* m_scene_context;
 
     Optional<UUID> m_selected_entity_uuid;
+    Optional<UUID> m_entity_to_destroy_uuid;
     Vector<PFN_OnSceneHierarchySelectionChanged> m_on_selection_changed_callbacks;
 };
 
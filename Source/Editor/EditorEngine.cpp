@@ -37,7 +37,7 @@ bool EditorEngine::initialize()
         return false;
     }
 
-    if (!Renderer::initialize())
+    if (!Renderer::initialize(RendererThreadingMode::RenderThread))
     {
         SE_LOG_ERROR("Failed to initialize the renderer!");
         return false;
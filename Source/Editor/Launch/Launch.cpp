@@ -5,6 +5,7 @@
 
 #include <Core/Containers/Span.h>
 #include <Core/FileSystem/FileSystem.h>
+#include <Core/LogSinks.h>
 #include <Core/Platform/Platform.h>
 #include <EditorEngine.h>
 
@@ -26,11 +27,36 @@ static i32 guarded_main(Span<char*> command_line_arguments)
     // Set the engine root as the process working directory.
     FileSystem::set_working_directory("../../"sv);
 
+    // Start the logger. The sinks must outlive it, as the logger thread writes the remaining messages when it is shut down.
+    ConsoleLogSink console_log_sink;
+    FileLogSink file_log_sink("Logs/Editor.log"sv);
+    // Can be converted to text by the log decoder tool.
+    BinaryFileLogSink binary_file_log_sink("Logs/Editor.binlog"sv);
+    if (!Logger::initialize())
+        return 1;
+    Logger::add_sink(&console_log_sink);
+    Logger::add_sink(&file_log_sink);
+    Logger::add_sink(&binary_file_log_sink);
+
+    // Apply the log filters from the configuration file, and then from the command line (`--log-filters=Renderer=Warn,Asset=Trace`).
+    Logger::apply_filters_from_file("Content/Config/LogFilters.ini"sv);
+    const StringView log_filters_argument_prefix = "--log-filters="sv;
+    for (char* command_line_argument : command_line_arguments)
+    {
+        const StringView argument = StringView::create_from_utf8(command_line_argument);
+        if (argument.byte_count() >= log_filters_argument_prefix.byte_count() &&
+            argument.slice(0, log_filters_argument_prefix.byte_count()) == log_filters_argument_prefix)
+        {
+            Logger::apply_filters(argument.slice(log_filters_argument_prefix.byte_count()));
+        }
+    }
+
     // Initialize the engine.
     Engine::instantiate<EditorEngine>();
     if (!g_engine->initialize())
     {
-        // TODO: Log error message.
+        SE_LOG_FATAL("Failed to initialize the engine!");
+        Logger::shutdown();
         return 1;
     }
 
@@ -42,6 +68,7 @@ static i32 guarded_main(Span<char*> command_line_arguments)
     g_engine->shutdown();
     Engine::destroy();
 
+    Logger::shutdown();
     Platform::shutdown();
     return 0;
 }
@@ -3,11 +3,19 @@
  * SPDX-License-Identifier: Apache-2.0.
  */
 
+#include <Core/Containers/Hash.h>
 #include <Core/FileSystem/FileSystem.h>
 #include <Core/Log.h>
+#include <Core/String/ChunkedOutputBuffer.h>
+#include <Core/String/NumberParsing.h>
+#include <Core/String/StringBuilder.h>
 #include <Engine/Scene/Reflection/ComponentReflectorRegistry.h>
 #include <Engine/Scene/Scene.h>
 #include <Serialization/EditorSceneSerializer.h>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <yaml-cpp/eventhandler.h>
 #include <yaml-cpp/shooteryaml.h>
 
 namespace SE
@@ -19,6 +27,45 @@ ALWAYS_INLINE static YAML::Emitter& operator<<(YAML::Emitter& out, const Compone
     return out;
 }
 
+//
+// Every document of a journal is preceded by a header line, "# Journal entry <byte count> <checksum>", where both values
+// are written as 16 hexadecimal digits. The header is a YAML comment, so it is ignored by the parser.
+//
+static constexpr StringView s_journal_entry_header_prefix = "# Journal entry "sv;
+static constexpr usize s_journal_entry_header_byte_count = s_journal_entry_header_prefix.byte_count() + 2 * (16 + 1);
+
+// Returns the number of bytes at the beginning of the journal that are occupied by entries which were completely written.
+NODISCARD static usize get_journal_valid_byte_count(ReadonlyByteSpan journal_bytes)
+{
+    const usize prefix_byte_count = s_journal_entry_header_prefix.byte_count();
+    usize offset = 0;
+    while (journal_bytes.count() - offset >= s_journal_entry_header_byte_count)
+    {
+        const char* header_characters = reinterpret_cast<const char*>(journal_bytes.elements() + offset);
+        const StringView header = StringView::unsafe_create_from_utf8(header_characters, s_journal_entry_header_byte_count);
+
+        u64 document_byte_count;
+        u64 document_checksum;
+        if (header.slice(0, prefix_byte_count) != s_journal_entry_header_prefix || header_characters[prefix_byte_count + 16] != ' ' ||
+            header_characters[s_journal_entry_header_byte_count - 1] != '\n' ||
+            !parse_integer(header.slice(prefix_byte_count, 16), document_byte_count, 16) ||
+            !parse_integer(header.slice(prefix_byte_count + 17, 16), document_checksum, 16))
+        {
+            break;
+        }
+
+        const usize document_offset = offset + s_journal_entry_header_byte_count;
+        if (document_byte_count > journal_bytes.count() - document_offset)
+            break;
+        if (hash_memory(journal_bytes.slice(document_offset, document_byte_count)) != document_checksum)
+            break;
+
+        offset = document_offset + document_byte_count;
+    }
+
+    return offset;
+}
+
 bool EditorSceneSerializer::serialize(const String& filepath)
 {
     Vector<const Entity*> entities_sorted_by_uuid;
@@ -41,33 +88,142 @@ bool EditorSceneSerializer::serialize(const String& filepath)
         }
     );
 
-    YAML::Emitter out;
-    out << YAML::BeginMap; // Root map.
+    // NOTE: The scene is streamed to a temporary file while it is serialized, so the whole document is never stored in
+    //       memory. The scene file is replaced by the temporary file only if the scene was entirely serialized.
+    const String temporary_filepath = StringBuilder::join({ filepath.view(), ".tmp"sv });
+    FileWriter scene_file_writer;
+    if (scene_file_writer.open(temporary_filepath) != FileError::Success)
+    {
+        SE_LOG_TAG_ERROR("Editor", "Failed to open the scene file '{}' for writing!", temporary_filepath);
+        return false;
+    }
+
+    bool has_serialized_scene = true;
+    {
+        ChunkedOutputBuffer scene_buffer(scene_file_writer);
+        YAML::FormatBuilderStreamBuffer scene_stream_buffer(scene_buffer);
+        std::ostream scene_stream(&scene_stream_buffer);
 
-    out << YAML::Key << "UUID" << YAML::Value << UUID::invalid();
-    out << YAML::Key << "Name" << YAML::Value << "Unnamed Scene";
+        YAML::Emitter out(scene_stream);
+        out << YAML::BeginMap; // Root map.
 
-    out << YAML::Key << "Entities" << YAML::BeginSeq;
+        out << YAML::Key << "UUID" << YAML::Value << UUID::invalid();
+        out << YAML::Key << "Name" << YAML::Value << "Unnamed Scene";
+
+        out << YAML::Key << "Entities" << YAML::BeginSeq;
 
-    SE_LOG_TAG_INFO("Editor", "Serializing '{}' entities.", entities_sorted_by_uuid.count());
-    for (const Entity* entity : entities_sorted_by_uuid)
+        SE_LOG_TAG_INFO("Editor", "Serializing '{}' entities.", entities_sorted_by_uuid.count());
+        for (const Entity* entity : entities_sorted_by_uuid)
+        {
+            if (!serialize_entity(out, *entity))
+            {
+                has_serialized_scene = false;
+                break;
+            }
+        }
+
+        out << YAML::EndSeq; // Entities.
+        out << YAML::EndMap; // Root.
+
+        scene_buffer.flush();
+        has_serialized_scene = has_serialized_scene && (scene_buffer.file_error() == FileError::Success);
+    }
+    scene_file_writer.close();
+
+    if (!has_serialized_scene || !FileSystem::move_file(temporary_filepath, filepath))
+    {
+        SE_LOG_TAG_ERROR("Editor", "Failed to serialize the scene to filepath '{}'!", filepath);
+        FileSystem::delete_file(temporary_filepath);
+        return false;
+    }
+
+    const String journal_filepath = get_journal_filepath(filepath);
+    if (FileSystem::exists(journal_filepath) && !FileSystem::delete_file(journal_filepath))
     {
+        SE_LOG_TAG_ERROR("Editor", "Failed to delete the outdated scene journal '{}'!", journal_filepath);
+        return false;
+    }
+
+    SE_LOG_TAG_INFO("Editor", "Serialized scene to filepath '{}'.", filepath);
+    return true;
+}
+
+bool EditorSceneSerializer::serialize_changes(const String& filepath)
+{
+    const HashMap<UUID, SceneEntityChange>& entity_changes = m_scene_context.get_entity_changes();
+    if (entity_changes.is_empty())
+        return true;
+
+    // NOTE: The document is built in a contiguous buffer, so its checksum can be calculated before it is written.
+    FormatMemoryBuilder<4 * KiB> journal_document;
+    YAML::FormatBuilderStreamBuffer journal_stream_buffer(journal_document);
+    std::ostream journal_stream(&journal_stream_buffer);
+
+    YAML::Emitter out(journal_stream);
+    out << YAML::BeginDoc;
+    out << YAML::BeginMap; // Root map.
+
+    out << YAML::Key << "Entities" << YAML::BeginSeq;
+    for (const auto entity_change : entity_changes)
+    {
+        if (entity_change.value != SceneEntityChange::Modified)
+            continue;
+
+        const Entity* entity = m_scene_context.get_entity_from_uuid(entity_change.key);
+        SE_ASSERT(entity != nullptr);
         if (!serialize_entity(out, *entity))
             return false;
     }
-
     out << YAML::EndSeq; // Entities.
+
+    out << YAML::Key << "DestroyedEntities" << YAML::BeginSeq;
+    for (const auto entity_change : entity_changes)
+    {
+        if (entity_change.value == SceneEntityChange::Destroyed)
+            out << entity_change.key;
+    }
+    out << YAML::EndSeq; // DestroyedEntities.
+
     out << YAML::EndMap; // Root.
-    const StringView yaml_string_view = StringView::unsafe_create_from_utf8(out.c_str(), out.size());
+    out << YAML::Newline;
 
-    FileWriter scene_file_writer;
-    SE_CHECK_FILE_ERROR(scene_file_writer.open(filepath));
-    SE_CHECK_FILE_ERROR(scene_file_writer.write_and_close(yaml_string_view.byte_span()));
+    const String journal_filepath = get_journal_filepath(filepath);
+    FileWriter journal_file_writer;
+    if (journal_file_writer.open(journal_filepath, true) != FileError::Success)
+    {
+        SE_LOG_TAG_ERROR("Editor", "Failed to open the scene journal '{}' for writing!", journal_filepath);
+        return false;
+    }
 
-    SE_LOG_TAG_INFO("Editor", "Serialized scene to filepath '{}'.", filepath);
+    //
+    // The editor can be closed while the entry is being written, so the document is preceded by a header that stores its
+    // byte count and checksum. A torn entry at the end of the journal is detected by the header and skipped on replay.
+    //
+    const StringView document = journal_document.view();
+    char header_buffer[s_journal_entry_header_byte_count];
+    const u64 document_checksum = hash_memory(document.byte_span());
+    const Optional<StringView> header =
+        format_to(Span<char>(header_buffer, sizeof(header_buffer)), "# Journal entry {:016x} {:016x}\n"sv, document.byte_count(), document_checksum);
+    SE_ASSERT(header.has_value() && header->byte_count() == s_journal_entry_header_byte_count);
+
+    const ReadonlyByteSpan journal_entry[] = { header->byte_span(), document.byte_span() };
+    const FileError journal_file_error = journal_file_writer.write_gather(Span<const ReadonlyByteSpan>(journal_entry, SE_ARRAY_COUNT(journal_entry)));
+    journal_file_writer.close();
+    if (journal_file_error != FileError::Success)
+    {
+        SE_LOG_TAG_ERROR("Editor", "Failed to write the scene journal '{}'!", journal_filepath);
+        return false;
+    }
+
+    SE_LOG_TAG_INFO("Editor", "Saved '{}' entity changes to the scene journal '{}'.", entity_changes.count(), journal_filepath);
     return true;
 }
 
+String EditorSceneSerializer::get_journal_filepath(const String& filepath)
+{
+    return StringBuilder::join({ filepath.view(), ".journal"sv });
+}
+
 bool EditorSceneSerializer::serialize_entity(YAML::Emitter& emitter, const Entity& entity)
 {
     emitter << YAML::BeginMap; // Entity map.
@@ -91,7 +247,7 @@ bool EditorSceneSerializer::serialize_entity_component(YAML::Emitter& emitter, c
     emitter << YAML::BeginMap; // Component map.
     const ComponentReflector& reflector = m_component_reflector_registry_context.get_reflector(component.get_component_type_uuid());
 
-    emitter << YAML::Key << "Name" << reflector.name;
+    emitter << YAML::Key << "Name" << reflector.name.view();
     emitter << YAML::Key << "TypeUUID" << component.get_component_type_uuid();
     emitter << YAML::Key << "Fields" << YAML::BeginSeq;
 
@@ -109,7 +265,7 @@ bool EditorSceneSerializer::serialize_entity_component(YAML::Emitter& emitter, c
 bool EditorSceneSerializer::serialize_component_field(YAML::Emitter& emitter, const EntityComponent& component, const ComponentField& field)
 {
     emitter << YAML::BeginMap;
-    emitter << YAML::Key << "Name" << YAML::Value << field.name;
+    emitter << YAML::Key << "Name" << YAML::Value << field.name.view();
     emitter << YAML::Key << "Type" << YAML::Value << field.type_stack.first();
     emitter << YAML::Key << "Value" << YAML::Value;
 
@@ -135,144 +291,745 @@ bool EditorSceneSerializer::serialize_component_field(YAML::Emitter& emitter, co
         CASE_STATEMENT(String, String);
 
 #undef CASE_STATEMENT
+
+        case ComponentFieldType::AssetReferenceTexture: emitter << field.get_value<AssetHandle>(&component).value(); break;
     }
 
     emitter << YAML::EndMap;
     return true;
 }
 
-bool EditorSceneSerializer::deserialize(const String& filepath)
+//==============================================================================================================
+// DESERIALIZATION.
+//==============================================================================================================
+
+//
+// Read-only stream buffer over a block of memory. Used to feed the memory mapped scene file to the YAML parser without copying it.
+//
+class MemoryStreamBuffer : public std::streambuf
+{
+public:
+    explicit MemoryStreamBuffer(ReadonlyByteSpan bytes)
+    {
+        char* begin = const_cast<char*>(reinterpret_cast<const char*>(bytes.elements()));
+        setg(begin, begin, begin + bytes.count());
+    }
+};
+
+//
+// The scalars are decoded directly from the text received by the event handler, without creating a YAML node for each
+// one. The accepted spellings are the same as the ones accepted by the YAML node conversions.
+//
+NODISCARD ALWAYS_INLINE static StringView get_yaml_scalar_view(const std::string& scalar)
 {
-    FileReader scene_file_reader;
-    SE_CHECK_FILE_ERROR(scene_file_reader.open(filepath));
-    String scene_file;
-    SE_CHECK_FILE_ERROR(scene_file_reader.read_entire_to_string_and_close(scene_file));
+    // NOTE: The view is only parsed as a number, which rejects any invalid character, so the UTF-8 validation is skipped.
+    return StringView::unsafe_create_from_utf8(scalar.data(), scalar.size());
+}
+
+template<typename T>
+requires (is_integral<T>)
+NODISCARD ALWAYS_INLINE static bool decode_yaml_scalar(const std::string& scalar, T& out_value)
+{
+    return parse_integer(get_yaml_scalar_view(scalar), out_value);
+}
 
-    YAML::Node scene = YAML::Load(scene_file.characters());
-    if (!scene)
+template<typename T>
+NODISCARD ALWAYS_INLINE static bool decode_yaml_floating_point_scalar(const std::string& scalar, T& out_value)
+{
+    if (scalar == ".inf" || scalar == ".Inf" || scalar == ".INF" || scalar == "+.inf" || scalar == "+.Inf" || scalar == "+.INF")
     {
-        SE_LOG_TAG_ERROR("Editor", "Failed to load the root YAML node from scene file '{}'!", filepath);
+        out_value = std::numeric_limits<T>::infinity();
+        return true;
+    }
+    if (scalar == "-.inf" || scalar == "-.Inf" || scalar == "-.INF")
+    {
+        out_value = -std::numeric_limits<T>::infinity();
+        return true;
+    }
+    if (scalar == ".nan" || scalar == ".NaN" || scalar == ".NAN")
+    {
+        out_value = std::numeric_limits<T>::quiet_NaN();
+        return true;
+    }
+
+    return parse_floating_point(get_yaml_scalar_view(scalar), out_value);
+}
+
+NODISCARD ALWAYS_INLINE static bool decode_yaml_scalar(const std::string& scalar, float& out_value)
+{
+    return decode_yaml_floating_point_scalar(scalar, out_value);
+}
+
+NODISCARD ALWAYS_INLINE static bool decode_yaml_scalar(const std::string& scalar, double& out_value)
+{
+    return decode_yaml_floating_point_scalar(scalar, out_value);
+}
+
+NODISCARD static bool decode_yaml_scalar(const std::string& scalar, bool& out_value)
+{
+    // The booleans can be written in lowercase, capitalized or uppercase (such as "true", "True" or "TRUE").
+    constexpr usize max_boolean_byte_count = 5;
+    if (scalar.empty() || scalar.size() > max_boolean_byte_count)
         return false;
+
+    auto is_lowercase = [](char character) -> bool { return ('a' <= character && character <= 'z'); };
+    auto is_uppercase = [](char character) -> bool { return ('A' <= character && character <= 'Z'); };
+
+    bool is_rest_lowercase = true;
+    bool is_rest_uppercase = true;
+    for (usize offset = 1; offset < scalar.size(); ++offset)
+    {
+        is_rest_lowercase &= is_lowercase(scalar[offset]);
+        is_rest_uppercase &= is_uppercase(scalar[offset]);
     }
+    if (!(is_rest_lowercase && (is_lowercase(scalar[0]) || is_uppercase(scalar[0]))) && !(is_rest_uppercase && is_uppercase(scalar[0])))
+        return false;
 
-    const UUID scene_uuid = scene["UUID"].as<UUID>();
-    const String scene_name = scene["Name"].as<String>();
-    SE_LOG_TAG_TRACE("Editor", "Deserializing scene '{}' (UUID: {})", scene_name, scene_uuid);
+    char lowercase_characters[max_boolean_byte_count];
+    for (usize offset = 0; offset < scalar.size(); ++offset)
+        lowercase_characters[offset] = is_uppercase(scalar[offset]) ? static_cast<char>(scalar[offset] - 'A' + 'a') : scalar[offset];
+    const StringView lowercase = StringView::unsafe_create_from_utf8(lowercase_characters, scalar.size());
 
-    YAML::Node entities = scene["Entities"];
-    if (!entities || !entities.IsSequence())
+    if (lowercase == "true"sv || lowercase == "yes"sv || lowercase == "on"sv || lowercase == "y"sv)
     {
-        SE_LOG_TAG_ERROR("Editor", "Scene file is corrupted! No 'Entities' node found!");
+        out_value = true;
+        return true;
+    }
+    if (lowercase == "false"sv || lowercase == "no"sv || lowercase == "off"sv || lowercase == "n"sv)
+    {
+        out_value = false;
+        return true;
+    }
+    return false;
+}
+
+NODISCARD static bool decode_yaml_scalar(const std::string& scalar, UUID& out_value)
+{
+    // The UUIDs are always written with 16 hexadecimal digits.
+    u64 uuid_value;
+    if (scalar.size() != 16 || !parse_integer(get_yaml_scalar_view(scalar), uuid_value, 16))
         return false;
+
+    out_value = UUID(uuid_value);
+    return true;
+}
+
+//
+// Receives the events emitted by the YAML parser and builds the scene while the file is being parsed.
+// The handler keeps a stack with the collections that are currently open and only the state of the entity, component
+// and field that are being read. The keys are expected in the order in which the serializer writes them: the UUID of
+// an entity before its components, the type of a component before its fields.
+//
+class SceneYAMLEventHandler final : public YAML::EventHandler
+{
+public:
+    explicit SceneYAMLEventHandler(EditorSceneSerializer& serializer)
+        : m_serializer(serializer)
+    {}
+
+    NODISCARD ALWAYS_INLINE bool has_failed() const { return m_has_failed; }
+    NODISCARD ALWAYS_INLINE bool has_found_entities() const { return m_has_found_entities; }
+
+public:
+    virtual void OnDocumentStart(const YAML::Mark& mark) override {}
+    virtual void OnDocumentEnd() override {}
+
+    virtual void OnNull(const YAML::Mark& mark, YAML::anchor_t anchor) override { on_scalar(mark, {}); }
+    virtual void OnAlias(const YAML::Mark& mark, YAML::anchor_t anchor) override { fail(mark, "YAML aliases are not supported"sv); }
+    virtual void OnScalar(const YAML::Mark& mark, const std::string& tag, YAML::anchor_t anchor, const std::string& value) override { on_scalar(mark, value); }
+
+    virtual void OnSequenceStart(const YAML::Mark& mark, const std::string& tag, YAML::anchor_t anchor, YAML::EmitterStyle::value style) override
+    {
+        on_collection_start(mark, false);
     }
 
-    for (const YAML::Node& entity_node : entities)
+    virtual void OnMapStart(const YAML::Mark& mark, const std::string& tag, YAML::anchor_t anchor, YAML::EmitterStyle::value style) override
     {
-        if (!deserialize_entity(entity_node))
-            return false;
+        on_collection_start(mark, true);
     }
 
-    return true;
+    virtual void OnSequenceEnd() override { on_collection_end(); }
+    virtual void OnMapEnd() override { on_collection_end(); }
+
+private:
+    enum class Scope : u8
+    {
+        Root,
+        Entities,
+        DestroyedEntities,
+        Entity,
+        Components,
+        Component,
+        Fields,
+        Field,
+        FieldValue,
+        // A collection that is not part of the scene format. Its contents are ignored.
+        Skipped,
+    };
+
+    struct ScopeState
+    {
+        Scope scope;
+        bool is_map;
+        // Only used by the maps, as their items alternate between keys and values.
+        bool is_expecting_key;
+    };
+
+    // The values of the fields that have the most components (Vector4 and Color4).
+    static constexpr u32 max_field_value_scalar_count = 4;
+
+private:
+    void on_scalar(const YAML::Mark& mark, const std::string& value);
+    void on_collection_start(const YAML::Mark& mark, bool is_map);
+    void on_collection_end();
+
+    // Must be called after each item of a collection has been fully read.
+    void on_item_end();
+
+    bool begin_entity_components();
+    bool end_entity();
+    void begin_component_fields();
+    bool end_component();
+    bool end_field();
+
+    void fail(const YAML::Mark& mark, StringView message);
+
+private:
+    EditorSceneSerializer& m_serializer;
+    Vector<ScopeState> m_scopes;
+    std::string m_current_key;
+    YAML::Mark m_last_mark;
+    bool m_has_failed { false };
+    bool m_has_found_entities { false };
+    String m_scene_name;
+    UUID m_scene_uuid { UUID::invalid() };
+
+    // The state of the entity that is currently being read.
+    UUID m_entity_uuid { UUID::invalid() };
+    String m_entity_name;
+    Entity* m_entity { nullptr };
+
+    // The state of the component that is currently being read.
+    UUID m_component_type_uuid { UUID::invalid() };
+    bool m_has_component_fields { false };
+    const ComponentReflector* m_component_reflector { nullptr };
+    EntityComponent* m_component { nullptr };
+
+    // The state of the field that is currently being read.
+    Name m_field_name;
+    ComponentFieldType m_field_type { ComponentFieldType::Unknown };
+    std::string m_field_value_scalars[max_field_value_scalar_count];
+    u32 m_field_value_scalar_count { 0 };
+};
+
+void SceneYAMLEventHandler::on_scalar(const YAML::Mark& mark, const std::string& value)
+{
+    m_last_mark = mark;
+    if (m_has_failed)
+        return;
+
+    if (m_scopes.is_empty())
+    {
+        fail(mark, "The root YAML node must be a map"sv);
+        return;
+    }
+
+    ScopeState& scope_state = m_scopes.last();
+    if (scope_state.is_map && scope_state.is_expecting_key)
+    {
+        m_current_key = value;
+        scope_state.is_expecting_key = false;
+        return;
+    }
+
+    bool is_valid = true;
+    switch (scope_state.scope)
+    {
+        case Scope::Root:
+        {
+            if (m_current_key == "UUID")
+                is_valid = decode_yaml_scalar(value, m_scene_uuid);
+            else if (m_current_key == "Name")
+                m_scene_name = StringView::create_from_utf8(value.data(), value.size());
+            break;
+        }
+
+        case Scope::DestroyedEntities:
+        {
+            UUID entity_uuid;
+            is_valid = decode_yaml_scalar(value, entity_uuid);
+            if (is_valid)
+                m_serializer.m_scene_context.destroy_entity(entity_uuid);
+            break;
+        }
+
+        case Scope::Entity:
+        {
+            if (m_current_key == "UUID")
+                is_valid = decode_yaml_scalar(value, m_entity_uuid);
+            else if (m_current_key == "Name")
+                m_entity_name = StringView::create_from_utf8(value.data(), value.size());
+            break;
+        }
+
+        case Scope::Component:
+        {
+            if (m_current_key == "TypeUUID")
+                is_valid = decode_yaml_scalar(value, m_component_type_uuid);
+            break;
+        }
+
+        case Scope::Field:
+        {
+            if (m_current_key == "Name")
+            {
+                // A name that has never been interned can't be the name of any reflected field, so it is not added to the name table.
+                m_field_name = Name::find(StringView::create_from_utf8(value.data(), value.size())).value_or(Name());
+            }
+            else if (m_current_key == "Type")
+            {
+                m_field_type = get_component_field_type_from_string(StringView::create_from_utf8(value.data(), value.size()));
+            }
+            else if (m_current_key == "Value")
+            {
+                m_field_value_scalars[0] = value;
+                m_field_value_scalar_count = 1;
+            }
+            break;
+        }
+
+        case Scope::FieldValue:
+        {
+            // Values with too many components are detected when the field is applied, as the count doesn't match the field type.
+            if (m_field_value_scalar_count < max_field_value_scalar_count)
+                m_field_value_scalars[m_field_value_scalar_count] = value;
+            m_field_value_scalar_count++;
+            break;
+        }
+
+        default: break;
+    }
+
+    if (!is_valid)
+    {
+        fail(mark, "Invalid UUID"sv);
+        return;
+    }
+
+    on_item_end();
 }
 
-bool EditorSceneSerializer::deserialize_entity(const YAML::Node& node)
+void SceneYAMLEventHandler::on_collection_start(const YAML::Mark& mark, bool is_map)
 {
-    const UUID entity_uuid = node["UUID"].as<UUID>();
-    const String entity_name = node["Name"].as<String>();
+    m_last_mark = mark;
+    if (m_has_failed)
+        return;
 
-    SE_ASSERT(entity_uuid.is_valid());
-    Entity* entity = m_scene_context.create_entity_with_uuid(entity_uuid);
-    entity->set_name(entity_name);
+    if (m_scopes.is_empty())
+    {
+        if (!is_map)
+        {
+            fail(mark, "The root YAML node must be a map"sv);
+            return;
+        }
+
+        m_scopes.add({ Scope::Root, true, true });
+        return;
+    }
 
-    YAML::Node components = node["Components"];
-    if (!components || !components.IsSequence())
+    const ScopeState& parent_scope_state = m_scopes.last();
+    // Collections used as map keys are never part of the scene format.
+    const bool is_map_key = parent_scope_state.is_map && parent_scope_state.is_expecting_key;
+    Scope scope = Scope::Skipped;
+
+    switch (parent_scope_state.scope)
     {
-        SE_LOG_TAG_ERROR("Editor", "Scene file is corrupted! No 'Components' node found for entity '{}'!", entity_uuid);
-        return false;
+        case Scope::Root:
+        {
+            if (!is_map && !is_map_key && m_current_key == "Entities")
+            {
+                SE_LOG_TAG_TRACE("Editor", "Deserializing scene '{}' (UUID: {})", m_scene_name, m_scene_uuid);
+                m_has_found_entities = true;
+                scope = Scope::Entities;
+            }
+            else if (!is_map && !is_map_key && m_current_key == "DestroyedEntities")
+            {
+                scope = Scope::DestroyedEntities;
+            }
+            break;
+        }
+
+        case Scope::Entities:
+        {
+            if (is_map)
+            {
+                m_entity_uuid = UUID::invalid();
+                m_entity_name.clear();
+                m_entity = nullptr;
+                scope = Scope::Entity;
+            }
+            break;
+        }
+
+        case Scope::Entity:
+        {
+            if (!is_map && !is_map_key && m_current_key == "Components")
+            {
+                if (!begin_entity_components())
+                    return;
+                scope = Scope::Components;
+            }
+            break;
+        }
+
+        case Scope::Components:
+        {
+            if (is_map)
+            {
+                m_component_type_uuid = UUID::invalid();
+                m_has_component_fields = false;
+                m_component_reflector = nullptr;
+                m_component = nullptr;
+                scope = Scope::Component;
+            }
+            break;
+        }
+
+        case Scope::Component:
+        {
+            if (!is_map && !is_map_key && m_current_key == "Fields")
+            {
+                begin_component_fields();
+                scope = Scope::Fields;
+            }
+            break;
+        }
+
+        case Scope::Fields:
+        {
+            if (is_map)
+            {
+                m_field_name = Name();
+                m_field_type = ComponentFieldType::Unknown;
+                m_field_value_scalar_count = 0;
+                scope = Scope::Field;
+            }
+            break;
+        }
+
+        case Scope::Field:
+        {
+            if (!is_map && !is_map_key && m_current_key == "Value")
+            {
+                m_field_value_scalar_count = 0;
+                scope = Scope::FieldValue;
+            }
+            break;
+        }
+
+        default: break;
     }
 
-    for (const YAML::Node& component_node : components)
+    m_scopes.add({ scope, is_map, true });
+}
+
+void SceneYAMLEventHandler::on_collection_end()
+{
+    if (m_has_failed)
+        return;
+
+    SE_ASSERT(!m_scopes.is_empty());
+    const Scope scope = m_scopes.last().scope;
+    m_scopes.remove_last();
+
+    bool is_valid = true;
+    switch (scope)
     {
-        if (!deserialize_entity_component(component_node, *entity))
-            return false;
+        case Scope::Entity: is_valid = end_entity(); break;
+        case Scope::Component: is_valid = end_component(); break;
+        case Scope::Field: is_valid = end_field(); break;
+        default: break;
     }
 
-    return true;
+    if (is_valid)
+        on_item_end();
 }
 
-bool EditorSceneSerializer::deserialize_entity_component(const YAML::Node& node, Entity& entity)
+void SceneYAMLEventHandler::on_item_end()
 {
-    const String name = node["Name"].as<String>();
-    const UUID type_uuid = node["TypeUUID"].as<UUID>();
+    if (m_scopes.is_empty())
+        return;
+
+    ScopeState& scope_state = m_scopes.last();
+    if (scope_state.is_map)
+        scope_state.is_expecting_key = !scope_state.is_expecting_key;
+}
 
-    YAML::Node fields = node["Fields"];
-    if (!fields || !fields.IsSequence())
+bool SceneYAMLEventHandler::begin_entity_components()
+{
+    if (!m_entity_uuid.is_valid() || m_entity != nullptr)
     {
-        SE_LOG_TAG_ERROR("Editor", "Scene file is corrupted! No 'Fields' node found for component '{}', entity '{}'!", name, entity.uuid());
+        fail(m_last_mark, "Entity has an invalid UUID or multiple 'Components' nodes"sv);
         return false;
     }
 
-    const ComponentReflector& reflector = m_component_reflector_registry_context.get_reflector(type_uuid);
-    void* component_memory = ::operator new(reflector.structure_byte_count);
+    // The journal stores the whole state of the modified entities, so an entity that already exists is replaced.
+    m_serializer.m_scene_context.destroy_entity(m_entity_uuid);
+    m_entity = m_serializer.m_scene_context.create_entity_with_uuid(m_entity_uuid);
+    m_entity->set_name(m_entity_name);
+    return true;
+}
 
-    EntityComponentInitializer initializer = {};
-    initializer.parent_entity = &entity;
-    initializer.scene_context = &m_scene_context;
-    reflector.instantiate_function(component_memory, initializer);
-    EntityComponent* component = static_cast<EntityComponent*>(component_memory);
-    entity.add_component(component);
+bool SceneYAMLEventHandler::end_entity()
+{
+    if (m_entity == nullptr)
+    {
+        SE_LOG_TAG_ERROR("Editor", "Scene file is corrupted! No 'Components' node found for entity '{}'!", m_entity_uuid);
+        m_has_failed = true;
+        return false;
+    }
+
+    // The component fields are written directly in memory, so the entity bounds must be recalculated.
+    m_serializer.m_scene_context.update_entity_spatial_bounds(*m_entity);
+    return true;
+}
 
-    for (const YAML::Node& field_node : fields)
+void SceneYAMLEventHandler::begin_component_fields()
+{
+    m_has_component_fields = true;
+    m_component_reflector = m_serializer.m_component_reflector_registry_context.try_get_reflector(m_component_type_uuid);
+    if (m_component_reflector == nullptr)
     {
-        if (!deserialize_component_field(field_node, entity, *component))
-            return false;
+        SE_LOG_TAG_WARN("Editor", "Component type '{}' of entity '{}' no longer exists. Skipping...", m_component_type_uuid, m_entity_uuid);
+        return;
+    }
+
+    m_component = m_serializer.instantiate_entity_component(*m_entity, *m_component_reflector);
+}
+
+bool SceneYAMLEventHandler::end_component()
+{
+    if (!m_has_component_fields)
+    {
+        SE_LOG_TAG_ERROR("Editor", "Scene file is corrupted! No 'Fields' node found for a component of entity '{}'!", m_entity_uuid);
+        m_has_failed = true;
+        return false;
     }
 
     return true;
 }
 
-bool EditorSceneSerializer::deserialize_component_field(const YAML::Node& node, Entity& entity, EntityComponent& component)
+bool SceneYAMLEventHandler::end_field()
 {
-    const Vector<ComponentField>& reflector_fields = m_component_reflector_registry_context.get_reflector(component.get_component_type_uuid()).fields;
+    if (m_component == nullptr)
+        return true;
 
-    const String name = node["Name"].as<String>();
-    const ComponentFieldType type = get_component_field_type_from_string(node["Type"].as<String>().view());
-    const YAML::Node value = node["Value"];
+    // Fields that no longer exist (or whose type has changed) are skipped.
+    const Optional<u32> field_index = m_component_reflector->find_field_index(m_field_name, m_field_type);
+    if (!field_index.has_value())
+        return true;
 
-    for (const ComponentField& reflector_field : reflector_fields)
+    const ComponentField& field = m_component_reflector->fields[field_index.value()];
+    const std::string* scalars = m_field_value_scalars;
+    const u32 scalar_count = m_field_value_scalar_count;
+    bool is_valid = true;
+
+    switch (m_field_type)
     {
-        if (reflector_field.name == name && reflector_field.type_stack.first() == type)
-        {
-            switch (type)
-            {
-#define CASE_STATEMENT(field_type, type) \
-    case ComponentFieldType::field_type: reflector_field.get_value<type>(&component) = value.as<type>(); break
-
-                CASE_STATEMENT(UInt8, u8);
-                CASE_STATEMENT(UInt16, u16);
-                CASE_STATEMENT(UInt32, u32);
-                CASE_STATEMENT(UInt64, u64);
-                CASE_STATEMENT(Int8, i8);
-                CASE_STATEMENT(Int16, i16);
-                CASE_STATEMENT(Int32, i32);
-                CASE_STATEMENT(Int64, i64);
-                CASE_STATEMENT(Float32, float);
-                CASE_STATEMENT(Float64, double);
-                CASE_STATEMENT(Boolean, bool);
-                CASE_STATEMENT(Vector2, Vector2);
-                CASE_STATEMENT(Vector3, Vector3);
-                CASE_STATEMENT(Vector4, Vector4);
-                CASE_STATEMENT(Color3, Color3);
-                CASE_STATEMENT(Color4, Color4);
-                CASE_STATEMENT(String, String);
+#define CASE_STATEMENT(field_type, type)                                                                      \
+    case ComponentFieldType::field_type:                                                                      \
+    {                                                                                                         \
+        is_valid = (scalar_count == 1) && decode_yaml_scalar(scalars[0], field.get_value<type>(m_component)); \
+        break;                                                                                                \
+    }
+
+        CASE_STATEMENT(UInt8, u8);
+        CASE_STATEMENT(UInt16, u16);
+        CASE_STATEMENT(UInt32, u32);
+        CASE_STATEMENT(UInt64, u64);
+        CASE_STATEMENT(Int8, i8);
+        CASE_STATEMENT(Int16, i16);
+        CASE_STATEMENT(Int32, i32);
+        CASE_STATEMENT(Int64, i64);
+        CASE_STATEMENT(Float32, float);
+        CASE_STATEMENT(Float64, double);
+        CASE_STATEMENT(Boolean, bool);
 
 #undef CASE_STATEMENT
-            }
+
+        case ComponentFieldType::Vector2:
+        {
+            Vector2& value = field.get_value<Vector2>(m_component);
+            is_valid = (scalar_count == 2) && decode_yaml_scalar(scalars[0], value.x) && decode_yaml_scalar(scalars[1], value.y);
+            break;
+        }
+
+        case ComponentFieldType::Vector3:
+        {
+            Vector3& value = field.get_value<Vector3>(m_component);
+            is_valid = (scalar_count == 3) && decode_yaml_scalar(scalars[0], value.x) && decode_yaml_scalar(scalars[1], value.y) &&
+                       decode_yaml_scalar(scalars[2], value.z);
+            break;
+        }
+
+        case ComponentFieldType::Vector4:
+        {
+            Vector4& value = field.get_value<Vector4>(m_component);
+            is_valid = (scalar_count == 4) && decode_yaml_scalar(scalars[0], value.x) && decode_yaml_scalar(scalars[1], value.y) &&
+                       decode_yaml_scalar(scalars[2], value.z) && decode_yaml_scalar(scalars[3], value.w);
+            break;
+        }
+
+        case ComponentFieldType::Color3:
+        {
+            Color3& value = field.get_value<Color3>(m_component);
+            is_valid = (scalar_count == 3) && decode_yaml_scalar(scalars[0], value.r) && decode_yaml_scalar(scalars[1], value.g) &&
+                       decode_yaml_scalar(scalars[2], value.b);
+            break;
+        }
+
+        case ComponentFieldType::Color4:
+        {
+            Color4& value = field.get_value<Color4>(m_component);
+            is_valid = (scalar_count == 4) && decode_yaml_scalar(scalars[0], value.r) && decode_yaml_scalar(scalars[1], value.g) &&
+                       decode_yaml_scalar(scalars[2], value.b) && decode_yaml_scalar(scalars[3], value.a);
+            break;
+        }
+
+        case ComponentFieldType::String:
+        {
+            is_valid = (scalar_count == 1);
+            if (is_valid)
+                field.get_value<String>(m_component) = StringView::create_from_utf8(scalars[0].data(), scalars[0].size());
+            break;
+        }
+
+        case ComponentFieldType::AssetReferenceTexture:
+        {
+            UUID asset_uuid;
+            is_valid = (scalar_count == 1) && decode_yaml_scalar(scalars[0], asset_uuid);
+            if (is_valid)
+                field.get_value<AssetHandle>(m_component) = AssetHandle(asset_uuid);
             break;
         }
+
+        default: break;
+    }
+
+    if (!is_valid)
+    {
+        SE_LOG_TAG_ERROR("Editor", "Scene file is corrupted! Invalid value for field '{}' of entity '{}'!", m_field_name, m_entity_uuid);
+        m_has_failed = true;
+        return false;
+    }
+
+    return true;
+}
+
+void SceneYAMLEventHandler::fail(const YAML::Mark& mark, StringView message)
+{
+    SE_LOG_TAG_ERROR("Editor", "Scene file is corrupted! {} (line {}).", message, mark.line + 1);
+    m_has_failed = true;
+}
+
+bool EditorSceneSerializer::deserialize(const String& filepath)
+{
+    const String journal_filepath = get_journal_filepath(filepath);
+    if (!FileSystem::exists(journal_filepath))
+        return deserialize(filepath, {});
+
+    MemoryMappedFile journal_file;
+    if (journal_file.open(journal_filepath) != FileError::Success)
+    {
+        SE_LOG_TAG_ERROR("Editor", "Failed to open the scene journal '{}'!", journal_filepath);
+        return false;
+    }
+
+    return deserialize(filepath, journal_file.bytes());
+}
+
+bool EditorSceneSerializer::deserialize(const String& filepath, ReadonlyByteSpan journal_bytes)
+{
+    MemoryMappedFile scene_file;
+    if (scene_file.open(filepath) != FileError::Success)
+    {
+        SE_LOG_TAG_ERROR("Editor", "Failed to open the scene file '{}'!", filepath);
+        return false;
+    }
+
+    if (!deserialize_documents(scene_file.bytes(), filepath, false))
+        return false;
+
+    if (journal_bytes.is_empty())
+        return true;
+
+    // NOTE: Only the entries that were completely written are replayed. A torn entry can only be the last one, as the
+    //       journal is not appended to after a torn entry has been found (see `has_discarded_journal_tail`).
+    const String journal_filepath = get_journal_filepath(filepath);
+    const usize journal_valid_byte_count = get_journal_valid_byte_count(journal_bytes);
+    if (journal_valid_byte_count < journal_bytes.count())
+    {
+        SE_LOG_TAG_WARN(
+            "Editor", "Discarded the last '{}' bytes of the scene journal '{}', as they were not completely written.",
+            journal_bytes.count() - journal_valid_byte_count, journal_filepath
+        );
+        m_has_discarded_journal_tail = true;
+    }
+
+    if (!deserialize_documents(journal_bytes.slice(0, journal_valid_byte_count), journal_filepath, true))
+        return false;
+
+    return true;
+}
+
+bool EditorSceneSerializer::deserialize_documents(ReadonlyByteSpan bytes, const String& filepath, bool is_journal)
+{
+    MemoryStreamBuffer stream_buffer(bytes);
+    std::istream stream(&stream_buffer);
+    YAML::Parser parser(stream);
+
+    // The scene files contain a single document, while the journals contain a document for each saved change.
+    SceneYAMLEventHandler event_handler(*this);
+    u32 document_count = 0;
+    while (parser.HandleNextDocument(event_handler))
+    {
+        if (event_handler.has_failed())
+            return false;
+        ++document_count;
+    }
+
+    if (is_journal)
+    {
+        SE_LOG_TAG_TRACE("Editor", "Replayed '{}' changes from the scene journal '{}'.", document_count, filepath);
+        return true;
+    }
+
+    if (document_count == 0)
+    {
+        SE_LOG_TAG_ERROR("Editor", "Failed to load the root YAML node from scene file '{}'!", filepath);
+        return false;
+    }
+
+    if (!event_handler.has_found_entities())
+    {
+        SE_LOG_TAG_ERROR("Editor", "Scene file is corrupted! No 'Entities' node found!");
+        return false;
     }
 
     return true;
 }
 
+EntityComponent* EditorSceneSerializer::instantiate_entity_component(Entity& entity, const ComponentReflector& reflector)
+{
+    void* component_memory = ::operator new(reflector.structure_byte_count);
+
+    EntityComponentInitializer initializer = {};
+    initializer.parent_entity = &entity;
+    initializer.scene_context = &m_scene_context;
+    reflector.instantiate_function(component_memory, initializer);
+    EntityComponent* component = static_cast<EntityComponent*>(component_memory);
+    entity.add_component(component);
+    return component;
+}
+
 } // namespace SE
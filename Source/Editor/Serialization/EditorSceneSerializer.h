@@ -11,7 +11,6 @@ namespace YAML
 {
 
 // YAML forward declarations.
-class Node;
 class Emitter;
 
 } // namespace YAML
@@ -25,33 +24,65 @@ class Entity;
 class EntityComponent;
 class ComponentReflectorRegistry;
 struct ComponentField;
+struct ComponentReflector;
 
 class EditorSceneSerializer
 {
     SE_MAKE_NONCOPYABLE(EditorSceneSerializer);
     SE_MAKE_NONMOVABLE(EditorSceneSerializer);
 
+    friend class SceneYAMLEventHandler;
+
 public:
     ALWAYS_INLINE explicit EditorSceneSerializer(Scene& scene_context, const ComponentReflectorRegistry& component_reflector_registry_context)
         : m_scene_context(scene_context)
         , m_component_reflector_registry_context(component_reflector_registry_context)
+        , m_has_discarded_journal_tail(false)
     {}
 
+    // Writes the whole scene to the given file. The journal of the file (if any) is deleted, as it is older than the scene.
     bool serialize(const String& filepath);
+
+    //
+    // Appends the entities that have changed since the scene changes were last cleared to the journal of the given
+    // scene file, as a new YAML document. The modified entities are written entirely, and the destroyed entities only
+    // by their UUID, so the cost only depends on the number of changed entities and not on the size of the scene.
+    // Each document is preceded by a header with its byte count and checksum, so a torn document can be detected.
+    //
+    bool serialize_changes(const String& filepath);
+
+    //
+    // The scene file is parsed as a stream of YAML events and the entities and components are created as soon as they
+    // are encountered, without ever building the node tree of the whole file. The file is memory mapped, so besides the
+    // scene itself only the state of the deepest nesting level has to be kept in memory.
+    // After the scene file has been loaded, the changes stored in its journal are replayed in the order they were saved.
+    //
     bool deserialize(const String& filepath);
 
+    // Loads the given scene file, followed by the changes stored in the provided journal bytes (instead of the journal file).
+    bool deserialize(const String& filepath, ReadonlyByteSpan journal_bytes);
+
+    //
+    // Whether the last entry of the journal was torn (the editor was closed while it was being written) and has been
+    // skipped by `deserialize`. The changes appended after it would never be replayed, so the whole scene must be saved.
+    //
+    NODISCARD ALWAYS_INLINE bool has_discarded_journal_tail() const { return m_has_discarded_journal_tail; }
+
+    NODISCARD static String get_journal_filepath(const String& filepath);
+
 private:
     bool serialize_entity(YAML::Emitter& emitter, const Entity& entity);
     bool serialize_entity_component(YAML::Emitter& emitter, const EntityComponent& component);
     bool serialize_component_field(YAML::Emitter& emitter, const EntityComponent& component, const ComponentField& field);
 
-    bool deserialize_entity(const YAML::Node& node);
-    bool deserialize_entity_component(const YAML::Node& node, Entity& entity);
-    bool deserialize_component_field(const YAML::Node& node, Entity& entity, EntityComponent& component);
+    bool deserialize_documents(ReadonlyByteSpan bytes, const String& filepath, bool is_journal);
+
+    EntityComponent* instantiate_entity_component(Entity& entity, const ComponentReflector& reflector);
 
 private:
     Scene& m_scene_context;
     const ComponentReflectorRegistry& m_component_reflector_registry_context;
+    bool m_has_discarded_journal_tail;
 };
 
 } // namespace SE
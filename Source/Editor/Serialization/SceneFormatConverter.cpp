@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/Log.h>
+#include <Engine/Scene/Scene.h>
+#include <Engine/Scene/Serialization/BinarySceneSerializer.h>
+#include <Serialization/EditorSceneSerializer.h>
+#include <Serialization/SceneFormatConverter.h>
+
+namespace SE
+{
+
+bool SceneFormatConverter::convert_yaml_to_binary(
+    const String& yaml_filepath, const String& binary_filepath, const ComponentReflectorRegistry& component_reflector_registry
+)
+{
+    OwnPtr<Scene> scene = Scene::create();
+
+    EditorSceneSerializer yaml_serializer(*scene, component_reflector_registry);
+    if (!yaml_serializer.deserialize(yaml_filepath))
+    {
+        SE_LOG_TAG_ERROR("Editor", "Failed to load the YAML scene '{}' for conversion!", yaml_filepath);
+        return false;
+    }
+
+    BinarySceneSerializer binary_serializer(*scene, component_reflector_registry);
+    if (!binary_serializer.serialize(binary_filepath))
+    {
+        SE_LOG_TAG_ERROR("Editor", "Failed to write the binary scene '{}'!", binary_filepath);
+        return false;
+    }
+
+    return true;
+}
+
+bool SceneFormatConverter::convert_binary_to_yaml(
+    const String& binary_filepath, const String& yaml_filepath, const ComponentReflectorRegistry& component_reflector_registry
+)
+{
+    OwnPtr<Scene> scene = Scene::create();
+
+    BinarySceneSerializer binary_serializer(*scene, component_reflector_registry);
+    if (!binary_serializer.deserialize(binary_filepath))
+    {
+        SE_LOG_TAG_ERROR("Editor", "Failed to load the binary scene '{}' for conversion!", binary_filepath);
+        return false;
+    }
+
+    EditorSceneSerializer yaml_serializer(*scene, component_reflector_registry);
+    if (!yaml_serializer.serialize(yaml_filepath))
+    {
+        SE_LOG_TAG_ERROR("Editor", "Failed to write the YAML scene '{}'!", yaml_filepath);
+        return false;
+    }
+
+    return true;
+}
+
+} // namespace SE
@@ -0,0 +1,31 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/String/String.h>
+
+namespace SE
+{
+
+// Forward declarations.
+class ComponentReflectorRegistry;
+
+//
+// Converts scene files between the YAML format, which is used by the editor as the interchange format, and the
+// binary format, which is loaded by the runtime. The conversion loads the scene into a temporary scene object,
+// so the converted file always matches the layout of the components that are currently registered.
+//
+class SceneFormatConverter
+{
+public:
+    static bool
+    convert_yaml_to_binary(const String& yaml_filepath, const String& binary_filepath, const ComponentReflectorRegistry& component_reflector_registry);
+
+    static bool
+    convert_binary_to_yaml(const String& binary_filepath, const String& yaml_filepath, const ComponentReflectorRegistry& component_reflector_registry);
+};
+
+} // namespace SE
@@ -0,0 +1,232 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/FileSystem/FileSystem.h>
+#include <Core/Log.h>
+#include <Core/Math/MathCore.h>
+#include <Core/String/StringBuilder.h>
+#include <Engine/Scene/Scene.h>
+#include <Serialization/EditorSceneSerializer.h>
+#include <Serialization/SceneJournal.h>
+
+namespace SE
+{
+
+// The journal is compacted only when it is larger than half of the base file, but never while it is smaller than this value.
+static constexpr usize s_min_compaction_journal_byte_count = 64 * 1024;
+
+SceneJournal::SceneJournal(Scene& scene_context, const ComponentReflectorRegistry& component_reflector_registry_context, const String& filepath)
+    : m_scene_context(scene_context)
+    , m_component_reflector_registry_context(component_reflector_registry_context)
+    , m_filepath(filepath)
+    , m_is_base_file_valid(false)
+    , m_base_file_byte_count(0)
+    , m_journal_byte_count(0)
+{
+    m_scene_context.set_change_tracking_enabled(true);
+}
+
+SceneJournal::~SceneJournal()
+{
+    end_compaction(true);
+}
+
+bool SceneJournal::load()
+{
+    end_compaction(false);
+    m_is_base_file_valid = false;
+    if (!FileSystem::exists(m_filepath))
+        return false;
+
+    EditorSceneSerializer serializer(m_scene_context, m_component_reflector_registry_context);
+    if (!serializer.deserialize(m_filepath))
+    {
+        SE_LOG_TAG_ERROR("Editor", "Failed to load the scene file '{}'!", m_filepath);
+        return false;
+    }
+
+    // Loading the scene is not a change that has to be saved, as the scene matches the base file and its journal.
+    m_scene_context.clear_entity_changes();
+    m_is_base_file_valid = !serializer.has_discarded_journal_tail();
+    m_base_file_byte_count = FileSystem::get_file_size(m_filepath).value_or(0);
+    m_journal_byte_count = FileSystem::get_file_size(EditorSceneSerializer::get_journal_filepath(m_filepath)).value_or(0);
+    return true;
+}
+
+bool SceneJournal::save()
+{
+    if (!m_is_base_file_valid || m_scene_context.get_play_state() != Scene::PlayState::NotPlaying)
+        return save_base();
+
+    if (!save_changes())
+        return false;
+
+    const usize compaction_journal_byte_count = Math::max(m_base_file_byte_count / 2, s_min_compaction_journal_byte_count);
+    if (!m_compaction_job.is_valid() && m_journal_byte_count >= compaction_journal_byte_count)
+        begin_compaction();
+
+    return true;
+}
+
+void SceneJournal::on_update()
+{
+    // The changes made by a play session are not tracked, so the next save has to write the whole scene.
+    if (m_scene_context.get_play_state() != Scene::PlayState::NotPlaying)
+        m_is_base_file_valid = false;
+
+    if (m_compaction_job.is_valid() && m_compaction_job->has_finished.load(MemoryOrder::Acquire))
+        end_compaction(true);
+}
+
+bool SceneJournal::save_base()
+{
+    // The compacted base file would be older than the one that is about to be written.
+    end_compaction(false);
+
+    EditorSceneSerializer serializer(m_scene_context, m_component_reflector_registry_context);
+    if (!serializer.serialize(m_filepath))
+    {
+        m_is_base_file_valid = false;
+        return false;
+    }
+
+    m_scene_context.clear_entity_changes();
+    m_is_base_file_valid = (m_scene_context.get_play_state() == Scene::PlayState::NotPlaying);
+    m_base_file_byte_count = FileSystem::get_file_size(m_filepath).value_or(0);
+    m_journal_byte_count = 0;
+    return true;
+}
+
+bool SceneJournal::save_changes()
+{
+    EditorSceneSerializer serializer(m_scene_context, m_component_reflector_registry_context);
+    if (!serializer.serialize_changes(m_filepath))
+    {
+        // The journal might have been partially written, so the whole scene is saved the next time.
+        m_is_base_file_valid = false;
+        return false;
+    }
+
+    m_scene_context.clear_entity_changes();
+    m_journal_byte_count = FileSystem::get_file_size(EditorSceneSerializer::get_journal_filepath(m_filepath)).value_or(0);
+    return true;
+}
+
+void SceneJournal::begin_compaction()
+{
+    SE_ASSERT(!m_compaction_job.is_valid());
+    m_compaction_job = create_own<CompactionJob>();
+    m_compaction_job->component_reflector_registry = &m_component_reflector_registry_context;
+    m_compaction_job->filepath = m_filepath;
+    m_compaction_job->compacted_filepath = StringBuilder::join({ m_filepath.view(), ".compacted"sv });
+    m_compaction_job->has_succeeded = false;
+
+    // NOTE: The journal is copied, as the following saves keep appending to it while the compaction is running.
+    //       The changes appended after this point are moved to the new journal when the compaction finishes.
+    const String journal_filepath = EditorSceneSerializer::get_journal_filepath(m_filepath);
+    FileReader journal_file_reader;
+    if (journal_file_reader.open(journal_filepath) != FileError::Success ||
+        journal_file_reader.read_entire_and_close(m_compaction_job->journal) != FileError::Success)
+    {
+        SE_LOG_TAG_WARN("Editor", "Failed to read the scene journal '{}'. The journal will not be compacted.", journal_filepath);
+        m_compaction_job.release();
+        return;
+    }
+
+    if (!m_compaction_thread.start(compaction_thread_entry_point, m_compaction_job.get(), "SceneJournalCompaction"sv))
+    {
+        SE_LOG_TAG_WARN("Editor", "Failed to start the compaction thread of the scene journal '{}'.", journal_filepath);
+        m_compaction_job.release();
+        return;
+    }
+}
+
+void SceneJournal::end_compaction(bool should_apply)
+{
+    if (!m_compaction_job.is_valid())
+        return;
+
+    m_compaction_thread.join();
+    const String& compacted_filepath = m_compaction_job->compacted_filepath;
+
+    if (!should_apply || !m_compaction_job->has_succeeded)
+    {
+        if (FileSystem::exists(compacted_filepath))
+            FileSystem::delete_file(compacted_filepath);
+        m_compaction_job.release();
+        return;
+    }
+
+    //
+    // The compacted base file contains all the changes that were in the journal when the compaction started. The changes
+    // appended since then (the tail of the journal) are written to a temporary file that later replaces the journal.
+    // Replaying a change more than once has no effect, so if the editor is closed before the journal is replaced,
+    // loading the compacted base file together with the old journal still results in the same scene.
+    //
+    const String journal_filepath = EditorSceneSerializer::get_journal_filepath(m_filepath);
+    const String journal_tail_filepath = StringBuilder::join({ journal_filepath.view(), ".tail"sv });
+    const usize compacted_journal_byte_count = m_compaction_job->journal.byte_count();
+
+    Buffer journal;
+    FileReader journal_file_reader;
+    if (journal_file_reader.open(journal_filepath) != FileError::Success || journal_file_reader.read_entire_and_close(journal) != FileError::Success)
+    {
+        SE_LOG_TAG_ERROR("Editor", "Failed to read the scene journal '{}'! The compacted scene is discarded.", journal_filepath);
+        FileSystem::delete_file(compacted_filepath);
+        m_compaction_job.release();
+        return;
+    }
+
+    SE_ASSERT(journal.byte_count() >= compacted_journal_byte_count);
+    const ReadonlyByteSpan journal_tail = journal.readonly_byte_span().slice(compacted_journal_byte_count);
+    if (journal_tail.has_elements())
+    {
+        FileWriter journal_tail_file_writer;
+        if (journal_tail_file_writer.open(journal_tail_filepath) != FileError::Success ||
+            journal_tail_file_writer.write_and_close(journal_tail) != FileError::Success)
+        {
+            SE_LOG_TAG_ERROR("Editor", "Failed to write the scene journal '{}'! The compacted scene is discarded.", journal_tail_filepath);
+            FileSystem::delete_file(compacted_filepath);
+            m_compaction_job.release();
+            return;
+        }
+    }
+
+    if (!FileSystem::move_file(compacted_filepath, m_filepath))
+    {
+        SE_LOG_TAG_ERROR("Editor", "Failed to replace the scene file '{}' with its compacted version!", m_filepath);
+        FileSystem::delete_file(compacted_filepath);
+        if (journal_tail.has_elements())
+            FileSystem::delete_file(journal_tail_filepath);
+        m_compaction_job.release();
+        return;
+    }
+
+    const bool has_replaced_journal =
+        journal_tail.has_elements() ? FileSystem::move_file(journal_tail_filepath, journal_filepath) : FileSystem::delete_file(journal_filepath);
+    if (!has_replaced_journal)
+        SE_LOG_TAG_WARN("Editor", "Failed to truncate the scene journal '{}'. It will be compacted again.", journal_filepath);
+
+    m_base_file_byte_count = FileSystem::get_file_size(m_filepath).value_or(0);
+    m_journal_byte_count = FileSystem::get_file_size(journal_filepath).value_or(0);
+    m_compaction_job.release();
+
+    SE_LOG_TAG_INFO("Editor", "Compacted '{}' bytes of the scene journal into the scene file '{}'.", compacted_journal_byte_count, m_filepath);
+}
+
+void SceneJournal::compaction_thread_entry_point(void* user_data)
+{
+    CompactionJob& job = *static_cast<CompactionJob*>(user_data);
+
+    // The base file and the copy of the journal are loaded in a separate scene, so the active scene can be edited (and saved)
+    // while the compaction is running.
+    OwnPtr<Scene> scene = Scene::create();
+    EditorSceneSerializer serializer(*scene, *job.component_reflector_registry);
+    job.has_succeeded = serializer.deserialize(job.filepath, job.journal.readonly_byte_span()) && serializer.serialize(job.compacted_filepath);
+
+    job.has_finished.store(true, MemoryOrder::Release);
+}
+
+} // namespace SE
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/Containers/OwnPtr.h>
+#include <Core/Memory/Buffer.h>
+#include <Core/Platform/Atomic.h>
+#include <Core/Platform/Thread.h>
+#include <Core/String/String.h>
+
+namespace SE
+{
+
+// Forward declarations.
+class Scene;
+class ComponentReflectorRegistry;
+
+//
+// Saves the edits made to a scene incrementally. The first save writes the whole scene (the base file), while the
+// following saves only append the entities that have changed since the previous save to the journal of the base file.
+// When the journal becomes large compared to the base file, it is folded into a new base file by a background thread,
+// which loads the base file and the journal into a separate scene, so the active scene is never accessed by it.
+//
+// The files are replaced in an order that keeps the scene loadable if the editor is closed at any point: replaying
+// a change is idempotent, so the journal is only truncated after the compacted base file has replaced the old one.
+//
+class SceneJournal
+{
+    SE_MAKE_NONCOPYABLE(SceneJournal);
+    SE_MAKE_NONMOVABLE(SceneJournal);
+
+public:
+    SceneJournal(Scene& scene_context, const ComponentReflectorRegistry& component_reflector_registry_context, const String& filepath);
+    ~SceneJournal();
+
+    // Loads the base file and its journal into the scene, which must be empty. Returns false if the base file doesn't exist.
+    bool load();
+
+    //
+    // Saves the changes of the scene. If the scene hasn't been loaded from (or saved to) the base file by this journal,
+    // or the scene is currently playing (the changes made by a play session are not tracked), the whole scene is saved.
+    //
+    bool save();
+
+    // Must be called periodically by the main thread, in order to replace the base file when a compaction finishes.
+    void on_update();
+
+private:
+    struct CompactionJob
+    {
+        const ComponentReflectorRegistry* component_reflector_registry;
+        String filepath;
+        String compacted_filepath;
+        // The contents of the journal when the compaction started.
+        Buffer journal;
+        bool has_succeeded;
+        Atomic<bool> has_finished;
+    };
+
+private:
+    bool save_base();
+    bool save_changes();
+
+    void begin_compaction();
+    void end_compaction(bool should_apply);
+
+    static void compaction_thread_entry_point(void* user_data);
+
+private:
+    Scene& m_scene_context;
+    const ComponentReflectorRegistry& m_component_reflector_registry_context;
+    String m_filepath;
+
+    // Whether or not the base file matches the scene, excluding the changes that have not been saved yet.
+    bool m_is_base_file_valid;
+    usize m_base_file_byte_count;
+    usize m_journal_byte_count;
+
+    Thread m_compaction_thread;
+    OwnPtr<CompactionJob> m_compaction_job;
+};
+
+} // namespace SE
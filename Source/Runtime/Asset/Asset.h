@@ -7,6 +7,7 @@
 
 #include <Core/API.h>
 #include <Core/Containers/RefPtr.h>
+#include <Core/Containers/Vector.h>
 #include <Core/String/String.h>
 #include <Core/UUID.h>
 
@@ -44,6 +45,12 @@ private:
     UUID m_uuid;
 };
 
+template<>
+struct Hasher<AssetHandle>
+{
+    NODISCARD ALWAYS_INLINE static u64 get_hash(const AssetHandle& value) { return Hasher<UUID>::get_hash(value.value()); }
+};
+
 //
 // Enumeration of all asset types used by the engine.
 //
@@ -69,6 +76,9 @@ public:
     AssetType type = AssetType::Unknown;
     AssetState state = AssetState::Unknown;
     AssetHandle handle = AssetHandle::invalid();
+    // The assets that are referenced by this asset, which are loaded together with it by `AssetManager::preload`.
+    // NOTE: The dependencies of an asset are filled by its serializer, so they might only be known after it is loaded.
+    Vector<AssetHandle> dependencies;
 };
 
 //
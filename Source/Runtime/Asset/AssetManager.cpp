@@ -4,6 +4,8 @@
  */
 
 #include <Asset/AssetManager.h>
+#include <Core/Containers/HashMap.h>
+#include <Core/Math/MathCore.h>
 
 namespace SE
 {
@@ -17,4 +19,73 @@ void AssetManager::shutdown()
     g_asset_manager = nullptr;
 }
 
+void AssetManager::preload(Span<const AssetHandle> handles, AssetLoadPriority priority)
+{
+    if (priority == AssetLoadPriority::Background)
+    {
+        for (const AssetHandle handle : handles)
+            m_background_preload_queue.add(handle);
+        return;
+    }
+
+    HashMap<AssetHandle, bool> visited_handles;
+    Vector<AssetHandle> pending_handles;
+    for (const AssetHandle handle : handles)
+        pending_handles.add(handle);
+
+    while (!pending_handles.is_empty())
+    {
+        // Collect the assets that are not loaded yet, following the dependencies that are already known. The same asset
+        // might be referenced multiple times, but it is visited only once.
+        Vector<AssetHandle> batch_handles;
+        while (!pending_handles.is_empty())
+        {
+            const AssetHandle handle = pending_handles.last();
+            pending_handles.remove_last();
+            if (!handle.is_valid() || visited_handles.contains(handle))
+                continue;
+            visited_handles.add(handle, true);
+
+            const AssetMetadata& metadata = get_asset_metadata(handle);
+            if (metadata.type == AssetType::Unknown)
+                continue;
+
+            for (const AssetHandle dependency_handle : metadata.dependencies)
+                pending_handles.add(dependency_handle);
+            if (metadata.state != AssetState::Ready)
+                batch_handles.add(handle);
+        }
+
+        if (batch_handles.is_empty())
+            break;
+        load_assets(Span<const AssetHandle>(batch_handles.elements(), batch_handles.count()));
+
+        // Loading an asset might discover dependencies that were not known before, which are loaded by the next batch.
+        for (const AssetHandle handle : batch_handles)
+        {
+            for (const AssetHandle dependency_handle : get_asset_metadata(handle).dependencies)
+            {
+                if (!visited_handles.contains(dependency_handle))
+                    pending_handles.add(dependency_handle);
+            }
+        }
+    }
+}
+
+void AssetManager::update()
+{
+    if (m_background_preload_queue.is_empty())
+        return;
+
+    const usize batch_count = Math::min(m_background_preload_queue.count(), background_preload_batch_count);
+    preload(Span<const AssetHandle>(m_background_preload_queue.elements(), batch_count), AssetLoadPriority::Immediate);
+    m_background_preload_queue.remove(0, batch_count);
+}
+
+void AssetManager::load_assets(Span<const AssetHandle> handles)
+{
+    for (const AssetHandle handle : handles)
+        get_asset_sync(handle);
+}
+
 } // namespace SE
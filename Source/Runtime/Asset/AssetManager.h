@@ -7,23 +7,50 @@
 
 #include "Asset/Asset.h"
 #include "Core/API.h"
+#include "Core/Containers/Span.h"
+#include "Core/Containers/Vector.h"
 
 namespace SE
 {
 
+enum class AssetLoadPriority : u8
+{
+    // The assets are loaded before `preload` returns, such as the assets referenced by a scene that is being opened.
+    Immediate,
+    // The assets are queued and loaded by `update`, a few every frame, so loading them doesn't stall a single frame.
+    Background,
+};
+
 class AssetManager
 {
 public:
     template<typename T>
     ALWAYS_INLINE static void instantiate();
 
+    // The maximum number of queued assets that are loaded by a single call to `update`.
+    static constexpr usize background_preload_batch_count = 16;
+
 public:
+    virtual ~AssetManager() = default;
+
     virtual bool initialize() = 0;
     SHOOTER_API virtual void shutdown();
 
     virtual RefPtr<Asset> get_asset_sync(AssetHandle handle) = 0;
     virtual AssetMetadata& get_asset_metadata(AssetHandle handle) = 0;
 
+    //
+    // Loads the given assets, such as all the assets referenced by a scene, together with all the assets they depend on
+    // (directly or indirectly). The assets that are not loaded yet are loaded as a single batch, which allows the asset
+    // manager to read their files concurrently and in the order in which they are stored, instead of discovering them one
+    // at a time through `get_asset_sync`. The dependencies that are only known after an asset is loaded are loaded by
+    // the next batch. Each asset is loaded once, even if the dependencies form a cycle.
+    //
+    SHOOTER_API void preload(Span<const AssetHandle> handles, AssetLoadPriority priority);
+
+    // Must be called once per frame by the main thread. Loads the next assets queued by the background preloads.
+    SHOOTER_API void update();
+
     template<typename T>
     ALWAYS_INLINE RefPtr<T> get_asset_sync(AssetHandle handle)
     {
@@ -34,6 +61,16 @@ public:
         SE_ASSERT(asset->get_type() == T::get_static_type());
         return asset.as<T>();
     }
+
+protected:
+    //
+    // Loads the given assets, none of which is loaded. The default implementation loads them one at a time, using
+    // `get_asset_sync`, so asset managers that are able to load multiple assets concurrently should override it.
+    //
+    SHOOTER_API virtual void load_assets(Span<const AssetHandle> handles);
+
+private:
+    Vector<AssetHandle> m_background_preload_queue;
 };
 
 SHOOTER_API extern AssetManager* g_asset_manager;
@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Asset/AssetPack.h>
+#include <Core/Log.h>
+#include <Core/Memory/Compression.h>
+#include <Core/Memory/MemoryOperations.h>
+
+namespace SE
+{
+
+AssetPack::~AssetPack()
+{
+    close();
+}
+
+bool AssetPack::open(const String& filepath)
+{
+    close();
+
+    if (m_file.open(filepath) != FileError::Success)
+    {
+        SE_LOG_TAG_ERROR("Asset", "Failed to open the asset pack '{}'!", filepath);
+        return false;
+    }
+
+    const ReadonlyByteSpan bytes = m_file.bytes();
+    if (bytes.count() < sizeof(AssetPackHeader))
+    {
+        SE_LOG_TAG_ERROR("Asset", "Invalid or corrupted asset pack: '{}'!", filepath);
+        m_file.close();
+        return false;
+    }
+
+    AssetPackHeader header;
+    copy_memory(&header, bytes.elements(), sizeof(AssetPackHeader));
+    if (header.magic != asset_pack_magic || header.version != asset_pack_version)
+    {
+        SE_LOG_TAG_ERROR("Asset", "The asset pack '{}' has an unsupported format or version!", filepath);
+        m_file.close();
+        return false;
+    }
+
+    // NOTE: The table of contents is accessed directly in the mapped file, so it must be aligned. The mapping itself is always page aligned.
+    const u64 toc_byte_count = static_cast<u64>(header.entry_count) * sizeof(AssetPackEntry);
+    const bool is_toc_valid = (header.toc_offset % alignof(AssetPackEntry) == 0) && header.toc_offset <= bytes.count() &&
+                              toc_byte_count <= bytes.count() - header.toc_offset;
+    const bool is_string_table_valid =
+        header.string_table_offset <= bytes.count() && header.string_table_byte_count <= bytes.count() - header.string_table_offset;
+    if (!is_toc_valid || !is_string_table_valid)
+    {
+        SE_LOG_TAG_ERROR("Asset", "Invalid or corrupted asset pack: '{}'!", filepath);
+        m_file.close();
+        return false;
+    }
+
+    const AssetPackEntry* entries = reinterpret_cast<const AssetPackEntry*>(bytes.elements() + header.toc_offset);
+    for (u32 entry_index = 0; entry_index < header.entry_count; ++entry_index)
+    {
+        const AssetPackEntry& entry = entries[entry_index];
+        const bool is_data_valid = entry.data_offset <= bytes.count() && entry.stored_byte_count <= bytes.count() - entry.data_offset;
+        const bool is_name_valid = static_cast<u64>(entry.name_offset) + entry.name_byte_count <= header.string_table_byte_count;
+        // The binary search requires the entries to be strictly sorted by their handle.
+        const bool is_sorted = (entry_index == 0) || (entries[entry_index - 1].handle < entry.handle);
+        const bool is_compression_valid = (entry.compression == AssetPackCompression::None && entry.stored_byte_count == entry.byte_count) ||
+                                          (entry.compression == AssetPackCompression::LZ4);
+
+        if (!is_data_valid || !is_name_valid || !is_sorted || !is_compression_valid)
+        {
+            SE_LOG_TAG_ERROR("Asset", "Invalid or corrupted entry ({}) in the asset pack '{}'!", entry_index, filepath);
+            m_file.close();
+            return false;
+        }
+    }
+
+    m_filepath = filepath;
+    m_entries = entries;
+    m_entry_count = header.entry_count;
+    m_string_table = bytes.slice(header.string_table_offset, header.string_table_byte_count);
+    return true;
+}
+
+void AssetPack::close()
+{
+    m_file.close();
+    m_filepath.clear();
+    m_entries = nullptr;
+    m_entry_count = 0;
+    m_string_table = {};
+}
+
+const AssetPackEntry* AssetPack::find_entry(AssetHandle handle) const
+{
+    const u64 handle_value = handle.value().value();
+
+    u32 first = 0;
+    u32 last = m_entry_count;
+    while (first < last)
+    {
+        const u32 middle = first + (last - first) / 2;
+        if (m_entries[middle].handle < handle_value)
+            first = middle + 1;
+        else
+            last = middle;
+    }
+
+    if (first < m_entry_count && m_entries[first].handle == handle_value)
+        return &m_entries[first];
+    return nullptr;
+}
+
+StringView AssetPack::get_entry_name(const AssetPackEntry& entry) const
+{
+    const char* name = reinterpret_cast<const char*>(m_string_table.elements() + entry.name_offset);
+    return StringView::create_from_utf8(name, entry.name_byte_count);
+}
+
+bool AssetPack::read_entry(const AssetPackEntry& entry, Buffer& decompression_buffer, ReadonlyByteSpan& out_bytes) const
+{
+    const ReadonlyByteSpan stored_bytes = m_file.bytes().slice(entry.data_offset, entry.stored_byte_count);
+
+    switch (entry.compression)
+    {
+        case AssetPackCompression::None:
+        {
+            out_bytes = stored_bytes;
+            return true;
+        }
+
+        case AssetPackCompression::LZ4:
+        {
+            if (decompression_buffer.byte_count() < entry.byte_count)
+                decompression_buffer = Buffer::create(entry.byte_count);
+
+            const WriteonlyByteSpan decompressed_bytes = WriteonlyByteSpan(decompression_buffer.bytes(), entry.byte_count);
+            if (!decompress_lz4(stored_bytes, decompressed_bytes))
+                return false;
+
+            out_bytes = ReadonlyByteSpan(decompression_buffer.bytes(), entry.byte_count);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+} // namespace SE
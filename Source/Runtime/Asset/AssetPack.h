@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Asset/Asset.h>
+#include <Core/FileSystem/FileSystem.h>
+#include <Core/Memory/Buffer.h>
+#include <Core/String/StringView.h>
+
+namespace SE
+{
+
+//
+// Layout of the asset pack file (.sepak). All offsets are relative to the beginning of the file.
+//
+// The file starts with a header, followed by the table of contents (one entry for each asset, sorted by the asset handle,
+// so an asset is found with a binary search) and by the string table, which stores the names of the assets. The data of
+// each asset is aligned to `asset_pack_entry_alignment` bytes, so an entry never shares a page with another entry and
+// reading it from the mapped file only touches the pages of that entry.
+//
+static constexpr u32 asset_pack_magic = 0x4B505345; // 'SEPK'
+static constexpr u32 asset_pack_version = 1;
+static constexpr u64 asset_pack_entry_alignment = 4096;
+
+enum class AssetPackCompression : u8
+{
+    None = 0,
+    LZ4,
+};
+
+struct AssetPackHeader
+{
+    u32 magic;
+    u32 version;
+    u32 entry_count;
+    u32 reserved;
+    u64 toc_offset;
+    u64 string_table_offset;
+    u64 string_table_byte_count;
+};
+
+struct AssetPackEntry
+{
+    u64 handle;
+    AssetType type;
+    AssetPackCompression compression;
+    u8 reserved;
+    // The name of the asset (the path of its asset file, relative to the content directory), stored in the string table.
+    u32 name_offset;
+    u32 name_byte_count;
+    u32 reserved_2;
+    u64 data_offset;
+    // The number of bytes occupied by the data in the file, which is smaller than the uncompressed size if the entry is compressed.
+    u64 stored_byte_count;
+    u64 byte_count;
+};
+
+static_assert(sizeof(AssetPackHeader) == 40);
+static_assert(sizeof(AssetPackEntry) == 48);
+
+//
+// Read-only view over an asset pack file. The file is mapped in memory, so opening a pack only validates its table of
+// contents, and the data of an uncompressed entry is read directly from the mapped pages, without any copy.
+//
+class AssetPack
+{
+    SE_MAKE_NONCOPYABLE(AssetPack);
+    SE_MAKE_NONMOVABLE(AssetPack);
+
+public:
+    AssetPack() = default;
+    SHOOTER_API ~AssetPack();
+
+    SHOOTER_API bool open(const String& filepath);
+    SHOOTER_API void close();
+
+    NODISCARD ALWAYS_INLINE const String& get_filepath() const { return m_filepath; }
+    NODISCARD ALWAYS_INLINE u32 get_entry_count() const { return m_entry_count; }
+    NODISCARD ALWAYS_INLINE const AssetPackEntry& get_entry(u32 entry_index) const { return m_entries[entry_index]; }
+
+    // Returns the entry of the asset with the given handle, or nullptr if the pack doesn't contain the asset.
+    NODISCARD SHOOTER_API const AssetPackEntry* find_entry(AssetHandle handle) const;
+
+    NODISCARD SHOOTER_API StringView get_entry_name(const AssetPackEntry& entry) const;
+
+    //
+    // Returns the uncompressed data of the given entry. The data of uncompressed entries points directly into the mapped file,
+    // while compressed entries are decompressed into the given buffer, so the returned bytes are valid only as long as both
+    // the pack and the buffer are. Returns false if the data of the entry is corrupted.
+    //
+    NODISCARD SHOOTER_API bool read_entry(const AssetPackEntry& entry, Buffer& decompression_buffer, ReadonlyByteSpan& out_bytes) const;
+
+private:
+    String m_filepath;
+    MemoryMappedFile m_file;
+    const AssetPackEntry* m_entries { nullptr };
+    u32 m_entry_count { 0 };
+    ReadonlyByteSpan m_string_table;
+};
+
+} // namespace SE
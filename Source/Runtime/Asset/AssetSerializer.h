@@ -6,16 +6,36 @@
 #pragma once
 
 #include <Asset/Asset.h>
+#include <Core/Containers/OwnPtr.h>
 #include <Core/Containers/RefPtr.h>
 
 namespace SE
 {
 
+// The data read from the files of an asset, from which the asset is created. Each serializer derives its own type from it.
+class AssetLoadData
+{
+public:
+    virtual ~AssetLoadData() = default;
+};
+
 class AssetSerializer
 {
 public:
+    virtual ~AssetSerializer() = default;
+
     virtual bool serialize(AssetHandle handle) = 0;
     virtual RefPtr<Asset> deserialize(AssetMetadata& metadata) = 0;
+
+    //
+    // Loading an asset can be split in two phases: reading (and decoding) its files, which can be done by any thread,
+    // and creating the asset from the read data, which is always done by the main thread. This allows multiple assets
+    // to be read concurrently. The assets of serializers that don't support it are loaded by the main thread, using `deserialize`.
+    // NOTE: Multiple assets are read at the same time, so `read_asset` must not modify the state of the serializer.
+    //
+    NODISCARD virtual bool supports_concurrent_reads() const { return false; }
+    virtual OwnPtr<AssetLoadData> read_asset(const AssetMetadata& metadata) { return {}; }
+    virtual RefPtr<Asset> create_asset(AssetMetadata& metadata, OwnPtr<AssetLoadData> load_data) { return {}; }
 };
 
 } // namespace SE
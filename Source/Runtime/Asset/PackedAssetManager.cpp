@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Asset/PackedAssetManager.h>
+#include <Asset/TextureAsset.h>
+#include <Core/Log.h>
+#include <Renderer/CookedTexture.h>
+
+namespace SE
+{
+
+bool PackedAssetManager::initialize()
+{
+    return true;
+}
+
+void PackedAssetManager::shutdown()
+{
+    // The assets reference the mapped memory of the packs only while they are loaded, so the packs are closed last.
+    m_asset_slots.clear_and_shrink();
+    m_packs.clear_and_shrink();
+    m_decompression_buffer.release();
+
+    // Required by the AssetManager specification.
+    AssetManager::shutdown();
+}
+
+bool PackedAssetManager::mount_pack(const String& pack_filepath)
+{
+    OwnPtr<AssetPack> pack = create_own<AssetPack>();
+    if (!pack->open(pack_filepath))
+        return false;
+
+    SE_LOG_TAG_INFO("Asset", "Mounted the asset pack '{}', which contains '{}' assets.", pack_filepath, pack->get_entry_count());
+    m_packs.add(move(pack));
+    return true;
+}
+
+PackedAssetManager::AssetSlot* PackedAssetManager::find_or_add_asset_slot(AssetHandle handle)
+{
+    Optional<AssetSlot&> optional_asset_slot = m_asset_slots.get_if_exists(handle);
+    if (optional_asset_slot.has_value())
+        return &optional_asset_slot.value();
+
+    for (u32 pack_index = 0; pack_index < m_packs.count(); ++pack_index)
+    {
+        const AssetPackEntry* entry = m_packs[pack_index]->find_entry(handle);
+        if (entry == nullptr)
+            continue;
+
+        AssetSlot asset_slot;
+        asset_slot.metadata.type = entry->type;
+        asset_slot.metadata.state = AssetState::Unloaded;
+        asset_slot.metadata.handle = handle;
+        asset_slot.pack_index = pack_index;
+        asset_slot.entry = entry;
+
+        m_asset_slots.add(handle, move(asset_slot));
+        return &m_asset_slots.at(handle);
+    }
+
+    return nullptr;
+}
+
+RefPtr<Asset> PackedAssetManager::get_asset_sync(AssetHandle handle)
+{
+    AssetSlot* asset_slot = find_or_add_asset_slot(handle);
+    if (asset_slot == nullptr)
+    {
+        SE_LOG_TAG_ERROR("Asset", "Querying an invalid asset ID ({})!", handle.value());
+        return {};
+    }
+
+    // Check if the asset is already loaded.
+    if (asset_slot->metadata.state == AssetState::Ready)
+        return asset_slot->asset;
+
+    RefPtr<Asset> loaded_asset = load_asset(*asset_slot);
+    if (!loaded_asset.is_valid())
+    {
+        SE_LOG_TAG_ERROR("Asset", "Failed to load asset with ID '{}'!", handle.value());
+        return {};
+    }
+
+    asset_slot->asset = move(loaded_asset);
+    asset_slot->metadata.state = AssetState::Ready;
+    return asset_slot->asset;
+}
+
+AssetMetadata& PackedAssetManager::get_asset_metadata(AssetHandle handle)
+{
+    AssetSlot* asset_slot = find_or_add_asset_slot(handle);
+    if (asset_slot == nullptr)
+    {
+        SE_LOG_TAG_ERROR("Asset", "Querying an invalid asset ID ({})!", handle.value());
+        return m_empty_asset_slot.metadata;
+    }
+
+    return asset_slot->metadata;
+}
+
+RefPtr<Asset> PackedAssetManager::load_asset(const AssetSlot& asset_slot)
+{
+    const AssetPack& pack = *m_packs[asset_slot.pack_index];
+    const AssetPackEntry& entry = *asset_slot.entry;
+
+    ReadonlyByteSpan entry_bytes;
+    if (!pack.read_entry(entry, m_decompression_buffer, entry_bytes))
+    {
+        SE_LOG_TAG_ERROR("Asset", "The asset '{}' is corrupted in the asset pack '{}'!", pack.get_entry_name(entry), pack.get_filepath());
+        return {};
+    }
+
+    switch (entry.type)
+    {
+        case AssetType::Texture:
+        {
+            // The entries of the texture assets store their cooked texture.
+            RefPtr<Texture2D> renderer_texture = CookedTexture::create_from_memory(entry_bytes);
+            if (!renderer_texture.is_valid())
+                return {};
+
+            RefPtr<TextureAsset> asset = create_ref<TextureAsset>(move(renderer_texture), String(pack.get_entry_name(entry)));
+            return asset.as<Asset>();
+        }
+
+        case AssetType::Unknown: break;
+    }
+
+    SE_LOG_TAG_ERROR("Asset", "The asset '{}' has an unsupported type!", pack.get_entry_name(entry));
+    return {};
+}
+
+} // namespace SE
@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Asset/AssetManager.h>
+#include <Asset/AssetPack.h>
+#include <Core/Containers/HashMap.h>
+#include <Core/Containers/OwnPtr.h>
+#include <Core/Containers/Vector.h>
+
+namespace SE
+{
+
+//
+// Asset manager that resolves the assets from asset packs, instead of the loose files of a project. The packs are
+// memory mapped when they are mounted, so the only file that is opened while loading assets is the pack itself.
+//
+class PackedAssetManager : public AssetManager
+{
+public:
+    SHOOTER_API virtual bool initialize() override;
+    SHOOTER_API virtual void shutdown() override;
+
+    SHOOTER_API virtual RefPtr<Asset> get_asset_sync(AssetHandle handle) override;
+    SHOOTER_API virtual AssetMetadata& get_asset_metadata(AssetHandle handle) override;
+
+    //
+    // Makes the assets of the given pack available. When multiple mounted packs contain the same asset,
+    // the pack that was mounted first is used.
+    //
+    SHOOTER_API bool mount_pack(const String& pack_filepath);
+
+private:
+    struct AssetSlot
+    {
+        AssetMetadata metadata;
+        RefPtr<Asset> asset;
+        u32 pack_index;
+        const AssetPackEntry* entry;
+    };
+
+    // Returns the slot of the asset, creating it if the asset is stored in a mounted pack but hasn't been queried yet.
+    AssetSlot* find_or_add_asset_slot(AssetHandle handle);
+
+    RefPtr<Asset> load_asset(const AssetSlot& asset_slot);
+
+private:
+    Vector<OwnPtr<AssetPack>> m_packs;
+    HashMap<AssetHandle, AssetSlot> m_asset_slots;
+    AssetSlot m_empty_asset_slot;
+
+    // Reused between loads, so decompressing the entries doesn't allocate memory every time.
+    Buffer m_decompression_buffer;
+};
+
+} // namespace SE
@@ -12,6 +12,17 @@ TextureAsset::TextureAsset(RefPtr<Texture2D> renderer_texture, String texture_fi
     : Asset(AssetType::Texture)
     , m_renderer_texture(move(renderer_texture))
     , m_texture_filepath(move(texture_filepath))
+    , m_is_packed_in_atlas(false)
+    , m_atlas_source_hash(0)
 {}
 
+void TextureAsset::set_atlas_region(RefPtr<Texture2D> atlas_page_texture, String atlas_page_filepath, const TextureUVRect& uv_rect, u64 atlas_source_hash)
+{
+    m_renderer_texture = move(atlas_page_texture);
+    m_atlas_page_filepath = move(atlas_page_filepath);
+    m_uv_rect = uv_rect;
+    m_is_packed_in_atlas = true;
+    m_atlas_source_hash = atlas_source_hash;
+}
+
 } // namespace SE
@@ -21,12 +21,34 @@ public:
 
     SHOOTER_API TextureAsset(RefPtr<Texture2D> renderer_texture, String texture_filepath);
 
+    // NOTE: When the texture is packed in an atlas this is the texture of the atlas page, so it must always be
+    //       sampled using the UV rectangle of the asset.
     NODISCARD ALWAYS_INLINE RefPtr<Texture2D> get_renderer_texture() const { return m_renderer_texture; }
     NODISCARD ALWAYS_INLINE const String& get_texture_filepath() const { return m_texture_filepath; }
 
+    NODISCARD ALWAYS_INLINE const TextureUVRect& get_uv_rect() const { return m_uv_rect; }
+    NODISCARD ALWAYS_INLINE bool is_packed_in_atlas() const { return m_is_packed_in_atlas; }
+
+    // The filepath of the cooked atlas page image. Empty if the texture isn't packed in an atlas or if it was
+    // packed at runtime, in a dynamic atlas.
+    NODISCARD ALWAYS_INLINE const String& get_atlas_page_filepath() const { return m_atlas_page_filepath; }
+
+    // The hash of the source image that was packed in the cooked atlas page. Zero if the texture has no atlas page file.
+    NODISCARD ALWAYS_INLINE u64 get_atlas_source_hash() const { return m_atlas_source_hash; }
+
+public:
+    SHOOTER_API void set_atlas_region(
+        RefPtr<Texture2D> atlas_page_texture, String atlas_page_filepath, const TextureUVRect& uv_rect, u64 atlas_source_hash = 0
+    );
+
 private:
     RefPtr<Texture2D> m_renderer_texture;
     String m_texture_filepath;
+
+    TextureUVRect m_uv_rect;
+    bool m_is_packed_in_atlas;
+    String m_atlas_page_filepath;
+    u64 m_atlas_source_hash;
 };
 
 } // namespace SE
@@ -5,8 +5,20 @@
 
 #pragma once
 
+#include <Core/API.h>
 #include <Core/CoreDefines.h>
 
+namespace SE
+{
+
+//
+// Invoked when an assertion fails, before the debugger is triggered.
+// Flushes the logger, so the messages logged before the failure are not lost when the process is terminated.
+//
+SHOOTER_API void on_assertion_failed();
+
+} // namespace SE
+
 #if SE_CONFIGURATION_DEBUG
     #define SE_ASSERTION_ENABLE_DEBUG_ASSERT 1
     #define SE_ASSERTION_ENABLE_ASSERT       1
@@ -23,27 +35,30 @@
 #endif // SE_CONFIGURATION_DEBUG
 
 #if SE_ASSERTION_ENABLE_DEBUG_ASSERT
-    #define SE_DEBUG_ASSERT(...) \
-        if (!(__VA_ARGS__))      \
-        {                        \
-            SE_DEBUGBREAK;       \
+    #define SE_DEBUG_ASSERT(...)         \
+        if (!(__VA_ARGS__))              \
+        {                                \
+            ::SE::on_assertion_failed(); \
+            SE_DEBUGBREAK;               \
         }
 #else
     #define SE_DEBUG_ASSERT(...) // Exclude from build.
 #endif // SE_ASSERTION_ENABLE_DEBUG_ASSERT
 
 #if SE_ASSERTION_ENABLE_ASSERT
-    #define SE_ASSERT(...)  \
-        if (!(__VA_ARGS__)) \
-        {                   \
-            SE_DEBUGBREAK;  \
+    #define SE_ASSERT(...)               \
+        if (!(__VA_ARGS__))              \
+        {                                \
+            ::SE::on_assertion_failed(); \
+            SE_DEBUGBREAK;               \
         }
 #else
     #define SE_ASSERT(...) // Exclude from build.
 #endif // SE_ASSERTION_ENABLE_ASSERT
 
-#define SE_VERIFY(...)  \
-    if (!(__VA_ARGS__)) \
-    {                   \
-        SE_DEBUGBREAK;  \
+#define SE_VERIFY(...)               \
+    if (!(__VA_ARGS__))              \
+    {                                \
+        ::SE::on_assertion_failed(); \
+        SE_DEBUGBREAK;               \
     }
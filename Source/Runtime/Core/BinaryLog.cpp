@@ -0,0 +1,286 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/BinaryLog.h>
+#include <Core/Containers/Vector.h>
+#include <Core/Log.h>
+
+namespace SE
+{
+
+// Formats the argument that starts at the given offset, and advances the offset past it. Returns false if the bytes are invalid.
+static bool format_binary_log_argument(
+    FormatBuilder& builder, const FormatBuilder::Specifier& specifier, BinaryLogArgumentType argument_type, ReadonlyByteSpan argument_bytes,
+    usize& offset
+)
+{
+    if (offset + binary_log_slot_byte_count > argument_bytes.count())
+        return false;
+
+    // NOTE: The arguments are always aligned to the size of a slot, as the binary buffers are.
+    const u8* slot = argument_bytes.elements() + offset;
+    offset += binary_log_slot_byte_count;
+
+    FormatErrorCode error_code = FormatErrorCode::Success;
+    switch (argument_type)
+    {
+        case BinaryLogArgumentType::UnsignedInteger:
+            error_code = builder.push_unsigned_integer(specifier, *reinterpret_cast<const u64*>(slot));
+            break;
+        case BinaryLogArgumentType::SignedInteger:
+            error_code = builder.push_signed_integer(specifier, *reinterpret_cast<const i64*>(slot));
+            break;
+        case BinaryLogArgumentType::Bool:
+            error_code = Formatter<bool>::format(builder, specifier, *reinterpret_cast<const u64*>(slot) != 0);
+            break;
+        case BinaryLogArgumentType::Float:
+            error_code = builder.push_floating_point(specifier, static_cast<float>(*reinterpret_cast<const double*>(slot)));
+            break;
+        case BinaryLogArgumentType::Double:
+            error_code = builder.push_floating_point(specifier, *reinterpret_cast<const double*>(slot));
+            break;
+        case BinaryLogArgumentType::UUID:
+            error_code = Formatter<UUID>::format(builder, specifier, UUID(*reinterpret_cast<const u64*>(slot)));
+            break;
+        case BinaryLogArgumentType::String:
+        {
+            const u64 byte_count = *reinterpret_cast<const u64*>(slot);
+            if (byte_count > binary_log_max_string_byte_count || offset + align_to_binary_log_slot(byte_count) > argument_bytes.count())
+                return false;
+
+            const char* characters = reinterpret_cast<const char*>(argument_bytes.elements() + offset);
+            offset += align_to_binary_log_slot(byte_count);
+            error_code = builder.push_string(specifier, StringView::unsafe_create_from_utf8(characters, byte_count));
+            break;
+        }
+        default: return false;
+    }
+
+    return (error_code == FormatErrorCode::Success);
+}
+
+bool format_binary_log_message(FormatBuilder& builder, StringView format, Span<const BinaryLogArgumentType> argument_types, ReadonlyByteSpan argument_bytes)
+{
+    // NOTE: The format string was validated at compile time, but it is parsed again here because the log decoder tool
+    //       only has access to the text of the format.
+    const char* characters = format.characters();
+    const usize byte_count = format.byte_count();
+    usize segment_offset = 0;
+    usize argument_index = 0;
+    usize argument_offset = 0;
+
+    for (usize offset = 0; offset < byte_count; ++offset)
+    {
+        if (characters[offset] != '{')
+            continue;
+
+        usize specifier_end_offset = offset + 1;
+        while (specifier_end_offset < byte_count && characters[specifier_end_offset] != '}')
+            ++specifier_end_offset;
+        if (specifier_end_offset == byte_count || argument_index == argument_types.count())
+            return false;
+
+        FormatBuilder::Specifier specifier;
+        const StringView specifier_string = StringView::unsafe_create_from_utf8(characters + offset + 1, specifier_end_offset - offset - 1);
+        if (!FormatBuilder::parse_specifier(specifier_string, specifier))
+            return false;
+
+        builder.push_characters(characters + segment_offset, offset - segment_offset);
+        if (!format_binary_log_argument(builder, specifier, argument_types[argument_index], argument_bytes, argument_offset))
+            return false;
+
+        segment_offset = specifier_end_offset + 1;
+        offset = specifier_end_offset;
+        ++argument_index;
+    }
+
+    builder.push_characters(characters + segment_offset, byte_count - segment_offset);
+    return (argument_index == argument_types.count() && argument_offset == argument_bytes.count());
+}
+
+//
+// Reads the values stored in a binary log file, checking that they don't exceed the bounds of the file.
+//
+class BinaryLogReader
+{
+public:
+    ALWAYS_INLINE explicit BinaryLogReader(ReadonlyByteSpan bytes)
+        : m_bytes(bytes)
+        , m_offset(0)
+    {}
+
+    NODISCARD ALWAYS_INLINE bool is_at_end() const { return (m_offset == m_bytes.count()); }
+
+    template<typename T>
+    NODISCARD ALWAYS_INLINE bool read(T& out_value)
+    {
+        if (m_offset + sizeof(T) > m_bytes.count())
+            return false;
+        // NOTE: The values are not aligned in the file, so they are copied instead of being accessed in place.
+        copy_memory(&out_value, m_bytes.elements() + m_offset, sizeof(T));
+        m_offset += sizeof(T);
+        return true;
+    }
+
+    NODISCARD ALWAYS_INLINE bool read_bytes(usize byte_count, ReadonlyByteSpan& out_bytes)
+    {
+        if (m_offset + byte_count > m_bytes.count())
+            return false;
+        out_bytes = ReadonlyByteSpan(m_bytes.elements() + m_offset, byte_count);
+        m_offset += byte_count;
+        return true;
+    }
+
+private:
+    ReadonlyByteSpan m_bytes;
+    usize m_offset;
+};
+
+struct DecodedBinaryLogFormat
+{
+    bool is_valid { false };
+    Logger::Severity::Type severity { Logger::Severity::Trace };
+    StringView format;
+    Span<const BinaryLogArgumentType> argument_types;
+};
+
+NODISCARD static StringView bytes_to_string_view(ReadonlyByteSpan bytes)
+{
+    return StringView::unsafe_create_from_utf8(reinterpret_cast<const char*>(bytes.elements()), bytes.count());
+}
+
+bool decode_binary_log_file(ReadonlyByteSpan file_bytes, LogSink& sink)
+{
+    BinaryLogReader reader = BinaryLogReader(file_bytes);
+
+    BinaryLogFile::Header header;
+    if (!reader.read(header) || header.magic != BinaryLogFile::magic)
+    {
+        SE_LOG_ERROR("The file is not a binary log file!");
+        return false;
+    }
+    if (header.version != BinaryLogFile::version || header.tick_counter_frequency == 0)
+    {
+        SE_LOG_ERROR("The version {} of the binary log file is not supported!", header.version);
+        return false;
+    }
+
+    Vector<DecodedBinaryLogFormat> formats;
+    // The arguments are copied to an aligned buffer before they are formatted, as they are not aligned in the file.
+    Vector<u64> argument_slots;
+    FormatMemoryBuilder<512> message;
+    FormatMemoryBuilder<512> line;
+
+    while (!reader.is_at_end())
+    {
+        BinaryLogFile::ChunkKind chunk_kind;
+        if (!reader.read(chunk_kind))
+            return false;
+
+        LogMessage log_message = {};
+        if (chunk_kind == BinaryLogFile::ChunkKind::Format)
+        {
+            u32 format_id;
+            u8 severity;
+            u8 argument_count;
+            u32 format_byte_count;
+            ReadonlyByteSpan argument_type_bytes;
+            ReadonlyByteSpan format_bytes;
+            if (!reader.read(format_id) || !reader.read(severity) || !reader.read(argument_count) || !reader.read(format_byte_count) ||
+                !reader.read_bytes(argument_count, argument_type_bytes) || !reader.read_bytes(format_byte_count, format_bytes) ||
+                severity >= Logger::Severity::EnumCount)
+            {
+                break;
+            }
+
+            if (format_id >= formats.count())
+                formats.set_count(format_id + 1);
+
+            DecodedBinaryLogFormat& format = formats[format_id];
+            format.is_valid = true;
+            format.severity = static_cast<Logger::Severity::Type>(severity);
+            format.format = bytes_to_string_view(format_bytes);
+            const BinaryLogArgumentType* argument_types = reinterpret_cast<const BinaryLogArgumentType*>(argument_type_bytes.elements());
+            format.argument_types = Span<const BinaryLogArgumentType>(argument_types, argument_count);
+            continue;
+        }
+        else if (chunk_kind == BinaryLogFile::ChunkKind::TextMessage)
+        {
+            u8 severity;
+            u32 tag_byte_count;
+            u32 message_byte_count;
+            ReadonlyByteSpan tag_bytes;
+            ReadonlyByteSpan message_bytes;
+            if (!reader.read(severity) || !reader.read(log_message.tick_counter) || !reader.read(log_message.thread_id) || !reader.read(tag_byte_count) ||
+                !reader.read(message_byte_count) || !reader.read_bytes(tag_byte_count, tag_bytes) || !reader.read_bytes(message_byte_count, message_bytes) ||
+                severity >= Logger::Severity::EnumCount)
+            {
+                break;
+            }
+
+            log_message.severity = static_cast<Logger::Severity::Type>(severity);
+            if (tag_byte_count > 0)
+                log_message.tag = Name(bytes_to_string_view(tag_bytes));
+            log_message.message = bytes_to_string_view(message_bytes);
+        }
+        else if (chunk_kind == BinaryLogFile::ChunkKind::BinaryMessage)
+        {
+            u32 format_id;
+            u32 argument_byte_count;
+            ReadonlyByteSpan argument_bytes;
+            if (!reader.read(format_id) || !reader.read(log_message.tick_counter) || !reader.read(log_message.thread_id) ||
+                !reader.read(argument_byte_count) || !reader.read_bytes(argument_byte_count, argument_bytes))
+            {
+                break;
+            }
+
+            if (format_id >= formats.count() || !formats[format_id].is_valid)
+            {
+                SE_LOG_ERROR("The binary log file contains a message with an unknown format!");
+                return false;
+            }
+
+            const DecodedBinaryLogFormat& format = formats[format_id];
+            argument_slots.set_count(align_to_binary_log_slot(argument_byte_count) / binary_log_slot_byte_count);
+            copy_memory(argument_slots.elements(), argument_bytes.elements(), argument_byte_count);
+
+            message.clear();
+            const ReadonlyByteSpan aligned_argument_bytes = ReadonlyByteSpan(reinterpret_cast<ReadonlyBytes>(argument_slots.elements()), argument_byte_count);
+            if (!format_binary_log_message(message, format.format, format.argument_types, aligned_argument_bytes))
+            {
+                message.clear();
+                format_to(message, "Failed to format the binary message '{}'!"sv, format.format);
+            }
+
+            log_message.severity = format.severity;
+            log_message.message = message.view();
+        }
+        else
+        {
+            break;
+        }
+
+        // NOTE: The tick counter is converted to milliseconds in two steps, so the multiplication doesn't overflow.
+        const u64 elapsed_ticks = log_message.tick_counter - header.start_tick_counter;
+        const u64 elapsed_milliseconds =
+            (elapsed_ticks / header.tick_counter_frequency) * 1000 + ((elapsed_ticks % header.tick_counter_frequency) * 1000) / header.tick_counter_frequency;
+        const u64 millisecond_of_day = (header.start_millisecond_of_day + elapsed_milliseconds) % (24 * 60 * 60 * 1000);
+
+        line.clear();
+        Logger::format_line(line, millisecond_of_day, log_message.severity, log_message.tag, log_message.message);
+        log_message.line = line.view();
+        sink.write(log_message);
+    }
+
+    sink.flush();
+    if (!reader.is_at_end())
+    {
+        // The last chunk is incomplete if the process was terminated while the file was written, which is expected.
+        SE_LOG_WARN("The binary log file ends with an incomplete message.");
+    }
+    return true;
+}
+
+} // namespace SE
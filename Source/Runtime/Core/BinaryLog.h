@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/String/Format.h>
+
+namespace SE
+{
+
+// Forward declarations.
+class LogSink;
+
+//
+// The type of an argument of a binary log message, as stored in its format. The type determines how the bytes of the
+// argument are encoded, so the message can be formatted later by the logger thread or by the log decoder tool.
+//
+enum class BinaryLogArgumentType : u8
+{
+    Invalid = 0,
+
+    UnsignedInteger,
+    SignedInteger,
+    Bool,
+    // Stored as a double, which represents every float value exactly.
+    Float,
+    Double,
+    UUID,
+    String,
+};
+
+//
+// The arguments are encoded in slots of 8 bytes, so all of them can be written with aligned stores. A string is encoded
+// as its byte count followed by its characters, padded to a multiple of the slot size.
+//
+static constexpr usize binary_log_slot_byte_count = sizeof(u64);
+// Longer strings are truncated, as the arguments of a binary message are meant to be small.
+static constexpr usize binary_log_max_string_byte_count = 255;
+
+NODISCARD ALWAYS_INLINE static constexpr usize align_to_binary_log_slot(usize byte_count)
+{
+    return (byte_count + binary_log_slot_byte_count - 1) & ~(binary_log_slot_byte_count - 1);
+}
+
+//
+// Describes how a type is encoded as an argument of a binary log message.
+// NOTE: Only the types that have a specialization can be logged with `SE_LOG_FAST`.
+//
+template<typename T>
+struct BinaryLogArgument;
+
+template<typename T>
+requires (is_integral<T>)
+struct BinaryLogArgument<T>
+{
+    static constexpr BinaryLogArgumentType type = is_signed_integral<T> ? BinaryLogArgumentType::SignedInteger : BinaryLogArgumentType::UnsignedInteger;
+
+    NODISCARD ALWAYS_INLINE static constexpr usize get_byte_count(const T&) { return binary_log_slot_byte_count; }
+
+    ALWAYS_INLINE static u8* write(u8* destination, const T& value)
+    {
+        if constexpr (is_signed_integral<T>)
+            *reinterpret_cast<i64*>(destination) = static_cast<i64>(value);
+        else
+            *reinterpret_cast<u64*>(destination) = static_cast<u64>(value);
+        return destination + binary_log_slot_byte_count;
+    }
+};
+
+template<>
+struct BinaryLogArgument<bool>
+{
+    static constexpr BinaryLogArgumentType type = BinaryLogArgumentType::Bool;
+
+    NODISCARD ALWAYS_INLINE static constexpr usize get_byte_count(const bool&) { return binary_log_slot_byte_count; }
+
+    ALWAYS_INLINE static u8* write(u8* destination, const bool& value)
+    {
+        *reinterpret_cast<u64*>(destination) = value ? 1 : 0;
+        return destination + binary_log_slot_byte_count;
+    }
+};
+
+template<>
+struct BinaryLogArgument<float>
+{
+    static constexpr BinaryLogArgumentType type = BinaryLogArgumentType::Float;
+
+    NODISCARD ALWAYS_INLINE static constexpr usize get_byte_count(const float&) { return binary_log_slot_byte_count; }
+
+    ALWAYS_INLINE static u8* write(u8* destination, const float& value)
+    {
+        *reinterpret_cast<double*>(destination) = static_cast<double>(value);
+        return destination + binary_log_slot_byte_count;
+    }
+};
+
+template<>
+struct BinaryLogArgument<double>
+{
+    static constexpr BinaryLogArgumentType type = BinaryLogArgumentType::Double;
+
+    NODISCARD ALWAYS_INLINE static constexpr usize get_byte_count(const double&) { return binary_log_slot_byte_count; }
+
+    ALWAYS_INLINE static u8* write(u8* destination, const double& value)
+    {
+        *reinterpret_cast<double*>(destination) = value;
+        return destination + binary_log_slot_byte_count;
+    }
+};
+
+template<>
+struct BinaryLogArgument<UUID>
+{
+    static constexpr BinaryLogArgumentType type = BinaryLogArgumentType::UUID;
+
+    NODISCARD ALWAYS_INLINE static constexpr usize get_byte_count(const UUID&) { return binary_log_slot_byte_count; }
+
+    ALWAYS_INLINE static u8* write(u8* destination, const UUID& value)
+    {
+        *reinterpret_cast<u64*>(destination) = value.value();
+        return destination + binary_log_slot_byte_count;
+    }
+};
+
+template<>
+struct BinaryLogArgument<StringView>
+{
+    static constexpr BinaryLogArgumentType type = BinaryLogArgumentType::String;
+
+    NODISCARD ALWAYS_INLINE static usize get_byte_count(const StringView& value)
+    {
+        const usize byte_count = (value.byte_count() < binary_log_max_string_byte_count) ? value.byte_count() : binary_log_max_string_byte_count;
+        return binary_log_slot_byte_count + align_to_binary_log_slot(byte_count);
+    }
+
+    ALWAYS_INLINE static u8* write(u8* destination, const StringView& value)
+    {
+        // NOTE: A truncated string might end in the middle of a codepoint, which is acceptable for a diagnostic message.
+        const usize byte_count = (value.byte_count() < binary_log_max_string_byte_count) ? value.byte_count() : binary_log_max_string_byte_count;
+        *reinterpret_cast<u64*>(destination) = byte_count;
+        copy_memory(destination + binary_log_slot_byte_count, value.characters(), byte_count);
+        return destination + binary_log_slot_byte_count + align_to_binary_log_slot(byte_count);
+    }
+};
+
+template<>
+struct BinaryLogArgument<String>
+{
+    static constexpr BinaryLogArgumentType type = BinaryLogArgumentType::String;
+
+    NODISCARD ALWAYS_INLINE static usize get_byte_count(const String& value) { return BinaryLogArgument<StringView>::get_byte_count(value.view()); }
+    ALWAYS_INLINE static u8* write(u8* destination, const String& value) { return BinaryLogArgument<StringView>::write(destination, value.view()); }
+};
+
+template<>
+struct BinaryLogArgument<Name>
+{
+    static constexpr BinaryLogArgumentType type = BinaryLogArgumentType::String;
+
+    NODISCARD ALWAYS_INLINE static usize get_byte_count(const Name& value) { return BinaryLogArgument<StringView>::get_byte_count(value.view()); }
+    ALWAYS_INLINE static u8* write(u8* destination, const Name& value) { return BinaryLogArgument<StringView>::write(destination, value.view()); }
+};
+
+//
+// Formats a binary log message, by replacing the specifiers of the format string with the encoded arguments.
+// Returns false if the arguments don't match the format (which only happens if the bytes are corrupted).
+//
+NODISCARD SHOOTER_API bool format_binary_log_message(
+    FormatBuilder& builder, StringView format, Span<const BinaryLogArgumentType> argument_types, ReadonlyByteSpan argument_bytes
+);
+
+//
+// Layout of the file written by `BinaryFileLogSink` and read by the log decoder tool.
+// The file starts with a header, followed by a sequence of chunks. Each chunk starts with a byte that identifies its kind,
+// and the format of a binary message is always written before the first message that uses it.
+//
+struct BinaryLogFile
+{
+    static constexpr u32 magic = 0x474F4C53; // "SLOG"
+    static constexpr u32 version = 1;
+
+    struct Header
+    {
+        u32 magic;
+        u32 version;
+        u64 tick_counter_frequency;
+        // The tick counter and the local time of the day when the file was created, used to calculate the time of the messages.
+        u64 start_tick_counter;
+        u64 start_millisecond_of_day;
+    };
+
+    enum class ChunkKind : u8
+    {
+        // u32 format id, u8 severity, u8 argument count, u32 format byte count, argument types, format characters.
+        Format = 1,
+        // u8 severity, u64 tick counter, u64 thread id, u32 tag byte count, u32 message byte count, tag and message characters.
+        TextMessage = 2,
+        // u32 format id, u64 tick counter, u64 thread id, u32 argument byte count, argument bytes.
+        BinaryMessage = 3,
+    };
+};
+
+//
+// Converts the contents of a binary log file to text, by formatting its messages exactly as the logger thread does, and
+// writes them to the given sink. Returns false if the bytes are not a valid binary log file. Used by the log decoder tool.
+//
+NODISCARD SHOOTER_API bool decode_binary_log_file(ReadonlyByteSpan file_bytes, LogSink& sink);
+
+} // namespace SE
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/Containers/Hash.h>
+#include <Core/Memory/MemoryOperations.h>
+
+namespace SE
+{
+
+static constexpr u64 s_xxh64_prime_1 = 0x9E3779B185EBCA87;
+static constexpr u64 s_xxh64_prime_2 = 0xC2B2AE3D27D4EB4F;
+static constexpr u64 s_xxh64_prime_3 = 0x165667B19E3779F9;
+static constexpr u64 s_xxh64_prime_4 = 0x85EBCA77C2B2AE63;
+static constexpr u64 s_xxh64_prime_5 = 0x27D4EB2F165667C5;
+
+NODISCARD ALWAYS_INLINE static u64 rotate_left(u64 value, u32 shift)
+{
+    return (value << shift) | (value >> (64 - shift));
+}
+
+NODISCARD ALWAYS_INLINE static u64 read_u64(ReadonlyBytes bytes)
+{
+    // NOTE: The input is not necessarily aligned, so the value is copied instead of being dereferenced.
+    u64 value;
+    copy_memory(&value, bytes, sizeof(u64));
+    return value;
+}
+
+NODISCARD ALWAYS_INLINE static u32 read_u32(ReadonlyBytes bytes)
+{
+    u32 value;
+    copy_memory(&value, bytes, sizeof(u32));
+    return value;
+}
+
+NODISCARD ALWAYS_INLINE static u64 xxh64_round(u64 accumulator, u64 lane)
+{
+    accumulator += lane * s_xxh64_prime_2;
+    accumulator = rotate_left(accumulator, 31);
+    return accumulator * s_xxh64_prime_1;
+}
+
+NODISCARD ALWAYS_INLINE static u64 xxh64_merge_accumulator(u64 hash, u64 accumulator)
+{
+    hash ^= xxh64_round(0, accumulator);
+    return hash * s_xxh64_prime_1 + s_xxh64_prime_4;
+}
+
+u64 hash_memory(ReadonlyByteSpan bytes, u64 seed /*= 0*/)
+{
+    ReadonlyBytes input = bytes.elements();
+    const usize byte_count = bytes.count();
+    usize offset = 0;
+    u64 hash;
+
+    if (byte_count >= 32)
+    {
+        // The input is processed in stripes of 32 bytes, by four independent accumulators.
+        u64 accumulators[4] = { seed + s_xxh64_prime_1 + s_xxh64_prime_2, seed + s_xxh64_prime_2, seed, seed - s_xxh64_prime_1 };
+        for (; offset + 32 <= byte_count; offset += 32)
+        {
+            accumulators[0] = xxh64_round(accumulators[0], read_u64(input + offset + 0));
+            accumulators[1] = xxh64_round(accumulators[1], read_u64(input + offset + 8));
+            accumulators[2] = xxh64_round(accumulators[2], read_u64(input + offset + 16));
+            accumulators[3] = xxh64_round(accumulators[3], read_u64(input + offset + 24));
+        }
+
+        hash = rotate_left(accumulators[0], 1) + rotate_left(accumulators[1], 7) + rotate_left(accumulators[2], 12) + rotate_left(accumulators[3], 18);
+        for (u32 accumulator_index = 0; accumulator_index < 4; ++accumulator_index)
+            hash = xxh64_merge_accumulator(hash, accumulators[accumulator_index]);
+    }
+    else
+    {
+        hash = seed + s_xxh64_prime_5;
+    }
+
+    hash += static_cast<u64>(byte_count);
+
+    // Consume the bytes that don't form a complete stripe.
+    for (; offset + 8 <= byte_count; offset += 8)
+    {
+        hash ^= xxh64_round(0, read_u64(input + offset));
+        hash = rotate_left(hash, 27) * s_xxh64_prime_1 + s_xxh64_prime_4;
+    }
+
+    if (offset + 4 <= byte_count)
+    {
+        hash ^= static_cast<u64>(read_u32(input + offset)) * s_xxh64_prime_1;
+        hash = rotate_left(hash, 23) * s_xxh64_prime_2 + s_xxh64_prime_3;
+        offset += 4;
+    }
+
+    for (; offset < byte_count; ++offset)
+    {
+        hash ^= static_cast<u64>(input[offset]) * s_xxh64_prime_5;
+        hash = rotate_left(hash, 11) * s_xxh64_prime_1;
+    }
+
+    // Final avalanche, so that every input bit affects every output bit.
+    hash ^= hash >> 33;
+    hash *= s_xxh64_prime_2;
+    hash ^= hash >> 29;
+    hash *= s_xxh64_prime_3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+} // namespace SE
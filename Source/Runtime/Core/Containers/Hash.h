@@ -5,12 +5,21 @@
 
 #pragma once
 
+#include <Core/API.h>
 #include <Core/Assertions.h>
+#include <Core/Containers/Span.h>
 #include <Core/CoreTypes.h>
 
 namespace SE
 {
 
+//
+// Calculates the 64-bit hash of a block of memory, using the XXH64 algorithm. Meant for large blocks (such as the contents
+// of a file), where the hash is used to detect if the contents have changed.
+// https://github.com/Cyan4973/xxHash/blob/dev/doc/xxhash_spec.md
+//
+NODISCARD SHOOTER_API u64 hash_memory(ReadonlyByteSpan bytes, u64 seed = 0);
+
 template<typename T>
 struct Hasher
 {
@@ -22,14 +31,35 @@ struct Hasher
     }
 };
 
+template<>
+struct Hasher<u64>
+{
+    NODISCARD ALWAYS_INLINE static u64 get_hash(const u64& value)
+    {
+        // NOTE: The finalizer of the SplitMix64 generator. It ensures that integer keys that only differ
+        //       in a few bits (such as packed coordinates) are spread across the whole table.
+        u64 hash = value;
+        hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9;
+        hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EB;
+        return hash ^ (hash >> 31);
+    }
+};
+
 template<>
 struct Hasher<void*>
 {
     NODISCARD ALWAYS_INLINE static u64 get_hash(const void* const& value)
     {
-        // TODO: Provide a better hashing function for raw pointers.
-        return reinterpret_cast<u64>(value);
+        // NOTE: Heap allocations are aligned and often allocated next to each other, so the pointers only differ in a few
+        //       of their middle bits. Used directly they fill long runs of adjacent slots, which makes probing linear.
+        return Hasher<u64>::get_hash(reinterpret_cast<u64>(value));
     }
 };
 
+template<typename T>
+struct Hasher<T*>
+{
+    NODISCARD ALWAYS_INLINE static u64 get_hash(T* const& value) { return Hasher<void*>::get_hash(value); }
+};
+
 } // namespace SE
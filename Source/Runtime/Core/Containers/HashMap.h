@@ -295,7 +295,24 @@ public:
 
     ALWAYS_INLINE ValueType& operator[](const KeyType& key) { return get_or_add(key); }
 
+    ALWAYS_INLINE void remove(const KeyType& key)
+    {
+        const Bucket& key_as_bucket = unsafe_bucket_from_key(key);
+        m_buckets.remove(key_as_bucket);
+    }
+
+    ALWAYS_INLINE HashMapRemoveResult remove_if_exists(const KeyType& key)
+    {
+        const Bucket& key_as_bucket = unsafe_bucket_from_key(key);
+        const HashTableRemoveResult remove_result = m_buckets.remove_if_exists(key_as_bucket);
+        return (remove_result == HashTableRemoveResult::RemovedExistingEntry) ? HashMapRemoveResult::RemovedExistingKey
+                                                                                : HashMapRemoveResult::KeyDoesNotExist;
+    }
+
 public:
+    // Makes sure that the given number of keys can be stored without re-allocating the map.
+    ALWAYS_INLINE void reserve(usize key_count) { m_buckets.reserve(key_count); }
+
     ALWAYS_INLINE void clear() { m_buckets.clear(); }
 
     ALWAYS_INLINE void clear_and_shrink() { m_buckets.clear_and_shrink(); }
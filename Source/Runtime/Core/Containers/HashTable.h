@@ -372,6 +372,12 @@ public:
     }
 
 public:
+    //
+    // Makes sure that the given number of elements can be stored without re-allocating the table. When the final number
+    // of elements is known in advance, this avoids re-hashing all the elements every time the table grows.
+    //
+    ALWAYS_INLINE void reserve(usize element_count) { re_allocate_if_overloaded(element_count); }
+
     ALWAYS_INLINE void clear()
     {
         if (m_occupied_slot_count == 0)
@@ -389,6 +395,8 @@ public:
 
             m_slots_metadata[index] = metadata_empty_value;
         }
+
+        m_occupied_slot_count = 0;
     }
 
     ALWAYS_INLINE void clear_and_shrink()
@@ -414,7 +422,7 @@ public:
     ALWAYS_INLINE void remove(const T& element)
     {
         Optional<usize> optional_slot_index = find(element);
-        SE_ASSERT(optional_slot_index);
+        SE_ASSERT(optional_slot_index.has_value());
 
         const usize slot_index = *optional_slot_index;
         m_slots[slot_index].~T();
@@ -425,7 +433,7 @@ public:
     ALWAYS_INLINE HashTableRemoveResult remove_if_exists(const T& element)
     {
         const auto optional_slot_index = find(element);
-        if (!optional_slot_index)
+        if (!optional_slot_index.has_value())
         {
             return HashTableRemoveResult::EntryDoesNotExist;
         }
@@ -7,10 +7,16 @@
 
 #include <Core/Assertions.h>
 #include <Core/CoreTypes.h>
+#include <Core/Platform/Atomic.h>
 
 namespace SE
 {
 
+//
+// Base class for objects whose lifetime is managed by `RefPtr`.
+// The reference count is atomic, so references to the same object can be acquired and released from
+// multiple threads (for example, by the render thread while it executes the submitted commands).
+//
 class RefCounted
 {
     SE_MAKE_NONCOPYABLE(RefCounted);
@@ -29,22 +35,26 @@ public:
 private:
     NODISCARD ALWAYS_INLINE u32 get_reference_count() const
     {
-        SE_ASSERT(m_reference_count > 0);
-        return m_reference_count;
+        const u32 reference_count = m_reference_count.load(MemoryOrder::Relaxed);
+        SE_ASSERT(reference_count > 0);
+        return reference_count;
     }
 
     ALWAYS_INLINE void increment_reference_count()
     {
         // TODO: Ensure that addition would not overflow.
-        ++m_reference_count;
+        m_reference_count.fetch_add(1, MemoryOrder::Relaxed);
     }
 
     // Returns true when the instance is destroyed.
     ALWAYS_INLINE bool decrement_reference_count()
     {
-        SE_DEBUG_ASSERT(m_reference_count > 0);
+        // NOTE: The release-acquire ordering ensures that all accesses to the object made by other threads
+        //       happen before the object is destroyed.
+        const u32 previous_reference_count = m_reference_count.fetch_sub(1, MemoryOrder::AcquireRelease);
+        SE_DEBUG_ASSERT(previous_reference_count > 0);
 
-        if (--m_reference_count == 0)
+        if (previous_reference_count == 1)
         {
             delete this;
             return true;
@@ -54,7 +64,7 @@ private:
     }
 
 private:
-    u32 m_reference_count;
+    Atomic<u32> m_reference_count;
 };
 
 template<typename T>
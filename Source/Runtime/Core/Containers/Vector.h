@@ -356,28 +356,57 @@ public:
         if (m_count <= 1)
             return;
 
-        if (sort_order == SortOrder::Ascending)
+        // The element with the lower index is placed after the other only if the comparison requires it, so the sort is stable.
+        const ComparisonResult out_of_order_result = (sort_order == SortOrder::Ascending) ? ComparisonResult::Greater : ComparisonResult::Less;
+        auto is_out_of_order = [&](const T& lhs, const T& rhs) -> bool { return comparison_function(lhs, rhs) == out_of_order_result; };
+
+        //
+        // Short runs are sorted using insertion sort, which are then merged into runs of increasing length (bottom-up merge sort).
+        // NOTE: Only the left run of each merge is moved to the temporary storage, as the elements of the right run are
+        //       always moved to a position lower (or equal) than their current one.
+        //
+        constexpr usize insertion_sort_run_count = 16;
+        for (usize run_begin = 0; run_begin < m_count; run_begin += insertion_sort_run_count)
         {
-            for (usize element_index = 0; element_index < m_count; ++element_index)
+            const usize run_end = (run_begin + insertion_sort_run_count < m_count) ? (run_begin + insertion_sort_run_count) : m_count;
+            for (usize index = run_begin + 1; index < run_end; ++index)
             {
-                for (usize index = element_index; index < m_count - 1; ++index)
-                {
-                    if (comparison_function(m_elements[index], m_elements[index + 1]) == ComparisonResult::Greater)
-                        swap_elements(m_elements + index, m_elements + index + 1);
-                }
+                for (usize insert_index = index; insert_index > run_begin && is_out_of_order(m_elements[insert_index - 1], m_elements[insert_index]);
+                     --insert_index)
+                    swap_elements(m_elements + insert_index - 1, m_elements + insert_index);
             }
         }
-        else if (sort_order == SortOrder::Descending)
+
+        if (m_count <= insertion_sort_run_count)
+            return;
+
+        T* temporary_elements = allocate_memory(m_count);
+        for (usize run_count = insertion_sort_run_count; run_count < m_count; run_count *= 2)
         {
-            for (usize element_index = 0; element_index < m_count; ++element_index)
+            for (usize left_begin = 0; left_begin + run_count < m_count; left_begin += 2 * run_count)
             {
-                for (usize index = element_index; index < m_count - 1; ++index)
+                const usize right_begin = left_begin + run_count;
+                const usize right_end = (right_begin + run_count < m_count) ? (right_begin + run_count) : m_count;
+
+                // The runs are already in order, so there is nothing to merge.
+                if (!is_out_of_order(m_elements[right_begin - 1], m_elements[right_begin]))
+                    continue;
+
+                move_elements(temporary_elements, m_elements + left_begin, run_count);
+                usize left_index = 0;
+                usize right_index = right_begin;
+                usize destination_index = left_begin;
+                while (left_index < run_count)
                 {
-                    if (comparison_function(m_elements[index], m_elements[index + 1]) == ComparisonResult::Less)
-                        swap_elements(m_elements + index, m_elements + index + 1);
+                    T* source = (right_index < right_end && is_out_of_order(temporary_elements[left_index], m_elements[right_index]))
+                                    ? (m_elements + right_index++)
+                                    : (temporary_elements + left_index++);
+                    new (m_elements + destination_index++) T(move(*source));
+                    source->~T();
                 }
             }
         }
+        release_memory(temporary_elements, m_count);
     }
 
 public:
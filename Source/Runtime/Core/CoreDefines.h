@@ -102,6 +102,42 @@
     #error Unknown or unsupported compiler!
 #endif // Any supported compiler.
 
+//======================================================================================
+// ARCHITECTURE CONFIGURATION MACROS.
+//======================================================================================
+
+// The `_M_X64` is defined by MSVC, while `__x86_64__` is defined by clang and GCC.
+#if defined(_M_X64) || defined(__x86_64__)
+    #define SE_ARCHITECTURE_X64 1
+#endif // x64 architecture.
+
+#ifndef SE_ARCHITECTURE_X64
+    #define SE_ARCHITECTURE_X64 0
+#endif // SE_ARCHITECTURE_X64
+
+//
+// SSE2 is part of the x64 instruction set, so the SSE2 intrinsics can be used without checking the processor at runtime.
+// The code that uses them must always provide a scalar fallback for the other architectures.
+//
+#define SE_SIMD_SSE2 SE_ARCHITECTURE_X64
+
+//
+// Set when the program is instrumented with AddressSanitizer. MSVC and GCC define `__SANITIZE_ADDRESS__`, while clang
+// only reports it as a feature. The code that reads past the end of a buffer (in a way that can't fault) must use its
+// scalar fallback when it is set, as the sanitizer can't know that the bytes are never used.
+//
+#if defined(__SANITIZE_ADDRESS__)
+    #define SE_ADDRESS_SANITIZER 1
+#elif defined(__has_feature)
+    #if __has_feature(address_sanitizer)
+        #define SE_ADDRESS_SANITIZER 1
+    #endif // __has_feature(address_sanitizer)
+#endif // AddressSanitizer.
+
+#ifndef SE_ADDRESS_SANITIZER
+    #define SE_ADDRESS_SANITIZER 0
+#endif // SE_ADDRESS_SANITIZER
+
 //======================================================================================
 // UTILITY (GENERAL PURPOSE) MACROS.
 //======================================================================================
@@ -89,6 +89,8 @@ template<typename T> struct RemoveConst<const T>    { using Type = T; };
 template<typename T> struct RemovePointer           { using Type = T; };
 template<typename T> struct RemovePointer<T*>       { using Type = T; };
 
+template<typename T> struct TypeIdentity            { using Type = T; };
+
 template<typename T>    struct IsIntegral      { static constexpr bool value = false;  static constexpr bool is_signed = false; };
 template<>              struct IsIntegral<u8>  { static constexpr bool value = true;   static constexpr bool is_signed = false; };
 template<>              struct IsIntegral<u16> { static constexpr bool value = true;   static constexpr bool is_signed = false; };
@@ -138,6 +140,13 @@ constexpr bool is_base_of = std::is_base_of_v<BaseType, DerivedType>;
 template<typename T>
 using RemovePointer = typename Detail::RemovePointer<T>::Type;
 
+//
+// Evaluates to the given type, but excludes a function parameter from template argument deduction.
+// Follows the C++ standard `std::type_identity_t`.
+//
+template<typename T>
+using TypeIdentity = typename Detail::TypeIdentity<T>::Type;
+
 //
 // Used in move semantics. Follows the C++ standard signature, which can be found at:
 // https://en.cppreference.com/w/cpp/utility/move
@@ -177,11 +177,47 @@ public:
     //
     SHOOTER_API FileError write_and_close(ReadonlyByteSpan bytes_to_write);
 
+    //
+    // Writes the given buffers, one after another, to the end of the file. Used to write data that is stored in multiple
+    // separate buffers (such as a `ChunkedOutputBuffer`) without first copying it to a contiguous buffer.
+    // NOTE: The Windows gather function (`WriteFileGather`) only works with unbuffered, page-aligned I/O, so the buffers
+    //       are written by successive write operations on the same handle.
+    //
+    SHOOTER_API FileError write_gather(Span<const ReadonlyByteSpan> buffers_to_write);
+
 private:
     void* m_native_handle;
     bool m_handle_is_opened;
 };
 
+//
+// Maps the entire contents of a file in the virtual address space of the process, as read-only memory.
+// The pages are loaded by the operating system on demand, so opening a large file is cheap and no copy
+// of the file is ever made in the user space.
+//
+class MemoryMappedFile
+{
+    SE_MAKE_NONCOPYABLE(MemoryMappedFile);
+    SE_MAKE_NONMOVABLE(MemoryMappedFile);
+
+public:
+    SHOOTER_API MemoryMappedFile();
+    SHOOTER_API ~MemoryMappedFile();
+
+    SHOOTER_API FileError open(const String& filepath);
+    SHOOTER_API void close();
+    NODISCARD ALWAYS_INLINE bool is_opened() const { return (m_file_handle != nullptr); }
+
+    // The mapped contents of the file. Only valid until the file is closed.
+    NODISCARD ALWAYS_INLINE ReadonlyByteSpan bytes() const { return ReadonlyByteSpan(m_mapped_data, m_byte_count); }
+
+private:
+    void* m_file_handle;
+    void* m_mapping_handle;
+    ReadonlyBytes m_mapped_data;
+    usize m_byte_count;
+};
+
 class FileSystem
 {
 public:
@@ -194,6 +230,15 @@ public:
     // will return an empty optional.
     SHOOTER_API NODISCARD static Optional<usize> get_file_size(const String& filepath);
 
+    // Returns a value that changes every time the file is written. The value has no meaning on its own, so it should
+    // only be compared with a value previously returned for the same file. If the filepath is not valid, an empty optional is returned.
+    SHOOTER_API NODISCARD static Optional<u64> get_file_last_write_time(const String& filepath);
+
+    // Moves (or renames) a file, replacing the destination file if it already exists.
+    SHOOTER_API static bool move_file(const String& source_filepath, const String& destination_filepath);
+
+    SHOOTER_API static bool delete_file(const String& filepath);
+
 public:
     SHOOTER_API static void set_working_directory(const String& filepath);
     SHOOTER_API static String get_working_directory();
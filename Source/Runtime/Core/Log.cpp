@@ -3,50 +3,981 @@
  * SPDX-License-Identifier: Apache-2.0.
  */
 
+#include <Core/Containers/Vector.h>
+#include <Core/FileSystem/FileSystem.h>
 #include <Core/Log.h>
+#include <Core/LogSinks.h>
+#include <Core/Platform/Atomic.h>
 #include <Core/Platform/Platform.h>
+#include <Core/Platform/Thread.h>
 
 namespace SE
 {
 
-#define SE_CONSOLE_TEXT_COLOR_INDEX       (0)
-#define SE_CONSOLE_BACKGROUND_COLOR_INDEX (1)
+static StringView s_severity_text_table[5] = { "TRACE"sv, "INFO"sv, "WARN"sv, "ERROR"sv, "FATAL"sv };
+static StringView s_severity_padding_table[5] = { " "sv, "  "sv, "  "sv, " "sv, " "sv };
+static StringView s_severity_name_table[5] = { "Trace"sv, "Info"sv, "Warn"sv, "Error"sv, "Fatal"sv };
+
+// The number of records in the queue. Must be a power of two.
+static constexpr u64 s_log_record_queue_capacity = 4096;
+// The number of message characters that are stored in the record itself. Longer messages are moved to the heap.
+static constexpr usize s_log_record_inline_capacity = 200;
+// The number of times the logger thread polls the queue before it waits to be woken up.
+static constexpr u32 s_logger_thread_spin_count = 64;
+
+//
+// A message that was logged but not yet written to the sinks.
+// Each record is placed on its own cache lines, so the producers that write adjacent records don't contend.
+//
+struct alignas(64) LogRecord
+{
+    //
+    // Synchronizes the producers with the logger thread (the queue is the bounded queue described by Dmitry Vyukov).
+    // A record at queue position `p` can be written when its sequence is `p`, and can be read when its sequence is `p + 1`.
+    // After the record is read, its sequence becomes `p + capacity`, which is the next position that maps to the record.
+    //
+    Atomic<u64> sequence;
 
-// clang-format off
-static Platform::ConsoleColor s_console_color_table[5][2] = {
-    { Platform::ConsoleColor::DarkGray,    Platform::ConsoleColor::Black },
-    { Platform::ConsoleColor::Green,       Platform::ConsoleColor::Black },
-    { Platform::ConsoleColor::LightYellow, Platform::ConsoleColor::Black },
-    { Platform::ConsoleColor::LightRed,    Platform::ConsoleColor::Black },
-    { Platform::ConsoleColor::White,       Platform::ConsoleColor::Red   },
+    u64 tick_counter;
+    u64 thread_id;
+    // Only set if the message doesn't fit in the inline storage.
+    char* heap_message;
+    u32 message_byte_count;
+    Name tag;
+    Logger::Severity::Type severity;
+    char inline_message[s_log_record_inline_capacity];
 };
-// clang-format on
+static_assert(sizeof(LogRecord) == 256);
 
-static StringView s_severity_text_table[5] = { "TRACE"sv, "INFO"sv, "WARN"sv, "ERROR"sv, "FATAL"sv };
-static StringView s_severity_padding_table[5] = { " "sv, "  "sv, "  "sv, " "sv, " "sv };
+// The number of bytes in the buffer of binary messages of each thread. Must be a power of two.
+static constexpr usize s_binary_log_buffer_capacity = 64 * KiB;
+// The maximum number of bytes of the arguments of a binary message. Larger messages are dropped.
+static constexpr usize s_binary_log_max_argument_byte_count = 4 * KiB;
+// The maximum number of places from which binary messages can be logged.
+static constexpr u32 s_binary_log_max_format_count = 4096;
+
+//
+// Precedes the arguments of a binary message in the buffer of a thread.
+// The messages are aligned to the size of the header, so there is always room for a header before the end of the buffer.
+//
+struct BinaryLogEntryHeader
+{
+    // Zero marks the end of the used bytes, when the next message didn't fit before the end of the buffer.
+    u32 format_id;
+    u32 argument_byte_count;
+    u64 tick_counter;
+};
+static_assert(sizeof(BinaryLogEntryHeader) == 16);
+
+NODISCARD ALWAYS_INLINE static usize get_binary_log_entry_byte_count(usize argument_byte_count)
+{
+    return (sizeof(BinaryLogEntryHeader) + argument_byte_count + sizeof(BinaryLogEntryHeader) - 1) & ~(sizeof(BinaryLogEntryHeader) - 1);
+}
+
+//
+// Ring of bytes in which a thread writes its binary messages, which are read by the logger thread. The positions only
+// increase, and are mapped to the bytes of the buffer modulo its capacity.
+//
+struct BinaryLogBuffer
+{
+    // The end of the published messages. Written by the owning thread and read by the logger thread.
+    alignas(64) Atomic<u64> write_position;
+    // Only accessed by the owning thread. The end of the message that is currently written, and the last read position
+    // that was observed, so the shared read position is only loaded when the buffer seems to be full.
+    u64 pending_write_position { 0 };
+    u64 cached_read_position { 0 };
+
+    // The end of the messages that were written to the sinks. Written by the logger thread and read by the owning thread.
+    alignas(64) Atomic<u64> read_position;
+    u64 thread_id { 0 };
+
+    // The buffer is owned by both its thread and the logger, and it is deleted when both of them have released it.
+    Atomic<u32> reference_count { 2 };
+
+    alignas(64) u8 bytes[s_binary_log_buffer_capacity];
+};
+
+static void release_binary_log_buffer(BinaryLogBuffer* buffer)
+{
+    if (buffer->reference_count.fetch_sub(1, MemoryOrder::AcquireRelease) == 1)
+        delete buffer;
+}
+
+struct LoggerData
+{
+    LogRecord* records { nullptr };
+
+    alignas(64) Atomic<u64> enqueue_position;
+    Atomic<u64> dropped_message_count;
+    // Set by the logger thread while it waits for messages, so the producers know when it must be woken up.
+    Atomic<u32> is_logger_thread_waiting;
+    Atomic<u32> is_shutting_down;
+
+    // Only accessed by the logger thread.
+    alignas(64) u64 dequeue_position { 0 };
+    u64 reported_dropped_message_count { 0 };
+
+    //
+    // Protects the flush requests and is used together with the condition variables. A flush is complete once the logger
+    // thread has written all the records up to the requested position, and has drained the binary buffers after the flush
+    // was requested.
+    //
+    Mutex mutex;
+    ConditionVariable wake_condition;
+    ConditionVariable flush_condition;
+    u64 requested_flush_count { 0 };
+    u64 requested_flush_position { 0 };
+    u64 completed_flush_count { 0 };
+
+    Mutex sinks_mutex;
+    Vector<LogSink*> sinks;
+
+    // The buffers of binary messages of the threads that have logged binary messages.
+    Mutex binary_buffers_mutex;
+    Vector<BinaryLogBuffer*> binary_buffers;
+    // Distinguishes between the consecutive initializations of the logger, so the threads don't use buffers that were
+    // registered with a logger that has been shut down.
+    u32 generation { 0 };
+
+    Thread thread;
+    Atomic<u64> thread_id;
+
+    // The wall-clock time of the messages is calculated from their tick counter, relative to these values.
+    u64 start_tick_counter { 0 };
+    u64 tick_counter_frequency { 0 };
+    u64 start_millisecond_of_day { 0 };
+};
+
+static LoggerData* s_logger = nullptr;
+static u32 s_logger_generation = 0;
+
+//
+// The formats of the binary messages, indexed by their ID. The formats are never released, as their IDs are cached by the
+// places that log them. The array is only written while the mutex is locked, and a format is always registered before
+// any message that uses it is published, so the logger thread can read it without locking the mutex.
+//
+static Mutex s_binary_formats_mutex;
+static BinaryLogFormat* s_binary_formats[s_binary_log_max_format_count];
+static u32 s_binary_format_count = 0;
+
+struct BinaryLogThreadContext
+{
+    ~BinaryLogThreadContext()
+    {
+        if (buffer)
+            release_binary_log_buffer(buffer);
+    }
+
+    BinaryLogBuffer* buffer { nullptr };
+    u32 logger_generation { 0 };
+
+    // The message that is currently written. If the logger is not initialized the arguments are written to the
+    // fallback storage instead of the buffer, and the message is written to the console when it is ended.
+    bool is_writing_to_buffer { false };
+    u32 format_id { 0 };
+    usize argument_byte_count { 0 };
+    alignas(16) u8 fallback_argument_bytes[s_binary_log_max_argument_byte_count];
+};
+
+static thread_local BinaryLogThreadContext t_binary_log_context;
+
+// Used when the logger is not initialized. The mutex serializes the messages that are written to it.
+static ConsoleLogSink s_fallback_console_sink;
+static Mutex s_fallback_console_mutex;
+
+struct LogTagOverride
+{
+    Name tag;
+    Logger::Severity::Type minimum_severity;
+};
+
+//
+// The runtime filters of the tags. The filters are never released, as the places that log messages keep references to
+// them. The mutex is only locked when a filter is created or changed, never when a message is logged.
+//
+static Mutex s_log_tags_mutex;
+static Vector<LogTag*> s_log_tags;
+static Vector<LogTagOverride> s_log_tag_overrides;
+static Logger::Severity::Type s_default_minimum_severity = Logger::Severity::Trace;
+
+void Logger::format_line(FormatBuilder& builder, u64 millisecond_of_day, Severity::Type severity, Name tag, StringView message)
+{
+    const u64 hour = millisecond_of_day / (60 * 60 * 1000);
+    const u64 minute = (millisecond_of_day / (60 * 1000)) % 60;
+    const u64 second = (millisecond_of_day / 1000) % 60;
+    const u64 millisecond = millisecond_of_day % 1000;
+
+    if (tag.is_empty())
+    {
+        format_to(
+            builder, "[{:02}:{:02}:{:02}.{:03}][{}]:{}{}\n"sv, hour, minute, second, millisecond, s_severity_text_table[severity],
+            s_severity_padding_table[severity], message
+        );
+    }
+    else
+    {
+        format_to(
+            builder, "[{:02}:{:02}:{:02}.{:03}][{}][{}]:{}{}\n"sv, hour, minute, second, millisecond, s_severity_text_table[severity], tag,
+            s_severity_padding_table[severity], message
+        );
+    }
+}
+
+static u64 get_millisecond_of_day(const Platform::SystemTime& system_time)
+{
+    return ((static_cast<u64>(system_time.hour) * 60 + system_time.minute) * 60 + system_time.second) * 1000 + system_time.millisecond;
+}
+
+static u64 get_millisecond_of_day(const LoggerData& logger, u64 tick_counter)
+{
+    // NOTE: The tick counter is converted to milliseconds in two steps, so the multiplication doesn't overflow.
+    const u64 elapsed_ticks = tick_counter - logger.start_tick_counter;
+    const u64 elapsed_milliseconds =
+        (elapsed_ticks / logger.tick_counter_frequency) * 1000 + ((elapsed_ticks % logger.tick_counter_frequency) * 1000) / logger.tick_counter_frequency;
+    return (logger.start_millisecond_of_day + elapsed_milliseconds) % (24 * 60 * 60 * 1000);
+}
+
+//
+// Writes the message directly to the console, on the calling thread. Used when the logger is not initialized.
+//
+static void write_message_synchronously(Logger::Severity::Type severity, Name tag, StringView message)
+{
+    FormatMemoryBuilder<512> line;
+    Logger::format_line(line, get_millisecond_of_day(Platform::get_local_system_time()), severity, tag, message);
+
+    LogMessage log_message = {};
+    log_message.severity = severity;
+    log_message.tag = tag;
+    log_message.message = message;
+    log_message.line = line.view();
+    log_message.tick_counter = Platform::get_current_tick_counter();
+    log_message.thread_id = Thread::get_current_thread_id();
+
+    ScopedLock console_lock(s_fallback_console_mutex);
+    s_fallback_console_sink.write(log_message);
+}
+
+static void wake_logger_thread(LoggerData& logger)
+{
+    ScopedLock lock(logger.mutex);
+    logger.wake_condition.notify_one();
+}
+
+//
+// Pushes the message to the queue. Returns false if the queue is full.
+// NOTE: This is the only code that is executed by the producers, so it must be as cheap as possible.
+//
+static bool enqueue_log_record(LoggerData& logger, Logger::Severity::Type severity, Name tag, StringView message)
+{
+    u64 position = logger.enqueue_position.load(MemoryOrder::Relaxed);
+    LogRecord* record;
+    while (true)
+    {
+        record = &logger.records[position & (s_log_record_queue_capacity - 1)];
+        const u64 sequence = record->sequence.load(MemoryOrder::Acquire);
+        const i64 sequence_difference = static_cast<i64>(sequence - position);
+
+        if (sequence_difference == 0)
+        {
+            // The record is free, so try to claim it. If another producer claimed it first, the position is updated.
+            if (logger.enqueue_position.compare_exchange(position, position + 1, MemoryOrder::Relaxed))
+                break;
+        }
+        else if (sequence_difference < 0)
+        {
+            // The record still contains a message from the previous lap, so the queue is full.
+            return false;
+        }
+        else
+        {
+            position = logger.enqueue_position.load(MemoryOrder::Relaxed);
+        }
+    }
+
+    record->tick_counter = Platform::get_current_tick_counter();
+    record->thread_id = Thread::get_current_thread_id();
+    record->tag = tag;
+    record->severity = severity;
+    record->message_byte_count = static_cast<u32>(message.byte_count());
+    record->heap_message = nullptr;
+
+    char* message_characters = record->inline_message;
+    if (message.byte_count() > s_log_record_inline_capacity)
+    {
+        record->heap_message = new char[message.byte_count()];
+        message_characters = record->heap_message;
+    }
+    copy_memory(message_characters, message.characters(), message.byte_count());
+
+    //
+    // NOTE: The publication of the record and the check of the waiting flag are sequentially consistent, as are the
+    //       store of the flag and the check of the queue done by the logger thread. This guarantees that either the
+    //       logger thread sees the record before waiting, or the producer sees that it is waiting and wakes it up.
+    //
+    record->sequence.store(position + 1, MemoryOrder::SequentiallyConsistent);
+    if (logger.is_logger_thread_waiting.load(MemoryOrder::SequentiallyConsistent))
+        wake_logger_thread(logger);
+
+    return true;
+}
+
+NODISCARD static bool is_log_record_available(const LoggerData& logger)
+{
+    const LogRecord& record = logger.records[logger.dequeue_position & (s_log_record_queue_capacity - 1)];
+    return (record.sequence.load(MemoryOrder::SequentiallyConsistent) == logger.dequeue_position + 1);
+}
+
+NODISCARD static bool is_any_message_available(LoggerData& logger)
+{
+    if (is_log_record_available(logger))
+        return true;
+
+    ScopedLock binary_buffers_lock(logger.binary_buffers_mutex);
+    for (const BinaryLogBuffer* buffer : logger.binary_buffers)
+    {
+        if (buffer->write_position.load(MemoryOrder::SequentiallyConsistent) != buffer->read_position.load(MemoryOrder::Relaxed))
+            return true;
+    }
+    return false;
+}
+
+static void write_message_to_sinks(LoggerData& logger, const LogMessage& message)
+{
+    for (LogSink* sink : logger.sinks)
+        sink->write(message);
+}
+
+//
+// Writes the published binary messages of a thread to the sinks. Returns true if any message was written.
+//
+static bool write_binary_log_messages(LoggerData& logger, BinaryLogBuffer& buffer, FormatMemoryBuilder<512>& line, FormatMemoryBuilder<512>& message)
+{
+    u64 read_position = buffer.read_position.load(MemoryOrder::Relaxed);
+    const u64 write_position = buffer.write_position.load(MemoryOrder::Acquire);
+    if (read_position == write_position)
+        return false;
+
+    while (read_position < write_position)
+    {
+        const usize offset = read_position & (s_binary_log_buffer_capacity - 1);
+        const BinaryLogEntryHeader& header = *reinterpret_cast<const BinaryLogEntryHeader*>(buffer.bytes + offset);
+        if (header.format_id == 0)
+        {
+            // The rest of the buffer is unused, so the next message is at its beginning.
+            read_position += s_binary_log_buffer_capacity - offset;
+            continue;
+        }
+
+        const BinaryLogFormat& format = *s_binary_formats[header.format_id];
+        const ReadonlyByteSpan argument_bytes = ReadonlyByteSpan(reinterpret_cast<ReadonlyBytes>(&header + 1), header.argument_byte_count);
+
+        message.clear();
+        if (!format_binary_log_message(message, format.format, format.argument_types, argument_bytes))
+        {
+            message.clear();
+            format_to(message, "Failed to format the binary message '{}'!"sv, format.format);
+        }
+
+        line.clear();
+        Logger::format_line(line, get_millisecond_of_day(logger, header.tick_counter), format.severity, Name(), message.view());
+
+        LogMessage log_message = {};
+        log_message.severity = format.severity;
+        log_message.message = message.view();
+        log_message.line = line.view();
+        log_message.tick_counter = header.tick_counter;
+        log_message.thread_id = buffer.thread_id;
+        log_message.binary_format = &format;
+        log_message.binary_argument_bytes = argument_bytes;
+        write_message_to_sinks(logger, log_message);
+
+        read_position += get_binary_log_entry_byte_count(header.argument_byte_count);
+    }
+
+    // Release the bytes of the messages, so they can be reused by the thread.
+    buffer.read_position.store(read_position, MemoryOrder::Release);
+    return true;
+}
+
+//
+// Writes all the available records and binary messages to the sinks. Returns true if any message was written.
+// NOTE: The text messages are written before the binary messages, so the order of the messages logged by a thread is
+//       only preserved between messages of the same kind. Their time is always accurate.
+//
+static bool write_log_records(LoggerData& logger, FormatMemoryBuilder<512>& line, FormatMemoryBuilder<512>& message)
+{
+    ScopedLock sinks_lock(logger.sinks_mutex);
+    bool has_written_records = false;
+
+    const u64 dropped_message_count = logger.dropped_message_count.load(MemoryOrder::Relaxed);
+    if (dropped_message_count > logger.reported_dropped_message_count)
+    {
+        message.clear();
+        format_to(message, "{} messages were dropped because the log buffers were full!"sv, dropped_message_count - logger.reported_dropped_message_count);
+        logger.reported_dropped_message_count = dropped_message_count;
+
+        const Platform::SystemTime system_time = Platform::get_local_system_time();
+        line.clear();
+        Logger::format_line(line, get_millisecond_of_day(system_time), Logger::Severity::Warn, Name(), message.view());
+
+        LogMessage log_message = {};
+        log_message.severity = Logger::Severity::Warn;
+        log_message.message = message.view();
+        log_message.line = line.view();
+        log_message.tick_counter = Platform::get_current_tick_counter();
+        log_message.thread_id = Thread::get_current_thread_id();
+        write_message_to_sinks(logger, log_message);
+        has_written_records = true;
+    }
+
+    while (is_log_record_available(logger))
+    {
+        LogRecord& record = logger.records[logger.dequeue_position & (s_log_record_queue_capacity - 1)];
+        const char* message_characters = record.heap_message ? record.heap_message : record.inline_message;
+        const StringView message = StringView::unsafe_create_from_utf8(message_characters, record.message_byte_count);
+
+        line.clear();
+        Logger::format_line(line, get_millisecond_of_day(logger, record.tick_counter), record.severity, record.tag, message);
+
+        LogMessage log_message = {};
+        log_message.severity = record.severity;
+        log_message.tag = record.tag;
+        log_message.message = message;
+        log_message.line = line.view();
+        log_message.tick_counter = record.tick_counter;
+        log_message.thread_id = record.thread_id;
+        write_message_to_sinks(logger, log_message);
+
+        delete[] record.heap_message;
+        record.heap_message = nullptr;
+
+        // Release the record, so it can be claimed by the producers again.
+        record.sequence.store(logger.dequeue_position + s_log_record_queue_capacity, MemoryOrder::Release);
+        ++logger.dequeue_position;
+        has_written_records = true;
+    }
+
+    {
+        ScopedLock binary_buffers_lock(logger.binary_buffers_mutex);
+        for (usize buffer_index = 0; buffer_index < logger.binary_buffers.count();)
+        {
+            BinaryLogBuffer* buffer = logger.binary_buffers[buffer_index];
+            // NOTE: The thread releases the buffer after it has published its last message, so if the buffer was released
+            //       before its messages are written, all of them are written.
+            const bool is_released_by_thread = (buffer->reference_count.load(MemoryOrder::Acquire) == 1);
+            if (write_binary_log_messages(logger, *buffer, line, message))
+                has_written_records = true;
+
+            if (is_released_by_thread)
+            {
+                logger.binary_buffers.remove_unordered(buffer_index);
+                release_binary_log_buffer(buffer);
+                continue;
+            }
+            ++buffer_index;
+        }
+    }
+
+    if (has_written_records)
+    {
+        for (LogSink* sink : logger.sinks)
+            sink->flush();
+    }
+
+    return has_written_records;
+}
+
+static void logger_thread_entry_point(void*)
+{
+    LoggerData& logger = *s_logger;
+    logger.thread_id.store(Thread::get_current_thread_id());
+    FormatMemoryBuilder<512> line;
+    FormatMemoryBuilder<512> message;
+
+    while (true)
+    {
+        // The flush requests are observed before the messages are written, so all the binary messages that were
+        // published before the flush was requested are written before the flush is completed.
+        logger.mutex.lock();
+        const u64 observed_flush_count = logger.requested_flush_count;
+        const u64 observed_flush_position = logger.requested_flush_position;
+        logger.mutex.unlock();
+
+        const bool has_written_records = write_log_records(logger, line, message);
+        if (!has_written_records && observed_flush_count == logger.completed_flush_count)
+        {
+            // Poll for a short time before waiting, as waking up the logger thread is expensive for the producers.
+            for (u32 spin_index = 0; spin_index < s_logger_thread_spin_count && !is_any_message_available(logger); ++spin_index)
+                Thread::sleep_for_milliseconds(0);
+        }
+
+        logger.mutex.lock();
+        if (observed_flush_count > logger.completed_flush_count)
+        {
+            // NOTE: A record that was claimed before the flush was requested might not be published yet, in which
+            //       case the logger thread can't wait for a wake-up.
+            const bool is_flush_complete = (logger.dequeue_position >= observed_flush_position);
+            if (is_flush_complete)
+            {
+                logger.completed_flush_count = observed_flush_count;
+                logger.flush_condition.notify_all();
+            }
+            logger.mutex.unlock();
+
+            if (!is_flush_complete)
+                Thread::sleep_for_milliseconds(0);
+            continue;
+        }
+
+        if (has_written_records || logger.requested_flush_count > logger.completed_flush_count)
+        {
+            logger.mutex.unlock();
+            continue;
+        }
+
+        if (logger.is_shutting_down.load())
+        {
+            logger.mutex.unlock();
+            break;
+        }
+
+        logger.is_logger_thread_waiting.store(1, MemoryOrder::SequentiallyConsistent);
+        if (!is_any_message_available(logger) && !logger.is_shutting_down.load() && logger.requested_flush_count == logger.completed_flush_count)
+            logger.wake_condition.wait(logger.mutex);
+        logger.is_logger_thread_waiting.store(0, MemoryOrder::SequentiallyConsistent);
+        logger.mutex.unlock();
+    }
+
+    //
+    // NOTE: The messages published after the last write (and the messages dropped since then) would otherwise be lost.
+    //       No other thread logs while the logger is shut down, so a single write drains everything that is left.
+    //
+    write_log_records(logger, line, message);
+}
+
+bool Logger::initialize()
+{
+    if (s_logger)
+        return false;
+
+    s_logger = new LoggerData();
+    s_logger->records = new LogRecord[s_log_record_queue_capacity];
+    for (u64 position = 0; position < s_log_record_queue_capacity; ++position)
+        s_logger->records[position].sequence.store(position, MemoryOrder::Relaxed);
+
+    s_logger->start_tick_counter = Platform::get_current_tick_counter();
+    s_logger->tick_counter_frequency = Platform::get_tick_counter_frequency();
+    s_logger->start_millisecond_of_day = get_millisecond_of_day(Platform::get_local_system_time());
+    s_logger->generation = ++s_logger_generation;
+
+    if (!s_logger->thread.start(logger_thread_entry_point, nullptr, "Logger"sv))
+    {
+        delete[] s_logger->records;
+        delete s_logger;
+        s_logger = nullptr;
+        return false;
+    }
+
+    return true;
+}
+
+void Logger::shutdown()
+{
+    if (!s_logger)
+        return;
+
+    // The logger thread writes all the remaining messages before it exits.
+    s_logger->is_shutting_down.store(1);
+    wake_logger_thread(*s_logger);
+    s_logger->thread.join();
+
+    // The buffers that are still used by their threads are deleted when the threads exit or log the next binary message.
+    for (BinaryLogBuffer* buffer : s_logger->binary_buffers)
+        release_binary_log_buffer(buffer);
+
+    delete[] s_logger->records;
+    delete s_logger;
+    s_logger = nullptr;
+}
+
+void Logger::add_sink(LogSink* sink)
+{
+    SE_ASSERT(s_logger && sink);
+    ScopedLock sinks_lock(s_logger->sinks_mutex);
+    s_logger->sinks.add(sink);
+}
+
+void Logger::remove_sink(LogSink* sink)
+{
+    if (!s_logger)
+        return;
+
+    ScopedLock sinks_lock(s_logger->sinks_mutex);
+    for (usize sink_index = 0; sink_index < s_logger->sinks.count(); ++sink_index)
+    {
+        if (s_logger->sinks[sink_index] == sink)
+        {
+            s_logger->sinks.remove(sink_index);
+            return;
+        }
+    }
+}
+
+void Logger::flush()
+{
+    if (!s_logger)
+        return;
+
+    // NOTE: The sinks are flushed by the logger thread, so flushing from a sink would never complete.
+    if (Thread::get_current_thread_id() == s_logger->thread_id.load(MemoryOrder::Relaxed))
+        return;
+
+    const u64 flush_position = s_logger->enqueue_position.load();
+    ScopedLock lock(s_logger->mutex);
+    if (flush_position > s_logger->requested_flush_position)
+        s_logger->requested_flush_position = flush_position;
+    const u64 flush_count = ++s_logger->requested_flush_count;
+
+    s_logger->wake_condition.notify_one();
+    while (s_logger->completed_flush_count < flush_count)
+        s_logger->flush_condition.wait(s_logger->mutex);
+}
+
+u64 Logger::get_dropped_message_count()
+{
+    return s_logger ? s_logger->dropped_message_count.load(MemoryOrder::Relaxed) : 0;
+}
+
+NODISCARD static LogTag* find_log_tag(Name tag)
+{
+    for (LogTag* log_tag : s_log_tags)
+    {
+        if (log_tag->name == tag)
+            return log_tag;
+    }
+    return nullptr;
+}
+
+NODISCARD static LogTagOverride* find_log_tag_override(Name tag)
+{
+    for (LogTagOverride& tag_override : s_log_tag_overrides)
+    {
+        if (tag_override.tag == tag)
+            return &tag_override;
+    }
+    return nullptr;
+}
+
+LogTag& Logger::get_tag(Name tag)
+{
+    ScopedLock log_tags_lock(s_log_tags_mutex);
+    if (LogTag* log_tag = find_log_tag(tag))
+        return *log_tag;
+
+    const LogTagOverride* tag_override = find_log_tag_override(tag);
+    LogTag* log_tag = new LogTag(tag, tag_override ? tag_override->minimum_severity : s_default_minimum_severity);
+    s_log_tags.add(log_tag);
+    return *log_tag;
+}
+
+void Logger::set_default_minimum_severity(Severity::Type minimum_severity)
+{
+    ScopedLock log_tags_lock(s_log_tags_mutex);
+    s_default_minimum_severity = minimum_severity;
+    for (LogTag* log_tag : s_log_tags)
+    {
+        if (!find_log_tag_override(log_tag->name))
+            log_tag->minimum_severity.store(minimum_severity, MemoryOrder::Relaxed);
+    }
+}
+
+void Logger::set_tag_minimum_severity(Name tag, Severity::Type minimum_severity)
+{
+    ScopedLock log_tags_lock(s_log_tags_mutex);
+    if (LogTagOverride* tag_override = find_log_tag_override(tag))
+        tag_override->minimum_severity = minimum_severity;
+    else
+        s_log_tag_overrides.add({ tag, minimum_severity });
+
+    if (LogTag* log_tag = find_log_tag(tag))
+        log_tag->minimum_severity.store(minimum_severity, MemoryOrder::Relaxed);
+}
+
+void Logger::reset_tag_minimum_severity(Name tag)
+{
+    ScopedLock log_tags_lock(s_log_tags_mutex);
+    for (usize override_index = 0; override_index < s_log_tag_overrides.count(); ++override_index)
+    {
+        if (s_log_tag_overrides[override_index].tag == tag)
+        {
+            s_log_tag_overrides.remove_unordered(override_index);
+            break;
+        }
+    }
+
+    if (LogTag* log_tag = find_log_tag(tag))
+        log_tag->minimum_severity.store(s_default_minimum_severity, MemoryOrder::Relaxed);
+}
+
+bool Logger::parse_severity(StringView string, Severity::Type& out_severity)
+{
+    for (u8 severity = 0; severity < Severity::EnumCount; ++severity)
+    {
+        if (string == s_severity_name_table[severity] || string == s_severity_text_table[severity])
+        {
+            out_severity = static_cast<Severity::Type>(severity);
+            return true;
+        }
+    }
+    return false;
+}
+
+NODISCARD static bool is_filter_whitespace(char character)
+{
+    return (character == ' ' || character == '\t' || character == '\r');
+}
+
+NODISCARD static StringView trim_filter_whitespace(StringView string)
+{
+    usize begin_offset = 0;
+    usize end_offset = string.byte_count();
+    while (begin_offset < end_offset && is_filter_whitespace(string.characters()[begin_offset]))
+        ++begin_offset;
+    while (end_offset > begin_offset && is_filter_whitespace(string.characters()[end_offset - 1]))
+        --end_offset;
+    return string.slice(begin_offset, end_offset - begin_offset);
+}
+
+static bool apply_filter(StringView filter)
+{
+    const usize separator_offset = filter.find('=');
+    if (separator_offset == StringView::invalid_position)
+    {
+        Logger::Severity::Type minimum_severity;
+        if (!Logger::parse_severity(filter, minimum_severity))
+            return false;
+        Logger::set_default_minimum_severity(minimum_severity);
+        return true;
+    }
+
+    const StringView tag = trim_filter_whitespace(filter.slice(0, separator_offset));
+    Logger::Severity::Type minimum_severity;
+    if (tag.is_empty() || !Logger::parse_severity(trim_filter_whitespace(filter.slice(separator_offset + 1)), minimum_severity))
+        return false;
+    Logger::set_tag_minimum_severity(Name(tag), minimum_severity);
+    return true;
+}
+
+bool Logger::apply_filters(StringView filters)
+{
+    const char* characters = filters.characters();
+    const usize byte_count = filters.byte_count();
+    bool are_all_filters_valid = true;
+
+    usize filter_offset = 0;
+    while (filter_offset < byte_count)
+    {
+        usize filter_end_offset = filter_offset;
+        while (filter_end_offset < byte_count && characters[filter_end_offset] != ',' && characters[filter_end_offset] != '\n' &&
+               characters[filter_end_offset] != '#')
+        {
+            ++filter_end_offset;
+        }
+
+        const StringView filter = trim_filter_whitespace(filters.slice(filter_offset, filter_end_offset - filter_offset));
+        if (!filter.is_empty() && !apply_filter(filter))
+        {
+            SE_LOG_WARN("Invalid log filter '{}'!", filter);
+            are_all_filters_valid = false;
+        }
+
+        // The comments continue until the end of the line.
+        if (filter_end_offset < byte_count && characters[filter_end_offset] == '#')
+        {
+            while (filter_end_offset < byte_count && characters[filter_end_offset] != '\n')
+                ++filter_end_offset;
+        }
+        filter_offset = filter_end_offset + 1;
+    }
+
+    return are_all_filters_valid;
+}
+
+bool Logger::apply_filters_from_file(const String& filepath)
+{
+    FileReader file_reader;
+    String filters;
+    if (file_reader.open(filepath, FileReader::OpenPolicy::NonExistingFileIsEmpty) != FileError::Success ||
+        file_reader.read_entire_to_string_and_close(filters) != FileError::Success)
+    {
+        SE_LOG_WARN("Failed to read the log filters file '{}'!", filepath);
+        return false;
+    }
+
+    return apply_filters(filters.view());
+}
 
 void Logger::log_message(Severity::Type severity, StringView message)
 {
-    Optional<String> formatted_message =
-        format("[14:28:35][{}]:{}{}\n"sv, s_severity_text_table[(u8)(severity)], s_severity_padding_table[(u8)(severity)], message);
-    if (!formatted_message.has_value())
+    log_tagged_message(severity, Name(), message);
+}
+
+void Logger::log_tagged_message(Severity::Type severity, Name tag, StringView message)
+{
+    if (!s_logger)
+    {
+        write_message_synchronously(severity, tag, message);
+        return;
+    }
+
+    if (severity == Severity::Fatal)
+    {
+        //
+        // NOTE: Fatal messages are not dropped, as they are most likely the last messages before the process exits.
+        //       The logger thread itself can't wait for room in the queue, because it is the one that makes room.
+        //
+        const bool is_logger_thread = (Thread::get_current_thread_id() == s_logger->thread_id.load(MemoryOrder::Relaxed));
+        while (!enqueue_log_record(*s_logger, severity, tag, message))
+        {
+            if (is_logger_thread)
+            {
+                s_logger->dropped_message_count.fetch_add(1, MemoryOrder::Relaxed);
+                return;
+            }
+            Thread::sleep_for_milliseconds(0);
+        }
+        flush();
         return;
+    }
+
+    if (!enqueue_log_record(*s_logger, severity, tag, message))
+        s_logger->dropped_message_count.fetch_add(1, MemoryOrder::Relaxed);
+}
+
+u32 Logger::register_binary_format(Severity::Type severity, StringView format, Span<const BinaryLogArgumentType> argument_types)
+{
+    ScopedLock binary_formats_lock(s_binary_formats_mutex);
+    if (s_binary_format_count + 1 >= s_binary_log_max_format_count)
+    {
+        // The messages logged with this format are dropped, as zero is not a valid format ID.
+        return 0;
+    }
+
+    // NOTE: The format IDs start at one, as zero marks the unused bytes at the end of a binary buffer.
+    const u32 format_id = ++s_binary_format_count;
+    BinaryLogFormat* binary_format = new BinaryLogFormat();
+    binary_format->id = format_id;
+    binary_format->severity = severity;
+    binary_format->format = format;
+    binary_format->argument_types = argument_types;
+    s_binary_formats[format_id] = binary_format;
+    return format_id;
+}
+
+//
+// Returns the buffer of binary messages of the calling thread, which is created (and registered with the logger) the
+// first time the thread logs a binary message.
+//
+static BinaryLogBuffer* get_thread_binary_log_buffer(LoggerData& logger, BinaryLogThreadContext& context)
+{
+    if (context.buffer && context.logger_generation == logger.generation)
+        return context.buffer;
+
+    // The buffer was registered with a logger that has been shut down, which already released it.
+    if (context.buffer)
+        release_binary_log_buffer(context.buffer);
+
+    BinaryLogBuffer* buffer = new BinaryLogBuffer();
+    buffer->thread_id = Thread::get_current_thread_id();
+    {
+        ScopedLock binary_buffers_lock(logger.binary_buffers_mutex);
+        logger.binary_buffers.add(buffer);
+    }
+
+    context.buffer = buffer;
+    context.logger_generation = logger.generation;
+    return buffer;
+}
+
+u8* Logger::begin_binary_message(u32 format_id, usize argument_byte_count)
+{
+    BinaryLogThreadContext& context = t_binary_log_context;
+    LoggerData* logger = s_logger;
+
+    if (format_id == 0 || argument_byte_count > s_binary_log_max_argument_byte_count)
+    {
+        if (logger)
+            logger->dropped_message_count.fetch_add(1, MemoryOrder::Relaxed);
+        return nullptr;
+    }
+
+    context.format_id = format_id;
+    context.argument_byte_count = argument_byte_count;
+    if (!logger)
+    {
+        context.is_writing_to_buffer = false;
+        return context.fallback_argument_bytes;
+    }
+
+    BinaryLogBuffer& buffer = *get_thread_binary_log_buffer(*logger, context);
+    const usize entry_byte_count = get_binary_log_entry_byte_count(argument_byte_count);
+
+    // If the message doesn't fit before the end of the buffer, the remaining bytes are skipped.
+    u64 position = buffer.pending_write_position;
+    const usize offset = position & (s_binary_log_buffer_capacity - 1);
+    const usize skipped_byte_count = (s_binary_log_buffer_capacity - offset < entry_byte_count) ? (s_binary_log_buffer_capacity - offset) : 0;
 
-    Platform::ConsoleColor text_color = s_console_color_table[severity][SE_CONSOLE_TEXT_COLOR_INDEX];
-    Platform::ConsoleColor background_color = s_console_color_table[severity][SE_CONSOLE_BACKGROUND_COLOR_INDEX];
-    Platform::write_to_console(formatted_message.value().view(), text_color, background_color);
+    if (position + skipped_byte_count + entry_byte_count - buffer.cached_read_position > s_binary_log_buffer_capacity)
+    {
+        buffer.cached_read_position = buffer.read_position.load(MemoryOrder::Acquire);
+        if (position + skipped_byte_count + entry_byte_count - buffer.cached_read_position > s_binary_log_buffer_capacity)
+        {
+            logger->dropped_message_count.fetch_add(1, MemoryOrder::Relaxed);
+            return nullptr;
+        }
+    }
+
+    if (skipped_byte_count > 0)
+    {
+        reinterpret_cast<BinaryLogEntryHeader*>(buffer.bytes + offset)->format_id = 0;
+        position += skipped_byte_count;
+    }
+
+    BinaryLogEntryHeader* header = reinterpret_cast<BinaryLogEntryHeader*>(buffer.bytes + (position & (s_binary_log_buffer_capacity - 1)));
+    header->format_id = format_id;
+    header->argument_byte_count = static_cast<u32>(argument_byte_count);
+    header->tick_counter = Platform::get_current_tick_counter();
+
+    buffer.pending_write_position = position + entry_byte_count;
+    context.is_writing_to_buffer = true;
+    return reinterpret_cast<u8*>(header + 1);
 }
 
-void Logger::log_tagged_message(Severity::Type severity, StringView tag, StringView message)
+void Logger::end_binary_message()
 {
-    Optional<String> formatted_message =
-        format("[14:28:35][{}][{}]:{}{}\n"sv, s_severity_text_table[severity], tag, s_severity_padding_table[severity], message);
-    if (!formatted_message.has_value())
+    BinaryLogThreadContext& context = t_binary_log_context;
+    if (!context.is_writing_to_buffer)
+    {
+        // The logger is not initialized, so the message is formatted immediately.
+        const BinaryLogFormat& format = *s_binary_formats[context.format_id];
+        const ReadonlyByteSpan argument_bytes = ReadonlyByteSpan(context.fallback_argument_bytes, context.argument_byte_count);
+
+        FormatMemoryBuilder<512> message;
+        if (format_binary_log_message(message, format.format, format.argument_types, argument_bytes))
+            write_message_synchronously(format.severity, Name(), message.view());
         return;
+    }
 
-    Platform::ConsoleColor text_color = s_console_color_table[severity][SE_CONSOLE_TEXT_COLOR_INDEX];
-    Platform::ConsoleColor background_color = s_console_color_table[severity][SE_CONSOLE_BACKGROUND_COLOR_INDEX];
-    Platform::write_to_console(formatted_message.value().view(), text_color, background_color);
+    // NOTE: The same ordering as for the records of the text messages is required, so the logger thread is always woken up.
+    BinaryLogBuffer& buffer = *context.buffer;
+    buffer.write_position.store(buffer.pending_write_position, MemoryOrder::SequentiallyConsistent);
+    if (s_logger->is_logger_thread_waiting.load(MemoryOrder::SequentiallyConsistent))
+        wake_logger_thread(*s_logger);
+}
+
+void on_assertion_failed()
+{
+    Logger::flush();
 }
 
 } // namespace SE
@@ -6,13 +6,42 @@
 #pragma once
 
 #include <Core/API.h>
+#include <Core/BinaryLog.h>
 #include <Core/CoreTypes.h>
+#include <Core/Platform/Atomic.h>
 #include <Core/String/Format.h>
+#include <Core/String/Name.h>
 #include <Core/String/StringView.h>
 
+//
+// The messages with a lower severity are removed from the build, together with the evaluation of their arguments.
+// The value is the name of a severity, and it can be overridden by the build scripts (for example, `SE_LOG_MINIMUM_SEVERITY=Warn`).
+//
+#ifndef SE_LOG_MINIMUM_SEVERITY
+    #if SE_CONFIGURATION_SHIPPING
+        #define SE_LOG_MINIMUM_SEVERITY Info
+    #else
+        #define SE_LOG_MINIMUM_SEVERITY Trace
+    #endif // SE_CONFIGURATION_SHIPPING
+#endif // SE_LOG_MINIMUM_SEVERITY
+
 namespace SE
 {
 
+// Forward declarations.
+class LogSink;
+class String;
+struct BinaryLogFormat;
+struct LogTag;
+
+//
+// Asynchronous logger. The messages are formatted on the calling thread and pushed to a lock-free queue of fixed-size
+// records, from which a background thread writes them to the registered sinks. Logging never blocks the calling thread,
+// unless the message is fatal: when the queue is full the message is dropped (and counted), and messages that don't fit
+// in a record are moved to the heap.
+//
+// Before the logger is initialized (and after it is shut down) the messages are written directly to the console.
+//
 class Logger
 {
 public:
@@ -30,39 +59,234 @@ public:
         };
     };
 
+public:
+    //
+    // Starts the logger thread. The logger must be initialized and shut down on the main thread, while no other thread
+    // is logging messages.
+    //
+    SHOOTER_API static bool initialize();
+    SHOOTER_API static void shutdown();
+
+    //
+    // The sinks are not owned by the logger, and they must be removed before they are destroyed. They are only invoked
+    // by the logger thread, so they don't have to be thread-safe with respect to each other.
+    //
+    SHOOTER_API static void add_sink(LogSink* sink);
+    SHOOTER_API static void remove_sink(LogSink* sink);
+
+    //
+    // Blocks the calling thread until all the messages logged before the call are written to the sinks, and the sinks
+    // are flushed. Invoked automatically after a fatal message is logged and when an assertion fails.
+    //
+    SHOOTER_API static void flush();
+
+    // The number of messages that were dropped because the queue was full.
+    NODISCARD SHOOTER_API static u64 get_dropped_message_count();
+
+public:
+    //
+    // Returns the runtime filter of the given tag (the empty name being the tag of the untagged messages), which is
+    // created the first time it is requested and is never destroyed. The logging macros request the filter only once
+    // for each place where a message is logged.
+    //
+    NODISCARD SHOOTER_API static LogTag& get_tag(Name tag);
+
+    // The minimum severity of the tags that don't have their own minimum severity. By default, all messages are logged.
+    SHOOTER_API static void set_default_minimum_severity(Severity::Type minimum_severity);
+    SHOOTER_API static void set_tag_minimum_severity(Name tag, Severity::Type minimum_severity);
+    // The tag will use the default minimum severity again.
+    SHOOTER_API static void reset_tag_minimum_severity(Name tag);
+
+    //
+    // Applies a list of filters, separated by commas or new lines. Each filter is either the name of a severity, which
+    // sets the default minimum severity, or `<tag>=<severity>`, which sets the minimum severity of a tag. Everything
+    // after a '#' character on the same line is ignored. For example: `Info, Renderer=Warn, Asset=Trace`.
+    // Returns false if any of the filters is invalid, in which case the valid filters are still applied.
+    //
+    SHOOTER_API static bool apply_filters(StringView filters);
+    // Applies the filters stored in the given file. A file that doesn't exist is the same as an empty file.
+    SHOOTER_API static bool apply_filters_from_file(const String& filepath);
+
+    // Returns false if the given string is not the name of a severity.
+    NODISCARD SHOOTER_API static bool parse_severity(StringView string, Severity::Type& out_severity);
+
 public:
     SHOOTER_API static void log_message(Severity::Type severity, StringView message);
-    SHOOTER_API static void log_tagged_message(Severity::Type severity, StringView tag, StringView message);
+    SHOOTER_API static void log_tagged_message(Severity::Type severity, Name tag, StringView message);
 
+    //
+    // The message is formatted in a buffer on the stack, so logging a message only allocates memory if the formatted
+    // message is longer than the inline capacity of the buffer.
+    //
     template<typename... Args>
-    ALWAYS_INLINE static void log_message(Severity::Type severity, StringView message, Args&&... args)
+    ALWAYS_INLINE static void log_message(Severity::Type severity, FormatString<TypeIdentity<Args>...> message, const Args&... args)
     {
-        Optional<String> formatted_message = format(message, forward<Args>(args)...);
-        if (!formatted_message.has_value())
+        FormatMemoryBuilder<512> formatted_message;
+        if (format_to(formatted_message, message, args...) != FormatErrorCode::Success)
             return;
-        log_message(severity, formatted_message.value().view());
+        log_message(severity, formatted_message.view());
     }
 
     template<typename... Args>
-    ALWAYS_INLINE static void log_tagged_message(Severity::Type severity, StringView tag, StringView message, Args&&... args)
+    ALWAYS_INLINE static void log_tagged_message(Severity::Type severity, Name tag, FormatString<TypeIdentity<Args>...> message, const Args&... args)
     {
-        Optional<String> formatted_message = format(message, forward<Args>(args)...);
-        if (!formatted_message.has_value())
+        FormatMemoryBuilder<512> formatted_message;
+        if (format_to(formatted_message, message, args...) != FormatErrorCode::Success)
             return;
-        log_tagged_message(severity, tag, formatted_message.value().view());
+        log_tagged_message(severity, tag, formatted_message.view());
+    }
+
+public:
+    // Registers the format of the binary messages that are logged from one place. Returns the ID of the format.
+    NODISCARD SHOOTER_API static u32 register_binary_format(Severity::Type severity, StringView format, Span<const BinaryLogArgumentType> argument_types);
+
+    //
+    // Reserves room for the arguments of a binary message in the buffer of the calling thread, and returns the location
+    // where they must be written. Returns nullptr if the buffer is full, in which case the message is dropped.
+    //
+    NODISCARD SHOOTER_API static u8* begin_binary_message(u32 format_id, usize argument_byte_count);
+    // Publishes the message that was reserved by the last call to `begin_binary_message` on the calling thread.
+    SHOOTER_API static void end_binary_message();
+
+    //
+    // Logs a message without formatting it. The format is registered once for each place where the message is logged
+    // (each lambda that provides the format string has a distinct type), and each call only copies the encoded arguments
+    // to the buffer of the calling thread. The message is formatted later by the logger thread, or by the log decoder tool
+    // if it is written to a binary log file. Use `SE_LOG_FAST` instead of invoking this function directly.
+    //
+    template<typename FormatProvider, typename... Args>
+    ALWAYS_INLINE static void log_binary_message(FormatProvider, Severity::Type severity, const Args&... args)
+    {
+        // Validates the format string at compile time, as the text messages do.
+        MAYBE_UNUSED constexpr FormatString<TypeIdentity<Args>...> format_string = FormatProvider()();
+
+        // NOTE: The last element only exists so the array is never empty.
+        static constexpr BinaryLogArgumentType s_argument_types[] = { BinaryLogArgument<Args>::type..., BinaryLogArgumentType::Invalid };
+        static const u32 s_format_id =
+            register_binary_format(severity, FormatProvider()(), Span<const BinaryLogArgumentType>(s_argument_types, sizeof...(Args)));
+
+        const usize argument_byte_count = (BinaryLogArgument<Args>::get_byte_count(args) + ... + 0);
+        u8* destination = begin_binary_message(s_format_id, argument_byte_count);
+        if (!destination)
+            return;
+
+        ((destination = BinaryLogArgument<Args>::write(destination, args)), ...);
+        end_binary_message();
+    }
+
+    // Formats the line of a message, as it is written to the sinks: the time of the day, the severity, the tag (if any) and the message.
+    SHOOTER_API static void format_line(FormatBuilder& builder, u64 millisecond_of_day, Severity::Type severity, Name tag, StringView message);
+};
+
+//
+// The runtime filter of the messages that are logged with one tag. Checking whether a message is enabled only requires
+// an atomic load, so the disabled messages are discarded before their arguments are evaluated or formatted.
+//
+struct LogTag
+{
+    ALWAYS_INLINE LogTag(Name in_name, Logger::Severity::Type in_minimum_severity)
+        : name(in_name)
+        , minimum_severity(in_minimum_severity)
+    {}
+
+    NODISCARD ALWAYS_INLINE bool is_enabled(Logger::Severity::Type severity) const
+    {
+        return (severity >= minimum_severity.load(MemoryOrder::Relaxed));
     }
+
+    Name name;
+    Atomic<Logger::Severity::Type> minimum_severity;
+};
+
+//
+// A message that is written to the sinks.
+//
+struct LogMessage
+{
+    Logger::Severity::Type severity;
+    // Empty if the message was not logged with a tag.
+    Name tag;
+    StringView message;
+    // The message prefixed by the time, severity and tag, and terminated by a new line character.
+    StringView line;
+    // The value of the platform tick counter when the message was logged.
+    u64 tick_counter;
+    u64 thread_id;
+
+    // Only set for the messages logged with `SE_LOG_FAST`, which are also available in their encoded form.
+    const BinaryLogFormat* binary_format;
+    ReadonlyByteSpan binary_argument_bytes;
+};
+
+//
+// The format of the binary messages that are logged from one place with `SE_LOG_FAST`.
+//
+struct BinaryLogFormat
+{
+    u32 id;
+    Logger::Severity::Type severity;
+    StringView format;
+    Span<const BinaryLogArgumentType> argument_types;
+};
+
+//
+// Destination of the logged messages. Only invoked by the logger thread.
+//
+class LogSink
+{
+public:
+    virtual ~LogSink() = default;
+
+    // Invoked for every message, in the order in which they were logged.
+    virtual void write(const LogMessage& message) = 0;
+
+    // Invoked when there are no more messages to write and when the logger is flushed.
+    virtual void flush() {}
 };
 
 } // namespace SE
 
-#define SE_LOG_TRACE(message, ...) ::SE::Logger::log_message(::SE::Logger::Severity::Trace, message##sv, __VA_ARGS__)
-#define SE_LOG_INFO(message, ...)  ::SE::Logger::log_message(::SE::Logger::Severity::Info, message##sv, __VA_ARGS__)
-#define SE_LOG_WARN(message, ...)  ::SE::Logger::log_message(::SE::Logger::Severity::Warn, message##sv, __VA_ARGS__)
-#define SE_LOG_ERROR(message, ...) ::SE::Logger::log_message(::SE::Logger::Severity::Error, message##sv, __VA_ARGS__)
-#define SE_LOG_FATAL(message, ...) ::SE::Logger::log_message(::SE::Logger::Severity::Fatal, message##sv, __VA_ARGS__)
-
-#define SE_LOG_TAG_TRACE(tag, message, ...) ::SE::Logger::log_tagged_message(::SE::Logger::Severity::Trace, tag##sv, message##sv, __VA_ARGS__)
-#define SE_LOG_TAG_INFO(tag, message, ...)  ::SE::Logger::log_tagged_message(::SE::Logger::Severity::Info, tag##sv, message##sv, __VA_ARGS__)
-#define SE_LOG_TAG_WARN(tag, message, ...)  ::SE::Logger::log_tagged_message(::SE::Logger::Severity::Warn, tag##sv, message##sv, __VA_ARGS__)
-#define SE_LOG_TAG_ERROR(tag, message, ...) ::SE::Logger::log_tagged_message(::SE::Logger::Severity::Error, tag##sv, message##sv, __VA_ARGS__)
-#define SE_LOG_TAG_FATAL(tag, message, ...) ::SE::Logger::log_tagged_message(::SE::Logger::Severity::Fatal, tag##sv, message##sv, __VA_ARGS__)
+//
+// Logs a message, unless its severity is lower than `SE_LOG_MINIMUM_SEVERITY` (in which case the call is removed from the
+// build) or lower than the minimum severity of its tag (in which case the arguments are not evaluated).
+// The filter of the tag is requested only once for each place where a message is logged, and the statement that logs
+// the message can access it as `s_log_tag`.
+//
+#define SE_LOG_FILTERED(severity, tag_name, ...)                                                           \
+    do                                                                                                     \
+    {                                                                                                      \
+        if constexpr (::SE::Logger::Severity::severity >= ::SE::Logger::Severity::SE_LOG_MINIMUM_SEVERITY) \
+        {                                                                                                  \
+            static ::SE::LogTag& s_log_tag = ::SE::Logger::get_tag(tag_name);                              \
+            if (s_log_tag.is_enabled(::SE::Logger::Severity::severity))                                    \
+                __VA_ARGS__;                                                                               \
+        }                                                                                                  \
+    } while (0)
+
+#define SE_LOG_TRACE(message, ...) SE_LOG_FILTERED(Trace, ::SE::Name(), ::SE::Logger::log_message(::SE::Logger::Severity::Trace, message##sv, __VA_ARGS__))
+#define SE_LOG_INFO(message, ...)  SE_LOG_FILTERED(Info, ::SE::Name(), ::SE::Logger::log_message(::SE::Logger::Severity::Info, message##sv, __VA_ARGS__))
+#define SE_LOG_WARN(message, ...)  SE_LOG_FILTERED(Warn, ::SE::Name(), ::SE::Logger::log_message(::SE::Logger::Severity::Warn, message##sv, __VA_ARGS__))
+#define SE_LOG_ERROR(message, ...) SE_LOG_FILTERED(Error, ::SE::Name(), ::SE::Logger::log_message(::SE::Logger::Severity::Error, message##sv, __VA_ARGS__))
+#define SE_LOG_FATAL(message, ...) SE_LOG_FILTERED(Fatal, ::SE::Name(), ::SE::Logger::log_message(::SE::Logger::Severity::Fatal, message##sv, __VA_ARGS__))
+
+//
+// Logs a binary message, which is formatted by the logger thread instead of the calling thread. Meant for hot paths, such
+// as per-entity or per-draw diagnostics. Only the types that specialize `BinaryLogArgument` can be used as arguments.
+// The severity is the name of the severity, for example: `SE_LOG_FAST(Trace, "Drawing {} quads", quad_count)`.
+//
+#define SE_LOG_FAST(severity, message, ...)                                                                           \
+    SE_LOG_FILTERED(                                                                                                  \
+        severity, ::SE::Name(),                                                                                       \
+        ::SE::Logger::log_binary_message([]() { return message##sv; }, ::SE::Logger::Severity::severity, __VA_ARGS__) \
+    )
+
+#define SE_LOG_TAG_TRACE(tag, message, ...) \
+    SE_LOG_FILTERED(Trace, ::SE::Name(tag##sv), ::SE::Logger::log_tagged_message(::SE::Logger::Severity::Trace, s_log_tag.name, message##sv, __VA_ARGS__))
+#define SE_LOG_TAG_INFO(tag, message, ...) \
+    SE_LOG_FILTERED(Info, ::SE::Name(tag##sv), ::SE::Logger::log_tagged_message(::SE::Logger::Severity::Info, s_log_tag.name, message##sv, __VA_ARGS__))
+#define SE_LOG_TAG_WARN(tag, message, ...) \
+    SE_LOG_FILTERED(Warn, ::SE::Name(tag##sv), ::SE::Logger::log_tagged_message(::SE::Logger::Severity::Warn, s_log_tag.name, message##sv, __VA_ARGS__))
+#define SE_LOG_TAG_ERROR(tag, message, ...) \
+    SE_LOG_FILTERED(Error, ::SE::Name(tag##sv), ::SE::Logger::log_tagged_message(::SE::Logger::Severity::Error, s_log_tag.name, message##sv, __VA_ARGS__))
+#define SE_LOG_TAG_FATAL(tag, message, ...) \
+    SE_LOG_FILTERED(Fatal, ::SE::Name(tag##sv), ::SE::Logger::log_tagged_message(::SE::Logger::Severity::Fatal, s_log_tag.name, message##sv, __VA_ARGS__))
@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/LogSinks.h>
+#include <Core/Platform/Platform.h>
+
+namespace SE
+{
+
+// clang-format off
+static Platform::ConsoleColor s_console_color_table[5][2] = {
+    { Platform::ConsoleColor::DarkGray,    Platform::ConsoleColor::Black },
+    { Platform::ConsoleColor::Green,       Platform::ConsoleColor::Black },
+    { Platform::ConsoleColor::LightYellow, Platform::ConsoleColor::Black },
+    { Platform::ConsoleColor::LightRed,    Platform::ConsoleColor::Black },
+    { Platform::ConsoleColor::White,       Platform::ConsoleColor::Red   },
+};
+// clang-format on
+
+void ConsoleLogSink::write(const LogMessage& message)
+{
+    const Platform::ConsoleColor text_color = s_console_color_table[message.severity][0];
+    const Platform::ConsoleColor background_color = s_console_color_table[message.severity][1];
+    Platform::write_to_console(message.line, text_color, background_color);
+}
+
+FileLogSink::FileLogSink(String filepath, u64 max_byte_count, u32 max_backup_count)
+    : m_filepath(move(filepath))
+    , m_max_byte_count(max_byte_count)
+    , m_max_backup_count(max_backup_count)
+    , m_file_byte_count(0)
+    , m_file_builder(m_file_writer)
+{
+    if (FileSystem::exists(m_filepath))
+        rotate_files();
+    else
+        m_file_writer.open(m_filepath, false, FileWriter::OpenPolicy::CreateIfNotExisting, FileWriter::SharePolicy::ReadOnly);
+}
+
+FileLogSink::~FileLogSink()
+{
+    m_file_builder.flush();
+    m_file_writer.close();
+}
+
+void FileLogSink::write(const LogMessage& message)
+{
+    if (!m_file_writer.is_opened())
+        return;
+
+    // NOTE: A message that is larger than the maximum file size is still written, but it is the only message in its file.
+    if (m_file_byte_count > 0 && m_file_byte_count + message.line.byte_count() > m_max_byte_count)
+        rotate_files();
+
+    m_file_builder.push_characters(message.line.characters(), message.line.byte_count());
+    m_file_byte_count += message.line.byte_count();
+}
+
+void FileLogSink::flush()
+{
+    if (m_file_writer.is_opened())
+        m_file_builder.flush();
+}
+
+String FileLogSink::get_backup_filepath(u32 backup_index) const
+{
+    FormatMemoryBuilder<> backup_filepath;
+    format_to(backup_filepath, "{}.{}"sv, m_filepath, backup_index);
+    return backup_filepath.release_string();
+}
+
+void FileLogSink::rotate_files()
+{
+    if (m_file_writer.is_opened())
+    {
+        m_file_builder.flush();
+        m_file_writer.close();
+    }
+
+    if (m_max_backup_count > 0)
+    {
+        // The oldest backup is replaced by the one before it.
+        for (u32 backup_index = m_max_backup_count; backup_index > 1; --backup_index)
+            FileSystem::move_file(get_backup_filepath(backup_index - 1), get_backup_filepath(backup_index));
+        FileSystem::move_file(m_filepath, get_backup_filepath(1));
+    }
+
+    // NOTE: The file is opened without appending, so its contents are discarded if the file couldn't be moved.
+    m_file_writer.open(m_filepath, false, FileWriter::OpenPolicy::CreateIfNotExisting, FileWriter::SharePolicy::ReadOnly);
+    m_file_byte_count = 0;
+}
+
+BinaryFileLogSink::BinaryFileLogSink(const String& filepath)
+    : m_file_builder(m_file_writer)
+{
+    if (m_file_writer.open(filepath, false, FileWriter::OpenPolicy::CreateIfNotExisting, FileWriter::SharePolicy::ReadOnly) != FileError::Success)
+        return;
+
+    BinaryLogFile::Header header = {};
+    header.magic = BinaryLogFile::magic;
+    header.version = BinaryLogFile::version;
+    header.tick_counter_frequency = Platform::get_tick_counter_frequency();
+    header.start_tick_counter = Platform::get_current_tick_counter();
+
+    const Platform::SystemTime system_time = Platform::get_local_system_time();
+    header.start_millisecond_of_day =
+        ((static_cast<u64>(system_time.hour) * 60 + system_time.minute) * 60 + system_time.second) * 1000 + system_time.millisecond;
+    write_value(header);
+}
+
+BinaryFileLogSink::~BinaryFileLogSink()
+{
+    m_file_builder.flush();
+    m_file_writer.close();
+}
+
+void BinaryFileLogSink::write(const LogMessage& message)
+{
+    if (!m_file_writer.is_opened())
+        return;
+
+    if (message.binary_format)
+    {
+        write_format_if_required(*message.binary_format);
+        write_value(BinaryLogFile::ChunkKind::BinaryMessage);
+        write_value(message.binary_format->id);
+        write_value(message.tick_counter);
+        write_value(message.thread_id);
+        write_value(static_cast<u32>(message.binary_argument_bytes.count()));
+        m_file_builder.push_characters(reinterpret_cast<const char*>(message.binary_argument_bytes.elements()), message.binary_argument_bytes.count());
+        return;
+    }
+
+    const StringView tag = message.tag.is_empty() ? StringView() : message.tag.view();
+    write_value(BinaryLogFile::ChunkKind::TextMessage);
+    write_value(static_cast<u8>(message.severity));
+    write_value(message.tick_counter);
+    write_value(message.thread_id);
+    write_value(static_cast<u32>(tag.byte_count()));
+    write_value(static_cast<u32>(message.message.byte_count()));
+    m_file_builder.push_characters(tag.characters(), tag.byte_count());
+    m_file_builder.push_characters(message.message.characters(), message.message.byte_count());
+}
+
+void BinaryFileLogSink::flush()
+{
+    if (m_file_writer.is_opened())
+        m_file_builder.flush();
+}
+
+void BinaryFileLogSink::write_format_if_required(const BinaryLogFormat& format)
+{
+    if (format.id < m_written_formats.count() && m_written_formats[format.id])
+        return;
+
+    if (format.id >= m_written_formats.count())
+        m_written_formats.set_count(format.id + 1, 0);
+    m_written_formats[format.id] = 1;
+
+    write_value(BinaryLogFile::ChunkKind::Format);
+    write_value(format.id);
+    write_value(static_cast<u8>(format.severity));
+    write_value(static_cast<u8>(format.argument_types.count()));
+    write_value(static_cast<u32>(format.format.byte_count()));
+    m_file_builder.push_characters(reinterpret_cast<const char*>(format.argument_types.elements()), format.argument_types.count());
+    m_file_builder.push_characters(format.format.characters(), format.format.byte_count());
+}
+
+MemoryLogSink::MemoryLogSink(u32 capacity)
+    : m_entries(Vector<Entry>::create_filled(capacity))
+    , m_first_entry_index(0)
+    , m_entry_count(0)
+    , m_version(0)
+{
+    SE_ASSERT(capacity > 0);
+}
+
+void MemoryLogSink::write(const LogMessage& message)
+{
+    // Exclude the new line character from the stored line.
+    StringView line = message.line;
+    if (line.byte_count() > 0 && line.characters()[line.byte_count() - 1] == '\n')
+        line = StringView::unsafe_create_from_utf8(line.characters(), line.byte_count() - 1);
+
+    ScopedLock lock(m_mutex);
+    const u32 capacity = static_cast<u32>(m_entries.count());
+
+    Entry* entry;
+    if (m_entry_count < capacity)
+    {
+        entry = &m_entries[(m_first_entry_index + m_entry_count) % capacity];
+        ++m_entry_count;
+    }
+    else
+    {
+        // The sink is full, so the oldest message is replaced.
+        entry = &m_entries[m_first_entry_index];
+        m_first_entry_index = (m_first_entry_index + 1) % capacity;
+    }
+
+    entry->severity = message.severity;
+    entry->line = line;
+    ++m_version;
+}
+
+void MemoryLogSink::clear()
+{
+    ScopedLock lock(m_mutex);
+    m_first_entry_index = 0;
+    m_entry_count = 0;
+    ++m_version;
+}
+
+} // namespace SE
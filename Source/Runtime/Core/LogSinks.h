@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/Containers/Vector.h>
+#include <Core/FileSystem/FileSystem.h>
+#include <Core/Log.h>
+#include <Core/Platform/Thread.h>
+#include <Core/String/String.h>
+
+namespace SE
+{
+
+//
+// Writes the messages to the console of the process, colored by their severity.
+//
+class ConsoleLogSink final : public LogSink
+{
+public:
+    SHOOTER_API virtual void write(const LogMessage& message) override;
+};
+
+//
+// Writes the messages to a file on the disk. When the file grows larger than the maximum size it is renamed to
+// `<filepath>.1` (the previous backups being shifted to `<filepath>.2` and so on) and a new file is started, so the
+// log files never occupy more than `(max_backup_count + 1) * max_byte_count` bytes.
+// The file of the previous session is rotated in the same way when the sink is created.
+//
+class FileLogSink final : public LogSink
+{
+    SE_MAKE_NONCOPYABLE(FileLogSink);
+    SE_MAKE_NONMOVABLE(FileLogSink);
+
+public:
+    static constexpr u64 default_max_byte_count = 16 * MiB;
+    static constexpr u32 default_max_backup_count = 3;
+
+public:
+    SHOOTER_API explicit FileLogSink(String filepath, u64 max_byte_count = default_max_byte_count, u32 max_backup_count = default_max_backup_count);
+    SHOOTER_API virtual ~FileLogSink() override;
+
+    NODISCARD ALWAYS_INLINE bool is_opened() const { return m_file_writer.is_opened(); }
+
+    // The messages are buffered in memory and written to the file only when the sink is flushed.
+    SHOOTER_API virtual void write(const LogMessage& message) override;
+    SHOOTER_API virtual void flush() override;
+
+private:
+    NODISCARD String get_backup_filepath(u32 backup_index) const;
+    void rotate_files();
+
+private:
+    String m_filepath;
+    u64 m_max_byte_count;
+    u32 m_max_backup_count;
+    // The number of bytes written to the current file, including the bytes that are still buffered.
+    u64 m_file_byte_count;
+    FileWriter m_file_writer;
+    FormatFileBuilder m_file_builder;
+};
+
+//
+// Writes the messages to a binary log file, which can be converted to text by the log decoder tool. The binary messages
+// are written in their encoded form, together with their formats, so they are cheaper to write and much smaller than
+// their text. The text messages are written as they are.
+//
+class BinaryFileLogSink final : public LogSink
+{
+    SE_MAKE_NONCOPYABLE(BinaryFileLogSink);
+    SE_MAKE_NONMOVABLE(BinaryFileLogSink);
+
+public:
+    SHOOTER_API explicit BinaryFileLogSink(const String& filepath);
+    SHOOTER_API virtual ~BinaryFileLogSink() override;
+
+    NODISCARD ALWAYS_INLINE bool is_opened() const { return m_file_writer.is_opened(); }
+
+    SHOOTER_API virtual void write(const LogMessage& message) override;
+    SHOOTER_API virtual void flush() override;
+
+private:
+    template<typename T>
+    ALWAYS_INLINE void write_value(const T& value)
+    {
+        m_file_builder.push_characters(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    void write_format_if_required(const BinaryLogFormat& format);
+
+private:
+    FileWriter m_file_writer;
+    FormatFileBuilder m_file_builder;
+    // Indexed by the ID of a binary format, and set to one after the format has been written to the file.
+    Vector<u8> m_written_formats;
+};
+
+//
+// Keeps the most recent messages in memory, so they can be displayed by the editor.
+// NOTE: The messages are written by the logger thread, so the sink must be locked while its messages are accessed.
+//
+class MemoryLogSink final : public LogSink
+{
+public:
+    struct Entry
+    {
+        Logger::Severity::Type severity;
+        // The line of the message, without the new line character.
+        String line;
+    };
+
+public:
+    SHOOTER_API explicit MemoryLogSink(u32 capacity);
+
+    SHOOTER_API virtual void write(const LogMessage& message) override;
+    SHOOTER_API void clear();
+
+    // The mutex that must be locked while the messages are accessed.
+    NODISCARD ALWAYS_INLINE Mutex& get_mutex() { return m_mutex; }
+
+    NODISCARD ALWAYS_INLINE u32 get_entry_count() const { return m_entry_count; }
+    // Returns the entry with the given index, where the index zero represents the oldest message that is still stored.
+    NODISCARD ALWAYS_INLINE const Entry& get_entry(u32 entry_index) const { return m_entries[(m_first_entry_index + entry_index) % m_entries.count()]; }
+
+    // Incremented every time a message is written or the sink is cleared.
+    NODISCARD ALWAYS_INLINE u64 get_version() const { return m_version; }
+
+private:
+    Mutex m_mutex;
+    Vector<Entry> m_entries;
+    u32 m_first_entry_index;
+    u32 m_entry_count;
+    u64 m_version;
+};
+
+} // namespace SE
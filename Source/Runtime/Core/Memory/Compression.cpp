@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/Memory/Compression.h>
+#include <Core/Memory/MemoryOperations.h>
+
+namespace SE
+{
+
+static constexpr usize s_lz4_min_match_byte_count = 4;
+static constexpr usize s_lz4_max_match_offset = 0xFFFF;
+// The last 5 bytes of a block are always literals, and the last match must start at least 12 bytes before the end of the block.
+static constexpr usize s_lz4_last_literals_byte_count = 5;
+static constexpr usize s_lz4_match_start_limit = 12;
+
+static constexpr u32 s_lz4_hash_table_bits = 12;
+
+NODISCARD ALWAYS_INLINE static u32 read_lz4_sequence(ReadonlyBytes bytes)
+{
+    u32 sequence;
+    copy_memory(&sequence, bytes, sizeof(u32));
+    return sequence;
+}
+
+NODISCARD ALWAYS_INLINE static u32 hash_lz4_sequence(u32 sequence)
+{
+    return (sequence * 2654435761U) >> (32 - s_lz4_hash_table_bits);
+}
+
+// Writes the part of a length that doesn't fit in the 4 bits of the token, as a run of 255 values ended by a smaller value.
+ALWAYS_INLINE static void write_lz4_length(WriteonlyBytes& output, usize length)
+{
+    for (; length >= 255; length -= 255)
+        *output++ = 255;
+    *output++ = static_cast<u8>(length);
+}
+
+static void write_lz4_sequence(WriteonlyBytes& output, ReadonlyBytes literals, usize literal_count, usize match_offset, usize match_byte_count)
+{
+    WriteonlyBytes token = output++;
+    *token = static_cast<u8>((literal_count >= 15 ? 15 : literal_count) << 4);
+    if (literal_count >= 15)
+        write_lz4_length(output, literal_count - 15);
+
+    copy_memory(output, literals, literal_count);
+    output += literal_count;
+
+    // The last sequence of the block only contains literals.
+    if (match_byte_count == 0)
+        return;
+
+    *output++ = static_cast<u8>(match_offset & 0xFF);
+    *output++ = static_cast<u8>((match_offset >> 8) & 0xFF);
+
+    const usize match_length = match_byte_count - s_lz4_min_match_byte_count;
+    *token |= static_cast<u8>(match_length >= 15 ? 15 : match_length);
+    if (match_length >= 15)
+        write_lz4_length(output, match_length - 15);
+}
+
+usize compress_lz4(ReadonlyByteSpan source, WriteonlyByteSpan destination)
+{
+    SE_ASSERT(destination.count() >= get_lz4_max_compressed_byte_count(source.count()));
+
+    ReadonlyBytes input = source.elements();
+    const usize input_byte_count = source.count();
+    WriteonlyBytes output = destination.elements();
+
+    // Each slot stores the position (plus one) of the last occurrence of a 4-byte sequence with the given hash, or zero.
+    u32 hash_table[1 << s_lz4_hash_table_bits] = {};
+
+    usize anchor = 0;
+    usize position = 0;
+    if (input_byte_count > s_lz4_match_start_limit)
+    {
+        const usize match_end_limit = input_byte_count - s_lz4_last_literals_byte_count;
+        while (position + s_lz4_match_start_limit < input_byte_count)
+        {
+            const u32 sequence = read_lz4_sequence(input + position);
+            u32& hash_slot = hash_table[hash_lz4_sequence(sequence)];
+            const usize candidate = hash_slot;
+            hash_slot = static_cast<u32>(position + 1);
+
+            if (candidate == 0 || position - (candidate - 1) > s_lz4_max_match_offset || read_lz4_sequence(input + candidate - 1) != sequence)
+            {
+                ++position;
+                continue;
+            }
+
+            const usize match_position = candidate - 1;
+            usize match_byte_count = s_lz4_min_match_byte_count;
+            while (position + match_byte_count < match_end_limit && input[match_position + match_byte_count] == input[position + match_byte_count])
+                ++match_byte_count;
+
+            write_lz4_sequence(output, input + anchor, position - anchor, position - match_position, match_byte_count);
+            position += match_byte_count;
+            anchor = position;
+        }
+    }
+
+    write_lz4_sequence(output, input + anchor, input_byte_count - anchor, 0, 0);
+    return static_cast<usize>(output - destination.elements());
+}
+
+// Reads the continuation of a length, as written by `write_lz4_length`. Returns false if the input ends before the length does.
+NODISCARD ALWAYS_INLINE static bool read_lz4_length(ReadonlyBytes& input, ReadonlyBytes input_end, usize& length)
+{
+    u8 value;
+    do
+    {
+        if (input >= input_end)
+            return false;
+        value = *input++;
+        length += value;
+    } while (value == 255);
+    return true;
+}
+
+bool decompress_lz4(ReadonlyByteSpan source, WriteonlyByteSpan destination)
+{
+    ReadonlyBytes input = source.elements();
+    ReadonlyBytes input_end = input + source.count();
+    WriteonlyBytes output = destination.elements();
+    WriteonlyBytes output_begin = output;
+    WriteonlyBytes output_end = output + destination.count();
+
+    while (input < input_end)
+    {
+        const u8 token = *input++;
+
+        usize literal_count = token >> 4;
+        if (literal_count == 15 && !read_lz4_length(input, input_end, literal_count))
+            return false;
+        if (literal_count > static_cast<usize>(input_end - input) || literal_count > static_cast<usize>(output_end - output))
+            return false;
+
+        copy_memory(output, input, literal_count);
+        input += literal_count;
+        output += literal_count;
+
+        // The last sequence of the block only contains literals.
+        if (input == input_end)
+            return (output == output_end);
+
+        if (input_end - input < 2)
+            return false;
+        const usize match_offset = static_cast<usize>(input[0]) | (static_cast<usize>(input[1]) << 8);
+        input += 2;
+        if (match_offset == 0 || match_offset > static_cast<usize>(output - output_begin))
+            return false;
+
+        usize match_byte_count = token & 0x0F;
+        if (match_byte_count == 15 && !read_lz4_length(input, input_end, match_byte_count))
+            return false;
+        match_byte_count += s_lz4_min_match_byte_count;
+        if (match_byte_count > static_cast<usize>(output_end - output))
+            return false;
+
+        // NOTE: The match can overlap the bytes that are being written (when the offset is smaller than the match length),
+        //       in which case the bytes must be copied one by one, in order to repeat the pattern.
+        ReadonlyBytes match = output - match_offset;
+        if (match_offset >= match_byte_count)
+        {
+            copy_memory(output, match, match_byte_count);
+            output += match_byte_count;
+        }
+        else
+        {
+            for (usize byte_index = 0; byte_index < match_byte_count; ++byte_index)
+                *output++ = match[byte_index];
+        }
+    }
+
+    // An empty block is valid only when the uncompressed data is empty as well.
+    return (source.count() == 0 && destination.count() == 0);
+}
+
+} // namespace SE
@@ -0,0 +1,39 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/API.h>
+#include <Core/Containers/Span.h>
+
+namespace SE
+{
+
+//
+// Compression using the LZ4 block format, which trades compression ratio for a very fast decompression (it only
+// copies literals and previous matches, with no entropy decoding). The compressed blocks are compatible with any
+// other LZ4 implementation, but the frame format (headers, checksums) is not used.
+// https://github.com/lz4/lz4/blob/dev/doc/lz4_Block_format.md
+//
+
+// Returns the maximum number of bytes that compressing the given number of bytes can produce.
+NODISCARD ALWAYS_INLINE constexpr usize get_lz4_max_compressed_byte_count(usize byte_count)
+{
+    return byte_count + (byte_count / 255) + 16;
+}
+
+//
+// Compresses the source bytes into the destination, which must be at least `get_lz4_max_compressed_byte_count` bytes large.
+// Returns the number of bytes written to the destination.
+//
+NODISCARD SHOOTER_API usize compress_lz4(ReadonlyByteSpan source, WriteonlyByteSpan destination);
+
+//
+// Decompresses an LZ4 block into the destination, whose size must be exactly the size of the uncompressed data.
+// The input is fully validated, so a corrupted block never reads or writes out of bounds and results in returning false.
+//
+NODISCARD SHOOTER_API bool decompress_lz4(ReadonlyByteSpan source, WriteonlyByteSpan destination);
+
+} // namespace SE
@@ -4,6 +4,11 @@
  */
 
 #include <Core/Memory/MemoryOperations.h>
+#include <bit>
+
+#if SE_SIMD_SSE2
+    #include <emmintrin.h>
+#endif // SE_SIMD_SSE2
 
 namespace SE
 {
@@ -31,4 +36,63 @@ void zero_memory(void* destination, usize byte_count)
         dst_bytes[byte_offset] = 0;
 }
 
+#if SE_SIMD_SSE2
+
+// Returns a mask where each bit is set if the corresponding byte of the 32-byte block is equal to the pattern.
+NODISCARD ALWAYS_INLINE static u32 get_equal_byte_mask(ReadonlyBytes block, __m128i pattern)
+{
+    const __m128i low_half = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(block)), pattern);
+    const __m128i high_half = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 16)), pattern);
+    return static_cast<u32>(_mm_movemask_epi8(low_half)) | (static_cast<u32>(_mm_movemask_epi8(high_half)) << 16);
+}
+
+#endif // SE_SIMD_SSE2
+
+usize find_byte(const void* memory, ReadonlyByte byte_value, usize byte_count)
+{
+    ReadonlyBytes bytes = reinterpret_cast<ReadonlyBytes>(memory);
+    usize byte_offset = 0;
+
+#if SE_SIMD_SSE2
+    const __m128i pattern = _mm_set1_epi8(static_cast<char>(byte_value));
+    for (; byte_offset + 32 <= byte_count; byte_offset += 32)
+    {
+        const u32 equal_byte_mask = get_equal_byte_mask(bytes + byte_offset, pattern);
+        if (equal_byte_mask != 0)
+            return byte_offset + std::countr_zero(equal_byte_mask);
+    }
+#endif // SE_SIMD_SSE2
+
+    for (; byte_offset < byte_count; ++byte_offset)
+    {
+        if (bytes[byte_offset] == byte_value)
+            return byte_offset;
+    }
+    return invalid_size;
+}
+
+usize find_last_byte(const void* memory, ReadonlyByte byte_value, usize byte_count)
+{
+    ReadonlyBytes bytes = reinterpret_cast<ReadonlyBytes>(memory);
+    usize end_offset = byte_count;
+
+#if SE_SIMD_SSE2
+    const __m128i pattern = _mm_set1_epi8(static_cast<char>(byte_value));
+    for (; end_offset >= 32; end_offset -= 32)
+    {
+        const u32 equal_byte_mask = get_equal_byte_mask(bytes + end_offset - 32, pattern);
+        if (equal_byte_mask != 0)
+            return end_offset - 1 - std::countl_zero(equal_byte_mask);
+    }
+#endif // SE_SIMD_SSE2
+
+    while (end_offset > 0)
+    {
+        --end_offset;
+        if (bytes[end_offset] == byte_value)
+            return end_offset;
+    }
+    return invalid_size;
+}
+
 } // namespace SE
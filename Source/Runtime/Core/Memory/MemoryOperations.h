@@ -19,6 +19,13 @@ SHOOTER_API void set_memory(void* destination, ReadonlyByte byte_value, usize by
 
 SHOOTER_API void zero_memory(void* destination, usize byte_count);
 
+//
+// Returns the offset of the first (or the last) byte that is equal to the given value, or `invalid_size` if no byte is.
+// The bytes are compared 32 at a time, when the architecture allows it.
+//
+NODISCARD SHOOTER_API usize find_byte(const void* memory, ReadonlyByte byte_value, usize byte_count);
+NODISCARD SHOOTER_API usize find_last_byte(const void* memory, ReadonlyByte byte_value, usize byte_count);
+
 template<typename T>
 ALWAYS_INLINE static void copy_memory_from_span(void* destination, Span<T> span)
 {
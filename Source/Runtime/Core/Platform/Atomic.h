@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/CoreTypes.h>
+
+// NOTE: The standard library atomics are the only portable way of emitting the correct instructions and
+//       compiler barriers for every supported compiler, so this header is a thin wrapper around them.
+#include <atomic>
+
+namespace SE
+{
+
+enum class MemoryOrder : u8
+{
+    Relaxed,
+    Acquire,
+    Release,
+    AcquireRelease,
+    SequentiallyConsistent,
+};
+
+//
+// Value that can be safely read and modified by multiple threads at the same time.
+// Only integral, enumeration and pointer types are supported.
+//
+template<typename T>
+class Atomic
+{
+    SE_MAKE_NONCOPYABLE(Atomic);
+    SE_MAKE_NONMOVABLE(Atomic);
+
+public:
+    ALWAYS_INLINE Atomic()
+        : m_value(T())
+    {}
+
+    ALWAYS_INLINE explicit Atomic(T value)
+        : m_value(value)
+    {}
+
+    NODISCARD ALWAYS_INLINE T load(MemoryOrder order = MemoryOrder::SequentiallyConsistent) const
+    {
+        return m_value.load(to_std_memory_order(order));
+    }
+
+    ALWAYS_INLINE void store(T value, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
+    {
+        m_value.store(value, to_std_memory_order(order));
+    }
+
+    // Returns the value that was stored before the exchange.
+    ALWAYS_INLINE T exchange(T value, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
+    {
+        return m_value.exchange(value, to_std_memory_order(order));
+    }
+
+    //
+    // Replaces the stored value with `desired` only if it is equal to `expected`. Returns true if the exchange
+    // was performed, otherwise `expected` is updated to contain the currently stored value.
+    //
+    ALWAYS_INLINE bool compare_exchange(T& expected, T desired, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
+    {
+        return m_value.compare_exchange_strong(expected, desired, to_std_memory_order(order), to_std_failure_memory_order(order));
+    }
+
+    // Returns the value that was stored before the addition.
+    ALWAYS_INLINE T fetch_add(T value, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
+    {
+        return m_value.fetch_add(value, to_std_memory_order(order));
+    }
+
+    // Returns the value that was stored before the subtraction.
+    ALWAYS_INLINE T fetch_sub(T value, MemoryOrder order = MemoryOrder::SequentiallyConsistent)
+    {
+        return m_value.fetch_sub(value, to_std_memory_order(order));
+    }
+
+private:
+    NODISCARD ALWAYS_INLINE static constexpr std::memory_order to_std_memory_order(MemoryOrder order)
+    {
+        switch (order)
+        {
+            case MemoryOrder::Relaxed: return std::memory_order_relaxed;
+            case MemoryOrder::Acquire: return std::memory_order_acquire;
+            case MemoryOrder::Release: return std::memory_order_release;
+            case MemoryOrder::AcquireRelease: return std::memory_order_acq_rel;
+            case MemoryOrder::SequentiallyConsistent: return std::memory_order_seq_cst;
+        }
+        return std::memory_order_seq_cst;
+    }
+
+    // The memory order used when a compare-exchange fails can't contain a release operation.
+    NODISCARD ALWAYS_INLINE static constexpr std::memory_order to_std_failure_memory_order(MemoryOrder order)
+    {
+        switch (order)
+        {
+            case MemoryOrder::Release: return std::memory_order_relaxed;
+            case MemoryOrder::AcquireRelease: return std::memory_order_acquire;
+            default: return to_std_memory_order(order);
+        }
+    }
+
+private:
+    std::atomic<T> m_value;
+};
+
+} // namespace SE
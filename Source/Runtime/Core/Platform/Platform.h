@@ -35,6 +35,18 @@ public:
         White,
     };
 
+    // Calendar date and time of day, as displayed by the operating system.
+    struct SystemTime
+    {
+        u16 year;
+        u8 month;
+        u8 day;
+        u8 hour;
+        u8 minute;
+        u8 second;
+        u16 millisecond;
+    };
+
 public:
     SHOOTER_API static bool initialize();
     SHOOTER_API static void shutdown();
@@ -42,6 +54,12 @@ public:
     SHOOTER_API static u64 get_current_tick_counter();
     SHOOTER_API static u64 get_tick_counter_frequency();
 
+    // Returns the current local (wall-clock) time. Unlike the tick counter, it is not monotonic.
+    SHOOTER_API static SystemTime get_local_system_time();
+
+    // Returns the number of bytes of physical memory currently used by the process (its resident set or working set).
+    SHOOTER_API static usize get_process_resident_byte_count();
+
     SHOOTER_API static void write_to_console(StringView message, ConsoleColor text_color, ConsoleColor background_color);
 };
 
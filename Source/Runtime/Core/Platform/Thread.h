@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/API.h>
+#include <Core/CoreTypes.h>
+#include <Core/String/StringView.h>
+
+namespace SE
+{
+
+using PFN_ThreadEntryPoint = void (*)(void* user_data);
+
+//
+// Thin wrapper around a native operating system thread.
+// The thread starts executing the entry point as soon as `start` is called, and it must be joined
+// before the wrapper object is destroyed.
+//
+class Thread
+{
+    SE_MAKE_NONCOPYABLE(Thread);
+    SE_MAKE_NONMOVABLE(Thread);
+
+public:
+    Thread() = default;
+    SHOOTER_API ~Thread();
+
+    // Returns true if the thread has been started and not yet joined.
+    NODISCARD ALWAYS_INLINE bool is_joinable() const { return (m_native_handle != nullptr); }
+
+public:
+    // The name of the thread is only used for debugging purposes.
+    SHOOTER_API bool start(PFN_ThreadEntryPoint entry_point, void* user_data, StringView name);
+
+    // Blocks the calling thread until the thread finishes its execution.
+    SHOOTER_API void join();
+
+public:
+    NODISCARD SHOOTER_API static u64 get_current_thread_id();
+
+    // Returns the number of threads that the hardware can execute concurrently.
+    NODISCARD SHOOTER_API static u32 get_hardware_concurrency();
+
+    SHOOTER_API static void sleep_for_milliseconds(u32 milliseconds);
+
+private:
+    void* m_native_handle { nullptr };
+};
+
+//
+// Lightweight non-recursive mutual exclusion primitive.
+//
+class Mutex
+{
+    SE_MAKE_NONCOPYABLE(Mutex);
+    SE_MAKE_NONMOVABLE(Mutex);
+
+    friend class ConditionVariable;
+
+public:
+    SHOOTER_API Mutex();
+    SHOOTER_API ~Mutex();
+
+    SHOOTER_API void lock();
+    SHOOTER_API void unlock();
+    NODISCARD SHOOTER_API bool try_lock();
+
+private:
+    // NOTE: Storage for the native lock object. On Windows this is a slim reader/writer lock,
+    //       which has the size of a pointer.
+    void* m_native_storage;
+};
+
+//
+// Locks the given mutex for the lifetime of the object.
+//
+class ScopedLock
+{
+    SE_MAKE_NONCOPYABLE(ScopedLock);
+    SE_MAKE_NONMOVABLE(ScopedLock);
+
+public:
+    ALWAYS_INLINE explicit ScopedLock(Mutex& mutex)
+        : m_mutex(mutex)
+    {
+        m_mutex.lock();
+    }
+
+    ALWAYS_INLINE ~ScopedLock() { m_mutex.unlock(); }
+
+private:
+    Mutex& m_mutex;
+};
+
+//
+// Condition variable that works together with `Mutex`.
+// As with any condition variable, spurious wake-ups are possible, so the waiting code must always
+// check the actual condition in a loop.
+//
+class ConditionVariable
+{
+    SE_MAKE_NONCOPYABLE(ConditionVariable);
+    SE_MAKE_NONMOVABLE(ConditionVariable);
+
+public:
+    SHOOTER_API ConditionVariable();
+    SHOOTER_API ~ConditionVariable();
+
+    // The mutex must be locked by the calling thread. It is released while waiting and locked again before returning.
+    SHOOTER_API void wait(Mutex& mutex);
+
+    SHOOTER_API void notify_one();
+    SHOOTER_API void notify_all();
+
+private:
+    void* m_native_storage;
+};
+
+} // namespace SE
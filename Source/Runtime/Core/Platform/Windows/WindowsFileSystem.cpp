@@ -69,7 +69,7 @@ static FileError write_to_file(HANDLE file_handle, ReadonlyByteSpan byte_buffer_
         const usize bytes_to_write = Math::min(byte_buffer_to_write.count() - byte_offset, max_bytes_to_write);
 
         DWORD bytes_written;
-        BOOL write_success = WriteFile(file_handle, byte_buffer_to_write.elements(), (DWORD)(bytes_to_write), &bytes_written, NULL);
+        BOOL write_success = WriteFile(file_handle, byte_buffer_to_write.elements() + byte_offset, (DWORD)(bytes_to_write), &bytes_written, NULL);
         if (!write_success || bytes_written != bytes_to_write)
             return FileError::Unknown;
 
@@ -358,6 +358,18 @@ FileError FileWriter::open(
     if (m_native_handle == INVALID_HANDLE_VALUE)
         return FileError::FileNotFound;
 
+    if (append)
+    {
+        // The file pointer of a newly opened handle is always placed at the beginning of the file.
+        LARGE_INTEGER distance_to_move = {};
+        if (!SetFilePointerEx(m_native_handle, distance_to_move, NULL, FILE_END))
+        {
+            CloseHandle(m_native_handle);
+            m_native_handle = INVALID_HANDLE_VALUE;
+            return FileError::Unknown;
+        }
+    }
+
     m_handle_is_opened = true;
     return FileError::Success;
 }
@@ -394,6 +406,97 @@ FileError FileWriter::write_and_close(ReadonlyByteSpan bytes_to_write)
     return file_error;
 }
 
+FileError FileWriter::write_gather(Span<const ReadonlyByteSpan> buffers_to_write)
+{
+    // Ensure that the file handle is ready for writing.
+    if (!m_handle_is_opened)
+        return FileError::FileHandleNotOpened;
+    SE_ASSERT(m_native_handle != INVALID_HANDLE_VALUE);
+
+    for (const ReadonlyByteSpan bytes_to_write : buffers_to_write)
+    {
+        const FileError file_error = write_to_file(m_native_handle, bytes_to_write);
+        if (file_error != FileError::Success)
+            return file_error;
+    }
+
+    return FileError::Success;
+}
+
+//==============================================================================================================
+// MEMORY MAPPED FILE.
+//==============================================================================================================
+
+MemoryMappedFile::MemoryMappedFile()
+    : m_file_handle(nullptr)
+    , m_mapping_handle(nullptr)
+    , m_mapped_data(nullptr)
+    , m_byte_count(0)
+{}
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+    close();
+}
+
+FileError MemoryMappedFile::open(const String& filepath)
+{
+    // Close the previously opened file.
+    close();
+
+    HANDLE file_handle = CreateFileA(filepath_to_cstr(filepath), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file_handle == INVALID_HANDLE_VALUE)
+        return FileError::FileNotFound;
+    m_file_handle = file_handle;
+
+    LARGE_INTEGER file_size_large_integer;
+    if (!GetFileSizeEx(file_handle, &file_size_large_integer))
+    {
+        close();
+        return FileError::Unknown;
+    }
+
+    m_byte_count = static_cast<usize>(file_size_large_integer.QuadPart);
+    if (m_byte_count == 0)
+    {
+        // Empty files can't be mapped, but they are valid files nonetheless.
+        return FileError::Success;
+    }
+
+    // https://learn.microsoft.com/en-us/windows/win32/api/memoryapi/nf-memoryapi-createfilemappinga
+    m_mapping_handle = CreateFileMappingA(file_handle, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (m_mapping_handle == NULL)
+    {
+        close();
+        return FileError::Unknown;
+    }
+
+    // https://learn.microsoft.com/en-us/windows/win32/api/memoryapi/nf-memoryapi-mapviewoffile
+    m_mapped_data = static_cast<ReadonlyBytes>(MapViewOfFile(m_mapping_handle, FILE_MAP_READ, 0, 0, 0));
+    if (m_mapped_data == nullptr)
+    {
+        close();
+        return FileError::Unknown;
+    }
+
+    return FileError::Success;
+}
+
+void MemoryMappedFile::close()
+{
+    if (m_mapped_data != nullptr)
+        UnmapViewOfFile(m_mapped_data);
+    if (m_mapping_handle != nullptr)
+        CloseHandle(m_mapping_handle);
+    if (m_file_handle != nullptr)
+        CloseHandle(m_file_handle);
+
+    m_file_handle = nullptr;
+    m_mapping_handle = nullptr;
+    m_mapped_data = nullptr;
+    m_byte_count = 0;
+}
+
 //==============================================================================================================
 // FILE SYSTEM.
 //==============================================================================================================
@@ -429,6 +532,29 @@ Optional<usize> FileSystem::get_file_size(const String& filepath)
     return success ? Optional<usize>(file_size.QuadPart) : Optional<usize>();
 }
 
+Optional<u64> FileSystem::get_file_last_write_time(const String& filepath)
+{
+    WIN32_FILE_ATTRIBUTE_DATA file_attribute_data;
+    if (!GetFileAttributesExA(filepath_to_cstr(filepath), GetFileExInfoStandard, &file_attribute_data))
+        return {};
+
+    const FILETIME& last_write_time = file_attribute_data.ftLastWriteTime;
+    return (static_cast<u64>(last_write_time.dwHighDateTime) << 32) | static_cast<u64>(last_write_time.dwLowDateTime);
+}
+
+bool FileSystem::move_file(const String& source_filepath, const String& destination_filepath)
+{
+    // NOTE: The function only returns after the file has been moved on disk, so the move can be used to atomically
+    //       replace a file with a newly written version of it.
+    const DWORD flags = MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH;
+    return MoveFileExA(filepath_to_cstr(source_filepath), filepath_to_cstr(destination_filepath), flags);
+}
+
+bool FileSystem::delete_file(const String& filepath)
+{
+    return DeleteFileA(filepath_to_cstr(filepath));
+}
+
 void FileSystem::set_working_directory(const String& filepath)
 {
     SetCurrentDirectoryA(filepath_to_cstr(filepath));
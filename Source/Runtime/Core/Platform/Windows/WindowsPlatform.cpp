@@ -5,6 +5,7 @@
 
 #include <Core/Platform/Platform.h>
 #include <Core/Platform/Windows/WindowsHeaders.h>
+#include <psapi.h>
 
 namespace SE
 {
@@ -65,6 +66,31 @@ u64 Platform::get_tick_counter_frequency()
     return s_windows_platform->performance_counter_frequency;
 }
 
+Platform::SystemTime Platform::get_local_system_time()
+{
+    SYSTEMTIME local_time;
+    GetLocalTime(&local_time);
+
+    SystemTime system_time;
+    system_time.year = static_cast<u16>(local_time.wYear);
+    system_time.month = static_cast<u8>(local_time.wMonth);
+    system_time.day = static_cast<u8>(local_time.wDay);
+    system_time.hour = static_cast<u8>(local_time.wHour);
+    system_time.minute = static_cast<u8>(local_time.wMinute);
+    system_time.second = static_cast<u8>(local_time.wSecond);
+    system_time.millisecond = static_cast<u16>(local_time.wMilliseconds);
+    return system_time;
+}
+
+usize Platform::get_process_resident_byte_count()
+{
+    // NOTE: The 'K32' version of the function is exported by kernel32.dll, so linking with psapi.lib is not required.
+    PROCESS_MEMORY_COUNTERS memory_counters = {};
+    if (!K32GetProcessMemoryInfo(GetCurrentProcess(), &memory_counters, sizeof(memory_counters)))
+        return 0;
+    return static_cast<usize>(memory_counters.WorkingSetSize);
+}
+
 static WORD get_console_foreground_color(Platform::ConsoleColor color)
 {
     switch (color)
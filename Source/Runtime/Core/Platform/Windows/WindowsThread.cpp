@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/Containers/Vector.h>
+#include <Core/Platform/Thread.h>
+#include <Core/Platform/Windows/WindowsHeaders.h>
+
+namespace SE
+{
+
+static_assert(sizeof(SRWLOCK) == sizeof(void*), "The storage of the mutex is not large enough for a SRWLOCK!");
+static_assert(sizeof(CONDITION_VARIABLE) == sizeof(void*), "The storage of the condition variable is not large enough for a CONDITION_VARIABLE!");
+
+//==============================================================================================================
+// THREAD.
+//==============================================================================================================
+
+struct WindowsThreadStartInfo
+{
+    PFN_ThreadEntryPoint entry_point;
+    void* user_data;
+};
+
+static DWORD WINAPI windows_thread_procedure(LPVOID parameter)
+{
+    // NOTE: The start information is allocated by the thread that created this thread and it is owned by
+    //       this thread from now on.
+    WindowsThreadStartInfo* start_info = static_cast<WindowsThreadStartInfo*>(parameter);
+    const PFN_ThreadEntryPoint entry_point = start_info->entry_point;
+    void* user_data = start_info->user_data;
+    delete start_info;
+
+    entry_point(user_data);
+    return 0;
+}
+
+static void set_windows_thread_name(HANDLE thread_handle, StringView name)
+{
+    if (name.is_empty())
+        return;
+
+    const int wide_character_count = MultiByteToWideChar(CP_UTF8, 0, name.characters(), static_cast<int>(name.byte_count()), nullptr, 0);
+    if (wide_character_count <= 0)
+        return;
+
+    // NOTE: The buffer is zero-initialized, so the last character acts as the null-termination character.
+    Vector<WCHAR> wide_name = Vector<WCHAR>::create_filled(static_cast<usize>(wide_character_count) + 1);
+    MultiByteToWideChar(CP_UTF8, 0, name.characters(), static_cast<int>(name.byte_count()), wide_name.elements(), wide_character_count);
+
+    // NOTE: The name of the thread is only a debugging aid, so failing to set it is not an error.
+    SetThreadDescription(thread_handle, wide_name.elements());
+}
+
+Thread::~Thread()
+{
+    // The thread must be joined before the wrapper object is destroyed.
+    SE_ASSERT(!is_joinable());
+}
+
+bool Thread::start(PFN_ThreadEntryPoint entry_point, void* user_data, StringView name)
+{
+    SE_ASSERT(entry_point != nullptr);
+    // The thread has already been started.
+    SE_ASSERT(!is_joinable());
+
+    WindowsThreadStartInfo* start_info = new WindowsThreadStartInfo();
+    start_info->entry_point = entry_point;
+    start_info->user_data = user_data;
+
+    HANDLE thread_handle = CreateThread(nullptr, 0, windows_thread_procedure, start_info, 0, nullptr);
+    if (thread_handle == nullptr)
+    {
+        delete start_info;
+        return false;
+    }
+
+    set_windows_thread_name(thread_handle, name);
+    m_native_handle = thread_handle;
+    return true;
+}
+
+void Thread::join()
+{
+    SE_ASSERT(is_joinable());
+    HANDLE thread_handle = static_cast<HANDLE>(m_native_handle);
+
+    WaitForSingleObject(thread_handle, INFINITE);
+    CloseHandle(thread_handle);
+    m_native_handle = nullptr;
+}
+
+u64 Thread::get_current_thread_id()
+{
+    return static_cast<u64>(GetCurrentThreadId());
+}
+
+u32 Thread::get_hardware_concurrency()
+{
+    SYSTEM_INFO system_info;
+    GetSystemInfo(&system_info);
+    return static_cast<u32>(system_info.dwNumberOfProcessors);
+}
+
+void Thread::sleep_for_milliseconds(u32 milliseconds)
+{
+    Sleep(static_cast<DWORD>(milliseconds));
+}
+
+//==============================================================================================================
+// MUTEX.
+//==============================================================================================================
+
+ALWAYS_INLINE static SRWLOCK* get_native_lock(void** native_storage)
+{
+    return reinterpret_cast<SRWLOCK*>(native_storage);
+}
+
+Mutex::Mutex()
+{
+    InitializeSRWLock(get_native_lock(&m_native_storage));
+}
+
+Mutex::~Mutex()
+{
+    // NOTE: Slim reader/writer locks don't have to be explicitly destroyed.
+}
+
+void Mutex::lock()
+{
+    AcquireSRWLockExclusive(get_native_lock(&m_native_storage));
+}
+
+void Mutex::unlock()
+{
+    ReleaseSRWLockExclusive(get_native_lock(&m_native_storage));
+}
+
+bool Mutex::try_lock()
+{
+    return TryAcquireSRWLockExclusive(get_native_lock(&m_native_storage)) != 0;
+}
+
+//==============================================================================================================
+// CONDITION VARIABLE.
+//==============================================================================================================
+
+ALWAYS_INLINE static CONDITION_VARIABLE* get_native_condition_variable(void** native_storage)
+{
+    return reinterpret_cast<CONDITION_VARIABLE*>(native_storage);
+}
+
+ConditionVariable::ConditionVariable()
+{
+    InitializeConditionVariable(get_native_condition_variable(&m_native_storage));
+}
+
+ConditionVariable::~ConditionVariable()
+{
+    // NOTE: Condition variables don't have to be explicitly destroyed.
+}
+
+void ConditionVariable::wait(Mutex& mutex)
+{
+    SleepConditionVariableSRW(get_native_condition_variable(&m_native_storage), get_native_lock(&mutex.m_native_storage), INFINITE, 0);
+}
+
+void ConditionVariable::notify_one()
+{
+    WakeConditionVariable(get_native_condition_variable(&m_native_storage));
+}
+
+void ConditionVariable::notify_all()
+{
+    WakeAllConditionVariable(get_native_condition_variable(&m_native_storage));
+}
+
+} // namespace SE
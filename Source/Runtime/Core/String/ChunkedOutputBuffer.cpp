@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/String/ChunkedOutputBuffer.h>
+
+namespace SE
+{
+
+ChunkedOutputBuffer::ChunkedOutputBuffer()
+    : FormatBuilder(nullptr, 0)
+    , m_file_writer(nullptr)
+    , m_max_streamed_chunk_count(0)
+    , m_buffered_byte_count(0)
+    , m_streamed_byte_count(0)
+    , m_file_error(FileError::Success)
+{
+    acquire_chunk();
+}
+
+ChunkedOutputBuffer::ChunkedOutputBuffer(FileWriter& file_writer, u32 max_streamed_chunk_count /*= default_max_streamed_chunk_count*/)
+    : FormatBuilder(nullptr, 0)
+    , m_file_writer(&file_writer)
+    , m_max_streamed_chunk_count(max_streamed_chunk_count)
+    , m_buffered_byte_count(0)
+    , m_streamed_byte_count(0)
+    , m_file_error(FileError::Success)
+{
+    SE_ASSERT(m_max_streamed_chunk_count > 0);
+    m_chunks.set_fixed_capacity(m_max_streamed_chunk_count);
+    acquire_chunk();
+}
+
+ChunkedOutputBuffer::~ChunkedOutputBuffer()
+{
+    if (is_streaming())
+        flush();
+
+    for (char* chunk : m_chunks)
+        ::operator delete(chunk);
+    for (char* chunk : m_free_chunks)
+        ::operator delete(chunk);
+}
+
+FileError ChunkedOutputBuffer::write_to(FileWriter& file_writer)
+{
+    SE_ASSERT(!is_streaming());
+    const FileError file_error = write_chunks(file_writer);
+    clear();
+    return file_error;
+}
+
+void ChunkedOutputBuffer::flush()
+{
+    SE_ASSERT(is_streaming());
+    if (m_buffered_byte_count + m_byte_count == 0)
+        return;
+
+    const FileError file_error = write_chunks(*m_file_writer);
+    if (m_file_error == FileError::Success)
+        m_file_error = file_error;
+
+    m_streamed_byte_count += m_buffered_byte_count + m_byte_count;
+    release_chunks();
+}
+
+void ChunkedOutputBuffer::clear()
+{
+    release_chunks();
+    m_streamed_byte_count = 0;
+}
+
+void ChunkedOutputBuffer::on_buffer_full(usize)
+{
+    // NOTE: A string that doesn't fit in the current chunk is split by the format builder, which continues to copy it
+    //       to the chunk acquired here.
+    if (is_streaming() && m_chunks.count() == m_max_streamed_chunk_count)
+    {
+        flush();
+        return;
+    }
+
+    m_buffered_byte_count += m_byte_count;
+    acquire_chunk();
+}
+
+FileError ChunkedOutputBuffer::write_chunks(FileWriter& file_writer) const
+{
+    Vector<ReadonlyByteSpan> chunk_spans;
+    chunk_spans.set_fixed_capacity(m_chunks.count());
+    for (usize chunk_index = 0; chunk_index < m_chunks.count(); ++chunk_index)
+    {
+        const bool is_last_chunk = (chunk_index == m_chunks.count() - 1);
+        const usize chunk_used_byte_count = is_last_chunk ? m_byte_count : chunk_byte_count;
+        if (chunk_used_byte_count > 0)
+            chunk_spans.add(ReadonlyByteSpan(reinterpret_cast<ReadonlyBytes>(m_chunks[chunk_index]), chunk_used_byte_count));
+    }
+
+    return file_writer.write_gather(Span<const ReadonlyByteSpan>(chunk_spans.elements(), chunk_spans.count()));
+}
+
+void ChunkedOutputBuffer::release_chunks()
+{
+    // The chunks are released in the reverse order, so the first chunk is the one acquired again.
+    for (usize chunk_index = m_chunks.count(); chunk_index > 0; --chunk_index)
+        m_free_chunks.add(m_chunks[chunk_index - 1]);
+    m_chunks.clear();
+
+    m_buffered_byte_count = 0;
+    acquire_chunk();
+}
+
+void ChunkedOutputBuffer::acquire_chunk()
+{
+    char* chunk;
+    if (m_free_chunks.has_elements())
+    {
+        chunk = m_free_chunks.last();
+        m_free_chunks.remove_last();
+    }
+    else
+    {
+        chunk = static_cast<char*>(::operator new(chunk_byte_count));
+    }
+
+    m_chunks.add(chunk);
+    m_buffer = chunk;
+    m_byte_count = 0;
+    m_capacity = chunk_byte_count;
+}
+
+} // namespace SE
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/Containers/Vector.h>
+#include <Core/FileSystem/FileSystem.h>
+#include <Core/String/Format.h>
+
+namespace SE
+{
+
+//
+// Builds a large output (such as a serialized scene) in a list of fixed size chunks, instead of a single contiguous
+// buffer, so appending never moves the characters that were already written.
+// When a file writer is given, the buffer streams its contents to the file: every time the maximum number of chunks
+// is filled, they are written to the file and then reused, so the memory used doesn't depend on the size of the output
+// and the file is written while the output is still being generated.
+// Otherwise, all chunks are kept in memory until they are written by `write_to`.
+// NOTE: The chunks are written one after another (see `FileWriter::write_gather`), so the output is not written to the
+//       file atomically, even if it fits in memory.
+//
+class ChunkedOutputBuffer final : public FormatBuilder
+{
+public:
+    static constexpr usize chunk_byte_count = 64 * KiB;
+    static constexpr u32 default_max_streamed_chunk_count = 4;
+
+public:
+    SHOOTER_API ChunkedOutputBuffer();
+    SHOOTER_API explicit ChunkedOutputBuffer(FileWriter& file_writer, u32 max_streamed_chunk_count = default_max_streamed_chunk_count);
+    SHOOTER_API virtual ~ChunkedOutputBuffer() override;
+
+    ALWAYS_INLINE void append(StringView string) { push_characters(string.characters(), string.byte_count()); }
+    ALWAYS_INLINE void append(ReadonlyByteSpan bytes) { push_characters(reinterpret_cast<const char*>(bytes.elements()), bytes.count()); }
+
+    // The number of bytes that have been appended to the buffer, including the ones already streamed to the file.
+    NODISCARD ALWAYS_INLINE usize byte_count() const { return m_streamed_byte_count + m_buffered_byte_count + m_byte_count; }
+    NODISCARD ALWAYS_INLINE bool is_streaming() const { return (m_file_writer != nullptr); }
+
+    //
+    // Writes the chunks that are stored in memory to the given file, one after another, and clears the buffer.
+    // Can only be used when the buffer doesn't stream its contents to a file.
+    //
+    SHOOTER_API FileError write_to(FileWriter& file_writer);
+
+    //
+    // Writes the chunks that haven't been streamed yet, including the partially filled one, to the file. Invoked
+    // automatically when the buffer is destroyed. Can only be used when the buffer streams its contents to a file.
+    //
+    SHOOTER_API void flush();
+
+    // The first error that occurred while streaming the contents to the file, if any.
+    NODISCARD ALWAYS_INLINE FileError file_error() const { return m_file_error; }
+
+    // Discards the contents of the buffer, keeping its chunks allocated to be reused.
+    SHOOTER_API void clear();
+
+protected:
+    virtual void on_buffer_full(usize required_byte_count) override;
+
+private:
+    // Writes all chunks that are stored in memory, where only the last one can be partially filled.
+    FileError write_chunks(FileWriter& file_writer) const;
+    // Marks all chunks as free and starts appending to the first one again.
+    void release_chunks();
+    void acquire_chunk();
+
+private:
+    // The chunks that are currently in use, in the order they were filled. The last one is the chunk characters are
+    // appended to (`m_buffer`), while all the others are full.
+    Vector<char*> m_chunks;
+    // The chunks that are no longer in use, which are reused instead of allocating new ones.
+    Vector<char*> m_free_chunks;
+    FileWriter* m_file_writer;
+    u32 m_max_streamed_chunk_count;
+    // The number of bytes stored in the full chunks.
+    usize m_buffered_byte_count;
+    usize m_streamed_byte_count;
+    FileError m_file_error;
+};
+
+} // namespace SE
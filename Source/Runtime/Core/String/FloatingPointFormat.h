@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/API.h>
+#include <Core/CoreTypes.h>
+
+namespace SE
+{
+
+//
+// Decimal representation of a positive floating point value, which is equal to `digits * 10^exponent`.
+// The digits never have trailing zeros, as they are moved into the exponent.
+//
+struct DecimalFloatingPoint
+{
+    u64 digits;
+    i32 exponent;
+};
+
+//
+// Calculates the shortest decimal representation of the given value that is parsed back to exactly the same value.
+// If there are multiple representations of the same length, the one closest to the exact value is returned.
+// The implementation follows the Ryu algorithm (Ulf Adams, 2018), which only requires a few 64-bit multiplications.
+// NOTE: The value must be finite and strictly positive.
+//
+NODISCARD SHOOTER_API DecimalFloatingPoint get_shortest_decimal(float value);
+NODISCARD SHOOTER_API DecimalFloatingPoint get_shortest_decimal(double value);
+
+// The maximum number of fractional digits supported by `write_fixed_decimal`.
+static constexpr u32 fixed_decimal_max_precision = 32;
+// The maximum number of characters written by `write_fixed_decimal`, excluding the fractional digits.
+static constexpr usize fixed_decimal_max_integral_digit_count = 309 + 1;
+
+//
+// Writes the given value in fixed notation, with exactly `precision` fractional digits, correctly rounded (ties are
+// rounded to even). The buffer must have room for `fixed_decimal_max_integral_digit_count + precision` characters.
+// Returns the number of characters that were written.
+// NOTE: The value must be finite and positive (or zero).
+//
+NODISCARD SHOOTER_API usize write_fixed_decimal(double value, u32 precision, char* buffer);
+
+} // namespace SE
@@ -4,129 +4,293 @@
  */
 
 #include <Core/String/Format.h>
-
-#define SE_FORMSE_SPECIFIER_BEGIN_TOKEN '{'
-#define SE_FORMSE_SPECIFIER_END_TOKEN   '}'
+#include <cmath>
 
 namespace SE
 {
 
-Optional<String> FormatBuilder::release_string()
+void FormatBuilder::push_characters_slow(const char* characters, usize byte_count)
 {
-    // NOTE: Creating a string from a vector of characters is very wasteful. In our current implementation,
-    //       there is always an unnecessary memory allocation. If the formatted string fits in a String
-    //       inline capacity then allocating the memory for the vector is not necessary. Otherwise, memory
-    //       is allocated for both the vector and the released string even though the vector memory is
-    //       freed right after.
-    // TODO: Replace the Vector container to something else that minimizes unnecessary memory allocations.
-    //       At the moment of writing this implementation, the concept of a StringBuilder doesn't exist.
-
-    auto formatted_view = StringView::unsafe_create_from_utf8(m_formatted_string_buffer.elements(), m_formatted_string_buffer.count());
-    String formatted_string = String(formatted_view);
-    m_formatted_string_buffer.clear_and_shrink();
-    return formatted_string;
+    while (byte_count > 0)
+    {
+        if (m_byte_count == m_capacity)
+        {
+            on_buffer_full(byte_count);
+            if (m_byte_count == m_capacity)
+            {
+                // NOTE: The builder couldn't make room for any more characters, so the remaining ones are discarded.
+                m_discarded_byte_count += byte_count;
+                return;
+            }
+        }
+
+        const usize chunk_byte_count = Math::min(byte_count, m_capacity - m_byte_count);
+        copy_memory(m_buffer + m_byte_count, characters, chunk_byte_count);
+        m_byte_count += chunk_byte_count;
+        characters += chunk_byte_count;
+        byte_count -= chunk_byte_count;
+    }
 }
 
-FormatErrorCode FormatBuilder::consume_until_format_specifier()
+// clang-format off
+static constexpr char s_decimal_digit_pairs[] =
+    "0001020304050607080910111213141516171819"
+    "2021222324252627282930313233343536373839"
+    "4041424344454647484950515253545556575859"
+    "6061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+// clang-format on
+
+static constexpr char s_lowercase_hexadecimal_digits[] = "0123456789abcdef";
+static constexpr char s_uppercase_hexadecimal_digits[] = "0123456789ABCDEF";
+
+// The longest 64-bit integer has 20 decimal digits (or 16 hexadecimal digits).
+static constexpr usize s_integer_max_digit_count = 20;
+
+// Writes the digits of the value so that they end at the given pointer, and returns the number of written digits.
+static usize write_decimal_integer(u64 value, char* buffer_end)
 {
-    usize specifier_offset = m_string_format.find(SE_FORMSE_SPECIFIER_BEGIN_TOKEN);
-    if (specifier_offset == StringView::invalid_position)
+    char* cursor = buffer_end;
+
+    // NOTE: Two digits are generated for each division, which is the most expensive part of the conversion.
+    while (value >= 100)
     {
-        m_formatted_string_buffer.add_span(m_string_format.byte_span().as<const char>());
-        return {};
+        const usize pair_offset = 2 * static_cast<usize>(value % 100);
+        value /= 100;
+        cursor -= 2;
+        cursor[0] = s_decimal_digit_pairs[pair_offset];
+        cursor[1] = s_decimal_digit_pairs[pair_offset + 1];
     }
 
-    m_formatted_string_buffer.add_span(m_string_format.byte_span().slice(0, specifier_offset).as<const char>());
-    m_string_format = m_string_format.slice(specifier_offset);
-    return {};
+    if (value >= 10)
+    {
+        const usize pair_offset = 2 * static_cast<usize>(value);
+        cursor -= 2;
+        cursor[0] = s_decimal_digit_pairs[pair_offset];
+        cursor[1] = s_decimal_digit_pairs[pair_offset + 1];
+    }
+    else
+    {
+        *--cursor = static_cast<char>('0' + value);
+    }
+
+    return static_cast<usize>(buffer_end - cursor);
 }
 
-Optional<FormatBuilder::Specifier> FormatBuilder::parse_specifier()
+// Writes the digits of the value so that they end at the given pointer, and returns the number of written digits.
+static usize write_hexadecimal_integer(u64 value, char* buffer_end, const char* hexadecimal_digits)
 {
-    if (m_string_format.is_empty() || m_string_format.byte_span()[0] != SE_FORMSE_SPECIFIER_BEGIN_TOKEN)
+    char* cursor = buffer_end;
+    do
     {
-        // NOTE: This function is only called when there is an argument passed to the 'format()' function
-        //       that hasn't been inserted in the formatted string yet. If this codepath is reached it
-        //       means that more arguments were passed to the function than required.
-        return {};
+        *--cursor = hexadecimal_digits[value & 0xF];
+        value >>= 4;
+    } while (value > 0);
+
+    return static_cast<usize>(buffer_end - cursor);
+}
+
+static usize write_integer(FormatBuilder::Specifier::Type type, u64 value, char* buffer_end)
+{
+    switch (type)
+    {
+        case FormatBuilder::Specifier::Type::Hexadecimal: return write_hexadecimal_integer(value, buffer_end, s_lowercase_hexadecimal_digits);
+        case FormatBuilder::Specifier::Type::HexadecimalUppercase: return write_hexadecimal_integer(value, buffer_end, s_uppercase_hexadecimal_digits);
+        default: return write_decimal_integer(value, buffer_end);
     }
+}
 
-    // Advance the format string to the next character, ignoring the SE_FORMSE_SPECIFIER_BEGIN_TOKEN.
-    m_string_format = m_string_format.slice(1);
+//
+// Writes the shortest decimal representation of a floating point value. Similarly to JavaScript, the fixed notation is
+// used when the decimal exponent is in the [-7, 21) range, otherwise the value is written in scientific notation.
+// NOTE: At most 26 characters are written (17 digits, the decimal point and an exponent with at most 3 digits).
+//
+static usize write_shortest_decimal(DecimalFloatingPoint decimal, char* buffer)
+{
+    char digits[s_integer_max_digit_count];
+    const usize digit_count = write_decimal_integer(decimal.digits, digits + sizeof(digits));
+    const char* first_digit = digits + sizeof(digits) - digit_count;
+    const i32 scientific_exponent = decimal.exponent + static_cast<i32>(digit_count) - 1;
 
-    usize specifier_count = m_string_format.find(SE_FORMSE_SPECIFIER_END_TOKEN);
-    if (specifier_count == StringView::invalid_position)
+    char* output = buffer;
+    if (-7 < scientific_exponent && scientific_exponent < 21)
     {
-        // NOTE: Because the format specifier doesn't have an end token the
-        //       string format is considered invalid.
-        return {};
+        if (decimal.exponent >= 0)
+        {
+            // The value is an integer, so the digits are followed by zeros.
+            copy_memory(output, first_digit, digit_count);
+            output += digit_count;
+            set_memory(output, '0', static_cast<usize>(decimal.exponent));
+            output += decimal.exponent;
+        }
+        else if (scientific_exponent >= 0)
+        {
+            const usize integral_digit_count = static_cast<usize>(scientific_exponent) + 1;
+            copy_memory(output, first_digit, integral_digit_count);
+            output += integral_digit_count;
+            *output++ = '.';
+            copy_memory(output, first_digit + integral_digit_count, digit_count - integral_digit_count);
+            output += digit_count - integral_digit_count;
+        }
+        else
+        {
+            const usize leading_zero_count = static_cast<usize>(-scientific_exponent) - 1;
+            *output++ = '0';
+            *output++ = '.';
+            set_memory(output, '0', leading_zero_count);
+            output += leading_zero_count;
+            copy_memory(output, first_digit, digit_count);
+            output += digit_count;
+        }
     }
+    else
+    {
+        *output++ = first_digit[0];
+        if (digit_count > 1)
+        {
+            *output++ = '.';
+            copy_memory(output, first_digit + 1, digit_count - 1);
+            output += digit_count - 1;
+        }
 
-    const StringView specifier_string = m_string_format.slice(0, specifier_count);
-    m_string_format = m_string_format.slice(specifier_count + 1);
+        *output++ = 'e';
+        *output++ = (scientific_exponent < 0) ? '-' : '+';
 
-    Optional<Specifier> specifier = FormatBuilder::parse_specifier(specifier_string);
-    if (specifier.has_value())
-        return specifier.value();
-    return {};
+        char exponent_digits[s_integer_max_digit_count];
+        const u64 exponent_magnitude = static_cast<u64>(scientific_exponent < 0 ? -scientific_exponent : scientific_exponent);
+        const usize exponent_digit_count = write_decimal_integer(exponent_magnitude, exponent_digits + sizeof(exponent_digits));
+        copy_memory(output, exponent_digits + sizeof(exponent_digits) - exponent_digit_count, exponent_digit_count);
+        output += exponent_digit_count;
+    }
+
+    return static_cast<usize>(output - buffer);
 }
 
-Optional<FormatBuilder::Specifier> FormatBuilder::parse_specifier(StringView specifier_string)
+void FormatBuilder::push_padding(char padding_character, usize padding_count)
 {
-    if (!specifier_string.is_empty())
+    char padding[32];
+    set_memory(padding, padding_character, Math::min(padding_count, sizeof(padding)));
+
+    while (padding_count > 0)
     {
-        // NOTE: Currently, we don't support any string format specifier!
-        return {};
+        const usize chunk_count = Math::min(padding_count, sizeof(padding));
+        push_characters(padding, chunk_count);
+        padding_count -= chunk_count;
     }
+}
 
-    return Specifier();
+void FormatBuilder::push_number(const Specifier& specifier, bool is_negative, const char* characters, usize byte_count)
+{
+    const usize total_byte_count = byte_count + (is_negative ? 1 : 0);
+    if (specifier.width <= total_byte_count)
+    {
+        if (is_negative)
+            push_characters("-", 1);
+        push_characters(characters, byte_count);
+        return;
+    }
+
+    const usize padding_count = specifier.width - total_byte_count;
+    if (!specifier.zero_padding)
+        push_padding(' ', padding_count);
+    if (is_negative)
+        push_characters("-", 1);
+    if (specifier.zero_padding)
+        push_padding('0', padding_count);
+    push_characters(characters, byte_count);
+}
+
+FormatErrorCode FormatBuilder::push_unsigned_integer(const Specifier& specifier, u64 value)
+{
+    if (specifier.type == Specifier::Type::Fixed)
+        return FormatErrorCode::InvalidSpecifier;
+
+    char buffer[s_integer_max_digit_count];
+    char* buffer_end = buffer + sizeof(buffer);
+    const usize digit_count = write_integer(specifier.type, value, buffer_end);
+
+    push_number(specifier, false, buffer_end - digit_count, digit_count);
+    return FormatErrorCode::Success;
+}
+
+FormatErrorCode FormatBuilder::push_signed_integer(const Specifier& specifier, i64 value)
+{
+    if (value >= 0)
+        return push_unsigned_integer(specifier, static_cast<u64>(value));
+    if (specifier.type == Specifier::Type::Fixed)
+        return FormatErrorCode::InvalidSpecifier;
+
+    // NOTE: The negation is done on the unsigned value, as negating the smallest signed value overflows.
+    const u64 magnitude = ~static_cast<u64>(value) + 1;
+
+    char buffer[s_integer_max_digit_count];
+    char* buffer_end = buffer + sizeof(buffer);
+    const usize digit_count = write_integer(specifier.type, magnitude, buffer_end);
+
+    push_number(specifier, true, buffer_end - digit_count, digit_count);
+    return FormatErrorCode::Success;
 }
 
-FormatErrorCode FormatBuilder::push_unsigned_integer(const Specifier&, u64 value)
+template<typename T>
+FormatErrorCode FormatBuilder::push_floating_point_impl(const Specifier& specifier, T value)
 {
-    // NOTE: The longest integer representation (in binary) is no longer than 64 characters.
-    char buffer[64] = {};
-    u8 digit_count = 0;
+    if (specifier.type == Specifier::Type::Hexadecimal || specifier.type == Specifier::Type::HexadecimalUppercase)
+        return FormatErrorCode::InvalidSpecifier;
 
-    if (value == 0)
+    const bool is_negative = std::signbit(value);
+    if (std::isnan(value) || std::isinf(value))
+    {
+        // NOTE: The special values are never padded with zeros, as that would make them look like numbers.
+        Specifier special_specifier = specifier;
+        special_specifier.zero_padding = false;
+        if (std::isnan(value))
+            push_number(special_specifier, false, "nan", 3);
+        else
+            push_number(special_specifier, is_negative, "inf", 3);
+        return FormatErrorCode::Success;
+    }
+
+    const T magnitude = is_negative ? -value : value;
+    char buffer[fixed_decimal_max_integral_digit_count + fixed_decimal_max_precision];
+    usize byte_count;
+
+    if (specifier.type == Specifier::Type::Fixed)
+    {
+        byte_count = write_fixed_decimal(static_cast<double>(magnitude), specifier.precision, buffer);
+    }
+    else if (magnitude == 0)
     {
         buffer[0] = '0';
-        digit_count = 1;
+        byte_count = 1;
     }
     else
     {
-        for (u64 temp_value = value; temp_value > 0; temp_value /= 10)
-        {
-            ++digit_count;
-        }
-
-        for (u8 digit_index = 0; digit_index < digit_count; ++digit_index)
-        {
-            u8 digit = value % 10;
-            buffer[digit_count - digit_index - 1] = '0' + digit;
-            value /= 10;
-        }
+        byte_count = write_shortest_decimal(get_shortest_decimal(magnitude), buffer);
     }
 
-    m_formatted_string_buffer.add_span({ buffer, digit_count });
+    push_number(specifier, is_negative, buffer, byte_count);
     return FormatErrorCode::Success;
 }
 
-FormatErrorCode FormatBuilder::push_signed_integer(const Specifier& specifier, i64 value)
+FormatErrorCode FormatBuilder::push_floating_point(const Specifier& specifier, float value)
 {
-    if (value < 0)
-    {
-        m_formatted_string_buffer.add('-');
-        value = -value;
-    }
+    return push_floating_point_impl(specifier, value);
+}
 
-    return push_unsigned_integer(specifier, static_cast<u64>(value));
+FormatErrorCode FormatBuilder::push_floating_point(const Specifier& specifier, double value)
+{
+    return push_floating_point_impl(specifier, value);
 }
 
-FormatErrorCode FormatBuilder::push_string(const Specifier&, StringView value)
+void FormatFileBuilder::flush()
 {
-    m_formatted_string_buffer.add_span(value.byte_span().as<const char>());
-    return FormatErrorCode::Success;
+    if (m_byte_count == 0)
+        return;
+
+    const FileError file_error = m_file_writer.write(ReadonlyByteSpan(reinterpret_cast<ReadonlyBytes>(m_buffer), m_byte_count));
+    if (m_file_error == FileError::Success)
+        m_file_error = file_error;
+    m_byte_count = 0;
 }
 
 } // namespace SE
@@ -7,7 +7,11 @@
 
 #include <Core/Containers/Optional.h>
 #include <Core/Containers/Span.h>
-#include <Core/Containers/Vector.h>
+#include <Core/FileSystem/FileSystem.h>
+#include <Core/Math/MathCore.h>
+#include <Core/Memory/MemoryOperations.h>
+#include <Core/String/FloatingPointFormat.h>
+#include <Core/String/Name.h>
 #include <Core/String/String.h>
 #include <Core/UUID.h>
 
@@ -22,31 +26,147 @@ enum class FormatErrorCode : u8
     InvalidSpecifier,
 };
 
+//
+// Destination of the formatted characters. The characters are written to a buffer that is provided by the derived
+// class, which decides what happens when the buffer is full: it can grow the buffer (`FormatMemoryBuilder`), flush its
+// contents (`FormatFileBuilder`) or discard the remaining characters (`FormatFixedBuilder`).
+//
 class FormatBuilder
 {
     SE_MAKE_NONCOPYABLE(FormatBuilder);
     SE_MAKE_NONMOVABLE(FormatBuilder);
 
 public:
+    //
+    // The options that can be given between the braces, after a colon: `{:[0][width][.precision][type]}`.
+    // For example, `{:x}` formats an integer in hexadecimal, `{:08}` pads a number with zeros to 8 characters and
+    // `{:.3f}` formats a floating point value with 3 fractional digits.
+    //
     struct Specifier
     {
+        enum class Type : u8
+        {
+            // Decimal for integers and the shortest representation that round-trips for floating point values.
+            Default,
+            // `x` and `X`: hexadecimal with lowercase or uppercase digits. Only valid for integers.
+            Hexadecimal,
+            HexadecimalUppercase,
+            // `f`: fixed notation with `precision` fractional digits (6 if not specified). Only valid for floating point values.
+            Fixed,
+        };
+
+        Type type { Type::Default };
+        // Numbers are padded with zeros (placed after the sign) instead of spaces. Not valid for strings.
+        bool zero_padding { false };
+        // The minimum number of characters. Numbers are aligned to the right, while strings are aligned to the left.
+        // NOTE: The width of a string is measured in bytes, not in codepoints.
+        u8 width { 0 };
+        u8 precision { 0 };
     };
 
-public:
-    ALWAYS_INLINE FormatBuilder(StringView string_format)
-        : m_string_format(string_format)
-    {}
+    static constexpr u32 max_specifier_width = 255;
+    static constexpr u32 max_specifier_precision = fixed_decimal_max_precision;
+
+    // Parses the text between the braces of a format specifier. Evaluated at compile time for the format strings.
+    NODISCARD static constexpr bool parse_specifier(StringView specifier_string, Specifier& out_specifier)
+    {
+        out_specifier = {};
+        if (specifier_string.is_empty())
+            return true;
+
+        const char* characters = specifier_string.characters();
+        const usize byte_count = specifier_string.byte_count();
+        if (characters[0] != ':')
+            return false;
+
+        usize offset = 1;
+        auto parse_number = [&](u32 max_value, u32& out_value) -> bool
+        {
+            const usize number_offset = offset;
+            for (out_value = 0; offset < byte_count && '0' <= characters[offset] && characters[offset] <= '9'; ++offset)
+            {
+                out_value = 10 * out_value + static_cast<u32>(characters[offset] - '0');
+                if (out_value > max_value)
+                    return false;
+            }
+            return (offset > number_offset);
+        };
+
+        if (offset < byte_count && characters[offset] == '0')
+        {
+            out_specifier.zero_padding = true;
+            ++offset;
+        }
+
+        u32 width = 0;
+        if (offset < byte_count && '1' <= characters[offset] && characters[offset] <= '9')
+        {
+            if (!parse_number(max_specifier_width, width))
+                return false;
+            out_specifier.width = static_cast<u8>(width);
+        }
+
+        bool has_precision = false;
+        u32 precision = 0;
+        if (offset < byte_count && characters[offset] == '.')
+        {
+            ++offset;
+            if (!parse_number(max_specifier_precision, precision))
+                return false;
+            out_specifier.precision = static_cast<u8>(precision);
+            has_precision = true;
+        }
+
+        if (offset < byte_count)
+        {
+            switch (characters[offset++])
+            {
+                case 'x': out_specifier.type = Specifier::Type::Hexadecimal; break;
+                case 'X': out_specifier.type = Specifier::Type::HexadecimalUppercase; break;
+                case 'f': out_specifier.type = Specifier::Type::Fixed; break;
+                default: return false;
+            }
+        }
+
+        if (offset != byte_count)
+            return false;
+        if (has_precision && out_specifier.type != Specifier::Type::Fixed)
+            return false;
+        if (!has_precision && out_specifier.type == Specifier::Type::Fixed)
+            out_specifier.precision = 6;
+        return true;
+    }
 
 public:
-    NODISCARD SHOOTER_API Optional<String> release_string();
+    virtual ~FormatBuilder() = default;
 
-    SHOOTER_API FormatErrorCode consume_until_format_specifier();
-    SHOOTER_API Optional<Specifier> parse_specifier();
-    static Optional<Specifier> parse_specifier(StringView specifier_string);
+    ALWAYS_INLINE void push_characters(const char* characters, usize byte_count)
+    {
+        if (m_byte_count + byte_count > m_capacity)
+        {
+            push_characters_slow(characters, byte_count);
+            return;
+        }
+
+        copy_memory(m_buffer + m_byte_count, characters, byte_count);
+        m_byte_count += byte_count;
+    }
 
     SHOOTER_API FormatErrorCode push_unsigned_integer(const Specifier& specifier, u64 value);
     SHOOTER_API FormatErrorCode push_signed_integer(const Specifier& specifier, i64 value);
-    SHOOTER_API FormatErrorCode push_string(const Specifier& specifier, StringView value);
+    SHOOTER_API FormatErrorCode push_floating_point(const Specifier& specifier, float value);
+    SHOOTER_API FormatErrorCode push_floating_point(const Specifier& specifier, double value);
+
+    ALWAYS_INLINE FormatErrorCode push_string(const Specifier& specifier, StringView value)
+    {
+        if (specifier.type != Specifier::Type::Default || specifier.zero_padding)
+            return FormatErrorCode::InvalidSpecifier;
+
+        push_characters(value.characters(), value.byte_count());
+        if (specifier.width > value.byte_count())
+            push_padding(' ', specifier.width - value.byte_count());
+        return FormatErrorCode::Success;
+    }
 
     template<typename T>
     requires (is_integral<T>)
@@ -63,9 +183,204 @@ public:
         }
     }
 
+    // The number of characters that didn't fit in the builder and were discarded.
+    NODISCARD ALWAYS_INLINE usize discarded_byte_count() const { return m_discarded_byte_count; }
+
+protected:
+    ALWAYS_INLINE FormatBuilder(char* buffer, usize capacity)
+        : m_buffer(buffer)
+        , m_byte_count(0)
+        , m_capacity(capacity)
+        , m_discarded_byte_count(0)
+    {}
+
+    //
+    // Invoked when the buffer is full, with the number of characters that still have to be written. The implementation
+    // must make room for at least one character, by growing or flushing the buffer, otherwise the characters are discarded.
+    //
+    virtual void on_buffer_full(usize required_byte_count) = 0;
+
+private:
+    SHOOTER_API void push_characters_slow(const char* characters, usize byte_count);
+    SHOOTER_API void push_padding(char padding_character, usize padding_count);
+
+    // Writes a number whose characters (excluding the sign) have already been generated, applying the width of the specifier.
+    void push_number(const Specifier& specifier, bool is_negative, const char* characters, usize byte_count);
+    template<typename T>
+    FormatErrorCode push_floating_point_impl(const Specifier& specifier, T value);
+
+protected:
+    char* m_buffer;
+    usize m_byte_count;
+    usize m_capacity;
+    usize m_discarded_byte_count;
+};
+
+//
+// Formats into a buffer that is stored inline, which is moved to the heap only if the formatted string doesn't fit in it.
+// Meant to be placed on the stack, so formatting doesn't allocate any memory in the common case.
+//
+template<usize InlineCapacity = 256>
+class FormatMemoryBuilder final : public FormatBuilder
+{
+public:
+    ALWAYS_INLINE FormatMemoryBuilder()
+        : FormatBuilder(m_inline_buffer, InlineCapacity)
+    {}
+
+    ALWAYS_INLINE virtual ~FormatMemoryBuilder() override
+    {
+        if (m_buffer != m_inline_buffer)
+            ::operator delete(m_buffer);
+    }
+
+    NODISCARD ALWAYS_INLINE StringView view() const { return StringView::unsafe_create_from_utf8(m_buffer, m_byte_count); }
+
+    // Only allocates memory if the formatted string doesn't fit in the inline capacity of a string.
+    NODISCARD ALWAYS_INLINE String release_string() const { return String(view()); }
+
+    ALWAYS_INLINE void clear() { m_byte_count = 0; }
+
+protected:
+    virtual void on_buffer_full(usize required_byte_count) override
+    {
+        const usize new_capacity = Math::max(m_capacity * 2, m_byte_count + required_byte_count);
+        char* new_buffer = static_cast<char*>(::operator new(new_capacity));
+        copy_memory(new_buffer, m_buffer, m_byte_count);
+
+        if (m_buffer != m_inline_buffer)
+            ::operator delete(m_buffer);
+        m_buffer = new_buffer;
+        m_capacity = new_capacity;
+    }
+
+private:
+    char m_inline_buffer[InlineCapacity];
+};
+
+//
+// Formats into a buffer provided by the caller, discarding the characters that don't fit in it.
+//
+class FormatFixedBuilder final : public FormatBuilder
+{
+public:
+    ALWAYS_INLINE explicit FormatFixedBuilder(Span<char> buffer)
+        : FormatBuilder(buffer.elements(), buffer.count())
+    {}
+
+    NODISCARD ALWAYS_INLINE StringView view() const { return StringView::unsafe_create_from_utf8(m_buffer, m_byte_count); }
+
+protected:
+    virtual void on_buffer_full(usize) override {}
+};
+
+//
+// Formats directly into a file, through a small inline buffer that is written to the file every time it fills up.
+// The remaining characters are written when the builder is destroyed (or when `flush` is called).
+//
+class FormatFileBuilder final : public FormatBuilder
+{
+public:
+    static constexpr usize buffer_capacity = 4 * KiB;
+
+public:
+    ALWAYS_INLINE explicit FormatFileBuilder(FileWriter& file_writer)
+        : FormatBuilder(m_inline_buffer, buffer_capacity)
+        , m_file_writer(file_writer)
+        , m_file_error(FileError::Success)
+    {}
+
+    ALWAYS_INLINE virtual ~FormatFileBuilder() override { flush(); }
+
+    SHOOTER_API void flush();
+
+    // The first error that occurred while writing to the file, if any.
+    NODISCARD ALWAYS_INLINE FileError file_error() const { return m_file_error; }
+
+protected:
+    virtual void on_buffer_full(usize) override { flush(); }
+
+private:
+    FileWriter& m_file_writer;
+    FileError m_file_error;
+    char m_inline_buffer[buffer_capacity];
+};
+
+namespace Detail
+{
+
+// NOTE: These functions are not constexpr on purpose. Calling them while evaluating a format string at compile time
+//       makes the compilation fail, and the name of the function shows up in the error message.
+void format_string_has_fewer_specifiers_than_arguments();
+void format_string_has_more_specifiers_than_arguments();
+void format_string_has_unterminated_specifier();
+void format_string_has_invalid_specifier();
+
+} // namespace Detail
+
+//
+// Format string that is validated and split at compile time. The literal text between the format specifiers and the
+// parsed specifiers are stored in the object, so formatting only has to copy the segments and the arguments.
+// The number of specifiers must match the number of arguments, otherwise the compilation fails.
+//
+template<typename... Args>
+class FormatString
+{
+public:
+    static constexpr usize argument_count = sizeof...(Args);
+
+    struct Segment
+    {
+        u32 offset;
+        u32 byte_count;
+    };
+
+public:
+    consteval FormatString(StringView string)
+        : m_characters(string.characters())
+    {
+        const usize byte_count = string.byte_count();
+        usize segment_offset = 0;
+        usize specifier_index = 0;
+
+        for (usize offset = 0; offset < byte_count; ++offset)
+        {
+            if (m_characters[offset] != '{')
+                continue;
+
+            if (specifier_index == argument_count)
+                Detail::format_string_has_more_specifiers_than_arguments();
+
+            usize specifier_end_offset = offset + 1;
+            while (specifier_end_offset < byte_count && m_characters[specifier_end_offset] != '}')
+                ++specifier_end_offset;
+            if (specifier_end_offset == byte_count)
+                Detail::format_string_has_unterminated_specifier();
+
+            const StringView specifier_string = StringView::unsafe_create_from_utf8(m_characters + offset + 1, specifier_end_offset - offset - 1);
+            if (!FormatBuilder::parse_specifier(specifier_string, m_specifiers[specifier_index]))
+                Detail::format_string_has_invalid_specifier();
+
+            m_segments[specifier_index] = { static_cast<u32>(segment_offset), static_cast<u32>(offset - segment_offset) };
+            segment_offset = specifier_end_offset + 1;
+            offset = specifier_end_offset;
+            ++specifier_index;
+        }
+
+        if (specifier_index != argument_count)
+            Detail::format_string_has_fewer_specifiers_than_arguments();
+        m_segments[argument_count] = { static_cast<u32>(segment_offset), static_cast<u32>(byte_count - segment_offset) };
+    }
+
+    // The literal text that precedes the argument with the given index. The index `argument_count` is the text after the last argument.
+    NODISCARD ALWAYS_INLINE const Segment& segment(usize index) const { return m_segments[index]; }
+    NODISCARD ALWAYS_INLINE const FormatBuilder::Specifier& specifier(usize index) const { return m_specifiers[index]; }
+    NODISCARD ALWAYS_INLINE const char* characters() const { return m_characters; }
+
 private:
-    StringView m_string_format;
-    Vector<char> m_formatted_string_buffer;
+    const char* m_characters;
+    Segment m_segments[argument_count + 1] = {};
+    FormatBuilder::Specifier m_specifiers[argument_count + 1] = {};
 };
 
 template<typename T>
@@ -96,9 +411,27 @@ struct Formatter<T>
 template<>
 struct Formatter<bool>
 {
-    ALWAYS_INLINE static FormatErrorCode format(FormatBuilder& builder, const FormatBuilder::Specifier&, const bool& value)
+    ALWAYS_INLINE static FormatErrorCode format(FormatBuilder& builder, const FormatBuilder::Specifier& specifier, const bool& value)
+    {
+        return builder.push_string(specifier, value ? "true"sv : "false"sv);
+    }
+};
+
+template<>
+struct Formatter<float>
+{
+    ALWAYS_INLINE static FormatErrorCode format(FormatBuilder& builder, const FormatBuilder::Specifier& specifier, const float& value)
     {
-        return builder.push_string({}, value ? "true"sv : "false"sv);
+        return builder.push_floating_point(specifier, value);
+    }
+};
+
+template<>
+struct Formatter<double>
+{
+    ALWAYS_INLINE static FormatErrorCode format(FormatBuilder& builder, const FormatBuilder::Specifier& specifier, const double& value)
+    {
+        return builder.push_floating_point(specifier, value);
     }
 };
 
@@ -120,6 +453,15 @@ struct Formatter<String>
     }
 };
 
+template<>
+struct Formatter<Name>
+{
+    ALWAYS_INLINE static FormatErrorCode format(FormatBuilder& builder, const FormatBuilder::Specifier& specifier, const Name& value)
+    {
+        return builder.push_string(specifier, value.view());
+    }
+};
+
 #define SE_INTEGER_FORMATTER_DECLARATION(type_name)                                                                                            \
     template<>                                                                                                                                 \
     struct Formatter<type_name>                                                                                                                \
@@ -147,73 +489,63 @@ struct Formatter<UUID>
 {
     ALWAYS_INLINE static FormatErrorCode format(FormatBuilder& builder, const FormatBuilder::Specifier& specifier, const UUID& value)
     {
-        // Because a UUID is only a 64-bit unsigned integer, we can be sure that it will
-        // fit in a 16-long character array (written in hexadecimal).
-        char uuid_buffer[16] = {};
-        set_memory(uuid_buffer, '0', 16);
-
+        // Because a UUID is only a 64-bit unsigned integer, it always fits in 16 hexadecimal digits.
+        char uuid_buffer[16];
         u64 uuid_value = value.value();
-        usize buffer_offset = 0;
-        while (uuid_value > 0)
-        {
-            const u8 digit = uuid_value % 16;
-            uuid_value /= 16;
-
-            if (digit <= 9)
-                uuid_buffer[buffer_offset++] = '0' + digit;
-            else
-                uuid_buffer[buffer_offset++] = 'A' + (digit - 10);
-        }
+        for (usize offset = sizeof(uuid_buffer); offset > 0; uuid_value >>= 4)
+            uuid_buffer[--offset] = "0123456789ABCDEF"[uuid_value & 0xF];
 
-        // Flip the modified characters.
-        for (usize offset = 0; offset < sizeof(uuid_buffer) / 2; ++offset)
-        {
-            const char temporary = uuid_buffer[offset];
-            uuid_buffer[offset] = uuid_buffer[sizeof(uuid_buffer) - offset - 1];
-            uuid_buffer[sizeof(uuid_buffer) - offset - 1] = temporary;
-        }
-
-        const StringView uuid_buffer_string_view = StringView::create_from_utf8(uuid_buffer, sizeof(uuid_buffer));
+        const StringView uuid_buffer_string_view = StringView::unsafe_create_from_utf8(uuid_buffer, sizeof(uuid_buffer));
         return builder.push_string(specifier, uuid_buffer_string_view);
     }
 };
 
-namespace Detail
-{
-
-NODISCARD ALWAYS_INLINE FormatErrorCode format(FormatBuilder& builder)
-{
-    return builder.consume_until_format_specifier();
-}
-
-template<typename T, typename... Args>
-NODISCARD ALWAYS_INLINE FormatErrorCode format(FormatBuilder& builder, const T& argument, Args&&... other_arguments)
+//
+// Formats the arguments directly into the given builder. Doesn't allocate any memory by itself, so formatting into a
+// builder that has enough capacity never allocates.
+//
+template<typename... Args>
+ALWAYS_INLINE FormatErrorCode format_to(FormatBuilder& builder, FormatString<TypeIdentity<Args>...> string_format, const Args&... args)
 {
-    FormatErrorCode error_code = builder.consume_until_format_specifier();
-    if (error_code != FormatErrorCode::Success)
-        return error_code;
+    FormatErrorCode error_code = FormatErrorCode::Success;
+    usize argument_index = 0;
 
-    Optional<FormatBuilder::Specifier> format_specifier = builder.parse_specifier();
-    if (!format_specifier.has_value())
-        return FormatErrorCode::InvalidSpecifier;
+    auto format_argument = [&]<typename T>(const T& argument)
+    {
+        const auto& segment = string_format.segment(argument_index);
+        builder.push_characters(string_format.characters() + segment.offset, segment.byte_count);
 
-    error_code = Formatter<T>::format(builder, format_specifier, argument);
-    if (error_code != FormatErrorCode::Success)
-        return error_code;
+        const FormatErrorCode argument_error_code = Formatter<T>::format(builder, string_format.specifier(argument_index), argument);
+        if (error_code == FormatErrorCode::Success)
+            error_code = argument_error_code;
+        ++argument_index;
+    };
+    (format_argument(args), ...);
 
-    return format(builder, forward<Args>(other_arguments)...);
+    const auto& last_segment = string_format.segment(sizeof...(Args));
+    builder.push_characters(string_format.characters() + last_segment.offset, last_segment.byte_count);
+    return error_code;
 }
 
-} // namespace Detail
-
+//
+// Formats the arguments into the given buffer and returns a view of the formatted characters. If the formatted string
+// doesn't fit in the buffer an empty optional is returned. No memory is allocated.
+//
 template<typename... Args>
-NODISCARD ALWAYS_INLINE Optional<String> format(StringView string_format, Args&&... args)
+NODISCARD ALWAYS_INLINE Optional<StringView> format_to(Span<char> buffer, FormatString<TypeIdentity<Args>...> string_format, const Args&... args)
 {
-    FormatBuilder builder = FormatBuilder(string_format);
-    FormatErrorCode error_code = Detail::format(builder, forward<Args>(args)...);
-    if (error_code != FormatErrorCode::Success)
+    FormatFixedBuilder builder = FormatFixedBuilder(buffer);
+    if (format_to(builder, string_format, args...) != FormatErrorCode::Success || builder.discarded_byte_count() > 0)
         return {};
+    return builder.view();
+}
 
+template<typename... Args>
+NODISCARD ALWAYS_INLINE Optional<String> format(FormatString<TypeIdentity<Args>...> string_format, const Args&... args)
+{
+    FormatMemoryBuilder builder;
+    if (format_to(builder, string_format, args...) != FormatErrorCode::Success)
+        return {};
     return builder.release_string();
 }
 
@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/Memory/MemoryOperations.h>
+#include <Core/String/Name.h>
+#include <Core/String/NameTable.h>
+
+namespace SE
+{
+
+NameTable::NameTable(PFN_HashFunction hash_function)
+    : m_hash_function(hash_function)
+{
+    // The entry with index zero is the empty name, which is never added to the hash map.
+    m_pages[0] = new NameEntry[entries_per_page];
+    m_pages[0][0] = { "", 0, 0, 0 };
+    m_entry_count = 1;
+}
+
+NameTable::~NameTable()
+{
+    for (NameEntry* page : m_pages)
+        delete[] page;
+    for (char* characters : m_character_allocations)
+        delete[] characters;
+}
+
+u32 NameTable::find_or_add(StringView string)
+{
+    if (string.is_empty())
+        return 0;
+
+    const u64 hash = m_hash_function(string);
+    ScopedLock lock(m_mutex);
+
+    const Optional<u32> existing_entry_index = find_locked(string, hash);
+    if (existing_entry_index.has_value())
+        return existing_entry_index.value();
+
+    const u32 entry_index = m_entry_count;
+    const u32 page_index = entry_index / entries_per_page;
+    SE_ASSERT(page_index < max_page_count);
+    if (m_pages[page_index] == nullptr)
+        m_pages[page_index] = new NameEntry[entries_per_page];
+
+    NameEntry& entry = m_pages[page_index][entry_index % entries_per_page];
+    entry.characters = copy_characters(string);
+    entry.byte_count = static_cast<u32>(string.byte_count());
+    entry.next_entry_index = 0;
+    entry.hash = hash;
+
+    // The new entry becomes the first entry of its hash chain.
+    Optional<u32&> first_entry_index = m_first_entry_indices.get_if_exists(hash);
+    if (first_entry_index.has_value())
+    {
+        entry.next_entry_index = first_entry_index.value();
+        first_entry_index.value() = entry_index;
+    }
+    else
+    {
+        m_first_entry_indices.add(hash, entry_index);
+    }
+
+    m_entry_count++;
+    return entry_index;
+}
+
+Optional<u32> NameTable::find(StringView string)
+{
+    if (string.is_empty())
+        return 0U;
+
+    const u64 hash = m_hash_function(string);
+    ScopedLock lock(m_mutex);
+    return find_locked(string, hash);
+}
+
+u32 NameTable::get_entry_count()
+{
+    ScopedLock lock(m_mutex);
+    return m_entry_count;
+}
+
+u64 NameTable::get_default_hash(StringView string)
+{
+    return hash_memory(string.byte_span());
+}
+
+Optional<u32> NameTable::find_locked(StringView string, u64 hash) const
+{
+    Optional<const u32&> first_entry_index = m_first_entry_indices.get_if_exists(hash);
+    if (!first_entry_index.has_value())
+        return {};
+
+    for (u32 entry_index = first_entry_index.value(); entry_index != 0;)
+    {
+        const NameEntry& entry = get_entry(entry_index);
+        if (entry.hash == hash && StringView::unsafe_create_from_utf8(entry.characters, entry.byte_count) == string)
+            return entry_index;
+        entry_index = entry.next_entry_index;
+    }
+
+    return {};
+}
+
+const char* NameTable::copy_characters(StringView string)
+{
+    const usize byte_count = string.byte_count() + 1;
+
+    // Strings that are larger than a block get their own allocation.
+    if (byte_count > character_block_byte_count / 4)
+    {
+        char* characters = new char[byte_count];
+        copy_memory_from_span(characters, string.byte_span());
+        characters[byte_count - 1] = 0;
+        m_character_allocations.add(characters);
+        return characters;
+    }
+
+    if (m_character_block == nullptr || m_character_block_offset + byte_count > character_block_byte_count)
+    {
+        m_character_block = new char[character_block_byte_count];
+        m_character_block_offset = 0;
+        m_character_allocations.add(m_character_block);
+    }
+
+    char* characters = m_character_block + m_character_block_offset;
+    copy_memory_from_span(characters, string.byte_span());
+    characters[byte_count - 1] = 0;
+    m_character_block_offset += byte_count;
+    return characters;
+}
+
+// NOTE: The table is created the first time it is used, so names can be created by static initializers. It is
+//       never destroyed, as names might still be used by static destructors.
+static NameTable& get_name_table()
+{
+    static NameTable* s_name_table = new NameTable();
+    return *s_name_table;
+}
+
+Name::Name(StringView string)
+    : m_index(get_name_table().find_or_add(string))
+{}
+
+Optional<Name> Name::find(StringView string)
+{
+    const Optional<u32> index = get_name_table().find(string);
+    if (!index.has_value())
+        return {};
+    return Name(index.value());
+}
+
+StringView Name::view() const
+{
+    const NameEntry& entry = get_name_table().get_entry(m_index);
+    return StringView::unsafe_create_from_utf8(entry.characters, entry.byte_count);
+}
+
+} // namespace SE
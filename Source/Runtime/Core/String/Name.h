@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/API.h>
+#include <Core/Containers/Hash.h>
+#include <Core/Containers/Optional.h>
+#include <Core/String/StringView.h>
+
+namespace SE
+{
+
+//
+// Interned string, stored as the index of its characters in a global table. Each distinct string is stored only once
+// and is never released, so two names are equal only if they have the same index, and comparing (or hashing) names
+// never has to access their characters. Meant for identifiers that are created once and compared often, such as the
+// names of the reflected components and fields, the inputs of render passes and the log tags.
+//
+// NOTE: Names can be created and accessed by any thread. Creating a name from a string requires locking the table,
+//       so names that are used repeatedly should be created only once, instead of every time they are used.
+//
+class Name
+{
+public:
+    // The default constructed name is the empty name.
+    ALWAYS_INLINE Name()
+        : m_index(0)
+    {}
+
+    SHOOTER_API Name(StringView string);
+
+    // Returns the name of the given string, but only if it has already been interned. The table is never modified.
+    NODISCARD SHOOTER_API static Optional<Name> find(StringView string);
+
+public:
+    NODISCARD SHOOTER_API StringView view() const;
+    // The characters of the name are always null-terminated, so they can be passed directly to C APIs.
+    NODISCARD ALWAYS_INLINE const char* characters() const { return view().characters(); }
+
+    NODISCARD ALWAYS_INLINE u32 index() const { return m_index; }
+    NODISCARD ALWAYS_INLINE bool is_empty() const { return (m_index == 0); }
+
+    NODISCARD ALWAYS_INLINE bool operator==(const Name& other) const { return (m_index == other.m_index); }
+    NODISCARD ALWAYS_INLINE bool operator!=(const Name& other) const { return (m_index != other.m_index); }
+
+private:
+    ALWAYS_INLINE explicit Name(u32 index)
+        : m_index(index)
+    {}
+
+private:
+    u32 m_index;
+};
+
+template<>
+struct Hasher<Name>
+{
+    NODISCARD ALWAYS_INLINE static u64 get_hash(const Name& value) { return Hasher<u64>::get_hash(value.index()); }
+};
+
+} // namespace SE
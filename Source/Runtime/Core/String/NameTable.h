@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/API.h>
+#include <Core/Containers/HashMap.h>
+#include <Core/Containers/Optional.h>
+#include <Core/Containers/Vector.h>
+#include <Core/Platform/Thread.h>
+#include <Core/String/StringView.h>
+
+namespace SE
+{
+
+struct NameEntry
+{
+    const char* characters;
+    u32 byte_count;
+    // The index of the next entry whose string has the same hash, or zero if there is none.
+    u32 next_entry_index;
+    u64 hash;
+};
+
+//
+// The table of interned strings that backs the `Name` type. Each distinct string is added only once, and the index of its
+// entry never changes. The entries are allocated in pages and the characters in blocks, which are never moved, so an
+// entry can be accessed without locking the table.
+// NOTE: Only the global table (which is never destroyed) is used by the names. Other tables are only created by tests.
+//
+class NameTable
+{
+    SE_MAKE_NONCOPYABLE(NameTable);
+    SE_MAKE_NONMOVABLE(NameTable);
+
+public:
+    static constexpr u32 entries_per_page = 4096;
+    static constexpr u32 max_page_count = 1024;
+
+    // The characters of the names are copied in blocks of this size. Strings larger than a quarter of a block get their own allocation.
+    static constexpr usize character_block_byte_count = 64 * KiB;
+
+    using PFN_HashFunction = u64 (*)(StringView string);
+
+public:
+    // The hash function can be replaced, so the tests can create strings with the same hash.
+    SHOOTER_API explicit NameTable(PFN_HashFunction hash_function = get_default_hash);
+    SHOOTER_API ~NameTable();
+
+    // Returns the index of the entry of the given string, which is added to the table if it doesn't exist yet.
+    NODISCARD SHOOTER_API u32 find_or_add(StringView string);
+    // Returns the index of the entry of the given string, but only if it exists. The table is never modified.
+    NODISCARD SHOOTER_API Optional<u32> find(StringView string);
+
+    NODISCARD ALWAYS_INLINE const NameEntry& get_entry(u32 index) const
+    {
+        SE_ASSERT(index / entries_per_page < max_page_count);
+        return m_pages[index / entries_per_page][index % entries_per_page];
+    }
+
+    // The number of entries in the table, including the entry of the empty string.
+    NODISCARD SHOOTER_API u32 get_entry_count();
+
+    NODISCARD SHOOTER_API static u64 get_default_hash(StringView string);
+
+private:
+    NODISCARD Optional<u32> find_locked(StringView string, u64 hash) const;
+    NODISCARD const char* copy_characters(StringView string);
+
+private:
+    PFN_HashFunction m_hash_function;
+    Mutex m_mutex;
+    NameEntry* m_pages[max_page_count] = {};
+    u32 m_entry_count { 0 };
+    // Maps the hash of a string to the index of the first entry with that hash.
+    HashMap<u64, u32> m_first_entry_indices;
+    char* m_character_block { nullptr };
+    usize m_character_block_offset { 0 };
+    // The character blocks and the strings that got their own allocation, released when the table is destroyed.
+    Vector<char*> m_character_allocations;
+};
+
+} // namespace SE
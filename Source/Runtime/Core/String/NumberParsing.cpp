@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/Assertions.h>
+#include <Core/String/NumberParsing.h>
+#include <charconv>
+
+namespace SE
+{
+
+NODISCARD ALWAYS_INLINE static u32 get_digit_value(char character)
+{
+    if ('0' <= character && character <= '9')
+        return static_cast<u32>(character - '0');
+    if ('a' <= character && character <= 'z')
+        return static_cast<u32>(character - 'a') + 10;
+    if ('A' <= character && character <= 'Z')
+        return static_cast<u32>(character - 'A') + 10;
+    // Greater than any valid base, so the character is rejected.
+    return 36;
+}
+
+bool parse_unsigned_integer(StringView string, u32 base, u64 max_value, u64& out_value)
+{
+    SE_ASSERT(2 <= base && base <= 36);
+    if (string.is_empty())
+        return false;
+
+    // The largest value that can be multiplied by the base without overflowing the maximum value.
+    const u64 max_value_before_digit = max_value / base;
+
+    u64 value = 0;
+    for (usize offset = 0; offset < string.byte_count(); ++offset)
+    {
+        const u32 digit_value = get_digit_value(string.characters()[offset]);
+        if (digit_value >= base)
+            return false;
+        if (value > max_value_before_digit)
+            return false;
+
+        value *= base;
+        if (digit_value > max_value - value)
+            return false;
+        value += digit_value;
+    }
+
+    out_value = value;
+    return true;
+}
+
+bool parse_signed_integer(StringView string, u32 base, i64 min_value, i64 max_value, i64& out_value)
+{
+    SE_ASSERT(min_value <= 0 && 0 <= max_value);
+    if (string.is_empty())
+        return false;
+
+    const char sign = string.characters()[0];
+    const bool is_negative = (sign == '-');
+    const usize sign_byte_count = (sign == '-' || sign == '+') ? 1 : 0;
+    const StringView digits = string.slice(sign_byte_count);
+
+    // NOTE: The magnitude of the minimum value can't be represented as a positive signed integer, so it is calculated
+    //       as `-(min_value + 1) + 1`.
+    const u64 max_magnitude = is_negative ? static_cast<u64>(-(min_value + 1)) + 1 : static_cast<u64>(max_value);
+    u64 magnitude;
+    if (!parse_unsigned_integer(digits, base, max_magnitude, magnitude))
+        return false;
+
+    if (is_negative)
+        out_value = (magnitude > 0) ? -static_cast<i64>(magnitude - 1) - 1 : 0;
+    else
+        out_value = static_cast<i64>(magnitude);
+    return true;
+}
+
+template<typename T>
+NODISCARD ALWAYS_INLINE static bool parse_floating_point_impl(StringView string, T& out_value)
+{
+    const char* begin = string.characters();
+    const char* end = begin + string.byte_count();
+
+    // NOTE: `std::from_chars` doesn't accept a leading '+' sign, but accepts "inf" and "nan", which aren't numbers.
+    if (begin != end && *begin == '+')
+    {
+        ++begin;
+        if (begin != end && *begin == '-')
+            return false;
+    }
+    const char* first_digit = (begin != end && *begin == '-') ? begin + 1 : begin;
+    if (first_digit == end || !(('0' <= *first_digit && *first_digit <= '9') || *first_digit == '.'))
+        return false;
+
+    T value;
+    const std::from_chars_result result = std::from_chars(begin, end, value, std::chars_format::general);
+    if (result.ec != std::errc() || result.ptr != end)
+        return false;
+
+    out_value = value;
+    return true;
+}
+
+bool parse_floating_point(StringView string, float& out_value)
+{
+    return parse_floating_point_impl(string, out_value);
+}
+
+bool parse_floating_point(StringView string, double& out_value)
+{
+    return parse_floating_point_impl(string, out_value);
+}
+
+} // namespace SE
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/API.h>
+#include <Core/CoreTypes.h>
+#include <Core/String/StringView.h>
+
+namespace SE
+{
+
+//
+// Parses an unsigned integer written in the given base (between 2 and 36, where the digits past 9 are letters of
+// either case). The whole string must be a number, without a sign, whitespace or a base prefix.
+// Returns false if the string isn't a number or if the value is greater than `max_value`, without modifying `out_value`.
+//
+NODISCARD SHOOTER_API bool parse_unsigned_integer(StringView string, u32 base, u64 max_value, u64& out_value);
+
+//
+// Parses a signed integer written in the given base, which can be preceded by a '+' or a '-' sign.
+// Returns false if the string isn't a number or if the value is outside of `[min_value, max_value]`, without modifying `out_value`.
+//
+NODISCARD SHOOTER_API bool parse_signed_integer(StringView string, u32 base, i64 min_value, i64 max_value, i64& out_value);
+
+template<typename T>
+requires (is_integral<T>)
+NODISCARD ALWAYS_INLINE bool parse_integer(StringView string, T& out_value, u32 base = 10)
+{
+    if constexpr (is_signed_integral<T>)
+    {
+        // NOTE: The minimum value of a two's complement signed integer is `-max_value - 1`.
+        constexpr i64 max_value = static_cast<i64>((static_cast<u64>(1) << (8 * sizeof(T) - 1)) - 1);
+        constexpr i64 min_value = -max_value - 1;
+
+        i64 value;
+        if (!parse_signed_integer(string, base, min_value, max_value, value))
+            return false;
+        out_value = static_cast<T>(value);
+        return true;
+    }
+    else
+    {
+        static_assert(is_unsigned_integral<T>);
+        constexpr u64 max_value = static_cast<T>(~static_cast<u64>(0));
+
+        u64 value;
+        if (!parse_unsigned_integer(string, base, max_value, value))
+            return false;
+        out_value = static_cast<T>(value);
+        return true;
+    }
+}
+
+//
+// Parses a decimal floating point value, in fixed or scientific notation, which can be preceded by a '+' or a '-' sign.
+// The value is correctly rounded, so the output of `get_shortest_decimal` is parsed back to exactly the same value.
+// Returns false if the string isn't a number or if the value is out of range, without modifying `out_value`.
+//
+NODISCARD SHOOTER_API bool parse_floating_point(StringView string, float& out_value);
+NODISCARD SHOOTER_API bool parse_floating_point(StringView string, double& out_value);
+
+} // namespace SE
@@ -3,8 +3,9 @@
  * SPDX-License-Identifier: Apache-2.0.
  */
 
-#include <Core/String/String.h>
+#include <Core/Math/MathCore.h>
 #include <Core/Memory/MemoryOperations.h>
+#include <Core/String/String.h>
 
 namespace SE
 {
@@ -23,8 +24,8 @@ String String::create_from_utf8(const char* null_terminated_characters)
 
 String::String()
 {
-    m_inline_buffer[0] = 0;
-    m_byte_count = 1;
+    m_inline.characters[0] = 0;
+    m_inline.byte_count = 1;
 }
 
 String::~String()
@@ -39,26 +40,18 @@ String::String(const String& other)
 }
 
 String::String(String&& other) noexcept
-    : m_heap_buffer(other.m_heap_buffer)
-    , m_byte_count(other.m_byte_count)
 {
-    other.m_inline_buffer[0] = 0;
-    other.m_byte_count = 1;
+    copy_memory(this, &other, sizeof(String));
+    other.m_inline.characters[0] = 0;
+    other.m_inline.byte_count = 1;
 }
 
 String::String(StringView string_view)
-    : m_byte_count(string_view.byte_span().count() + 1)
 {
-    char* destination_buffer = m_inline_buffer;
-
-    if (is_stored_on_heap())
-    {
-        m_heap_buffer = allocate_memory(m_byte_count);
-        destination_buffer = m_heap_buffer;
-    }
-
+    const usize byte_count = string_view.byte_span().count() + 1;
+    char* destination_buffer = initialize_storage(byte_count);
     copy_memory_from_span(destination_buffer, string_view.byte_span());
-    destination_buffer[m_byte_count - 1] = 0;
+    destination_buffer[byte_count - 1] = 0;
 }
 
 String& String::append(StringView view_to_append)
@@ -66,47 +59,48 @@ String& String::append(StringView view_to_append)
     if (view_to_append.is_empty())
         return *this;
 
-    const usize new_byte_count = m_byte_count + view_to_append.byte_span().count();
+    const usize old_byte_count = byte_count_with_null_termination();
+    const usize new_byte_count = old_byte_count + view_to_append.byte_span().count();
 
-    if (new_byte_count <= inline_capacity)
+    // NOTE: The appended view might point inside this string, so it is copied before the old heap buffer is released.
+    if (new_byte_count <= capacity())
     {
-        SE_DEBUG_ASSERT(m_byte_count > 0);
-        copy_memory_from_span(m_inline_buffer + m_byte_count - 1, view_to_append.byte_span());
-        m_byte_count = new_byte_count;
-        m_inline_buffer[m_byte_count - 1] = 0;
+        char* destination_buffer = get_storage();
+        copy_memory_from_span(destination_buffer + old_byte_count - 1, view_to_append.byte_span());
+        destination_buffer[new_byte_count - 1] = 0;
+        if (is_stored_inline())
+            m_inline.byte_count = static_cast<u8>(new_byte_count);
+        else
+            m_heap.byte_count = static_cast<u32>(new_byte_count);
         return *this;
     }
 
-    char* new_heap_buffer = allocate_memory(new_byte_count);
+    // The capacity grows geometrically, so appending repeatedly to a string only allocates memory a logarithmic number of times.
+    const usize new_capacity = Math::max(new_byte_count, capacity() + capacity() / 2);
+    char* new_heap_buffer = allocate_memory(new_capacity);
     copy_memory_from_span(new_heap_buffer, byte_span());
-    SE_DEBUG_ASSERT(m_byte_count > 0);
-    copy_memory_from_span(new_heap_buffer + m_byte_count - 1, view_to_append.byte_span());
+    copy_memory_from_span(new_heap_buffer + old_byte_count - 1, view_to_append.byte_span());
     new_heap_buffer[new_byte_count - 1] = 0;
 
     if (is_stored_on_heap())
-        release_memory(m_heap_buffer, m_byte_count);
+        release_memory(m_heap.characters, m_heap.capacity);
 
-    m_heap_buffer = new_heap_buffer;
-    m_byte_count = new_byte_count;
+    m_heap.characters = new_heap_buffer;
+    m_heap.byte_count = static_cast<u32>(new_byte_count);
+    m_heap.capacity = static_cast<u32>(new_capacity);
+    m_inline.byte_count = 0;
     return *this;
 }
 
 String String::operator+(StringView view_to_append) const
 {
-    String result;
-    result.m_byte_count = m_byte_count + view_to_append.byte_span().count();
-    char* destination_buffer = result.m_inline_buffer;
-
-    if (result.is_stored_on_heap())
-    {
-        result.m_heap_buffer = allocate_memory(result.m_byte_count);
-        destination_buffer = result.m_heap_buffer;
-    }
+    const usize result_byte_count = byte_count_with_null_termination() + view_to_append.byte_span().count();
 
+    String result;
+    char* destination_buffer = result.initialize_storage(result_byte_count);
     copy_memory_from_span(destination_buffer, byte_span());
-    SE_DEBUG_ASSERT(m_byte_count > 0);
-    copy_memory_from_span(destination_buffer + m_byte_count - 1, view_to_append.byte_span());
-    destination_buffer[result.m_byte_count - 1] = 0;
+    copy_memory_from_span(destination_buffer + byte_count(), view_to_append.byte_span());
+    destination_buffer[result_byte_count - 1] = 0;
 
     return result;
 }
@@ -114,10 +108,10 @@ String String::operator+(StringView view_to_append) const
 void String::clear()
 {
     if (is_stored_on_heap())
-        release_memory(m_heap_buffer, m_byte_count);
+        release_memory(m_heap.characters, m_heap.capacity);
 
-    m_byte_count = 1;
-    m_inline_buffer[0] = 0;
+    m_inline.characters[0] = 0;
+    m_inline.byte_count = 1;
 }
 
 StringView String::path_parent() const
@@ -172,58 +166,73 @@ String& String::operator=(const String& other)
 
 String& String::operator=(String&& other) noexcept
 {
-    if (is_stored_on_heap())
-        release_memory(m_heap_buffer, m_byte_count);
+    if (this == &other)
+        return *this;
 
-    m_heap_buffer = other.m_heap_buffer;
-    m_byte_count = other.m_byte_count;
+    if (is_stored_on_heap())
+        release_memory(m_heap.characters, m_heap.capacity);
 
-    zero_memory(other.m_inline_buffer, inline_capacity);
-    other.m_inline_buffer[0] = 0;
-    other.m_byte_count = 1;
+    copy_memory(this, &other, sizeof(String));
+    other.m_inline.characters[0] = 0;
+    other.m_inline.byte_count = 1;
 
     return *this;
 }
 
 String& String::operator=(StringView string_view)
 {
-    usize byte_count = string_view.byte_span().count() + 1;
-    char* destination_buffer = m_inline_buffer;
+    const usize byte_count = string_view.byte_span().count() + 1;
 
-    if (is_stored_inline())
+    // The characters of the view might be stored in this string, in which case they can't be overwritten in-place.
+    const char* storage = get_storage();
+    if (string_view.characters() < storage + byte_count_with_null_termination() && storage < string_view.characters() + byte_count)
     {
-        if (byte_count > inline_capacity)
-        {
-            m_heap_buffer = allocate_memory(byte_count);
-            destination_buffer = m_heap_buffer;
-        }
+        *this = String(string_view);
+        return *this;
     }
-    else
+
+    // The heap buffer is reused if the new string fits in it, as the string has already grown this large once.
+    if (byte_count > capacity())
     {
-        if (byte_count <= inline_capacity)
-        {
-            release_memory(m_heap_buffer, m_byte_count);
-        }
-        else
-        {
-            if (m_byte_count != byte_count)
-            {
-                release_memory(m_heap_buffer, m_byte_count);
-                m_heap_buffer = allocate_memory(byte_count);
-            }
-            destination_buffer = m_heap_buffer;
-        }
+        clear();
+        char* destination_buffer = initialize_storage(byte_count);
+        copy_memory_from_span(destination_buffer, string_view.byte_span());
+        destination_buffer[byte_count - 1] = 0;
+        return *this;
     }
 
-    m_byte_count = byte_count;
+    char* destination_buffer = get_storage();
     copy_memory_from_span(destination_buffer, string_view.byte_span());
-    destination_buffer[m_byte_count - 1] = 0;
+    destination_buffer[byte_count - 1] = 0;
+    if (is_stored_inline())
+        m_inline.byte_count = static_cast<u8>(byte_count);
+    else
+        m_heap.byte_count = static_cast<u32>(byte_count);
 
     return *this;
 }
 
+char* String::initialize_storage(usize byte_count)
+{
+    SE_ASSERT(byte_count > 0);
+
+    if (byte_count <= inline_capacity)
+    {
+        m_inline.byte_count = static_cast<u8>(byte_count);
+        return m_inline.characters;
+    }
+
+    m_heap.characters = allocate_memory(byte_count);
+    m_heap.byte_count = static_cast<u32>(byte_count);
+    m_heap.capacity = static_cast<u32>(byte_count);
+    m_inline.byte_count = 0;
+    return m_heap.characters;
+}
+
 char* String::allocate_memory(usize byte_count)
 {
+    // The byte count and capacity of the strings stored on the heap are 32-bit values.
+    SE_ASSERT(byte_count <= static_cast<usize>(0xFFFFFFFF));
     void* memory_block = ::operator new(byte_count);
     SE_ASSERT(memory_block);
     return reinterpret_cast<char*>(memory_block);
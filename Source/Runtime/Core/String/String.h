@@ -17,17 +17,18 @@ namespace SE
 
 //
 // Container that stores a UTF-8 encoded, null-terminated string.
-// If the string is small enough, the threshold being determined by the platform
-// architecture, no memory will be allocated from the heap and the characters will
-// be instead stored inline. This allows small strings to be very efficient in terms
-// of performance, as copying and creating them would be very cheap.
+// If the string is small enough no memory will be allocated from the heap and the characters will be instead stored
+// inline, in the same memory that holds the heap buffer pointer, byte count and capacity of a large string. This allows
+// small strings (most names and filepaths) to be very efficient in terms of performance, as copying and creating them
+// would be very cheap. Strings that are stored on the heap grow geometrically when appended to.
 //
 class String
 {
     friend class StringBuilder;
 
 public:
-    static constexpr usize inline_capacity = sizeof(char*);
+    // The maximum number of bytes (including the null termination character) that can be stored inline.
+    static constexpr usize inline_capacity = 3 * sizeof(char*) - 1;
     static_assert(inline_capacity > 0);
 
 public:
@@ -57,65 +58,59 @@ public:
 
     NODISCARD ALWAYS_INLINE ReadonlyByteSpan byte_span()
     {
-        SE_ASSERT(m_byte_count > 0);
-        auto* bytes = reinterpret_cast<ReadWriteBytes>(is_stored_inline() ? m_inline_buffer : m_heap_buffer);
-        return ReadonlyByteSpan(bytes, m_byte_count - 1);
+        auto* bytes = reinterpret_cast<ReadWriteBytes>(get_storage());
+        return ReadonlyByteSpan(bytes, byte_count());
     }
 
     NODISCARD ALWAYS_INLINE ReadonlyByteSpan byte_span() const
     {
-        SE_ASSERT(m_byte_count > 0);
-        const auto* bytes = reinterpret_cast<ReadonlyBytes>(is_stored_inline() ? m_inline_buffer : m_heap_buffer);
-        return ReadonlyByteSpan(bytes, m_byte_count - 1);
+        const auto* bytes = reinterpret_cast<ReadonlyBytes>(get_storage());
+        return ReadonlyByteSpan(bytes, byte_count());
     }
 
     NODISCARD ALWAYS_INLINE ReadonlyByteSpan readonly_byte_span()
     {
-        SE_ASSERT(m_byte_count > 0);
-        const auto* bytes = reinterpret_cast<ReadonlyBytes>(is_stored_inline() ? m_inline_buffer : m_heap_buffer);
-        return ReadonlyByteSpan(bytes, m_byte_count - 1);
+        const auto* bytes = reinterpret_cast<ReadonlyBytes>(get_storage());
+        return ReadonlyByteSpan(bytes, byte_count());
     }
 
     NODISCARD ALWAYS_INLINE ReadonlyByteSpan byte_span_with_null_termination()
     {
-        SE_ASSERT(m_byte_count > 0);
-        auto* bytes = reinterpret_cast<ReadWriteBytes>(is_stored_inline() ? m_inline_buffer : m_heap_buffer);
-        return ReadonlyByteSpan(bytes, m_byte_count);
+        auto* bytes = reinterpret_cast<ReadWriteBytes>(get_storage());
+        return ReadonlyByteSpan(bytes, byte_count_with_null_termination());
     }
 
     NODISCARD ALWAYS_INLINE ReadonlyByteSpan byte_span_with_null_termination() const
     {
-        SE_ASSERT(m_byte_count > 0);
-        const auto* bytes = reinterpret_cast<ReadonlyBytes>(is_stored_inline() ? m_inline_buffer : m_heap_buffer);
-        return ReadonlyByteSpan(bytes, m_byte_count);
+        const auto* bytes = reinterpret_cast<ReadonlyBytes>(get_storage());
+        return ReadonlyByteSpan(bytes, byte_count_with_null_termination());
     }
 
     NODISCARD ALWAYS_INLINE ReadonlyByteSpan readonly_byte_span_with_null_termination()
     {
-        SE_ASSERT(m_byte_count > 0);
-        const auto* bytes = reinterpret_cast<ReadonlyBytes>(is_stored_inline() ? m_inline_buffer : m_heap_buffer);
-        return ReadonlyByteSpan(bytes, m_byte_count);
+        const auto* bytes = reinterpret_cast<ReadonlyBytes>(get_storage());
+        return ReadonlyByteSpan(bytes, byte_count_with_null_termination());
     }
 
     // This function is not recommended for general use. It is only meant to be used for communication with C APIs.
     NODISCARD ALWAYS_INLINE const char* characters() const { return byte_span_with_null_termination().as<const char>().elements(); }
 
-    NODISCARD ALWAYS_INLINE usize byte_count() const
-    {
-        SE_ASSERT(m_byte_count > 0);
-        return (m_byte_count - 1);
-    }
+    NODISCARD ALWAYS_INLINE usize byte_count() const { return (byte_count_with_null_termination() - 1); }
 
     NODISCARD ALWAYS_INLINE usize byte_count_with_null_termination() const
     {
-        SE_ASSERT(m_byte_count > 0);
-        return m_byte_count;
+        const usize byte_count = is_stored_inline() ? m_inline.byte_count : m_heap.byte_count;
+        SE_ASSERT(byte_count > 0);
+        return byte_count;
     }
 
-    NODISCARD ALWAYS_INLINE bool is_empty() const { return (m_byte_count <= 1); }
+    NODISCARD ALWAYS_INLINE bool is_empty() const { return (byte_count_with_null_termination() <= 1); }
+
+    NODISCARD ALWAYS_INLINE bool is_stored_inline() const { return (m_inline.byte_count != 0); }
+    NODISCARD ALWAYS_INLINE bool is_stored_on_heap() const { return (m_inline.byte_count == 0); }
 
-    NODISCARD ALWAYS_INLINE bool is_stored_inline() const { return m_byte_count <= inline_capacity; }
-    NODISCARD ALWAYS_INLINE bool is_stored_on_heap() const { return m_byte_count > inline_capacity; }
+    // The number of bytes (including the null termination character) that can be stored without allocating memory.
+    NODISCARD ALWAYS_INLINE usize capacity() const { return is_stored_inline() ? inline_capacity : m_heap.capacity; }
 
 public:
     NODISCARD SHOOTER_API String& append(StringView view_to_append);
@@ -140,16 +135,44 @@ public:
     NODISCARD ALWAYS_INLINE bool operator!=(StringView string_view) const { return (view() != string_view); }
 
 private:
+    NODISCARD ALWAYS_INLINE char* get_storage() { return is_stored_inline() ? m_inline.characters : m_heap.characters; }
+    NODISCARD ALWAYS_INLINE const char* get_storage() const { return is_stored_inline() ? m_inline.characters : m_heap.characters; }
+
+    //
+    // Prepares the storage for the given number of bytes (including the null termination character) and returns the buffer
+    // where the characters must be written, including the null termination character. The current storage is not released,
+    // so the string must be either empty or not constructed yet.
+    //
+    NODISCARD char* initialize_storage(usize byte_count);
+
     NODISCARD static char* allocate_memory(usize byte_count);
     static void release_memory(char* heap_buffer, usize byte_count);
 
 private:
+    struct InlineStorage
+    {
+        char characters[inline_capacity];
+        // The number of bytes (including the null termination character) of the string if it is stored inline, or zero
+        // if the string is stored on the heap.
+        u8 byte_count;
+    };
+
+    struct HeapStorage
+    {
+        char* characters;
+        // NOTE: The byte count and capacity of a string stored on the heap are 32-bit values, so that they fit
+        //       next to the pointer without overlapping the byte count of the inline storage.
+        u32 byte_count;
+        u32 capacity;
+    };
+
     union
     {
-        char m_inline_buffer[inline_capacity];
-        char* m_heap_buffer;
+        InlineStorage m_inline;
+        HeapStorage m_heap;
     };
-    usize m_byte_count;
 };
 
+static_assert(sizeof(String) == 3 * sizeof(char*));
+
 } // namespace SE
@@ -5,10 +5,121 @@
 
 #include <Core/String/StringBuilder.h>
 #include <Core/Memory/MemoryOperations.h>
+#include <Core/String/Utf8.h>
 
 namespace SE
 {
 
+StringBuilder::StringBuilder()
+    : FormatBuilder(nullptr, 0)
+{}
+
+StringBuilder::StringBuilder(usize reserved_byte_count)
+    : FormatBuilder(nullptr, 0)
+{
+    reserve(reserved_byte_count);
+}
+
+StringBuilder::~StringBuilder()
+{
+    // NOTE: The capacity of the builder doesn't include the null termination character, while the size of the buffer does.
+    if (m_buffer)
+        String::release_memory(m_buffer, m_capacity + 1);
+}
+
+void StringBuilder::reserve(usize byte_count)
+{
+    if (byte_count > m_capacity)
+        reallocate_buffer(byte_count);
+}
+
+String StringBuilder::release_string()
+{
+    String result;
+    if (m_byte_count + 1 <= String::inline_capacity)
+    {
+        char* destination_buffer = result.initialize_storage(m_byte_count + 1);
+        copy_memory(destination_buffer, m_buffer, m_byte_count);
+        destination_buffer[m_byte_count] = 0;
+        m_byte_count = 0;
+        return result;
+    }
+
+    // The capacity of the builder always leaves room for the null termination character.
+    m_buffer[m_byte_count] = 0;
+    result.m_heap.characters = m_buffer;
+    result.m_heap.byte_count = static_cast<u32>(m_byte_count + 1);
+    result.m_heap.capacity = static_cast<u32>(m_capacity + 1);
+    result.m_inline.byte_count = 0;
+
+    m_buffer = nullptr;
+    m_byte_count = 0;
+    m_capacity = 0;
+    return result;
+}
+
+StringBuilder& StringBuilder::append_codepoint(UnicodeCodepoint codepoint)
+{
+    ReadWriteByte encoded_codepoint[4];
+    const usize codepoint_width = UTF8::bytes_from_codepoint(codepoint, { encoded_codepoint, sizeof(encoded_codepoint) });
+    push_characters(reinterpret_cast<const char*>(encoded_codepoint), codepoint_width);
+    return *this;
+}
+
+StringBuilder& StringBuilder::append_path(StringView path)
+{
+    const char* characters = path.characters();
+    const usize byte_count = path.byte_count();
+
+    // The characters are copied in runs that don't contain any delimitation character, so most paths are copied at once.
+    bool last_character_is_path_delimitator = (m_byte_count == 0) || (m_buffer[m_byte_count - 1] == SE_FILEPATH_DELIMITATOR);
+    usize offset = 0;
+    while (offset < byte_count)
+    {
+        if (characters[offset] == SE_FILEPATH_DELIMITATOR || characters[offset] == '\\')
+        {
+            // A path that starts with a delimitation character is only absolute if nothing was appended before it.
+            if (!last_character_is_path_delimitator || m_byte_count == 0)
+                append(SE_FILEPATH_DELIMITATOR);
+            last_character_is_path_delimitator = true;
+            ++offset;
+            continue;
+        }
+
+        if (!last_character_is_path_delimitator)
+            append(SE_FILEPATH_DELIMITATOR);
+
+        usize run_end_offset = offset;
+        while (run_end_offset < byte_count && characters[run_end_offset] != SE_FILEPATH_DELIMITATOR && characters[run_end_offset] != '\\')
+            ++run_end_offset;
+
+        push_characters(characters + offset, run_end_offset - offset);
+        last_character_is_path_delimitator = false;
+        offset = run_end_offset;
+    }
+
+    return *this;
+}
+
+void StringBuilder::on_buffer_full(usize required_byte_count)
+{
+    // The capacity grows geometrically, in the same way as the capacity of a string.
+    reallocate_buffer(Math::max(m_byte_count + required_byte_count, m_capacity + m_capacity / 2));
+}
+
+void StringBuilder::reallocate_buffer(usize new_capacity)
+{
+    char* new_buffer = String::allocate_memory(new_capacity + 1);
+    if (m_buffer)
+    {
+        copy_memory(new_buffer, m_buffer, m_byte_count);
+        String::release_memory(m_buffer, m_capacity + 1);
+    }
+
+    m_buffer = new_buffer;
+    m_capacity = new_capacity;
+}
+
 String StringBuilder::join(std::initializer_list<StringView> views_list)
 {
     usize result_byte_count = 0;
@@ -17,14 +128,7 @@ String StringBuilder::join(std::initializer_list<StringView> views_list)
     result_byte_count += sizeof('\0');
 
     String result;
-    result.m_byte_count = result_byte_count;
-    char* destination_buffer = result.m_inline_buffer;
-
-    if (result.is_stored_on_heap())
-    {
-        result.m_heap_buffer = String::allocate_memory(result.m_byte_count);
-        destination_buffer = result.m_heap_buffer;
-    }
+    char* destination_buffer = result.initialize_storage(result_byte_count);
 
     usize byte_offset = 0;
     for (StringView view : views_list)
@@ -32,7 +136,7 @@ String StringBuilder::join(std::initializer_list<StringView> views_list)
         copy_memory_from_span(destination_buffer + byte_offset, view.byte_span());
         byte_offset += view.byte_span().count();
     }
-    destination_buffer[result.m_byte_count - 1] = 0;
+    destination_buffer[result_byte_count - 1] = 0;
 
     return result;
 }
@@ -57,14 +161,7 @@ String StringBuilder::path_join(std::initializer_list<StringView> paths_list)
     result_byte_count += sizeof('\0');
 
     String result;
-    result.m_byte_count = result_byte_count;
-    char* destination_buffer = result.m_inline_buffer;
-
-    if (result.is_stored_on_heap())
-    {
-        result.m_heap_buffer = String::allocate_memory(result.m_byte_count);
-        destination_buffer = result.m_heap_buffer;
-    }
+    char* destination_buffer = result.initialize_storage(result_byte_count);
 
     usize byte_offset = 0;
     last_character_is_path_delimitator = true;
@@ -86,7 +183,7 @@ String StringBuilder::path_join(std::initializer_list<StringView> paths_list)
         byte_offset += path.byte_span().count();
     }
 
-    destination_buffer[result.m_byte_count - 1] = 0;
+    destination_buffer[result_byte_count - 1] = 0;
     return result;
 }
 
@@ -97,7 +194,7 @@ String StringBuilder::path_generic(StringView path)
     char* result_characters = result.byte_span().as<char>().elements();
     usize result_byte_offset = 0;
 
-    while (result_byte_offset < result.m_byte_count)
+    while (result_byte_offset < result.byte_count())
     {
         if (result_characters[result_byte_offset] == '\\')
             result_characters[result_byte_offset] = '/';
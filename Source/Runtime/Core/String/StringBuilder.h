@@ -5,14 +5,89 @@
 
 #pragma once
 
+#include <Core/String/Format.h>
 #include <Core/String/String.h>
 #include <initializer_list>
 
 namespace SE
 {
 
-class StringBuilder
+//
+// Builds a string by appending to a buffer that grows geometrically. The buffer is allocated in the same way as the heap
+// storage of a `String`, so `release_string` transfers it to the string without copying the characters. The builder is
+// also a `FormatBuilder`, so the arguments of a format string can be written directly into it with `format_to`.
+//
+class StringBuilder final : public FormatBuilder
 {
+public:
+    // No memory is allocated until the first character is appended.
+    SHOOTER_API StringBuilder();
+    SHOOTER_API explicit StringBuilder(usize reserved_byte_count);
+    SHOOTER_API virtual ~StringBuilder() override;
+
+    // Makes sure that the builder can store the given number of bytes (excluding the null termination character) without growing.
+    SHOOTER_API void reserve(usize byte_count);
+
+    NODISCARD ALWAYS_INLINE usize byte_count() const { return m_byte_count; }
+    NODISCARD ALWAYS_INLINE bool is_empty() const { return (m_byte_count == 0); }
+    NODISCARD ALWAYS_INLINE StringView view() const { return StringView::unsafe_create_from_utf8(m_buffer, m_byte_count); }
+
+    // The buffer is kept, so the builder can be reused without allocating memory again.
+    ALWAYS_INLINE void clear() { m_byte_count = 0; }
+
+    //
+    // Transfers the buffer to a string and leaves the builder empty. Strings that fit in the inline storage of a `String`
+    // are copied instead, in which case the builder keeps its buffer.
+    //
+    NODISCARD SHOOTER_API String release_string();
+
+public:
+    ALWAYS_INLINE StringBuilder& append(StringView view)
+    {
+        push_characters(view.characters(), view.byte_count());
+        return *this;
+    }
+
+    ALWAYS_INLINE StringBuilder& append(const String& string) { return append(string.view()); }
+
+    ALWAYS_INLINE StringBuilder& append(char ascii_character)
+    {
+        push_characters(&ascii_character, sizeof(char));
+        return *this;
+    }
+
+    // Invalid codepoints are not appended.
+    SHOOTER_API StringBuilder& append_codepoint(UnicodeCodepoint codepoint);
+
+    // NOTE: Numbers are appended as they are formatted by `{}`, which never fails.
+    template<typename T>
+    requires (is_integral<T>)
+    ALWAYS_INLINE StringBuilder& append_integer(T value)
+    {
+        push_integer(Specifier(), value);
+        return *this;
+    }
+
+    // Appended in the shortest representation that round-trips.
+    ALWAYS_INLINE StringBuilder& append_floating_point(float value)
+    {
+        push_floating_point(Specifier(), value);
+        return *this;
+    }
+
+    ALWAYS_INLINE StringBuilder& append_floating_point(double value)
+    {
+        push_floating_point(Specifier(), value);
+        return *this;
+    }
+
+    //
+    // Appends a component of a filepath, separated from the previous characters by exactly one path delimitation character.
+    // The path is normalized while it is appended: backslashes are converted to the path delimitation character, and
+    // consecutive delimitation characters are collapsed into one.
+    //
+    SHOOTER_API StringBuilder& append_path(StringView path);
+
 public:
     NODISCARD SHOOTER_API static String join(std::initializer_list<StringView> views_list);
 
@@ -22,6 +97,13 @@ public: // Filepath API.
 
     // Returns a platform-independent filepath, equivalent with the given path.
     SHOOTER_API static String path_generic(StringView path);
+
+protected:
+    virtual void on_buffer_full(usize required_byte_count) override;
+
+private:
+    // Replaces the buffer with one that can store the given number of bytes, plus the null termination character.
+    void reallocate_buffer(usize new_capacity);
 };
 
 } // namespace SE
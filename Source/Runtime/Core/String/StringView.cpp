@@ -3,6 +3,7 @@
  * SPDX-License-Identifier: Apache-2.0.
  */
 
+#include <Core/Memory/MemoryOperations.h>
 #include <Core/String/StringView.h>
 #include <Core/String/Utf8.h>
 
@@ -11,8 +12,11 @@ namespace SE
 
 StringView StringView::create_from_utf8(const char* characters, usize byte_count)
 {
+#if SE_ASSERTION_ENABLE_ASSERT
+    // NOTE: The validity is only used by the assertion, so the string is not validated when the assertions are disabled.
     MAYBE_UNUSED bool validity = UTF8::check_validity({ reinterpret_cast<ReadonlyBytes>(characters), byte_count });
     SE_ASSERT(validity);
+#endif // SE_ASSERTION_ENABLE_ASSERT
 
     return unsafe_create_from_utf8(characters, byte_count);
 }
@@ -33,31 +37,34 @@ StringView StringView::create_from_utf8(const char* null_terminated_characters)
 
 usize StringView::find(char ascii_character) const
 {
-    for (usize offset = 0; offset < m_byte_count; ++offset)
-    {
-        if (m_characters[offset] == ascii_character)
-        {
-            return offset;
-        }
-    }
-
-    return invalid_position;
+    return find_byte(m_characters, static_cast<ReadWriteByte>(ascii_character), m_byte_count);
 }
 
 usize StringView::find(UnicodeCodepoint codepoint_to_find) const
 {
+    ReadWriteByte encoded_codepoint[4];
+    const usize codepoint_width = UTF8::bytes_from_codepoint(codepoint_to_find, { encoded_codepoint, sizeof(encoded_codepoint) });
+    if (codepoint_width == 0)
+        return invalid_position;
+
+    //
+    // NOTE: A leading byte of a UTF-8 sequence can never be mistaken for a continuation byte, so the codepoint is found
+    //       by searching for its encoded bytes, without decoding the codepoints that precede it.
+    //
     usize offset = 0;
-    while (offset < m_byte_count)
+    while (offset + codepoint_width <= m_byte_count)
     {
-        usize codepoint_width;
-        UnicodeCodepoint codepoint = UTF8::bytes_to_codepoint(byte_span().slice(offset), codepoint_width);
-        SE_ASSERT(codepoint != invalid_unicode_codepoint);
-
-        if (codepoint == codepoint_to_find)
-        {
+        const usize match_offset = find_byte(m_characters + offset, encoded_codepoint[0], m_byte_count - offset - codepoint_width + 1);
+        if (match_offset == invalid_size)
+            return invalid_position;
+        offset += match_offset;
+
+        usize byte_index = 1;
+        while (byte_index < codepoint_width && static_cast<ReadWriteByte>(m_characters[offset + byte_index]) == encoded_codepoint[byte_index])
+            ++byte_index;
+        if (byte_index == codepoint_width)
             return offset;
-        }
-        offset += codepoint_width;
+        ++offset;
     }
 
     return invalid_position;
@@ -65,14 +72,7 @@ usize StringView::find(UnicodeCodepoint codepoint_to_find) const
 
 usize StringView::find_last(char ascii_character) const
 {
-    ReadonlyByteSpan span = byte_span();
-    for (auto byte_it = span.rbegin(); byte_it != span.rend(); --byte_it)
-    {
-        if (*byte_it == ascii_character)
-            return (byte_it - span.begin());
-    }
-
-    return invalid_size;
+    return find_last_byte(m_characters, static_cast<ReadWriteByte>(ascii_character), m_byte_count);
 }
 
 StringView StringView::slice(usize offset_in_bytes) const
@@ -4,6 +4,11 @@
  */
 
 #include <Core/String/Utf8.h>
+#include <bit>
+
+#if SE_SIMD_SSE2
+    #include <emmintrin.h>
+#endif // SE_SIMD_SSE2
 
 namespace SE
 {
@@ -47,7 +52,7 @@ UnicodeCodepoint UTF8::bytes_to_codepoint(ReadonlyByteSpan byte_span, usize& out
         }
 
         UnicodeCodepoint codepoint = 0;
-        codepoint += (byte_span.elements()[0] & 0x1F) << 12;
+        codepoint += (byte_span.elements()[0] & 0x0F) << 12;
         codepoint += (byte_span.elements()[1] & 0x3F) << 6;
         codepoint += (byte_span.elements()[2] & 0x3F) << 0;
 
@@ -64,7 +69,7 @@ UnicodeCodepoint UTF8::bytes_to_codepoint(ReadonlyByteSpan byte_span, usize& out
         }
 
         UnicodeCodepoint codepoint = 0;
-        codepoint += (byte_span.elements()[0] & 0x1F) << 18;
+        codepoint += (byte_span.elements()[0] & 0x07) << 18;
         codepoint += (byte_span.elements()[1] & 0x3F) << 12;
         codepoint += (byte_span.elements()[2] & 0x3F) << 6;
         codepoint += (byte_span.elements()[3] & 0x3F) << 0;
@@ -166,22 +171,115 @@ usize UTF8::codepoint_width(UnicodeCodepoint codepoint)
     return 0;
 }
 
-usize UTF8::length(ReadonlyByteSpan byte_span)
+//
+// Validates the codepoint that starts with the given non-ASCII byte, and returns its width in bytes (or zero if the
+// codepoint is not valid). Overlong encodings, surrogates and codepoints above U+10FFFF are all rejected.
+//
+NODISCARD static usize get_valid_multibyte_codepoint_width(ReadonlyBytes bytes, usize byte_count)
+{
+    const auto is_continuation_byte = [](ReadWriteByte byte) -> bool { return ((byte & 0xC0) == 0x80); };
+    const ReadWriteByte leading_byte = bytes[0];
+
+    if (leading_byte >= 0xC2 && leading_byte <= 0xDF)
+    {
+        if (byte_count < 2 || !is_continuation_byte(bytes[1]))
+            return 0;
+        return 2;
+    }
+
+    if (leading_byte >= 0xE0 && leading_byte <= 0xEF)
+    {
+        // NOTE: The range of the second byte excludes the overlong encodings (after 0xE0) and the surrogates (after 0xED).
+        const ReadWriteByte min_second_byte = (leading_byte == 0xE0) ? 0xA0 : 0x80;
+        const ReadWriteByte max_second_byte = (leading_byte == 0xED) ? 0x9F : 0xBF;
+        if (byte_count < 3 || bytes[1] < min_second_byte || bytes[1] > max_second_byte || !is_continuation_byte(bytes[2]))
+            return 0;
+        return 3;
+    }
+
+    if (leading_byte >= 0xF0 && leading_byte <= 0xF4)
+    {
+        // NOTE: The range of the second byte excludes the overlong encodings (after 0xF0) and the codepoints above U+10FFFF (after 0xF4).
+        const ReadWriteByte min_second_byte = (leading_byte == 0xF0) ? 0x90 : 0x80;
+        const ReadWriteByte max_second_byte = (leading_byte == 0xF4) ? 0x8F : 0xBF;
+        if (byte_count < 4 || bytes[1] < min_second_byte || bytes[1] > max_second_byte || !is_continuation_byte(bytes[2]) ||
+            !is_continuation_byte(bytes[3]))
+        {
+            return 0;
+        }
+        return 4;
+    }
+
+    return 0;
+}
+
+//
+// Validates the UTF-8 byte sequence and counts its codepoints. Blocks of 32 ASCII bytes are validated with a single
+// comparison when the architecture allows it, so only the blocks that contain other characters are decoded.
+//
+NODISCARD static bool validate_and_count_codepoints(ReadonlyByteSpan byte_span, usize& out_codepoint_count)
 {
-    usize len = 0;
+    ReadonlyBytes bytes = byte_span.elements();
+    const usize byte_count = byte_span.count();
     usize byte_offset = 0;
+    usize codepoint_count = 0;
 
-    while (byte_offset < byte_span.count())
+    while (byte_offset < byte_count)
     {
-        usize codepoint_width = bytes_to_codepoint_width(byte_span.slice(byte_offset));
-        if (codepoint_width == 0)
-            return invalid_size;
+        // The bytes before this offset are decoded one codepoint at a time.
+        usize scalar_end_offset = byte_count;
+
+#if SE_SIMD_SSE2
+        if (byte_offset + 32 <= byte_count)
+        {
+            const __m128i low_half = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + byte_offset));
+            const __m128i high_half = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + byte_offset + 16));
+            // The mask contains the most significant bit of each byte, which is only set for the non-ASCII bytes.
+            const u32 non_ascii_byte_mask =
+                static_cast<u32>(_mm_movemask_epi8(low_half)) | (static_cast<u32>(_mm_movemask_epi8(high_half)) << 16);
+
+            if (non_ascii_byte_mask == 0)
+            {
+                byte_offset += 32;
+                codepoint_count += 32;
+                continue;
+            }
+
+            // Skip the ASCII bytes before the first non-ASCII byte, and decode only until the end of the block.
+            const usize ascii_byte_count = std::countr_zero(non_ascii_byte_mask);
+            scalar_end_offset = byte_offset + 32;
+            byte_offset += ascii_byte_count;
+            codepoint_count += ascii_byte_count;
+        }
+#endif // SE_SIMD_SSE2
 
-        ++len;
-        byte_offset += codepoint_width;
+        while (byte_offset < scalar_end_offset)
+        {
+            if (bytes[byte_offset] < 0x80)
+            {
+                ++byte_offset;
+                ++codepoint_count;
+                continue;
+            }
+
+            const usize codepoint_width = get_valid_multibyte_codepoint_width(bytes + byte_offset, byte_count - byte_offset);
+            if (codepoint_width == 0)
+                return false;
+            byte_offset += codepoint_width;
+            ++codepoint_count;
+        }
     }
 
-    return len;
+    out_codepoint_count = codepoint_count;
+    return true;
+}
+
+usize UTF8::length(ReadonlyByteSpan byte_span)
+{
+    usize codepoint_count;
+    if (!validate_and_count_codepoints(byte_span, codepoint_count))
+        return invalid_size;
+    return codepoint_count;
 }
 
 usize UTF8::byte_count(ReadonlyBytes bytes)
@@ -193,8 +291,35 @@ usize UTF8::byte_count(ReadonlyBytes bytes)
     }
 
     ReadonlyBytes base = bytes;
+#if SE_SIMD_SSE2 && !SE_ADDRESS_SANITIZER
+    //
+    // NOTE: This intentionally reads outside of the string: the first block starts before it and the last block ends
+    //       after its null-termination character (up to 15 bytes on either side). The blocks are loaded from aligned
+    //       addresses, so they never cross a page boundary and the reads can't fault, and the bytes outside of the
+    //       string are ignored. AddressSanitizer reports these reads regardless, so the scalar loop is used instead.
+    //
+    const usize misalignment = reinterpret_cast<uintptr>(bytes) & 15;
+    const __m128i* block = reinterpret_cast<const __m128i*>(bytes - misalignment);
+    const __m128i zero = _mm_setzero_si128();
+
+    u32 null_byte_mask = static_cast<u32>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_load_si128(block), zero))) >> misalignment;
+    if (null_byte_mask != 0)
+    {
+        bytes += std::countr_zero(null_byte_mask) + 1;
+    }
+    else
+    {
+        do
+        {
+            ++block;
+            null_byte_mask = static_cast<u32>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_load_si128(block), zero)));
+        } while (null_byte_mask == 0);
+        bytes = reinterpret_cast<ReadonlyBytes>(block) + std::countr_zero(null_byte_mask) + 1;
+    }
+#else
     while (*bytes++)
     {}
+#endif // SE_SIMD_SSE2 && !SE_ADDRESS_SANITIZER
 
     // Determining the number of bytes this way doesn't guarantee that the byte sequence
     // is valid UTF-8, so a validation must now be performed.
@@ -212,18 +337,8 @@ usize UTF8::byte_count(ReadonlyBytes bytes)
 
 bool UTF8::check_validity(ReadonlyByteSpan byte_span)
 {
-    usize byte_offset = 0;
-    while (byte_offset < byte_span.count())
-    {
-        const usize codepoint_width = bytes_to_codepoint_width(byte_span.slice(byte_offset));
-        if (codepoint_width == 0)
-        {
-            // A valid UTF-8 codepoint can't have a width of zero, so the string is not correctly encoded.
-            return false;
-        }
-        byte_offset += codepoint_width;
-    }
-    return true;
+    usize codepoint_count;
+    return validate_and_count_codepoints(byte_span, codepoint_count);
 }
 
 } // namespace SE
@@ -53,9 +53,15 @@ public:
     // Determines the number of bytes that a null-terminated UTF-8 string occupies.
     // If 'bytes' is nullptr, zero will be returned.
     // If the provided byte sequence is not valid UTF-8 'invalid_size' will be returned.
+    // The null-termination character is searched in aligned 16-byte blocks when the architecture allows it, which
+    // reads (but never faults on) up to 15 bytes before and after the string.
     //
     NODISCARD SHOOTER_API static usize byte_count(ReadonlyBytes bytes);
 
+    //
+    // Checks that the byte sequence is well-formed UTF-8. Truncated sequences, unexpected continuation bytes, overlong
+    // encodings, surrogates and codepoints above U+10FFFF are all invalid.
+    //
     NODISCARD SHOOTER_API static bool check_validity(ReadonlyByteSpan byte_span);
 };
 
@@ -6,6 +6,7 @@
 #pragma once
 
 #include <Core/API.h>
+#include <Core/Containers/Hash.h>
 #include <Core/CoreTypes.h>
 
 namespace SE
@@ -66,4 +67,10 @@ private:
     u64 m_uuid_value;
 };
 
+template<>
+struct Hasher<UUID>
+{
+    NODISCARD ALWAYS_INLINE static u64 get_hash(const UUID& value) { return Hasher<u64>::get_hash(value.value()); }
+};
+
 } // namespace SE
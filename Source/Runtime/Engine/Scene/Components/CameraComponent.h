@@ -22,9 +22,23 @@ public:
     NODISCARD ALWAYS_INLINE float get_clip_plane_near() const { return m_clip_plane_near; }
     NODISCARD ALWAYS_INLINE float get_clip_plane_far() const { return m_clip_plane_far; }
 
-    ALWAYS_INLINE void set_vertical_field_of_view(float vertical_field_of_view) { m_vertical_field_of_view = vertical_field_of_view; }
-    ALWAYS_INLINE void set_clip_plane_near(float clip_plane_near) { m_clip_plane_near = clip_plane_near; }
-    ALWAYS_INLINE void set_clip_plane_far(float clip_plane_far) { m_clip_plane_far = clip_plane_far; }
+    ALWAYS_INLINE void set_vertical_field_of_view(float vertical_field_of_view)
+    {
+        m_vertical_field_of_view = vertical_field_of_view;
+        mark_modified();
+    }
+
+    ALWAYS_INLINE void set_clip_plane_near(float clip_plane_near)
+    {
+        m_clip_plane_near = clip_plane_near;
+        mark_modified();
+    }
+
+    ALWAYS_INLINE void set_clip_plane_far(float clip_plane_far)
+    {
+        m_clip_plane_far = clip_plane_far;
+        mark_modified();
+    }
 
     NODISCARD SHOOTER_API Matrix4 get_projection_matrix(float aspect_ratio) const;
 
@@ -34,6 +34,13 @@ void SpriteRendererComponent::on_register(ComponentReflector& reflector)
         field.byte_offset = SE_OFFSET_OF(SpriteRendererComponent, m_sprite_color);
         field.name = "m_translation"sv;
     }
+
+    {
+        ComponentField& field = reflector.fields.emplace();
+        field.type_stack.add(ComponentFieldType::AssetReferenceTexture);
+        field.byte_offset = SE_OFFSET_OF(SpriteRendererComponent, m_texture_handle);
+        field.name = "m_texture"sv;
+    }
 }
 
 SpriteRendererComponent::SpriteRendererComponent(const EntityComponentInitializer& initializer, Color4 in_sprite_color)
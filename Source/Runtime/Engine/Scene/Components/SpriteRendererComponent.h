@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include <Asset/Asset.h>
 #include <Core/Math/Color.h>
 #include <Engine/Scene/EntityComponent.h>
 
@@ -20,10 +21,23 @@ public:
 
 public:
     NODISCARD ALWAYS_INLINE Color4 sprite_color() const { return m_sprite_color; }
-    ALWAYS_INLINE void set_sprite_color(Color4 new_sprite_color) { m_sprite_color = new_sprite_color; }
+    ALWAYS_INLINE void set_sprite_color(Color4 new_sprite_color)
+    {
+        m_sprite_color = new_sprite_color;
+        mark_modified();
+    }
+
+    // The texture asset that is drawn by the sprite, tinted by the sprite color. Invalid if the sprite is a colored quad.
+    NODISCARD ALWAYS_INLINE AssetHandle texture_handle() const { return m_texture_handle; }
+    ALWAYS_INLINE void set_texture_handle(AssetHandle new_texture_handle)
+    {
+        m_texture_handle = new_texture_handle;
+        mark_modified();
+    }
 
 private:
     Color4 m_sprite_color { 1, 1, 1, 1 };
+    AssetHandle m_texture_handle;
 };
 
 } // namespace SE
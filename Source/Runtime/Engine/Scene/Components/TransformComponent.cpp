@@ -6,6 +6,7 @@
 #include <Core/Math/MatrixTransformations.h>
 #include <Engine/Scene/Components/TransformComponent.h>
 #include <Engine/Scene/Reflection/ComponentReflector.h>
+#include <Engine/Scene/Scene.h>
 
 namespace SE
 {
@@ -57,6 +58,26 @@ TransformComponent::TransformComponent(const EntityComponentInitializer& initial
     , m_rotation(in_rotation)
 {}
 
+void TransformComponent::set_translation(Vector3 new_translation)
+{
+    m_translation = new_translation;
+    scene_context().update_entity_spatial_bounds(*parent_entity());
+    mark_modified();
+}
+
+void TransformComponent::set_rotation(Vector3 in_rotation)
+{
+    m_rotation = in_rotation;
+    mark_modified();
+}
+
+void TransformComponent::set_scale(Vector3 in_scale)
+{
+    m_scale = in_scale;
+    scene_context().update_entity_spatial_bounds(*parent_entity());
+    mark_modified();
+}
+
 Matrix4 TransformComponent::get_transform_matrix() const
 {
     const Matrix4 translation_matrix = Matrix4::translate(m_translation);
@@ -24,9 +24,10 @@ public:
     NODISCARD ALWAYS_INLINE Vector3 rotation() const { return m_rotation; }
     NODISCARD ALWAYS_INLINE Vector3 scale() const { return m_scale; }
 
-    ALWAYS_INLINE void set_translation(Vector3 new_translation) { m_translation = new_translation; }
-    ALWAYS_INLINE void set_rotation(Vector3 in_rotation) { m_rotation = in_rotation; }
-    ALWAYS_INLINE void set_scale(Vector3 in_scale) { m_scale = in_scale; }
+    // NOTE: Changing the translation or the scale of the entity also updates its bounds in the scene spatial grid.
+    SHOOTER_API void set_translation(Vector3 new_translation);
+    SHOOTER_API void set_rotation(Vector3 in_rotation);
+    SHOOTER_API void set_scale(Vector3 in_scale);
 
     NODISCARD SHOOTER_API Matrix4 get_transform_matrix() const;
 
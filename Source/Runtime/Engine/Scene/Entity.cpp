@@ -29,6 +29,7 @@ Entity::~Entity()
 void Entity::set_name(String entity_name)
 {
     m_name = entity_name;
+    m_scene_context.mark_entity_modified(m_uuid);
 }
 
 void Entity::on_begin_play()
@@ -96,6 +97,10 @@ void Entity::add_component(EntityComponent* component)
 {
     m_components.add(component);
 
+    // The component might be the one that makes the entity visible (or it might change its bounds).
+    m_scene_context.update_entity_spatial_bounds(*this);
+    m_scene_context.mark_entity_modified(m_uuid);
+
     if (m_scene_context.get_play_state() == Scene::PlayState::BeginPlaying || m_scene_context.get_play_state() == Scene::PlayState::Playing)
     {
         // If the scene is currently playing (even if just beginning to do so) invoke the component `on_begin_play` callback.
@@ -33,6 +33,7 @@ class Entity
 
     friend class OwnPtr<Entity>;
     friend class Scene;
+    friend class BinarySceneSerializer;
 
 #if SE_CONFIGURATION_TARGET_EDITOR
     friend class EditorSceneSerializer;
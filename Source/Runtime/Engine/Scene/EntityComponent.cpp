@@ -5,6 +5,7 @@
 
 #include <Engine/Scene/Entity.h>
 #include <Engine/Scene/EntityComponent.h>
+#include <Engine/Scene/Scene.h>
 
 namespace SE
 {
@@ -29,4 +30,9 @@ void EntityComponent::set_is_updatable(bool is_updatable)
     m_is_updatable = is_updatable;
 }
 
+void EntityComponent::mark_modified()
+{
+    m_parent_entity.scene_context().mark_entity_modified(m_parent_entity.uuid());
+}
+
 } // namespace SE
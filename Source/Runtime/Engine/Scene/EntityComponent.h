@@ -66,6 +66,10 @@ protected:
     SHOOTER_API virtual void on_end_play() {}
     SHOOTER_API virtual void on_update(float delta_time) {}
 
+    // Records that the component has been modified, so the parent entity is saved with the next scene save.
+    // Must be called by the setters of all the component fields that are saved.
+    SHOOTER_API void mark_modified();
+
 private:
     Entity& m_parent_entity;
     bool m_is_updatable;
@@ -3,7 +3,11 @@
  * SPDX-License-Identifier: Apache-2.0.
  */
 
+#include <Asset/Asset.h>
 #include <Core/Log.h>
+#include <Core/Math/Color.h>
+#include <Core/Math/Vector.h>
+#include <Core/Misc/ComparisonResult.h>
 #include <Engine/Scene/Reflection/ComponentReflector.h>
 
 namespace SE
@@ -51,6 +55,40 @@ ComponentFieldType get_component_field_type_from_string(StringView field_type_as
     return ComponentFieldType::Unknown;
 }
 
+usize get_component_field_type_byte_count(ComponentFieldType field_type)
+{
+    switch (field_type)
+    {
+        case ComponentFieldType::Unknown: return 0;
+        case ComponentFieldType::UInt8: return sizeof(u8);
+        case ComponentFieldType::UInt16: return sizeof(u16);
+        case ComponentFieldType::UInt32: return sizeof(u32);
+        case ComponentFieldType::UInt64: return sizeof(u64);
+        case ComponentFieldType::Int8: return sizeof(i8);
+        case ComponentFieldType::Int16: return sizeof(i16);
+        case ComponentFieldType::Int32: return sizeof(i32);
+        case ComponentFieldType::Int64: return sizeof(i64);
+        case ComponentFieldType::Float32: return sizeof(float);
+        case ComponentFieldType::Float64: return sizeof(double);
+        case ComponentFieldType::Boolean: return sizeof(bool);
+        case ComponentFieldType::Vector2: return sizeof(Vector2);
+        case ComponentFieldType::Vector3: return sizeof(Vector3);
+        case ComponentFieldType::Vector4: return sizeof(Vector4);
+        case ComponentFieldType::Color3: return sizeof(Color3);
+        case ComponentFieldType::Color4: return sizeof(Color4);
+        case ComponentFieldType::String: return sizeof(String);
+        case ComponentFieldType::AssetReferenceTexture: return sizeof(AssetHandle);
+    }
+
+    SE_ASSERT("Invalid ComponentFieldType!");
+    return 0;
+}
+
+bool is_component_field_type_trivially_copyable(ComponentFieldType field_type)
+{
+    return (field_type != ComponentFieldType::Unknown && field_type != ComponentFieldType::String);
+}
+
 StringView get_component_field_flag_as_string(ComponentFieldFlag field_flag)
 {
     switch (field_flag)
@@ -93,4 +131,96 @@ ComponentFieldFlag get_component_field_flag_from_string(StringView field_flag_as
     return ComponentFieldFlag::None;
 }
 
+//==============================================================================================================
+// COMPONENT SERIALIZATION PLAN.
+//==============================================================================================================
+
+void ComponentReflector::compile_serialization_plan()
+{
+    serialization_plan.steps.clear();
+    serialization_plan.field_indices.clear();
+    serialization_plan.field_indices.set_fixed_capacity(fields.count());
+
+    for (u32 field_index = 0; field_index < fields.count(); ++field_index)
+        serialization_plan.field_indices.add(field_index);
+
+    serialization_plan.field_indices.sort(
+        [this](u32 lhs, u32 rhs) -> ComparisonResult
+        {
+            if (fields[lhs].byte_offset < fields[rhs].byte_offset)
+                return ComparisonResult::Less;
+            if (fields[lhs].byte_offset > fields[rhs].byte_offset)
+                return ComparisonResult::Greater;
+            return ComparisonResult::Equal;
+        }
+    );
+
+    for (u32 plan_field_index = 0; plan_field_index < serialization_plan.field_indices.count(); ++plan_field_index)
+    {
+        const ComponentField& field = fields[serialization_plan.field_indices[plan_field_index]];
+        const ComponentFieldType field_type = field.type_stack.first();
+        const u32 field_byte_offset = static_cast<u32>(field.byte_offset);
+        const u32 field_byte_count = static_cast<u32>(get_component_field_type_byte_count(field_type));
+        SE_ASSERT(field_byte_count > 0);
+        SE_ASSERT(field.byte_offset + field_byte_count <= structure_byte_count);
+
+        ComponentSerializationStepType step_type = ComponentSerializationStepType::CopyBytes;
+        if (field_type == ComponentFieldType::String)
+            step_type = ComponentSerializationStepType::String;
+        else if (field_type == ComponentFieldType::AssetReferenceTexture)
+            step_type = ComponentSerializationStepType::AssetReference;
+
+        // Merge the field into the previous step if both can be copied and the field immediately follows it in memory.
+        if (step_type == ComponentSerializationStepType::CopyBytes && !serialization_plan.steps.is_empty())
+        {
+            ComponentSerializationStep& last_step = serialization_plan.steps.last();
+            if (last_step.type == ComponentSerializationStepType::CopyBytes && last_step.byte_offset + last_step.byte_count == field_byte_offset)
+            {
+                last_step.field_count++;
+                last_step.byte_count += field_byte_count;
+                continue;
+            }
+        }
+
+        ComponentSerializationStep& step = serialization_plan.steps.emplace();
+        step.type = step_type;
+        step.first_field_index = plan_field_index;
+        step.field_count = 1;
+        step.byte_offset = field_byte_offset;
+        step.byte_count = field_byte_count;
+    }
+}
+
+Optional<u32> ComponentReflector::find_field_index(Name field_name, ComponentFieldType field_type) const
+{
+    for (u32 field_index = 0; field_index < fields.count(); ++field_index)
+    {
+        const ComponentField& field = fields[field_index];
+        if (field.name == field_name && field.type_stack.first() == field_type)
+            return field_index;
+    }
+
+    return {};
+}
+
+void ComponentReflector::build_field_remap_table(Span<const ComponentFieldDescription> saved_fields, ComponentFieldRemapTable& out_remap_table) const
+{
+    out_remap_table.field_indices.clear();
+    out_remap_table.field_indices.set_fixed_capacity(saved_fields.count());
+    out_remap_table.is_identity = (saved_fields.count() == serialization_plan.field_indices.count());
+
+    for (usize saved_field_index = 0; saved_field_index < saved_fields.count(); ++saved_field_index)
+    {
+        const ComponentFieldDescription& saved_field = saved_fields[saved_field_index];
+        const Optional<u32> field_index = find_field_index(saved_field.name, saved_field.type);
+        out_remap_table.field_indices.add(field_index);
+
+        if (out_remap_table.is_identity)
+        {
+            if (!field_index.has_value() || field_index.value() != serialization_plan.field_indices[saved_field_index])
+                out_remap_table.is_identity = false;
+        }
+    }
+}
+
 } // namespace SE
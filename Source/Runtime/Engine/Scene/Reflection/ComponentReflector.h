@@ -6,8 +6,11 @@
 #pragma once
 
 #include <Core/API.h>
+#include <Core/Containers/Optional.h>
+#include <Core/Containers/Span.h>
 #include <Core/Containers/Vector.h>
 #include <Core/Memory/Buffer.h>
+#include <Core/String/Name.h>
 #include <Core/String/String.h>
 #include <Core/UUID.h>
 
@@ -48,6 +51,12 @@ NODISCARD SHOOTER_API StringView get_component_field_type_as_string(ComponentFie
 NODISCARD SHOOTER_API const char* get_component_field_type_as_raw_string(ComponentFieldType field_type);
 NODISCARD SHOOTER_API ComponentFieldType get_component_field_type_from_string(StringView field_type_as_string);
 
+// Returns the number of bytes that a field of the given type occupies in the component structure.
+NODISCARD SHOOTER_API usize get_component_field_type_byte_count(ComponentFieldType field_type);
+
+// Returns true if a field of the given type can be copied with a plain memory copy (it doesn't own any memory).
+NODISCARD SHOOTER_API bool is_component_field_type_trivially_copyable(ComponentFieldType field_type);
+
 // clang-format off
 #define SE_FOR_EACH_COMPONENT_FIELD_FLAG(x) \
     x(None)                                 \
@@ -89,7 +98,7 @@ struct ComponentField
 public:
     Vector<ComponentFieldType> type_stack;
     usize byte_offset { 0 };
-    String name;
+    Name name;
     ComponentFieldMetadata metadata;
 
 public:
@@ -106,6 +115,56 @@ public:
     }
 };
 
+enum class ComponentSerializationStepType : u8
+{
+    // A range of adjacent fields that don't own any memory, copied with a single memory copy.
+    CopyBytes,
+    // A single string field. Its characters are stored out-of-line, separated from the fixed-size values.
+    String,
+    // A single asset reference field, stored as the handle of the referenced asset.
+    AssetReference,
+};
+
+struct ComponentSerializationStep
+{
+    ComponentSerializationStepType type;
+    // Range in the `ComponentSerializationPlan::field_indices` array of the fields covered by this step.
+    u32 first_field_index;
+    u32 field_count;
+    // Range in the component structure covered by this step.
+    u32 byte_offset;
+    u32 byte_count;
+};
+
+//
+// Description of how the fields of a component type are (de)serialized, compiled once when the component type is registered.
+// The fields are sorted by their byte offset and adjacent fields that can be trivially copied are merged into a single step,
+// so (de)serializing a component is a tight loop over the steps instead of a switch for each of its fields.
+//
+struct ComponentSerializationPlan
+{
+public:
+    Vector<ComponentSerializationStep> steps;
+    // The indices of the reflector fields, ordered by their byte offset in the component structure.
+    Vector<u32> field_indices;
+};
+
+// The name and type of a field, as found in a saved scene.
+struct ComponentFieldDescription
+{
+    Name name;
+    ComponentFieldType type;
+};
+
+struct ComponentFieldRemapTable
+{
+public:
+    // For each saved field, the index of the reflector field that it is loaded into. Saved fields that no longer exist are empty.
+    Vector<Optional<u32>> field_indices;
+    // True if the saved fields are exactly the fields of the plan, in the same order.
+    bool is_identity { false };
+};
+
 // Pointer to the function that will construct a component in the memory block
 // provided by the first parameter.
 using PFN_InstantiateComponent = void (*)(void*, const struct EntityComponentInitializer&);
@@ -115,12 +174,26 @@ struct ComponentReflector
 public:
     UUID parent_type_uuid { UUID::invalid() };
     usize structure_byte_count { 0 };
-    String name;
+    Name name;
     PFN_InstantiateComponent instantiate_function { nullptr };
     Vector<ComponentField> fields;
     Buffer default_component_object_buffer;
+    ComponentSerializationPlan serialization_plan;
 
 public:
+    // Must be called after all the fields of the component have been registered.
+    SHOOTER_API void compile_serialization_plan();
+
+    // Returns the index of the field with the given name and type, or an empty optional if the component has no such field.
+    NODISCARD SHOOTER_API Optional<u32> find_field_index(Name field_name, ComponentFieldType field_type) const;
+
+    //
+    // Matches the fields of a saved component against the current fields of the component, by their name and type.
+    // This allows loading scenes that were saved before fields were reordered, added or removed, while still
+    // only comparing the names once per component type instead of once per component instance.
+    //
+    SHOOTER_API void build_field_remap_table(Span<const ComponentFieldDescription> saved_fields, ComponentFieldRemapTable& out_remap_table) const;
+
     template<typename ComponentType>
     NODISCARD ALWAYS_INLINE const ComponentType& get_default_component_object() const
     {
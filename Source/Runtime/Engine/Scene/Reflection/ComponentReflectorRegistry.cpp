@@ -8,6 +8,7 @@
 #include <Engine/Scene/Components/TransformComponent.h>
 #include <Engine/Scene/EntityComponent.h>
 #include <Engine/Scene/Reflection/ComponentReflectorRegistry.h>
+#include <Engine/Scene/Scene.h>
 
 namespace SE
 {
@@ -22,6 +23,7 @@ bool ComponentReflectorRegistry::initialize()
     {                                                                                                                     \
         ComponentReflector& reflector = allocate_reflector(component_type::get_static_component_type_uuid());             \
         component_type::on_register(reflector);                                                                           \
+        reflector.compile_serialization_plan();                                                                           \
         reflector.default_component_object_buffer.allocate_new(sizeof(component_type));                                   \
         reflector.instantiate_function(reflector.default_component_object_buffer.bytes(), default_component_initializer); \
     }
@@ -61,4 +63,44 @@ const ComponentReflector& ComponentReflectorRegistry::get_reflector(UUID compone
     return m_registry.at(component_type_uuid);
 }
 
+const ComponentReflector* ComponentReflectorRegistry::try_get_reflector(UUID component_type_uuid) const
+{
+    Optional<const ComponentReflector&> reflector = m_registry.get_if_exists(component_type_uuid);
+    return reflector.has_value() ? &reflector.value() : nullptr;
+}
+
+void ComponentReflectorRegistry::collect_asset_references(const Scene& scene, Vector<AssetHandle>& out_asset_handles) const
+{
+    HashMap<AssetHandle, bool> collected_asset_handles;
+    for (const AssetHandle asset_handle : out_asset_handles)
+        collected_asset_handles.add(asset_handle, true);
+
+    scene.for_each_entity(
+        [&](const Entity* entity, UUID) -> IterationDecision
+        {
+            for (const EntityComponent* component : entity->get_components())
+            {
+                const ComponentReflector* reflector = try_get_reflector(component->get_component_type_uuid());
+                if (reflector == nullptr)
+                    continue;
+
+                const u8* component_bytes = reinterpret_cast<const u8*>(component);
+                for (const ComponentSerializationStep& step : reflector->serialization_plan.steps)
+                {
+                    if (step.type != ComponentSerializationStepType::AssetReference)
+                        continue;
+
+                    const AssetHandle asset_handle = *reinterpret_cast<const AssetHandle*>(component_bytes + step.byte_offset);
+                    if (!asset_handle.is_valid() || collected_asset_handles.contains(asset_handle))
+                        continue;
+
+                    collected_asset_handles.add(asset_handle, true);
+                    out_asset_handles.add(asset_handle);
+                }
+            }
+            return IterationDecision::Continue;
+        }
+    );
+}
+
 } // namespace SE
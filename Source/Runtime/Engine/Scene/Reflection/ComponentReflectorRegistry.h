@@ -5,13 +5,17 @@
 
 #pragma once
 
+#include <Asset/Asset.h>
 #include <Core/Containers/HashMap.h>
+#include <Core/Containers/Vector.h>
 #include <Core/Misc/IterationDecision.h>
 #include <Engine/Scene/Reflection/ComponentReflector.h>
 
 namespace SE
 {
 
+class Scene;
+
 class ComponentReflectorRegistry
 {
 public:
@@ -21,6 +25,15 @@ public:
     SHOOTER_API ComponentReflector& allocate_reflector(UUID component_type_uuid);
     SHOOTER_API const ComponentReflector& get_reflector(UUID component_type_uuid) const;
 
+    // Returns a null pointer if no reflector is registered for the given component type.
+    NODISCARD SHOOTER_API const ComponentReflector* try_get_reflector(UUID component_type_uuid) const;
+
+    //
+    // Appends the handles of all the assets referenced by the components of the given scene, so they can be preloaded
+    // before the scene is used. Each handle is appended once, and invalid (unset) references are skipped.
+    //
+    SHOOTER_API void collect_asset_references(const Scene& scene, Vector<AssetHandle>& out_asset_handles) const;
+
     template<typename PredicateFunction>
     ALWAYS_INLINE void for_each_reflector(PredicateFunction predicate_function) const
     {
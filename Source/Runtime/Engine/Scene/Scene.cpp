@@ -4,6 +4,8 @@
  */
 
 #include <Engine/Scene/Components/CameraComponent.h>
+#include <Engine/Scene/Components/SpriteRendererComponent.h>
+#include <Engine/Scene/Components/TransformComponent.h>
 #include <Engine/Scene/Scene.h>
 
 namespace SE
@@ -17,11 +19,13 @@ OwnPtr<Scene> Scene::create()
 
 Scene::Scene()
     : m_play_state(PlayState::NotPlaying)
+    , m_is_change_tracking_enabled(false)
 {}
 
 Scene::~Scene()
 {
     SE_ASSERT(m_play_state == PlayState::NotPlaying);
+    m_sprite_spatial_grid.clear();
     m_entities.clear_and_shrink();
 }
 
@@ -48,9 +52,32 @@ Entity* Scene::create_entity_with_uuid(UUID entity_uuid)
         entity->on_begin_play();
     }
 
+    mark_entity_modified(entity_uuid);
     return entity;
 }
 
+void Scene::destroy_entity(UUID entity_uuid)
+{
+    SE_ASSERT(m_play_state == PlayState::NotPlaying || m_play_state == PlayState::Playing);
+
+    Entity* entity = get_entity_from_uuid(entity_uuid);
+    if (entity == nullptr)
+        return;
+
+    if (m_play_state == PlayState::Playing)
+        entity->on_end_play();
+
+    m_sprite_spatial_grid.remove(entity);
+    if (m_primary_camera_entity_uuid == entity_uuid)
+        m_primary_camera_entity_uuid = UUID::invalid();
+
+    // NOTE: Removing the entity from the table also releases the entity and all of its components.
+    m_entities.remove(entity_uuid);
+
+    if (m_is_change_tracking_enabled && m_play_state == PlayState::NotPlaying)
+        m_entity_changes.get_or_add(entity_uuid) = SceneEntityChange::Destroyed;
+}
+
 Entity* Scene::get_entity_from_uuid(UUID entity_uuid)
 {
     Optional<OwnPtr<Entity>&> entity = m_entities.get_if_exists(entity_uuid);
@@ -91,6 +118,35 @@ UUID Scene::find_primary_camera_entity() const
     return primary_camera_entity_uuid;
 }
 
+void Scene::update_entity_spatial_bounds(Entity& entity)
+{
+    if (!entity.has_component<TransformComponent>() || !entity.has_component<SpriteRendererComponent>())
+    {
+        m_sprite_spatial_grid.remove(&entity);
+        return;
+    }
+
+    const TransformComponent& tc = entity.get_component<TransformComponent>();
+    const Vector3 translation = tc.translation();
+    const Vector3 scale = tc.scale();
+
+    // NOTE: The sprite quad is centered around the entity translation, and the scale can be negative (when the sprite is mirrored).
+    const Vector2 half_extent = Vector2(0.5F * Math::max(scale.x, -scale.x), 0.5F * Math::max(scale.y, -scale.y));
+
+    SpatialBounds bounds;
+    bounds.min = Vector2(translation.x - half_extent.x, translation.y - half_extent.y);
+    bounds.max = Vector2(translation.x + half_extent.x, translation.y + half_extent.y);
+    m_sprite_spatial_grid.insert_or_update(&entity, bounds);
+}
+
+void Scene::mark_entity_modified(UUID entity_uuid)
+{
+    if (!m_is_change_tracking_enabled || m_play_state != PlayState::NotPlaying)
+        return;
+
+    m_entity_changes.get_or_add(entity_uuid) = SceneEntityChange::Modified;
+}
+
 void Scene::on_begin_play()
 {
     SE_ASSERT(m_play_state == PlayState::NotPlaying);
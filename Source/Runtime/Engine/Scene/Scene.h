@@ -10,10 +10,22 @@
 #include <Core/Misc/IterationDecision.h>
 #include <Engine/Scene/Entity.h>
 #include <Engine/Scene/EntityComponent.h>
+#include <Engine/Scene/SpatialHashGrid.h>
 
 namespace SE
 {
 
+//
+// The kind of change that has been made to an entity since the change tracking state of the scene was last cleared.
+//
+enum class SceneEntityChange : u8
+{
+    // The entity has been created or any of its properties or components has been modified.
+    Modified,
+    // The entity no longer exists in the scene.
+    Destroyed,
+};
+
 //
 // The scene class is responsible for managing a collection of entities.
 //
@@ -47,6 +59,13 @@ public:
     SHOOTER_API Entity* create_entity();
     SHOOTER_API Entity* create_entity_with_uuid(UUID entity_uuid);
 
+    // Makes sure that the given total number of entities can exist in the scene without growing the entity table.
+    ALWAYS_INLINE void reserve_entities(u32 entity_count) { m_entities.reserve(entity_count); }
+
+    // Destroys the entity and all of its components. Does nothing if no entity has the given UUID.
+    // Entities can't be destroyed while the scene begins or ends a play session.
+    SHOOTER_API void destroy_entity(UUID entity_uuid);
+
     // These functions return null pointers if no entity has the given UUID.
     SHOOTER_API Entity* get_entity_from_uuid(UUID entity_uuid);
     SHOOTER_API const Entity* get_entity_from_uuid(UUID entity_uuid) const;
@@ -100,6 +119,49 @@ public:
         }
     }
 
+    //
+    // Iterates only over the entities that have a sprite (both a transform and a sprite renderer component) whose
+    // bounds intersect the given region of the world. The query is accelerated by the scene spatial grid, so its
+    // cost doesn't depend on the number of entities outside of the region.
+    // The entity predicate has the same signature as the one used by `for_each_entity`.
+    //
+    template<typename EntityPredicate>
+    ALWAYS_INLINE void for_each_sprite_entity_in_bounds(const SpatialBounds& bounds, EntityPredicate entity_predicate) const
+    {
+        m_sprite_spatial_grid.query(
+            bounds,
+            [&](const Entity* entity) -> IterationDecision
+            {
+                return entity_predicate(entity, entity->uuid());
+            }
+        );
+    }
+
+    //
+    // Recalculates the bounds of the entity in the scene spatial grid. Must be called every time the transform
+    // of an entity changes or a component that affects its bounds is added.
+    // NOTE: The transform component setters and `Entity::add_component` already call this function. Code that
+    //       modifies the transform directly (via the component reflection system) must call it manually.
+    //
+    SHOOTER_API void update_entity_spatial_bounds(Entity& entity);
+
+public:
+    //
+    // When change tracking is enabled, the scene records which entities have been created, modified or destroyed,
+    // so that only the changed entities have to be saved. Modifications are only recorded while the scene is not playing,
+    // as the changes made by a play session are never saved.
+    // NOTE: The entity and component setters record their modifications automatically. Code that modifies a component
+    //       directly (via the component reflection system) must call `mark_entity_modified` manually.
+    //
+    ALWAYS_INLINE void set_change_tracking_enabled(bool is_enabled) { m_is_change_tracking_enabled = is_enabled; }
+    NODISCARD ALWAYS_INLINE bool is_change_tracking_enabled() const { return m_is_change_tracking_enabled; }
+
+    SHOOTER_API void mark_entity_modified(UUID entity_uuid);
+
+    // Returns the entities that have changed since `clear_entity_changes` was last called.
+    NODISCARD ALWAYS_INLINE const HashMap<UUID, SceneEntityChange>& get_entity_changes() const { return m_entity_changes; }
+    ALWAYS_INLINE void clear_entity_changes() { m_entity_changes.clear(); }
+
 public:
     //
     // Invokes the `on_begin_play` callback for each entity in the scene.
@@ -128,6 +190,12 @@ private:
 
     HashMap<UUID, OwnPtr<Entity>> m_entities;
 
+    bool m_is_change_tracking_enabled;
+    HashMap<UUID, SceneEntityChange> m_entity_changes;
+
+    // Spatial acceleration structure that contains the bounds of all entities that have a sprite.
+    SpatialHashGrid m_sprite_spatial_grid;
+
     // The UUID of the enyity that has a camera component attached to it and it is also
     // marked as the primary one.
     UUID m_primary_camera_entity_uuid;
@@ -0,0 +1,690 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/Containers/HashMap.h>
+#include <Core/Containers/OwnPtr.h>
+#include <Core/FileSystem/FileSystem.h>
+#include <Core/Log.h>
+#include <Core/Math/MathCore.h>
+#include <Core/Memory/MemoryOperations.h>
+#include <Core/Platform/Atomic.h>
+#include <Core/Platform/Thread.h>
+#include <Core/String/Utf8.h>
+#include <Engine/Scene/Reflection/ComponentReflectorRegistry.h>
+#include <Engine/Scene/Scene.h>
+#include <Engine/Scene/Serialization/BinarySceneSerializer.h>
+
+namespace SE
+{
+
+//==============================================================================================================
+// UTILITIES.
+//==============================================================================================================
+
+// Returns the number of bytes that a value of the given field type occupies in the binary scene file.
+static u32 get_binary_value_byte_count(ComponentFieldType field_type)
+{
+    if (field_type == ComponentFieldType::String)
+        return sizeof(BinarySceneStringReference);
+    return static_cast<u32>(get_component_field_type_byte_count(field_type));
+}
+
+// Returns the number of bytes that an element of the value range written for the given serialization step occupies.
+static u32 get_binary_step_byte_count(const ComponentSerializationStep& step)
+{
+    if (step.type == ComponentSerializationStepType::String)
+        return sizeof(BinarySceneStringReference);
+    return step.byte_count;
+}
+
+static usize align_offset(usize offset)
+{
+    return (offset + binary_scene_alignment - 1) & ~(binary_scene_alignment - 1);
+}
+
+static usize append_aligned_bytes(Vector<u8>& bytes, usize byte_count)
+{
+    const usize offset = align_offset(bytes.count());
+    bytes.set_count(offset + byte_count);
+    return offset;
+}
+
+static BinarySceneStringReference append_string(Vector<u8>& string_table, StringView string)
+{
+    BinarySceneStringReference string_reference;
+    string_reference.offset = static_cast<u32>(string_table.count());
+    string_reference.byte_count = static_cast<u32>(string.byte_count());
+    string_table.add_span(string.byte_span());
+    return string_reference;
+}
+
+//==============================================================================================================
+// SERIALIZATION.
+//==============================================================================================================
+
+bool BinarySceneSerializer::serialize(const String& filepath)
+{
+    Vector<u8> scene_bytes;
+    serialize_to_memory(scene_bytes);
+
+    FileWriter scene_file_writer;
+    SE_CHECK_FILE_ERROR(scene_file_writer.open(filepath));
+    SE_CHECK_FILE_ERROR(scene_file_writer.write_and_close(ReadonlyByteSpan(scene_bytes.elements(), scene_bytes.count())));
+
+    SE_LOG_TAG_INFO("Scene", "Serialized binary scene to filepath '{}' ({} bytes).", filepath, scene_bytes.count());
+    return true;
+}
+
+void BinarySceneSerializer::serialize_to_memory(Vector<u8>& out_bytes)
+{
+    struct ComponentTypeGroup
+    {
+        const ComponentReflector* reflector { nullptr };
+        UUID type_uuid;
+        Vector<u32> entity_indices;
+        Vector<const EntityComponent*> components;
+    };
+
+    Vector<const Entity*> entities;
+    entities.set_fixed_capacity(m_scene_context.get_entity_count());
+
+    // Group the component instances by their type, in the order in which the types are first encountered.
+    Vector<ComponentTypeGroup> component_type_groups;
+    HashMap<UUID, u32> component_type_group_indices;
+    usize field_count = 0;
+    usize value_range_count = 0;
+
+    m_scene_context.for_each_entity(
+        [&](const Entity* entity, UUID entity_uuid) -> IterationDecision
+        {
+            const u32 entity_index = static_cast<u32>(entities.count());
+            entities.add(entity);
+
+            for (const EntityComponent* component : entity->get_components())
+            {
+                const UUID type_uuid = component->get_component_type_uuid();
+                u32 group_index;
+
+                Optional<u32&> existing_group_index = component_type_group_indices.get_if_exists(type_uuid);
+                if (existing_group_index.has_value())
+                {
+                    group_index = existing_group_index.value();
+                }
+                else
+                {
+                    group_index = static_cast<u32>(component_type_groups.count());
+                    component_type_group_indices.add(type_uuid, group_index);
+
+                    ComponentTypeGroup& new_group = component_type_groups.emplace();
+                    new_group.reflector = &m_component_reflector_registry_context.get_reflector(type_uuid);
+                    new_group.type_uuid = type_uuid;
+                    field_count += new_group.reflector->serialization_plan.field_indices.count();
+                    value_range_count += new_group.reflector->serialization_plan.steps.count();
+                }
+
+                ComponentTypeGroup& group = component_type_groups[group_index];
+                group.entity_indices.add(entity_index);
+                group.components.add(component);
+            }
+
+            return IterationDecision::Continue;
+        }
+    );
+
+    out_bytes.clear();
+    Vector<u8> string_table;
+
+    // Reserve the space for the header and the tables. They are written at the end, once all offsets are known.
+    const usize header_offset = append_aligned_bytes(out_bytes, sizeof(BinarySceneHeader));
+    const usize entity_table_offset = append_aligned_bytes(out_bytes, entities.count() * sizeof(BinarySceneEntityRecord));
+    const usize component_type_table_offset = append_aligned_bytes(out_bytes, component_type_groups.count() * sizeof(BinarySceneComponentTypeRecord));
+    const usize field_table_offset = append_aligned_bytes(out_bytes, field_count * sizeof(BinarySceneFieldRecord));
+    const usize value_range_table_offset = append_aligned_bytes(out_bytes, value_range_count * sizeof(BinarySceneValueRangeRecord));
+
+    Vector<BinarySceneEntityRecord> entity_records;
+    entity_records.set_fixed_capacity(entities.count());
+    for (const Entity* entity : entities)
+    {
+        BinarySceneEntityRecord& entity_record = entity_records.emplace();
+        entity_record.uuid = entity->uuid().value();
+        entity_record.name = append_string(string_table, entity->name().view());
+    }
+
+    Vector<BinarySceneComponentTypeRecord> component_type_records;
+    Vector<BinarySceneFieldRecord> field_records;
+    Vector<BinarySceneValueRangeRecord> value_range_records;
+    component_type_records.set_fixed_capacity(component_type_groups.count());
+    field_records.set_fixed_capacity(field_count);
+    value_range_records.set_fixed_capacity(value_range_count);
+
+    for (const ComponentTypeGroup& group : component_type_groups)
+    {
+        const ComponentSerializationPlan& plan = group.reflector->serialization_plan;
+        const usize instance_count = group.components.count();
+
+        BinarySceneComponentTypeRecord& component_type_record = component_type_records.emplace();
+        zero_memory(&component_type_record, sizeof(BinarySceneComponentTypeRecord));
+        component_type_record.type_uuid = group.type_uuid.value();
+        component_type_record.name = append_string(string_table, group.reflector->name.view());
+        component_type_record.first_field_index = static_cast<u32>(field_records.count());
+        component_type_record.field_count = static_cast<u32>(plan.field_indices.count());
+        component_type_record.first_value_range_index = static_cast<u32>(value_range_records.count());
+        component_type_record.value_range_count = static_cast<u32>(plan.steps.count());
+        component_type_record.instance_count = static_cast<u32>(instance_count);
+
+        component_type_record.entity_indices_offset = append_aligned_bytes(out_bytes, instance_count * sizeof(u32));
+        copy_memory(out_bytes.elements() + component_type_record.entity_indices_offset, group.entity_indices.elements(), instance_count * sizeof(u32));
+
+        // The fields are written in the order of the plan, so a value range always covers a contiguous run of field records.
+        for (u32 step_index = 0; step_index < plan.steps.count(); ++step_index)
+        {
+            const ComponentSerializationStep& step = plan.steps[step_index];
+            const u32 element_byte_count = get_binary_step_byte_count(step);
+
+            BinarySceneValueRangeRecord& value_range_record = value_range_records.emplace();
+            zero_memory(&value_range_record, sizeof(BinarySceneValueRangeRecord));
+            value_range_record.element_byte_count = element_byte_count;
+            value_range_record.values_offset = append_aligned_bytes(out_bytes, instance_count * element_byte_count);
+
+            for (u32 plan_field_index = step.first_field_index; plan_field_index < step.first_field_index + step.field_count; ++plan_field_index)
+            {
+                const ComponentField& field = group.reflector->fields[plan.field_indices[plan_field_index]];
+
+                BinarySceneFieldRecord& field_record = field_records.emplace();
+                zero_memory(&field_record, sizeof(BinarySceneFieldRecord));
+                field_record.name = append_string(string_table, field.name.view());
+                field_record.type = field.type_stack.first();
+                field_record.value_range_index = step_index;
+                field_record.byte_offset_in_value_range = static_cast<u32>(field.byte_offset) - step.byte_offset;
+            }
+
+            u8* values = out_bytes.elements() + value_range_record.values_offset;
+            for (usize instance_index = 0; instance_index < instance_count; ++instance_index)
+            {
+                const u8* component_bytes = reinterpret_cast<const u8*>(group.components[instance_index]);
+                u8* element = values + instance_index * element_byte_count;
+
+                switch (step.type)
+                {
+                    case ComponentSerializationStepType::CopyBytes:
+                    case ComponentSerializationStepType::AssetReference:
+                    {
+                        copy_memory(element, component_bytes + step.byte_offset, element_byte_count);
+                        break;
+                    }
+
+                    case ComponentSerializationStepType::String:
+                    {
+                        const String& string_value = *reinterpret_cast<const String*>(component_bytes + step.byte_offset);
+                        const BinarySceneStringReference string_reference = append_string(string_table, string_value.view());
+                        copy_memory(element, &string_reference, sizeof(BinarySceneStringReference));
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    const usize string_table_offset = append_aligned_bytes(out_bytes, string_table.count());
+    copy_memory(out_bytes.elements() + string_table_offset, string_table.elements(), string_table.count());
+
+    BinarySceneHeader header = {};
+    header.magic = binary_scene_magic;
+    header.version = binary_scene_version;
+    // NOTE: Scenes don't have an UUID yet, so the same value as the one in the YAML scene files is written.
+    header.scene_uuid = UUID::invalid().value();
+    header.entity_count = static_cast<u32>(entities.count());
+    header.component_type_count = static_cast<u32>(component_type_records.count());
+    header.field_count = static_cast<u32>(field_records.count());
+    header.value_range_count = static_cast<u32>(value_range_records.count());
+    header.entity_table_offset = entity_table_offset;
+    header.component_type_table_offset = component_type_table_offset;
+    header.field_table_offset = field_table_offset;
+    header.value_range_table_offset = value_range_table_offset;
+    header.string_table_offset = string_table_offset;
+    header.string_table_byte_count = string_table.count();
+
+    copy_memory(out_bytes.elements() + header_offset, &header, sizeof(BinarySceneHeader));
+    copy_memory(out_bytes.elements() + entity_table_offset, entity_records.elements(), entity_records.count() * sizeof(BinarySceneEntityRecord));
+    copy_memory(
+        out_bytes.elements() + component_type_table_offset,
+        component_type_records.elements(),
+        component_type_records.count() * sizeof(BinarySceneComponentTypeRecord)
+    );
+    copy_memory(out_bytes.elements() + field_table_offset, field_records.elements(), field_records.count() * sizeof(BinarySceneFieldRecord));
+    copy_memory(
+        out_bytes.elements() + value_range_table_offset,
+        value_range_records.elements(),
+        value_range_records.count() * sizeof(BinarySceneValueRangeRecord)
+    );
+}
+
+//==============================================================================================================
+// DESERIALIZATION.
+//==============================================================================================================
+
+// The number of component instances decoded at once by a worker thread. Large enough to make the cost of fetching the
+// jobs insignificant, but small enough for the jobs to be evenly distributed between the workers.
+static constexpr u32 s_decode_job_instance_count = 1024;
+
+// For smaller scenes starting the worker threads takes longer than decoding all the components on the calling thread.
+static constexpr usize s_parallel_decode_min_instance_count = 4096;
+
+struct BinarySceneComponentTypeContext
+{
+    const BinarySceneComponentTypeRecord* record { nullptr };
+    const ComponentReflector* reflector { nullptr };
+    const BinarySceneFieldRecord* field_records { nullptr };
+    const BinarySceneValueRangeRecord* value_range_records { nullptr };
+    StringView name;
+    ComponentFieldRemapTable field_remap_table;
+    // True if the saved value ranges are exactly the steps of the serialization plan of the component type.
+    bool is_plan_layout { false };
+    // The index in the staged components array of the first instance of the component type.
+    usize first_staged_component_index { 0 };
+};
+
+struct BinarySceneDecodeJob
+{
+    u32 component_type_context_index;
+    u32 first_instance_index;
+    u32 instance_count;
+};
+
+// State shared by all the threads that decode the components of a binary scene.
+struct BinarySceneDecodeState
+{
+    ReadonlyByteSpan bytes;
+    const BinarySceneHeader* header { nullptr };
+    Scene* scene_context { nullptr };
+    const Vector<Entity*>* entities { nullptr };
+    const Vector<BinarySceneComponentTypeContext>* component_type_contexts { nullptr };
+    const Vector<BinarySceneDecodeJob>* jobs { nullptr };
+    // Each component instance has its own slot in the array, so the workers never write to the same element.
+    Vector<EntityComponent*>* staged_components { nullptr };
+    Atomic<u32> next_job_index;
+    Atomic<u32> has_failed;
+};
+
+static bool read_binary_string(ReadonlyByteSpan bytes, const BinarySceneHeader& header, BinarySceneStringReference string_reference, StringView& out_string)
+{
+    if (string_reference.offset > header.string_table_byte_count || string_reference.byte_count > header.string_table_byte_count - string_reference.offset)
+        return false;
+
+    const ReadonlyByteSpan string_bytes = bytes.slice(header.string_table_offset + string_reference.offset, string_reference.byte_count);
+    if (!UTF8::check_validity(string_bytes))
+        return false;
+
+    out_string = StringView::unsafe_create_from_utf8(reinterpret_cast<const char*>(string_bytes.elements()), string_bytes.count());
+    return true;
+}
+
+static bool read_binary_string_value(const BinarySceneDecodeState& state, const u8* value, String& out_string)
+{
+    BinarySceneStringReference string_reference;
+    copy_memory(&string_reference, value, sizeof(BinarySceneStringReference));
+
+    StringView string_value;
+    if (!read_binary_string(state.bytes, *state.header, string_reference, string_value))
+        return false;
+    out_string = string_value;
+    return true;
+}
+
+// Instantiates and decodes the component instances of the given job. Only the staged components array is written.
+static bool decode_binary_components(BinarySceneDecodeState& state, const BinarySceneDecodeJob& job)
+{
+    const BinarySceneComponentTypeContext& context = (*state.component_type_contexts)[job.component_type_context_index];
+    const ComponentReflector& reflector = *context.reflector;
+    const ComponentSerializationPlan& plan = reflector.serialization_plan;
+    const u32* entity_indices = reinterpret_cast<const u32*>(state.bytes.elements() + context.record->entity_indices_offset);
+
+    for (u32 instance_index = job.first_instance_index; instance_index < job.first_instance_index + job.instance_count; ++instance_index)
+    {
+        // NOTE: The entity indices have been validated before the entities were created.
+        const u32 entity_index = entity_indices[instance_index];
+        void* component_memory = ::operator new(reflector.structure_byte_count);
+
+        EntityComponentInitializer initializer = {};
+        initializer.parent_entity = (*state.entities)[entity_index];
+        initializer.scene_context = state.scene_context;
+        reflector.instantiate_function(component_memory, initializer);
+        EntityComponent* component = static_cast<EntityComponent*>(component_memory);
+        (*state.staged_components)[context.first_staged_component_index + instance_index] = component;
+        u8* component_bytes = static_cast<u8*>(component_memory);
+
+        if (context.is_plan_layout)
+        {
+            for (u32 step_index = 0; step_index < plan.steps.count(); ++step_index)
+            {
+                const ComponentSerializationStep& step = plan.steps[step_index];
+                const BinarySceneValueRangeRecord& value_range_record = context.value_range_records[step_index];
+                const u8* element =
+                    state.bytes.elements() + value_range_record.values_offset + static_cast<usize>(instance_index) * value_range_record.element_byte_count;
+
+                if (step.type == ComponentSerializationStepType::String)
+                {
+                    if (!read_binary_string_value(state, element, *reinterpret_cast<String*>(component_bytes + step.byte_offset)))
+                    {
+                        SE_LOG_TAG_ERROR("Scene", "Binary scene is corrupted! Invalid string value for component type '{}'.", context.name);
+                        return false;
+                    }
+                    continue;
+                }
+
+                copy_memory(component_bytes + step.byte_offset, element, step.byte_count);
+            }
+
+            continue;
+        }
+
+        for (u32 field_index = 0; field_index < context.record->field_count; ++field_index)
+        {
+            if (!context.field_remap_table.field_indices[field_index].has_value())
+                continue;
+
+            const BinarySceneFieldRecord& field_record = context.field_records[field_index];
+            const BinarySceneValueRangeRecord& value_range_record = context.value_range_records[field_record.value_range_index];
+            const ComponentField& field = reflector.fields[context.field_remap_table.field_indices[field_index].value()];
+            const u8* value = state.bytes.elements() + value_range_record.values_offset +
+                              static_cast<usize>(instance_index) * value_range_record.element_byte_count + field_record.byte_offset_in_value_range;
+
+            if (field_record.type == ComponentFieldType::String)
+            {
+                if (!read_binary_string_value(state, value, field.get_value<String>(component)))
+                {
+                    SE_LOG_TAG_ERROR("Scene", "Binary scene is corrupted! Invalid string value for component type '{}'.", context.name);
+                    return false;
+                }
+                continue;
+            }
+
+            copy_memory(&field.get_value<u8>(component), value, get_binary_value_byte_count(field_record.type));
+        }
+    }
+
+    return true;
+}
+
+static void decode_binary_components_worker(void* user_data)
+{
+    BinarySceneDecodeState& state = *static_cast<BinarySceneDecodeState*>(user_data);
+
+    while (state.has_failed.load(MemoryOrder::Relaxed) == 0)
+    {
+        const u32 job_index = state.next_job_index.fetch_add(1, MemoryOrder::Relaxed);
+        if (job_index >= state.jobs->count())
+            break;
+
+        if (!decode_binary_components(state, (*state.jobs)[job_index]))
+            state.has_failed.store(1, MemoryOrder::Relaxed);
+    }
+}
+
+bool BinarySceneSerializer::deserialize(const String& filepath)
+{
+    MemoryMappedFile scene_file;
+    if (scene_file.open(filepath) != FileError::Success)
+    {
+        SE_LOG_TAG_ERROR("Scene", "Failed to open the binary scene file '{}'!", filepath);
+        return false;
+    }
+
+    if (!deserialize_from_memory(scene_file.bytes()))
+    {
+        SE_LOG_TAG_ERROR("Scene", "Failed to deserialize the binary scene file '{}'!", filepath);
+        return false;
+    }
+
+    return true;
+}
+
+bool BinarySceneSerializer::deserialize_from_memory(ReadonlyByteSpan bytes)
+{
+    const auto is_range_valid = [&bytes](u64 offset, u64 byte_count) -> bool
+    {
+        return (offset <= bytes.count()) && (byte_count <= bytes.count() - offset) && (offset % binary_scene_alignment == 0);
+    };
+
+    if (bytes.count() < sizeof(BinarySceneHeader))
+    {
+        SE_LOG_TAG_ERROR("Scene", "Binary scene is corrupted! The header is incomplete.");
+        return false;
+    }
+
+    const BinarySceneHeader& header = *reinterpret_cast<const BinarySceneHeader*>(bytes.elements());
+    if (header.magic != binary_scene_magic || header.version != binary_scene_version)
+    {
+        SE_LOG_TAG_ERROR("Scene", "Binary scene has an invalid signature or an unsupported version ({})!", header.version);
+        return false;
+    }
+
+    if (!is_range_valid(header.entity_table_offset, static_cast<u64>(header.entity_count) * sizeof(BinarySceneEntityRecord)) ||
+        !is_range_valid(header.component_type_table_offset, static_cast<u64>(header.component_type_count) * sizeof(BinarySceneComponentTypeRecord)) ||
+        !is_range_valid(header.field_table_offset, static_cast<u64>(header.field_count) * sizeof(BinarySceneFieldRecord)) ||
+        !is_range_valid(header.value_range_table_offset, static_cast<u64>(header.value_range_count) * sizeof(BinarySceneValueRangeRecord)) ||
+        !is_range_valid(header.string_table_offset, header.string_table_byte_count))
+    {
+        SE_LOG_TAG_ERROR("Scene", "Binary scene is corrupted! The tables are out of bounds.");
+        return false;
+    }
+
+    const auto* entity_records = reinterpret_cast<const BinarySceneEntityRecord*>(bytes.elements() + header.entity_table_offset);
+    const auto* component_type_records = reinterpret_cast<const BinarySceneComponentTypeRecord*>(bytes.elements() + header.component_type_table_offset);
+    const auto* field_records = reinterpret_cast<const BinarySceneFieldRecord*>(bytes.elements() + header.field_table_offset);
+    const auto* value_range_records = reinterpret_cast<const BinarySceneValueRangeRecord*>(bytes.elements() + header.value_range_table_offset);
+
+    const auto get_string = [&](BinarySceneStringReference string_reference, StringView& out_string) -> bool
+    {
+        return read_binary_string(bytes, header, string_reference, out_string);
+    };
+
+    //
+    // The scene is loaded in three phases:
+    //   1. The entity records and the schema of each component type are validated and the schema is matched against its
+    //      reflector. The entities are created only once all the records are known to be valid.
+    //   2. The component instances are split in jobs, which are decoded by worker threads into a staging array.
+    //   3. The decoded components are attached to their parent entities, in the order in which they were saved.
+    // Only the second phase touches the bulk of the data, while the first and last phases are short serial loops. If the
+    // second phase fails (a string value is corrupted) the entities created by the first phase are destroyed, so the scene
+    // is left unchanged.
+    //
+
+    HashMap<UUID, u32> entity_record_indices;
+    entity_record_indices.reserve(header.entity_count);
+    Vector<StringView> entity_names;
+    entity_names.set_fixed_capacity(header.entity_count);
+    for (u32 entity_index = 0; entity_index < header.entity_count; ++entity_index)
+    {
+        const BinarySceneEntityRecord& entity_record = entity_records[entity_index];
+        const UUID entity_uuid = UUID(entity_record.uuid);
+        StringView entity_name;
+        if (entity_uuid == UUID::invalid() || !get_string(entity_record.name, entity_name))
+        {
+            SE_LOG_TAG_ERROR("Scene", "Binary scene is corrupted! Invalid entity record ({}).", entity_index);
+            return false;
+        }
+
+        if (entity_record_indices.contains(entity_uuid) || m_scene_context.get_entity_from_uuid(entity_uuid) != nullptr)
+        {
+            SE_LOG_TAG_ERROR("Scene", "Binary scene contains an entity whose UUID ({}) is already used!", entity_uuid);
+            return false;
+        }
+        entity_record_indices.add(entity_uuid, entity_index);
+        entity_names.add(entity_name);
+    }
+
+    Vector<BinarySceneComponentTypeContext> component_type_contexts;
+    Vector<BinarySceneDecodeJob> jobs;
+    usize staged_component_count = 0;
+    // The saved schema of the current component type, used to build its remap table.
+    Vector<ComponentFieldDescription> saved_fields;
+
+    for (u32 component_type_index = 0; component_type_index < header.component_type_count; ++component_type_index)
+    {
+        const BinarySceneComponentTypeRecord& component_type_record = component_type_records[component_type_index];
+        const u32 instance_count = component_type_record.instance_count;
+
+        StringView component_type_name;
+        if (!get_string(component_type_record.name, component_type_name) ||
+            static_cast<u64>(component_type_record.first_field_index) + component_type_record.field_count > header.field_count ||
+            static_cast<u64>(component_type_record.first_value_range_index) + component_type_record.value_range_count > header.value_range_count ||
+            !is_range_valid(component_type_record.entity_indices_offset, static_cast<u64>(instance_count) * sizeof(u32)))
+        {
+            SE_LOG_TAG_ERROR("Scene", "Binary scene is corrupted! Invalid component type record ({}).", component_type_index);
+            return false;
+        }
+
+        const u32* entity_indices = reinterpret_cast<const u32*>(bytes.elements() + component_type_record.entity_indices_offset);
+        for (u32 instance_index = 0; instance_index < instance_count; ++instance_index)
+        {
+            if (entity_indices[instance_index] >= header.entity_count)
+            {
+                SE_LOG_TAG_ERROR("Scene", "Binary scene is corrupted! Invalid entity index for component type '{}'.", component_type_name);
+                return false;
+            }
+        }
+
+        const ComponentReflector* reflector = m_component_reflector_registry_context.try_get_reflector(UUID(component_type_record.type_uuid));
+        if (reflector == nullptr)
+        {
+            SE_LOG_TAG_WARN("Scene", "Component type '{}' no longer exists. Skipping its {} instances...", component_type_name, instance_count);
+            continue;
+        }
+
+        BinarySceneComponentTypeContext& context = component_type_contexts.emplace();
+        context.record = &component_type_record;
+        context.reflector = reflector;
+        context.field_records = field_records + component_type_record.first_field_index;
+        context.value_range_records = value_range_records + component_type_record.first_value_range_index;
+        context.name = component_type_name;
+        context.first_staged_component_index = staged_component_count;
+
+        for (u32 value_range_index = 0; value_range_index < component_type_record.value_range_count; ++value_range_index)
+        {
+            const BinarySceneValueRangeRecord& value_range_record = context.value_range_records[value_range_index];
+            if (!is_range_valid(value_range_record.values_offset, static_cast<u64>(instance_count) * value_range_record.element_byte_count))
+            {
+                SE_LOG_TAG_ERROR("Scene", "Binary scene is corrupted! Invalid value range record for component type '{}'.", component_type_name);
+                return false;
+            }
+        }
+
+        // Match the saved schema against the current reflector, once for all the instances of the component type.
+        saved_fields.clear();
+        for (u32 field_index = 0; field_index < component_type_record.field_count; ++field_index)
+        {
+            const BinarySceneFieldRecord& field_record = context.field_records[field_index];
+            ComponentFieldDescription& saved_field = saved_fields.emplace();
+            saved_field.type = field_record.type;
+
+            // NOTE: The size of the unknown (or invalid) field types is zero.
+            StringView field_name;
+            const u32 value_byte_count = get_binary_value_byte_count(field_record.type);
+            if (!get_string(field_record.name, field_name) || value_byte_count == 0 ||
+                field_record.value_range_index >= component_type_record.value_range_count ||
+                static_cast<u64>(field_record.byte_offset_in_value_range) + value_byte_count >
+                    context.value_range_records[field_record.value_range_index].element_byte_count)
+            {
+                SE_LOG_TAG_ERROR("Scene", "Binary scene is corrupted! Invalid field record for component type '{}'.", component_type_name);
+                return false;
+            }
+
+            // A name that has never been interned can't be the name of any reflected field, so it is not added to the name table.
+            saved_field.name = Name::find(field_name).value_or(Name());
+        }
+
+        reflector->build_field_remap_table(Span<const ComponentFieldDescription>(saved_fields.elements(), saved_fields.count()), context.field_remap_table);
+
+        // When the saved fields are the fields of the plan, in the same order and with the same sizes, the saved value
+        // ranges are exactly the steps of the plan and each of them can be loaded with a single memory copy.
+        const ComponentSerializationPlan& plan = reflector->serialization_plan;
+        context.is_plan_layout = context.field_remap_table.is_identity && (component_type_record.value_range_count == plan.steps.count());
+        for (u32 step_index = 0; context.is_plan_layout && step_index < plan.steps.count(); ++step_index)
+            context.is_plan_layout = (context.value_range_records[step_index].element_byte_count == get_binary_step_byte_count(plan.steps[step_index]));
+
+        for (u32 first_instance_index = 0; first_instance_index < instance_count; first_instance_index += s_decode_job_instance_count)
+        {
+            BinarySceneDecodeJob& job = jobs.emplace();
+            job.component_type_context_index = static_cast<u32>(component_type_contexts.count() - 1);
+            job.first_instance_index = first_instance_index;
+            job.instance_count = Math::min(s_decode_job_instance_count, instance_count - first_instance_index);
+        }
+
+        staged_component_count += instance_count;
+    }
+
+    // The entity table is grown only once, instead of being re-hashed repeatedly while the entities are added.
+    m_scene_context.reserve_entities(m_scene_context.get_entity_count() + header.entity_count);
+
+    Vector<Entity*> entities;
+    entities.set_fixed_capacity(header.entity_count);
+    for (u32 entity_index = 0; entity_index < header.entity_count; ++entity_index)
+    {
+        Entity* entity = m_scene_context.create_entity_with_uuid(UUID(entity_records[entity_index].uuid));
+        entity->set_name(entity_names[entity_index]);
+        entities.add(entity);
+    }
+
+    // NOTE: The staged components are initialized to null pointers, so the components that have not been decoded when
+    //       a job fails can be deleted together with the decoded ones.
+    Vector<EntityComponent*> staged_components;
+    staged_components.set_count(staged_component_count);
+
+    BinarySceneDecodeState decode_state;
+    decode_state.bytes = bytes;
+    decode_state.header = &header;
+    decode_state.scene_context = &m_scene_context;
+    decode_state.entities = &entities;
+    decode_state.component_type_contexts = &component_type_contexts;
+    decode_state.jobs = &jobs;
+    decode_state.staged_components = &staged_components;
+
+    // The calling thread decodes components as well, so only the additional worker threads are started.
+    u32 worker_thread_count = 0;
+    if (staged_component_count >= s_parallel_decode_min_instance_count)
+    {
+        const u32 max_thread_count = (m_max_decode_thread_count > 0) ? m_max_decode_thread_count : Math::max(Thread::get_hardware_concurrency(), 1U);
+        worker_thread_count = Math::min(max_thread_count, static_cast<u32>(jobs.count())) - 1;
+    }
+
+    Vector<OwnPtr<Thread>> worker_threads;
+    worker_threads.set_fixed_capacity(worker_thread_count);
+    for (u32 worker_index = 0; worker_index < worker_thread_count; ++worker_index)
+    {
+        OwnPtr<Thread> worker_thread = create_own<Thread>();
+        // If a worker can't be started its jobs are simply decoded by the other threads.
+        if (worker_thread->start(decode_binary_components_worker, &decode_state, "SceneDecodeWorker"sv))
+            worker_threads.add(move(worker_thread));
+    }
+
+    decode_binary_components_worker(&decode_state);
+    for (OwnPtr<Thread>& worker_thread : worker_threads)
+        worker_thread->join();
+
+    if (decode_state.has_failed.load() != 0)
+    {
+        for (EntityComponent* component : staged_components)
+            delete component;
+        for (Entity* entity : entities)
+            m_scene_context.destroy_entity(entity->uuid());
+        return false;
+    }
+
+    for (const BinarySceneComponentTypeContext& context : component_type_contexts)
+    {
+        const u32* entity_indices = reinterpret_cast<const u32*>(bytes.elements() + context.record->entity_indices_offset);
+        for (u32 instance_index = 0; instance_index < context.record->instance_count; ++instance_index)
+            entities[entity_indices[instance_index]]->add_component(staged_components[context.first_staged_component_index + instance_index]);
+    }
+
+    // The component fields are written directly in memory, so the entity bounds must be recalculated.
+    for (Entity* entity : entities)
+        m_scene_context.update_entity_spatial_bounds(*entity);
+
+    return true;
+}
+
+} // namespace SE
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/Containers/Span.h>
+#include <Core/Containers/Vector.h>
+#include <Core/String/String.h>
+#include <Engine/Scene/Reflection/ComponentReflector.h>
+
+namespace SE
+{
+
+// Forward declarations.
+class Scene;
+class ComponentReflectorRegistry;
+
+//
+// Layout of the binary scene file. All offsets are relative to the beginning of the file and all the
+// arrays are aligned to `binary_scene_alignment` bytes, so they can be read directly from the mapped file.
+//
+// The file starts with a header, followed by the entity table and the schema of the saved component types (built from
+// their reflectors). The field values are not interleaved per component: each step of the serialization plan of a component
+// type (a run of adjacent fields that are copied together, a string or an asset reference) has its own contiguous
+// array of values, with one element for each instance of the component type. String values are stored as references
+// into the string table, which is placed at the end of the file.
+//
+static constexpr u32 binary_scene_magic = 0x42534553; // 'SESB'
+static constexpr u32 binary_scene_version = 2;
+static constexpr u64 binary_scene_alignment = 8;
+
+struct BinarySceneStringReference
+{
+    u32 offset;
+    u32 byte_count;
+};
+
+struct BinarySceneHeader
+{
+    u32 magic;
+    u32 version;
+    u64 scene_uuid;
+    u32 entity_count;
+    u32 component_type_count;
+    u32 field_count;
+    u32 value_range_count;
+    u64 entity_table_offset;
+    u64 component_type_table_offset;
+    u64 field_table_offset;
+    u64 value_range_table_offset;
+    u64 string_table_offset;
+    u64 string_table_byte_count;
+};
+
+struct BinarySceneEntityRecord
+{
+    u64 uuid;
+    BinarySceneStringReference name;
+};
+
+struct BinarySceneComponentTypeRecord
+{
+    u64 type_uuid;
+    BinarySceneStringReference name;
+    // The fields of the component type are stored contiguously in the field table.
+    u32 first_field_index;
+    u32 field_count;
+    // The value ranges of the component type are stored contiguously in the value range table.
+    u32 first_value_range_index;
+    u32 value_range_count;
+    u32 instance_count;
+    u32 reserved;
+    // Array of `instance_count` u32 values, storing the index (in the entity table) of the parent entity of each instance.
+    u64 entity_indices_offset;
+};
+
+struct BinarySceneFieldRecord
+{
+    BinarySceneStringReference name;
+    ComponentFieldType type;
+    u16 reserved;
+    // Index of the value range that stores the values of this field, relative to the first value range of the component type.
+    u32 value_range_index;
+    // The offset of the field value within each element of the value range.
+    u32 byte_offset_in_value_range;
+    u32 reserved_2;
+};
+
+struct BinarySceneValueRangeRecord
+{
+    // The number of bytes occupied by each element of the values array.
+    u32 element_byte_count;
+    u32 reserved;
+    // Array of `instance_count` elements, tightly packed.
+    u64 values_offset;
+};
+
+static_assert(sizeof(BinarySceneHeader) == 80);
+static_assert(sizeof(BinarySceneEntityRecord) == 16);
+static_assert(sizeof(BinarySceneComponentTypeRecord) == 48);
+static_assert(sizeof(BinarySceneFieldRecord) == 24);
+static_assert(sizeof(BinarySceneValueRangeRecord) == 16);
+
+//
+// Serializer for the binary runtime scene format. Loading a scene maps the file in memory and copies the values
+// following the serialization plans of the component types, without any parsing or string comparison per component
+// instance. The saved fields are matched against the current component reflectors only once per component type: when
+// the schema is unchanged each value range is copied with a single memory copy, otherwise the fields are remapped
+// individually, so fields that have been reordered are still loaded correctly and fields that no longer exist are skipped.
+//
+class BinarySceneSerializer
+{
+    SE_MAKE_NONCOPYABLE(BinarySceneSerializer);
+    SE_MAKE_NONMOVABLE(BinarySceneSerializer);
+
+public:
+    ALWAYS_INLINE explicit BinarySceneSerializer(Scene& scene_context, const ComponentReflectorRegistry& component_reflector_registry_context)
+        : m_scene_context(scene_context)
+        , m_component_reflector_registry_context(component_reflector_registry_context)
+    {}
+
+    SHOOTER_API bool serialize(const String& filepath);
+    SHOOTER_API bool deserialize(const String& filepath);
+
+    // Writes the scene to the given byte array, using the same layout as the binary scene files.
+    SHOOTER_API void serialize_to_memory(Vector<u8>& out_bytes);
+
+    // The given bytes must remain valid until the function returns. No references to them are kept. If the bytes are
+    // corrupted, or an entity has the UUID of an entity that already exists in the scene, the scene is left unchanged.
+    SHOOTER_API bool deserialize_from_memory(ReadonlyByteSpan bytes);
+
+    // Limits the number of threads (including the calling thread) that decode the components of the loaded scene.
+    // By default (zero) one thread is used for each hardware thread.
+    ALWAYS_INLINE void set_max_decode_thread_count(u32 max_decode_thread_count) { m_max_decode_thread_count = max_decode_thread_count; }
+
+private:
+    Scene& m_scene_context;
+    const ComponentReflectorRegistry& m_component_reflector_registry_context;
+    u32 m_max_decode_thread_count { 0 };
+};
+
+} // namespace SE
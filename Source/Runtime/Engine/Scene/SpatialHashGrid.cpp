@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/Math/MathCore.h>
+#include <Engine/Scene/SpatialHashGrid.h>
+
+namespace SE
+{
+
+// NOTE: Cell coordinates are clamped to this range, so that extremely large (or infinite) bounds
+//       don't overflow the 32-bit cell coordinates.
+static constexpr float s_max_cell_coordinate = 1073741824.0F;
+
+static i32 world_to_cell_coordinate(float world_coordinate, float inverse_cell_size)
+{
+    float cell_coordinate = world_coordinate * inverse_cell_size;
+    cell_coordinate = Math::clamp(cell_coordinate, -s_max_cell_coordinate, s_max_cell_coordinate);
+
+    // Round towards negative infinity, so that the cell (0, 0) doesn't cover the range (-1, 1).
+    i32 result = static_cast<i32>(cell_coordinate);
+    if (static_cast<float>(result) > cell_coordinate)
+        --result;
+    return result;
+}
+
+static void remove_item_index(Vector<u32>& item_indices, u32 item_index)
+{
+    for (usize index = 0; index < item_indices.count(); ++index)
+    {
+        if (item_indices[index] == item_index)
+        {
+            item_indices.remove_unordered(index);
+            return;
+        }
+    }
+    SE_ASSERT(false);
+}
+
+SpatialHashGrid::SpatialHashGrid(float cell_size /*= default_cell_size*/)
+    : m_inverse_cell_size(1.0F / cell_size)
+    , m_item_count(0)
+    , m_query_stamp(0)
+{
+    SE_ASSERT(cell_size > 0.0F);
+}
+
+SpatialHashGrid::~SpatialHashGrid()
+{
+    clear();
+}
+
+void SpatialHashGrid::insert_or_update(Entity* entity, const SpatialBounds& bounds)
+{
+    SE_ASSERT(entity != nullptr);
+    const CellRange cell_range = get_cell_range(bounds);
+
+    Optional<u32&> existing_item_index = m_entity_to_item_index.get_if_exists(entity);
+    if (existing_item_index.has_value())
+    {
+        const u32 item_index = existing_item_index.value();
+        Item& item = m_items[item_index];
+        item.bounds = bounds;
+
+        // The entity still overlaps exactly the same cells, so only its bounds have to be updated.
+        if (item.cell_range == cell_range)
+            return;
+
+        remove_item_from_cells(item_index, item.cell_range);
+        item.cell_range = cell_range;
+        add_item_to_cells(item_index, item.cell_range);
+        return;
+    }
+
+    u32 item_index;
+    if (m_free_item_indices.has_elements())
+    {
+        item_index = m_free_item_indices.last();
+        m_free_item_indices.remove_last();
+    }
+    else
+    {
+        item_index = static_cast<u32>(m_items.count());
+        m_items.emplace();
+    }
+
+    Item& item = m_items[item_index];
+    item.entity = entity;
+    item.bounds = bounds;
+    item.cell_range = cell_range;
+    item.query_stamp = 0;
+
+    m_entity_to_item_index.add(entity, item_index);
+    add_item_to_cells(item_index, item.cell_range);
+    ++m_item_count;
+}
+
+void SpatialHashGrid::remove(Entity* entity)
+{
+    Optional<u32&> existing_item_index = m_entity_to_item_index.get_if_exists(entity);
+    if (!existing_item_index.has_value())
+        return;
+
+    const u32 item_index = existing_item_index.value();
+    m_entity_to_item_index.remove(entity);
+
+    Item& item = m_items[item_index];
+    remove_item_from_cells(item_index, item.cell_range);
+    item.entity = nullptr;
+
+    m_free_item_indices.add(item_index);
+    --m_item_count;
+}
+
+void SpatialHashGrid::clear()
+{
+    m_items.clear_and_shrink();
+    m_free_item_indices.clear_and_shrink();
+    m_oversized_item_indices.clear_and_shrink();
+    m_item_count = 0;
+
+    m_entity_to_item_index.clear_and_shrink();
+    m_cells.clear_and_shrink();
+}
+
+SpatialHashGrid::CellRange SpatialHashGrid::get_cell_range(const SpatialBounds& bounds) const
+{
+    CellRange cell_range;
+    cell_range.min_x = world_to_cell_coordinate(bounds.min.x, m_inverse_cell_size);
+    cell_range.min_y = world_to_cell_coordinate(bounds.min.y, m_inverse_cell_size);
+    cell_range.max_x = world_to_cell_coordinate(bounds.max.x, m_inverse_cell_size);
+    cell_range.max_y = world_to_cell_coordinate(bounds.max.y, m_inverse_cell_size);
+    return cell_range;
+}
+
+void SpatialHashGrid::begin_query() const
+{
+    ++m_query_stamp;
+    if (m_query_stamp == 0)
+    {
+        // The query stamp has wrapped around, so the stamps stored in the items are no longer meaningful.
+        for (const Item& item : m_items)
+            item.query_stamp = 0;
+        m_query_stamp = 1;
+    }
+}
+
+void SpatialHashGrid::add_item_to_cells(u32 item_index, const CellRange& cell_range)
+{
+    if (cell_range.get_cell_count() > max_cells_per_item)
+    {
+        m_oversized_item_indices.add(item_index);
+        return;
+    }
+
+    for (i32 cell_y = cell_range.min_y; cell_y <= cell_range.max_y; ++cell_y)
+    {
+        for (i32 cell_x = cell_range.min_x; cell_x <= cell_range.max_x; ++cell_x)
+        {
+            Vector<u32>& cell_items = m_cells.get_or_add(get_cell_key(cell_x, cell_y));
+            cell_items.add(item_index);
+        }
+    }
+}
+
+void SpatialHashGrid::remove_item_from_cells(u32 item_index, const CellRange& cell_range)
+{
+    if (cell_range.get_cell_count() > max_cells_per_item)
+    {
+        remove_item_index(m_oversized_item_indices, item_index);
+        return;
+    }
+
+    for (i32 cell_y = cell_range.min_y; cell_y <= cell_range.max_y; ++cell_y)
+    {
+        for (i32 cell_x = cell_range.min_x; cell_x <= cell_range.max_x; ++cell_x)
+        {
+            const u64 cell_key = get_cell_key(cell_x, cell_y);
+            Optional<Vector<u32>&> cell_items = m_cells.get_if_exists(cell_key);
+            SE_ASSERT(cell_items.has_value());
+
+            Vector<u32>& items = cell_items.value();
+            remove_item_index(items, item_index);
+
+            // Release the cells that no longer contain any entity, so that the number of allocated cells
+            // is always proportional to the number of entities in the grid.
+            if (items.is_empty())
+                m_cells.remove(cell_key);
+        }
+    }
+}
+
+} // namespace SE
@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/Containers/HashMap.h>
+#include <Core/Containers/Vector.h>
+#include <Core/Math/Vector.h>
+#include <Core/Misc/IterationDecision.h>
+
+namespace SE
+{
+
+// Forward declarations.
+class Entity;
+
+//
+// Axis-aligned bounding box in the XY plane of the world.
+//
+struct SpatialBounds
+{
+    Vector2 min;
+    Vector2 max;
+
+    NODISCARD ALWAYS_INLINE bool intersects(const SpatialBounds& other) const
+    {
+        return (min.x <= other.max.x && max.x >= other.min.x) && (min.y <= other.max.y && max.y >= other.min.y);
+    }
+};
+
+//
+// Uniform spatial hash grid that stores the bounds of entities in the XY plane of the world.
+// The world is divided into square cells of a fixed size, and only the cells that contain at least
+// one entity are allocated (as entries in a hash map keyed by the packed cell coordinates).
+//
+// The grid is updated incrementally: when the bounds of an entity change only the cells that it
+// leaves or enters are modified. Querying a region only visits the cells that overlap it, so the
+// cost is proportional to the number of entities that are (almost) inside the region and not to
+// the total number of entities in the scene.
+//
+class SpatialHashGrid
+{
+    SE_MAKE_NONCOPYABLE(SpatialHashGrid);
+    SE_MAKE_NONMOVABLE(SpatialHashGrid);
+
+public:
+    static constexpr float default_cell_size = 16.0F;
+
+    // Entities that overlap more cells than this value are not inserted in the cells. Instead, they are stored
+    // in a separate list that is tested by every query, so huge entities don't allocate an unbounded number of cells.
+    static constexpr u64 max_cells_per_item = 64;
+
+public:
+    SHOOTER_API explicit SpatialHashGrid(float cell_size = default_cell_size);
+    SHOOTER_API ~SpatialHashGrid();
+
+    // Returns the number of entities that are stored in the grid.
+    NODISCARD ALWAYS_INLINE u32 get_entity_count() const { return m_item_count; }
+
+public:
+    //
+    // Inserts the entity in the grid or, if it already exists, moves it so it matches the new bounds.
+    // If the bounds are identical to the ones currently stored in the grid no work is done.
+    //
+    SHOOTER_API void insert_or_update(Entity* entity, const SpatialBounds& bounds);
+
+    // Removes the entity from the grid. If the entity doesn't exist in the grid this function does nothing.
+    SHOOTER_API void remove(Entity* entity);
+
+    SHOOTER_API void clear();
+
+    //
+    // Invokes the given predicate for each entity whose bounds intersect the query bounds. Each entity is
+    // visited at most once, even if it spans multiple cells.
+    // The predicate signature should be: IterationDecision(Entity* entity).
+    //
+    template<typename EntityPredicate>
+    void query(const SpatialBounds& query_bounds, EntityPredicate entity_predicate) const
+    {
+        if (m_item_count == 0)
+            return;
+
+        begin_query();
+        const CellRange query_range = get_cell_range(query_bounds);
+
+        const auto visit_cell = [&](const Vector<u32>& cell_items) -> IterationDecision
+        {
+            for (u32 item_index : cell_items)
+            {
+                const Item& item = m_items[item_index];
+                if (item.query_stamp == m_query_stamp)
+                    continue;
+                item.query_stamp = m_query_stamp;
+
+                if (!item.bounds.intersects(query_bounds))
+                    continue;
+
+                if (entity_predicate(item.entity) == IterationDecision::Break)
+                    return IterationDecision::Break;
+            }
+            return IterationDecision::Continue;
+        };
+
+        if (visit_cell(m_oversized_item_indices) == IterationDecision::Break)
+            return;
+
+        // NOTE: When the query region is very large compared to the populated area of the world (for example,
+        //       a zoomed-out camera) it is cheaper to walk the allocated cells than every cell in the region.
+        if (query_range.get_cell_count() > static_cast<u64>(m_cells.count()))
+        {
+            for (auto cell_it : m_cells)
+            {
+                const i32 cell_x = get_cell_x_from_key(cell_it.key);
+                const i32 cell_y = get_cell_y_from_key(cell_it.key);
+                if (!query_range.contains(cell_x, cell_y))
+                    continue;
+
+                if (visit_cell(cell_it.value) == IterationDecision::Break)
+                    return;
+            }
+            return;
+        }
+
+        for (i32 cell_y = query_range.min_y; cell_y <= query_range.max_y; ++cell_y)
+        {
+            for (i32 cell_x = query_range.min_x; cell_x <= query_range.max_x; ++cell_x)
+            {
+                Optional<const Vector<u32>&> cell_items = m_cells.get_if_exists(get_cell_key(cell_x, cell_y));
+                if (!cell_items.has_value())
+                    continue;
+
+                if (visit_cell(cell_items.value()) == IterationDecision::Break)
+                    return;
+            }
+        }
+    }
+
+private:
+    struct CellRange
+    {
+        i32 min_x;
+        i32 min_y;
+        i32 max_x;
+        i32 max_y;
+
+        NODISCARD ALWAYS_INLINE bool operator==(const CellRange& other) const
+        {
+            return min_x == other.min_x && min_y == other.min_y && max_x == other.max_x && max_y == other.max_y;
+        }
+
+        NODISCARD ALWAYS_INLINE bool contains(i32 cell_x, i32 cell_y) const
+        {
+            return (cell_x >= min_x && cell_x <= max_x) && (cell_y >= min_y && cell_y <= max_y);
+        }
+
+        NODISCARD ALWAYS_INLINE u64 get_cell_count() const
+        {
+            const u64 width = static_cast<u64>(static_cast<i64>(max_x) - static_cast<i64>(min_x) + 1);
+            const u64 height = static_cast<u64>(static_cast<i64>(max_y) - static_cast<i64>(min_y) + 1);
+            return width * height;
+        }
+    };
+
+    struct Item
+    {
+        Entity* entity { nullptr };
+        SpatialBounds bounds;
+        CellRange cell_range;
+        // The stamp of the last query that visited this item. Used to report each item only once per query.
+        mutable u32 query_stamp { 0 };
+    };
+
+private:
+    NODISCARD ALWAYS_INLINE static u64 get_cell_key(i32 cell_x, i32 cell_y)
+    {
+        return (static_cast<u64>(static_cast<u32>(cell_x)) << 32) | static_cast<u64>(static_cast<u32>(cell_y));
+    }
+
+    NODISCARD ALWAYS_INLINE static i32 get_cell_x_from_key(u64 cell_key) { return static_cast<i32>(static_cast<u32>(cell_key >> 32)); }
+    NODISCARD ALWAYS_INLINE static i32 get_cell_y_from_key(u64 cell_key) { return static_cast<i32>(static_cast<u32>(cell_key)); }
+
+    NODISCARD SHOOTER_API CellRange get_cell_range(const SpatialBounds& bounds) const;
+
+    SHOOTER_API void begin_query() const;
+
+    void add_item_to_cells(u32 item_index, const CellRange& cell_range);
+    void remove_item_from_cells(u32 item_index, const CellRange& cell_range);
+
+private:
+    float m_inverse_cell_size;
+
+    // NOTE: The index of an item is stable for as long as the entity exists in the grid, so the cells only
+    //       store indices. Removed items are added to the free list and their slot is reused by the next inserted entity.
+    Vector<Item> m_items;
+    Vector<u32> m_free_item_indices;
+    Vector<u32> m_oversized_item_indices;
+    u32 m_item_count;
+
+    HashMap<Entity*, u32> m_entity_to_item_index;
+    HashMap<u64, Vector<u32>> m_cells;
+
+    mutable u32 m_query_stamp;
+};
+
+} // namespace SE
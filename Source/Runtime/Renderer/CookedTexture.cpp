@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/FileSystem/FileSystem.h>
+#include <Core/Log.h>
+#include <Core/Memory/Buffer.h>
+#include <Core/Memory/MemoryOperations.h>
+#include <Renderer/CookedTexture.h>
+
+namespace SE
+{
+
+RefPtr<Texture2D> CookedTexture::load(const String& filepath)
+{
+    FileReader file_reader;
+    Buffer file;
+    if (file_reader.open(filepath) != FileError::Success || file_reader.read_entire_and_close(file) != FileError::Success)
+    {
+        SE_LOG_TAG_ERROR("Renderer", "Failed to read the cooked texture '{}'!", filepath);
+        return {};
+    }
+
+    RefPtr<Texture2D> texture = create_from_memory(file.readonly_byte_span());
+    if (!texture.is_valid())
+        SE_LOG_TAG_ERROR("Renderer", "Invalid or corrupted cooked texture: '{}'!", filepath);
+    return texture;
+}
+
+RefPtr<Texture2D> CookedTexture::create_from_memory(ReadonlyByteSpan bytes)
+{
+    if (bytes.count() < sizeof(CookedTextureHeader))
+        return {};
+
+    CookedTextureHeader header;
+    copy_memory(&header, bytes.elements(), sizeof(CookedTextureHeader));
+    if (!is_header_valid(header, bytes.count() - sizeof(CookedTextureHeader)))
+        return {};
+
+    Texture2DDescription texture_description = {};
+    texture_description.width = header.width;
+    texture_description.height = header.height;
+    texture_description.format = header.format;
+    texture_description.mip_count = header.mip_count;
+    texture_description.data = bytes.slice(sizeof(CookedTextureHeader));
+    return Texture2D::create(texture_description);
+}
+
+Optional<CookedTextureHeader> CookedTexture::read_header(const String& filepath)
+{
+    if (!FileSystem::exists(filepath))
+        return {};
+
+    FileReader file_reader;
+    if (file_reader.open(filepath) != FileError::Success)
+        return {};
+
+    CookedTextureHeader header;
+    const WriteonlyByteSpan header_bytes = WriteonlyByteSpan(reinterpret_cast<WriteonlyBytes>(&header), sizeof(CookedTextureHeader));
+    const FileError read_error = file_reader.read(header_bytes, 0, sizeof(CookedTextureHeader));
+    const Optional<usize> file_size = FileSystem::get_file_size(filepath);
+    file_reader.close();
+
+    if (read_error != FileError::Success || !file_size.has_value() || file_size.value() < sizeof(CookedTextureHeader))
+        return {};
+    if (!is_header_valid(header, file_size.value() - sizeof(CookedTextureHeader)))
+        return {};
+
+    return header;
+}
+
+bool CookedTexture::is_header_valid(const CookedTextureHeader& header, usize data_byte_count)
+{
+    if (header.magic != cooked_texture_magic || header.version != cooked_texture_version)
+        return false;
+
+    switch (header.format)
+    {
+        case ImageFormat::RGBA8:
+        case ImageFormat::BGRA8:
+        case ImageFormat::BC1:
+        case ImageFormat::BC3:
+        case ImageFormat::BC7: break;
+        default: return false;
+    }
+
+    if (header.width == 0 || header.height == 0 || header.mip_count == 0 || header.mip_count > get_image_full_mip_count(header.width, header.height))
+        return false;
+    if (is_image_format_block_compressed(header.format) && (header.width % 4 != 0 || header.height % 4 != 0))
+        return false;
+
+    const usize expected_data_byte_count = get_image_mip_chain_byte_count(header.format, header.width, header.height, header.mip_count);
+    return (header.data_byte_count == expected_data_byte_count && data_byte_count == expected_data_byte_count);
+}
+
+} // namespace SE
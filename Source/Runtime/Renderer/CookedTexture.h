@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/Containers/Optional.h>
+#include <Core/Containers/RefPtr.h>
+#include <Core/String/String.h>
+#include <Renderer/Texture.h>
+
+namespace SE
+{
+
+//
+// Layout of the cooked texture file. The file starts with a header, immediately followed by the pixels of all the mip
+// levels of the texture, in the exact layout expected by `Texture2DDescription::data`. Loading a cooked texture is thus
+// a single file read, without any decoding or conversion of the pixels.
+//
+static constexpr u32 cooked_texture_magic = 0x58544553; // 'SETX'
+static constexpr u32 cooked_texture_version = 2;
+
+struct CookedTextureHeader
+{
+    u32 magic;
+    u32 version;
+    // The hash (XXH64, see `hash_memory`) of the contents of the source image file. The cooked texture must not be used
+    // if it doesn't match the hash of the current source image, as the image has changed since it was cooked.
+    u64 source_hash;
+    // The hash of the settings that were used to cook the texture. Used to detect if the texture has to be cooked again.
+    u64 settings_hash;
+    u32 width;
+    u32 height;
+    ImageFormat format;
+    u32 mip_count;
+    u64 data_byte_count;
+};
+
+static_assert(sizeof(CookedTextureHeader) == 48);
+
+class CookedTexture
+{
+public:
+    // Loads a cooked texture file and uploads it to the GPU. Returns an invalid reference if the file is corrupted.
+    NODISCARD SHOOTER_API static RefPtr<Texture2D> load(const String& filepath);
+
+    //
+    // Uploads a cooked texture that is already in memory (such as an entry of a memory mapped asset pack) to the GPU.
+    // Returns an invalid reference if the bytes don't form a valid cooked texture.
+    //
+    NODISCARD SHOOTER_API static RefPtr<Texture2D> create_from_memory(ReadonlyByteSpan bytes);
+
+    // Reads only the header of a cooked texture file. Returns an empty optional if the file doesn't exist or is not valid.
+    NODISCARD SHOOTER_API static Optional<CookedTextureHeader> read_header(const String& filepath);
+
+    // Returns true if the header is valid and describes a texture whose pixels occupy exactly the given number of bytes.
+    NODISCARD SHOOTER_API static bool is_header_valid(const CookedTextureHeader& header, usize data_byte_count);
+};
+
+} // namespace SE
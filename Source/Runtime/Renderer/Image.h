@@ -15,6 +15,12 @@ enum class ImageFormat : u32
     Unknown = 0,
     RGBA8,
     BGRA8,
+
+    // Block compressed formats. The pixels are stored in blocks of 4x4 pixels.
+    // https://learn.microsoft.com/en-us/windows/win32/direct3d11/texture-block-compression-in-direct3d-11
+    BC1,
+    BC3,
+    BC7,
 };
 
 enum class ImageFilteringMode : u32
@@ -30,4 +36,70 @@ enum class ImageAddressMode : u32
     MirrorRepeat,
 };
 
+NODISCARD ALWAYS_INLINE constexpr bool is_image_format_block_compressed(ImageFormat image_format)
+{
+    return (image_format == ImageFormat::BC1 || image_format == ImageFormat::BC3 || image_format == ImageFormat::BC7);
+}
+
+//
+// Returns the number of bytes of a pixel or, for block compressed formats, the number of bytes of a 4x4 block.
+//
+NODISCARD ALWAYS_INLINE constexpr u32 get_image_format_element_byte_count(ImageFormat image_format)
+{
+    switch (image_format)
+    {
+        case ImageFormat::Unknown: return 0;
+        case ImageFormat::RGBA8: return 4;
+        case ImageFormat::BGRA8: return 4;
+        case ImageFormat::BC1: return 8;
+        case ImageFormat::BC3: return 16;
+        case ImageFormat::BC7: return 16;
+    }
+
+    return 0;
+}
+
+// Returns the number of bytes of a row of pixels or, for block compressed formats, of a row of 4x4 blocks.
+NODISCARD ALWAYS_INLINE constexpr u32 get_image_row_pitch(ImageFormat image_format, u32 width)
+{
+    const u32 element_count = is_image_format_block_compressed(image_format) ? (width + 3) / 4 : width;
+    return element_count * get_image_format_element_byte_count(image_format);
+}
+
+// Returns the number of rows of pixels or, for block compressed formats, the number of rows of 4x4 blocks.
+NODISCARD ALWAYS_INLINE constexpr u32 get_image_row_count(ImageFormat image_format, u32 height)
+{
+    return is_image_format_block_compressed(image_format) ? (height + 3) / 4 : height;
+}
+
+NODISCARD ALWAYS_INLINE constexpr usize get_image_byte_count(ImageFormat image_format, u32 width, u32 height)
+{
+    return static_cast<usize>(get_image_row_pitch(image_format, width)) * static_cast<usize>(get_image_row_count(image_format, height));
+}
+
+// Returns the dimension of the given mip level, for an image whose largest mip has the given dimension.
+NODISCARD ALWAYS_INLINE constexpr u32 get_image_mip_dimension(u32 dimension, u32 mip_index)
+{
+    const u32 mip_dimension = dimension >> mip_index;
+    return (mip_dimension > 0) ? mip_dimension : 1;
+}
+
+// Returns the number of mip levels of the complete mip chain of an image, down to the 1x1 mip.
+NODISCARD ALWAYS_INLINE constexpr u32 get_image_full_mip_count(u32 width, u32 height)
+{
+    u32 mip_count = 1;
+    while ((width >> mip_count) > 0 || (height >> mip_count) > 0)
+        ++mip_count;
+    return mip_count;
+}
+
+// Returns the number of bytes of all the given mip levels of an image, when they are tightly packed one after the other.
+NODISCARD ALWAYS_INLINE constexpr usize get_image_mip_chain_byte_count(ImageFormat image_format, u32 width, u32 height, u32 mip_count)
+{
+    usize byte_count = 0;
+    for (u32 mip_index = 0; mip_index < mip_count; ++mip_index)
+        byte_count += get_image_byte_count(image_format, get_image_mip_dimension(width, mip_index), get_image_mip_dimension(height, mip_index));
+    return byte_count;
+}
+
 } // namespace SE
@@ -13,6 +13,55 @@
 namespace SE
 {
 
+PipelineBindingLayout::PipelineBindingLayout(Span<const PipelineInputDescription> input_descriptions)
+{
+    m_inputs.set_fixed_capacity(input_descriptions.count());
+    for (const PipelineInputDescription& input_description : input_descriptions)
+    {
+        // Each input must have a unique name.
+        SE_ASSERT(!m_binding_slots.contains(input_description.name));
+        SE_ASSERT(input_description.array_count > 0);
+        SE_ASSERT(input_description.type == PipelineInputType::TextureArray || input_description.array_count == 1);
+
+        PipelineInputBinding input = {};
+        input.type = input_description.type;
+        input.name = input_description.name;
+        input.shader_stage = input_description.shader_stage;
+        input.register_count = input_description.array_count;
+        input.sampler_register = 0;
+
+        if (input.type == PipelineInputType::UniformBuffer)
+        {
+            SE_ASSERT(input.shader_stage == ShaderStage::Vertex || input.shader_stage == ShaderStage::Fragment);
+            u32& constant_buffer_register_count =
+                (input.shader_stage == ShaderStage::Vertex) ? m_vertex_constant_buffer_register_count : m_fragment_constant_buffer_register_count;
+
+            input.first_register = constant_buffer_register_count;
+            constant_buffer_register_count += input.register_count;
+        }
+        else
+        {
+            // NOTE: Only the fragment stage can currently sample textures.
+            SE_ASSERT(input.shader_stage == ShaderStage::Fragment);
+            input.first_register = m_shader_resource_register_count;
+            m_shader_resource_register_count += input.register_count;
+            input.sampler_register = m_sampler_register_count++;
+        }
+
+        const PipelineBindingSlot binding_slot = static_cast<PipelineBindingSlot>(m_inputs.count());
+        m_binding_slots.add(input.name, binding_slot);
+        m_inputs.add(input);
+    }
+}
+
+PipelineBindingSlot PipelineBindingLayout::get_binding_slot(Name name) const
+{
+    const Optional<const PipelineBindingSlot&> binding_slot = m_binding_slots.get_if_exists(name);
+    if (!binding_slot.has_value())
+        return invalid_pipeline_binding_slot;
+    return binding_slot.value();
+}
+
 RefPtr<Pipeline> Pipeline::create(const PipelineDescription& description)
 {
     switch (get_current_renderer_api())
@@ -5,8 +5,12 @@
 
 #pragma once
 
+#include <Core/Containers/HashMap.h>
 #include <Core/Containers/RefPtr.h>
+#include <Core/Containers/Span.h>
+#include <Core/String/Name.h>
 #include <Renderer/Shader.h>
+#include <Renderer/ShaderStage.h>
 
 namespace SE
 {
@@ -62,10 +66,101 @@ enum class PipelineFrontFaceDirection : u8
     Clockwise,
 };
 
+enum class PipelineInputType : u8
+{
+    UniformBuffer,
+    Texture,
+    TextureArray,
+};
+
+struct PipelineInputDescription
+{
+public:
+    PipelineInputDescription() = default;
+    PipelineInputDescription(PipelineInputType in_type, Name in_name, ShaderStage in_shader_stage, u32 in_array_count = 1)
+        : type(in_type)
+        , name(in_name)
+        , shader_stage(in_shader_stage)
+        , array_count(in_array_count)
+    {}
+
+public:
+    PipelineInputType type;
+    Name name;
+    ShaderStage shader_stage;
+    // The number of textures of a texture array. Must be one for the other input types.
+    u32 array_count;
+};
+
+//
+// Integer handle that identifies an input of a pipeline. The input names are resolved to binding slots only once,
+// when the pipeline is created, so updating an input every batch doesn't require any string comparisons.
+//
+using PipelineBindingSlot = u32;
+static constexpr PipelineBindingSlot invalid_pipeline_binding_slot = static_cast<PipelineBindingSlot>(-1);
+
+//
+// An input of a pipeline, together with the shader registers that are assigned to it.
+//
+struct PipelineInputBinding
+{
+    PipelineInputType type;
+    Name name;
+    ShaderStage shader_stage;
+
+    // The first register (constant buffer or shader resource) that is assigned to the input.
+    u32 first_register;
+    u32 register_count;
+
+    // Only used by texture and texture array inputs.
+    u32 sampler_register;
+};
+
+//
+// The binding slots and the shader registers of the inputs of a pipeline, computed once when the pipeline is created.
+// The binding slot of an input is its index in the pipeline description, and the registers are assigned in the same
+// order: each uniform buffer gets a constant buffer register of its shader stage, while each texture (or texture array)
+// gets consecutive shader resource registers and a single sampler register.
+//
+class PipelineBindingLayout
+{
+public:
+    PipelineBindingLayout() = default;
+    SHOOTER_API explicit PipelineBindingLayout(Span<const PipelineInputDescription> input_descriptions);
+
+    NODISCARD ALWAYS_INLINE u32 get_input_count() const { return static_cast<u32>(m_inputs.count()); }
+
+    NODISCARD ALWAYS_INLINE const PipelineInputBinding& get_input(PipelineBindingSlot binding_slot) const
+    {
+        SE_ASSERT(binding_slot < m_inputs.count());
+        return m_inputs[binding_slot];
+    }
+
+    // Returns the binding slot of the input with the given name, or `invalid_pipeline_binding_slot` if no such input exists.
+    NODISCARD SHOOTER_API PipelineBindingSlot get_binding_slot(Name name) const;
+
+    NODISCARD ALWAYS_INLINE u32 get_vertex_constant_buffer_register_count() const { return m_vertex_constant_buffer_register_count; }
+    NODISCARD ALWAYS_INLINE u32 get_fragment_constant_buffer_register_count() const { return m_fragment_constant_buffer_register_count; }
+    NODISCARD ALWAYS_INLINE u32 get_shader_resource_register_count() const { return m_shader_resource_register_count; }
+    NODISCARD ALWAYS_INLINE u32 get_sampler_register_count() const { return m_sampler_register_count; }
+
+private:
+    // Indexed by the binding slot of the input.
+    Vector<PipelineInputBinding> m_inputs;
+    HashMap<Name, PipelineBindingSlot> m_binding_slots;
+
+    u32 m_vertex_constant_buffer_register_count { 0 };
+    u32 m_fragment_constant_buffer_register_count { 0 };
+    u32 m_shader_resource_register_count { 0 };
+    u32 m_sampler_register_count { 0 };
+};
+
 struct PipelineDescription
 {
     RefPtr<Shader> shader;
     Vector<PipelineVertexAttribute> vertex_attributes;
+    // The resources that are read by the shaders. They are bound through the render passes that use the pipeline.
+    Vector<PipelineInputDescription> inputs;
 
     PipelinePrimitiveTopology primitive_topology { PipelinePrimitiveTopology::TriangleList };
     PipelineFillMode fill_mode { PipelineFillMode::Solid };
@@ -83,6 +178,7 @@ public:
 
 public:
     NODISCARD virtual RefPtr<Shader> get_shader() const = 0;
+    NODISCARD virtual const PipelineBindingLayout& get_binding_layout() const = 0;
 
     NODISCARD virtual PipelinePrimitiveTopology get_primitive_topology() const = 0;
     NODISCARD virtual PipelineFillMode get_fill_mode() const = 0;
@@ -19,25 +19,15 @@ NODISCARD ALWAYS_INLINE constexpr DXGI_FORMAT get_d3d11_image_format(ImageFormat
         case ImageFormat::Unknown: return DXGI_FORMAT_UNKNOWN;
         case ImageFormat::RGBA8: return DXGI_FORMAT_R8G8B8A8_UNORM;
         case ImageFormat::BGRA8: return DXGI_FORMAT_B8G8R8A8_UNORM;
+        case ImageFormat::BC1: return DXGI_FORMAT_BC1_UNORM;
+        case ImageFormat::BC3: return DXGI_FORMAT_BC3_UNORM;
+        case ImageFormat::BC7: return DXGI_FORMAT_BC7_UNORM;
     }
 
     SE_ASSERT(false);
     return DXGI_FORMAT_UNKNOWN;
 }
 
-NODISCARD ALWAYS_INLINE u32 get_d3d11_image_format_size(ImageFormat image_format)
-{
-    switch (image_format)
-    {
-        case ImageFormat::Unknown: return 0;
-        case ImageFormat::RGBA8: return 4;
-        case ImageFormat::BGRA8: return 4;
-    }
-
-    SE_ASSERT(false);
-    return 0;
-}
-
 NODISCARD ALWAYS_INLINE constexpr D3D11_FILTER get_d3d11_image_filtering_mode(ImageFilteringMode min_image_filtering, ImageFilteringMode mag_image_filtering)
 {
     switch (min_image_filtering)
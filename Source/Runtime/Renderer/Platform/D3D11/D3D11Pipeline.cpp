@@ -63,6 +63,7 @@ D3D11Pipeline::D3D11Pipeline(const PipelineDescription& description)
     : m_input_layout(nullptr)
     , m_rasterizer_state(nullptr)
     , m_description(description)
+    , m_binding_layout(description.inputs.span())
     , m_vertex_stride(0)
 {
     if (m_description.vertex_attributes.has_elements())
@@ -22,6 +22,7 @@ public:
     NODISCARD ALWAYS_INLINE u32 get_vertex_stride() const { return m_vertex_stride; }
 
     NODISCARD ALWAYS_INLINE virtual RefPtr<Shader> get_shader() const override { return m_description.shader; }
+    NODISCARD ALWAYS_INLINE virtual const PipelineBindingLayout& get_binding_layout() const override { return m_binding_layout; }
     NODISCARD ALWAYS_INLINE virtual PipelinePrimitiveTopology get_primitive_topology() const override { return m_description.primitive_topology; }
     NODISCARD ALWAYS_INLINE virtual PipelineFillMode get_fill_mode() const override { return m_description.fill_mode; }
     NODISCARD ALWAYS_INLINE virtual PipelineCullMode get_cull_mode() const override { return m_description.cull_mode; }
@@ -31,6 +32,7 @@ private:
     ID3D11InputLayout* m_input_layout;
     ID3D11RasterizerState* m_rasterizer_state;
     PipelineDescription m_description;
+    PipelineBindingLayout m_binding_layout;
     u32 m_vertex_stride;
 };
 
@@ -16,123 +16,173 @@ namespace SE
 
 D3D11RenderPass::D3D11RenderPass(const RenderPassDescription& description)
     : m_description(description)
+    , m_binding_layout(&description.pipeline->get_binding_layout())
+    , m_has_bound_inputs(false)
 {
     if (m_description.target_framebuffer_attachments.count() != description.target_framebuffer->get_attachment_count())
     {
         SE_LOG_ERROR("The number of attachments specified to the render pass must acutally match the number of framebuffer attachments!");
         SE_ASSERT(false);
     }
+
+    // NOTE: The registers were assigned to the inputs when the pipeline was created, so the render pass only has to
+    //       know how many registers of each kind are used.
+    m_vertex_constant_buffers.register_count = m_binding_layout->get_vertex_constant_buffer_register_count();
+    m_fragment_constant_buffers.register_count = m_binding_layout->get_fragment_constant_buffer_register_count();
+    m_fragment_shader_resource_views.register_count = m_binding_layout->get_shader_resource_register_count();
+    m_fragment_sampler_states.register_count = m_binding_layout->get_sampler_register_count();
+
+    SE_ASSERT(m_vertex_constant_buffers.register_count <= max_constant_buffer_registers);
+    SE_ASSERT(m_fragment_constant_buffers.register_count <= max_constant_buffer_registers);
+    SE_ASSERT(m_fragment_shader_resource_views.register_count <= max_shader_resource_registers);
+    SE_ASSERT(m_fragment_sampler_states.register_count <= max_sampler_registers);
 }
 
 D3D11RenderPass::~D3D11RenderPass()
 {
-    m_input_textures.clear_and_shrink();
-    m_input_texture_arrays.clear_and_shrink();
+    for (RefPtr<D3D11UniformBuffer>& uniform_buffer : m_vertex_uniform_buffers)
+        uniform_buffer.release();
+    for (RefPtr<D3D11UniformBuffer>& uniform_buffer : m_fragment_uniform_buffers)
+        uniform_buffer.release();
+    for (RefPtr<D3D11Texture2D>& texture : m_fragment_textures)
+        texture.release();
 
     m_description.target_framebuffer.release();
     m_description.pipeline.release();
 }
 
-bool D3D11RenderPass::bind_inputs()
+void D3D11RenderPass::invalidate_bound_inputs()
 {
-    Vector<ID3D11Buffer*> vertex_shader_constant_buffers;
-    Vector<ID3D11Buffer*> pixel_shader_constant_buffers;
-
-    Vector<ID3D11ShaderResourceView*> fragment_shader_resource_views;
-    Vector<ID3D11SamplerState*> fragment_shader_sampler_states;
-
-    for (auto uniform_buffer_it : m_input_uniform_buffers)
-    {
-        RefPtr<D3D11UniformBuffer> uniform_buffer = uniform_buffer_it.value.uniform_buffer.as<D3D11UniformBuffer>();
-        const ShaderStage shader_stage = uniform_buffer_it.value.shader_stage;
-
-        if (shader_stage == ShaderStage::Vertex)
-            vertex_shader_constant_buffers.add(uniform_buffer->get_handle());
-        else if (shader_stage == ShaderStage::Fragment)
-            pixel_shader_constant_buffers.add(uniform_buffer->get_handle());
-    }
+    m_has_bound_inputs = false;
+}
 
-    for (auto texture : m_input_textures)
-    {
-        fragment_shader_resource_views.add(texture.value->get_view_handle());
-        fragment_shader_sampler_states.add(texture.value->get_sampler_state());
-    }
+bool D3D11RenderPass::bind_inputs()
+{
+    ID3D11DeviceContext* device_context = D3D11Renderer::get_device_context();
+    const bool bind_all_registers = !m_has_bound_inputs;
 
-    D3D11Renderer::get_device_context()->VSSetConstantBuffers(
-        0, static_cast<UINT>(vertex_shader_constant_buffers.count()), vertex_shader_constant_buffers.elements()
-    );
-    D3D11Renderer::get_device_context()->PSSetConstantBuffers(
-        0, static_cast<UINT>(pixel_shader_constant_buffers.count()), pixel_shader_constant_buffers.elements()
+    m_vertex_constant_buffers.bind_changed_registers(
+        bind_all_registers,
+        [device_context](u32 first_register, u32 register_count, ID3D11Buffer* const* handles)
+        {
+            device_context->VSSetConstantBuffers(first_register, register_count, handles);
+        }
     );
 
-    for (auto texture_array_bucket : m_input_texture_arrays)
-    {
-        Vector<RefPtr<D3D11Texture2D>>& texture_array = texture_array_bucket.value;
-
-        // TODO: There shouldn't be one sampler per texture anyway.
-        if (texture_array.has_elements())
-            fragment_shader_sampler_states.add(texture_array.first()->get_sampler_state());
+    m_fragment_constant_buffers.bind_changed_registers(
+        bind_all_registers,
+        [device_context](u32 first_register, u32 register_count, ID3D11Buffer* const* handles)
+        {
+            device_context->PSSetConstantBuffers(first_register, register_count, handles);
+        }
+    );
 
-        for (RefPtr<D3D11Texture2D>& texture : texture_array)
+    m_fragment_shader_resource_views.bind_changed_registers(
+        bind_all_registers,
+        [device_context](u32 first_register, u32 register_count, ID3D11ShaderResourceView* const* handles)
         {
-            if (texture.is_valid())
-                fragment_shader_resource_views.add(texture->get_view_handle());
+            device_context->PSSetShaderResources(first_register, register_count, handles);
         }
-    }
+    );
 
-    D3D11Renderer::get_device_context()->PSSetShaderResources(0, (UINT)(fragment_shader_resource_views.count()), fragment_shader_resource_views.elements());
-    D3D11Renderer::get_device_context()->PSSetSamplers(0, (UINT)(fragment_shader_sampler_states.count()), fragment_shader_sampler_states.elements());
+    m_fragment_sampler_states.bind_changed_registers(
+        bind_all_registers,
+        [device_context](u32 first_register, u32 register_count, ID3D11SamplerState* const* handles)
+        {
+            device_context->PSSetSamplers(first_register, register_count, handles);
+        }
+    );
 
+    m_has_bound_inputs = true;
     return true;
 }
 
-void D3D11RenderPass::set_input(StringView name, const RenderPassUniformBufferBinding& uniform_buffer_binding)
+RenderPassBindingSlot D3D11RenderPass::set_input(Name name, const RenderPassUniformBufferBinding& uniform_buffer_binding)
 {
-    SE_ASSERT(!m_input_uniform_buffers.contains(name));
-    m_input_uniform_buffers.add(name, uniform_buffer_binding);
+    const RenderPassBindingSlot binding_slot = get_binding_slot(name);
+    const PipelineInputBinding& input = get_input(binding_slot, PipelineInputType::UniformBuffer);
+    SE_ASSERT(input.shader_stage == uniform_buffer_binding.shader_stage);
+
+    set_uniform_buffer(input, uniform_buffer_binding.uniform_buffer);
+    return binding_slot;
 }
 
-void D3D11RenderPass::set_input(StringView name, const RenderPassTextureBinding& texture_binding)
+RenderPassBindingSlot D3D11RenderPass::set_input(Name name, const RenderPassTextureBinding& texture_binding)
 {
-    SE_ASSERT(!m_input_textures.contains(name));
-    m_input_textures.add(name, texture_binding.texture.as<D3D11Texture2D>());
+    const RenderPassBindingSlot binding_slot = get_binding_slot(name);
+    set_texture(get_input(binding_slot, PipelineInputType::Texture), 0, texture_binding.texture);
+    return binding_slot;
 }
 
-void D3D11RenderPass::set_input(StringView name, const RenderPassTextureArrayBinding& texture_array_binding)
+RenderPassBindingSlot D3D11RenderPass::set_input(Name name, const RenderPassTextureArrayBinding& texture_array_binding)
 {
-    SE_ASSERT(!m_input_texture_arrays.contains(name));
+    const RenderPassBindingSlot binding_slot = get_binding_slot(name);
+    const PipelineInputBinding& input = get_input(binding_slot, PipelineInputType::TextureArray);
+    SE_ASSERT(texture_array_binding.texture_array.count() == input.register_count);
 
-    Vector<RefPtr<D3D11Texture2D>> texture_array;
-    texture_array.ensure_capacity(texture_array_binding.texture_array.count());
+    for (u32 texture_index = 0; texture_index < input.register_count; ++texture_index)
+        set_texture(input, texture_index, texture_array_binding.texture_array[texture_index]);
+    return binding_slot;
+}
 
-    for (const auto& texture : texture_array_binding.texture_array)
-        texture_array.add(texture.as<D3D11Texture2D>());
+RenderPassBindingSlot D3D11RenderPass::get_binding_slot(Name name) const
+{
+    return m_binding_layout->get_binding_slot(name);
+}
 
-    m_input_texture_arrays.add(name, move(texture_array));
+void D3D11RenderPass::update_input(RenderPassBindingSlot binding_slot, RefPtr<UniformBuffer> uniform_buffer)
+{
+    const PipelineInputBinding& input = get_input(binding_slot, PipelineInputType::UniformBuffer);
+    set_uniform_buffer(input, move(uniform_buffer));
 }
 
-void D3D11RenderPass::update_input(StringView name, RefPtr<UniformBuffer> uniform_buffer)
+void D3D11RenderPass::update_input(RenderPassBindingSlot binding_slot, RefPtr<Texture2D> texture)
 {
-    SE_ASSERT(m_input_uniform_buffers.contains(name));
-    m_input_uniform_buffers.at(name).uniform_buffer = uniform_buffer;
+    const PipelineInputBinding& input = get_input(binding_slot, PipelineInputType::Texture);
+    set_texture(input, 0, move(texture));
+}
+
+void D3D11RenderPass::update_input(RenderPassBindingSlot binding_slot, Span<RefPtr<Texture2D>> texture_array)
+{
+    const PipelineInputBinding& input = get_input(binding_slot, PipelineInputType::TextureArray);
+    SE_ASSERT(texture_array.count() == input.register_count);
+
+    for (u32 texture_index = 0; texture_index < input.register_count; ++texture_index)
+        set_texture(input, texture_index, texture_array[texture_index]);
 }
 
-void D3D11RenderPass::update_input(StringView name, RefPtr<Texture2D> texture)
+const PipelineInputBinding& D3D11RenderPass::get_input(RenderPassBindingSlot binding_slot, PipelineInputType expected_type) const
 {
-    SE_ASSERT(m_input_textures.contains(name));
-    m_input_textures.at(name) = texture.as<D3D11Texture2D>();
+    // NOTE: The binding slot is invalid if the pipeline doesn't declare an input with the given name.
+    SE_ASSERT(binding_slot < m_binding_layout->get_input_count());
+    const PipelineInputBinding& input = m_binding_layout->get_input(binding_slot);
+    SE_ASSERT(input.type == expected_type);
+    return input;
+}
+
+void D3D11RenderPass::set_uniform_buffer(const PipelineInputBinding& input, RefPtr<UniformBuffer> uniform_buffer)
+{
+    const bool is_vertex_stage = (input.shader_stage == ShaderStage::Vertex);
+    RefPtr<D3D11UniformBuffer>* uniform_buffers = is_vertex_stage ? m_vertex_uniform_buffers : m_fragment_uniform_buffers;
+    auto& constant_buffers = is_vertex_stage ? m_vertex_constant_buffers : m_fragment_constant_buffers;
+
+    RefPtr<D3D11UniformBuffer>& d3d11_uniform_buffer = uniform_buffers[input.first_register];
+    d3d11_uniform_buffer = uniform_buffer.as<D3D11UniformBuffer>();
+    constant_buffers.current_handles[input.first_register] = d3d11_uniform_buffer.is_valid() ? d3d11_uniform_buffer->get_handle() : nullptr;
 }
 
-void D3D11RenderPass::update_input(StringView name, Span<RefPtr<Texture2D>> texture_array)
+void D3D11RenderPass::set_texture(const PipelineInputBinding& input, u32 register_offset, RefPtr<Texture2D> texture)
 {
-    SE_ASSERT(m_input_texture_arrays.contains(name));
-    Vector<RefPtr<D3D11Texture2D>>& textures = m_input_texture_arrays.at(name);
+    SE_ASSERT(register_offset < input.register_count);
+    const u32 register_index = input.first_register + register_offset;
 
-    SE_ASSERT(texture_array.count() == textures.count());
-    textures.clear();
+    RefPtr<D3D11Texture2D>& d3d11_texture = m_fragment_textures[register_index];
+    d3d11_texture = texture.as<D3D11Texture2D>();
+    m_fragment_shader_resource_views.current_handles[register_index] = d3d11_texture.is_valid() ? d3d11_texture->get_view_handle() : nullptr;
 
-    for (const auto& texture : texture_array)
-        textures.add(texture.as<D3D11Texture2D>());
+    // TODO: There shouldn't be one sampler per texture anyway. Texture arrays use the sampler of their first texture.
+    if (register_offset == 0 && d3d11_texture.is_valid())
+        m_fragment_sampler_states.current_handles[input.sampler_register] = d3d11_texture->get_sampler_state();
 }
 
 } // namespace SE
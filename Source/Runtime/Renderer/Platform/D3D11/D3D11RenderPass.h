@@ -5,9 +5,10 @@
 
 #pragma once
 
-#include <Core/Containers/HashMap.h>
+#include <Core/String/Name.h>
 #include <Renderer/Platform/D3D11/D3D11Headers.h>
 #include <Renderer/RenderPass.h>
+#include <Renderer/RenderPassRegisterSet.h>
 
 namespace SE
 {
@@ -40,23 +41,52 @@ public:
         return m_description.target_framebuffer_attachments[attachment_index];
     }
 
+public:
+    // Forgets the state that was last bound by this render pass, so the next call to `bind_inputs` binds all inputs.
+    // Must be invoked every time the render pass begins, as the device context state might have been modified in the meantime.
+    void invalidate_bound_inputs();
+
 public:
     virtual bool bind_inputs() override;
 
-    virtual void set_input(StringView name, const RenderPassUniformBufferBinding& uniform_buffer_binding) override;
-    virtual void set_input(StringView name, const RenderPassTextureBinding& texture_binding) override;
-    virtual void set_input(StringView name, const RenderPassTextureArrayBinding& texture_array_binding) override;
+    virtual RenderPassBindingSlot set_input(Name name, const RenderPassUniformBufferBinding& uniform_buffer_binding) override;
+    virtual RenderPassBindingSlot set_input(Name name, const RenderPassTextureBinding& texture_binding) override;
+    virtual RenderPassBindingSlot set_input(Name name, const RenderPassTextureArrayBinding& texture_array_binding) override;
+
+    NODISCARD virtual RenderPassBindingSlot get_binding_slot(Name name) const override;
 
-    virtual void update_input(StringView name, RefPtr<UniformBuffer> uniform_buffer) override;
-    virtual void update_input(StringView name, RefPtr<Texture2D> texture) override;
-    virtual void update_input(StringView name, Span<RefPtr<Texture2D>> texture_array) override;
+    using RenderPass::update_input;
+    virtual void update_input(RenderPassBindingSlot binding_slot, RefPtr<UniformBuffer> uniform_buffer) override;
+    virtual void update_input(RenderPassBindingSlot binding_slot, RefPtr<Texture2D> texture) override;
+    virtual void update_input(RenderPassBindingSlot binding_slot, Span<RefPtr<Texture2D>> texture_array) override;
+
+private:
+    static constexpr u32 max_constant_buffer_registers = D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT;
+    static constexpr u32 max_shader_resource_registers = 32;
+    static constexpr u32 max_sampler_registers = D3D11_COMMONSHADER_SAMPLER_SLOT_COUNT;
+
+    NODISCARD const PipelineInputBinding& get_input(RenderPassBindingSlot binding_slot, PipelineInputType expected_type) const;
+
+    void set_uniform_buffer(const PipelineInputBinding& input, RefPtr<UniformBuffer> uniform_buffer);
+    void set_texture(const PipelineInputBinding& input, u32 register_offset, RefPtr<Texture2D> texture);
 
 private:
     RenderPassDescription m_description;
 
-    HashMap<String, RenderPassUniformBufferBinding> m_input_uniform_buffers;
-    HashMap<String, RefPtr<D3D11Texture2D>> m_input_textures;
-    HashMap<String, Vector<RefPtr<D3D11Texture2D>>> m_input_texture_arrays;
+    // The binding layout of the pipeline, which is kept alive by the render pass description.
+    const PipelineBindingLayout* m_binding_layout;
+    bool m_has_bound_inputs;
+
+    // NOTE: The render pass keeps a reference to each resource it has bound, so the raw handles stored
+    //       in the register sets are valid for as long as they are used.
+    RefPtr<D3D11UniformBuffer> m_vertex_uniform_buffers[max_constant_buffer_registers];
+    RefPtr<D3D11UniformBuffer> m_fragment_uniform_buffers[max_constant_buffer_registers];
+    RefPtr<D3D11Texture2D> m_fragment_textures[max_shader_resource_registers];
+
+    RenderPassRegisterSet<ID3D11Buffer, max_constant_buffer_registers> m_vertex_constant_buffers;
+    RenderPassRegisterSet<ID3D11Buffer, max_constant_buffer_registers> m_fragment_constant_buffers;
+    RenderPassRegisterSet<ID3D11ShaderResourceView, max_shader_resource_registers> m_fragment_shader_resource_views;
+    RenderPassRegisterSet<ID3D11SamplerState, max_sampler_registers> m_fragment_sampler_states;
 };
 
 } // namespace SE
@@ -154,6 +154,10 @@ void D3D11Renderer::begin_render_pass(RefPtr<RenderPass> render_pass)
     RefPtr<D3D11Shader> shader = pipeline->get_shader().as<D3D11Shader>();
     RefPtr<D3D11Framebuffer> framebuffer = d3d11_render_pass->get_target_framebuffer();
 
+    // The device context state might have been modified since the render pass was last active, so the next
+    // call to `bind_inputs` must bind all inputs.
+    d3d11_render_pass->invalidate_bound_inputs();
+
     //
     // Set pipeline input layout.
     //
@@ -247,7 +251,7 @@ void D3D11Renderer::end_render_pass()
     s_d3d11_renderer->active_render_pass.release();
 }
 
-void D3D11Renderer::draw_indexed(RefPtr<VertexBuffer> vertex_buffer, RefPtr<IndexBuffer> index_buffer, u32 index_count)
+void D3D11Renderer::draw_indexed(RefPtr<VertexBuffer> vertex_buffer, RefPtr<IndexBuffer> index_buffer, u32 index_count, u32 vertex_buffer_byte_offset)
 {
     // A render pass must be active.
     SE_ASSERT(s_d3d11_renderer->active_render_pass.is_valid());
@@ -259,7 +263,7 @@ void D3D11Renderer::draw_indexed(RefPtr<VertexBuffer> vertex_buffer, RefPtr<Inde
     const u32 vertex_stride = s_d3d11_renderer->active_render_pass->get_pipeline()->get_vertex_stride();
     ID3D11Buffer* vertex_buffers[1] = { d3d11_vertex_buffer->get_handle() };
     const UINT strides[1] = { vertex_stride };
-    const UINT offsets[1] = { 0 };
+    const UINT offsets[1] = { vertex_buffer_byte_offset };
 
     s_d3d11_renderer->device_context->IASetVertexBuffers(0, SE_ARRAY_COUNT(vertex_buffers), vertex_buffers, strides, offsets);
 
@@ -59,7 +59,7 @@ public:
     virtual void begin_render_pass(RefPtr<RenderPass> render_pass) override;
     virtual void end_render_pass() override;
 
-    virtual void draw_indexed(RefPtr<VertexBuffer> vertex_buffer, RefPtr<IndexBuffer> index_buffer, u32 index_count) override;
+    virtual void draw_indexed(RefPtr<VertexBuffer> vertex_buffer, RefPtr<IndexBuffer> index_buffer, u32 index_count, u32 vertex_buffer_byte_offset) override;
 };
 
 } // namespace SE
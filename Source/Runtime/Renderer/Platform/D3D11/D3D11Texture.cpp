@@ -3,6 +3,7 @@
  * SPDX-License-Identifier: Apache-2.0.
  */
 
+#include <Core/Containers/Vector.h>
 #include <Renderer/Platform/D3D11/D3D11Image.h>
 #include <Renderer/Platform/D3D11/D3D11Renderer.h>
 #include <Renderer/Platform/D3D11/D3D11Texture.h>
@@ -17,6 +18,7 @@ D3D11Texture2D::D3D11Texture2D(const Texture2DDescription& description)
     , m_width(description.width)
     , m_height(description.height)
     , m_format(description.format)
+    , m_mip_count(description.mip_count)
     , m_min_filter(description.min_filter)
     , m_mag_filter(description.mag_filter)
     , m_address_mode_u(description.address_mode_u)
@@ -27,10 +29,13 @@ D3D11Texture2D::D3D11Texture2D(const Texture2DDescription& description)
     // The specification of the texture.
     // https://learn.microsoft.com/en-us/windows/win32/api/d3d11/ns-d3d11-d3d11_texture2d_desc
     //
+    SE_ASSERT(m_mip_count > 0 && m_mip_count <= get_image_full_mip_count(m_width, m_height));
+    SE_ASSERT(!is_image_format_block_compressed(m_format) || (m_width % 4 == 0 && m_height % 4 == 0));
+
     D3D11_TEXTURE2D_DESC texture_description = {};
     texture_description.Width = static_cast<UINT>(m_width);
     texture_description.Height = static_cast<UINT>(m_height);
-    texture_description.MipLevels = 1;
+    texture_description.MipLevels = static_cast<UINT>(m_mip_count);
     texture_description.ArraySize = 1;
     texture_description.Format = get_d3d11_image_format(m_format);
     texture_description.SampleDesc.Count = 1;
@@ -39,16 +44,26 @@ D3D11Texture2D::D3D11Texture2D(const Texture2DDescription& description)
     texture_description.BindFlags = D3D11_BIND_SHADER_RESOURCE;
     texture_description.CPUAccessFlags = 0;
 
+    // Each mip level is a separate subresource, with its own initial data.
     // https://learn.microsoft.com/en-us/windows/win32/api/d3d11/ns-d3d11-d3d11_subresource_data
-    D3D11_SUBRESOURCE_DATA initial_data = {};
+    Vector<D3D11_SUBRESOURCE_DATA> initial_data;
     if (!description.data.is_empty())
     {
-        const u32 slice_pitch = m_width * get_d3d11_image_format_size(m_format);
         // The provided data buffer doesn't match the texture number of bytes.
-        SE_ASSERT(static_cast<usize>(slice_pitch) * static_cast<usize>(m_height) == description.data.count());
+        SE_ASSERT(get_image_mip_chain_byte_count(m_format, m_width, m_height, m_mip_count) == description.data.count());
+        initial_data.set_fixed_capacity(m_mip_count);
+
+        usize mip_offset = 0;
+        for (u32 mip_index = 0; mip_index < m_mip_count; ++mip_index)
+        {
+            const u32 mip_width = get_image_mip_dimension(m_width, mip_index);
+            const u32 mip_height = get_image_mip_dimension(m_height, mip_index);
 
-        initial_data.pSysMem = description.data.elements();
-        initial_data.SysMemPitch = slice_pitch;
+            D3D11_SUBRESOURCE_DATA& mip_initial_data = initial_data.emplace();
+            mip_initial_data.pSysMem = description.data.elements() + mip_offset;
+            mip_initial_data.SysMemPitch = get_image_row_pitch(m_format, mip_width);
+            mip_offset += get_image_byte_count(m_format, mip_width, mip_height);
+        }
     }
 
     //
@@ -58,7 +73,7 @@ D3D11Texture2D::D3D11Texture2D(const Texture2DDescription& description)
     D3D11_SHADER_RESOURCE_VIEW_DESC texture_view_description = {};
     texture_view_description.Format = get_d3d11_image_format(m_format);
     texture_view_description.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
-    texture_view_description.Texture2D.MipLevels = 1;
+    texture_view_description.Texture2D.MipLevels = static_cast<UINT>(m_mip_count);
     texture_view_description.Texture2D.MostDetailedMip = 0;
 
     //
@@ -71,7 +86,8 @@ D3D11Texture2D::D3D11Texture2D(const Texture2DDescription& description)
     sampler_description.AddressV = get_d3d11_image_address_mode(m_address_mode_v);
     sampler_description.AddressW = get_d3d11_image_address_mode(m_address_mode_w);
 
-    SE_D3D11_CHECK(D3D11Renderer::get_device()->CreateTexture2D(&texture_description, &initial_data, &m_handle));
+    const D3D11_SUBRESOURCE_DATA* initial_data_pointer = initial_data.is_empty() ? nullptr : initial_data.elements();
+    SE_D3D11_CHECK(D3D11Renderer::get_device()->CreateTexture2D(&texture_description, initial_data_pointer, &m_handle));
     SE_D3D11_CHECK(D3D11Renderer::get_device()->CreateShaderResourceView(m_handle, &texture_view_description, &m_view_handle));
     SE_D3D11_CHECK(D3D11Renderer::get_device()->CreateSamplerState(&sampler_description, &m_sampler_state));
 }
@@ -83,4 +99,24 @@ D3D11Texture2D::~D3D11Texture2D()
     SE_D3D11_RELEASE(m_handle);
 }
 
+void D3D11Texture2D::update_region(u32 x, u32 y, u32 width, u32 height, ReadonlyByteSpan data)
+{
+    SE_ASSERT(x + width <= m_width && y + height <= m_height);
+    SE_ASSERT(!is_image_format_block_compressed(m_format));
+    const u32 row_pitch = get_image_row_pitch(m_format, width);
+    // The provided data buffer doesn't match the region number of bytes.
+    SE_ASSERT(static_cast<usize>(row_pitch) * static_cast<usize>(height) == data.count());
+
+    // https://learn.microsoft.com/en-us/windows/win32/api/d3d11/ns-d3d11-d3d11_box
+    D3D11_BOX region_box = {};
+    region_box.left = static_cast<UINT>(x);
+    region_box.right = static_cast<UINT>(x + width);
+    region_box.top = static_cast<UINT>(y);
+    region_box.bottom = static_cast<UINT>(y + height);
+    region_box.front = 0;
+    region_box.back = 1;
+
+    D3D11Renderer::get_device_context()->UpdateSubresource(m_handle, 0, &region_box, data.elements(), row_pitch, 0);
+}
+
 } // namespace SE
@@ -21,6 +21,8 @@ public:
     NODISCARD ALWAYS_INLINE virtual u32 get_height() const override { return m_height; }
     NODISCARD ALWAYS_INLINE virtual ImageFormat get_format() const override { return m_format; }
 
+    virtual void update_region(u32 x, u32 y, u32 width, u32 height, ReadonlyByteSpan data) override;
+
     NODISCARD ALWAYS_INLINE ID3D11Texture2D* get_handle() { return m_handle; }
     NODISCARD ALWAYS_INLINE const ID3D11Texture2D* get_handle() const { return m_handle; }
 
@@ -38,6 +40,7 @@ private:
     u32 m_width;
     u32 m_height;
     ImageFormat m_format;
+    u32 m_mip_count;
 
     ImageFilteringMode m_min_filter;
     ImageFilteringMode m_mag_filter;
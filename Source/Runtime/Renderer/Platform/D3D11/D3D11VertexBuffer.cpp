@@ -116,4 +116,24 @@ void D3D11VertexBuffer::update_data(ReadonlyByteSpan data)
     }
 }
 
+void D3D11VertexBuffer::write_data(u32 byte_offset, ReadonlyByteSpan data, bool discard_previous_contents)
+{
+    if (m_update_frequency != VertexBufferUpdateFrequency::High)
+    {
+        SE_LOG_TAG_ERROR("D3D11", "Sub-range writes are only supported by vertex buffers created with VertexBufferUpdateFrequency::High!");
+        return;
+    }
+
+    SE_ASSERT(static_cast<usize>(byte_offset) + data.count() <= m_buffer_byte_count);
+    const D3D11_MAP map_type = discard_previous_contents ? D3D11_MAP_WRITE_DISCARD : D3D11_MAP_WRITE_NO_OVERWRITE;
+
+    // Map the buffer memory.
+    D3D11_MAPPED_SUBRESOURCE buffer_subresource = {};
+    SE_D3D11_CHECK(D3D11Renderer::get_device_context()->Map(m_handle, 0, map_type, 0, &buffer_subresource));
+    // Copy data to the mapped memory, at the given offset.
+    copy_memory_from_span(static_cast<u8*>(buffer_subresource.pData) + byte_offset, data);
+    // Unmap the buffer memory.
+    D3D11Renderer::get_device_context()->Unmap(m_handle, 0);
+}
+
 } // namespace SE
@@ -21,6 +21,7 @@ public:
 
 public:
     virtual void update_data(ReadonlyByteSpan data) override;
+    virtual void write_data(u32 byte_offset, ReadonlyByteSpan data, bool discard_previous_contents) override;
 
 private:
     ID3D11Buffer* m_handle;
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/Math/MathCore.h>
+#include <Renderer/RectanglePacker.h>
+
+namespace SE
+{
+
+SkylineRectanglePacker::SkylineRectanglePacker(u32 width, u32 height)
+    : m_width(width)
+    , m_height(height)
+    , m_used_area(0)
+{
+    SE_ASSERT(m_width > 0 && m_height > 0);
+    reset();
+}
+
+Optional<PackedRectangle> SkylineRectanglePacker::pack(u32 width, u32 height)
+{
+    if (width == 0 || height == 0 || width > m_width || height > m_height)
+        return {};
+
+    usize best_segment_index = m_skyline.count();
+    u32 best_top = 0;
+    u32 best_segment_width = 0;
+
+    for (usize segment_index = 0; segment_index < m_skyline.count(); ++segment_index)
+    {
+        Optional<u32> placement_height = find_placement_height(segment_index, width, height);
+        if (!placement_height.has_value())
+            continue;
+
+        const u32 top = placement_height.value() + height;
+        const u32 segment_width = m_skyline[segment_index].width;
+        const bool is_first_candidate = (best_segment_index == m_skyline.count());
+
+        if (is_first_candidate || top < best_top || (top == best_top && segment_width < best_segment_width))
+        {
+            best_segment_index = segment_index;
+            best_top = top;
+            best_segment_width = segment_width;
+        }
+    }
+
+    if (best_segment_index == m_skyline.count())
+        return {};
+
+    PackedRectangle rectangle;
+    rectangle.x = m_skyline[best_segment_index].x;
+    rectangle.y = best_top - height;
+    rectangle.width = width;
+    rectangle.height = height;
+
+    add_skyline_segment(best_segment_index, rectangle);
+    m_used_area += static_cast<u64>(width) * static_cast<u64>(height);
+    return rectangle;
+}
+
+void SkylineRectanglePacker::reset()
+{
+    m_used_area = 0;
+    m_skyline.clear();
+    m_skyline.add({ 0, 0, m_width });
+}
+
+Optional<u32> SkylineRectanglePacker::find_placement_height(usize segment_index, u32 width, u32 height) const
+{
+    const u32 x = m_skyline[segment_index].x;
+    if (x + width > m_width)
+        return {};
+
+    // The rectangle rests on the highest segment that it spans.
+    u32 y = 0;
+    u32 remaining_width = width;
+    for (usize index = segment_index; remaining_width > 0; ++index)
+    {
+        // NOTE: The skyline always covers the whole width, so this can't go out of bounds when the rectangle fits horizontally.
+        SE_DEBUG_ASSERT(index < m_skyline.count());
+        const SkylineSegment& segment = m_skyline[index];
+
+        y = Math::max(y, segment.y);
+        if (y + height > m_height)
+            return {};
+
+        remaining_width -= Math::min(remaining_width, segment.width);
+    }
+
+    return y;
+}
+
+void SkylineRectanglePacker::add_skyline_segment(usize segment_index, const PackedRectangle& rectangle)
+{
+    SkylineSegment new_segment;
+    new_segment.x = rectangle.x;
+    new_segment.y = rectangle.y + rectangle.height;
+    new_segment.width = rectangle.width;
+    m_skyline.insert(segment_index, new_segment);
+
+    // Shrink or remove the segments that are now (partially) covered by the new segment.
+    const u32 new_segment_end = new_segment.x + new_segment.width;
+    const usize next_segment_index = segment_index + 1;
+    while (next_segment_index < m_skyline.count())
+    {
+        SkylineSegment& segment = m_skyline[next_segment_index];
+        if (segment.x >= new_segment_end)
+            break;
+
+        const u32 covered_width = new_segment_end - segment.x;
+        if (segment.width <= covered_width)
+        {
+            m_skyline.remove(next_segment_index);
+            continue;
+        }
+
+        segment.x += covered_width;
+        segment.width -= covered_width;
+        break;
+    }
+
+    // Merge the neighbouring segments that have the same height.
+    for (usize index = 0; index + 1 < m_skyline.count();)
+    {
+        if (m_skyline[index].y == m_skyline[index + 1].y)
+        {
+            m_skyline[index].width += m_skyline[index + 1].width;
+            m_skyline.remove(index + 1);
+            continue;
+        }
+        ++index;
+    }
+}
+
+} // namespace SE
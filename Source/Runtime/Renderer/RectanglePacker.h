@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/API.h>
+#include <Core/Containers/Optional.h>
+#include <Core/Containers/Vector.h>
+
+namespace SE
+{
+
+struct PackedRectangle
+{
+    u32 x;
+    u32 y;
+    u32 width;
+    u32 height;
+};
+
+//
+// Packs rectangles into a fixed size area using the skyline bottom-left heuristic.
+//
+// The packer keeps track of the "skyline" formed by the top edges of the already packed rectangles. A new rectangle
+// is placed on the skyline segment that results in the lowest top edge, with ties broken by picking the narrowest
+// segment (which wastes the least amount of space). The skyline is usually made of very few segments, so packing
+// is fast enough to be used at runtime, while producing results that are close to the much slower maxrects packers.
+//
+class SkylineRectanglePacker
+{
+public:
+    SHOOTER_API SkylineRectanglePacker(u32 width, u32 height);
+
+    NODISCARD ALWAYS_INLINE u32 get_width() const { return m_width; }
+    NODISCARD ALWAYS_INLINE u32 get_height() const { return m_height; }
+
+    // Returns the fraction of the total area that is covered by the packed rectangles.
+    NODISCARD ALWAYS_INLINE float get_occupancy() const
+    {
+        return static_cast<float>(m_used_area) / (static_cast<float>(m_width) * static_cast<float>(m_height));
+    }
+
+public:
+    // Returns an empty optional if the rectangle doesn't fit in the remaining space.
+    NODISCARD SHOOTER_API Optional<PackedRectangle> pack(u32 width, u32 height);
+
+    SHOOTER_API void reset();
+
+private:
+    struct SkylineSegment
+    {
+        u32 x;
+        u32 y;
+        u32 width;
+    };
+
+private:
+    // Returns the height at which the rectangle would be placed if its left edge is aligned with the given segment,
+    // or an empty optional if the rectangle doesn't fit there.
+    NODISCARD Optional<u32> find_placement_height(usize segment_index, u32 width, u32 height) const;
+
+    void add_skyline_segment(usize segment_index, const PackedRectangle& rectangle);
+
+private:
+    u32 m_width;
+    u32 m_height;
+    u64 m_used_area;
+    Vector<SkylineSegment> m_skyline;
+};
+
+} // namespace SE
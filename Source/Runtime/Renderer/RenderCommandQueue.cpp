@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/Assertions.h>
+#include <Renderer/RenderCommandQueue.h>
+
+namespace SE
+{
+
+ALWAYS_INLINE static uintptr align_address(uintptr address, usize alignment)
+{
+    // The alignment must be a power of two.
+    SE_DEBUG_ASSERT(alignment > 0 && (alignment & (alignment - 1)) == 0);
+    return (address + alignment - 1) & ~(static_cast<uintptr>(alignment) - 1);
+}
+
+RenderCommandQueue::RenderCommandQueue()
+    : m_current_chunk_index(0)
+    , m_current_chunk_offset(0)
+    , m_first_command(nullptr)
+    , m_last_command(nullptr)
+    , m_command_count(0)
+{}
+
+RenderCommandQueue::~RenderCommandQueue()
+{
+    reset();
+
+    for (Chunk& chunk : m_chunks)
+        ::operator delete(chunk.memory);
+    m_chunks.clear_and_shrink();
+}
+
+void* RenderCommandQueue::allocate(usize byte_count, usize alignment)
+{
+    // NOTE: The worst case padding required to align the allocation is `alignment - 1` bytes.
+    const usize required_byte_count = byte_count + alignment - 1;
+
+    if (required_byte_count > chunk_byte_count)
+    {
+        Chunk dedicated_chunk;
+        dedicated_chunk.byte_count = required_byte_count;
+        dedicated_chunk.memory = static_cast<u8*>(::operator new(dedicated_chunk.byte_count));
+        m_dedicated_chunks.add(dedicated_chunk);
+
+        return reinterpret_cast<void*>(align_address(reinterpret_cast<uintptr>(dedicated_chunk.memory), alignment));
+    }
+
+    while (true)
+    {
+        if (m_current_chunk_index == m_chunks.count())
+        {
+            Chunk chunk;
+            chunk.byte_count = chunk_byte_count;
+            chunk.memory = static_cast<u8*>(::operator new(chunk.byte_count));
+            m_chunks.add(chunk);
+        }
+
+        const Chunk& chunk = m_chunks[m_current_chunk_index];
+        const uintptr chunk_address = reinterpret_cast<uintptr>(chunk.memory);
+        const uintptr allocation_address = align_address(chunk_address + m_current_chunk_offset, alignment);
+        const usize allocation_end_offset = static_cast<usize>(allocation_address - chunk_address) + byte_count;
+
+        if (allocation_end_offset <= chunk.byte_count)
+        {
+            m_current_chunk_offset = allocation_end_offset;
+            return reinterpret_cast<void*>(allocation_address);
+        }
+
+        // The allocation doesn't fit in the current chunk, so move to the next one.
+        ++m_current_chunk_index;
+        m_current_chunk_offset = 0;
+    }
+}
+
+void RenderCommandQueue::execute()
+{
+    for (CommandHeader* command = m_first_command; command != nullptr; command = command->next)
+        command->execute_function(command->function);
+}
+
+void RenderCommandQueue::reset()
+{
+    // NOTE: The commands are destroyed in the order they were submitted, so the resources captured by them
+    //       are released in the same order as they would have been released without a render thread.
+    for (CommandHeader* command = m_first_command; command != nullptr; command = command->next)
+        command->destroy_function(command->function);
+
+    m_first_command = nullptr;
+    m_last_command = nullptr;
+    m_command_count = 0;
+
+    for (Chunk& dedicated_chunk : m_dedicated_chunks)
+        ::operator delete(dedicated_chunk.memory);
+    m_dedicated_chunks.clear();
+
+    m_current_chunk_index = 0;
+    m_current_chunk_offset = 0;
+}
+
+void RenderCommandQueue::link_command(CommandHeader* command_header)
+{
+    if (m_last_command)
+        m_last_command->next = command_header;
+    else
+        m_first_command = command_header;
+
+    m_last_command = command_header;
+    ++m_command_count;
+}
+
+} // namespace SE
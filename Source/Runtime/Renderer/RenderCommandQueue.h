@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/API.h>
+#include <Core/Containers/Span.h>
+#include <Core/Containers/Vector.h>
+#include <Core/Memory/MemoryOperations.h>
+
+namespace SE
+{
+
+//
+// Linear list of rendering commands that are recorded by one thread and later executed by another one.
+//
+// Commands are arbitrary callables (usually lambdas) that are stored inline in large memory chunks, so
+// recording a command never allocates once the queue has reached its steady state size. The queue also
+// acts as a per-frame linear allocator (see `allocate`), which is used to copy the data that the commands
+// consume (vertices, uniform data, etc.) out of the memory that the recording thread will overwrite.
+//
+// Executing the commands doesn't destroy them. The callables (and everything they captured, such as the
+// references to the GPU resources they use) are destroyed by `reset`, which is invoked by the thread that
+// owns the queue only after the commands have been executed. This defers the release of the resources
+// until the GPU commands that use them have been recorded.
+//
+class RenderCommandQueue
+{
+    SE_MAKE_NONCOPYABLE(RenderCommandQueue);
+    SE_MAKE_NONMOVABLE(RenderCommandQueue);
+
+public:
+    static constexpr usize chunk_byte_count = 256 * KiB;
+
+public:
+    SHOOTER_API RenderCommandQueue();
+    SHOOTER_API ~RenderCommandQueue();
+
+    NODISCARD ALWAYS_INLINE u32 get_command_count() const { return m_command_count; }
+    NODISCARD ALWAYS_INLINE bool is_empty() const { return (m_command_count == 0); }
+
+public:
+    template<typename CommandFunction>
+    ALWAYS_INLINE void submit(CommandFunction&& command_function)
+    {
+        using FunctionType = RemoveConst<RemoveReference<CommandFunction>>;
+
+        struct CommandStorage
+        {
+            static void execute(void* function) { (*static_cast<FunctionType*>(function))(); }
+            static void destroy(void* function) { static_cast<FunctionType*>(function)->~FunctionType(); }
+        };
+
+        CommandHeader* command_header = static_cast<CommandHeader*>(allocate(sizeof(CommandHeader), alignof(CommandHeader)));
+        void* function_memory = allocate(sizeof(FunctionType), alignof(FunctionType));
+        new (function_memory) FunctionType(forward<CommandFunction>(command_function));
+
+        command_header->execute_function = CommandStorage::execute;
+        command_header->destroy_function = CommandStorage::destroy;
+        command_header->function = function_memory;
+        command_header->next = nullptr;
+        link_command(command_header);
+    }
+
+    //
+    // Allocates a block of memory that remains valid until the queue is reset. The memory is not initialized.
+    // Allocations larger than the chunk size are supported, but they always require a dedicated heap allocation.
+    //
+    NODISCARD SHOOTER_API void* allocate(usize byte_count, usize alignment);
+
+    // Copies the given span into memory owned by the queue. Only trivially copyable types should be used.
+    template<typename T>
+    NODISCARD ALWAYS_INLINE Span<const T> copy_span(Span<const T> span)
+    {
+        if (span.is_empty())
+            return {};
+
+        T* elements = static_cast<T*>(allocate(span.count() * sizeof(T), alignof(T)));
+        copy_memory(elements, span.elements(), span.count() * sizeof(T));
+        return Span<const T>(elements, span.count());
+    }
+
+    // Invokes all recorded commands, in the order they were submitted.
+    SHOOTER_API void execute();
+
+    // Destroys all recorded commands and releases all allocations, but keeps the memory chunks for reuse.
+    SHOOTER_API void reset();
+
+private:
+    using PFN_ExecuteCommand = void (*)(void* function);
+    using PFN_DestroyCommand = void (*)(void* function);
+
+    struct CommandHeader
+    {
+        PFN_ExecuteCommand execute_function;
+        PFN_DestroyCommand destroy_function;
+        void* function;
+        CommandHeader* next;
+    };
+
+    struct Chunk
+    {
+        u8* memory;
+        usize byte_count;
+    };
+
+private:
+    SHOOTER_API void link_command(CommandHeader* command_header);
+
+private:
+    Vector<Chunk> m_chunks;
+    // Allocations that don't fit in a regular chunk. They are released every time the queue is reset.
+    Vector<Chunk> m_dedicated_chunks;
+    usize m_current_chunk_index;
+    usize m_current_chunk_offset;
+
+    CommandHeader* m_first_command;
+    CommandHeader* m_last_command;
+    u32 m_command_count;
+};
+
+} // namespace SE
@@ -6,9 +6,9 @@
 #pragma once
 
 #include <Core/Containers/RefPtr.h>
-#include <Core/String/StringView.h>
 #include <Core/Containers/Vector.h>
 #include <Core/Math/Color.h>
+#include <Core/String/Name.h>
 #include <Renderer/Framebuffer.h>
 #include <Renderer/Pipeline.h>
 #include <Renderer/ShaderStage.h>
@@ -81,6 +81,13 @@ struct RenderPassTextureArrayBinding
     Vector<RefPtr<Texture2D>> texture_array;
 };
 
+//
+// Integer handle that identifies an input of a render pass. The binding slots are those of the inputs of the pipeline
+// used by the render pass, which are resolved once when the pipeline is created.
+//
+using RenderPassBindingSlot = PipelineBindingSlot;
+static constexpr RenderPassBindingSlot invalid_render_pass_binding_slot = invalid_pipeline_binding_slot;
+
 class RenderPass : public RefCounted
 {
 public:
@@ -92,15 +99,29 @@ public:
 public:
     // Binds all the provided inputs to the pipeline. Must be manually invoked every time the render pass
     // begins or before one of the input resources will be used.
+    // Only the inputs that changed since the last invocation are re-bound.
     virtual bool bind_inputs() = 0;
 
-    virtual void set_input(StringView name, const RenderPassUniformBufferBinding& uniform_buffer_binding) = 0;
-    virtual void set_input(StringView name, const RenderPassTextureBinding& texture_binding) = 0;
-    virtual void set_input(StringView name, const RenderPassTextureArrayBinding& texture_array_binding) = 0;
-
-    virtual void update_input(StringView name, RefPtr<UniformBuffer> uniform_buffer) = 0;
-    virtual void update_input(StringView name, RefPtr<Texture2D> texture) = 0;
-    virtual void update_input(StringView name, Span<RefPtr<Texture2D>> texture_array) = 0;
+    // Sets the resource of an input that is declared by the pipeline of the render pass and returns its binding slot.
+    virtual RenderPassBindingSlot set_input(Name name, const RenderPassUniformBufferBinding& uniform_buffer_binding) = 0;
+    virtual RenderPassBindingSlot set_input(Name name, const RenderPassTextureBinding& texture_binding) = 0;
+    virtual RenderPassBindingSlot set_input(Name name, const RenderPassTextureArrayBinding& texture_array_binding) = 0;
+
+    // Returns the binding slot of the input with the given name, or `invalid_render_pass_binding_slot` if the pipeline
+    // doesn't declare such an input.
+    NODISCARD virtual RenderPassBindingSlot get_binding_slot(Name name) const = 0;
+
+    virtual void update_input(RenderPassBindingSlot binding_slot, RefPtr<UniformBuffer> uniform_buffer) = 0;
+    virtual void update_input(RenderPassBindingSlot binding_slot, RefPtr<Texture2D> texture) = 0;
+    virtual void update_input(RenderPassBindingSlot binding_slot, Span<RefPtr<Texture2D>> texture_array) = 0;
+
+    //
+    // Convenience wrappers that resolve the binding slot from the input name. They perform a lookup every time they are
+    // called, so code that updates inputs frequently (such as once per batch) should cache the binding slot instead.
+    //
+    ALWAYS_INLINE void update_input(Name name, RefPtr<UniformBuffer> uniform_buffer) { update_input(get_binding_slot(name), move(uniform_buffer)); }
+    ALWAYS_INLINE void update_input(Name name, RefPtr<Texture2D> texture) { update_input(get_binding_slot(name), move(texture)); }
+    ALWAYS_INLINE void update_input(Name name, Span<RefPtr<Texture2D>> texture_array) { update_input(get_binding_slot(name), texture_array); }
 };
 
 } // namespace SE
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/CoreTypes.h>
+#include <Core/Math/MathCore.h>
+
+namespace SE
+{
+
+//
+// The resources that are bound to the registers of a shader stage. The `current_handles` array stores the state
+// described by the render pass inputs, while the `bound_handles` array stores the state that was last set on the
+// device, so binding the inputs only has to issue calls for the registers that differ.
+//
+template<typename HandleType, u32 MaxRegisterCount>
+struct RenderPassRegisterSet
+{
+    static constexpr u32 max_register_count = MaxRegisterCount;
+
+    //
+    // Invokes the bind function once, for the range of registers whose current handles differ from the bound ones. Unless
+    // a full re-bind is requested, nothing is done if all registers are already up to date. Returns whether the bind function
+    // was invoked. The bind function is called as `bind_function(first_register, register_count, handles)`.
+    // NOTE: This function never allocates memory, as it is invoked for every batch.
+    //
+    template<typename BindFunction>
+    ALWAYS_INLINE bool bind_changed_registers(bool bind_all_registers, BindFunction bind_function)
+    {
+        u32 first_changed_register = register_count;
+        u32 last_changed_register = 0;
+
+        for (u32 register_index = 0; register_index < register_count; ++register_index)
+        {
+            if (bind_all_registers || current_handles[register_index] != bound_handles[register_index])
+            {
+                first_changed_register = Math::min(first_changed_register, register_index);
+                last_changed_register = register_index;
+            }
+        }
+
+        if (first_changed_register == register_count)
+            return false;
+
+        const u32 changed_register_count = last_changed_register - first_changed_register + 1;
+        bind_function(first_changed_register, changed_register_count, current_handles + first_changed_register);
+
+        for (u32 register_index = first_changed_register; register_index <= last_changed_register; ++register_index)
+            bound_handles[register_index] = current_handles[register_index];
+        return true;
+    }
+
+    HandleType* current_handles[MaxRegisterCount] = {};
+    HandleType* bound_handles[MaxRegisterCount] = {};
+    u32 register_count { 0 };
+};
+
+} // namespace SE
@@ -4,11 +4,14 @@
  */
 
 #include <Core/Containers/HashMap.h>
+#include <Core/Log.h>
+#include <Core/Platform/Thread.h>
 #include <Engine/Application/Window.h>
 #include <Renderer/Renderer.h>
 #include <Renderer/RendererAPI.h>
 #include <Renderer/RendererInterface.h>
 #include <Renderer/RenderingContext.h>
+#include <Renderer/TransientUploadRing.h>
 
 namespace SE
 {
@@ -19,6 +22,11 @@ struct ContextTableEntry
     RefPtr<Framebuffer> swapchain_framebuffer;
 };
 
+// NOTE: One transient vertex buffer is used for each frame that can be in flight: the one recorded by the main thread
+//       and the one executed by the render thread.
+static constexpr u32 transient_vertex_buffer_count = 2;
+static constexpr u32 transient_vertex_buffer_byte_count = 4 * MiB;
+
 struct RendererData
 {
     OwnPtr<RendererInterface> renderer_interface;
@@ -27,15 +35,85 @@ struct RendererData
 
     RefPtr<Texture2D> black_texture;
     RefPtr<Texture2D> white_texture;
+
+    OwnPtr<TransientUploadRing> transient_upload_ring;
+    RefPtr<VertexBuffer> transient_vertex_buffers[transient_vertex_buffer_count];
+
+    RendererThreadingMode threading_mode { RendererThreadingMode::SingleThreaded };
+
+    // NOTE: The main thread records the commands in the submission queue, while the render thread executes the
+    //       other queue. The queues are swapped at the end of each frame.
+    RenderCommandQueue command_queues[2];
+    u32 submission_command_queue_index { 0 };
+
+    Thread render_thread;
+    Mutex render_thread_mutex;
+    ConditionVariable render_thread_condition_variable;
+    // The command queue that the render thread should execute, or nullptr if the render thread is idle.
+    // Protected by the render thread mutex.
+    RenderCommandQueue* executing_command_queue { nullptr };
+    bool render_thread_should_exit { false };
 };
 
 static RendererData* s_renderer;
 
-bool Renderer::initialize()
+static void render_thread_entry_point(void*)
+{
+    while (true)
+    {
+        RenderCommandQueue* command_queue;
+        {
+            ScopedLock lock(s_renderer->render_thread_mutex);
+            while (s_renderer->executing_command_queue == nullptr && !s_renderer->render_thread_should_exit)
+                s_renderer->render_thread_condition_variable.wait(s_renderer->render_thread_mutex);
+
+            if (s_renderer->executing_command_queue == nullptr)
+                break;
+            command_queue = s_renderer->executing_command_queue;
+        }
+
+        command_queue->execute();
+
+        {
+            ScopedLock lock(s_renderer->render_thread_mutex);
+            s_renderer->executing_command_queue = nullptr;
+        }
+        s_renderer->render_thread_condition_variable.notify_all();
+    }
+}
+
+static void wait_for_render_thread()
+{
+    ScopedLock lock(s_renderer->render_thread_mutex);
+    while (s_renderer->executing_command_queue != nullptr)
+        s_renderer->render_thread_condition_variable.wait(s_renderer->render_thread_mutex);
+}
+
+static void kick_render_thread()
+{
+    // Wait for the render thread to finish the commands of the previous frame.
+    wait_for_render_thread();
+
+    const u32 executing_command_queue_index = s_renderer->submission_command_queue_index;
+    s_renderer->submission_command_queue_index = (executing_command_queue_index + 1) % SE_ARRAY_COUNT(s_renderer->command_queues);
+
+    // NOTE: The render thread is idle and it has already executed the commands of the next submission queue, so
+    //       the commands (and the resources they captured) can be safely destroyed by the main thread.
+    s_renderer->command_queues[s_renderer->submission_command_queue_index].reset();
+
+    {
+        ScopedLock lock(s_renderer->render_thread_mutex);
+        s_renderer->executing_command_queue = &s_renderer->command_queues[executing_command_queue_index];
+    }
+    s_renderer->render_thread_condition_variable.notify_all();
+}
+
+bool Renderer::initialize(RendererThreadingMode threading_mode /*= RendererThreadingMode::SingleThreaded*/)
 {
     if (s_renderer)
         return false;
     s_renderer = new RendererData();
+    s_renderer->threading_mode = threading_mode;
 
     // Set the rendering API.
     RendererAPI renderer_api = get_recommended_renderer_api_for_current_platform();
@@ -66,6 +144,25 @@ bool Renderer::initialize()
     white_texture_description.data = ReadonlyByteSpan(white_texture_data, sizeof(white_texture_data));
     s_renderer->white_texture = Texture2D::create(white_texture_description);
 
+    // Create the transient vertex buffers.
+    s_renderer->transient_upload_ring = create_own<TransientUploadRing>(transient_vertex_buffer_byte_count, transient_vertex_buffer_count);
+    for (RefPtr<VertexBuffer>& transient_vertex_buffer : s_renderer->transient_vertex_buffers)
+    {
+        VertexBufferDescription transient_vertex_buffer_description = {};
+        transient_vertex_buffer_description.byte_count = transient_vertex_buffer_byte_count;
+        transient_vertex_buffer_description.update_frequency = VertexBufferUpdateFrequency::High;
+        transient_vertex_buffer = VertexBuffer::create(transient_vertex_buffer_description);
+    }
+
+    if (s_renderer->threading_mode == RendererThreadingMode::RenderThread)
+    {
+        if (!s_renderer->render_thread.start(render_thread_entry_point, nullptr, "RenderThread"sv))
+        {
+            SE_LOG_TAG_ERROR("Renderer", "Failed to start the render thread! Falling back to single-threaded rendering.");
+            s_renderer->threading_mode = RendererThreadingMode::SingleThreaded;
+        }
+    }
+
     return true;
 }
 
@@ -74,6 +171,22 @@ void Renderer::shutdown()
     if (s_renderer == nullptr)
         return;
 
+    if (s_renderer->render_thread.is_joinable())
+    {
+        flush();
+
+        {
+            ScopedLock lock(s_renderer->render_thread_mutex);
+            s_renderer->render_thread_should_exit = true;
+        }
+        s_renderer->render_thread_condition_variable.notify_all();
+        s_renderer->render_thread.join();
+    }
+
+    for (RenderCommandQueue& command_queue : s_renderer->command_queues)
+        command_queue.reset();
+    s_renderer->threading_mode = RendererThreadingMode::SingleThreaded;
+
     for (auto it : s_renderer->context_table)
     {
         it.value.swapchain_framebuffer.release();
@@ -83,6 +196,10 @@ void Renderer::shutdown()
     s_renderer->black_texture.release();
     s_renderer->white_texture.release();
 
+    for (RefPtr<VertexBuffer>& transient_vertex_buffer : s_renderer->transient_vertex_buffers)
+        transient_vertex_buffer.release();
+    s_renderer->transient_upload_ring.release();
+
     s_renderer->renderer_interface->shutdown();
     s_renderer->renderer_interface.release();
 
@@ -95,8 +212,16 @@ bool Renderer::is_initialized()
     return (s_renderer != nullptr);
 }
 
+RendererThreadingMode Renderer::get_threading_mode()
+{
+    return s_renderer->threading_mode;
+}
+
 void Renderer::on_resize(u32 new_width, u32 new_height)
 {
+    // The swapchain images can't be resized while the render thread might still use them.
+    flush();
+
     s_renderer->renderer_interface->on_resize(new_width, new_height);
 
     for (auto it : s_renderer->context_table)
@@ -123,6 +248,9 @@ RenderingContext* Renderer::create_context_for_window(Window* window)
 
 void Renderer::destroy_context_for_window(Window* window)
 {
+    // The render thread might still present to the swapchain of the context.
+    flush();
+
     Optional<ContextTableEntry&> context_entry = s_renderer->context_table.get_if_exists(window->get_native_handle());
     SE_ASSERT(context_entry.has_value());
 
@@ -165,22 +293,80 @@ void Renderer::begin_frame()
 {
     // No context is currently active.
     SE_ASSERT(s_renderer->active_context != nullptr);
+
+    s_renderer->transient_upload_ring->begin_frame();
 }
 
 void Renderer::end_frame()
 {
     RenderingContext* active_context = Renderer::get_active_context();
-    s_renderer->renderer_interface->present(active_context);
+    submit([active_context]() { s_renderer->renderer_interface->present(active_context); });
+
+    if (s_renderer->threading_mode == RendererThreadingMode::RenderThread)
+        kick_render_thread();
+}
+
+void Renderer::flush()
+{
+    if (s_renderer->threading_mode == RendererThreadingMode::SingleThreaded)
+        return;
+
+    if (!get_submission_command_queue().is_empty())
+        kick_render_thread();
+    wait_for_render_thread();
+}
+
+ReadonlyByteSpan Renderer::copy_to_frame_memory(ReadonlyByteSpan data)
+{
+    if (s_renderer->threading_mode == RendererThreadingMode::SingleThreaded)
+        return data;
+
+    return get_submission_command_queue().copy_span(data);
+}
+
+TransientVertexData Renderer::upload_transient_vertex_data(ReadonlyByteSpan vertices)
+{
+    TransientVertexData transient_vertex_data;
+
+    Optional<TransientUploadAllocation> allocation = s_renderer->transient_upload_ring->allocate(static_cast<u32>(vertices.count()));
+    if (!allocation.has_value())
+    {
+        // NOTE: The data doesn't fit in a transient vertex buffer, so a dedicated vertex buffer is created instead. This is slow,
+        //       but it only happens when a single upload is larger than the whole transient buffer.
+        SE_LOG_TAG_WARN("Renderer", "Vertex data ({} bytes) doesn't fit in the transient vertex buffer!", vertices.count());
+
+        VertexBufferDescription vertex_buffer_description = {};
+        vertex_buffer_description.byte_count = static_cast<u32>(vertices.count());
+        vertex_buffer_description.update_frequency = VertexBufferUpdateFrequency::Never;
+        vertex_buffer_description.data = vertices;
+        transient_vertex_data.vertex_buffer = VertexBuffer::create(vertex_buffer_description);
+        return transient_vertex_data;
+    }
+
+    transient_vertex_data.vertex_buffer = s_renderer->transient_vertex_buffers[allocation.value().buffer_index];
+    transient_vertex_data.byte_offset = allocation.value().byte_offset;
+
+    submit(
+        [vertex_buffer = transient_vertex_data.vertex_buffer, allocation = allocation.value(), vertices = copy_to_frame_memory(vertices)]() mutable
+        { vertex_buffer->write_data(allocation.byte_offset, vertices, allocation.discard_previous_contents); }
+    );
+
+    return transient_vertex_data;
+}
+
+RenderCommandQueue& Renderer::get_submission_command_queue()
+{
+    return s_renderer->command_queues[s_renderer->submission_command_queue_index];
 }
 
 void Renderer::begin_render_pass(RefPtr<RenderPass> render_pass)
 {
-    s_renderer->renderer_interface->begin_render_pass(move(render_pass));
+    submit([render_pass = move(render_pass)]() { s_renderer->renderer_interface->begin_render_pass(render_pass); });
 }
 
 void Renderer::end_render_pass()
 {
-    s_renderer->renderer_interface->end_render_pass();
+    submit([]() { s_renderer->renderer_interface->end_render_pass(); });
 }
 
 RendererDevice Renderer::get_device()
@@ -188,9 +374,12 @@ RendererDevice Renderer::get_device()
     return s_renderer->renderer_interface->get_renderer_device();
 }
 
-void Renderer::draw_indexed(RefPtr<VertexBuffer> vertex_buffer, RefPtr<IndexBuffer> index_buffer, u32 indices_count)
+void Renderer::draw_indexed(RefPtr<VertexBuffer> vertex_buffer, RefPtr<IndexBuffer> index_buffer, u32 indices_count, u32 vertex_buffer_byte_offset /*= 0*/)
 {
-    s_renderer->renderer_interface->draw_indexed(vertex_buffer, index_buffer, indices_count);
+    submit(
+        [vertex_buffer = move(vertex_buffer), index_buffer = move(index_buffer), indices_count, vertex_buffer_byte_offset]()
+        { s_renderer->renderer_interface->draw_indexed(vertex_buffer, index_buffer, indices_count, vertex_buffer_byte_offset); }
+    );
 }
 
 RefPtr<Texture2D> Renderer::get_black_texture()
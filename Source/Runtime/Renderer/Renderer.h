@@ -8,6 +8,7 @@
 #include <Core/API.h>
 #include <Renderer/Framebuffer.h>
 #include <Renderer/IndexBuffer.h>
+#include <Renderer/RenderCommandQueue.h>
 #include <Renderer/RenderPass.h>
 #include <Renderer/RendererDevice.h>
 #include <Renderer/Texture.h>
@@ -20,13 +21,33 @@ namespace SE
 class RenderingContext;
 class Window;
 
+//
+// Vertex data that was uploaded to the transient upload ring. The data is only valid until the end of the current frame.
+//
+struct TransientVertexData
+{
+    RefPtr<VertexBuffer> vertex_buffer;
+    u32 byte_offset { 0 };
+};
+
+enum class RendererThreadingMode : u8
+{
+    // The rendering commands are executed immediately, on the thread that submits them.
+    SingleThreaded,
+    // The rendering commands are recorded by the main thread and executed by a dedicated render thread. The render
+    // thread executes the commands of frame N while the main thread records the commands of frame N + 1.
+    RenderThread,
+};
+
 class Renderer
 {
 public:
-    SHOOTER_API static bool initialize();
+    SHOOTER_API static bool initialize(RendererThreadingMode threading_mode = RendererThreadingMode::SingleThreaded);
     SHOOTER_API static void shutdown();
     SHOOTER_API static bool is_initialized();
 
+    NODISCARD SHOOTER_API static RendererThreadingMode get_threading_mode();
+
     SHOOTER_API static void on_resize(u32 new_width, u32 new_height);
 
 public:
@@ -41,20 +62,61 @@ public:
 
 public:
     SHOOTER_API static void begin_frame();
+
+    // Submits the present command and, when a render thread is used, hands the recorded commands over to it.
+    // Blocks only if the render thread hasn't finished executing the commands of the previous frame yet.
     SHOOTER_API static void end_frame();
 
+    // Blocks until all the commands submitted so far have been executed. Must be called before modifying
+    // the state that the render thread might be using (for example, before resizing a framebuffer).
+    SHOOTER_API static void flush();
+
     SHOOTER_API NODISCARD static RendererDevice get_device();
 
+public:
+    //
+    // Submits a command that will be executed on the render thread, or immediately when the renderer is single-threaded.
+    // The command must not reference any memory that the submitting code will modify or release before the command is
+    // executed. Resources should be captured by value (as `RefPtr`), which defers their release until the command has
+    // been executed, while raw data should be copied using `copy_to_frame_memory`.
+    //
+    template<typename CommandFunction>
+    ALWAYS_INLINE static void submit(CommandFunction&& command_function)
+    {
+        if (get_threading_mode() == RendererThreadingMode::SingleThreaded)
+        {
+            command_function();
+            return;
+        }
+
+        get_submission_command_queue().submit(forward<CommandFunction>(command_function));
+    }
+
+    //
+    // Copies the given data into memory that remains valid until the commands of the current frame have been executed.
+    // When the renderer is single-threaded the commands are executed immediately, so no copy is made.
+    //
+    NODISCARD SHOOTER_API static ReadonlyByteSpan copy_to_frame_memory(ReadonlyByteSpan data);
+
+    //
+    // Sub-allocates the vertices from the transient vertex buffer of the current frame, instead of discarding the contents
+    // of a dedicated buffer for every upload. The returned buffer and offset should be passed to `draw_indexed`.
+    //
+    NODISCARD SHOOTER_API static TransientVertexData upload_transient_vertex_data(ReadonlyByteSpan vertices);
+
 public:
     SHOOTER_API static void begin_render_pass(RefPtr<RenderPass> render_pass);
     SHOOTER_API static void end_render_pass();
 
 public:
-    SHOOTER_API static void draw_indexed(RefPtr<VertexBuffer> vertex_buffer, RefPtr<IndexBuffer> index_buffer, u32 indices_count);
+    SHOOTER_API static void draw_indexed(RefPtr<VertexBuffer> vertex_buffer, RefPtr<IndexBuffer> index_buffer, u32 indices_count, u32 vertex_buffer_byte_offset = 0);
 
 public:
     NODISCARD SHOOTER_API static RefPtr<Texture2D> get_black_texture();
     NODISCARD SHOOTER_API static RefPtr<Texture2D> get_white_texture();
+
+private:
+    NODISCARD SHOOTER_API static RenderCommandQueue& get_submission_command_queue();
 };
 
 } // namespace SE
@@ -59,14 +59,21 @@ void Renderer2D::begin_frame(const Matrix4& view_projection_matrix)
     UniformFrameData frame_data = {};
     frame_data.view_projection_matrix = view_projection_matrix;
     const ReadonlyByteSpan frame_data_byte_span = ReadonlyByteSpan(reinterpret_cast<ReadonlyBytes>(&frame_data), sizeof(UniformFrameData));
-    m_frame_data_uniform_buffer->upload_data(frame_data_byte_span);
+    Renderer::submit(
+        [uniform_buffer = m_frame_data_uniform_buffer, frame_data = Renderer::copy_to_frame_memory(frame_data_byte_span)]() mutable
+        { uniform_buffer->upload_data(frame_data); }
+    );
 
+    // NOTE: The render pass is active for the whole frame, so the batches only have to re-bind the inputs that
+    //       changed (and the render target is cleared only once, not for each batch).
+    Renderer::begin_render_pass(m_quad_render_pass);
     begin_quad_batch();
 }
 
 void Renderer2D::end_frame()
 {
     end_quad_batch();
+    Renderer::end_render_pass();
 }
 
 void Renderer2D::submit_quad(Vector2 translation, Vector2 scale, Color4 color)
@@ -91,6 +98,13 @@ void Renderer2D::submit_quad(Vector2 translation, Vector2 scale, Color4 color)
 }
 
 void Renderer2D::submit_quad(Vector2 translation, Vector2 scale, RefPtr<Texture2D> texture, Color4 tint_color /*= Color4(1, 1, 1, 1)*/)
+{
+    submit_quad(translation, scale, move(texture), TextureUVRect(), tint_color);
+}
+
+void Renderer2D::submit_quad(
+    Vector2 translation, Vector2 scale, RefPtr<Texture2D> texture, const TextureUVRect& uv_rect, Color4 tint_color /*= Color4(1, 1, 1, 1)*/
+)
 {
     if (m_statistics.quads_in_current_batch == m_max_quads_per_batch)
     {
@@ -107,13 +121,13 @@ void Renderer2D::submit_quad(Vector2 translation, Vector2 scale, RefPtr<Texture2
     }
 
     SE_DEBUG_ASSERT(texture_index.has_value());
-    construct_quad(translation, scale, tint_color, texture_index.value());
+    construct_quad(translation, scale, tint_color, texture_index.value(), uv_rect);
 }
 
 bool Renderer2D::initialize_quads()
 {
     m_max_quads_per_batch = 8192;
-    m_max_quad_textures_per_batch = 8;
+    m_max_quad_textures_per_batch = max_quad_textures_per_batch;
 
     // Each quad requires 4 vertices in order to be rendered.
     m_quad_vertices.set_count(4 * m_max_quads_per_batch);
@@ -131,12 +145,21 @@ bool Renderer2D::initialize_quads()
     String vertex_shader_source_code;
     String fragment_shader_source_code;
 
-    // The root directory where all engine shaders are stored on disk.
-    const String shaders_directory = StringBuilder::path_join({ g_engine->get_engine_root_directory().view(), "Content/Runtime/Shaders"sv });
+    // The engine shaders are stored in the same directory, so their filepaths are built directly in a single buffer.
+    const auto get_shader_filepath = [](StringView shader_filename) -> String
+    {
+        const String engine_root_directory = g_engine->get_engine_root_directory();
+        const StringView shaders_directory = "Content/Runtime/Shaders"sv;
+
+        StringBuilder filepath_builder;
+        filepath_builder.reserve(engine_root_directory.byte_count() + shaders_directory.byte_count() + shader_filename.byte_count() + 2);
+        filepath_builder.append_path(engine_root_directory.view()).append_path(shaders_directory).append_path(shader_filename);
+        return filepath_builder.release_string();
+    };
 
     {
         FileReader vertex_shader_file_reader;
-        vertex_shader_file_reader.open(shaders_directory + "/Renderer2D_Quad_V.hlsl"sv);
+        vertex_shader_file_reader.open(get_shader_filepath("Renderer2D_Quad_V.hlsl"sv));
         vertex_shader_source_code;
         vertex_shader_file_reader.read_entire_to_string_and_close(vertex_shader_source_code);
 
@@ -148,7 +171,7 @@ bool Renderer2D::initialize_quads()
 
     {
         FileReader fragment_shader_file_reader;
-        fragment_shader_file_reader.open(shaders_directory + "/Renderer2D_Quad_F.hlsl"sv);
+        fragment_shader_file_reader.open(get_shader_filepath("Renderer2D_Quad_F.hlsl"sv));
         fragment_shader_source_code;
         fragment_shader_file_reader.read_entire_to_string_and_close(fragment_shader_source_code);
 
@@ -174,6 +197,8 @@ bool Renderer2D::initialize_quads()
     pipeline_description.vertex_attributes.add({ PipelineVertexAttributeType::Float4, "COLOR"sv });
     pipeline_description.vertex_attributes.add({ PipelineVertexAttributeType::Float2, "TEXTURE_COORDINATES"sv });
     pipeline_description.vertex_attributes.add({ PipelineVertexAttributeType::UInt1, "TEXTURE_ID"sv });
+    pipeline_description.inputs.add({ PipelineInputType::UniformBuffer, "u_FrameData"sv, ShaderStage::Vertex });
+    pipeline_description.inputs.add({ PipelineInputType::TextureArray, "u_Textures"sv, ShaderStage::Fragment, m_max_quad_textures_per_batch });
     pipeline_description.primitive_topology = PipelinePrimitiveTopology::TriangleList;
     pipeline_description.cull_mode = PipelineCullMode::None;
 
@@ -198,16 +223,7 @@ bool Renderer2D::initialize_quads()
     m_quad_render_pass = RenderPass::create(render_pass_description);
 
     m_quad_render_pass->set_input("u_FrameData"sv, RenderPassUniformBufferBinding(m_frame_data_uniform_buffer, ShaderStage::Vertex));
-    m_quad_render_pass->set_input("u_Textures"sv, RenderPassTextureArrayBinding(m_quad_textures.span()));
-
-    //
-    // Quad vertex buffer.
-    //
-
-    VertexBufferDescription vertex_buffer_description = {};
-    vertex_buffer_description.byte_count = static_cast<u32>(m_quad_vertices.count() * sizeof(QuadVertex));
-    vertex_buffer_description.update_frequency = VertexBufferUpdateFrequency::High;
-    m_quad_vertex_buffer = VertexBuffer::create(vertex_buffer_description);
+    m_quad_textures_binding_slot = m_quad_render_pass->set_input("u_Textures"sv, RenderPassTextureArrayBinding(m_quad_textures.span()));
 
     //
     // Quad index buffer.
@@ -247,8 +263,8 @@ void Renderer2D::shutdown_quads()
     m_quad_textures.clear_and_shrink();
 
     m_quad_index_buffer.release();
-    m_quad_vertex_buffer.release();
     m_quad_render_pass.release();
+    m_quad_textures_binding_slot = invalid_render_pass_binding_slot;
     m_quad_pipeline.release();
     m_quad_shader.release();
 }
@@ -265,26 +281,35 @@ void Renderer2D::begin_quad_batch()
 
 void Renderer2D::end_quad_batch()
 {
-    Renderer::begin_render_pass(m_quad_render_pass);
-
     if (m_statistics.quads_in_current_batch > 0)
     {
         // Upload the vertices to the vertex buffer.
         const u32 vertices_count = 4 * m_statistics.quads_in_current_batch;
-        m_quad_vertex_buffer->update_data(m_quad_vertices.slice(0, vertices_count).as<ReadonlyByte>());
+        // NOTE: The vertices of all batches are sub-allocated from the same transient vertex buffer, instead of discarding
+        //       the contents of a dedicated vertex buffer for each batch.
+        const TransientVertexData vertex_data = Renderer::upload_transient_vertex_data(m_quad_vertices.slice(0, vertices_count).as<ReadonlyByte>());
 
         // Update the textures.
-        m_quad_render_pass->update_input("u_Textures"sv, m_quad_textures.span());
-        m_quad_render_pass->bind_inputs();
+        // NOTE: The texture slots are released when the next batch begins, so they are moved into the command instead, which
+        //       releases them once it has been executed. The array has a fixed size, so no memory is allocated for each batch.
+        QuadBatchTextures batch_textures;
+        for (u32 texture_index = 0; texture_index < m_statistics.quad_textures_in_current_batch; ++texture_index)
+            batch_textures.textures[texture_index] = move(m_quad_textures[texture_index]);
+
+        Renderer::submit(
+            [render_pass = m_quad_render_pass, binding_slot = m_quad_textures_binding_slot, batch_textures = move(batch_textures)]() mutable
+            {
+                render_pass->update_input(binding_slot, Span<RefPtr<Texture2D>>(batch_textures.textures, max_quad_textures_per_batch));
+                render_pass->bind_inputs();
+            }
+        );
 
         // Each quad requires 6 indices in order to be rendered.
-        Renderer::draw_indexed(m_quad_vertex_buffer, m_quad_index_buffer, 6 * m_statistics.quads_in_current_batch);
+        Renderer::draw_indexed(vertex_data.vertex_buffer, m_quad_index_buffer, 6 * m_statistics.quads_in_current_batch, vertex_data.byte_offset);
     }
-
-    Renderer::end_render_pass();
 }
 
-void Renderer2D::construct_quad(Vector2 translation, Vector2 scale, Color4 color, u32 texture_index)
+void Renderer2D::construct_quad(Vector2 translation, Vector2 scale, Color4 color, u32 texture_index, const TextureUVRect& uv_rect /*= {}*/)
 {
     SE_ASSERT(m_statistics.quads_in_current_batch < m_max_quads_per_batch);
     SE_ASSERT(texture_index < m_max_quad_textures_per_batch);
@@ -293,25 +318,25 @@ void Renderer2D::construct_quad(Vector2 translation, Vector2 scale, Color4 color
     // Bottom-left vertex.
     vertices[0].position = translation + Vector2(-0.5F * scale.x, -0.5F * scale.y);
     vertices[0].color = color;
-    vertices[0].texture_coordinates = Vector2(0, 0);
+    vertices[0].texture_coordinates = Vector2(uv_rect.min.x, uv_rect.min.y);
     vertices[0].texture_id = texture_index;
 
     // Bottom-right vertex.
     vertices[1].position = translation + Vector2(0.5F * scale.x, -0.5F * scale.y);
     vertices[1].color = color;
-    vertices[1].texture_coordinates = Vector2(1, 0);
+    vertices[1].texture_coordinates = Vector2(uv_rect.max.x, uv_rect.min.y);
     vertices[1].texture_id = texture_index;
 
     // Top-right vertex.
     vertices[2].position = translation + Vector2(0.5F * scale.x, 0.5F * scale.y);
     vertices[2].color = color;
-    vertices[2].texture_coordinates = Vector2(1, 1);
+    vertices[2].texture_coordinates = Vector2(uv_rect.max.x, uv_rect.max.y);
     vertices[2].texture_id = texture_index;
 
     // Top-left vertex.
     vertices[3].position = translation + Vector2(-0.5F * scale.x, 0.5F * scale.y);
     vertices[3].color = color;
-    vertices[3].texture_coordinates = Vector2(0, 1);
+    vertices[3].texture_coordinates = Vector2(uv_rect.min.x, uv_rect.max.y);
     vertices[3].texture_id = texture_index;
 
     m_statistics.quads_in_current_batch++;
@@ -14,6 +14,7 @@
 #include <Renderer/Pipeline.h>
 #include <Renderer/RenderPass.h>
 #include <Renderer/Shader.h>
+#include <Renderer/Texture.h>
 #include <Renderer/VertexBuffer.h>
 
 namespace SE
@@ -62,6 +63,20 @@ public:
 
     SHOOTER_API void submit_quad(Vector2 translation, Vector2 scale, RefPtr<Texture2D> texture, Color4 tint_color = Color4(1, 1, 1, 1));
 
+    // Samples only the given region of the texture. Used to render images that are packed in a texture atlas page.
+    SHOOTER_API void submit_quad(
+        Vector2 translation, Vector2 scale, RefPtr<Texture2D> texture, const TextureUVRect& uv_rect, Color4 tint_color = Color4(1, 1, 1, 1)
+    );
+
+private:
+    static constexpr u32 max_quad_textures_per_batch = 8;
+
+    // The textures bound by a batch, which are owned by the command that binds them until it has been executed.
+    struct QuadBatchTextures
+    {
+        RefPtr<Texture2D> textures[max_quad_textures_per_batch];
+    };
+
 private:
     bool initialize_quads();
     void shutdown_quads();
@@ -69,7 +84,7 @@ private:
     void begin_quad_batch();
     void end_quad_batch();
 
-    void construct_quad(Vector2 translation, Vector2 scale, Color4 color, u32 texture_index);
+    void construct_quad(Vector2 translation, Vector2 scale, Color4 color, u32 texture_index, const TextureUVRect& uv_rect = {});
 
     // Returns an empty optional if no texture slot is available.
     Optional<u32> find_quad_texture_slot_index(const RefPtr<Texture2D>& texture);
@@ -82,7 +97,7 @@ private:
     RefPtr<Shader> m_quad_shader;
     RefPtr<Pipeline> m_quad_pipeline;
     RefPtr<RenderPass> m_quad_render_pass;
-    RefPtr<VertexBuffer> m_quad_vertex_buffer;
+    RenderPassBindingSlot m_quad_textures_binding_slot { invalid_render_pass_binding_slot };
     RefPtr<IndexBuffer> m_quad_index_buffer;
 
     u32 m_max_quads_per_batch { 0 };
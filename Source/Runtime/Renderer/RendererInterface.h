@@ -34,7 +34,7 @@ public:
     virtual void begin_render_pass(RefPtr<RenderPass> render_pass) = 0;
     virtual void end_render_pass() = 0;
 
-    virtual void draw_indexed(RefPtr<VertexBuffer> vertex_buffer, RefPtr<IndexBuffer> index_buffer, u32 index_count) = 0;
+    virtual void draw_indexed(RefPtr<VertexBuffer> vertex_buffer, RefPtr<IndexBuffer> index_buffer, u32 index_count, u32 vertex_buffer_byte_offset) = 0;
 };
 
 } // namespace SE
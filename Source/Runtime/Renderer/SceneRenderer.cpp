@@ -6,6 +6,7 @@
 #include <Asset/AssetManager.h>
 #include <Asset/TextureAsset.h>
 #include <Core/Log.h>
+#include <Core/Math/MatrixTransformations.h>
 #include <Engine/Scene/Components/SpriteRendererComponent.h>
 #include <Engine/Scene/Components/TransformComponent.h>
 #include <Renderer/Renderer.h>
@@ -14,6 +15,78 @@
 namespace SE
 {
 
+//
+// Calculates the bounds of the region of the XY plane (where all sprites are rendered) that is visible through
+// the camera described by the given view projection matrix. The visible region is the intersection between the
+// camera frustum and the plane, which is the convex polygon formed by the points where the frustum edges cross it.
+// Returns an empty optional if the frustum doesn't intersect the plane at all.
+//
+static Optional<SpatialBounds> calculate_visible_sprite_bounds(const Matrix4& view_projection_matrix)
+{
+    const Matrix4 inverse_view_projection_matrix = Matrix4::inverse(view_projection_matrix);
+
+    // The corners of the view volume, in normalized device coordinates. The corner index bits encode
+    // the position along the X (bit 0), Y (bit 1) and Z (bit 2) axes.
+    Vector3 frustum_corners[8];
+    for (u32 corner_index = 0; corner_index < SE_ARRAY_COUNT(frustum_corners); ++corner_index)
+    {
+        const float x = (corner_index & 1) ? 1.0F : -1.0F;
+        const float y = (corner_index & 2) ? 1.0F : -1.0F;
+        const float z = (corner_index & 4) ? 1.0F : 0.0F;
+
+        const Vector4 world_corner = Vector4(x, y, z, 1.0F) * inverse_view_projection_matrix;
+        frustum_corners[corner_index] = Vector3(world_corner.x / world_corner.w, world_corner.y / world_corner.w, world_corner.z / world_corner.w);
+    }
+
+    SpatialBounds bounds;
+    bool has_intersection = false;
+
+    const auto add_point = [&](float x, float y)
+    {
+        if (!has_intersection)
+        {
+            bounds.min = Vector2(x, y);
+            bounds.max = Vector2(x, y);
+            has_intersection = true;
+            return;
+        }
+
+        bounds.min = Vector2(Math::min(bounds.min.x, x), Math::min(bounds.min.y, y));
+        bounds.max = Vector2(Math::max(bounds.max.x, x), Math::max(bounds.max.y, y));
+    };
+
+    // Each of the 12 edges of the frustum connects two corners whose indices differ by exactly one bit.
+    for (u32 corner_index = 0; corner_index < SE_ARRAY_COUNT(frustum_corners); ++corner_index)
+    {
+        for (u32 axis_bit = 1; axis_bit <= 4; axis_bit <<= 1)
+        {
+            if (corner_index & axis_bit)
+                continue;
+
+            const Vector3 a = frustum_corners[corner_index];
+            const Vector3 b = frustum_corners[corner_index | axis_bit];
+
+            if (a.z == 0.0F && b.z == 0.0F)
+            {
+                // The edge lies in the plane.
+                add_point(a.x, a.y);
+                add_point(b.x, b.y);
+                continue;
+            }
+
+            if ((a.z > 0.0F && b.z > 0.0F) || (a.z < 0.0F && b.z < 0.0F))
+                continue;
+
+            const float t = a.z / (a.z - b.z);
+            add_point(a.x + t * (b.x - a.x), a.y + t * (b.y - a.y));
+        }
+    }
+
+    if (!has_intersection)
+        return {};
+    return bounds;
+}
+
 bool SceneRenderer::initialize(Scene& in_scene_context, RefPtr<Framebuffer> target_framebuffer)
 {
     SE_ASSERT(m_scene_context == nullptr);
@@ -49,28 +122,45 @@ void SceneRenderer::on_resize(u32 new_width, u32 new_height)
 
 bool SceneRenderer::render(const Matrix4& view_projection_matrix)
 {
-    Renderer::begin_frame();
+    // NOTE: The scene is rendered as part of the frame that is started by the application, so the frame
+    //       boundaries (and presenting) are not managed by the scene renderer.
     m_renderer_2d->begin_frame(view_projection_matrix);
 
-    m_scene_context->for_each_entity(
-        [&](const Entity* entity, UUID)
-        {
-            if (!entity->has_component<TransformComponent>() || !entity->has_component<SpriteRendererComponent>())
+    // Only the sprites that intersect the visible region are submitted to the 2D renderer.
+    const Optional<SpatialBounds> visible_bounds = calculate_visible_sprite_bounds(view_projection_matrix);
+    if (visible_bounds.has_value())
+    {
+        m_scene_context->for_each_sprite_entity_in_bounds(
+            visible_bounds.value(),
+            [&](const Entity* entity, UUID)
+            {
+                const TransformComponent& tc = entity->get_component<TransformComponent>();
+                const SpriteRendererComponent& src = entity->get_component<SpriteRendererComponent>();
+
+                const Vector3 t = tc.translation();
+                const Vector3 s = tc.scale();
+
+                // NOTE: The texture might be packed in an atlas page, so it is always sampled through the UV rectangle of the asset.
+                //       The textures referenced by the scene are preloaded when it is opened, so this doesn't load them.
+                if (src.texture_handle().is_valid())
+                {
+                    const RefPtr<TextureAsset> texture_asset = g_asset_manager->get_asset_sync<TextureAsset>(src.texture_handle());
+                    if (texture_asset.is_valid())
+                    {
+                        m_renderer_2d->submit_quad(
+                            { t.x, t.y }, { s.x, s.y }, texture_asset->get_renderer_texture(), texture_asset->get_uv_rect(), src.sprite_color()
+                        );
+                        return IterationDecision::Continue;
+                    }
+                }
+
+                m_renderer_2d->submit_quad({ t.x, t.y }, { s.x, s.y }, src.sprite_color());
                 return IterationDecision::Continue;
-
-            const TransformComponent& tc = entity->get_component<TransformComponent>();
-            const SpriteRendererComponent& src = entity->get_component<SpriteRendererComponent>();
-
-            const Vector3 t = tc.translation();
-            const Vector3 s = tc.scale();
-
-            m_renderer_2d->submit_quad({ t.x, t.y }, { s.x, s.y }, src.sprite_color());
-            return IterationDecision::Continue;
-        }
-    );
+            }
+        );
+    }
 
     m_renderer_2d->end_frame();
-    Renderer::end_frame();
     return true;
 }
 
@@ -7,16 +7,31 @@
 
 #include <Core/Containers/RefPtr.h>
 #include <Core/Containers/Span.h>
+#include <Core/Math/Vector.h>
 #include <Renderer/Image.h>
 
 namespace SE
 {
 
+//
+// Rectangle, in normalized texture coordinates, of the region of a texture that is sampled. Used to reference
+// images that are packed inside a larger texture, such as the pages of a texture atlas.
+//
+struct TextureUVRect
+{
+    Vector2 min { 0, 0 };
+    Vector2 max { 1, 1 };
+};
+
 struct Texture2DDescription
 {
     u32 width { 0 };
     u32 height { 0 };
     ImageFormat format { ImageFormat::Unknown };
+    // The number of mip levels of the texture. The block compressed textures must have the dimensions of the first mip
+    // level multiples of 4, as required by the graphics APIs.
+    u32 mip_count { 1 };
+    // The pixels of all the mip levels, tightly packed one after the other, starting with the largest one.
     ReadonlyByteSpan data;
 
     ImageFilteringMode min_filter { ImageFilteringMode::Linear };
@@ -38,6 +53,13 @@ public:
     NODISCARD virtual u32 get_width() const = 0;
     NODISCARD virtual u32 get_height() const = 0;
     NODISCARD virtual ImageFormat get_format() const = 0;
+
+    //
+    // Replaces the pixels of the given region of the first mip level of the texture. The data must be tightly packed and use
+    // the format of the texture, which can't be block compressed.
+    // NOTE: This records GPU commands, so it must be invoked from a command submitted via `Renderer::submit`.
+    //
+    virtual void update_region(u32 x, u32 y, u32 width, u32 height, ReadonlyByteSpan data) = 0;
 };
 
 } // namespace SE
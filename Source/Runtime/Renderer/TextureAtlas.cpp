@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/Math/MathCore.h>
+#include <Core/Memory/MemoryOperations.h>
+#include <Renderer/Renderer.h>
+#include <Renderer/TextureAtlas.h>
+
+namespace SE
+{
+
+// The atlas pages always use the RGBA8 format.
+static constexpr u32 s_bytes_per_pixel = 4;
+
+TextureAtlas::TextureAtlas(const TextureAtlasDescription& description)
+    : m_description(description)
+{
+    SE_ASSERT(m_description.page_width > 0 && m_description.page_height > 0);
+}
+
+TextureAtlas::~TextureAtlas()
+{
+    clear();
+}
+
+RefPtr<Texture2D> TextureAtlas::get_page_texture(u32 page_index) const
+{
+    SE_ASSERT(m_description.mode == TextureAtlasMode::Dynamic);
+    return m_pages[page_index].texture;
+}
+
+ReadonlyByteSpan TextureAtlas::get_page_pixels(u32 page_index) const
+{
+    SE_ASSERT(m_description.mode == TextureAtlasMode::Offline);
+    return m_pages[page_index].pixels.readonly_byte_span();
+}
+
+float TextureAtlas::get_page_occupancy(u32 page_index) const
+{
+    return m_pages[page_index].packer.get_occupancy();
+}
+
+Optional<TextureAtlasRegion> TextureAtlas::add_image(u32 width, u32 height, ReadonlyByteSpan pixels)
+{
+    // The provided pixels buffer doesn't match the image number of bytes.
+    SE_ASSERT(static_cast<usize>(width) * static_cast<usize>(height) * s_bytes_per_pixel == pixels.count());
+    if (width == 0 || height == 0)
+        return {};
+
+    const u32 padding = m_description.padding;
+    const u32 block_width = width + 2 * padding;
+    const u32 block_height = height + 2 * padding;
+    if (block_width > m_description.page_width || block_height > m_description.page_height)
+        return {};
+
+    // Try to pack the image in the existing pages, starting with the most recent one as it is the least likely to be full.
+    u32 page_index = get_page_count();
+    Optional<PackedRectangle> rectangle;
+    for (u32 candidate_page_index = get_page_count(); candidate_page_index > 0; --candidate_page_index)
+    {
+        rectangle = m_pages[candidate_page_index - 1].packer.pack(block_width, block_height);
+        if (rectangle.has_value())
+        {
+            page_index = candidate_page_index - 1;
+            break;
+        }
+    }
+
+    if (!rectangle.has_value())
+    {
+        create_page();
+        page_index = get_page_count() - 1;
+        rectangle = m_pages[page_index].packer.pack(block_width, block_height);
+        // The block is smaller than the page, so it always fits in an empty page.
+        SE_ASSERT(rectangle.has_value());
+    }
+
+    // Build the padded block. The padding pixels replicate the closest edge pixel of the image.
+    Buffer block_pixels = Buffer::create(static_cast<usize>(block_width) * static_cast<usize>(block_height) * s_bytes_per_pixel);
+    for (u32 block_y = 0; block_y < block_height; ++block_y)
+    {
+        const u32 source_y = Math::clamp(block_y, padding, padding + height - 1) - padding;
+        for (u32 block_x = 0; block_x < block_width; ++block_x)
+        {
+            const u32 source_x = Math::clamp(block_x, padding, padding + width - 1) - padding;
+            const usize source_offset = (static_cast<usize>(source_y) * width + source_x) * s_bytes_per_pixel;
+            const usize block_offset = (static_cast<usize>(block_y) * block_width + block_x) * s_bytes_per_pixel;
+            copy_memory(block_pixels.bytes() + block_offset, pixels.elements() + source_offset, s_bytes_per_pixel);
+        }
+    }
+
+    write_block_to_page(page_index, rectangle.value(), block_pixels.readonly_byte_span());
+
+    // The UV rectangle only covers the image, without the padding.
+    const float page_width = static_cast<float>(m_description.page_width);
+    const float page_height = static_cast<float>(m_description.page_height);
+    TextureAtlasRegion region;
+    region.page_index = page_index;
+    region.uv_rect.min.x = static_cast<float>(rectangle->x + padding) / page_width;
+    region.uv_rect.min.y = static_cast<float>(rectangle->y + padding) / page_height;
+    region.uv_rect.max.x = static_cast<float>(rectangle->x + padding + width) / page_width;
+    region.uv_rect.max.y = static_cast<float>(rectangle->y + padding + height) / page_height;
+    return region;
+}
+
+void TextureAtlas::clear()
+{
+    m_pages.clear_and_shrink();
+}
+
+void TextureAtlas::create_page()
+{
+    Page& page = m_pages.emplace(m_description.page_width, m_description.page_height);
+    const usize page_byte_count = static_cast<usize>(m_description.page_width) * static_cast<usize>(m_description.page_height) * s_bytes_per_pixel;
+
+    switch (m_description.mode)
+    {
+        case TextureAtlasMode::Dynamic:
+        {
+            // NOTE: The texture is created without initial data, as the images are uploaded to it as they are added.
+            //       The regions that are never written contain undefined pixels, but they are never sampled.
+            Texture2DDescription texture_description = {};
+            texture_description.width = m_description.page_width;
+            texture_description.height = m_description.page_height;
+            texture_description.format = ImageFormat::RGBA8;
+            page.texture = Texture2D::create(texture_description);
+            break;
+        }
+
+        case TextureAtlasMode::Offline:
+        {
+            page.pixels = Buffer::create(page_byte_count);
+            zero_memory(page.pixels.data(), page.pixels.byte_count());
+            break;
+        }
+    }
+}
+
+void TextureAtlas::write_block_to_page(u32 page_index, const PackedRectangle& rectangle, ReadonlyByteSpan block_pixels)
+{
+    Page& page = m_pages[page_index];
+
+    switch (m_description.mode)
+    {
+        case TextureAtlasMode::Dynamic:
+        {
+            Renderer::submit(
+                [texture = page.texture, rectangle, block_pixels = Renderer::copy_to_frame_memory(block_pixels)]() mutable
+                { texture->update_region(rectangle.x, rectangle.y, rectangle.width, rectangle.height, block_pixels); }
+            );
+            break;
+        }
+
+        case TextureAtlasMode::Offline:
+        {
+            const usize block_row_byte_count = static_cast<usize>(rectangle.width) * s_bytes_per_pixel;
+            for (u32 block_y = 0; block_y < rectangle.height; ++block_y)
+            {
+                const usize page_offset = (static_cast<usize>(rectangle.y + block_y) * m_description.page_width + rectangle.x) * s_bytes_per_pixel;
+                copy_memory(page.pixels.bytes() + page_offset, block_pixels.elements() + block_y * block_row_byte_count, block_row_byte_count);
+            }
+            break;
+        }
+    }
+}
+
+} // namespace SE
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/Containers/Optional.h>
+#include <Core/Containers/Vector.h>
+#include <Core/Memory/Buffer.h>
+#include <Renderer/RectanglePacker.h>
+#include <Renderer/Texture.h>
+
+namespace SE
+{
+
+enum class TextureAtlasMode : u8
+{
+    // The pages are GPU textures and each added image is uploaded to its page immediately.
+    // Used to pack the small textures at runtime, so that they can be rendered in a single batch.
+    Dynamic,
+    // The pages are only kept in memory, so that they can be written to disk by the texture cooker.
+    Offline,
+};
+
+struct TextureAtlasDescription
+{
+    u32 page_width { 2048 };
+    u32 page_height { 2048 };
+    // The number of pixels that surround each image. The padding is filled with the edge pixels of the image,
+    // so that linear filtering doesn't bleed the neighbouring images into it.
+    u32 padding { 1 };
+    TextureAtlasMode mode { TextureAtlasMode::Dynamic };
+};
+
+//
+// The location of an image inside a texture atlas.
+//
+struct TextureAtlasRegion
+{
+    u32 page_index { 0 };
+    TextureUVRect uv_rect;
+};
+
+//
+// Packs RGBA8 images into one or more fixed size pages. A new page is created whenever an image doesn't fit
+// in any of the existing pages. Images are never removed from the atlas, as the atlas is meant to be rebuilt
+// from scratch when its contents change significantly.
+//
+class TextureAtlas
+{
+    SE_MAKE_NONCOPYABLE(TextureAtlas);
+    SE_MAKE_NONMOVABLE(TextureAtlas);
+
+public:
+    SHOOTER_API explicit TextureAtlas(const TextureAtlasDescription& description);
+    SHOOTER_API ~TextureAtlas();
+
+    NODISCARD ALWAYS_INLINE const TextureAtlasDescription& get_description() const { return m_description; }
+    NODISCARD ALWAYS_INLINE u32 get_page_count() const { return static_cast<u32>(m_pages.count()); }
+
+    // Only available when the atlas is in dynamic mode.
+    NODISCARD SHOOTER_API RefPtr<Texture2D> get_page_texture(u32 page_index) const;
+
+    // Only available when the atlas is in offline mode. The pixels are RGBA8, tightly packed.
+    NODISCARD SHOOTER_API ReadonlyByteSpan get_page_pixels(u32 page_index) const;
+
+    // Returns the fraction of the page area that is covered by images (including their padding).
+    NODISCARD SHOOTER_API float get_page_occupancy(u32 page_index) const;
+
+public:
+    //
+    // Adds an RGBA8 image to the atlas. The pixels must be tightly packed and use the same row order as the data
+    // that is passed to `Texture2D::create`, so the returned UV rectangle can be used exactly like the full [0, 1] range.
+    // Returns an empty optional if the image (including its padding) is larger than a page.
+    //
+    NODISCARD SHOOTER_API Optional<TextureAtlasRegion> add_image(u32 width, u32 height, ReadonlyByteSpan pixels);
+
+    SHOOTER_API void clear();
+
+private:
+    struct Page
+    {
+        SkylineRectanglePacker packer;
+        RefPtr<Texture2D> texture;
+        Buffer pixels;
+
+        Page(u32 width, u32 height)
+            : packer(width, height)
+        {}
+    };
+
+private:
+    void create_page();
+
+    // Writes the padded block to the given page, either by uploading it to the page texture or by copying it
+    // into the page pixels, depending on the mode of the atlas.
+    void write_block_to_page(u32 page_index, const PackedRectangle& rectangle, ReadonlyByteSpan block_pixels);
+
+private:
+    TextureAtlasDescription m_description;
+    Vector<Page> m_pages;
+};
+
+} // namespace SE
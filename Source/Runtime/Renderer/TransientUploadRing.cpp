@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/Assertions.h>
+#include <Renderer/TransientUploadRing.h>
+
+namespace SE
+{
+
+TransientUploadRing::TransientUploadRing(u32 buffer_byte_count, u32 buffer_count)
+    : m_buffer_byte_count(buffer_byte_count)
+    , m_buffer_count(buffer_count)
+    , m_current_buffer_index(0)
+    , m_current_byte_offset(0)
+    , m_wrap_count(0)
+    , m_is_current_buffer_untouched(true)
+{
+    SE_ASSERT(m_buffer_byte_count > 0);
+    SE_ASSERT(m_buffer_count > 0);
+}
+
+void TransientUploadRing::begin_frame()
+{
+    m_current_buffer_index = (m_current_buffer_index + 1) % m_buffer_count;
+    m_current_byte_offset = 0;
+    m_wrap_count = 0;
+    m_is_current_buffer_untouched = true;
+}
+
+Optional<TransientUploadAllocation> TransientUploadRing::allocate(u32 byte_count, u32 alignment /*= default_alignment*/)
+{
+    // The alignment must be a power of two.
+    SE_ASSERT(alignment > 0 && (alignment & (alignment - 1)) == 0);
+
+    if (byte_count == 0 || byte_count > m_buffer_byte_count)
+        return {};
+
+    // NOTE: The offsets are computed using 64-bit integers, so aligning an offset close to the end of the buffer can't overflow.
+    const u64 aligned_byte_offset = (static_cast<u64>(m_current_byte_offset) + alignment - 1) & ~(static_cast<u64>(alignment) - 1);
+
+    TransientUploadAllocation allocation;
+    allocation.buffer_index = m_current_buffer_index;
+    allocation.byte_count = byte_count;
+    allocation.discard_previous_contents = m_is_current_buffer_untouched;
+
+    if (aligned_byte_offset + byte_count > m_buffer_byte_count)
+    {
+        // The buffer is full, so wrap around. Discarding the contents makes the driver provide a fresh memory block,
+        // so the data that was already written (and is referenced by the draw calls of this frame) is not overwritten.
+        allocation.byte_offset = 0;
+        allocation.discard_previous_contents = true;
+        ++m_wrap_count;
+    }
+    else
+    {
+        allocation.byte_offset = static_cast<u32>(aligned_byte_offset);
+    }
+
+    m_current_byte_offset = allocation.byte_offset + byte_count;
+    m_is_current_buffer_untouched = false;
+    return allocation;
+}
+
+} // namespace SE
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/API.h>
+#include <Core/Containers/Optional.h>
+#include <Core/CoreTypes.h>
+
+namespace SE
+{
+
+struct TransientUploadAllocation
+{
+    // The index of the buffer (one for each frame in flight) that contains the allocation.
+    u32 buffer_index { 0 };
+    u32 byte_offset { 0 };
+    u32 byte_count { 0 };
+
+    // When true, the previous contents of the buffer must be discarded before writing the allocation (the buffer is
+    // written for the first time in the current frame, or the allocation wrapped around). Otherwise, the allocation
+    // can be written without synchronization, as it doesn't overlap any data that the GPU might still be reading.
+    bool discard_previous_contents { false };
+};
+
+//
+// Backend-agnostic allocation logic of the transient upload ring.
+//
+// Dynamic data (such as the vertices of a batch) is written to one large buffer per frame in flight. Inside a frame,
+// allocations are sub-allocated linearly, so the backend can map the buffer without discarding its contents (for example,
+// using `D3D11_MAP_WRITE_NO_OVERWRITE`) and each draw call references its data by offset. Only the first allocation of
+// a frame, and the allocation that wraps around when the buffer is full, discard the previous contents.
+//
+// This class doesn't own any GPU resources, it only computes the offsets.
+//
+class TransientUploadRing
+{
+public:
+    static constexpr u32 default_alignment = 16;
+
+public:
+    SHOOTER_API TransientUploadRing(u32 buffer_byte_count, u32 buffer_count);
+
+    NODISCARD ALWAYS_INLINE u32 get_buffer_byte_count() const { return m_buffer_byte_count; }
+    NODISCARD ALWAYS_INLINE u32 get_buffer_count() const { return m_buffer_count; }
+    NODISCARD ALWAYS_INLINE u32 get_current_buffer_index() const { return m_current_buffer_index; }
+
+    // Returns the number of times the current buffer wrapped around during the current frame.
+    NODISCARD ALWAYS_INLINE u32 get_wrap_count() const { return m_wrap_count; }
+
+public:
+    // Moves to the buffer of the next frame in flight. Must be called once at the beginning of each frame.
+    SHOOTER_API void begin_frame();
+
+    //
+    // Allocates a block of the given size from the buffer of the current frame. Returns an empty optional if the
+    // requested size is larger than the capacity of a buffer. The alignment must be a power of two.
+    //
+    NODISCARD SHOOTER_API Optional<TransientUploadAllocation> allocate(u32 byte_count, u32 alignment = default_alignment);
+
+private:
+    u32 m_buffer_byte_count;
+    u32 m_buffer_count;
+
+    u32 m_current_buffer_index;
+    u32 m_current_byte_offset;
+    u32 m_wrap_count;
+    // True if nothing has been allocated from the current buffer since the frame began.
+    bool m_is_current_buffer_untouched;
+};
+
+} // namespace SE
@@ -35,6 +35,13 @@ public:
 
 public:
     virtual void update_data(ReadonlyByteSpan data) = 0;
+
+    //
+    // Writes the data at the given offset in the buffer. Only available for buffers created with `VertexBufferUpdateFrequency::High`.
+    // If `discard_previous_contents` is false the caller guarantees that the written range is not used by any pending draw call,
+    // so the buffer is written without waiting for the GPU and without the driver allocating a new memory block.
+    //
+    virtual void write_data(u32 byte_offset, ReadonlyByteSpan data, bool discard_previous_contents) = 0;
 };
 
 } // namespace SE
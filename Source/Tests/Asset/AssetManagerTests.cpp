@@ -0,0 +1,231 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Asset/AssetManager.h>
+#include <Core/Containers/HashMap.h>
+#include <Engine/Scene/Components/SpriteRendererComponent.h>
+#include <Engine/Scene/Reflection/ComponentReflectorRegistry.h>
+#include <Engine/Scene/Scene.h>
+#include <TestFramework.h>
+
+namespace SE
+{
+
+//
+// Asset manager whose assets are only metadata. It records the batches that `preload` loads, and the dependencies of
+// an asset can be either known before it is loaded or only discovered by loading it (as if read from its file).
+//
+class TestAssetManager final : public AssetManager
+{
+public:
+    virtual bool initialize() override { return true; }
+
+    virtual RefPtr<Asset> get_asset_sync(AssetHandle handle) override
+    {
+        AssetMetadata& metadata = get_asset_metadata(handle);
+        if (metadata.type == AssetType::Unknown)
+            return {};
+
+        ++load_count;
+        metadata.state = AssetState::Ready;
+        Optional<Vector<AssetHandle>&> discovered_dependencies = m_discovered_dependencies.get_if_exists(handle);
+        if (discovered_dependencies.has_value())
+            metadata.dependencies = discovered_dependencies.value();
+        return {};
+    }
+
+    virtual AssetMetadata& get_asset_metadata(AssetHandle handle) override
+    {
+        Optional<AssetMetadata&> metadata = m_metadata.get_if_exists(handle);
+        if (!metadata.has_value())
+        {
+            m_empty_metadata = {};
+            return m_empty_metadata;
+        }
+        return metadata.value();
+    }
+
+    AssetHandle register_asset(u64 uuid_value, Span<const AssetHandle> known_dependencies = {}, Span<const AssetHandle> discovered_dependencies = {})
+    {
+        const AssetHandle handle = AssetHandle(UUID(uuid_value));
+        AssetMetadata metadata;
+        metadata.type = AssetType::Texture;
+        metadata.state = AssetState::Unloaded;
+        metadata.handle = handle;
+        for (const AssetHandle dependency_handle : known_dependencies)
+            metadata.dependencies.add(dependency_handle);
+        m_metadata.add(handle, move(metadata));
+
+        if (discovered_dependencies.count() > 0)
+        {
+            Vector<AssetHandle> discovered_dependency_handles;
+            for (const AssetHandle dependency_handle : discovered_dependencies)
+                discovered_dependency_handles.add(dependency_handle);
+            m_discovered_dependencies.add(handle, move(discovered_dependency_handles));
+        }
+        return handle;
+    }
+
+    NODISCARD bool is_ready(AssetHandle handle) { return get_asset_metadata(handle).state == AssetState::Ready; }
+
+    NODISCARD bool batch_contains(usize batch_index, AssetHandle handle) const
+    {
+        for (const AssetHandle batch_handle : batches[batch_index])
+        {
+            if (batch_handle == handle)
+                return true;
+        }
+        return false;
+    }
+
+public:
+    Vector<Vector<AssetHandle>> batches;
+    u32 load_count { 0 };
+
+protected:
+    virtual void load_assets(Span<const AssetHandle> handles) override
+    {
+        Vector<AssetHandle>& batch = batches.emplace();
+        for (const AssetHandle handle : handles)
+            batch.add(handle);
+        AssetManager::load_assets(handles);
+    }
+
+private:
+    HashMap<AssetHandle, AssetMetadata> m_metadata;
+    HashMap<AssetHandle, Vector<AssetHandle>> m_discovered_dependencies;
+    AssetMetadata m_empty_metadata;
+};
+
+SE_TEST(asset_manager_preloads_the_dependency_closure_as_one_batch)
+{
+    TestAssetManager asset_manager;
+    const AssetHandle leaf_handle = asset_manager.register_asset(1);
+    const AssetHandle shared_handle = asset_manager.register_asset(2, { &leaf_handle, 1 });
+    const AssetHandle dependencies[] = { shared_handle, leaf_handle };
+    const AssetHandle root_handle = asset_manager.register_asset(3, { dependencies, SE_ARRAY_COUNT(dependencies) });
+
+    // The shared asset is both a root and a (direct) dependency, and the leaf is referenced by two assets.
+    const AssetHandle preload_handles[] = { root_handle, shared_handle, AssetHandle::invalid(), AssetHandle(UUID(1000)) };
+    asset_manager.preload({ preload_handles, SE_ARRAY_COUNT(preload_handles) }, AssetLoadPriority::Immediate);
+
+    if (!SE_TEST_CHECK(asset_manager.batches.count() == 1))
+        return;
+    SE_TEST_CHECK(asset_manager.batches[0].count() == 3);
+    SE_TEST_CHECK(asset_manager.batch_contains(0, root_handle));
+    SE_TEST_CHECK(asset_manager.batch_contains(0, shared_handle));
+    SE_TEST_CHECK(asset_manager.batch_contains(0, leaf_handle));
+    SE_TEST_CHECK(asset_manager.load_count == 3);
+}
+
+SE_TEST(asset_manager_preloads_dependencies_discovered_by_loading)
+{
+    TestAssetManager asset_manager;
+    const AssetHandle second_level_handle = asset_manager.register_asset(1);
+    const AssetHandle first_level_handle = asset_manager.register_asset(2, {}, { &second_level_handle, 1 });
+    const AssetHandle root_handle = asset_manager.register_asset(3, {}, { &first_level_handle, 1 });
+
+    asset_manager.preload({ &root_handle, 1 }, AssetLoadPriority::Immediate);
+
+    // Each level of dependencies is only known once the previous one is loaded, so it is loaded by its own batch.
+    if (!SE_TEST_CHECK(asset_manager.batches.count() == 3))
+        return;
+    SE_TEST_CHECK(asset_manager.batch_contains(0, root_handle));
+    SE_TEST_CHECK(asset_manager.batch_contains(1, first_level_handle));
+    SE_TEST_CHECK(asset_manager.batch_contains(2, second_level_handle));
+    SE_TEST_CHECK(asset_manager.is_ready(second_level_handle));
+}
+
+SE_TEST(asset_manager_preloads_dependency_cycles_once)
+{
+    TestAssetManager asset_manager;
+    const AssetHandle first_handle = AssetHandle(UUID(1));
+    const AssetHandle second_handle = AssetHandle(UUID(2));
+    // One edge of the cycle is known before loading and the other one is discovered by loading.
+    asset_manager.register_asset(1, { &second_handle, 1 });
+    asset_manager.register_asset(2, {}, { &first_handle, 1 });
+    const AssetHandle self_handle = AssetHandle(UUID(3));
+    asset_manager.register_asset(3, { &self_handle, 1 }, { &self_handle, 1 });
+
+    const AssetHandle preload_handles[] = { first_handle, self_handle };
+    asset_manager.preload({ preload_handles, SE_ARRAY_COUNT(preload_handles) }, AssetLoadPriority::Immediate);
+
+    SE_TEST_CHECK(asset_manager.batches.count() == 1);
+    SE_TEST_CHECK(asset_manager.load_count == 3);
+}
+
+SE_TEST(asset_manager_preload_follows_the_dependencies_of_ready_assets)
+{
+    TestAssetManager asset_manager;
+    const AssetHandle dependency_handle = asset_manager.register_asset(1);
+    const AssetHandle root_handle = asset_manager.register_asset(2, { &dependency_handle, 1 });
+    asset_manager.get_asset_metadata(root_handle).state = AssetState::Ready;
+
+    // The ready asset isn't loaded again, but its unloaded dependency is.
+    asset_manager.preload({ &root_handle, 1 }, AssetLoadPriority::Immediate);
+    if (!SE_TEST_CHECK(asset_manager.batches.count() == 1))
+        return;
+    SE_TEST_CHECK(asset_manager.batches[0].count() == 1);
+    SE_TEST_CHECK(asset_manager.batch_contains(0, dependency_handle));
+
+    // Once everything is loaded, preloading again doesn't load anything.
+    asset_manager.preload({ &root_handle, 1 }, AssetLoadPriority::Immediate);
+    SE_TEST_CHECK(asset_manager.batches.count() == 1);
+    SE_TEST_CHECK(asset_manager.load_count == 1);
+}
+
+SE_TEST(asset_manager_background_preload_is_loaded_by_update)
+{
+    TestAssetManager asset_manager;
+    Vector<AssetHandle> handles;
+    for (u64 uuid_value = 1; uuid_value <= AssetManager::background_preload_batch_count + 4; ++uuid_value)
+        handles.add(asset_manager.register_asset(uuid_value));
+
+    asset_manager.preload({ handles.elements(), handles.count() }, AssetLoadPriority::Background);
+    SE_TEST_CHECK(asset_manager.batches.is_empty());
+
+    asset_manager.update();
+    if (!SE_TEST_CHECK(asset_manager.batches.count() == 1))
+        return;
+    SE_TEST_CHECK(asset_manager.batches[0].count() == AssetManager::background_preload_batch_count);
+    SE_TEST_CHECK(!asset_manager.is_ready(handles.last()));
+
+    asset_manager.update();
+    asset_manager.update();
+    if (!SE_TEST_CHECK(asset_manager.batches.count() == 2))
+        return;
+    SE_TEST_CHECK(asset_manager.batches[1].count() == 4);
+    SE_TEST_CHECK(asset_manager.is_ready(handles.last()));
+}
+
+SE_TEST(component_reflector_registry_collects_the_sprite_textures_of_a_scene)
+{
+    ComponentReflectorRegistry component_reflector_registry;
+    component_reflector_registry.initialize();
+
+    OwnPtr<Scene> scene = Scene::create();
+    const AssetHandle first_texture_handle = AssetHandle(UUID(0x1000));
+    const AssetHandle second_texture_handle = AssetHandle(UUID(0x2000));
+    const AssetHandle texture_handles[] = { first_texture_handle, second_texture_handle, first_texture_handle, AssetHandle::invalid() };
+    for (const AssetHandle texture_handle : texture_handles)
+    {
+        Entity* entity = scene->create_entity();
+        entity->add_component<SpriteRendererComponent>(Color4(1, 1, 1, 1)).set_texture_handle(texture_handle);
+    }
+
+    // Each texture is collected once, and the sprite without a texture doesn't reference any asset.
+    Vector<AssetHandle> asset_handles;
+    component_reflector_registry.collect_asset_references(*scene, asset_handles);
+    if (SE_TEST_CHECK(asset_handles.count() == 2))
+    {
+        SE_TEST_CHECK(asset_handles[0] == first_texture_handle || asset_handles[1] == first_texture_handle);
+        SE_TEST_CHECK(asset_handles[0] == second_texture_handle || asset_handles[1] == second_texture_handle);
+    }
+
+    scene.release();
+    component_reflector_registry.shutdown();
+}
+
+} // namespace SE
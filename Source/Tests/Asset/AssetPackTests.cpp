@@ -0,0 +1,325 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Asset/AssetPack.h>
+#include <Core/Containers/Vector.h>
+#include <Core/Memory/Compression.h>
+#include <Core/Memory/MemoryOperations.h>
+#include <Core/String/Format.h>
+#include <TestFramework.h>
+#include <cstring>
+
+namespace SE
+{
+
+struct TestAssetPackEntry
+{
+    u64 handle;
+    StringView name;
+    Vector<ReadWriteByte> bytes;
+    AssetPackCompression compression;
+};
+
+NODISCARD static u64 align_test_asset_pack_offset(u64 offset)
+{
+    return (offset + asset_pack_entry_alignment - 1) & ~(asset_pack_entry_alignment - 1);
+}
+
+//
+// Creates an asset pack with the same layout as the packs written by `AssetPackBuilder`: the header, the table of contents,
+// the string table and the (aligned) data of each entry. The entries are written in the given order, so they must be
+// sorted by their handle for the pack to be valid.
+//
+NODISCARD static Vector<ReadWriteByte> create_test_asset_pack(const Vector<TestAssetPackEntry>& entries)
+{
+    AssetPackHeader header = {};
+    header.magic = asset_pack_magic;
+    header.version = asset_pack_version;
+    header.entry_count = static_cast<u32>(entries.count());
+    header.toc_offset = sizeof(AssetPackHeader);
+    header.string_table_offset = header.toc_offset + entries.count() * sizeof(AssetPackEntry);
+
+    Vector<AssetPackEntry> toc_entries;
+    Vector<Vector<ReadWriteByte>> stored_data;
+    for (const TestAssetPackEntry& entry : entries)
+    {
+        AssetPackEntry& toc_entry = toc_entries.emplace();
+        zero_memory(&toc_entry, sizeof(AssetPackEntry));
+        toc_entry.handle = entry.handle;
+        toc_entry.type = AssetType::Texture;
+        toc_entry.compression = entry.compression;
+        toc_entry.name_offset = static_cast<u32>(header.string_table_byte_count);
+        toc_entry.name_byte_count = static_cast<u32>(entry.name.byte_count());
+        toc_entry.byte_count = entry.bytes.count();
+        header.string_table_byte_count += entry.name.byte_count();
+
+        Vector<ReadWriteByte>& entry_stored_data = stored_data.emplace(entry.bytes);
+        if (entry.compression == AssetPackCompression::LZ4)
+        {
+            entry_stored_data = Vector<ReadWriteByte>::create_filled(get_lz4_max_compressed_byte_count(entry.bytes.count()), 0);
+            const usize compressed_byte_count = compress_lz4(
+                ReadonlyByteSpan(entry.bytes.elements(), entry.bytes.count()),
+                WriteonlyByteSpan(entry_stored_data.elements(), entry_stored_data.count())
+            );
+            entry_stored_data.remove_last(entry_stored_data.count() - compressed_byte_count);
+        }
+        toc_entry.stored_byte_count = entry_stored_data.count();
+    }
+
+    u64 data_offset = align_test_asset_pack_offset(header.string_table_offset + header.string_table_byte_count);
+    for (AssetPackEntry& toc_entry : toc_entries)
+    {
+        toc_entry.data_offset = data_offset;
+        data_offset = align_test_asset_pack_offset(data_offset + toc_entry.stored_byte_count);
+    }
+
+    Vector<ReadWriteByte> pack_bytes = Vector<ReadWriteByte>::create_filled(header.string_table_offset, 0);
+    copy_memory(pack_bytes.elements(), &header, sizeof(AssetPackHeader));
+    copy_memory(pack_bytes.elements() + header.toc_offset, toc_entries.elements(), toc_entries.count() * sizeof(AssetPackEntry));
+    for (const TestAssetPackEntry& entry : entries)
+        pack_bytes.add_span(Span<const ReadWriteByte>(reinterpret_cast<ReadonlyBytes>(entry.name.characters()), entry.name.byte_count()));
+
+    for (usize entry_index = 0; entry_index < toc_entries.count(); ++entry_index)
+    {
+        while (pack_bytes.count() < toc_entries[entry_index].data_offset)
+            pack_bytes.add(0);
+        pack_bytes.add_span(Span<const ReadWriteByte>(stored_data[entry_index].elements(), stored_data[entry_index].count()));
+    }
+    return pack_bytes;
+}
+
+NODISCARD static bool write_test_file(const String& filepath, const Vector<ReadWriteByte>& bytes)
+{
+    FileWriter file_writer;
+    if (file_writer.open(filepath) != FileError::Success)
+        return false;
+    return (file_writer.write_and_close(ReadonlyByteSpan(bytes.elements(), bytes.count())) == FileError::Success);
+}
+
+NODISCARD static Vector<ReadWriteByte> create_test_asset_bytes(usize byte_count, u64 seed)
+{
+    // Few distinct values, so that the data can be compressed.
+    TestRandomGenerator random_generator = { seed };
+    Vector<ReadWriteByte> bytes = Vector<ReadWriteByte>::create_filled(byte_count, 0);
+    for (ReadWriteByte& byte : bytes)
+        byte = static_cast<ReadWriteByte>(random_generator.next() % 16);
+    return bytes;
+}
+
+NODISCARD static Vector<TestAssetPackEntry> create_test_asset_pack_entries()
+{
+    Vector<TestAssetPackEntry> entries;
+    entries.add({ 10, "Textures/Wall.setex"sv, create_test_asset_bytes(5000, 1), AssetPackCompression::None });
+    entries.add({ 20, "Textures/Floor.setex"sv, create_test_asset_bytes(20000, 2), AssetPackCompression::LZ4 });
+    entries.add({ 30, "Textures/Empty.setex"sv, {}, AssetPackCompression::None });
+    return entries;
+}
+
+SE_TEST(asset_pack_opens_and_reads_entries)
+{
+    const String pack_filepath = "SE-Tests-AssetPack.sepak"sv;
+    const Vector<TestAssetPackEntry> entries = create_test_asset_pack_entries();
+    if (!SE_TEST_CHECK(write_test_file(pack_filepath, create_test_asset_pack(entries))))
+        return;
+
+    AssetPack pack;
+    if (SE_TEST_CHECK(pack.open(pack_filepath)))
+    {
+        SE_TEST_CHECK(pack.get_entry_count() == entries.count());
+        SE_TEST_CHECK(pack.find_entry(AssetHandle(UUID(15))) == nullptr);
+        SE_TEST_CHECK(pack.find_entry(AssetHandle(UUID(40))) == nullptr);
+
+        Buffer decompression_buffer;
+        for (const TestAssetPackEntry& entry : entries)
+        {
+            const AssetPackEntry* pack_entry = pack.find_entry(AssetHandle(UUID(entry.handle)));
+            if (!SE_TEST_CHECK(pack_entry != nullptr))
+                continue;
+            SE_TEST_CHECK(pack_entry->data_offset % asset_pack_entry_alignment == 0);
+            SE_TEST_CHECK(pack.get_entry_name(*pack_entry) == entry.name);
+
+            ReadonlyByteSpan entry_bytes;
+            if (SE_TEST_CHECK(pack.read_entry(*pack_entry, decompression_buffer, entry_bytes)))
+            {
+                SE_TEST_CHECK(entry_bytes.count() == entry.bytes.count());
+                SE_TEST_CHECK(entry.bytes.is_empty() || std::memcmp(entry_bytes.elements(), entry.bytes.elements(), entry.bytes.count()) == 0);
+            }
+        }
+        pack.close();
+    }
+
+    FileSystem::delete_file(pack_filepath);
+}
+
+SE_TEST(asset_pack_rejects_invalid_table_of_contents)
+{
+    const String pack_filepath = "SE-Tests-AssetPack.sepak"sv;
+    const Vector<ReadWriteByte> valid_pack_bytes = create_test_asset_pack(create_test_asset_pack_entries());
+    AssetPackHeader valid_header;
+    copy_memory(&valid_header, valid_pack_bytes.elements(), sizeof(AssetPackHeader));
+
+    // Writes the pack after applying the given modification and checks that opening it fails.
+    const auto check_rejected = [&](auto modify_function) -> bool
+    {
+        Vector<ReadWriteByte> pack_bytes = valid_pack_bytes;
+        AssetPackHeader& header = *reinterpret_cast<AssetPackHeader*>(pack_bytes.elements());
+        AssetPackEntry* entries = reinterpret_cast<AssetPackEntry*>(pack_bytes.elements() + valid_header.toc_offset);
+        modify_function(pack_bytes, header, entries);
+
+        AssetPack pack;
+        if (!write_test_file(pack_filepath, pack_bytes))
+            return false;
+        const bool is_opened = pack.open(pack_filepath);
+        return !is_opened && pack.get_entry_count() == 0;
+    };
+
+    // The file is smaller than the header.
+    SE_TEST_CHECK(check_rejected([](Vector<ReadWriteByte>& bytes, AssetPackHeader&, AssetPackEntry*)
+                                 { bytes.remove_last(bytes.count() - sizeof(AssetPackHeader) + 1); }));
+    SE_TEST_CHECK(check_rejected([](Vector<ReadWriteByte>&, AssetPackHeader& header, AssetPackEntry*) { header.magic = 0x4B505346; }));
+    SE_TEST_CHECK(check_rejected([](Vector<ReadWriteByte>&, AssetPackHeader& header, AssetPackEntry*) { header.version = asset_pack_version + 1; }));
+
+    // The table of contents is misaligned, starts past the end of the file or doesn't fit in the file.
+    SE_TEST_CHECK(check_rejected([](Vector<ReadWriteByte>&, AssetPackHeader& header, AssetPackEntry*) { header.toc_offset += 4; }));
+    SE_TEST_CHECK(check_rejected([](Vector<ReadWriteByte>& bytes, AssetPackHeader& header, AssetPackEntry*) { header.toc_offset = bytes.count() + 8; }));
+    SE_TEST_CHECK(check_rejected([](Vector<ReadWriteByte>&, AssetPackHeader& header, AssetPackEntry*) { header.entry_count = 0xFFFFFFFF; }));
+
+    // The string table doesn't fit in the file.
+    SE_TEST_CHECK(check_rejected([](Vector<ReadWriteByte>& bytes, AssetPackHeader& header, AssetPackEntry*)
+                                 { header.string_table_offset = bytes.count() + 1; }));
+    SE_TEST_CHECK(check_rejected([](Vector<ReadWriteByte>& bytes, AssetPackHeader& header, AssetPackEntry*)
+                                 { header.string_table_byte_count = bytes.count(); }));
+    SE_TEST_CHECK(check_rejected([](Vector<ReadWriteByte>&, AssetPackHeader& header, AssetPackEntry*) { header.string_table_offset = ~0ull; }));
+
+    // The data of an entry doesn't fit in the file, even if the offset overflows.
+    SE_TEST_CHECK(check_rejected([](Vector<ReadWriteByte>&, AssetPackHeader&, AssetPackEntry* entries) { entries[2].data_offset += 1; }));
+    SE_TEST_CHECK(check_rejected([](Vector<ReadWriteByte>&, AssetPackHeader&, AssetPackEntry* entries) { entries[1].stored_byte_count = ~0ull; }));
+    SE_TEST_CHECK(check_rejected([](Vector<ReadWriteByte>&, AssetPackHeader&, AssetPackEntry* entries) { entries[0].data_offset = ~0ull - 100; }));
+
+    // The name of an entry is outside of the string table.
+    SE_TEST_CHECK(check_rejected([](Vector<ReadWriteByte>&, AssetPackHeader& header, AssetPackEntry* entries)
+                                 { entries[2].name_offset = static_cast<u32>(header.string_table_byte_count); }));
+    SE_TEST_CHECK(check_rejected([](Vector<ReadWriteByte>&, AssetPackHeader&, AssetPackEntry* entries) { entries[0].name_byte_count = 0xFFFFFFFF; }));
+
+    // The entries are not strictly sorted by their handle, so they can't be searched.
+    SE_TEST_CHECK(check_rejected([](Vector<ReadWriteByte>&, AssetPackHeader&, AssetPackEntry* entries) { entries[1].handle = 5; }));
+    SE_TEST_CHECK(check_rejected([](Vector<ReadWriteByte>&, AssetPackHeader&, AssetPackEntry* entries) { entries[2].handle = entries[1].handle; }));
+
+    // An uncompressed entry whose sizes don't match, and an unknown compression.
+    SE_TEST_CHECK(check_rejected([](Vector<ReadWriteByte>&, AssetPackHeader&, AssetPackEntry* entries) { entries[0].byte_count += 1; }));
+    SE_TEST_CHECK(check_rejected([](Vector<ReadWriteByte>&, AssetPackHeader&, AssetPackEntry* entries)
+                                 { entries[1].compression = static_cast<AssetPackCompression>(7); }));
+
+    // The unmodified pack is still valid.
+    AssetPack pack;
+    SE_TEST_CHECK(write_test_file(pack_filepath, valid_pack_bytes) && pack.open(pack_filepath));
+    pack.close();
+
+    FileSystem::delete_file(pack_filepath);
+}
+
+SE_TEST(asset_pack_read_entry_rejects_corrupted_compressed_data)
+{
+    const String pack_filepath = "SE-Tests-AssetPack.sepak"sv;
+    Vector<ReadWriteByte> pack_bytes = create_test_asset_pack(create_test_asset_pack_entries());
+    AssetPackEntry* entries = reinterpret_cast<AssetPackEntry*>(pack_bytes.elements() + sizeof(AssetPackHeader));
+    // The compressed block is cut short, which the table of contents can't detect.
+    entries[1].stored_byte_count -= 1;
+    if (!SE_TEST_CHECK(write_test_file(pack_filepath, pack_bytes)))
+        return;
+
+    AssetPack pack;
+    if (SE_TEST_CHECK(pack.open(pack_filepath)))
+    {
+        Buffer decompression_buffer;
+        ReadonlyByteSpan entry_bytes;
+        SE_TEST_CHECK(!pack.read_entry(pack.get_entry(1), decompression_buffer, entry_bytes));
+        SE_TEST_CHECK(pack.read_entry(pack.get_entry(0), decompression_buffer, entry_bytes));
+        pack.close();
+    }
+
+    FileSystem::delete_file(pack_filepath);
+}
+
+SE_BENCHMARK(asset_pack_cold_start)
+{
+    constexpr u32 asset_count = 1000;
+    constexpr usize asset_byte_count = 64 * KiB;
+    constexpr u64 loaded_byte_count = static_cast<u64>(asset_count) * asset_byte_count;
+
+    Vector<TestAssetPackEntry> entries;
+    Vector<String> loose_filepaths;
+    for (u32 asset_index = 0; asset_index < asset_count; ++asset_index)
+    {
+        entries.add({ asset_index + 1, "Textures/Asset.setex"sv, create_test_asset_bytes(asset_byte_count, asset_index), AssetPackCompression::None });
+        loose_filepaths.add(format("SE-Tests-LooseAsset-{}.setex"sv, asset_index).value());
+        if (!SE_TEST_CHECK(write_test_file(loose_filepaths.last(), entries.last().bytes)))
+            return;
+    }
+
+    const String pack_filepath = "SE-Tests-AssetPack.sepak"sv;
+    const String compressed_pack_filepath = "SE-Tests-AssetPack-LZ4.sepak"sv;
+    if (!SE_TEST_CHECK(write_test_file(pack_filepath, create_test_asset_pack(entries))))
+        return;
+    for (TestAssetPackEntry& entry : entries)
+        entry.compression = AssetPackCompression::LZ4;
+    if (!SE_TEST_CHECK(write_test_file(compressed_pack_filepath, create_test_asset_pack(entries))))
+        return;
+
+    //
+    // Every asset is read and all of its bytes are touched, as an asset loader would.
+    // NOTE: The files were just written, so they are most likely in the file cache of the operating system. The benchmark
+    //       measures the cost of opening and reading many small files compared to reading from one mapped file, not the
+    //       speed of the storage device.
+    //
+    u64 checksum = 0;
+    const auto sum_bytes = [&checksum](ReadonlyByteSpan bytes)
+    {
+        for (usize byte_offset = 0; byte_offset < bytes.count(); byte_offset += 64)
+            checksum += bytes[byte_offset];
+    };
+
+    u64 start_tick_counter = Platform::get_current_tick_counter();
+    for (const String& loose_filepath : loose_filepaths)
+    {
+        FileReader file_reader;
+        Buffer file_buffer;
+        if (file_reader.open(loose_filepath) != FileError::Success || file_reader.read_entire_and_close(file_buffer) != FileError::Success)
+            return;
+        sum_bytes(file_buffer.readonly_byte_span());
+    }
+    test_context.report_throughput("Loose files"sv, loaded_byte_count, Platform::get_current_tick_counter() - start_tick_counter);
+
+    const auto measure_pack = [&](StringView measurement_name, const String& filepath)
+    {
+        const u64 pack_start_tick_counter = Platform::get_current_tick_counter();
+        AssetPack pack;
+        if (!SE_TEST_CHECK(pack.open(filepath)))
+            return;
+
+        Buffer decompression_buffer;
+        for (u32 asset_index = 0; asset_index < asset_count; ++asset_index)
+        {
+            const AssetPackEntry* entry = pack.find_entry(AssetHandle(UUID(asset_index + 1)));
+            ReadonlyByteSpan entry_bytes;
+            if (!SE_TEST_CHECK(entry != nullptr && pack.read_entry(*entry, decompression_buffer, entry_bytes)))
+                return;
+            sum_bytes(entry_bytes);
+        }
+        pack.close();
+        test_context.report_throughput(measurement_name, loaded_byte_count, Platform::get_current_tick_counter() - pack_start_tick_counter);
+    };
+
+    measure_pack("Asset pack"sv, pack_filepath);
+    measure_pack("Asset pack (LZ4)"sv, compressed_pack_filepath);
+    SE_TEST_CHECK(checksum > 0);
+
+    for (const String& loose_filepath : loose_filepaths)
+        FileSystem::delete_file(loose_filepath);
+    FileSystem::delete_file(pack_filepath);
+    FileSystem::delete_file(compressed_pack_filepath);
+}
+
+} // namespace SE
@@ -0,0 +1,237 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/BinaryLog.h>
+#include <Core/Containers/Vector.h>
+#include <Core/FileSystem/FileSystem.h>
+#include <Core/Log.h>
+#include <Core/LogSinks.h>
+#include <Core/Memory/Buffer.h>
+#include <Core/String/Format.h>
+#include <Core/String/String.h>
+#include <Core/UUID.h>
+#include <TestFramework.h>
+
+namespace SE
+{
+
+//
+// Encodes the arguments as `SE_LOG_FAST` does, and returns the message formatted from the encoded bytes. The decoded
+// message must be the same as the one formatted directly from the arguments.
+//
+template<typename... Args>
+NODISCARD static Optional<String> format_encoded_test_message(FormatString<TypeIdentity<Args>...> message, const Args&... args)
+{
+    static constexpr BinaryLogArgumentType s_argument_types[] = { BinaryLogArgument<Args>::type..., BinaryLogArgumentType::Invalid };
+
+    // NOTE: The arguments are written with aligned stores, so the buffer is made of slots.
+    const usize argument_byte_count = (BinaryLogArgument<Args>::get_byte_count(args) + ... + 0);
+    Vector<u64> argument_slots = Vector<u64>::create_filled(argument_byte_count / binary_log_slot_byte_count, 0);
+    u8* destination = reinterpret_cast<u8*>(argument_slots.elements());
+    ((destination = BinaryLogArgument<Args>::write(destination, args)), ...);
+    if (destination != reinterpret_cast<u8*>(argument_slots.elements()) + argument_byte_count)
+        return {};
+
+    const auto& last_segment = message.segment(sizeof...(Args));
+    const StringView format = StringView::unsafe_create_from_utf8(message.characters(), last_segment.offset + last_segment.byte_count);
+    const ReadonlyByteSpan argument_bytes = ReadonlyByteSpan(reinterpret_cast<ReadonlyBytes>(argument_slots.elements()), argument_byte_count);
+
+    FormatMemoryBuilder<512> builder;
+    if (!format_binary_log_message(builder, format, Span<const BinaryLogArgumentType>(s_argument_types, sizeof...(Args)), argument_bytes))
+        return {};
+    return builder.release_string();
+}
+
+template<typename... Args>
+NODISCARD static bool is_encoded_test_message_valid(FormatString<TypeIdentity<Args>...> message, const Args&... args)
+{
+    const Optional<String> decoded_message = format_encoded_test_message<Args...>(message, args...);
+    const Optional<String> expected_message = format(message, args...);
+    return decoded_message.has_value() && expected_message.has_value() && decoded_message.value() == expected_message->view();
+}
+
+NODISCARD static String create_test_string(usize byte_count)
+{
+    String string;
+    for (usize byte_index = 0; byte_index < byte_count; ++byte_index)
+    {
+        const char character = static_cast<char>('a' + byte_index % 26);
+        string.append(StringView::unsafe_create_from_utf8(&character, 1));
+    }
+    return string;
+}
+
+SE_TEST(binary_log_arguments_decode_to_the_formatted_text)
+{
+    // Integers of every size, at their limits and with the integer specifiers.
+    SE_TEST_CHECK(is_encoded_test_message_valid("{} {} {} {}"sv, u8(255), u16(65535), u32(0xFFFFFFFF), u64(0xFFFFFFFFFFFFFFFF)));
+    SE_TEST_CHECK(is_encoded_test_message_valid("{} {} {} {}"sv, i8(-128), i16(-32768), i32(-2147483647 - 1), i64(-9223372036854775807 - 1)));
+    SE_TEST_CHECK(is_encoded_test_message_valid("{} {} {} {}"sv, i8(127), i16(32767), i32(2147483647), i64(9223372036854775807)));
+    SE_TEST_CHECK(is_encoded_test_message_valid("{:x} {:08x} {:6} {:06}"sv, u32(0xBEEF), u64(0xABC), i32(-42), u16(7)));
+
+    // Booleans, and floats, which are stored as doubles but must be formatted as floats.
+    SE_TEST_CHECK(is_encoded_test_message_valid("{} and {}"sv, true, false));
+    SE_TEST_CHECK(is_encoded_test_message_valid("{} {} {} {}"sv, 0.1F, -3.4028235e38F, 1e-45F, 16777217.0F));
+    SE_TEST_CHECK(is_encoded_test_message_valid("{:.3f} {:.1f}"sv, 3.14159F, -0.05F));
+    SE_TEST_CHECK(is_encoded_test_message_valid("{} {} {} {}"sv, 0.1, -1.7976931348623157e308, 5e-324, 123456789.125));
+    SE_TEST_CHECK(is_encoded_test_message_valid("{:.6f}"sv, 2.718281828459045));
+
+    // UUIDs, strings of every kind, and all types in a single message.
+    SE_TEST_CHECK(is_encoded_test_message_valid("{} {}"sv, UUID(0), UUID(0x0123456789ABCDEF)));
+    const String string = "Player"sv;
+    const Name name = "Camera"sv;
+    SE_TEST_CHECK(is_encoded_test_message_valid("'{}' '{}' '{}' '{}'"sv, StringView(), "Entity"sv, string, name));
+    SE_TEST_CHECK(is_encoded_test_message_valid("[{:10}]"sv, "left"sv));
+    SE_TEST_CHECK(is_encoded_test_message_valid(
+        "Entity {} ({}) moved {} units in {} ms: {}, {}"sv, UUID(42), "Player"sv, 2.5F, u32(16), true, i64(-1)
+    ));
+    SE_TEST_CHECK(is_encoded_test_message_valid("No arguments."sv));
+
+    // Strings of every length up to a few slots, so each amount of padding is checked.
+    for (usize byte_count = 0; byte_count <= 4 * binary_log_slot_byte_count; ++byte_count)
+    {
+        const String test_string = create_test_string(byte_count);
+        SE_TEST_CHECK(is_encoded_test_message_valid("<{}>{}"sv, test_string.view(), u32(byte_count)));
+    }
+}
+
+SE_TEST(binary_log_strings_are_clamped)
+{
+    // The strings that are longer than the maximum are truncated to the maximum, and the arguments after them are still decoded.
+    const usize byte_counts[] = { binary_log_max_string_byte_count - 1, binary_log_max_string_byte_count, binary_log_max_string_byte_count + 1, 1000 };
+    for (const usize byte_count : byte_counts)
+    {
+        const String test_string = create_test_string(byte_count);
+        const usize clamped_byte_count = (byte_count < binary_log_max_string_byte_count) ? byte_count : binary_log_max_string_byte_count;
+        const StringView clamped_string = test_string.view().slice(0, clamped_byte_count);
+
+        SE_TEST_CHECK(BinaryLogArgument<StringView>::get_byte_count(test_string.view()) == 8 + align_to_binary_log_slot(clamped_byte_count));
+        const Optional<String> decoded_message = format_encoded_test_message<StringView, u32>("<{}>{}"sv, test_string.view(), 7u);
+        const Optional<String> expected_message = format("<{}>{}"sv, clamped_string, 7u);
+        SE_TEST_CHECK(decoded_message.has_value() && expected_message.has_value() && decoded_message.value() == expected_message->view());
+    }
+}
+
+SE_TEST(binary_log_rejects_arguments_that_dont_match_the_format)
+{
+    const BinaryLogArgumentType argument_types[] = { BinaryLogArgumentType::UnsignedInteger, BinaryLogArgumentType::String };
+    const Span<const BinaryLogArgumentType> types = Span<const BinaryLogArgumentType>(argument_types, 2);
+    u64 argument_slots[4] = { 5, 3, 0, 0 };
+    copy_memory(&argument_slots[2], "abc", 3);
+    const auto decode = [&](StringView format, usize argument_byte_count) -> bool
+    {
+        FormatMemoryBuilder<64> builder;
+        return format_binary_log_message(builder, format, types, ReadonlyByteSpan(reinterpret_cast<ReadonlyBytes>(argument_slots), argument_byte_count));
+    };
+
+    SE_TEST_CHECK(decode("{} {}"sv, 24));
+    // Missing bytes, extra bytes, and a different number of specifiers than arguments.
+    SE_TEST_CHECK(!decode("{} {}"sv, 16));
+    SE_TEST_CHECK(!decode("{} {}"sv, 8));
+    SE_TEST_CHECK(!decode("{} {}"sv, 32));
+    SE_TEST_CHECK(!decode("{}"sv, 24));
+    SE_TEST_CHECK(!decode("{} {} {}"sv, 24));
+    SE_TEST_CHECK(!decode("{} {"sv, 24));
+
+    // A string that is longer than the maximum can only come from corrupted bytes.
+    argument_slots[1] = binary_log_max_string_byte_count + 1;
+    SE_TEST_CHECK(!decode("{} {}"sv, 24));
+}
+
+//
+// Captures the text of the messages, as the logger thread and the log decoder write them.
+//
+class TestBinaryLogSink final : public LogSink
+{
+public:
+    struct CapturedMessage
+    {
+        Logger::Severity::Type severity;
+        Name tag;
+        String message;
+        u64 thread_id;
+        bool is_binary;
+    };
+
+public:
+    virtual void write(const LogMessage& message) override
+    {
+        m_messages.add({ message.severity, message.tag, String(message.message), message.thread_id, message.binary_format != nullptr });
+    }
+
+    NODISCARD ALWAYS_INLINE const Vector<CapturedMessage>& messages() const { return m_messages; }
+
+private:
+    Vector<CapturedMessage> m_messages;
+};
+
+SE_TEST(binary_log_file_decodes_to_the_logged_messages)
+{
+    const String filepath = "SE-Tests-BinaryLog.selog"sv;
+    const String long_string = create_test_string(300);
+    TestBinaryLogSink logged_messages;
+
+    if (!SE_TEST_CHECK(Logger::initialize()))
+        return;
+    {
+        BinaryFileLogSink file_sink = BinaryFileLogSink(filepath);
+        SE_TEST_CHECK(file_sink.is_opened());
+        Logger::add_sink(&file_sink);
+        Logger::add_sink(&logged_messages);
+
+        // Binary messages of every argument type are mixed with text messages. The binary messages from the same place
+        // share their format, which is written to the file only once.
+        for (u32 index = 0; index < 3; ++index)
+        {
+            SE_LOG_FAST(Info, "Entity {} '{}' moved by {} in {} ms.", UUID(1000 + index), "Player"sv, 0.5F * static_cast<float>(index), 16.25);
+            SE_LOG_FAST(Warn, "{} {} {} {:x}", i8(-5), i64(-1), true, u64(0xDEAD) + index);
+            Logger::log_tagged_message(Logger::Severity::Error, "BinaryLogTests"sv, "Text message {}"sv, index);
+        }
+        SE_LOG_FAST(Info, "Clamped: {}", long_string);
+
+        Logger::flush();
+        Logger::remove_sink(&logged_messages);
+        Logger::remove_sink(&file_sink);
+    }
+    Logger::shutdown();
+
+    Buffer file_bytes;
+    FileReader file_reader;
+    if (SE_TEST_CHECK(file_reader.open(filepath) == FileError::Success && file_reader.read_entire_and_close(file_bytes) == FileError::Success))
+    {
+        TestBinaryLogSink decoded_messages;
+        SE_TEST_CHECK(decode_binary_log_file(file_bytes.readonly_byte_span(), decoded_messages));
+
+        // The decoder formats the messages exactly as the logger thread did.
+        if (SE_TEST_CHECK(logged_messages.messages().count() == 10 && decoded_messages.messages().count() == logged_messages.messages().count()))
+        {
+            for (usize message_index = 0; message_index < logged_messages.messages().count(); ++message_index)
+            {
+                const TestBinaryLogSink::CapturedMessage& logged_message = logged_messages.messages()[message_index];
+                const TestBinaryLogSink::CapturedMessage& decoded_message = decoded_messages.messages()[message_index];
+                SE_TEST_CHECK(decoded_message.message == logged_message.message.view());
+                SE_TEST_CHECK(decoded_message.severity == logged_message.severity && decoded_message.tag == logged_message.tag);
+                SE_TEST_CHECK(decoded_message.thread_id == logged_message.thread_id);
+            }
+
+            // NOTE: The text messages are written before the binary messages that were published in the same pass.
+            const Optional<String> clamped_message = format("Clamped: {}"sv, long_string.view().slice(0, binary_log_max_string_byte_count));
+            bool has_clamped_message = false;
+            for (const TestBinaryLogSink::CapturedMessage& logged_message : logged_messages.messages())
+                has_clamped_message |= (logged_message.is_binary && logged_message.message == clamped_message->view());
+            SE_TEST_CHECK(has_clamped_message);
+        }
+
+        // A file that is cut in the middle of a chunk decodes the complete chunks, and a file without its header is rejected.
+        TestBinaryLogSink truncated_messages;
+        SE_TEST_CHECK(decode_binary_log_file(file_bytes.readonly_byte_span().slice(0, file_bytes.byte_count() - 3), truncated_messages));
+        SE_TEST_CHECK(truncated_messages.messages().count() + 1 == decoded_messages.messages().count());
+        SE_TEST_CHECK(!decode_binary_log_file(file_bytes.readonly_byte_span().slice(0, 10), truncated_messages));
+    }
+
+    FileSystem::delete_file(filepath);
+}
+
+} // namespace SE
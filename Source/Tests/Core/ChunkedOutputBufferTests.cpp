@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/Containers/Vector.h>
+#include <Core/FileSystem/FileSystem.h>
+#include <Core/Math/MathCore.h>
+#include <Core/Memory/Buffer.h>
+#include <Core/String/ChunkedOutputBuffer.h>
+#include <TestFramework.h>
+#include <cstring>
+
+namespace SE
+{
+
+// Characters that don't repeat with a period that divides the chunk size, so a chunk written at the wrong offset is detected.
+NODISCARD static Vector<char> create_test_characters(usize byte_count, u64 seed)
+{
+    TestRandomGenerator random_generator = { seed };
+    Vector<char> characters = Vector<char>::create_filled(byte_count, 0);
+    for (char& character : characters)
+        character = static_cast<char>('a' + random_generator.next() % 26);
+    return characters;
+}
+
+NODISCARD static StringView get_test_string_view(const Vector<char>& characters, usize offset, usize byte_count)
+{
+    return StringView::create_from_utf8(characters.elements() + offset, byte_count);
+}
+
+// Checks that the file contains exactly the given characters.
+static void check_test_file_contents(TestContext& test_context, const String& filepath, const Vector<char>& expected_characters)
+{
+    Buffer file_contents;
+    FileReader file_reader;
+    if (!SE_TEST_CHECK(file_reader.open(filepath) == FileError::Success && file_reader.read_entire_and_close(file_contents) == FileError::Success))
+        return;
+
+    if (SE_TEST_CHECK(file_contents.byte_count() == expected_characters.count()))
+        SE_TEST_CHECK(std::memcmp(file_contents.data(), expected_characters.elements(), expected_characters.count()) == 0);
+}
+
+SE_TEST(chunked_output_buffer_fills_chunks_up_to_their_boundary)
+{
+    constexpr usize chunk_byte_count = ChunkedOutputBuffer::chunk_byte_count;
+    const Vector<char> characters = create_test_characters(3 * chunk_byte_count + 1, 1);
+    const String filepath = "SE-Tests-ChunkedOutputBuffer.txt"sv;
+
+    // The strings end exactly at the chunk boundaries, followed by a single character in a new chunk.
+    for (const usize byte_count : { chunk_byte_count - 1, chunk_byte_count, chunk_byte_count + 1, 3 * chunk_byte_count, 3 * chunk_byte_count + 1 })
+    {
+        ChunkedOutputBuffer buffer;
+        const usize first_byte_count = Math::min(byte_count, chunk_byte_count);
+        buffer.append(get_test_string_view(characters, 0, first_byte_count));
+        SE_TEST_CHECK(buffer.byte_count() == first_byte_count);
+        for (usize offset = first_byte_count; offset < byte_count; offset += chunk_byte_count)
+            buffer.append(get_test_string_view(characters, offset, Math::min(chunk_byte_count, byte_count - offset)));
+        SE_TEST_CHECK(buffer.byte_count() == byte_count);
+
+        FileWriter file_writer;
+        if (SE_TEST_CHECK(file_writer.open(filepath) == FileError::Success))
+        {
+            SE_TEST_CHECK(buffer.write_to(file_writer) == FileError::Success);
+            file_writer.close();
+            check_test_file_contents(test_context, filepath, Vector<char>::create_from_span(Span<const char>(characters.elements(), byte_count)));
+        }
+    }
+
+    FileSystem::delete_file(filepath);
+}
+
+SE_TEST(chunked_output_buffer_splits_strings_across_chunks)
+{
+    constexpr usize chunk_byte_count = ChunkedOutputBuffer::chunk_byte_count;
+    const Vector<char> characters = create_test_characters(5 * chunk_byte_count + 123, 2);
+    const String filepath = "SE-Tests-ChunkedOutputBuffer.txt"sv;
+
+    ChunkedOutputBuffer buffer;
+    // Strings of a length that is not a divisor of the chunk size straddle the chunk boundaries.
+    usize offset = 0;
+    for (; offset + 997 <= 2 * chunk_byte_count; offset += 997)
+        buffer.append(get_test_string_view(characters, offset, 997));
+    // A single string that is larger than two chunks is split across three of them.
+    buffer.append(get_test_string_view(characters, offset, characters.count() - offset));
+    SE_TEST_CHECK(buffer.byte_count() == characters.count());
+
+    FileWriter file_writer;
+    if (SE_TEST_CHECK(file_writer.open(filepath) == FileError::Success))
+    {
+        SE_TEST_CHECK(buffer.write_to(file_writer) == FileError::Success);
+        file_writer.close();
+        check_test_file_contents(test_context, filepath, characters);
+    }
+
+    FileSystem::delete_file(filepath);
+}
+
+SE_TEST(chunked_output_buffer_formats_across_chunks)
+{
+    const String filepath = "SE-Tests-ChunkedOutputBuffer.txt"sv;
+    ChunkedOutputBuffer buffer;
+
+    // The formatted numbers don't align with the chunk boundaries, so some of them are split between two chunks.
+    Vector<char> expected_characters;
+    for (u32 value = 0; buffer.byte_count() < 2 * ChunkedOutputBuffer::chunk_byte_count + 50; ++value)
+    {
+        SE_TEST_CHECK(format_to(buffer, "{}, "sv, value) == FormatErrorCode::Success);
+        char value_characters[16];
+        const Optional<StringView> value_string = format_to(Span<char>(value_characters, sizeof(value_characters)), "{}, "sv, value);
+        expected_characters.add_span(Span<const char>(value_string->characters(), value_string->byte_count()));
+    }
+    SE_TEST_CHECK(buffer.byte_count() == expected_characters.count());
+
+    FileWriter file_writer;
+    if (SE_TEST_CHECK(file_writer.open(filepath) == FileError::Success))
+    {
+        SE_TEST_CHECK(buffer.write_to(file_writer) == FileError::Success);
+        file_writer.close();
+        check_test_file_contents(test_context, filepath, expected_characters);
+    }
+
+    FileSystem::delete_file(filepath);
+}
+
+SE_TEST(chunked_output_buffer_write_to_clears_the_buffer)
+{
+    const Vector<char> characters = create_test_characters(2 * ChunkedOutputBuffer::chunk_byte_count + 17, 3);
+    const String first_filepath = "SE-Tests-ChunkedOutputBuffer-1.txt"sv;
+    const String second_filepath = "SE-Tests-ChunkedOutputBuffer-2.txt"sv;
+    const usize second_byte_count = 1000;
+
+    ChunkedOutputBuffer buffer;
+    buffer.append(get_test_string_view(characters, 0, characters.count()));
+
+    FileWriter first_file_writer;
+    if (SE_TEST_CHECK(first_file_writer.open(first_filepath) == FileError::Success))
+    {
+        SE_TEST_CHECK(buffer.write_to(first_file_writer) == FileError::Success);
+        first_file_writer.close();
+        check_test_file_contents(test_context, first_filepath, characters);
+    }
+    SE_TEST_CHECK(buffer.byte_count() == 0);
+
+    // The buffer is reused, and only the characters appended after the previous write are written.
+    buffer.append(get_test_string_view(characters, 0, second_byte_count));
+    SE_TEST_CHECK(buffer.byte_count() == second_byte_count);
+    FileWriter second_file_writer;
+    if (SE_TEST_CHECK(second_file_writer.open(second_filepath) == FileError::Success))
+    {
+        SE_TEST_CHECK(buffer.write_to(second_file_writer) == FileError::Success);
+        second_file_writer.close();
+        check_test_file_contents(test_context, second_filepath, Vector<char>::create_from_span(Span<const char>(characters.elements(), second_byte_count)));
+    }
+
+    // Writing an empty buffer produces an empty file.
+    FileWriter empty_file_writer;
+    if (SE_TEST_CHECK(empty_file_writer.open(second_filepath) == FileError::Success))
+    {
+        SE_TEST_CHECK(buffer.write_to(empty_file_writer) == FileError::Success);
+        empty_file_writer.close();
+        check_test_file_contents(test_context, second_filepath, {});
+    }
+
+    FileSystem::delete_file(first_filepath);
+    FileSystem::delete_file(second_filepath);
+}
+
+SE_TEST(chunked_output_buffer_streams_to_the_file)
+{
+    constexpr usize chunk_byte_count = ChunkedOutputBuffer::chunk_byte_count;
+    const Vector<char> characters = create_test_characters(7 * chunk_byte_count + 321, 4);
+    const String filepath = "SE-Tests-ChunkedOutputBuffer.txt"sv;
+
+    const u32 max_streamed_chunk_counts[] = { 1, 2, ChunkedOutputBuffer::default_max_streamed_chunk_count };
+    for (const u32 max_streamed_chunk_count : max_streamed_chunk_counts)
+    {
+        FileWriter file_writer;
+        if (!SE_TEST_CHECK(file_writer.open(filepath) == FileError::Success))
+            continue;
+
+        {
+            ChunkedOutputBuffer buffer(file_writer, max_streamed_chunk_count);
+            SE_TEST_CHECK(buffer.is_streaming());
+
+            // The byte count includes the characters that have already been streamed to the file.
+            usize offset = 0;
+            const usize byte_counts[] = { 1000, chunk_byte_count, 3 * chunk_byte_count + 5, 3 * chunk_byte_count - 1005 };
+            for (const usize byte_count : byte_counts)
+            {
+                buffer.append(get_test_string_view(characters, offset, byte_count));
+                offset += byte_count;
+                SE_TEST_CHECK(buffer.byte_count() == offset);
+            }
+
+            // An explicit flush writes the partially filled chunk, and the buffer continues to append after it.
+            buffer.flush();
+            SE_TEST_CHECK(buffer.byte_count() == offset);
+            buffer.flush();
+            SE_TEST_CHECK(buffer.byte_count() == offset);
+
+            buffer.append(get_test_string_view(characters, offset, characters.count() - offset));
+            SE_TEST_CHECK(buffer.byte_count() == characters.count());
+            SE_TEST_CHECK(buffer.file_error() == FileError::Success);
+
+            // The remaining characters are written when the buffer is destroyed.
+        }
+
+        file_writer.close();
+        check_test_file_contents(test_context, filepath, characters);
+    }
+
+    FileSystem::delete_file(filepath);
+}
+
+} // namespace SE
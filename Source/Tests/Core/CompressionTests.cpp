@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/Containers/Vector.h>
+#include <Core/Memory/Compression.h>
+#include <TestFramework.h>
+#include <cstring>
+
+namespace SE
+{
+
+// Compresses the given bytes and checks that decompressing them results in the same bytes. Returns the compressed block.
+static Vector<ReadWriteByte> check_lz4_round_trip(TestContext& test_context, ReadonlyByteSpan bytes)
+{
+    Vector<ReadWriteByte> compressed_bytes = Vector<ReadWriteByte>::create_filled(get_lz4_max_compressed_byte_count(bytes.count()), 0);
+    const usize compressed_byte_count = compress_lz4(bytes, WriteonlyByteSpan(compressed_bytes.elements(), compressed_bytes.count()));
+    SE_TEST_CHECK(compressed_byte_count <= get_lz4_max_compressed_byte_count(bytes.count()));
+    compressed_bytes.remove(compressed_byte_count, compressed_bytes.count() - compressed_byte_count);
+
+    // The destination is larger than the data, so writing past the end of the data would be detected.
+    Vector<ReadWriteByte> decompressed_bytes = Vector<ReadWriteByte>::create_filled(bytes.count() + 16, 0xCD);
+    const ReadonlyByteSpan compressed_span = ReadonlyByteSpan(compressed_bytes.elements(), compressed_bytes.count());
+    SE_TEST_CHECK(decompress_lz4(compressed_span, WriteonlyByteSpan(decompressed_bytes.elements(), bytes.count())));
+    SE_TEST_CHECK(bytes.count() == 0 || std::memcmp(decompressed_bytes.elements(), bytes.elements(), bytes.count()) == 0);
+    for (usize byte_index = bytes.count(); byte_index < decompressed_bytes.count(); ++byte_index)
+        SE_TEST_CHECK(decompressed_bytes[byte_index] == 0xCD);
+
+    return compressed_bytes;
+}
+
+NODISCARD static Vector<ReadWriteByte> create_random_bytes(usize byte_count, u32 distinct_value_count, u64 seed)
+{
+    TestRandomGenerator random_generator = { seed };
+    Vector<ReadWriteByte> bytes = Vector<ReadWriteByte>::create_filled(byte_count, 0);
+    for (ReadWriteByte& byte : bytes)
+        byte = static_cast<ReadWriteByte>(random_generator.next() % distinct_value_count);
+    return bytes;
+}
+
+SE_TEST(lz4_round_trips_empty_and_short_inputs)
+{
+    const Vector<ReadWriteByte> empty_compressed_bytes = check_lz4_round_trip(test_context, {});
+    // An empty input is a single token, without literals or matches.
+    SE_TEST_CHECK(empty_compressed_bytes.count() == 1);
+
+    // The inputs that are too short to contain a match are stored only as literals.
+    const char* text = "abcabcabcabcabcabc";
+    for (usize byte_count = 1; byte_count <= 18; ++byte_count)
+        check_lz4_round_trip(test_context, ReadonlyByteSpan(reinterpret_cast<ReadonlyBytes>(text), byte_count));
+}
+
+SE_TEST(lz4_round_trips_incompressible_input)
+{
+    // Random bytes only contain accidental matches, so the block is mostly literals and never exceeds the maximum size.
+    for (const usize byte_count : { 15, 16, 270, 271, 4096, 65536 + 300 })
+    {
+        const Vector<ReadWriteByte> bytes = create_random_bytes(byte_count, 256, byte_count);
+        const Vector<ReadWriteByte> compressed_bytes = check_lz4_round_trip(test_context, ReadonlyByteSpan(bytes.elements(), bytes.count()));
+        SE_TEST_CHECK(compressed_bytes.count() >= byte_count);
+    }
+}
+
+SE_TEST(lz4_round_trips_overlapping_matches)
+{
+    // A run of a single byte is encoded as a match whose offset (one) is much smaller than its length, so the match
+    // overlaps the bytes it produces.
+    const Vector<ReadWriteByte> run_bytes = Vector<ReadWriteByte>::create_filled(100000, 'a');
+    const Vector<ReadWriteByte> run_compressed_bytes = check_lz4_round_trip(test_context, ReadonlyByteSpan(run_bytes.elements(), run_bytes.count()));
+    SE_TEST_CHECK(run_compressed_bytes.count() < 500);
+
+    // Short repeated patterns, with offsets between 2 and 7 bytes.
+    for (usize pattern_byte_count = 2; pattern_byte_count < 8; ++pattern_byte_count)
+    {
+        Vector<ReadWriteByte> pattern_bytes = Vector<ReadWriteByte>::create_filled(1000 + pattern_byte_count, 0);
+        for (usize byte_index = 0; byte_index < pattern_bytes.count(); ++byte_index)
+            pattern_bytes[byte_index] = static_cast<ReadWriteByte>('0' + byte_index % pattern_byte_count);
+        check_lz4_round_trip(test_context, ReadonlyByteSpan(pattern_bytes.elements(), pattern_bytes.count()));
+    }
+
+    // Data with few distinct values contains many matches of every length, including matches that are farther away than
+    // the maximum offset.
+    for (const u32 distinct_value_count : { 2, 4, 16 })
+    {
+        const Vector<ReadWriteByte> bytes = create_random_bytes(200000, distinct_value_count, distinct_value_count);
+        check_lz4_round_trip(test_context, ReadonlyByteSpan(bytes.elements(), bytes.count()));
+    }
+}
+
+SE_TEST(lz4_rejects_truncated_blocks)
+{
+    const Vector<ReadWriteByte> bytes = create_random_bytes(5000, 4, 1);
+    const Vector<ReadWriteByte> compressed_bytes = check_lz4_round_trip(test_context, ReadonlyByteSpan(bytes.elements(), bytes.count()));
+
+    Vector<ReadWriteByte> decompressed_bytes = Vector<ReadWriteByte>::create_filled(bytes.count(), 0);
+    u32 accepted_truncated_block_count = 0;
+    for (usize truncated_byte_count = 0; truncated_byte_count < compressed_bytes.count(); ++truncated_byte_count)
+    {
+        // NOTE: The truncated block is copied to its own allocation, so reading past its end would be reported by the sanitizers.
+        const Vector<ReadWriteByte> truncated_bytes =
+            Vector<ReadWriteByte>::create_from_span(Span<const ReadWriteByte>(compressed_bytes.elements(), truncated_byte_count));
+
+        const ReadonlyByteSpan truncated_span = ReadonlyByteSpan(truncated_bytes.elements(), truncated_bytes.count());
+        if (decompress_lz4(truncated_span, WriteonlyByteSpan(decompressed_bytes.elements(), decompressed_bytes.count())))
+            ++accepted_truncated_block_count;
+    }
+    SE_TEST_CHECK(accepted_truncated_block_count == 0);
+}
+
+SE_TEST(lz4_rejects_corrupted_blocks)
+{
+    ReadWriteByte decompressed_bytes[64];
+    const auto decompress = [&](std::initializer_list<ReadWriteByte> block, usize decompressed_byte_count) -> bool
+    {
+        return decompress_lz4(ReadonlyByteSpan(block.begin(), block.size()), WriteonlyByteSpan(decompressed_bytes, decompressed_byte_count));
+    };
+
+    // A valid block: 4 literals ('abcd') followed by a match of 8 bytes at offset 4, and a last sequence with 1 literal.
+    SE_TEST_CHECK(decompress({ 0x44, 'a', 'b', 'c', 'd', 0x04, 0x00, 0x10, 'e' }, 13));
+
+    // The match offset is zero, or points before the beginning of the output.
+    SE_TEST_CHECK(!decompress({ 0x44, 'a', 'b', 'c', 'd', 0x00, 0x00, 0x10, 'e' }, 13));
+    SE_TEST_CHECK(!decompress({ 0x44, 'a', 'b', 'c', 'd', 0x05, 0x00, 0x10, 'e' }, 13));
+    // The match offset is cut in half.
+    SE_TEST_CHECK(!decompress({ 0x44, 'a', 'b', 'c', 'd', 0x04 }, 13));
+    // The literals continue past the end of the block.
+    SE_TEST_CHECK(!decompress({ 0x80, 'a', 'b', 'c' }, 8));
+    // The length continuation of the literals is missing.
+    SE_TEST_CHECK(!decompress({ 0xF0 }, 16));
+    SE_TEST_CHECK(!decompress({ 0xF0, 0xFF, 0xFF }, 64));
+    // The length continuation of the match is missing.
+    SE_TEST_CHECK(!decompress({ 0x4F, 'a', 'b', 'c', 'd', 0x04, 0x00 }, 64));
+
+    // The output is larger or smaller than the size of the uncompressed data.
+    SE_TEST_CHECK(!decompress({ 0x44, 'a', 'b', 'c', 'd', 0x04, 0x00, 0x10, 'e' }, 12));
+    SE_TEST_CHECK(!decompress({ 0x44, 'a', 'b', 'c', 'd', 0x04, 0x00, 0x10, 'e' }, 14));
+    SE_TEST_CHECK(!decompress({ 0x30, 'a', 'b', 'c' }, 2));
+    SE_TEST_CHECK(!decompress({}, 1));
+
+    // Any corruption of a real block must be handled without reading or writing out of bounds, even if it can't always
+    // be detected (a changed literal still decodes to valid data).
+    const Vector<ReadWriteByte> bytes = create_random_bytes(2000, 8, 2);
+    const Vector<ReadWriteByte> compressed_bytes = check_lz4_round_trip(test_context, ReadonlyByteSpan(bytes.elements(), bytes.count()));
+    Vector<ReadWriteByte> output_bytes = Vector<ReadWriteByte>::create_filled(bytes.count(), 0);
+    TestRandomGenerator random_generator = { 3 };
+    for (u32 iteration_index = 0; iteration_index < 2000; ++iteration_index)
+    {
+        Vector<ReadWriteByte> corrupted_bytes = compressed_bytes;
+        corrupted_bytes[random_generator.next() % corrupted_bytes.count()] ^= static_cast<ReadWriteByte>(1 + random_generator.next() % 255);
+        MAYBE_UNUSED const bool is_valid = decompress_lz4(
+            ReadonlyByteSpan(corrupted_bytes.elements(), corrupted_bytes.count()), WriteonlyByteSpan(output_bytes.elements(), output_bytes.count())
+        );
+    }
+}
+
+} // namespace SE
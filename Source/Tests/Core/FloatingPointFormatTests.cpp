@@ -0,0 +1,417 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/Containers/Vector.h>
+#include <Core/Math/MathCore.h>
+#include <Core/Platform/Atomic.h>
+#include <Core/Platform/Thread.h>
+#include <Core/String/FloatingPointFormat.h>
+#include <Core/String/Format.h>
+#include <Core/String/NumberParsing.h>
+#include <TestFramework.h>
+#include <bit>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+namespace SE
+{
+
+//
+// Calculates the shortest decimal representation of a value using the C library, which is the reference the Ryu
+// implementation is checked against: the value is printed with an increasing number of significant digits, until
+// the printed value is parsed back to exactly the same value.
+//
+template<typename T>
+NODISCARD static DecimalFloatingPoint get_reference_shortest_decimal(T value)
+{
+    constexpr u32 max_significant_digit_count = (sizeof(T) == sizeof(float)) ? 9 : 17;
+
+    char buffer[64];
+    for (u32 significant_digit_count = 1; significant_digit_count <= max_significant_digit_count; ++significant_digit_count)
+    {
+        std::snprintf(buffer, sizeof(buffer), "%.*e", static_cast<int>(significant_digit_count - 1), static_cast<double>(value));
+        const T parsed_value = (sizeof(T) == sizeof(float)) ? static_cast<T>(std::strtof(buffer, nullptr)) : static_cast<T>(std::strtod(buffer, nullptr));
+        if (parsed_value != value)
+            continue;
+
+        DecimalFloatingPoint decimal = {};
+        u32 digit_count = 0;
+        const char* character = buffer;
+        for (; *character != 'e'; ++character)
+        {
+            if ('0' <= *character && *character <= '9')
+            {
+                decimal.digits = decimal.digits * 10 + static_cast<u64>(*character - '0');
+                ++digit_count;
+            }
+        }
+
+        decimal.exponent = std::atoi(character + 1) - static_cast<i32>(digit_count - 1);
+        while (decimal.digits != 0 && decimal.digits % 10 == 0)
+        {
+            decimal.digits /= 10;
+            ++decimal.exponent;
+        }
+        return decimal;
+    }
+
+    SE_ASSERT(false);
+    return {};
+}
+
+template<typename T>
+NODISCARD static bool is_shortest_decimal_valid(T value)
+{
+    const DecimalFloatingPoint decimal = get_shortest_decimal(value);
+    const DecimalFloatingPoint reference_decimal = get_reference_shortest_decimal(value);
+    return (decimal.digits == reference_decimal.digits && decimal.exponent == reference_decimal.exponent);
+}
+
+NODISCARD static bool is_formatted_as(Optional<String> formatted_string, const char* expected_string)
+{
+    return formatted_string.has_value() && formatted_string->view() == StringView::create_from_utf8(expected_string);
+}
+
+SE_TEST(floating_point_format_shortest_float_matches_reference)
+{
+    const float edge_values[] = {
+        std::bit_cast<float>(0x00000001U), // The smallest subnormal value.
+        std::bit_cast<float>(0x007FFFFFU), // The largest subnormal value.
+        std::bit_cast<float>(0x00800000U), // The smallest normal value.
+        std::bit_cast<float>(0x7F7FFFFFU), // The largest finite value.
+        0.1F, 1.0F, 3.0F, 1.0F / 3.0F, 16777216.0F, 16777218.0F, 1e10F, 1e-10F, 8.589973e9F, 2.3509887e-38F,
+    };
+    for (const float value : edge_values)
+        SE_TEST_CHECK(is_shortest_decimal_valid(value));
+
+    TestRandomGenerator random_generator = { 1 };
+    u32 failed_value_count = 0;
+    for (u32 value_index = 0; value_index < 250000; ++value_index)
+    {
+        const float value = std::bit_cast<float>(static_cast<u32>(random_generator.next()) & 0x7FFFFFFF);
+        if (!std::isfinite(value) || value <= 0.0F)
+            continue;
+        if (!is_shortest_decimal_valid(value))
+            ++failed_value_count;
+    }
+    SE_TEST_CHECK(failed_value_count == 0);
+}
+
+SE_TEST(floating_point_format_shortest_double_matches_reference)
+{
+    const double edge_values[] = {
+        std::bit_cast<double>(0x0000000000000001ULL), // The smallest subnormal value.
+        std::bit_cast<double>(0x000FFFFFFFFFFFFFULL), // The largest subnormal value.
+        std::bit_cast<double>(0x0010000000000000ULL), // The smallest normal value.
+        std::bit_cast<double>(0x7FEFFFFFFFFFFFFFULL), // The largest finite value.
+        0.1, 0.3, 1.0, 1.0 / 3.0, 9007199254740992.0, 9007199254740994.0, 1e23, 5.764607523034235e39, 2.9802322387695312e-8, 1e-300,
+    };
+    for (const double value : edge_values)
+        SE_TEST_CHECK(is_shortest_decimal_valid(value));
+
+    TestRandomGenerator random_generator = { 2 };
+    u32 failed_value_count = 0;
+    for (u32 value_index = 0; value_index < 250000; ++value_index)
+    {
+        // Random bit patterns cover all the exponents, while the ratios of small integers are the values with few
+        // significant digits that are common in practice.
+        double value = std::bit_cast<double>(random_generator.next() & 0x7FFFFFFFFFFFFFFF);
+        if (value_index % 3 == 0)
+            value = static_cast<double>(random_generator.next() % 100000) / static_cast<double>(1 + random_generator.next() % 1000);
+        if (!std::isfinite(value) || value <= 0.0)
+            continue;
+        if (!is_shortest_decimal_valid(value))
+            ++failed_value_count;
+    }
+    SE_TEST_CHECK(failed_value_count == 0);
+}
+
+SE_TEST(floating_point_format_fixed_decimal_matches_reference)
+{
+    TestRandomGenerator random_generator = { 3 };
+    u32 failed_value_count = 0;
+    for (u32 value_index = 0; value_index < 500000; ++value_index)
+    {
+        // Values with a fractional part close to a rounding boundary, and random bit patterns (including very large values).
+        double value;
+        if (value_index % 2 == 0)
+            value = std::ldexp(static_cast<double>(random_generator.next() >> 11), static_cast<int>(random_generator.next() % 200) - 150);
+        else
+            value = std::bit_cast<double>(random_generator.next() & 0x7FFFFFFFFFFFFFFF);
+        if (!std::isfinite(value))
+            continue;
+
+        const u32 precision = static_cast<u32>(random_generator.next() % ((value_index % 4 == 0) ? (fixed_decimal_max_precision + 1) : 8));
+
+        char buffer[fixed_decimal_max_integral_digit_count + fixed_decimal_max_precision + 1];
+        const usize byte_count = write_fixed_decimal(value, precision, buffer);
+        buffer[byte_count] = '\0';
+
+        char reference_buffer[sizeof(buffer)];
+        std::snprintf(reference_buffer, sizeof(reference_buffer), "%.*f", static_cast<int>(precision), value);
+        if (std::strcmp(buffer, reference_buffer) != 0)
+            ++failed_value_count;
+    }
+    SE_TEST_CHECK(failed_value_count == 0);
+}
+
+SE_TEST(format_writes_floating_point_values)
+{
+    // The shortest representation uses the fixed notation, unless the scientific notation is shorter.
+    SE_TEST_CHECK(is_formatted_as(format("{}"sv, 1.5F), "1.5"));
+    SE_TEST_CHECK(is_formatted_as(format("{}"sv, 0.1F), "0.1"));
+    SE_TEST_CHECK(is_formatted_as(format("{}"sv, 0.1), "0.1"));
+    SE_TEST_CHECK(is_formatted_as(format("{}"sv, 1.0 / 3.0), "0.3333333333333333"));
+    SE_TEST_CHECK(is_formatted_as(format("{}"sv, 100.0), "100"));
+    SE_TEST_CHECK(is_formatted_as(format("{}"sv, 1e20), "100000000000000000000"));
+    SE_TEST_CHECK(is_formatted_as(format("{}"sv, 1e21), "1e+21"));
+    SE_TEST_CHECK(is_formatted_as(format("{}"sv, 1.5e-7), "1.5e-7"));
+    SE_TEST_CHECK(is_formatted_as(format("{}"sv, 0.000001), "0.000001"));
+    SE_TEST_CHECK(is_formatted_as(format("{}"sv, 5e-324), "5e-324"));
+    SE_TEST_CHECK(is_formatted_as(format("{}"sv, 1.7976931348623157e308), "1.7976931348623157e+308"));
+    SE_TEST_CHECK(is_formatted_as(format("{}"sv, 3.4028235e38F), "3.4028235e+38"));
+
+    // Zeros keep their sign, and the special values are written as in the C library.
+    SE_TEST_CHECK(is_formatted_as(format("{}"sv, -0.0), "-0"));
+    SE_TEST_CHECK(is_formatted_as(format("{}"sv, 0.0F), "0"));
+    SE_TEST_CHECK(is_formatted_as(format("{}"sv, std::numeric_limits<double>::quiet_NaN()), "nan"));
+    SE_TEST_CHECK(is_formatted_as(format("{}"sv, -std::numeric_limits<double>::infinity()), "-inf"));
+    SE_TEST_CHECK(is_formatted_as(format("{:08}"sv, std::numeric_limits<double>::infinity()), "     inf"));
+
+    // The fixed notation is correctly rounded, with ties rounded to even.
+    SE_TEST_CHECK(is_formatted_as(format("{:.3f}"sv, 3.14159), "3.142"));
+    SE_TEST_CHECK(is_formatted_as(format("{:.3f}"sv, 0.0005), "0.001"));
+    SE_TEST_CHECK(is_formatted_as(format("{:.0f}"sv, 2.5), "2"));
+    SE_TEST_CHECK(is_formatted_as(format("{:.0f}"sv, 3.5), "4"));
+    SE_TEST_CHECK(is_formatted_as(format("{:.2f}"sv, 0.125), "0.12"));
+    SE_TEST_CHECK(is_formatted_as(format("{:.3f}"sv, 0.1245F), "0.124"));
+    SE_TEST_CHECK(is_formatted_as(format("{:08.3f}"sv, -1.5), "-001.500"));
+    SE_TEST_CHECK(is_formatted_as(format("{:f}"sv, 1.0), "1.000000"));
+    SE_TEST_CHECK(is_formatted_as(format("{:.2f}"sv, 1e22), "10000000000000000000000.00"));
+
+    // The specifiers that don't apply to floating point values are rejected.
+    SE_TEST_CHECK(!format("{:x}"sv, 1.0).has_value());
+}
+
+SE_TEST(format_writes_integers)
+{
+    SE_TEST_CHECK(is_formatted_as(format("{}"sv, 0U), "0"));
+    SE_TEST_CHECK(is_formatted_as(format("{}"sv, static_cast<u64>(1234567890123)), "1234567890123"));
+    SE_TEST_CHECK(is_formatted_as(format("{}"sv, static_cast<u64>(-1)), "18446744073709551615"));
+    SE_TEST_CHECK(is_formatted_as(format("{}"sv, static_cast<i64>(0x8000000000000000)), "-9223372036854775808"));
+    SE_TEST_CHECK(is_formatted_as(format("{:x}"sv, 255), "ff"));
+    SE_TEST_CHECK(is_formatted_as(format("{:X}"sv, 48879U), "BEEF"));
+    SE_TEST_CHECK(is_formatted_as(format("{:08x}"sv, 48879U), "0000beef"));
+    SE_TEST_CHECK(is_formatted_as(format("{:x}"sv, -255), "-ff"));
+    SE_TEST_CHECK(is_formatted_as(format("{:08}"sv, -42), "-0000042"));
+    SE_TEST_CHECK(is_formatted_as(format("{:5}"sv, 42), "   42"));
+    SE_TEST_CHECK(is_formatted_as(format("{:2}"sv, 12345), "12345"));
+    SE_TEST_CHECK(is_formatted_as(format("[{:6}]"sv, "ab"sv), "[ab    ]"));
+    SE_TEST_CHECK(is_formatted_as(format("{}"sv, UUID(0xABC)), "0000000000000ABC"));
+
+    // The specifiers that don't apply to the argument are rejected.
+    SE_TEST_CHECK(!format("{:.2f}"sv, 1).has_value());
+    SE_TEST_CHECK(!format("{:08}"sv, "a"sv).has_value());
+
+    TestRandomGenerator random_generator = { 4 };
+    u32 failed_value_count = 0;
+    for (u32 value_index = 0; value_index < 1000000; ++value_index)
+    {
+        const u64 unsigned_value = random_generator.next() >> (random_generator.next() % 64);
+        const i64 signed_value = static_cast<i64>(random_generator.next()) >> (random_generator.next() % 64);
+
+        char buffer[64];
+        const Optional<StringView> formatted_string =
+            format_to(Span<char>(buffer, sizeof(buffer)), "{} {} {:x}"sv, unsigned_value, signed_value, unsigned_value);
+
+        char reference_buffer[64];
+        const int reference_byte_count = std::snprintf(
+            reference_buffer, sizeof(reference_buffer), "%llu %lld %llx", static_cast<unsigned long long>(unsigned_value), static_cast<long long>(signed_value),
+            static_cast<unsigned long long>(unsigned_value)
+        );
+
+        const StringView reference_string = StringView::create_from_utf8(reference_buffer, static_cast<usize>(reference_byte_count));
+        if (!formatted_string.has_value() || formatted_string.value() != reference_string)
+            ++failed_value_count;
+    }
+    SE_TEST_CHECK(failed_value_count == 0);
+}
+
+SE_TEST(format_round_trips_random_doubles)
+{
+    TestRandomGenerator random_generator = { 5 };
+    u32 failed_value_count = 0;
+    for (u32 value_index = 0; value_index < 1000000; ++value_index)
+    {
+        const double value = std::bit_cast<double>(random_generator.next());
+        if (!std::isfinite(value))
+            continue;
+
+        char buffer[64];
+        const Optional<StringView> formatted_string = format_to(Span<char>(buffer, sizeof(buffer)), "{}"sv, value);
+        double parsed_value;
+        if (!formatted_string.has_value() || !parse_floating_point(formatted_string.value(), parsed_value) ||
+            std::bit_cast<u64>(parsed_value) != std::bit_cast<u64>(value))
+        {
+            ++failed_value_count;
+        }
+    }
+    SE_TEST_CHECK(failed_value_count == 0);
+}
+
+//
+// Formats every positive finite float and checks that it is parsed back to exactly the same value. The values are
+// split between all the hardware threads, as there are more than two billion of them.
+//
+SE_EXHAUSTIVE_TEST(format_round_trips_every_float)
+{
+    struct RoundTripState
+    {
+        u32 thread_count;
+        u32 thread_index;
+        Atomic<u64>* failed_value_count;
+    };
+
+    const PFN_ThreadEntryPoint round_trip_floats = [](void* user_data)
+    {
+        const RoundTripState& state = *static_cast<const RoundTripState*>(user_data);
+        u64 failed_value_count = 0;
+
+        // NOTE: The positive finite floats are all the bit patterns below the one of the positive infinity.
+        for (u32 bits = 1 + state.thread_index; bits < 0x7F800000; bits += state.thread_count)
+        {
+            const float value = std::bit_cast<float>(bits);
+
+            char buffer[64];
+            const Optional<StringView> formatted_string = format_to(Span<char>(buffer, sizeof(buffer)), "{}"sv, value);
+            float parsed_value;
+            if (!formatted_string.has_value() || !parse_floating_point(formatted_string.value(), parsed_value) || std::bit_cast<u32>(parsed_value) != bits)
+                ++failed_value_count;
+        }
+
+        state.failed_value_count->fetch_add(failed_value_count);
+    };
+
+    constexpr u32 max_thread_count = 64;
+    const u32 thread_count = Math::clamp(Thread::get_hardware_concurrency(), 1U, max_thread_count);
+    Atomic<u64> failed_value_count;
+
+    RoundTripState states[max_thread_count];
+    Thread threads[max_thread_count];
+    for (u32 thread_index = 0; thread_index < thread_count; ++thread_index)
+    {
+        states[thread_index] = { thread_count, thread_index, &failed_value_count };
+        threads[thread_index].start(round_trip_floats, &states[thread_index], "RoundTripWorker"sv);
+    }
+    for (u32 thread_index = 0; thread_index < thread_count; ++thread_index)
+        threads[thread_index].join();
+
+    SE_TEST_CHECK(failed_value_count.load() == 0);
+}
+
+SE_BENCHMARK(format_integer_throughput)
+{
+    constexpr u32 value_count = 1 << 20;
+    constexpr u32 iteration_count = 4;
+    Vector<u64> values;
+    values.set_fixed_capacity(value_count);
+    TestRandomGenerator random_generator = { 6 };
+    for (u32 value_index = 0; value_index < value_count; ++value_index)
+        values.add(random_generator.next() >> (random_generator.next() % 64));
+
+    char buffer[256];
+    usize byte_count = 0;
+    const u64 operation_count = static_cast<u64>(value_count) * iteration_count;
+
+    u64 start_tick_counter = Platform::get_current_tick_counter();
+    for (u32 iteration_index = 0; iteration_index < iteration_count; ++iteration_index)
+    {
+        for (const u64 value : values)
+            byte_count += format_to(Span<char>(buffer, sizeof(buffer)), "{}"sv, value)->byte_count();
+    }
+    test_context.report_duration("format_to u64"sv, operation_count, Platform::get_current_tick_counter() - start_tick_counter);
+
+    start_tick_counter = Platform::get_current_tick_counter();
+    for (u32 iteration_index = 0; iteration_index < iteration_count; ++iteration_index)
+    {
+        for (const u64 value : values)
+            byte_count += format_to(Span<char>(buffer, sizeof(buffer)), "{}"sv, UUID(value))->byte_count();
+    }
+    test_context.report_duration("format_to UUID"sv, operation_count, Platform::get_current_tick_counter() - start_tick_counter);
+
+    // The C library is measured as the reference.
+    start_tick_counter = Platform::get_current_tick_counter();
+    for (u32 iteration_index = 0; iteration_index < iteration_count; ++iteration_index)
+    {
+        for (const u64 value : values)
+            byte_count += static_cast<usize>(std::snprintf(buffer, sizeof(buffer), "%llu", static_cast<unsigned long long>(value)));
+    }
+    test_context.report_duration("snprintf %llu"sv, operation_count, Platform::get_current_tick_counter() - start_tick_counter);
+
+    SE_TEST_CHECK(byte_count > 0);
+}
+
+SE_BENCHMARK(format_floating_point_throughput)
+{
+    constexpr u32 value_count = 1 << 20;
+    constexpr u32 iteration_count = 4;
+    Vector<double> values;
+    values.set_fixed_capacity(value_count);
+    TestRandomGenerator random_generator = { 7 };
+    for (u32 value_index = 0; value_index < value_count; ++value_index)
+        values.add(static_cast<double>(random_generator.next() % 2000000) / 997.0 - 1000.0);
+
+    char buffer[256];
+    usize byte_count = 0;
+    const u64 operation_count = static_cast<u64>(value_count) * iteration_count;
+
+    u64 start_tick_counter = Platform::get_current_tick_counter();
+    for (u32 iteration_index = 0; iteration_index < iteration_count; ++iteration_index)
+    {
+        for (const double value : values)
+            byte_count += format_to(Span<char>(buffer, sizeof(buffer)), "{}"sv, value)->byte_count();
+    }
+    test_context.report_duration("format_to double (shortest)"sv, operation_count, Platform::get_current_tick_counter() - start_tick_counter);
+
+    start_tick_counter = Platform::get_current_tick_counter();
+    for (u32 iteration_index = 0; iteration_index < iteration_count; ++iteration_index)
+    {
+        for (const double value : values)
+            byte_count += format_to(Span<char>(buffer, sizeof(buffer)), "{}"sv, static_cast<float>(value))->byte_count();
+    }
+    test_context.report_duration("format_to float (shortest)"sv, operation_count, Platform::get_current_tick_counter() - start_tick_counter);
+
+    start_tick_counter = Platform::get_current_tick_counter();
+    for (u32 iteration_index = 0; iteration_index < iteration_count; ++iteration_index)
+    {
+        for (const double value : values)
+            byte_count += format_to(Span<char>(buffer, sizeof(buffer)), "{:.3f}"sv, value)->byte_count();
+    }
+    test_context.report_duration("format_to double (.3f)"sv, operation_count, Platform::get_current_tick_counter() - start_tick_counter);
+
+    // The C library is measured as the reference. `%.17g` is what it takes for a double to round-trip.
+    start_tick_counter = Platform::get_current_tick_counter();
+    for (u32 iteration_index = 0; iteration_index < iteration_count; ++iteration_index)
+    {
+        for (const double value : values)
+            byte_count += static_cast<usize>(std::snprintf(buffer, sizeof(buffer), "%.17g", value));
+    }
+    test_context.report_duration("snprintf %.17g"sv, operation_count, Platform::get_current_tick_counter() - start_tick_counter);
+
+    start_tick_counter = Platform::get_current_tick_counter();
+    for (u32 iteration_index = 0; iteration_index < iteration_count; ++iteration_index)
+    {
+        for (const double value : values)
+            byte_count += static_cast<usize>(std::snprintf(buffer, sizeof(buffer), "%.3f", value));
+    }
+    test_context.report_duration("snprintf %.3f"sv, operation_count, Platform::get_current_tick_counter() - start_tick_counter);
+
+    SE_TEST_CHECK(byte_count > 0);
+}
+
+} // namespace SE
@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/String/Format.h>
+#include <TestFramework.h>
+#include <cstdio>
+#include <version>
+
+#if defined(__cpp_lib_format)
+    #include <format>
+#endif // defined(__cpp_lib_format)
+
+namespace SE
+{
+
+NODISCARD static StringView get_test_segment(const char* characters, const auto& segment)
+{
+    return StringView::unsafe_create_from_utf8(characters + segment.offset, segment.byte_count);
+}
+
+SE_TEST(format_string_splits_segments_at_compile_time)
+{
+    using TestFormatString = FormatString<u32, StringView, i32>;
+    constexpr TestFormatString string_format = "Entity {} ('{:8}') has {:08x} components."sv;
+    const char* characters = string_format.characters();
+    SE_TEST_CHECK(TestFormatString::argument_count == 3);
+
+    // The segments are the literal text before each argument, followed by the text after the last argument.
+    SE_TEST_CHECK(get_test_segment(characters, string_format.segment(0)) == "Entity "sv);
+    SE_TEST_CHECK(get_test_segment(characters, string_format.segment(1)) == " ('"sv);
+    SE_TEST_CHECK(get_test_segment(characters, string_format.segment(2)) == "') has "sv);
+    SE_TEST_CHECK(get_test_segment(characters, string_format.segment(3)) == " components."sv);
+
+    SE_TEST_CHECK(string_format.specifier(0).type == FormatBuilder::Specifier::Type::Default);
+    SE_TEST_CHECK(string_format.specifier(0).width == 0);
+    SE_TEST_CHECK(string_format.specifier(1).width == 8 && !string_format.specifier(1).zero_padding);
+    SE_TEST_CHECK(string_format.specifier(2).type == FormatBuilder::Specifier::Type::Hexadecimal);
+    SE_TEST_CHECK(string_format.specifier(2).width == 8 && string_format.specifier(2).zero_padding);
+
+    // Adjacent specifiers and specifiers at the ends of the string produce empty segments.
+    constexpr FormatString<u32, u32> adjacent_string_format = "{}{}"sv;
+    for (usize segment_index = 0; segment_index <= 2; ++segment_index)
+        SE_TEST_CHECK(adjacent_string_format.segment(segment_index).byte_count == 0);
+
+    // A string without specifiers is a single segment.
+    constexpr FormatString<> literal_string_format = "No arguments."sv;
+    SE_TEST_CHECK(get_test_segment(literal_string_format.characters(), literal_string_format.segment(0)) == "No arguments."sv);
+
+    const Optional<String> formatted_string = format("Entity {} ('{:8}') has {:08x} components."sv, 42u, "Camera"sv, 255);
+    SE_TEST_CHECK(formatted_string.has_value() && formatted_string.value() == "Entity 42 ('Camera  ') has 000000ff components."sv);
+}
+
+SE_TEST(format_fixed_builder_returns_an_empty_optional_when_truncated)
+{
+    char buffer[16];
+
+    // The formatted string fits exactly in the buffer.
+    const Optional<StringView> exact_string = format_to(Span<char>(buffer, 6), "{}-{}"sv, 12, 345);
+    SE_TEST_CHECK(exact_string.has_value() && exact_string.value() == "12-345"sv);
+
+    // One character too many, in the literal text or in an argument.
+    SE_TEST_CHECK(!format_to(Span<char>(buffer, 5), "{}-{}"sv, 12, 345).has_value());
+    SE_TEST_CHECK(!format_to(Span<char>(buffer, 6), "{}-{}!"sv, 12, 345).has_value());
+    SE_TEST_CHECK(!format_to(Span<char>(buffer, 4), "{}"sv, "Hello"sv).has_value());
+    SE_TEST_CHECK(!format_to(Span<char>(buffer, 0), "{}"sv, 1).has_value());
+    SE_TEST_CHECK(format_to(Span<char>(buffer, 0), ""sv).has_value());
+
+    // The builder keeps the characters that fit and counts the ones that were discarded.
+    FormatFixedBuilder builder = FormatFixedBuilder(Span<char>(buffer, 8));
+    SE_TEST_CHECK(format_to(builder, "{:x}{}"sv, 0xABCDEFu, "0123456789"sv) == FormatErrorCode::Success);
+    SE_TEST_CHECK(builder.view() == "abcdef01"sv);
+    SE_TEST_CHECK(builder.discarded_byte_count() == 8);
+}
+
+SE_TEST(format_memory_builder_moves_to_the_heap_when_full)
+{
+    FormatMemoryBuilder<16> builder;
+    const char* builder_begin = reinterpret_cast<const char*>(&builder);
+    const char* builder_end = builder_begin + sizeof(builder);
+    const auto is_stored_inline = [&]() -> bool { return builder_begin <= builder.view().characters() && builder.view().characters() < builder_end; };
+
+    // 16 characters fit in the inline buffer.
+    SE_TEST_CHECK(format_to(builder, "{}{}"sv, 12345678u, "abcdefgh"sv) == FormatErrorCode::Success);
+    SE_TEST_CHECK(builder.view() == "12345678abcdefgh"sv);
+    SE_TEST_CHECK(is_stored_inline());
+
+    // The 17th character moves the buffer to the heap, keeping the characters that were already written.
+    SE_TEST_CHECK(format_to(builder, "!"sv) == FormatErrorCode::Success);
+    SE_TEST_CHECK(builder.view() == "12345678abcdefgh!"sv);
+    SE_TEST_CHECK(!is_stored_inline());
+
+    // A string larger than the doubled capacity grows the buffer directly to the required size.
+    SE_TEST_CHECK(format_to(builder, "{:100}|"sv, "x"sv) == FormatErrorCode::Success);
+    SE_TEST_CHECK(builder.view().byte_count() == 17 + 101);
+    SE_TEST_CHECK(builder.view().slice(17, 2) == "x "sv && builder.view().slice(117) == "|"sv);
+    SE_TEST_CHECK(builder.discarded_byte_count() == 0);
+
+    // Clearing keeps the heap buffer.
+    const char* heap_buffer = builder.view().characters();
+    builder.clear();
+    SE_TEST_CHECK(format_to(builder, "{}"sv, 7) == FormatErrorCode::Success);
+    SE_TEST_CHECK(builder.view() == "7"sv && builder.view().characters() == heap_buffer);
+
+    const String released_string = builder.release_string();
+    SE_TEST_CHECK(released_string == "7"sv);
+}
+
+SE_BENCHMARK(format_message)
+{
+    constexpr u32 iteration_count = 2000000;
+    const StringView name = "PlayerController"sv;
+
+    // The length of the messages is accumulated, so the formatting can't be optimized away.
+    usize byte_count = 0;
+    u64 start_tick_counter = Platform::get_current_tick_counter();
+    for (u32 iteration_index = 0; iteration_index < iteration_count; ++iteration_index)
+    {
+        const Optional<String> message = format("Entity '{}' moved to ({}, {})."sv, name, iteration_index, 0.25F * static_cast<float>(iteration_index));
+        byte_count += message->byte_count();
+    }
+    test_context.report_duration("format() into a String"sv, iteration_count, Platform::get_current_tick_counter() - start_tick_counter);
+
+    start_tick_counter = Platform::get_current_tick_counter();
+    for (u32 iteration_index = 0; iteration_index < iteration_count; ++iteration_index)
+    {
+        FormatMemoryBuilder<128> builder;
+        MAYBE_UNUSED const FormatErrorCode error_code =
+            format_to(builder, "Entity '{}' moved to ({}, {})."sv, name, iteration_index, 0.25F * static_cast<float>(iteration_index));
+        byte_count += builder.view().byte_count();
+    }
+    test_context.report_duration("format_to() into a stack builder"sv, iteration_count, Platform::get_current_tick_counter() - start_tick_counter);
+
+    start_tick_counter = Platform::get_current_tick_counter();
+    for (u32 iteration_index = 0; iteration_index < iteration_count; ++iteration_index)
+    {
+        char buffer[128];
+        const int message_byte_count = std::snprintf(
+            buffer, sizeof(buffer), "Entity '%.*s' moved to (%u, %g).", static_cast<int>(name.byte_count()), name.characters(), iteration_index,
+            static_cast<double>(0.25F * static_cast<float>(iteration_index))
+        );
+        byte_count += static_cast<usize>(message_byte_count);
+    }
+    test_context.report_duration("snprintf() into a stack buffer"sv, iteration_count, Platform::get_current_tick_counter() - start_tick_counter);
+
+#if defined(__cpp_lib_format)
+    const std::string_view std_name = std::string_view(name.characters(), name.byte_count());
+    start_tick_counter = Platform::get_current_tick_counter();
+    for (u32 iteration_index = 0; iteration_index < iteration_count; ++iteration_index)
+    {
+        const std::string message = std::format("Entity '{}' moved to ({}, {}).", std_name, iteration_index, 0.25F * static_cast<float>(iteration_index));
+        byte_count += message.size();
+    }
+    test_context.report_duration("std::format() into a std::string"sv, iteration_count, Platform::get_current_tick_counter() - start_tick_counter);
+#else
+    SE_LOG_INFO("    std::format() is not available in this standard library.");
+#endif // defined(__cpp_lib_format)
+
+    SE_TEST_CHECK(byte_count > 0);
+}
+
+} // namespace SE
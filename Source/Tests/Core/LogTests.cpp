@@ -0,0 +1,344 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/Containers/Vector.h>
+#include <Core/Log.h>
+#include <Core/Math/MathCore.h>
+#include <Core/Platform/Atomic.h>
+#include <Core/Platform/Thread.h>
+#include <Core/String/NumberParsing.h>
+#include <Core/String/String.h>
+#include <TestFramework.h>
+
+namespace SE
+{
+
+//
+// The messages logged by the producer threads of the tests contain the index of the thread and the index of the message
+// in the sequence of that thread, at fixed offsets, so the sink can tell who logged each message and in which order.
+//
+static constexpr u32 s_test_max_producer_count = 16;
+
+NODISCARD static Name get_test_log_tag()
+{
+    static const Name s_test_log_tag = "LogTests"sv;
+    return s_test_log_tag;
+}
+
+static void log_test_message(u32 producer_index, u32 sequence_index)
+{
+    Logger::log_tagged_message(Logger::Severity::Info, get_test_log_tag(), "{:02} {:08} Entity moved to a new position."sv, producer_index, sequence_index);
+}
+
+NODISCARD static bool parse_test_message(StringView message, u32& out_producer_index, u32& out_sequence_index)
+{
+    return message.byte_count() > 11 && parse_integer(message.slice(0, 2), out_producer_index) && parse_integer(message.slice(3, 8), out_sequence_index) &&
+           out_producer_index < s_test_max_producer_count;
+}
+
+//
+// Captures the messages that are written by the logger thread. The captured messages can only be read after the logger
+// is flushed or shut down, while the message counts can be read at any time.
+//
+class TestLogSink final : public LogSink
+{
+public:
+    struct CapturedMessage
+    {
+        Logger::Severity::Type severity;
+        Name tag;
+        String message;
+        u64 thread_id;
+    };
+
+public:
+    virtual void write(const LogMessage& message) override
+    {
+        m_messages.add({ message.severity, message.tag, String(message.message), message.thread_id });
+
+        u32 producer_index;
+        u32 sequence_index;
+        if (message.tag == get_test_log_tag() && parse_test_message(message.message, producer_index, sequence_index))
+            m_producer_message_counts[producer_index].fetch_add(1);
+    }
+
+    virtual void flush() override { m_flush_count.fetch_add(1); }
+
+    NODISCARD ALWAYS_INLINE const Vector<CapturedMessage>& messages() const { return m_messages; }
+    NODISCARD ALWAYS_INLINE u32 get_producer_message_count(u32 producer_index) const { return m_producer_message_counts[producer_index].load(); }
+    NODISCARD ALWAYS_INLINE u32 get_flush_count() const { return m_flush_count.load(); }
+
+private:
+    Vector<CapturedMessage> m_messages;
+    Atomic<u32> m_producer_message_counts[s_test_max_producer_count];
+    Atomic<u32> m_flush_count;
+};
+
+// Sums the counts reported by the warnings that the logger thread writes when messages were dropped.
+NODISCARD static u64 get_reported_dropped_message_count(const TestLogSink& sink)
+{
+    u64 reported_dropped_message_count = 0;
+    for (const TestLogSink::CapturedMessage& captured_message : sink.messages())
+    {
+        const StringView message = captured_message.message.view();
+        const StringView suffix = " messages were dropped because the log buffers were full!"sv;
+        if (captured_message.severity != Logger::Severity::Warn || message.byte_count() <= suffix.byte_count())
+            continue;
+
+        u64 dropped_message_count;
+        const usize count_byte_count = message.byte_count() - suffix.byte_count();
+        if (message.slice(count_byte_count) == suffix && parse_integer(message.slice(0, count_byte_count), dropped_message_count))
+            reported_dropped_message_count += dropped_message_count;
+    }
+    return reported_dropped_message_count;
+}
+
+SE_TEST(logger_delivers_or_counts_the_messages_of_multiple_producers)
+{
+    struct ProducerState
+    {
+        u32 producer_index;
+        u32 message_count;
+        u64 thread_id;
+    };
+
+    const PFN_ThreadEntryPoint log_messages = [](void* user_data)
+    {
+        ProducerState& state = *static_cast<ProducerState*>(user_data);
+        state.thread_id = Thread::get_current_thread_id();
+        for (u32 sequence_index = 0; sequence_index < state.message_count; ++sequence_index)
+            log_test_message(state.producer_index, sequence_index);
+    };
+
+    // The producers log many more messages than the queue can hold, so some of them are most likely dropped.
+    constexpr u32 producer_count = 8;
+    constexpr u32 message_count = 20000;
+    if (!SE_TEST_CHECK(Logger::initialize()))
+        return;
+    TestLogSink sink;
+    Logger::add_sink(&sink);
+
+    ProducerState states[producer_count];
+    Thread threads[producer_count];
+    for (u32 producer_index = 0; producer_index < producer_count; ++producer_index)
+    {
+        states[producer_index] = { producer_index, message_count, 0 };
+        threads[producer_index].start(log_messages, &states[producer_index], "LogProducer"sv);
+    }
+    for (u32 producer_index = 0; producer_index < producer_count; ++producer_index)
+        threads[producer_index].join();
+
+    const u64 dropped_message_count = Logger::get_dropped_message_count();
+    Logger::shutdown();
+
+    // Every message is either written to the sink or counted as dropped, and the drops are reported by the logger thread.
+    u64 delivered_message_count = 0;
+    for (u32 producer_index = 0; producer_index < producer_count; ++producer_index)
+        delivered_message_count += sink.get_producer_message_count(producer_index);
+    SE_TEST_CHECK(delivered_message_count + dropped_message_count == u64(producer_count) * message_count);
+    SE_TEST_CHECK(get_reported_dropped_message_count(sink) == dropped_message_count);
+
+    // The messages of each producer are written in the order in which they were logged, and keep the ID of their thread.
+    u32 next_sequence_indices[producer_count] = {};
+    bool are_messages_ordered = true;
+    bool are_thread_ids_correct = true;
+    for (const TestLogSink::CapturedMessage& captured_message : sink.messages())
+    {
+        u32 producer_index;
+        u32 sequence_index;
+        if (captured_message.tag != get_test_log_tag() || !parse_test_message(captured_message.message.view(), producer_index, sequence_index))
+            continue;
+
+        are_messages_ordered &= (sequence_index >= next_sequence_indices[producer_index]);
+        are_thread_ids_correct &= (captured_message.thread_id == states[producer_index].thread_id);
+        next_sequence_indices[producer_index] = sequence_index + 1;
+    }
+    SE_TEST_CHECK(are_messages_ordered);
+    SE_TEST_CHECK(are_thread_ids_correct);
+}
+
+SE_TEST(logger_moves_long_messages_to_the_heap)
+{
+    if (!SE_TEST_CHECK(Logger::initialize()))
+        return;
+    TestLogSink sink;
+    Logger::add_sink(&sink);
+
+    // The inline capacity of a record is 200 bytes, so the messages around it and much longer ones are logged.
+    const usize byte_counts[] = { 0, 1, 199, 200, 201, 256, 1000, 64 * KiB };
+    Vector<String> messages;
+    TestRandomGenerator random_generator = { 5 };
+    for (const usize byte_count : byte_counts)
+    {
+        String message;
+        for (usize byte_index = 0; byte_index < byte_count; ++byte_index)
+        {
+            const char character = static_cast<char>('a' + random_generator.next() % 26);
+            message.append(StringView::unsafe_create_from_utf8(&character, 1));
+        }
+        Logger::log_tagged_message(Logger::Severity::Warn, get_test_log_tag(), message.view());
+        messages.add(move(message));
+    }
+
+    Logger::shutdown();
+
+    if (SE_TEST_CHECK(sink.messages().count() == messages.count()))
+    {
+        for (usize message_index = 0; message_index < messages.count(); ++message_index)
+        {
+            const TestLogSink::CapturedMessage& captured_message = sink.messages()[message_index];
+            SE_TEST_CHECK(captured_message.message == messages[message_index].view());
+            SE_TEST_CHECK(captured_message.severity == Logger::Severity::Warn && captured_message.tag == get_test_log_tag());
+        }
+    }
+}
+
+SE_TEST(logger_flush_waits_for_the_messages_logged_before_it)
+{
+    struct ProducerState
+    {
+        TestLogSink* sink;
+        u32 producer_index;
+        u32 failed_flush_count;
+    };
+
+    //
+    // Each producer waits for its own messages after every batch. The other producers request flushes concurrently, so
+    // a flush can be completed by the ticket of another thread only if it covers the messages of this one.
+    // NOTE: Fewer messages than the capacity of the queue are logged in total, so no message is dropped.
+    //
+    constexpr u32 producer_count = 4;
+    constexpr u32 batch_count = 4;
+    constexpr u32 batch_message_count = 200;
+    const PFN_ThreadEntryPoint log_and_flush_messages = [](void* user_data)
+    {
+        ProducerState& state = *static_cast<ProducerState*>(user_data);
+        for (u32 batch_index = 0; batch_index < batch_count; ++batch_index)
+        {
+            for (u32 message_index = 0; message_index < batch_message_count; ++message_index)
+                log_test_message(state.producer_index, batch_index * batch_message_count + message_index);
+
+            Logger::flush();
+            if (state.sink->get_producer_message_count(state.producer_index) != (batch_index + 1) * batch_message_count)
+                ++state.failed_flush_count;
+        }
+    };
+
+    if (!SE_TEST_CHECK(Logger::initialize()))
+        return;
+    TestLogSink sink;
+    Logger::add_sink(&sink);
+
+    ProducerState states[producer_count];
+    Thread threads[producer_count];
+    for (u32 producer_index = 0; producer_index < producer_count; ++producer_index)
+    {
+        states[producer_index] = { &sink, producer_index, 0 };
+        threads[producer_index].start(log_and_flush_messages, &states[producer_index], "LogProducer"sv);
+    }
+    for (u32 producer_index = 0; producer_index < producer_count; ++producer_index)
+        threads[producer_index].join();
+
+    // A flush without any new message completes immediately, and the sinks have been flushed after the messages were written.
+    Logger::flush();
+    const u32 flush_count = sink.get_flush_count();
+    const u64 dropped_message_count = Logger::get_dropped_message_count();
+    Logger::shutdown();
+
+    for (u32 producer_index = 0; producer_index < producer_count; ++producer_index)
+        SE_TEST_CHECK(states[producer_index].failed_flush_count == 0);
+    SE_TEST_CHECK(dropped_message_count == 0);
+    SE_TEST_CHECK(flush_count > 0);
+}
+
+SE_TEST(logger_shutdown_writes_the_remaining_messages)
+{
+    constexpr u32 message_count = 3000;
+
+    // The logger is initialized again after it was shut down, so the records and the thread are created from scratch.
+    for (u32 initialization_index = 0; initialization_index < 2; ++initialization_index)
+    {
+        if (!SE_TEST_CHECK(Logger::initialize()))
+            return;
+        TestLogSink sink;
+        Logger::add_sink(&sink);
+
+        // Fewer messages than the capacity of the queue are logged, so none of them can be dropped. The logger is shut down
+        // without being flushed, probably while most of the messages are still in the queue.
+        for (u32 sequence_index = 0; sequence_index < message_count; ++sequence_index)
+            log_test_message(initialization_index, sequence_index);
+        Logger::shutdown();
+
+        SE_TEST_CHECK(sink.get_producer_message_count(initialization_index) == message_count);
+        SE_TEST_CHECK(sink.messages().count() == message_count);
+        for (u32 sequence_index = 0; sequence_index < Math::min<usize>(message_count, sink.messages().count()); ++sequence_index)
+        {
+            u32 producer_index;
+            u32 captured_sequence_index;
+            const bool is_parsed = parse_test_message(sink.messages()[sequence_index].message.view(), producer_index, captured_sequence_index);
+            if (!SE_TEST_CHECK(is_parsed && producer_index == initialization_index && captured_sequence_index == sequence_index))
+                break;
+        }
+    }
+}
+
+SE_BENCHMARK(logger_producer_cost)
+{
+    // Only counts the messages, so the logger thread keeps up with the producer as much as possible.
+    class CountingLogSink final : public LogSink
+    {
+    public:
+        virtual void write(const LogMessage&) override { ++message_count; }
+        u64 message_count { 0 };
+    };
+
+    //
+    // The messages are logged in batches that fit in the queue, and the logger is flushed between the batches (outside
+    // of the measurement), so the cost of the producer is measured without dropping messages.
+    // The target is less than 100 ns for a short formatted message.
+    //
+    constexpr u32 batch_count = 500;
+    constexpr u32 batch_message_count = 2048;
+    if (!SE_TEST_CHECK(Logger::initialize()))
+        return;
+    CountingLogSink sink;
+    Logger::add_sink(&sink);
+
+    const auto measure = [&](auto log_function) -> u64
+    {
+        u64 elapsed_ticks = 0;
+        for (u32 batch_index = 0; batch_index < batch_count; ++batch_index)
+        {
+            const u64 start_tick_counter = Platform::get_current_tick_counter();
+            for (u32 message_index = 0; message_index < batch_message_count; ++message_index)
+                log_function(message_index);
+            elapsed_ticks += Platform::get_current_tick_counter() - start_tick_counter;
+            Logger::flush();
+        }
+        return elapsed_ticks;
+    };
+
+    const u64 formatted_ticks = measure([](u32 message_index)
+                                        { Logger::log_message(Logger::Severity::Info, "Entity {} moved to ({}, {})."sv, message_index, 1.5F, -2.25F); });
+    const u64 short_ticks = measure([](u32) { Logger::log_message(Logger::Severity::Info, "Entity moved to a new position."sv); });
+
+    String long_message;
+    for (u32 character_index = 0; character_index < 300; ++character_index)
+        long_message.append("x"sv);
+    const u64 long_ticks = measure([&long_message](u32) { Logger::log_message(Logger::Severity::Info, long_message.view()); });
+
+    const u64 dropped_message_count = Logger::get_dropped_message_count();
+    Logger::shutdown();
+
+    // NOTE: The measurements are reported after the logger is shut down, so they are written to the console directly.
+    constexpr u64 operation_count = u64(batch_count) * batch_message_count;
+    test_context.report_duration("log_message() formatting three arguments"sv, operation_count, formatted_ticks);
+    test_context.report_duration("log_message() with a short string"sv, operation_count, short_ticks);
+    test_context.report_duration("log_message() with a 300-byte string (heap)"sv, operation_count, long_ticks);
+    SE_LOG_INFO("    {} messages written, {} dropped", sink.message_count, dropped_message_count);
+    SE_TEST_CHECK(sink.message_count + dropped_message_count == 3 * operation_count);
+}
+
+} // namespace SE
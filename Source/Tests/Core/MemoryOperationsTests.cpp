@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/Containers/Vector.h>
+#include <Core/Memory/MemoryOperations.h>
+#include <TestFramework.h>
+#include <cstring>
+
+namespace SE
+{
+
+// The byte-at-a-time searches, which are the reference the block searches are checked against.
+NODISCARD static usize find_byte_reference(ReadonlyBytes bytes, ReadonlyByte byte_value, usize byte_count)
+{
+    for (usize byte_offset = 0; byte_offset < byte_count; ++byte_offset)
+    {
+        if (bytes[byte_offset] == byte_value)
+            return byte_offset;
+    }
+    return invalid_size;
+}
+
+NODISCARD static usize find_last_byte_reference(ReadonlyBytes bytes, ReadonlyByte byte_value, usize byte_count)
+{
+    for (usize end_offset = byte_count; end_offset > 0; --end_offset)
+    {
+        if (bytes[end_offset - 1] == byte_value)
+            return end_offset - 1;
+    }
+    return invalid_size;
+}
+
+SE_TEST(find_byte_matches_scalar_reference)
+{
+    // The searched value surrounds the searched bytes, so a match found outside of them would produce a wrong result.
+    alignas(32) ReadWriteByte buffer[32 + 320 + 32];
+    TestRandomGenerator random_generator = { 11 };
+
+    u32 mismatch_count = 0;
+    u32 not_found_count = 0;
+    for (u32 iteration_index = 0; iteration_index < 200000; ++iteration_index)
+    {
+        const usize byte_offset = 32 + random_generator.next() % 32;
+        const usize byte_count = random_generator.next() % 321;
+        const ReadWriteByte byte_value = static_cast<ReadWriteByte>(random_generator.next());
+
+        // The fewer the distinct values, the more matches there are (from none at all to one in two bytes).
+        constexpr u32 distinct_value_counts[4] = { 2, 16, 256, 0 };
+        const u32 distinct_value_count = distinct_value_counts[iteration_index % 4];
+
+        set_memory(buffer, byte_value, sizeof(buffer));
+        for (usize byte_index = 0; byte_index < byte_count; ++byte_index)
+        {
+            ReadWriteByte random_byte = static_cast<ReadWriteByte>(byte_value + 1);
+            if (distinct_value_count > 0)
+                random_byte = static_cast<ReadWriteByte>(byte_value + random_generator.next() % distinct_value_count);
+            buffer[byte_offset + byte_index] = random_byte;
+        }
+
+        const usize reference_first_offset = find_byte_reference(buffer + byte_offset, byte_value, byte_count);
+        const usize reference_last_offset = find_last_byte_reference(buffer + byte_offset, byte_value, byte_count);
+        if (find_byte(buffer + byte_offset, byte_value, byte_count) != reference_first_offset)
+            ++mismatch_count;
+        if (find_last_byte(buffer + byte_offset, byte_value, byte_count) != reference_last_offset)
+            ++mismatch_count;
+        if (reference_first_offset == invalid_size)
+            ++not_found_count;
+    }
+
+    SE_TEST_CHECK(mismatch_count == 0);
+    // Both present and missing values must have been searched.
+    SE_TEST_CHECK(not_found_count > 50000 && not_found_count < 150000);
+}
+
+SE_BENCHMARK(find_byte_throughput)
+{
+    constexpr usize byte_count = 16 * MiB;
+    constexpr u32 iteration_count = 16;
+    constexpr u64 processed_byte_count = static_cast<u64>(byte_count) * iteration_count;
+
+    // The value is only found at the opposite end of each search (the first byte is skipped by the forward searches and
+    // the last byte by the backward searches), so all the bytes are compared.
+    Vector<ReadWriteByte> bytes = Vector<ReadWriteByte>::create_filled(byte_count, 'a');
+    bytes[0] = '/';
+    bytes[byte_count - 1] = '/';
+
+    usize checksum = 0;
+    const auto measure = [&](StringView measurement_name, auto function)
+    {
+        // NOTE: The bytes are read through a volatile pointer, otherwise the compiler could execute a function that has
+        //       no side effects only once for all the iterations.
+        ReadonlyBytes volatile volatile_bytes = bytes.elements();
+        const u64 start_tick_counter = Platform::get_current_tick_counter();
+        // Every other search skips one more byte, so the searches alternate between aligned and unaligned blocks.
+        for (u32 iteration_index = 0; iteration_index < iteration_count; ++iteration_index)
+            checksum += function(volatile_bytes, iteration_index % 2);
+        test_context.report_throughput(measurement_name, processed_byte_count, Platform::get_current_tick_counter() - start_tick_counter);
+    };
+
+    measure("find_byte"sv, [](ReadonlyBytes elements, usize skip) { return find_byte(elements + 1 + skip, '/', byte_count - 1 - skip); });
+    measure(
+        "find_byte scalar reference"sv,
+        [](ReadonlyBytes elements, usize skip) { return find_byte_reference(elements + 1 + skip, '/', byte_count - 1 - skip); }
+    );
+    measure(
+        "memchr"sv,
+        [](ReadonlyBytes elements, usize skip) { return static_cast<usize>(std::memchr(elements + 1 + skip, '/', byte_count - 1 - skip) != nullptr); }
+    );
+    measure("find_last_byte"sv, [](ReadonlyBytes elements, usize skip) { return find_last_byte(elements, '/', byte_count - 1 - skip); });
+    measure(
+        "find_last_byte scalar reference"sv,
+        [](ReadonlyBytes elements, usize skip) { return find_last_byte_reference(elements, '/', byte_count - 1 - skip); }
+    );
+
+    SE_TEST_CHECK(checksum > 0);
+}
+
+} // namespace SE
@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/Containers/Vector.h>
+#include <Core/Platform/Thread.h>
+#include <Core/String/Format.h>
+#include <Core/String/Name.h>
+#include <Core/String/NameTable.h>
+#include <Core/String/String.h>
+#include <TestFramework.h>
+
+namespace SE
+{
+
+NODISCARD static String create_test_name_string(u32 index)
+{
+    return format("SE-Tests-Name-{}"sv, index).value();
+}
+
+// Checks that the entry stores exactly the given string, followed by a null-terminator.
+NODISCARD static bool is_entry_string(const NameEntry& entry, StringView string)
+{
+    return StringView::unsafe_create_from_utf8(entry.characters, entry.byte_count) == string && entry.characters[entry.byte_count] == 0;
+}
+
+SE_TEST(name_interns_equal_strings_to_the_same_index)
+{
+    const String first_string = "SE-Tests-Name-Equal"sv;
+    const String second_string = "SE-Tests-Name-Equal"sv;
+    SE_TEST_CHECK(first_string.characters() != second_string.characters());
+
+    // Strings with the same characters are the same name, regardless of where their characters are stored.
+    const Name first_name = first_string.view();
+    const Name second_name = second_string.view();
+    SE_TEST_CHECK(first_name == second_name && first_name.index() == second_name.index());
+    SE_TEST_CHECK(first_name.view() == first_string.view() && first_name.characters()[first_string.byte_count()] == 0);
+    SE_TEST_CHECK(first_name != Name("SE-Tests-Name-Equal2"sv) && first_name != Name("SE-Tests-Name-Equa"sv));
+
+    // The empty string is always the default constructed name.
+    SE_TEST_CHECK(Name(""sv) == Name() && Name(""sv).index() == 0 && Name().is_empty() && Name().view().is_empty());
+    SE_TEST_CHECK(!first_name.is_empty());
+}
+
+SE_TEST(name_table_chains_strings_with_the_same_hash)
+{
+    // Every string has one of four hashes, so the strings form long chains.
+    NameTable table = NameTable([](StringView string) -> u64 { return string.byte_count() % 4; });
+    constexpr u32 string_count = 1000;
+
+    Vector<u32> entry_indices;
+    for (u32 string_index = 0; string_index < string_count; ++string_index)
+        entry_indices.add(table.find_or_add(create_test_name_string(string_index).view()));
+    SE_TEST_CHECK(table.get_entry_count() == string_count + 1);
+
+    // Every string is found in its chain, whether it was added first or last, and adding it again doesn't create an entry.
+    for (u32 string_index = 0; string_index < string_count; ++string_index)
+    {
+        const String string = create_test_name_string(string_index);
+        const Optional<u32> entry_index = table.find(string.view());
+        SE_TEST_CHECK(entry_index.has_value() && entry_index.value() == entry_indices[string_index]);
+        SE_TEST_CHECK(table.find_or_add(string.view()) == entry_indices[string_index]);
+        SE_TEST_CHECK(is_entry_string(table.get_entry(entry_indices[string_index]), string.view()));
+    }
+    SE_TEST_CHECK(table.get_entry_count() == string_count + 1);
+
+    // A string that has the same hash as the others but different characters is not found.
+    SE_TEST_CHECK(!table.find("SE-Tests-Name-X"sv).has_value());
+}
+
+SE_TEST(name_find_doesnt_add_the_string)
+{
+    NameTable table;
+    SE_TEST_CHECK(!table.find("Unknown"sv).has_value());
+    SE_TEST_CHECK(!table.find("Unknown"sv).has_value());
+    SE_TEST_CHECK(table.get_entry_count() == 1);
+
+    // The empty string is always found, as the entry with index zero.
+    const Optional<u32> empty_entry_index = table.find(""sv);
+    SE_TEST_CHECK(empty_entry_index.has_value() && empty_entry_index.value() == 0);
+
+    const u32 entry_index = table.find_or_add("Unknown"sv);
+    const Optional<u32> found_entry_index = table.find("Unknown"sv);
+    SE_TEST_CHECK(found_entry_index.has_value() && found_entry_index.value() == entry_index && table.get_entry_count() == 2);
+
+    // The same through the names, which use the global table.
+    const StringView unique_string = "SE-Tests-Name-Find-Only"sv;
+    SE_TEST_CHECK(!Name::find(unique_string).has_value());
+    SE_TEST_CHECK(!Name::find(unique_string).has_value());
+    const Name name = unique_string;
+    const Optional<Name> found_name = Name::find(unique_string);
+    SE_TEST_CHECK(found_name.has_value() && found_name.value() == name);
+}
+
+SE_TEST(name_table_stores_large_strings_in_their_own_allocation)
+{
+    constexpr usize block_byte_count = NameTable::character_block_byte_count;
+    NameTable table;
+
+    // The strings around the limit, and one that is larger than a whole block.
+    const usize large_byte_counts[] = { block_byte_count / 4 - 1, block_byte_count / 4, block_byte_count + 1 };
+    for (const usize large_byte_count : large_byte_counts)
+    {
+        String large_string;
+        for (usize byte_index = 0; byte_index < large_byte_count; ++byte_index)
+            large_string.append(StringView::unsafe_create_from_utf8(&"abcdefghijklmnopqrstuvwxyz"[byte_index % 26], 1));
+
+        const u32 before_index = table.find_or_add(format("Before-{}"sv, large_byte_count)->view());
+        const u32 large_index = table.find_or_add(large_string.view());
+        const u32 after_index = table.find_or_add(format("After-{}"sv, large_byte_count)->view());
+        SE_TEST_CHECK(is_entry_string(table.get_entry(large_index), large_string.view()));
+        SE_TEST_CHECK(table.find_or_add(large_string.view()) == large_index);
+
+        // A string that gets its own allocation doesn't use the current block, so the small strings around it are adjacent.
+        // NOTE: The string that fits in a block (with its null-terminator) is copied to it, unless the block is full.
+        const NameEntry& before_entry = table.get_entry(before_index);
+        const bool is_after_adjacent = (table.get_entry(after_index).characters == before_entry.characters + before_entry.byte_count + 1);
+        SE_TEST_CHECK(is_after_adjacent == (large_byte_count + 1 > block_byte_count / 4));
+    }
+
+    // Filling a block continues in a new one, and the strings of the previous block are kept.
+    Vector<u32> entry_indices;
+    for (u32 string_index = 0; string_index < 2 * block_byte_count / 16; ++string_index)
+        entry_indices.add(table.find_or_add(create_test_name_string(string_index).view()));
+    for (u32 string_index = 0; string_index < entry_indices.count(); ++string_index)
+        SE_TEST_CHECK(is_entry_string(table.get_entry(entry_indices[string_index]), create_test_name_string(string_index).view()));
+}
+
+SE_TEST(name_table_interns_strings_concurrently)
+{
+    struct InternState
+    {
+        NameTable* table;
+        u32 thread_index;
+        Vector<u32> entry_indices;
+    };
+
+    //
+    // All the threads intern the same strings, each starting at a different offset, so the threads race to add each string.
+    // Each string must be added only once, and all the threads must get the same index for it.
+    //
+    constexpr u32 thread_count = 8;
+    constexpr u32 string_count = 10000;
+    const PFN_ThreadEntryPoint intern_strings = [](void* user_data)
+    {
+        InternState& state = *static_cast<InternState*>(user_data);
+        state.entry_indices = Vector<u32>::create_filled(string_count, 0);
+        for (u32 iteration_index = 0; iteration_index < string_count; ++iteration_index)
+        {
+            const u32 string_index = (iteration_index + state.thread_index * (string_count / thread_count)) % string_count;
+            state.entry_indices[string_index] = state.table->find_or_add(create_test_name_string(string_index).view());
+        }
+    };
+
+    NameTable table;
+    InternState states[thread_count];
+    Thread threads[thread_count];
+    for (u32 thread_index = 0; thread_index < thread_count; ++thread_index)
+    {
+        states[thread_index].table = &table;
+        states[thread_index].thread_index = thread_index;
+        threads[thread_index].start(intern_strings, &states[thread_index], "NameInterner"sv);
+    }
+    for (u32 thread_index = 0; thread_index < thread_count; ++thread_index)
+        threads[thread_index].join();
+
+    SE_TEST_CHECK(table.get_entry_count() == string_count + 1);
+    bool are_indices_equal = true;
+    bool are_entries_valid = true;
+    for (u32 string_index = 0; string_index < string_count; ++string_index)
+    {
+        const u32 entry_index = states[0].entry_indices[string_index];
+        for (u32 thread_index = 1; thread_index < thread_count; ++thread_index)
+            are_indices_equal &= (states[thread_index].entry_indices[string_index] == entry_index);
+        are_entries_valid &= is_entry_string(table.get_entry(entry_index), create_test_name_string(string_index).view());
+    }
+    SE_TEST_CHECK(are_indices_equal);
+    SE_TEST_CHECK(are_entries_valid);
+}
+
+} // namespace SE
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/String/NumberParsing.h>
+#include <TestFramework.h>
+#include <bit>
+
+namespace SE
+{
+
+SE_TEST(number_parsing_parses_integers_in_range)
+{
+    u8 u8_value = 0;
+    SE_TEST_CHECK(parse_integer("255"sv, u8_value) && u8_value == 255);
+    SE_TEST_CHECK(!parse_integer("256"sv, u8_value) && u8_value == 255);
+
+    i8 i8_value = 0;
+    SE_TEST_CHECK(parse_integer("-128"sv, i8_value) && i8_value == -128);
+    SE_TEST_CHECK(parse_integer("+127"sv, i8_value) && i8_value == 127);
+    SE_TEST_CHECK(!parse_integer("128"sv, i8_value));
+    SE_TEST_CHECK(!parse_integer("-129"sv, i8_value));
+
+    u64 u64_value = 0;
+    SE_TEST_CHECK(parse_integer("18446744073709551615"sv, u64_value) && u64_value == 0xFFFFFFFFFFFFFFFF);
+    SE_TEST_CHECK(!parse_integer("18446744073709551616"sv, u64_value));
+    SE_TEST_CHECK(!parse_integer("-1"sv, u64_value));
+
+    i64 i64_value = 0;
+    SE_TEST_CHECK(parse_integer("-9223372036854775808"sv, i64_value) && i64_value == static_cast<i64>(0x8000000000000000));
+    SE_TEST_CHECK(parse_integer("9223372036854775807"sv, i64_value) && i64_value == 0x7FFFFFFFFFFFFFFF);
+    SE_TEST_CHECK(!parse_integer("9223372036854775808"sv, i64_value));
+    SE_TEST_CHECK(parse_integer("-0"sv, i64_value) && i64_value == 0);
+}
+
+SE_TEST(number_parsing_rejects_invalid_integers)
+{
+    i32 value = 7;
+    SE_TEST_CHECK(!parse_integer(""sv, value));
+    SE_TEST_CHECK(!parse_integer("-"sv, value));
+    SE_TEST_CHECK(!parse_integer("+-1"sv, value));
+    SE_TEST_CHECK(!parse_integer(" 1"sv, value));
+    SE_TEST_CHECK(!parse_integer("1 "sv, value));
+    SE_TEST_CHECK(!parse_integer("12a"sv, value));
+    SE_TEST_CHECK(!parse_integer("1.0"sv, value));
+    SE_TEST_CHECK(value == 7);
+}
+
+SE_TEST(number_parsing_parses_integers_in_other_bases)
+{
+    u64 value = 0;
+    SE_TEST_CHECK(parse_integer("00A3F29B0C4D5E6F"sv, value, 16) && value == 0x00A3F29B0C4D5E6F);
+    SE_TEST_CHECK(parse_integer("ffffffffffffffff"sv, value, 16) && value == 0xFFFFFFFFFFFFFFFF);
+    SE_TEST_CHECK(!parse_integer("1ffffffffffffffff"sv, value, 16));
+    SE_TEST_CHECK(parse_integer("101"sv, value, 2) && value == 5);
+    SE_TEST_CHECK(!parse_integer("102"sv, value, 2));
+}
+
+SE_TEST(number_parsing_parses_floating_point_values)
+{
+    float float_value = 0.0F;
+    SE_TEST_CHECK(parse_floating_point("0.1"sv, float_value) && float_value == 0.1F);
+    SE_TEST_CHECK(parse_floating_point("-2.5e3"sv, float_value) && float_value == -2500.0F);
+    SE_TEST_CHECK(parse_floating_point("+.5"sv, float_value) && float_value == 0.5F);
+    SE_TEST_CHECK(parse_floating_point("3"sv, float_value) && float_value == 3.0F);
+    SE_TEST_CHECK(parse_floating_point("1e-45"sv, float_value) && std::bit_cast<u32>(float_value) == 1);
+    SE_TEST_CHECK(!parse_floating_point("1e39"sv, float_value));
+
+    double double_value = 0.0;
+    SE_TEST_CHECK(parse_floating_point("1.7976931348623157e308"sv, double_value) && std::bit_cast<u64>(double_value) == 0x7FEFFFFFFFFFFFFF);
+    SE_TEST_CHECK(parse_floating_point("-0"sv, double_value) && std::bit_cast<u64>(double_value) == 0x8000000000000000);
+
+    // The special values aren't numbers, and their spelling is decided by the format being parsed.
+    double_value = 1.0;
+    SE_TEST_CHECK(!parse_floating_point(""sv, double_value));
+    SE_TEST_CHECK(!parse_floating_point("inf"sv, double_value));
+    SE_TEST_CHECK(!parse_floating_point("-nan"sv, double_value));
+    SE_TEST_CHECK(!parse_floating_point("+-1"sv, double_value));
+    SE_TEST_CHECK(!parse_floating_point("1.0f"sv, double_value));
+    SE_TEST_CHECK(!parse_floating_point(" 1.0"sv, double_value));
+    SE_TEST_CHECK(double_value == 1.0);
+}
+
+} // namespace SE
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/String/Format.h>
+#include <Core/String/String.h>
+#include <Core/String/StringBuilder.h>
+#include <TestFramework.h>
+
+namespace SE
+{
+
+static constexpr StringView s_test_characters = "abcdefghijklmnopqrstuvwxyz0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ"sv;
+
+SE_TEST(string_builder_append_path_collapses_delimiters)
+{
+    // Repeated delimiters and backslashes, inside a component and between components, become a single forward slash.
+    StringBuilder builder;
+    builder.append_path("Content//Textures\\\\Player"sv);
+    SE_TEST_CHECK(builder.view() == "Content/Textures/Player"sv);
+    builder.append_path("\\/Idle.png"sv);
+    SE_TEST_CHECK(builder.view() == "Content/Textures/Player/Idle.png"sv);
+
+    // A delimiter is inserted between components that don't have one.
+    builder.clear();
+    builder.append_path("Content"sv).append_path("Textures"sv);
+    SE_TEST_CHECK(builder.view() == "Content/Textures"sv);
+
+    // A trailing delimiter is kept, and the next component doesn't add another one.
+    builder.clear();
+    builder.append_path("Content\\\\"sv);
+    SE_TEST_CHECK(builder.view() == "Content/"sv);
+    builder.append_path("//Textures"sv);
+    SE_TEST_CHECK(builder.view() == "Content/Textures"sv);
+
+    // An empty component appends nothing, not even a delimiter.
+    builder.append_path(""sv);
+    SE_TEST_CHECK(builder.view() == "Content/Textures"sv);
+}
+
+SE_TEST(string_builder_append_path_keeps_a_leading_delimiter_only_on_an_empty_builder)
+{
+    // A path that starts with a delimiter is absolute when nothing was appended before it, so the delimiter is kept once.
+    StringBuilder builder;
+    builder.append_path("/Content"sv);
+    SE_TEST_CHECK(builder.view() == "/Content"sv);
+
+    builder.clear();
+    builder.append_path("\\\\//Content"sv);
+    SE_TEST_CHECK(builder.view() == "/Content"sv);
+
+    builder.clear();
+    builder.append_path("/"sv);
+    SE_TEST_CHECK(builder.view() == "/"sv);
+    builder.append_path("/Content"sv);
+    SE_TEST_CHECK(builder.view() == "/Content"sv);
+
+    // On a builder that isn't empty, the leading delimiter only separates the component from the previous characters.
+    builder.clear();
+    builder.append("Game"sv);
+    builder.append_path("/Content"sv);
+    SE_TEST_CHECK(builder.view() == "Game/Content"sv);
+}
+
+SE_TEST(string_builder_release_string_transfers_its_buffer)
+{
+    // A string that doesn't fit inline takes the buffer of the builder, without copying the characters.
+    StringBuilder builder;
+    builder.append(s_test_characters);
+    const char* builder_buffer = builder.view().characters();
+    const String string = builder.release_string();
+    SE_TEST_CHECK(string.is_stored_on_heap());
+    SE_TEST_CHECK(string.characters() == builder_buffer);
+    SE_TEST_CHECK(string.view() == s_test_characters);
+    SE_TEST_CHECK(builder.is_empty());
+
+    // The builder no longer owns a buffer, so appending allocates a new one.
+    builder.append(s_test_characters.slice(0, 30));
+    SE_TEST_CHECK(builder.view().characters() != builder_buffer);
+    const String second_string = builder.release_string();
+    SE_TEST_CHECK(second_string.view() == s_test_characters.slice(0, 30));
+    SE_TEST_CHECK(string.view() == s_test_characters);
+
+    // A string that fits inline (with its null-terminator) is copied, and the builder keeps its buffer.
+    // NOTE: The buffer is reserved first, so both strings below are built in the same buffer.
+    constexpr usize inline_byte_count = String::inline_capacity - 1;
+    builder.reserve(s_test_characters.byte_count());
+    builder.append(s_test_characters.slice(0, inline_byte_count));
+    const char* kept_buffer = builder.view().characters();
+    const String inline_string = builder.release_string();
+    SE_TEST_CHECK(inline_string.is_stored_inline());
+    SE_TEST_CHECK(inline_string.view() == s_test_characters.slice(0, inline_byte_count));
+    SE_TEST_CHECK(builder.is_empty());
+
+    // One more character doesn't fit inline, so the same buffer is transferred to the string.
+    builder.append(s_test_characters.slice(0, inline_byte_count + 1));
+    SE_TEST_CHECK(builder.view().characters() == kept_buffer);
+    const String boundary_string = builder.release_string();
+    SE_TEST_CHECK(boundary_string.is_stored_on_heap() && boundary_string.characters() == kept_buffer);
+    SE_TEST_CHECK(boundary_string.view() == s_test_characters.slice(0, inline_byte_count + 1));
+
+    // An empty builder produces an empty string.
+    StringBuilder empty_builder;
+    const String empty_string = empty_builder.release_string();
+    SE_TEST_CHECK(empty_string.is_empty() && empty_string.is_stored_inline());
+}
+
+SE_TEST(string_builder_format_to_appends_the_formatted_arguments)
+{
+    // The formatted characters are appended after the existing ones, so formatting and appending can be mixed.
+    StringBuilder builder;
+    builder.append("Entity "sv);
+    SE_TEST_CHECK(format_to(builder, "{} at ({}, {:03})"sv, "Camera"sv, -4, 7u) == FormatErrorCode::Success);
+    builder.append('.');
+    SE_TEST_CHECK(builder.view() == "Entity Camera at (-4, 007)."sv);
+
+    // An argument larger than the buffer grows it, keeping the characters that were already written.
+    SE_TEST_CHECK(format_to(builder, " {}|{:100}|"sv, s_test_characters, "x"sv) == FormatErrorCode::Success);
+    const StringView view = builder.view();
+    SE_TEST_CHECK(view.byte_count() == 27 + 1 + s_test_characters.byte_count() + 1 + 100 + 1);
+    SE_TEST_CHECK(view.slice(0, 27) == "Entity Camera at (-4, 007)."sv);
+    SE_TEST_CHECK(view.slice(28, s_test_characters.byte_count()) == s_test_characters);
+    SE_TEST_CHECK(view.slice(view.byte_count() - 2) == " |"sv);
+
+    // The formatted string is released like any other built string.
+    const usize byte_count = builder.byte_count();
+    const String string = builder.release_string();
+    SE_TEST_CHECK(string.byte_count() == byte_count && string.view().slice(0, 6) == "Entity"sv);
+}
+
+} // namespace SE
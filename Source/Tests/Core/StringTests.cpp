@@ -0,0 +1,257 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/String/String.h>
+#include <Core/String/StringBuilder.h>
+#include <TestFramework.h>
+
+namespace SE
+{
+
+// The longest test string is used to create strings of any length (up to its own), sliced from its beginning.
+static constexpr StringView s_test_characters = "abcdefghijklmnopqrstuvwxyz0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ"sv;
+
+//
+// Counts the heap allocations made by a string while it is modified. The runtime might be a separate module with its own
+// allocator, so the allocations are not counted by hooking the global allocation functions. Instead, every time the heap
+// buffer of the string changes (which is the only case where `String` allocates) one allocation is counted.
+//
+class TestStringAllocationCounter
+{
+public:
+    ALWAYS_INLINE explicit TestStringAllocationCounter(const String& string)
+        : m_string(string)
+        , m_heap_buffer(string.is_stored_on_heap() ? string.characters() : nullptr)
+    {}
+
+    // Must be called after every modification of the string.
+    ALWAYS_INLINE void update()
+    {
+        const char* heap_buffer = m_string.is_stored_on_heap() ? m_string.characters() : nullptr;
+        if (heap_buffer != nullptr && heap_buffer != m_heap_buffer)
+            ++m_allocation_count;
+        m_heap_buffer = heap_buffer;
+    }
+
+    NODISCARD ALWAYS_INLINE u32 allocation_count() const { return m_allocation_count; }
+
+private:
+    const String& m_string;
+    const char* m_heap_buffer;
+    u32 m_allocation_count { 0 };
+};
+
+SE_TEST(string_stores_up_to_22_characters_inline)
+{
+    SE_TEST_CHECK(String::inline_capacity == 23);
+
+    // The inline storage holds 22 characters and the null termination character, so the 23rd character moves the string to the heap.
+    for (usize byte_count = 0; byte_count <= 24; ++byte_count)
+    {
+        const StringView view = s_test_characters.slice(0, byte_count);
+        const String string = view;
+        SE_TEST_CHECK(string.is_stored_inline() == (byte_count <= 22));
+        SE_TEST_CHECK(string.byte_count() == byte_count);
+        SE_TEST_CHECK(string.view() == view);
+        SE_TEST_CHECK(string.characters()[byte_count] == 0);
+        SE_TEST_CHECK(string.capacity() >= byte_count + 1);
+    }
+
+    // Appending crosses the boundary in the same way as constructing.
+    for (usize byte_count = 20; byte_count <= 24; ++byte_count)
+    {
+        String string = s_test_characters.slice(0, 20);
+        MAYBE_UNUSED String& result = string.append(s_test_characters.slice(20, byte_count - 20));
+        SE_TEST_CHECK(string.is_stored_inline() == (byte_count <= 22));
+        SE_TEST_CHECK(string.view() == s_test_characters.slice(0, byte_count));
+
+        const String concatenated = String(s_test_characters.slice(0, 20)) + s_test_characters.slice(20, byte_count - 20);
+        SE_TEST_CHECK(concatenated.is_stored_inline() == (byte_count <= 22));
+        SE_TEST_CHECK(concatenated.view() == s_test_characters.slice(0, byte_count));
+    }
+}
+
+SE_TEST(string_appends_and_assigns_itself)
+{
+    // Self-append, both while the result fits in the current storage and while it has to be moved to a larger buffer.
+    for (const usize byte_count : { usize(0), usize(5), usize(11), usize(12), usize(22), usize(40) })
+    {
+        String string = s_test_characters.slice(0, byte_count);
+        MAYBE_UNUSED String& result = string.append(string);
+        SE_TEST_CHECK(string.byte_count() == 2 * byte_count);
+        SE_TEST_CHECK(string.view().slice(0, byte_count) == s_test_characters.slice(0, byte_count));
+        SE_TEST_CHECK(string.view().slice(byte_count) == s_test_characters.slice(0, byte_count));
+    }
+
+    // A part of the string is appended to it.
+    String heap_string = s_test_characters.slice(0, 30);
+    MAYBE_UNUSED String& result = heap_string.append(heap_string.view().slice(10, 5));
+    SE_TEST_CHECK(heap_string.view().slice(30) == s_test_characters.slice(10, 5));
+
+    // Self-assignment, with a copy and with a move.
+    for (const usize byte_count : { usize(0), usize(22), usize(23), usize(40) })
+    {
+        String string = s_test_characters.slice(0, byte_count);
+        String& string_reference = string;
+        string = string_reference;
+        SE_TEST_CHECK(string.view() == s_test_characters.slice(0, byte_count));
+        string = move(string_reference);
+        SE_TEST_CHECK(string.view() == s_test_characters.slice(0, byte_count));
+    }
+
+    // A string is assigned a view of its own characters, which overlaps the storage that is overwritten.
+    for (const usize byte_count : { usize(20), usize(40) })
+    {
+        String string = s_test_characters.slice(0, byte_count);
+        string = string.view().slice(3);
+        SE_TEST_CHECK(string.view() == s_test_characters.slice(3, byte_count - 3));
+        string = string.view().slice(0, 4);
+        SE_TEST_CHECK(string.view() == s_test_characters.slice(3, 4));
+    }
+}
+
+SE_TEST(string_reuses_its_heap_buffer_on_assignment)
+{
+    String string = s_test_characters.slice(0, 60);
+    SE_TEST_CHECK(string.is_stored_on_heap());
+    const char* heap_buffer = string.characters();
+    const usize capacity = string.capacity();
+
+    // Any string that fits in the heap buffer is copied into it, including the strings that could be stored inline.
+    for (const usize byte_count : { usize(59), usize(40), usize(23), usize(5), usize(0), usize(60) })
+    {
+        string = s_test_characters.slice(0, byte_count);
+        SE_TEST_CHECK(string.characters() == heap_buffer);
+        SE_TEST_CHECK(string.capacity() == capacity);
+        SE_TEST_CHECK(string.view() == s_test_characters.slice(0, byte_count));
+    }
+
+    const String other = s_test_characters.slice(10, 30);
+    string = other;
+    SE_TEST_CHECK(string.characters() == heap_buffer);
+    SE_TEST_CHECK(string == other);
+
+    // A string that doesn't fit in the heap buffer replaces it.
+    string = s_test_characters;
+    SE_TEST_CHECK(string.view() == s_test_characters);
+    SE_TEST_CHECK(string.capacity() >= s_test_characters.byte_count() + 1);
+
+    // Clearing releases the heap buffer.
+    string.clear();
+    SE_TEST_CHECK(string.is_stored_inline() && string.is_empty());
+}
+
+SE_TEST(string_moves_inline_and_heap_strings)
+{
+    for (const usize byte_count : { usize(0), usize(7), usize(22), usize(23), usize(50) })
+    {
+        String source = s_test_characters.slice(0, byte_count);
+        const bool is_stored_on_heap = source.is_stored_on_heap();
+        const char* source_characters = source.characters();
+
+        // The heap buffer is transferred, while the inline characters are copied.
+        String moved = move(source);
+        SE_TEST_CHECK(moved.view() == s_test_characters.slice(0, byte_count));
+        SE_TEST_CHECK(moved.is_stored_on_heap() == is_stored_on_heap);
+        if (is_stored_on_heap)
+            SE_TEST_CHECK(moved.characters() == source_characters);
+        SE_TEST_CHECK(source.is_empty() && source.is_stored_inline());
+
+        // Move assignment releases the heap buffer of the destination.
+        String destination = s_test_characters.slice(0, 40);
+        destination = move(moved);
+        SE_TEST_CHECK(destination.view() == s_test_characters.slice(0, byte_count));
+        if (is_stored_on_heap)
+            SE_TEST_CHECK(destination.characters() == source_characters);
+        SE_TEST_CHECK(moved.is_empty() && moved.is_stored_inline());
+
+        // The moved-from strings are valid and can be reused.
+        source = s_test_characters.slice(0, 3);
+        SE_TEST_CHECK(source.view() == s_test_characters.slice(0, 3));
+    }
+}
+
+SE_TEST(string_stores_heap_byte_counts_larger_than_the_inline_count)
+{
+    // The inline byte count is 8 bits, while the heap byte count and capacity are 32 bits. The strings larger than 255
+    // and 65535 bytes check that the heap counts are not truncated to the size of the inline count.
+    for (const usize byte_count : { usize(255), usize(256), usize(65535), usize(65536), usize(1000000) })
+    {
+        StringBuilder builder;
+        for (usize byte_index = 0; byte_index < byte_count; ++byte_index)
+            builder.append(static_cast<char>('a' + byte_index % 26));
+        const String string = builder.release_string();
+
+        SE_TEST_CHECK(string.is_stored_on_heap());
+        SE_TEST_CHECK(string.byte_count() == byte_count);
+        SE_TEST_CHECK(string.capacity() >= byte_count + 1);
+        SE_TEST_CHECK(string.characters()[byte_count - 1] == static_cast<char>('a' + (byte_count - 1) % 26));
+        SE_TEST_CHECK(string.characters()[byte_count] == 0);
+
+        const String copy = string;
+        SE_TEST_CHECK(copy.byte_count() == byte_count);
+        SE_TEST_CHECK(copy == string);
+    }
+}
+
+SE_TEST(string_append_allocates_a_logarithmic_number_of_times)
+{
+    constexpr usize append_count = 100000;
+    String string;
+    TestStringAllocationCounter allocation_counter = TestStringAllocationCounter(string);
+    for (usize append_index = 0; append_index < append_count; ++append_index)
+    {
+        MAYBE_UNUSED String& result = string.append(s_test_characters.slice(append_index % 26, 1));
+        allocation_counter.update();
+    }
+    SE_TEST_CHECK(string.byte_count() == append_count);
+
+    // The capacity grows by half each time, starting from the inline capacity: 23 * 1.5^21 is larger than 100000 bytes.
+    SE_TEST_CHECK(allocation_counter.allocation_count() <= 22);
+
+    // Assigning shorter strings reuses the heap buffer.
+    for (usize byte_count = 0; byte_count <= s_test_characters.byte_count(); ++byte_count)
+    {
+        string = s_test_characters.slice(0, byte_count);
+        allocation_counter.update();
+    }
+    SE_TEST_CHECK(allocation_counter.allocation_count() <= 22);
+}
+
+SE_BENCHMARK(string_append_and_assign)
+{
+    constexpr usize string_count = 100000;
+
+    // Appends short suffixes to a string, as when a path or a name is built from its parts.
+    u32 allocation_count = 0;
+    u64 start_tick_counter = Platform::get_current_tick_counter();
+    for (usize string_index = 0; string_index < string_count; ++string_index)
+    {
+        String string = s_test_characters.slice(0, 8);
+        TestStringAllocationCounter allocation_counter = TestStringAllocationCounter(string);
+        for (usize part_index = 0; part_index < 8; ++part_index)
+        {
+            MAYBE_UNUSED String& result = string.append(s_test_characters.slice(part_index, 6));
+            allocation_counter.update();
+        }
+        allocation_count += allocation_counter.allocation_count();
+    }
+    test_context.report_duration("Build a 56-byte string from 9 parts"sv, string_count, Platform::get_current_tick_counter() - start_tick_counter);
+    SE_LOG_INFO("    Allocations per string: {:.2f}", static_cast<double>(allocation_count) / static_cast<double>(string_count));
+
+    // Assigns strings of different lengths to the same string, which reuses its buffer once it is large enough.
+    String string;
+    TestStringAllocationCounter allocation_counter = TestStringAllocationCounter(string);
+    start_tick_counter = Platform::get_current_tick_counter();
+    for (usize string_index = 0; string_index < string_count; ++string_index)
+    {
+        string = s_test_characters.slice(0, string_index % s_test_characters.byte_count());
+        allocation_counter.update();
+    }
+    test_context.report_duration("Assign strings of 0-61 bytes"sv, string_count, Platform::get_current_tick_counter() - start_tick_counter);
+    SE_LOG_INFO("    Allocations: {} for {} assignments", allocation_counter.allocation_count(), string_count);
+}
+
+} // namespace SE
@@ -0,0 +1,253 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/Containers/Vector.h>
+#include <Core/Memory/MemoryOperations.h>
+#include <Core/String/Utf8.h>
+#include <TestFramework.h>
+#include <cstring>
+
+namespace SE
+{
+
+//
+// Validates the UTF-8 byte sequence and counts its codepoints one byte at a time, by decoding each codepoint and
+// checking its value. This is the reference the implementation (which validates blocks of ASCII bytes at once and
+// checks the ranges of the bytes instead of the decoded values) is checked against.
+//
+NODISCARD static usize get_reference_codepoint_count(ReadonlyBytes bytes, usize byte_count)
+{
+    usize codepoint_count = 0;
+    for (usize byte_offset = 0; byte_offset < byte_count; ++codepoint_count)
+    {
+        const ReadWriteByte leading_byte = bytes[byte_offset];
+        u32 codepoint_width;
+        UnicodeCodepoint codepoint;
+        UnicodeCodepoint min_codepoint;
+
+        if (leading_byte < 0x80)
+        {
+            codepoint_width = 1;
+            codepoint = leading_byte;
+            min_codepoint = 0;
+        }
+        else if ((leading_byte & 0xE0) == 0xC0)
+        {
+            codepoint_width = 2;
+            codepoint = leading_byte & 0x1F;
+            min_codepoint = 0x80;
+        }
+        else if ((leading_byte & 0xF0) == 0xE0)
+        {
+            codepoint_width = 3;
+            codepoint = leading_byte & 0x0F;
+            min_codepoint = 0x800;
+        }
+        else if ((leading_byte & 0xF8) == 0xF0)
+        {
+            codepoint_width = 4;
+            codepoint = leading_byte & 0x07;
+            min_codepoint = 0x10000;
+        }
+        else
+        {
+            return invalid_size;
+        }
+
+        if (byte_count - byte_offset < codepoint_width)
+            return invalid_size;
+        for (u32 byte_index = 1; byte_index < codepoint_width; ++byte_index)
+        {
+            const ReadWriteByte continuation_byte = bytes[byte_offset + byte_index];
+            if ((continuation_byte & 0xC0) != 0x80)
+                return invalid_size;
+            codepoint = (codepoint << 6) | (continuation_byte & 0x3F);
+        }
+
+        // Overlong encodings, surrogates and codepoints above U+10FFFF are invalid.
+        if (codepoint < min_codepoint || (codepoint >= 0xD800 && codepoint <= 0xDFFF) || codepoint > 0x10FFFF)
+            return invalid_size;
+        byte_offset += codepoint_width;
+    }
+    return codepoint_count;
+}
+
+//
+// Fills the buffer with text that is mostly ASCII (as are the strings of the engine), where one in `non_ascii_frequency`
+// codepoints is wider, or none if it is zero. The buffer never contains null-termination characters.
+//
+static void fill_random_text(TestRandomGenerator& random_generator, WriteonlyBytes bytes, usize byte_count, u32 non_ascii_frequency)
+{
+    usize byte_offset = 0;
+    while (byte_offset < byte_count)
+    {
+        const u64 random_value = random_generator.next();
+        UnicodeCodepoint codepoint = 1 + static_cast<UnicodeCodepoint>(random_value % 0x7F);
+        if (non_ascii_frequency > 0 && (random_value >> 32) % non_ascii_frequency == 0)
+        {
+            // Any codepoint in the range of a random width, except the surrogates.
+            constexpr UnicodeCodepoint range_starts[3] = { 0x80, 0x800, 0x10000 };
+            constexpr UnicodeCodepoint range_ends[3] = { 0x800, 0x10000, 0x110000 };
+            const u32 range_index = static_cast<u32>(random_value >> 40) % 3;
+            const UnicodeCodepoint range_width = range_ends[range_index] - range_starts[range_index];
+            codepoint = range_starts[range_index] + static_cast<UnicodeCodepoint>(random_generator.next() % range_width);
+            if (codepoint >= 0xD800 && codepoint <= 0xDFFF)
+                codepoint -= 0x800;
+        }
+
+        ReadWriteByte codepoint_bytes[4];
+        const usize codepoint_width = UTF8::bytes_from_codepoint(codepoint, WriteonlyByteSpan(codepoint_bytes, sizeof(codepoint_bytes)));
+        if (byte_offset + codepoint_width > byte_count)
+        {
+            // NOTE: The end of the buffer is filled with ASCII characters when the codepoint doesn't fit.
+            bytes[byte_offset++] = 'a';
+            continue;
+        }
+
+        copy_memory(bytes + byte_offset, codepoint_bytes, codepoint_width);
+        byte_offset += codepoint_width;
+    }
+}
+
+// Replaces a few random bytes with random non-null values, which makes most sequences invalid.
+static void corrupt_random_bytes(TestRandomGenerator& random_generator, WriteonlyBytes bytes, usize byte_count)
+{
+    if (byte_count == 0)
+        return;
+    const u32 corrupted_byte_count = static_cast<u32>(random_generator.next() % 3);
+    for (u32 corrupted_byte_index = 0; corrupted_byte_index < corrupted_byte_count; ++corrupted_byte_index)
+        bytes[random_generator.next() % byte_count] = static_cast<ReadWriteByte>(1 + random_generator.next() % 255);
+}
+
+SE_TEST(utf8_validation_handles_codepoints_across_blocks)
+{
+    // A codepoint that starts in the last byte of a 32-byte block and ends in the next block.
+    ReadWriteByte bytes[64];
+    set_memory(bytes, 'a', sizeof(bytes));
+    bytes[31] = 0xC3;
+    bytes[32] = 0xA9;
+    SE_TEST_CHECK(UTF8::length(ReadonlyByteSpan(bytes, 64)) == 63);
+
+    // A codepoint that is truncated by the end of a 32-byte sequence.
+    SE_TEST_CHECK(UTF8::length(ReadonlyByteSpan(bytes, 32)) == invalid_size);
+    SE_TEST_CHECK(!UTF8::check_validity(ReadonlyByteSpan(bytes, 32)));
+
+    // A continuation byte at the start of a block, that doesn't follow a leading byte.
+    bytes[31] = 'a';
+    SE_TEST_CHECK(UTF8::length(ReadonlyByteSpan(bytes, 64)) == invalid_size);
+
+    // The encodings that are rejected even though their bytes have the right form.
+    const ReadWriteByte overlong_encoding[] = { 0xE0, 0x80, 0xAF };
+    const ReadWriteByte surrogate[] = { 0xED, 0xA0, 0x80 };
+    const ReadWriteByte above_max_codepoint[] = { 0xF4, 0x90, 0x80, 0x80 };
+    SE_TEST_CHECK(!UTF8::check_validity(ReadonlyByteSpan(overlong_encoding, sizeof(overlong_encoding))));
+    SE_TEST_CHECK(!UTF8::check_validity(ReadonlyByteSpan(surrogate, sizeof(surrogate))));
+    SE_TEST_CHECK(!UTF8::check_validity(ReadonlyByteSpan(above_max_codepoint, sizeof(above_max_codepoint))));
+}
+
+SE_TEST(utf8_validation_matches_scalar_reference)
+{
+    // The sequences start at every offset inside a 32-byte block, and their lengths cover a few blocks, so the bytes are
+    // validated by both the block and the scalar paths (and the codepoints cross the boundaries between them).
+    alignas(32) ReadWriteByte buffer[32 + 160];
+    TestRandomGenerator random_generator = { 8 };
+
+    u32 mismatch_count = 0;
+    u32 invalid_sequence_count = 0;
+    for (u32 iteration_index = 0; iteration_index < 200000; ++iteration_index)
+    {
+        const usize byte_offset = random_generator.next() % 32;
+        const usize byte_count = random_generator.next() % 161;
+        ReadWriteBytes bytes = buffer + byte_offset;
+
+        fill_random_text(random_generator, bytes, byte_count, 1 + static_cast<u32>(random_generator.next() % 16));
+        if (iteration_index % 2 == 0)
+            corrupt_random_bytes(random_generator, bytes, byte_count);
+
+        const usize reference_codepoint_count = get_reference_codepoint_count(bytes, byte_count);
+        const usize codepoint_count = UTF8::length(ReadonlyByteSpan(bytes, byte_count));
+        const bool is_valid = UTF8::check_validity(ReadonlyByteSpan(bytes, byte_count));
+
+        if (codepoint_count != reference_codepoint_count || is_valid != (reference_codepoint_count != invalid_size))
+            ++mismatch_count;
+        if (reference_codepoint_count == invalid_size)
+            ++invalid_sequence_count;
+    }
+
+    SE_TEST_CHECK(mismatch_count == 0);
+    // Both valid and invalid sequences must have been checked.
+    SE_TEST_CHECK(invalid_sequence_count > 10000 && invalid_sequence_count < 190000);
+}
+
+SE_TEST(utf8_byte_count_matches_scalar_reference)
+{
+    // The bytes around the string aren't null, so a null-termination character found outside of the string would
+    // produce a wrong result.
+    alignas(16) ReadWriteByte buffer[16 + 128 + 16];
+    TestRandomGenerator random_generator = { 9 };
+
+    u32 mismatch_count = 0;
+    for (u32 iteration_index = 0; iteration_index < 100000; ++iteration_index)
+    {
+        const usize byte_offset = random_generator.next() % 16;
+        const usize byte_count = random_generator.next() % 128;
+        ReadWriteBytes bytes = buffer + byte_offset;
+
+        fill_random_text(random_generator, buffer, sizeof(buffer), 4);
+        if (iteration_index % 2 == 0)
+            corrupt_random_bytes(random_generator, bytes, byte_count);
+        bytes[byte_count] = '\0';
+
+        // NOTE: The byte count includes the null-termination character.
+        const usize reference_byte_count = (get_reference_codepoint_count(bytes, byte_count) != invalid_size) ? byte_count + 1 : invalid_size;
+        if (UTF8::byte_count(bytes) != reference_byte_count)
+            ++mismatch_count;
+    }
+
+    SE_TEST_CHECK(mismatch_count == 0);
+    SE_TEST_CHECK(UTF8::byte_count(nullptr) == 0);
+}
+
+SE_BENCHMARK(utf8_validation_throughput)
+{
+    constexpr usize byte_count = 16 * MiB;
+    constexpr u32 iteration_count = 8;
+    constexpr u64 processed_byte_count = static_cast<u64>(byte_count) * iteration_count;
+    TestRandomGenerator random_generator = { 10 };
+
+    // NOTE: The last byte is the null-termination character of the text, as required by `UTF8::byte_count`.
+    Vector<ReadWriteByte> ascii_text = Vector<ReadWriteByte>::create_filled(byte_count + 1, 0);
+    Vector<ReadWriteByte> mixed_text = Vector<ReadWriteByte>::create_filled(byte_count + 1, 0);
+    fill_random_text(random_generator, ascii_text.elements(), byte_count, 0);
+    fill_random_text(random_generator, mixed_text.elements(), byte_count, 8);
+
+    usize checksum = 0;
+    const auto measure = [&](StringView measurement_name, ReadonlyBytes bytes, auto function)
+    {
+        // NOTE: The bytes are read through a volatile pointer, otherwise the compiler could execute a function that has
+        //       no side effects only once for all the iterations.
+        ReadonlyBytes volatile volatile_bytes = bytes;
+        const u64 start_tick_counter = Platform::get_current_tick_counter();
+        for (u32 iteration_index = 0; iteration_index < iteration_count; ++iteration_index)
+            checksum += function(volatile_bytes);
+        test_context.report_throughput(measurement_name, processed_byte_count, Platform::get_current_tick_counter() - start_tick_counter);
+    };
+
+    measure("length (ASCII)"sv, ascii_text.elements(), [](ReadonlyBytes bytes) { return UTF8::length(ReadonlyByteSpan(bytes, byte_count)); });
+    measure("scalar reference (ASCII)"sv, ascii_text.elements(), [](ReadonlyBytes bytes) { return get_reference_codepoint_count(bytes, byte_count); });
+    measure("length (1/8 non-ASCII)"sv, mixed_text.elements(), [](ReadonlyBytes bytes) { return UTF8::length(ReadonlyByteSpan(bytes, byte_count)); });
+    measure("scalar reference (1/8 non-ASCII)"sv, mixed_text.elements(), [](ReadonlyBytes bytes) { return get_reference_codepoint_count(bytes, byte_count); });
+
+    // The byte count is validated as well, so it is compared with the sum of the two scalar passes.
+    measure("byte_count (ASCII)"sv, ascii_text.elements(), [](ReadonlyBytes bytes) { return UTF8::byte_count(bytes); });
+    measure(
+        "strlen and scalar reference (ASCII)"sv, ascii_text.elements(),
+        [](ReadonlyBytes bytes) { return get_reference_codepoint_count(bytes, std::strlen(reinterpret_cast<const char*>(bytes))); }
+    );
+
+    SE_TEST_CHECK(checksum > 0);
+}
+
+} // namespace SE
@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/FileSystem/FileSystem.h>
+#include <Core/Memory/Buffer.h>
+#include <Engine/Scene/Components/SpriteRendererComponent.h>
+#include <Engine/Scene/Components/TransformComponent.h>
+#include <Engine/Scene/Reflection/ComponentReflectorRegistry.h>
+#include <Engine/Scene/Scene.h>
+#include <Serialization/EditorSceneSerializer.h>
+#include <TestFramework.h>
+#include <TestScenes.h>
+#include <yaml-cpp/shooteryaml.h>
+
+namespace SE
+{
+
+//
+// The scene loader that the streaming parser replaced: the whole file is parsed into a tree of YAML nodes by
+// `YAML::Load`, which is then walked to create the entities. It is only able to load the components created by
+// `generate_test_scene`, and is kept as the reference that the streaming parser is measured against.
+//
+NODISCARD static bool load_scene_from_yaml_node_tree(Scene& scene, const String& filepath)
+{
+    FileReader scene_file_reader;
+    String scene_file;
+    if (scene_file_reader.open(filepath) != FileError::Success || scene_file_reader.read_entire_to_string_and_close(scene_file) != FileError::Success)
+        return false;
+
+    const YAML::Node scene_node = YAML::Load(scene_file.characters());
+    const YAML::Node entity_nodes = scene_node["Entities"];
+    if (!entity_nodes || !entity_nodes.IsSequence())
+        return false;
+
+    for (const YAML::Node& entity_node : entity_nodes)
+    {
+        Entity* entity = scene.create_entity_with_uuid(entity_node["UUID"].as<UUID>());
+        entity->set_name(entity_node["Name"].as<String>());
+
+        for (const YAML::Node& component_node : entity_node["Components"])
+        {
+            const YAML::Node field_nodes = component_node["Fields"];
+            const auto get_field_value = [&field_nodes](const char* field_name) -> YAML::Node
+            {
+                for (const YAML::Node& field_node : field_nodes)
+                {
+                    if (field_node["Name"].as<std::string>() == field_name)
+                        return field_node["Value"];
+                }
+                return {};
+            };
+
+            const UUID component_type_uuid = component_node["TypeUUID"].as<UUID>();
+            if (component_type_uuid == TransformComponent::get_static_component_type_uuid())
+            {
+                entity->add_component<TransformComponent>(
+                    get_field_value("m_translation").as<Vector3>(), get_field_value("m_rotation").as<Vector3>(),
+                    get_field_value("m_scale").as<Vector3>()
+                );
+            }
+            else if (component_type_uuid == SpriteRendererComponent::get_static_component_type_uuid())
+            {
+                // NOTE: The sprite color field is registered with the name 'm_translation'.
+                SpriteRendererComponent& sprite = entity->add_component<SpriteRendererComponent>(get_field_value("m_translation").as<Color4>());
+                sprite.set_texture_handle(AssetHandle(get_field_value("m_texture").as<UUID>()));
+            }
+        }
+    }
+
+    return true;
+}
+
+SE_TEST(editor_scene_serializer_streaming_loader_matches_the_node_tree_loader)
+{
+    ComponentReflectorRegistry component_reflector_registry;
+    component_reflector_registry.initialize();
+    const String scene_filepath = "SE-Tests-EditorSceneSerializer.sescene"sv;
+
+    OwnPtr<Scene> source_scene = Scene::create();
+    generate_test_scene(*source_scene, 1000, 3);
+    if (SE_TEST_CHECK(EditorSceneSerializer(*source_scene, component_reflector_registry).serialize(scene_filepath)))
+    {
+        OwnPtr<Scene> streamed_scene = Scene::create();
+        OwnPtr<Scene> node_tree_scene = Scene::create();
+        SE_TEST_CHECK(EditorSceneSerializer(*streamed_scene, component_reflector_registry).deserialize(scene_filepath));
+        SE_TEST_CHECK(load_scene_from_yaml_node_tree(*node_tree_scene, scene_filepath));
+
+        SE_TEST_CHECK(are_test_scenes_equal(*source_scene, *streamed_scene));
+        SE_TEST_CHECK(are_test_scenes_equal(*source_scene, *node_tree_scene));
+    }
+
+    FileSystem::delete_file(scene_filepath);
+    source_scene.release();
+    component_reflector_registry.shutdown();
+}
+
+SE_TEST(editor_scene_serializer_skips_a_torn_journal_tail)
+{
+    ComponentReflectorRegistry component_reflector_registry;
+    component_reflector_registry.initialize();
+    const String scene_filepath = "SE-Tests-EditorSceneSerializer.sescene"sv;
+    const String journal_filepath = EditorSceneSerializer::get_journal_filepath(scene_filepath);
+    const UUID first_entity_uuid = UUID(1);
+    const UUID second_entity_uuid = UUID(3);
+
+    OwnPtr<Scene> source_scene = Scene::create();
+    generate_test_scene(*source_scene, 20, 5);
+    source_scene->create_entity_with_uuid(first_entity_uuid)->set_name("First entity"sv);
+    source_scene->create_entity_with_uuid(second_entity_uuid)->set_name("Second entity"sv);
+    EditorSceneSerializer source_serializer(*source_scene, component_reflector_registry);
+    SE_TEST_CHECK(source_serializer.serialize(scene_filepath));
+
+    // Two changes are appended to the journal, each of them renaming one of the entities.
+    source_scene->set_change_tracking_enabled(true);
+    source_scene->get_entity_from_uuid(first_entity_uuid)->set_name("First change"sv);
+    SE_TEST_CHECK(source_serializer.serialize_changes(scene_filepath));
+    source_scene->clear_entity_changes();
+    const usize first_entry_byte_count = FileSystem::get_file_size(journal_filepath).value_or(0);
+    source_scene->get_entity_from_uuid(second_entity_uuid)->set_name("Second change"sv);
+    SE_TEST_CHECK(source_serializer.serialize_changes(scene_filepath));
+
+    Buffer journal;
+    FileReader journal_file_reader;
+    const bool has_read_journal =
+        journal_file_reader.open(journal_filepath) == FileError::Success && journal_file_reader.read_entire_and_close(journal) == FileError::Success;
+    if (SE_TEST_CHECK(has_read_journal && first_entry_byte_count > 0 && first_entry_byte_count < journal.byte_count()))
+    {
+        const auto check_replayed_changes = [&](ReadonlyByteSpan journal_bytes, bool expect_first_change, bool expect_discarded_tail)
+        {
+            OwnPtr<Scene> scene = Scene::create();
+            EditorSceneSerializer serializer(*scene, component_reflector_registry);
+            if (!SE_TEST_CHECK(serializer.deserialize(scene_filepath, journal_bytes)))
+                return;
+
+            SE_TEST_CHECK(serializer.has_discarded_journal_tail() == expect_discarded_tail);
+            SE_TEST_CHECK(scene->get_entity_from_uuid(first_entity_uuid)->name() == (expect_first_change ? "First change"sv : "First entity"sv));
+            SE_TEST_CHECK(scene->get_entity_from_uuid(second_entity_uuid)->name() == "Second entity"sv);
+        };
+
+        // The whole journal is replayed.
+        OwnPtr<Scene> scene = Scene::create();
+        EditorSceneSerializer serializer(*scene, component_reflector_registry);
+        if (SE_TEST_CHECK(serializer.deserialize(scene_filepath)))
+        {
+            SE_TEST_CHECK(!serializer.has_discarded_journal_tail());
+            SE_TEST_CHECK(scene->get_entity_from_uuid(first_entity_uuid)->name() == "First change"sv);
+            SE_TEST_CHECK(scene->get_entity_from_uuid(second_entity_uuid)->name() == "Second change"sv);
+        }
+
+        // The journal is cut at every byte, as if the editor was closed while the second entry was being written.
+        for (usize byte_count = 0; byte_count < journal.byte_count(); ++byte_count)
+        {
+            const bool is_at_entry_boundary = (byte_count == 0 || byte_count == first_entry_byte_count);
+            check_replayed_changes(journal.readonly_byte_span().slice(0, byte_count), byte_count >= first_entry_byte_count, !is_at_entry_boundary);
+        }
+
+        // A corrupted byte in the second entry is detected by its checksum.
+        Buffer corrupted_journal = Buffer::copy(journal);
+        corrupted_journal.bytes()[journal.byte_count() - 10] ^= 0x01;
+        check_replayed_changes(corrupted_journal.readonly_byte_span(), true, true);
+    }
+
+    FileSystem::delete_file(scene_filepath);
+    FileSystem::delete_file(journal_filepath);
+    source_scene.release();
+    component_reflector_registry.shutdown();
+}
+
+SE_BENCHMARK(editor_scene_serializer_load)
+{
+    constexpr u32 entity_count = 50000;
+    ComponentReflectorRegistry component_reflector_registry;
+    component_reflector_registry.initialize();
+    const String scene_filepath = "SE-Tests-EditorSceneSerializer.sescene"sv;
+
+    {
+        OwnPtr<Scene> source_scene = Scene::create();
+        generate_test_scene(*source_scene, entity_count, 7);
+        if (!SE_TEST_CHECK(EditorSceneSerializer(*source_scene, component_reflector_registry).serialize(scene_filepath)))
+            return;
+    }
+    SE_LOG_INFO("    Scene file: {} entities, {} bytes", entity_count, FileSystem::get_file_size(scene_filepath).value_or(0));
+
+    // The memory used by the loaded scene is the same for both loaders, so the difference between the peaks is the memory
+    // used by the loader itself.
+    // NOTE: The memory freed by a measurement might be kept by the heap and reused by the next one, so the loader that is
+    //       expected to use less memory is measured first.
+    const auto measure = [&](StringView measurement_name, auto load_function)
+    {
+        OwnPtr<Scene> scene = Scene::create();
+        TestPeakMemorySampler peak_memory_sampler;
+        peak_memory_sampler.start();
+
+        const u64 start_tick_counter = Platform::get_current_tick_counter();
+        SE_TEST_CHECK(load_function(*scene));
+        const u64 elapsed_ticks = Platform::get_current_tick_counter() - start_tick_counter;
+
+        const usize peak_byte_count = peak_memory_sampler.stop();
+        SE_TEST_CHECK(scene->get_entity_count() == entity_count);
+        const u64 elapsed_milliseconds = (elapsed_ticks * 1000) / Platform::get_tick_counter_frequency();
+        SE_LOG_INFO("    {}: {} ms, {} KiB peak resident memory", measurement_name, elapsed_milliseconds, peak_byte_count / KiB);
+    };
+
+    measure(
+        "Streaming parser"sv,
+        [&](Scene& scene) -> bool { return EditorSceneSerializer(scene, component_reflector_registry).deserialize(scene_filepath); }
+    );
+    measure("YAML::Load node tree"sv, [&](Scene& scene) -> bool { return load_scene_from_yaml_node_tree(scene, scene_filepath); });
+
+    FileSystem::delete_file(scene_filepath);
+    component_reflector_registry.shutdown();
+}
+
+} // namespace SE
@@ -0,0 +1,466 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/Math/MathCore.h>
+#include <Engine/Scene/Reflection/ComponentReflectorRegistry.h>
+#include <Engine/Scene/Scene.h>
+#include <Engine/Scene/Serialization/BinarySceneSerializer.h>
+#include <TestFramework.h>
+#include <TestScenes.h>
+
+namespace SE
+{
+
+// The number of label components that currently exist, including the default object of the reflector.
+static Atomic<i32> s_live_label_component_count { 0 };
+
+struct TestLiveLabelComponentCounter
+{
+    TestLiveLabelComponentCounter() { s_live_label_component_count.fetch_add(1); }
+    ~TestLiveLabelComponentCounter() { s_live_label_component_count.fetch_sub(1); }
+};
+
+//
+// Component with a string field, which is the only kind of value that can still be found to be corrupted while the
+// components are decoded (after the entities have been created). None of the engine components have string fields.
+//
+class TestLabelComponent final : public EntityComponent
+{
+    SE_ENTITY_COMPONENT(TestLabelComponent, EntityComponent);
+
+public:
+    String label;
+    u32 label_index { 0 };
+    TestLiveLabelComponentCounter live_counter;
+};
+
+UUID TestLabelComponent::get_static_component_type_uuid()
+{
+    return UUID(0x7E57C0A1B2C3D4E5);
+}
+
+void TestLabelComponent::on_register(ComponentReflector& reflector)
+{
+    reflector.parent_type_uuid = Super::get_static_component_type_uuid();
+    reflector.structure_byte_count = sizeof(TestLabelComponent);
+    reflector.name = "TestLabelComponent"sv;
+    reflector.instantiate_function = [](void* address, const EntityComponentInitializer& initializer) { new (address) TestLabelComponent(initializer); };
+
+    {
+        ComponentField& field = reflector.fields.emplace();
+        field.type_stack.add(ComponentFieldType::String);
+        field.byte_offset = SE_OFFSET_OF(TestLabelComponent, label);
+        field.name = "label"sv;
+    }
+
+    {
+        ComponentField& field = reflector.fields.emplace();
+        field.type_stack.add(ComponentFieldType::UInt32);
+        field.byte_offset = SE_OFFSET_OF(TestLabelComponent, label_index);
+        field.name = "label_index"sv;
+    }
+}
+
+// Registers the engine components and the test label component, in the same way as the engine components are registered.
+static void initialize_test_component_reflector_registry(ComponentReflectorRegistry& component_reflector_registry)
+{
+    component_reflector_registry.initialize();
+
+    ComponentReflector& reflector = component_reflector_registry.allocate_reflector(TestLabelComponent::get_static_component_type_uuid());
+    TestLabelComponent::on_register(reflector);
+    reflector.compile_serialization_plan();
+    reflector.default_component_object_buffer.allocate_new(sizeof(TestLabelComponent));
+    reflector.instantiate_function(reflector.default_component_object_buffer.bytes(), {});
+}
+
+// Adds a label to every third entity of the scene. The labels have different lengths, including empty labels.
+static void add_test_labels(Scene& scene)
+{
+    u32 entity_index = 0;
+    scene.for_each_entity(
+        [&entity_index](Entity* entity, UUID) -> IterationDecision
+        {
+            if (entity_index % 3 == 0)
+            {
+                TestLabelComponent& label_component = entity->add_component<TestLabelComponent>();
+                label_component.label_index = entity_index;
+                char label_characters[40];
+                const u32 label_byte_count = entity_index % SE_ARRAY_COUNT(label_characters);
+                for (u32 character_index = 0; character_index < label_byte_count; ++character_index)
+                    label_characters[character_index] = static_cast<char>('a' + (entity_index + character_index) % 26);
+                label_component.label = StringView::create_from_utf8(label_characters, label_byte_count);
+            }
+            ++entity_index;
+            return IterationDecision::Continue;
+        }
+    );
+}
+
+NODISCARD static bool are_test_labels_equal(const Scene& lhs, const Scene& rhs)
+{
+    bool are_equal = true;
+    lhs.for_each_entity(
+        [&](const Entity* lhs_entity, UUID entity_uuid) -> IterationDecision
+        {
+            const Entity* rhs_entity = rhs.get_entity_from_uuid(entity_uuid);
+            const bool has_label = lhs_entity->has_component<TestLabelComponent>();
+            are_equal = (rhs_entity != nullptr) && (has_label == rhs_entity->has_component<TestLabelComponent>());
+            if (are_equal && has_label)
+            {
+                const TestLabelComponent& lhs_label = lhs_entity->get_component<TestLabelComponent>();
+                const TestLabelComponent& rhs_label = rhs_entity->get_component<TestLabelComponent>();
+                are_equal = (lhs_label.label == rhs_label.label) && (lhs_label.label_index == rhs_label.label_index);
+            }
+            return are_equal ? IterationDecision::Continue : IterationDecision::Break;
+        }
+    );
+    return are_equal;
+}
+
+// Pointers to the tables of a binary scene, used to corrupt specific records.
+struct BinarySceneTables
+{
+    BinarySceneHeader* header;
+    BinarySceneEntityRecord* entity_records;
+    BinarySceneComponentTypeRecord* component_type_records;
+    BinarySceneFieldRecord* field_records;
+    BinarySceneValueRangeRecord* value_range_records;
+    u8* bytes;
+
+    NODISCARD BinarySceneComponentTypeRecord& get_component_type_record(UUID type_uuid)
+    {
+        u32 component_type_index = 0;
+        while (component_type_records[component_type_index].type_uuid != type_uuid.value())
+            ++component_type_index;
+        return component_type_records[component_type_index];
+    }
+
+    NODISCARD u32* get_entity_indices(const BinarySceneComponentTypeRecord& component_type_record)
+    {
+        return reinterpret_cast<u32*>(bytes + component_type_record.entity_indices_offset);
+    }
+
+    // Returns the string references that store the label of each instance of the test label component.
+    NODISCARD BinarySceneStringReference* get_label_string_references()
+    {
+        const BinarySceneComponentTypeRecord& label_record = get_component_type_record(TestLabelComponent::get_static_component_type_uuid());
+        const BinarySceneFieldRecord* label_field_records = field_records + label_record.first_field_index;
+        u32 field_index = 0;
+        while (label_field_records[field_index].type != ComponentFieldType::String)
+            ++field_index;
+
+        const BinarySceneValueRangeRecord& value_range_record =
+            value_range_records[label_record.first_value_range_index + label_field_records[field_index].value_range_index];
+        return reinterpret_cast<BinarySceneStringReference*>(bytes + value_range_record.values_offset);
+    }
+};
+
+NODISCARD static BinarySceneTables get_binary_scene_tables(Vector<u8>& bytes)
+{
+    BinarySceneTables tables;
+    tables.bytes = bytes.elements();
+    tables.header = reinterpret_cast<BinarySceneHeader*>(bytes.elements());
+    tables.entity_records = reinterpret_cast<BinarySceneEntityRecord*>(bytes.elements() + tables.header->entity_table_offset);
+    tables.component_type_records = reinterpret_cast<BinarySceneComponentTypeRecord*>(bytes.elements() + tables.header->component_type_table_offset);
+    tables.field_records = reinterpret_cast<BinarySceneFieldRecord*>(bytes.elements() + tables.header->field_table_offset);
+    tables.value_range_records = reinterpret_cast<BinarySceneValueRangeRecord*>(bytes.elements() + tables.header->value_range_table_offset);
+    return tables;
+}
+
+SE_TEST(binary_scene_serializer_round_trips_scenes)
+{
+    ComponentReflectorRegistry component_reflector_registry;
+    initialize_test_component_reflector_registry(component_reflector_registry);
+
+    {
+        OwnPtr<Scene> source_scene = Scene::create();
+        generate_test_scene(*source_scene, 1000, 5);
+        add_test_labels(*source_scene);
+
+        Vector<u8> scene_bytes;
+        BinarySceneSerializer(*source_scene, component_reflector_registry).serialize_to_memory(scene_bytes);
+
+        OwnPtr<Scene> loaded_scene = Scene::create();
+        const ReadonlyByteSpan scene_span = ReadonlyByteSpan(scene_bytes.elements(), scene_bytes.count());
+        if (SE_TEST_CHECK(BinarySceneSerializer(*loaded_scene, component_reflector_registry).deserialize_from_memory(scene_span)))
+        {
+            SE_TEST_CHECK(are_test_scenes_equal(*source_scene, *loaded_scene));
+            SE_TEST_CHECK(are_test_labels_equal(*source_scene, *loaded_scene));
+        }
+
+        // The entities are added to the ones that already exist in the scene.
+        OwnPtr<Scene> populated_scene = Scene::create();
+        generate_test_scene(*populated_scene, 10, 6);
+        SE_TEST_CHECK(BinarySceneSerializer(*populated_scene, component_reflector_registry).deserialize_from_memory(scene_span));
+        SE_TEST_CHECK(populated_scene->get_entity_count() == 1010);
+    }
+
+    {
+        OwnPtr<Scene> empty_scene = Scene::create();
+        Vector<u8> scene_bytes;
+        BinarySceneSerializer(*empty_scene, component_reflector_registry).serialize_to_memory(scene_bytes);
+
+        OwnPtr<Scene> loaded_scene = Scene::create();
+        const ReadonlyByteSpan scene_span = ReadonlyByteSpan(scene_bytes.elements(), scene_bytes.count());
+        SE_TEST_CHECK(BinarySceneSerializer(*loaded_scene, component_reflector_registry).deserialize_from_memory(scene_span));
+        SE_TEST_CHECK(loaded_scene->get_entity_count() == 0);
+    }
+
+    component_reflector_registry.shutdown();
+}
+
+SE_TEST(binary_scene_serializer_rejects_duplicate_entity_uuids)
+{
+    ComponentReflectorRegistry component_reflector_registry;
+    initialize_test_component_reflector_registry(component_reflector_registry);
+
+    OwnPtr<Scene> source_scene = Scene::create();
+    generate_test_scene(*source_scene, 100, 7);
+    Vector<u8> scene_bytes;
+    BinarySceneSerializer(*source_scene, component_reflector_registry).serialize_to_memory(scene_bytes);
+
+    // The entities of the scene already exist, so loading the same scene a second time fails.
+    OwnPtr<Scene> scene = Scene::create();
+    const ReadonlyByteSpan scene_span = ReadonlyByteSpan(scene_bytes.elements(), scene_bytes.count());
+    SE_TEST_CHECK(BinarySceneSerializer(*scene, component_reflector_registry).deserialize_from_memory(scene_span));
+    SE_TEST_CHECK(!BinarySceneSerializer(*scene, component_reflector_registry).deserialize_from_memory(scene_span));
+    SE_TEST_CHECK(are_test_scenes_equal(*source_scene, *scene));
+
+    // Two entities of the scene have the same UUID.
+    BinarySceneTables tables = get_binary_scene_tables(scene_bytes);
+    tables.entity_records[60].uuid = tables.entity_records[20].uuid;
+    OwnPtr<Scene> empty_scene = Scene::create();
+    SE_TEST_CHECK(!BinarySceneSerializer(*empty_scene, component_reflector_registry).deserialize_from_memory(scene_span));
+    SE_TEST_CHECK(empty_scene->get_entity_count() == 0);
+
+    scene.release();
+    source_scene.release();
+    component_reflector_registry.shutdown();
+}
+
+SE_TEST(binary_scene_serializer_rejects_corrupted_scenes_without_modifying_the_scene)
+{
+    ComponentReflectorRegistry component_reflector_registry;
+    initialize_test_component_reflector_registry(component_reflector_registry);
+
+    Vector<u8> valid_scene_bytes;
+    {
+        OwnPtr<Scene> source_scene = Scene::create();
+        generate_test_scene(*source_scene, 300, 9);
+        add_test_labels(*source_scene);
+        BinarySceneSerializer(*source_scene, component_reflector_registry).serialize_to_memory(valid_scene_bytes);
+    }
+
+    // Loads the scene after applying the given modification into a scene that already contains an entity. Returns true
+    // if loading the scene fails and the scene is left unchanged.
+    const UUID existing_entity_uuid = UUID(0x5EED);
+    const auto check_rejected = [&](auto modify_function) -> bool
+    {
+        Vector<u8> scene_bytes = valid_scene_bytes;
+        BinarySceneTables tables = get_binary_scene_tables(scene_bytes);
+        modify_function(scene_bytes, tables);
+
+        OwnPtr<Scene> scene = Scene::create();
+        scene->create_entity_with_uuid(existing_entity_uuid);
+        const ReadonlyByteSpan scene_span = ReadonlyByteSpan(scene_bytes.elements(), scene_bytes.count());
+        const bool is_loaded = BinarySceneSerializer(*scene, component_reflector_registry).deserialize_from_memory(scene_span);
+        return !is_loaded && scene->get_entity_count() == 1 && scene->get_entity_from_uuid(existing_entity_uuid) != nullptr;
+    };
+
+    // The header is incomplete or invalid, or the tables don't fit in the scene.
+    SE_TEST_CHECK(check_rejected([](Vector<u8>& bytes, BinarySceneTables&) { bytes.remove_last(bytes.count() - sizeof(BinarySceneHeader) + 1); }));
+    SE_TEST_CHECK(check_rejected([](Vector<u8>&, BinarySceneTables& tables) { tables.header->magic = 0; }));
+    SE_TEST_CHECK(check_rejected([](Vector<u8>&, BinarySceneTables& tables) { tables.header->entity_count = 0x10000000; }));
+    SE_TEST_CHECK(check_rejected([](Vector<u8>&, BinarySceneTables& tables) { tables.header->string_table_byte_count += 1; }));
+
+    // An entity record is invalid, or its name is not valid UTF-8.
+    SE_TEST_CHECK(check_rejected([](Vector<u8>&, BinarySceneTables& tables) { tables.entity_records[100].uuid = UUID::invalid().value(); }));
+    SE_TEST_CHECK(check_rejected([](Vector<u8>&, BinarySceneTables& tables)
+                                 { tables.entity_records[299].name.offset = static_cast<u32>(tables.header->string_table_byte_count); }));
+    SE_TEST_CHECK(check_rejected([](Vector<u8>& bytes, BinarySceneTables& tables)
+                                 { bytes[tables.header->string_table_offset + tables.entity_records[0].name.offset] = 0xFF; }));
+
+    // A component type record is invalid. The last component type is corrupted, so the records of the other component
+    // types have already been processed when the corruption is found.
+    const auto get_last_component_type_record = [](BinarySceneTables& tables) -> BinarySceneComponentTypeRecord&
+    {
+        return tables.component_type_records[tables.header->component_type_count - 1];
+    };
+    SE_TEST_CHECK(check_rejected([&](Vector<u8>&, BinarySceneTables& tables)
+                                 { get_last_component_type_record(tables).first_field_index = tables.header->field_count; }));
+    SE_TEST_CHECK(check_rejected([&](Vector<u8>&, BinarySceneTables& tables) { get_last_component_type_record(tables).value_range_count += 1; }));
+    SE_TEST_CHECK(check_rejected([&](Vector<u8>&, BinarySceneTables& tables) { get_last_component_type_record(tables).instance_count = 0x40000000; }));
+    SE_TEST_CHECK(check_rejected(
+        [&](Vector<u8>&, BinarySceneTables& tables)
+        {
+            BinarySceneComponentTypeRecord& component_type_record = get_last_component_type_record(tables);
+            tables.get_entity_indices(component_type_record)[component_type_record.instance_count - 1] = tables.header->entity_count;
+        }
+    ));
+
+    // A value range or a field record is invalid.
+    SE_TEST_CHECK(check_rejected([&](Vector<u8>&, BinarySceneTables& tables)
+                                 { tables.value_range_records[tables.header->value_range_count - 1].values_offset += 4; }));
+    SE_TEST_CHECK(check_rejected([&](Vector<u8>&, BinarySceneTables& tables)
+                                 { tables.value_range_records[tables.header->value_range_count - 1].element_byte_count = 0x1000000; }));
+    SE_TEST_CHECK(check_rejected([&](Vector<u8>&, BinarySceneTables& tables)
+                                 { tables.field_records[tables.header->field_count - 1].value_range_index = tables.header->value_range_count; }));
+    SE_TEST_CHECK(check_rejected([&](Vector<u8>&, BinarySceneTables& tables)
+                                 { tables.field_records[tables.header->field_count - 1].byte_offset_in_value_range += 1; }));
+    SE_TEST_CHECK(check_rejected([&](Vector<u8>&, BinarySceneTables& tables)
+                                 { tables.field_records[0].type = static_cast<ComponentFieldType>(0x3E7); }));
+
+    // A string value is corrupted. This is only found while decoding the components, so the entities that have already
+    // been created must be destroyed.
+    SE_TEST_CHECK(check_rejected(
+        [&](Vector<u8>&, BinarySceneTables& tables)
+        {
+            const BinarySceneComponentTypeRecord& label_record = tables.get_component_type_record(TestLabelComponent::get_static_component_type_uuid());
+            tables.get_label_string_references()[label_record.instance_count / 2].byte_count = 0xFFFFFFFF;
+        }
+    ));
+
+    // The unmodified scene is still valid.
+    SE_TEST_CHECK(!check_rejected([](Vector<u8>&, BinarySceneTables&) {}));
+
+    // Any corruption must be handled without crashing. It can't always be detected (a changed field value is still a valid
+    // value), but the scene must not be modified when it is.
+    TestRandomGenerator random_generator = { 10 };
+    u32 invalid_scene_count = 0;
+    for (u32 iteration_index = 0; iteration_index < 1000; ++iteration_index)
+    {
+        Vector<u8> scene_bytes = valid_scene_bytes;
+        // Most of the file is made of values, so the bytes of the header and the tables are corrupted more often.
+        const usize corrupted_byte_count = (iteration_index % 2) ? scene_bytes.count() : valid_scene_bytes.count() / 8;
+        scene_bytes[random_generator.next() % corrupted_byte_count] ^= static_cast<u8>(1 + random_generator.next() % 255);
+
+        OwnPtr<Scene> scene = Scene::create();
+        scene->create_entity_with_uuid(existing_entity_uuid);
+        const ReadonlyByteSpan scene_span = ReadonlyByteSpan(scene_bytes.elements(), scene_bytes.count());
+        if (!BinarySceneSerializer(*scene, component_reflector_registry).deserialize_from_memory(scene_span))
+        {
+            ++invalid_scene_count;
+            SE_TEST_CHECK(scene->get_entity_count() == 1);
+        }
+    }
+    SE_TEST_CHECK(invalid_scene_count > 0);
+
+    component_reflector_registry.shutdown();
+}
+
+SE_TEST(binary_scene_serializer_decodes_large_scenes_in_parallel)
+{
+    ComponentReflectorRegistry component_reflector_registry;
+    initialize_test_component_reflector_registry(component_reflector_registry);
+
+    // The 10000 transforms, 5000 sprites and 3334 labels are split in many jobs, which are decoded by several threads.
+    OwnPtr<Scene> source_scene = Scene::create();
+    generate_test_scene(*source_scene, 10000, 11);
+    add_test_labels(*source_scene);
+    Vector<u8> scene_bytes;
+    BinarySceneSerializer(*source_scene, component_reflector_registry).serialize_to_memory(scene_bytes);
+    const ReadonlyByteSpan scene_span = ReadonlyByteSpan(scene_bytes.elements(), scene_bytes.count());
+
+    for (const u32 decode_thread_count : { 1, 4 })
+    {
+        OwnPtr<Scene> loaded_scene = Scene::create();
+        BinarySceneSerializer serializer = BinarySceneSerializer(*loaded_scene, component_reflector_registry);
+        serializer.set_max_decode_thread_count(decode_thread_count);
+        if (SE_TEST_CHECK(serializer.deserialize_from_memory(scene_span)))
+        {
+            SE_TEST_CHECK(are_test_scenes_equal(*source_scene, *loaded_scene));
+            SE_TEST_CHECK(are_test_labels_equal(*source_scene, *loaded_scene));
+        }
+    }
+
+    source_scene.release();
+    component_reflector_registry.shutdown();
+}
+
+SE_TEST(binary_scene_serializer_releases_the_staged_components_when_parallel_decoding_fails)
+{
+    ComponentReflectorRegistry component_reflector_registry;
+    initialize_test_component_reflector_registry(component_reflector_registry);
+
+    Vector<u8> valid_scene_bytes;
+    {
+        OwnPtr<Scene> source_scene = Scene::create();
+        generate_test_scene(*source_scene, 10000, 12);
+        add_test_labels(*source_scene);
+        BinarySceneSerializer(*source_scene, component_reflector_registry).serialize_to_memory(valid_scene_bytes);
+    }
+    const i32 live_label_component_count = s_live_label_component_count.load();
+
+    // The corrupted label is decoded by the first, a middle or the last job, so when the decoding stops some of the staged
+    // components have been decoded and others are still null.
+    const UUID existing_entity_uuid = UUID(0x5EED);
+    const UUID label_type_uuid = TestLabelComponent::get_static_component_type_uuid();
+    const u32 label_count = get_binary_scene_tables(valid_scene_bytes).get_component_type_record(label_type_uuid).instance_count;
+    for (const u32 corrupted_instance_index : { 0U, label_count / 2, label_count - 1 })
+    {
+        Vector<u8> scene_bytes = valid_scene_bytes;
+        get_binary_scene_tables(scene_bytes).get_label_string_references()[corrupted_instance_index].offset = 0xFFFFFFFF;
+
+        OwnPtr<Scene> scene = Scene::create();
+        scene->create_entity_with_uuid(existing_entity_uuid);
+        BinarySceneSerializer serializer = BinarySceneSerializer(*scene, component_reflector_registry);
+        serializer.set_max_decode_thread_count(4);
+        SE_TEST_CHECK(!serializer.deserialize_from_memory(ReadonlyByteSpan(scene_bytes.elements(), scene_bytes.count())));
+        SE_TEST_CHECK(scene->get_entity_count() == 1 && scene->get_entity_from_uuid(existing_entity_uuid) != nullptr);
+        SE_TEST_CHECK(s_live_label_component_count.load() == live_label_component_count);
+    }
+
+    component_reflector_registry.shutdown();
+}
+
+SE_BENCHMARK(binary_scene_serializer_parallel_decode_scaling)
+{
+    constexpr u32 entity_count = 200000;
+    ComponentReflectorRegistry component_reflector_registry;
+    component_reflector_registry.initialize();
+
+    Vector<u8> scene_bytes;
+    {
+        OwnPtr<Scene> source_scene = Scene::create();
+        generate_test_scene(*source_scene, entity_count, 13);
+        BinarySceneSerializer(*source_scene, component_reflector_registry).serialize_to_memory(scene_bytes);
+    }
+    const ReadonlyByteSpan scene_span = ReadonlyByteSpan(scene_bytes.elements(), scene_bytes.count());
+    SE_LOG_INFO("    Scene: {} entities, {} bytes", entity_count, scene_bytes.count());
+
+    // The first load grows the heap, which the following loads reuse, so it is not measured.
+    {
+        OwnPtr<Scene> scene = Scene::create();
+        SE_TEST_CHECK(BinarySceneSerializer(*scene, component_reflector_registry).deserialize_from_memory(scene_span));
+    }
+
+    // The thread count is doubled until all the hardware threads are used. Only the loading is measured, while the
+    // scenes are created and destroyed outside of the measurement.
+    const u32 hardware_thread_count = Math::max(Thread::get_hardware_concurrency(), 1U);
+    u64 single_thread_ticks = 0;
+    for (u32 decode_thread_count = 1;; decode_thread_count = Math::min(decode_thread_count * 2, hardware_thread_count))
+    {
+        OwnPtr<Scene> scene = Scene::create();
+        BinarySceneSerializer serializer = BinarySceneSerializer(*scene, component_reflector_registry);
+        serializer.set_max_decode_thread_count(decode_thread_count);
+
+        const u64 start_tick_counter = Platform::get_current_tick_counter();
+        SE_TEST_CHECK(serializer.deserialize_from_memory(scene_span));
+        const u64 elapsed_ticks = Platform::get_current_tick_counter() - start_tick_counter;
+
+        if (decode_thread_count == 1)
+            single_thread_ticks = elapsed_ticks;
+        const double speedup = static_cast<double>(single_thread_ticks) / static_cast<double>(Math::max<u64>(elapsed_ticks, 1));
+        const u64 elapsed_milliseconds = (elapsed_ticks * 1000) / Platform::get_tick_counter_frequency();
+        SE_LOG_INFO("    {} threads: {} ms ({:.2f}x)", decode_thread_count, elapsed_milliseconds, speedup);
+
+        if (decode_thread_count == hardware_thread_count)
+            break;
+    }
+
+    component_reflector_registry.shutdown();
+}
+
+} // namespace SE
@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Renderer/Pipeline.h>
+#include <Renderer/RenderPassRegisterSet.h>
+#include <TestFramework.h>
+
+namespace SE
+{
+
+//
+// Stands in for the device of a rendering backend, counting the bind calls that are issued and the registers they cover,
+// so the tests (and the benchmark) don't require a rendering device.
+//
+struct CountingBindDevice
+{
+    u32 bind_call_count { 0 };
+    u32 bound_register_count { 0 };
+    u32 last_first_register { 0 };
+
+    ALWAYS_INLINE void bind(u32 first_register, u32 register_count)
+    {
+        ++bind_call_count;
+        bound_register_count += register_count;
+        last_first_register = first_register;
+    }
+};
+
+// The register set binds handles, which are only compared by address.
+struct FakeResourceHandle
+{
+    u32 value;
+};
+
+using FakeRegisterSet = RenderPassRegisterSet<FakeResourceHandle, 16>;
+
+NODISCARD static bool bind_registers(FakeRegisterSet& register_set, CountingBindDevice& device, bool bind_all_registers = false)
+{
+    return register_set.bind_changed_registers(
+        bind_all_registers,
+        [&device](u32 first_register, u32 register_count, FakeResourceHandle* const*)
+        {
+            device.bind(first_register, register_count);
+        }
+    );
+}
+
+SE_TEST(pipeline_binding_layout_resolves_inputs_once)
+{
+    Vector<PipelineInputDescription> input_descriptions;
+    input_descriptions.add({ PipelineInputType::UniformBuffer, "u_FrameData"sv, ShaderStage::Vertex });
+    input_descriptions.add({ PipelineInputType::UniformBuffer, "u_Material"sv, ShaderStage::Fragment });
+    input_descriptions.add({ PipelineInputType::TextureArray, "u_Textures"sv, ShaderStage::Fragment, 8 });
+    input_descriptions.add({ PipelineInputType::UniformBuffer, "u_ObjectData"sv, ShaderStage::Vertex });
+    input_descriptions.add({ PipelineInputType::Texture, "u_Mask"sv, ShaderStage::Fragment });
+
+    const Span<const PipelineInputDescription> inputs = Span<const PipelineInputDescription>(input_descriptions.elements(), input_descriptions.count());
+    const PipelineBindingLayout binding_layout = PipelineBindingLayout(inputs);
+    SE_TEST_CHECK(binding_layout.get_input_count() == 5);
+
+    // The binding slots are the indices of the inputs in the description.
+    SE_TEST_CHECK(binding_layout.get_binding_slot("u_FrameData"sv) == 0);
+    SE_TEST_CHECK(binding_layout.get_binding_slot("u_Material"sv) == 1);
+    SE_TEST_CHECK(binding_layout.get_binding_slot("u_Textures"sv) == 2);
+    SE_TEST_CHECK(binding_layout.get_binding_slot("u_ObjectData"sv) == 3);
+    SE_TEST_CHECK(binding_layout.get_binding_slot("u_Mask"sv) == 4);
+    SE_TEST_CHECK(binding_layout.get_binding_slot("u_Unknown"sv) == invalid_pipeline_binding_slot);
+
+    // The constant buffer registers are assigned separately for each shader stage.
+    SE_TEST_CHECK(binding_layout.get_input(0).first_register == 0);
+    SE_TEST_CHECK(binding_layout.get_input(1).first_register == 0);
+    SE_TEST_CHECK(binding_layout.get_input(3).first_register == 1);
+    SE_TEST_CHECK(binding_layout.get_vertex_constant_buffer_register_count() == 2);
+    SE_TEST_CHECK(binding_layout.get_fragment_constant_buffer_register_count() == 1);
+
+    // A texture array occupies consecutive shader resource registers, but a single sampler register.
+    const PipelineInputBinding& textures_input = binding_layout.get_input(2);
+    SE_TEST_CHECK(textures_input.first_register == 0);
+    SE_TEST_CHECK(textures_input.register_count == 8);
+    SE_TEST_CHECK(textures_input.sampler_register == 0);
+
+    const PipelineInputBinding& mask_input = binding_layout.get_input(4);
+    SE_TEST_CHECK(mask_input.first_register == 8);
+    SE_TEST_CHECK(mask_input.register_count == 1);
+    SE_TEST_CHECK(mask_input.sampler_register == 1);
+
+    SE_TEST_CHECK(binding_layout.get_shader_resource_register_count() == 9);
+    SE_TEST_CHECK(binding_layout.get_sampler_register_count() == 2);
+}
+
+SE_TEST(render_pass_register_set_only_rebinds_changed_registers)
+{
+    FakeResourceHandle handles[4] = {};
+    FakeRegisterSet register_set;
+    register_set.register_count = 8;
+    for (u32 register_index = 0; register_index < register_set.register_count; ++register_index)
+        register_set.current_handles[register_index] = &handles[register_index % 4];
+
+    // The first bind covers all registers.
+    CountingBindDevice device;
+    SE_TEST_CHECK(bind_registers(register_set, device));
+    SE_TEST_CHECK(device.bind_call_count == 1);
+    SE_TEST_CHECK(device.bound_register_count == 8);
+
+    // Nothing is bound if nothing changed, even if the same handles are set again.
+    register_set.current_handles[2] = &handles[2];
+    SE_TEST_CHECK(!bind_registers(register_set, device));
+    SE_TEST_CHECK(device.bind_call_count == 1);
+
+    // A single call covers the range between the first and the last changed registers.
+    register_set.current_handles[2] = &handles[3];
+    register_set.current_handles[5] = &handles[0];
+    SE_TEST_CHECK(bind_registers(register_set, device));
+    SE_TEST_CHECK(device.bind_call_count == 2);
+    SE_TEST_CHECK(device.last_first_register == 2);
+    SE_TEST_CHECK(device.bound_register_count == 8 + 4);
+
+    // A change of the last register is bound on its own.
+    register_set.current_handles[7] = &handles[1];
+    SE_TEST_CHECK(bind_registers(register_set, device));
+    SE_TEST_CHECK(device.last_first_register == 7);
+    SE_TEST_CHECK(device.bound_register_count == 8 + 4 + 1);
+
+    // A full re-bind (requested when the render pass begins) covers all registers again.
+    SE_TEST_CHECK(bind_registers(register_set, device, true));
+    SE_TEST_CHECK(device.bind_call_count == 4);
+    SE_TEST_CHECK(device.bound_register_count == 8 + 4 + 1 + 8);
+}
+
+//
+// Simulates the batches of a frame, where each batch updates the texture array input of the quad render pass and binds
+// the inputs. The textures of consecutive batches are mostly the same, so most batches shouldn't issue any bind call.
+//
+SE_BENCHMARK(render_pass_binding_per_batch)
+{
+    Vector<PipelineInputDescription> input_descriptions;
+    input_descriptions.add({ PipelineInputType::UniformBuffer, "u_FrameData"sv, ShaderStage::Vertex });
+    input_descriptions.add({ PipelineInputType::TextureArray, "u_Textures"sv, ShaderStage::Fragment, 8 });
+    const Span<const PipelineInputDescription> inputs = Span<const PipelineInputDescription>(input_descriptions.elements(), input_descriptions.count());
+    const PipelineBindingLayout binding_layout = PipelineBindingLayout(inputs);
+
+    FakeResourceHandle handles[16] = {};
+    FakeRegisterSet register_set;
+    register_set.register_count = binding_layout.get_shader_resource_register_count();
+
+    constexpr u32 batch_count = 10000000;
+    CountingBindDevice device;
+
+    const u64 start_tick_counter = Platform::get_current_tick_counter();
+    // The binding slot is resolved once, as the renderer does.
+    const PipelineBindingSlot textures_binding_slot = binding_layout.get_binding_slot("u_Textures"sv);
+    const PipelineInputBinding& textures_input = binding_layout.get_input(textures_binding_slot);
+    for (u32 batch_index = 0; batch_index < batch_count; ++batch_index)
+    {
+        // Every 16th batch uses a different texture in its last slot.
+        const u32 texture_variant = (batch_index / 16) % 2;
+        for (u32 texture_index = 0; texture_index < textures_input.register_count; ++texture_index)
+            register_set.current_handles[textures_input.first_register + texture_index] = &handles[texture_index + (texture_index == 7 ? texture_variant : 0)];
+        MAYBE_UNUSED const bool has_bound_registers = bind_registers(register_set, device);
+    }
+    const u64 elapsed_ticks = Platform::get_current_tick_counter() - start_tick_counter;
+
+    SE_TEST_CHECK(device.bind_call_count < batch_count / 8);
+    test_context.report_duration("update and bind"sv, batch_count, elapsed_ticks);
+    SE_LOG_INFO("    bind calls: {} for {} batches ({} registers)", device.bind_call_count, batch_count, device.bound_register_count);
+
+    // The lookup by name, which the slots replace in the batch loop.
+    constexpr u32 lookup_count = 10000000;
+    const Name names[2] = { Name("u_FrameData"sv), Name("u_Textures"sv) };
+    u64 binding_slot_sum = 0;
+    const u64 lookup_start_tick_counter = Platform::get_current_tick_counter();
+    for (u32 lookup_index = 0; lookup_index < lookup_count; ++lookup_index)
+        binding_slot_sum += binding_layout.get_binding_slot(names[lookup_index % 2]);
+    const u64 lookup_elapsed_ticks = Platform::get_current_tick_counter() - lookup_start_tick_counter;
+
+    SE_TEST_CHECK(binding_slot_sum == lookup_count / 2);
+    test_context.report_duration("get_binding_slot"sv, lookup_count, lookup_elapsed_ticks);
+}
+
+} // namespace SE
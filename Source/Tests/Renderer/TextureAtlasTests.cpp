@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/Containers/Vector.h>
+#include <Core/Math/MathCore.h>
+#include <Core/Memory/Buffer.h>
+#include <Core/Memory/MemoryOperations.h>
+#include <Renderer/RectanglePacker.h>
+#include <Renderer/TextureAtlas.h>
+#include <TestFramework.h>
+
+namespace SE
+{
+
+NODISCARD static bool are_rectangles_overlapping(const PackedRectangle& a, const PackedRectangle& b)
+{
+    return a.x < b.x + b.width && b.x < a.x + a.width && a.y < b.y + b.height && b.y < a.y + a.height;
+}
+
+SE_TEST(skyline_packer_places_rectangles_inside_the_page_without_overlap)
+{
+    constexpr u32 page_width = 512;
+    constexpr u32 page_height = 256;
+    SkylineRectanglePacker packer = SkylineRectanglePacker(page_width, page_height);
+    TestRandomGenerator random_generator = { 7 };
+
+    // Random sizes are packed until the packer rejects a few of them in a row, which only happens when the page is mostly full.
+    Vector<PackedRectangle> rectangles;
+    u64 packed_area = 0;
+    for (u32 rejected_count = 0; rejected_count < 32;)
+    {
+        const u32 width = 1 + static_cast<u32>(random_generator.next() % 48);
+        const u32 height = 1 + static_cast<u32>(random_generator.next() % 48);
+        const Optional<PackedRectangle> rectangle = packer.pack(width, height);
+        if (!rectangle.has_value())
+        {
+            ++rejected_count;
+            continue;
+        }
+
+        SE_TEST_CHECK(rectangle->width == width && rectangle->height == height);
+        rectangles.add(rectangle.value());
+        packed_area += static_cast<u64>(width) * height;
+    }
+
+    bool are_inside_page = true;
+    bool are_overlapping = false;
+    for (usize index = 0; index < rectangles.count(); ++index)
+    {
+        const PackedRectangle& rectangle = rectangles[index];
+        are_inside_page &= (rectangle.x + rectangle.width <= page_width && rectangle.y + rectangle.height <= page_height);
+        for (usize other_index = index + 1; other_index < rectangles.count(); ++other_index)
+            are_overlapping |= are_rectangles_overlapping(rectangle, rectangles[other_index]);
+    }
+    SE_TEST_CHECK(are_inside_page);
+    SE_TEST_CHECK(!are_overlapping);
+
+    // The occupancy is the packed area, and the skyline heuristic wastes little of the page with these sizes.
+    const float occupancy = static_cast<float>(packed_area) / static_cast<float>(page_width * page_height);
+    SE_TEST_CHECK(packer.get_occupancy() == occupancy);
+    SE_TEST_CHECK(occupancy > 0.75F);
+}
+
+SE_TEST(skyline_packer_fills_a_page)
+{
+    SkylineRectanglePacker packer = SkylineRectanglePacker(128, 64);
+
+    // Rectangles that tile the page exactly cover all of it, without any space left.
+    for (u32 rectangle_index = 0; rectangle_index < (128 / 16) * (64 / 32); ++rectangle_index)
+        SE_TEST_CHECK(packer.pack(16, 32).has_value());
+    SE_TEST_CHECK(packer.get_occupancy() == 1.0F);
+    SE_TEST_CHECK(!packer.pack(1, 1).has_value());
+
+    // Rectangles that are empty or larger than the page never fit.
+    packer.reset();
+    SE_TEST_CHECK(packer.get_occupancy() == 0.0F);
+    SE_TEST_CHECK(!packer.pack(0, 10).has_value() && !packer.pack(10, 0).has_value());
+    SE_TEST_CHECK(!packer.pack(129, 1).has_value() && !packer.pack(1, 65).has_value());
+
+    // A rectangle of the size of the page fits in an empty page, at its origin.
+    const Optional<PackedRectangle> page_rectangle = packer.pack(128, 64);
+    SE_TEST_CHECK(page_rectangle.has_value() && page_rectangle->x == 0 && page_rectangle->y == 0);
+    SE_TEST_CHECK(!packer.pack(1, 1).has_value());
+
+    // A tall rectangle leaves a narrow column, which is still used by the rectangles that fit in it.
+    packer.reset();
+    SE_TEST_CHECK(packer.pack(120, 64).has_value());
+    const Optional<PackedRectangle> column_rectangle = packer.pack(8, 64);
+    SE_TEST_CHECK(column_rectangle.has_value() && column_rectangle->x == 120 && column_rectangle->y == 0);
+    SE_TEST_CHECK(!packer.pack(1, 1).has_value());
+}
+
+// Creates an image whose pixels are all different, so a pixel copied from the wrong location is detected.
+NODISCARD static Buffer create_test_image(u32 width, u32 height, u8 seed)
+{
+    Buffer pixels = Buffer::create(static_cast<usize>(width) * height * 4);
+    for (u32 y = 0; y < height; ++y)
+    {
+        for (u32 x = 0; x < width; ++x)
+        {
+            u8* pixel = pixels.bytes() + (static_cast<usize>(y) * width + x) * 4;
+            pixel[0] = static_cast<u8>(x);
+            pixel[1] = static_cast<u8>(y);
+            pixel[2] = seed;
+            pixel[3] = 255;
+        }
+    }
+    return pixels;
+}
+
+SE_TEST(texture_atlas_extrudes_the_edges_of_the_images_into_the_padding)
+{
+    TextureAtlasDescription description;
+    description.page_width = 64;
+    description.page_height = 64;
+    description.padding = 2;
+    description.mode = TextureAtlasMode::Offline;
+    TextureAtlas atlas = TextureAtlas(description);
+
+    const u32 image_sizes[][2] = { { 10, 6 }, { 1, 1 }, { 7, 13 }, { 20, 3 } };
+    for (u32 image_index = 0; image_index < SE_ARRAY_COUNT(image_sizes); ++image_index)
+    {
+        const u32 width = image_sizes[image_index][0];
+        const u32 height = image_sizes[image_index][1];
+        const Buffer image = create_test_image(width, height, static_cast<u8>(image_index + 1));
+        const Optional<TextureAtlasRegion> region = atlas.add_image(width, height, image.readonly_byte_span());
+        if (!SE_TEST_CHECK(region.has_value() && region->page_index == 0))
+            continue;
+
+        // The UV rectangle covers exactly the image, in pixels of the page.
+        const u32 image_x = static_cast<u32>(region->uv_rect.min.x * 64.0F);
+        const u32 image_y = static_cast<u32>(region->uv_rect.min.y * 64.0F);
+        SE_TEST_CHECK(region->uv_rect.max.x * 64.0F == static_cast<float>(image_x + width));
+        SE_TEST_CHECK(region->uv_rect.max.y * 64.0F == static_cast<float>(image_y + height));
+        if (!SE_TEST_CHECK(image_x >= description.padding && image_y >= description.padding))
+            continue;
+
+        // Every pixel of the padded block is the pixel of the image that is the closest to it.
+        const ReadonlyByteSpan page_pixels = atlas.get_page_pixels(0);
+        bool are_pixels_correct = true;
+        for (u32 block_y = 0; block_y < height + 2 * description.padding; ++block_y)
+        {
+            for (u32 block_x = 0; block_x < width + 2 * description.padding; ++block_x)
+            {
+                const u32 page_x = image_x - description.padding + block_x;
+                const u32 page_y = image_y - description.padding + block_y;
+                const u32 source_x = Math::clamp(block_x, description.padding, description.padding + width - 1) - description.padding;
+                const u32 source_y = Math::clamp(block_y, description.padding, description.padding + height - 1) - description.padding;
+                const u8* page_pixel = page_pixels.elements() + (static_cast<usize>(page_y) * description.page_width + page_x) * 4;
+                const u8* source_pixel = image.bytes() + (static_cast<usize>(source_y) * width + source_x) * 4;
+                are_pixels_correct &= (page_pixel[0] == source_pixel[0] && page_pixel[1] == source_pixel[1] && page_pixel[2] == source_pixel[2]);
+            }
+        }
+        SE_TEST_CHECK(are_pixels_correct);
+    }
+}
+
+SE_TEST(texture_atlas_creates_a_page_when_the_current_one_is_full)
+{
+    TextureAtlasDescription description;
+    description.page_width = 32;
+    description.page_height = 32;
+    description.padding = 1;
+    description.mode = TextureAtlasMode::Offline;
+    TextureAtlas atlas = TextureAtlas(description);
+
+    // Four padded 14x14 images fill a page exactly, so the fifth one starts a new page.
+    const Buffer image = create_test_image(14, 14, 1);
+    for (u32 image_index = 0; image_index < 4; ++image_index)
+    {
+        const Optional<TextureAtlasRegion> region = atlas.add_image(14, 14, image.readonly_byte_span());
+        SE_TEST_CHECK(region.has_value() && region->page_index == 0);
+    }
+    SE_TEST_CHECK(atlas.get_page_count() == 1 && atlas.get_page_occupancy(0) == 1.0F);
+
+    const Optional<TextureAtlasRegion> fifth_region = atlas.add_image(14, 14, image.readonly_byte_span());
+    SE_TEST_CHECK(fifth_region.has_value() && fifth_region->page_index == 1);
+    SE_TEST_CHECK(atlas.get_page_count() == 2);
+
+    // An image that only fits in a page without its padding is rejected, and so is an empty image.
+    const Buffer large_image = create_test_image(31, 31, 2);
+    SE_TEST_CHECK(!atlas.add_image(31, 31, large_image.readonly_byte_span()).has_value());
+    SE_TEST_CHECK(!atlas.add_image(0, 0, ReadonlyByteSpan()).has_value());
+    SE_TEST_CHECK(atlas.get_page_count() == 2);
+
+    atlas.clear();
+    SE_TEST_CHECK(atlas.get_page_count() == 0);
+}
+
+} // namespace SE
@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Renderer/TransientUploadRing.h>
+#include <TestFramework.h>
+
+namespace SE
+{
+
+SE_TEST(transient_upload_ring_allocates_linearly_inside_a_frame)
+{
+    TransientUploadRing ring = TransientUploadRing(1024, 2);
+    ring.begin_frame();
+
+    const Optional<TransientUploadAllocation> first_allocation = ring.allocate(100);
+    const Optional<TransientUploadAllocation> second_allocation = ring.allocate(40);
+    const Optional<TransientUploadAllocation> third_allocation = ring.allocate(8, 64);
+    if (!SE_TEST_CHECK(first_allocation.has_value() && second_allocation.has_value() && third_allocation.has_value()))
+        return;
+
+    // Only the first allocation of the frame discards the previous contents of the buffer.
+    SE_TEST_CHECK(first_allocation->byte_offset == 0);
+    SE_TEST_CHECK(first_allocation->byte_count == 100);
+    SE_TEST_CHECK(first_allocation->discard_previous_contents);
+
+    // The offsets are aligned to the default alignment, or to the requested one.
+    SE_TEST_CHECK(second_allocation->byte_offset == 112);
+    SE_TEST_CHECK(!second_allocation->discard_previous_contents);
+    SE_TEST_CHECK(third_allocation->byte_offset == 192);
+    SE_TEST_CHECK(!third_allocation->discard_previous_contents);
+
+    SE_TEST_CHECK(first_allocation->buffer_index == ring.get_current_buffer_index());
+    SE_TEST_CHECK(ring.get_wrap_count() == 0);
+}
+
+SE_TEST(transient_upload_ring_wraps_around_when_the_buffer_is_full)
+{
+    TransientUploadRing ring = TransientUploadRing(256, 2);
+    ring.begin_frame();
+
+    // An allocation that ends exactly at the end of the buffer doesn't wrap around.
+    const Optional<TransientUploadAllocation> first_allocation = ring.allocate(128);
+    const Optional<TransientUploadAllocation> second_allocation = ring.allocate(128);
+    if (!SE_TEST_CHECK(first_allocation.has_value() && second_allocation.has_value()))
+        return;
+    SE_TEST_CHECK(second_allocation->byte_offset == 128);
+    SE_TEST_CHECK(!second_allocation->discard_previous_contents);
+    SE_TEST_CHECK(ring.get_wrap_count() == 0);
+
+    // The next allocation doesn't fit anymore, so it starts again at the beginning of the (discarded) buffer.
+    const Optional<TransientUploadAllocation> wrapped_allocation = ring.allocate(16);
+    if (!SE_TEST_CHECK(wrapped_allocation.has_value()))
+        return;
+    SE_TEST_CHECK(wrapped_allocation->byte_offset == 0);
+    SE_TEST_CHECK(wrapped_allocation->discard_previous_contents);
+    SE_TEST_CHECK(wrapped_allocation->buffer_index == first_allocation->buffer_index);
+    SE_TEST_CHECK(ring.get_wrap_count() == 1);
+
+    // After wrapping around, the allocations are linear again.
+    const Optional<TransientUploadAllocation> next_allocation = ring.allocate(16);
+    if (!SE_TEST_CHECK(next_allocation.has_value()))
+        return;
+    SE_TEST_CHECK(next_allocation->byte_offset == 16);
+    SE_TEST_CHECK(!next_allocation->discard_previous_contents);
+
+    // An allocation whose aligned offset passes the end of the buffer also wraps around.
+    MAYBE_UNUSED const Optional<TransientUploadAllocation> filling_allocation = ring.allocate(200);
+    const Optional<TransientUploadAllocation> aligned_allocation = ring.allocate(16, 64);
+    if (!SE_TEST_CHECK(aligned_allocation.has_value()))
+        return;
+    SE_TEST_CHECK(aligned_allocation->byte_offset == 0);
+    SE_TEST_CHECK(aligned_allocation->discard_previous_contents);
+    SE_TEST_CHECK(ring.get_wrap_count() == 2);
+}
+
+//
+// The ring doesn't wait on GPU fences: each frame in flight has its own buffer, so a buffer is only reused once the
+// frame that wrote it has been retired, which the end of the frame acts as the fence for. The first allocation made
+// from a reused buffer must discard its contents, so the data of the retired frame is never overwritten in place.
+//
+SE_TEST(transient_upload_ring_reclaims_the_buffers_of_retired_frames)
+{
+    constexpr u32 buffer_count = 3;
+    TransientUploadRing ring = TransientUploadRing(1024, buffer_count);
+
+    ring.begin_frame();
+    const u32 first_buffer_index = ring.get_current_buffer_index();
+    MAYBE_UNUSED const Optional<TransientUploadAllocation> first_frame_allocation = ring.allocate(512);
+    MAYBE_UNUSED const Optional<TransientUploadAllocation> wrapping_allocation = ring.allocate(1000);
+    SE_TEST_CHECK(ring.get_wrap_count() == 1);
+
+    // The frames in flight use the other buffers, starting from their beginning.
+    for (u32 frame_index = 1; frame_index < buffer_count; ++frame_index)
+    {
+        ring.begin_frame();
+        SE_TEST_CHECK(ring.get_current_buffer_index() != first_buffer_index);
+        SE_TEST_CHECK(ring.get_wrap_count() == 0);
+
+        const Optional<TransientUploadAllocation> allocation = ring.allocate(64);
+        if (SE_TEST_CHECK(allocation.has_value()))
+        {
+            SE_TEST_CHECK(allocation->buffer_index == ring.get_current_buffer_index());
+            SE_TEST_CHECK(allocation->byte_offset == 0);
+            SE_TEST_CHECK(allocation->discard_previous_contents);
+        }
+    }
+
+    // After all frames in flight, the buffer of the first frame is reclaimed.
+    ring.begin_frame();
+    SE_TEST_CHECK(ring.get_current_buffer_index() == first_buffer_index);
+    SE_TEST_CHECK(ring.get_wrap_count() == 0);
+
+    const Optional<TransientUploadAllocation> reclaimed_allocation = ring.allocate(64);
+    if (SE_TEST_CHECK(reclaimed_allocation.has_value()))
+    {
+        SE_TEST_CHECK(reclaimed_allocation->buffer_index == first_buffer_index);
+        SE_TEST_CHECK(reclaimed_allocation->byte_offset == 0);
+        SE_TEST_CHECK(reclaimed_allocation->discard_previous_contents);
+    }
+}
+
+SE_TEST(transient_upload_ring_rejects_oversize_allocations)
+{
+    TransientUploadRing ring = TransientUploadRing(1024, 2);
+    ring.begin_frame();
+
+    SE_TEST_CHECK(!ring.allocate(1025).has_value());
+    SE_TEST_CHECK(!ring.allocate(0).has_value());
+
+    // A rejected allocation doesn't modify the state of the ring.
+    const Optional<TransientUploadAllocation> first_allocation = ring.allocate(16);
+    if (SE_TEST_CHECK(first_allocation.has_value()))
+    {
+        SE_TEST_CHECK(first_allocation->byte_offset == 0);
+        SE_TEST_CHECK(first_allocation->discard_previous_contents);
+    }
+
+    // An allocation as large as the whole buffer is valid, but it always wraps around if the buffer isn't empty.
+    const Optional<TransientUploadAllocation> whole_buffer_allocation = ring.allocate(1024);
+    if (SE_TEST_CHECK(whole_buffer_allocation.has_value()))
+    {
+        SE_TEST_CHECK(whole_buffer_allocation->byte_offset == 0);
+        SE_TEST_CHECK(whole_buffer_allocation->discard_previous_contents);
+        SE_TEST_CHECK(ring.get_wrap_count() == 1);
+    }
+}
+
+SE_TEST(transient_upload_ring_aligns_offsets_near_the_end_of_a_large_buffer)
+{
+    // The aligned offset exceeds the range of a 32-bit integer, which must not overflow.
+    constexpr u32 buffer_byte_count = 0xFFFFFFF0;
+    TransientUploadRing ring = TransientUploadRing(buffer_byte_count, 1);
+    ring.begin_frame();
+
+    const Optional<TransientUploadAllocation> large_allocation = ring.allocate(buffer_byte_count - 8, 8);
+    const Optional<TransientUploadAllocation> aligned_allocation = ring.allocate(8, 256);
+    if (!SE_TEST_CHECK(large_allocation.has_value() && aligned_allocation.has_value()))
+        return;
+    SE_TEST_CHECK(aligned_allocation->byte_offset == 0);
+    SE_TEST_CHECK(aligned_allocation->discard_previous_contents);
+    SE_TEST_CHECK(ring.get_wrap_count() == 1);
+}
+
+SE_BENCHMARK(transient_upload_ring_allocation)
+{
+    constexpr u32 frame_count = 10000;
+    constexpr u32 allocations_per_frame = 1000;
+    TransientUploadRing ring = TransientUploadRing(4 * MiB, 3);
+
+    // The sizes are those of typical batches: a few quads up to a full batch of vertices.
+    u32 allocation_byte_count = 96;
+    u64 checksum = 0;
+
+    const u64 start_tick_counter = Platform::get_current_tick_counter();
+    for (u32 frame_index = 0; frame_index < frame_count; ++frame_index)
+    {
+        ring.begin_frame();
+        for (u32 allocation_index = 0; allocation_index < allocations_per_frame; ++allocation_index)
+        {
+            allocation_byte_count = 96 + ((allocation_byte_count * 1103515245 + 12345) % 16384);
+            const Optional<TransientUploadAllocation> allocation = ring.allocate(allocation_byte_count);
+            checksum += allocation->byte_offset;
+        }
+        checksum += ring.get_wrap_count();
+    }
+    const u64 elapsed_ticks = Platform::get_current_tick_counter() - start_tick_counter;
+
+    SE_TEST_CHECK(checksum > 0);
+    test_context.report_duration("allocate"sv, static_cast<u64>(frame_count) * allocations_per_frame, elapsed_ticks);
+}
+
+} // namespace SE
@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Core/CoreTypes.h>
+#include <Core/Log.h>
+#include <Core/Platform/Atomic.h>
+#include <Core/Platform/Platform.h>
+#include <Core/Platform/Thread.h>
+
+namespace SE
+{
+
+//
+// Collects the results of the checks made by a test, and reports the measurements made by a benchmark.
+//
+class TestContext
+{
+public:
+    ALWAYS_INLINE bool check(bool condition, const char* expression, const char* filepath, u32 line)
+    {
+        ++m_check_count;
+        if (!condition)
+        {
+            ++m_failed_check_count;
+            SE_LOG_ERROR("Check '{}' failed ({}:{})!", StringView::create_from_utf8(expression), StringView::create_from_utf8(filepath), line);
+        }
+        return condition;
+    }
+
+    NODISCARD ALWAYS_INLINE u64 get_check_count() const { return m_check_count; }
+    NODISCARD ALWAYS_INLINE u64 get_failed_check_count() const { return m_failed_check_count; }
+
+    // Reports the throughput of a benchmark that processed the given number of bytes in the given number of ticks.
+    void report_throughput(StringView measurement_name, u64 byte_count, u64 elapsed_ticks) const
+    {
+        const double elapsed_seconds = get_elapsed_seconds(elapsed_ticks);
+        const double mebibytes_per_second = (elapsed_seconds > 0.0) ? (static_cast<double>(byte_count) / (1024.0 * 1024.0)) / elapsed_seconds : 0.0;
+        SE_LOG_INFO("    {}: {:.1f} MiB/s", measurement_name, mebibytes_per_second);
+    }
+
+    // Reports the average duration of an operation of a benchmark that executed the given number of operations in the given number of ticks.
+    void report_duration(StringView measurement_name, u64 operation_count, u64 elapsed_ticks) const
+    {
+        const double elapsed_nanoseconds = get_elapsed_seconds(elapsed_ticks) * 1e9;
+        const double nanoseconds_per_operation = (operation_count > 0) ? elapsed_nanoseconds / static_cast<double>(operation_count) : 0.0;
+        SE_LOG_INFO("    {}: {:.2f} ns/operation", measurement_name, nanoseconds_per_operation);
+    }
+
+private:
+    NODISCARD ALWAYS_INLINE static double get_elapsed_seconds(u64 elapsed_ticks)
+    {
+        return static_cast<double>(elapsed_ticks) / static_cast<double>(Platform::get_tick_counter_frequency());
+    }
+
+private:
+    u64 m_check_count { 0 };
+    u64 m_failed_check_count { 0 };
+};
+
+//
+// Small pseudo-random generator (SplitMix64), used by the tests that check random inputs. The inputs are the same on
+// every run and every platform, so a failure can always be reproduced.
+// https://prng.di.unimi.it/splitmix64.c
+//
+struct TestRandomGenerator
+{
+    u64 state;
+
+    NODISCARD ALWAYS_INLINE u64 next()
+    {
+        u64 value = (state += 0x9E3779B97F4A7C15);
+        value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9;
+        value = (value ^ (value >> 27)) * 0x94D049BB133111EB;
+        return value ^ (value >> 31);
+    }
+};
+
+//
+// Measures the peak memory used by an operation, by sampling the resident memory of the process on a separate thread
+// between `start` and `stop`. The peak of the whole process can't be reset, so the peak is measured relative to the
+// memory that is resident when the sampling starts. Allocations that last less than the sampling interval might be missed.
+//
+class TestPeakMemorySampler
+{
+public:
+    void start()
+    {
+        m_baseline_byte_count = Platform::get_process_resident_byte_count();
+        m_peak_byte_count.store(m_baseline_byte_count);
+        m_is_sampling.store(true);
+        m_sampling_thread.start(sampling_thread_entry_point, this, "Peak Memory Sampler"sv);
+    }
+
+    // Returns the peak number of bytes that were resident in addition to the ones resident when the sampling started.
+    NODISCARD usize stop()
+    {
+        m_is_sampling.store(false);
+        m_sampling_thread.join();
+        sample();
+        const usize peak_byte_count = m_peak_byte_count.load();
+        return (peak_byte_count > m_baseline_byte_count) ? (peak_byte_count - m_baseline_byte_count) : 0;
+    }
+
+private:
+    static void sampling_thread_entry_point(void* user_data)
+    {
+        TestPeakMemorySampler& sampler = *static_cast<TestPeakMemorySampler*>(user_data);
+        while (sampler.m_is_sampling.load())
+        {
+            sampler.sample();
+            Thread::sleep_for_milliseconds(1);
+        }
+    }
+
+    ALWAYS_INLINE void sample()
+    {
+        const usize resident_byte_count = Platform::get_process_resident_byte_count();
+        usize peak_byte_count = m_peak_byte_count.load();
+        while (resident_byte_count > peak_byte_count && !m_peak_byte_count.compare_exchange(peak_byte_count, resident_byte_count))
+        {}
+    }
+
+private:
+    Thread m_sampling_thread;
+    Atomic<bool> m_is_sampling;
+    Atomic<usize> m_peak_byte_count;
+    usize m_baseline_byte_count { 0 };
+};
+
+using PFN_TestFunction = void (*)(TestContext&);
+
+enum class TestKind : u8
+{
+    // Executed every time the test program runs.
+    Test,
+    // Checks every possible input (such as all floating point values), which takes too long to be executed every time.
+    // Executed, together with the regular tests, only when the test program is invoked with `--exhaustive`.
+    ExhaustiveTest,
+    // Executed, instead of the tests, only when the test program is invoked with `--benchmarks`.
+    Benchmark,
+};
+
+//
+// Registers a test (or a benchmark) when the program starts, by adding it to a global linked list. The list is built
+// during the static initialization of the program, so the tests can be declared in any translation unit.
+//
+struct TestRegistration
+{
+    ALWAYS_INLINE TestRegistration(const char* in_name, PFN_TestFunction in_function, TestKind in_kind)
+        : name(in_name)
+        , function(in_function)
+        , kind(in_kind)
+        , next(s_first_registration)
+    {
+        s_first_registration = this;
+    }
+
+    const char* name;
+    PFN_TestFunction function;
+    TestKind kind;
+    TestRegistration* next;
+
+    // NOTE: Constant initialized, so it is valid before any registration is constructed.
+    static inline TestRegistration* s_first_registration = nullptr;
+};
+
+} // namespace SE
+
+#define SE_TEST_IMPL(function_name, test_kind)                                                                \
+    static void function_name(::SE::TestContext& test_context);                                               \
+    static ::SE::TestRegistration s_##function_name##_registration(#function_name, function_name, test_kind); \
+    static void function_name(MAYBE_UNUSED ::SE::TestContext& test_context)
+
+// Declares a test, which is executed every time the test program runs.
+#define SE_TEST(test_name) SE_TEST_IMPL(test_name, ::SE::TestKind::Test)
+
+// Declares an exhaustive test, which is only executed when the test program is invoked with `--exhaustive`.
+#define SE_EXHAUSTIVE_TEST(test_name) SE_TEST_IMPL(test_name, ::SE::TestKind::ExhaustiveTest)
+
+// Declares a benchmark, which is only executed when the test program is invoked with `--benchmarks`.
+#define SE_BENCHMARK(benchmark_name) SE_TEST_IMPL(benchmark_name, ::SE::TestKind::Benchmark)
+
+// Checks that the given expression is true, reporting the failure otherwise. Evaluates to the value of the expression.
+#define SE_TEST_CHECK(expression) test_context.check(static_cast<bool>(expression), #expression, __FILE__, __LINE__)
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/Containers/Span.h>
+#include <Core/Containers/Vector.h>
+#include <TestFramework.h>
+
+namespace SE
+{
+
+NODISCARD static bool is_selected(
+    const TestRegistration& registration, bool run_benchmarks, bool run_exhaustive_tests, const Vector<StringView>& selected_names
+)
+{
+    if (run_benchmarks != (registration.kind == TestKind::Benchmark))
+        return false;
+    if (registration.kind == TestKind::ExhaustiveTest && !run_exhaustive_tests)
+        return false;
+    if (selected_names.is_empty())
+        return true;
+
+    const StringView name = StringView::create_from_utf8(registration.name);
+    for (const StringView selected_name : selected_names)
+    {
+        if (name == selected_name)
+            return true;
+    }
+    return false;
+}
+
+//
+// Runs the tests of the engine, which don't require a window or a rendering device.
+// Usage: `SE-Tests [--benchmarks] [--exhaustive] [test names...]`. The benchmarks are executed instead of the tests when
+// `--benchmarks` is given, the exhaustive tests are executed together with the tests when `--exhaustive` is given, and
+// only the tests (or benchmarks) with the given names are executed if any name is given.
+//
+static i32 guarded_main(Span<char*> command_line_arguments)
+{
+    if (!Platform::initialize())
+        return 1;
+
+    bool run_benchmarks = false;
+    bool run_exhaustive_tests = false;
+    Vector<StringView> selected_names;
+    for (char* command_line_argument : command_line_arguments)
+    {
+        const StringView argument = StringView::create_from_utf8(command_line_argument);
+        if (argument == "--benchmarks"sv)
+            run_benchmarks = true;
+        else if (argument == "--exhaustive"sv)
+            run_exhaustive_tests = true;
+        else
+            selected_names.add(argument);
+    }
+
+    // NOTE: The registrations are linked in the reverse order of their construction, so they are collected first to be
+    //       executed in the order they are declared.
+    Vector<const TestRegistration*> registrations;
+    for (const TestRegistration* registration = TestRegistration::s_first_registration; registration; registration = registration->next)
+    {
+        if (is_selected(*registration, run_benchmarks, run_exhaustive_tests, selected_names))
+            registrations.insert(0, registration);
+    }
+
+    u32 failed_test_count = 0;
+    for (const TestRegistration* registration : registrations)
+    {
+        SE_LOG_INFO("[ RUN  ] {}", StringView::create_from_utf8(registration->name));
+        TestContext test_context;
+
+        const u64 start_tick_counter = Platform::get_current_tick_counter();
+        registration->function(test_context);
+        const u64 elapsed_ticks = Platform::get_current_tick_counter() - start_tick_counter;
+        const u64 elapsed_milliseconds = (elapsed_ticks * 1000) / Platform::get_tick_counter_frequency();
+
+        if (test_context.get_failed_check_count() > 0)
+        {
+            ++failed_test_count;
+            SE_LOG_ERROR(
+                "[ FAIL ] {} ({} of {} checks failed, {} ms)", StringView::create_from_utf8(registration->name), test_context.get_failed_check_count(),
+                test_context.get_check_count(), elapsed_milliseconds
+            );
+        }
+        else
+        {
+            SE_LOG_INFO(
+                "[  OK  ] {} ({} checks, {} ms)", StringView::create_from_utf8(registration->name), test_context.get_check_count(), elapsed_milliseconds
+            );
+        }
+    }
+
+    if (failed_test_count > 0)
+        SE_LOG_ERROR("{} of {} tests failed!", failed_test_count, registrations.count());
+    else
+        SE_LOG_INFO("All {} tests passed.", registrations.count());
+
+    Platform::shutdown();
+    return (failed_test_count > 0) ? 1 : 0;
+}
+
+} // namespace SE
+
+int main(int argument_count, char** arguments)
+{
+    SE::Span<char*> command_line_arguments(arguments + 1, argument_count - 1);
+    SE::i32 return_code = SE::guarded_main(command_line_arguments);
+    return static_cast<int>(return_code);
+}
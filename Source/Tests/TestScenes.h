@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#pragma once
+
+#include <Engine/Scene/Components/SpriteRendererComponent.h>
+#include <Engine/Scene/Components/TransformComponent.h>
+#include <Engine/Scene/Scene.h>
+#include <TestFramework.h>
+
+namespace SE
+{
+
+// Creates the given number of entities in the scene, half of them being sprites.
+inline void generate_test_scene(Scene& scene, u32 entity_count, u64 seed)
+{
+    TestRandomGenerator random_generator = { seed };
+    const auto next_float = [&random_generator]() -> float { return static_cast<float>(random_generator.next() % 20000) * 0.01F - 100.0F; };
+    // The sprites are a few units large, so each of them only overlaps a few cells of the spatial grid of the scene.
+    const auto next_scale = [&random_generator]() -> float { return static_cast<float>(random_generator.next() % 400) * 0.01F + 0.5F; };
+
+    scene.reserve_entities(scene.get_entity_count() + entity_count);
+    for (u32 entity_index = 0; entity_index < entity_count; ++entity_index)
+    {
+        Entity* entity = scene.create_entity_with_uuid(UUID(random_generator.next() | 1));
+        entity->set_name((entity_index % 2) ? "Sprite"sv : "Empty entity with a longer name"sv);
+        entity->add_component<TransformComponent>(
+            Vector3(next_float(), next_float(), next_float()), Vector3(0.0F, 0.0F, next_float()), Vector3(next_scale(), next_scale(), 1.0F)
+        );
+
+        if (entity_index % 2)
+        {
+            SpriteRendererComponent& sprite = entity->add_component<SpriteRendererComponent>(Color4(next_float(), next_float(), next_float(), 1.0F));
+            sprite.set_texture_handle(AssetHandle(UUID(random_generator.next() | 1)));
+        }
+    }
+}
+
+NODISCARD inline bool are_test_vectors_equal(Vector3 lhs, Vector3 rhs)
+{
+    return lhs.x == rhs.x && lhs.y == rhs.y && lhs.z == rhs.z;
+}
+
+//
+// Checks that both scenes contain the same entities, with the same transform and sprite components and field values.
+// The other components are not compared.
+//
+NODISCARD inline bool are_test_scenes_equal(const Scene& lhs, const Scene& rhs)
+{
+    if (lhs.get_entity_count() != rhs.get_entity_count())
+        return false;
+
+    bool are_equal = true;
+    lhs.for_each_entity(
+        [&](const Entity* lhs_entity, UUID entity_uuid) -> IterationDecision
+        {
+            const Entity* rhs_entity = rhs.get_entity_from_uuid(entity_uuid);
+            if (rhs_entity == nullptr || lhs_entity->name() != rhs_entity->name() || !rhs_entity->has_component<TransformComponent>())
+            {
+                are_equal = false;
+                return IterationDecision::Break;
+            }
+
+            const TransformComponent& lhs_transform = lhs_entity->get_component<TransformComponent>();
+            const TransformComponent& rhs_transform = rhs_entity->get_component<TransformComponent>();
+            are_equal = are_test_vectors_equal(lhs_transform.translation(), rhs_transform.translation()) &&
+                        are_test_vectors_equal(lhs_transform.rotation(), rhs_transform.rotation()) &&
+                        are_test_vectors_equal(lhs_transform.scale(), rhs_transform.scale());
+
+            const bool has_sprite = lhs_entity->has_component<SpriteRendererComponent>();
+            are_equal = are_equal && (has_sprite == rhs_entity->has_component<SpriteRendererComponent>());
+            if (are_equal && has_sprite)
+            {
+                const SpriteRendererComponent& lhs_sprite = lhs_entity->get_component<SpriteRendererComponent>();
+                const SpriteRendererComponent& rhs_sprite = rhs_entity->get_component<SpriteRendererComponent>();
+                const Color4 lhs_color = lhs_sprite.sprite_color();
+                const Color4 rhs_color = rhs_sprite.sprite_color();
+                are_equal = lhs_color.r == rhs_color.r && lhs_color.g == rhs_color.g && lhs_color.b == rhs_color.b && lhs_color.a == rhs_color.a &&
+                            lhs_sprite.texture_handle() == rhs_sprite.texture_handle();
+            }
+
+            return are_equal ? IterationDecision::Continue : IterationDecision::Break;
+        }
+    );
+    return are_equal;
+}
+
+} // namespace SE
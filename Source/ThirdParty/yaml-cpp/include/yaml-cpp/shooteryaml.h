@@ -7,6 +7,7 @@
 #include <Core/Math/Vector.h>
 #include <Core/String/Format.h>
 #include <Core/UUID.h>
+#include <streambuf>
 #include <yaml-cpp/yaml.h>
 
 namespace YAML
@@ -59,7 +60,7 @@ struct convert<SE::UUID>
 {
     static Node encode(const SE::UUID& rhs)
     {
-        const SE::Optional<SE::String> uuid_base_16 = SE::format(SE::StringView::create_from_utf8("{}"), rhs);
+        const SE::Optional<SE::String> uuid_base_16 = SE::format(SE::StringView::unsafe_create_from_utf8("{}", 2), rhs);
         Node node;
         node.push_back(uuid_base_16.value());
         return node;
@@ -89,7 +90,7 @@ struct convert<SE::UUID>
 
 ALWAYS_INLINE static YAML::Emitter& operator<<(YAML::Emitter& out, const SE::UUID& value)
 {
-    const SE::Optional<SE::String> uuid_base_16 = SE::format(SE::StringView::create_from_utf8("{}"), value);
+    const SE::Optional<SE::String> uuid_base_16 = SE::format(SE::StringView::unsafe_create_from_utf8("{}", 2), value);
     SE_ASSERT(uuid_base_16.has_value());
     out << uuid_base_16.value();
     return out;
@@ -279,4 +280,41 @@ ALWAYS_INLINE static YAML::Emitter& operator<<(YAML::Emitter& out, const SE::Col
 
 #pragma endregion Color4
 
+#pragma region FormatBuilderStreamBuffer
+
+//
+// Forwards the characters written to a standard stream to a format builder. An emitter that is constructed with a
+// stream using this buffer writes the document directly to the builder (for example, to a `SE::ChunkedOutputBuffer`
+// that streams it to a file), instead of building the whole document in its own contiguous buffer.
+//
+class FormatBuilderStreamBuffer final : public std::streambuf
+{
+public:
+    ALWAYS_INLINE explicit FormatBuilderStreamBuffer(SE::FormatBuilder& builder)
+        : m_builder(builder)
+    {}
+
+protected:
+    virtual int_type overflow(int_type character) override
+    {
+        if (!traits_type::eq_int_type(character, traits_type::eof()))
+        {
+            const char character_to_write = traits_type::to_char_type(character);
+            m_builder.push_characters(&character_to_write, 1);
+        }
+        return traits_type::not_eof(character);
+    }
+
+    virtual std::streamsize xsputn(const char* characters, std::streamsize count) override
+    {
+        m_builder.push_characters(characters, static_cast<SE::usize>(count));
+        return count;
+    }
+
+private:
+    SE::FormatBuilder& m_builder;
+};
+
+#pragma endregion FormatBuilderStreamBuffer
+
 } // namespace YAML
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2024 Traian Avram. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <Core/BinaryLog.h>
+#include <Core/Containers/Span.h>
+#include <Core/FileSystem/FileSystem.h>
+#include <Core/LogSinks.h>
+#include <Core/Platform/Platform.h>
+
+namespace SE
+{
+
+//
+// Converts a binary log file, written by the `BinaryFileLogSink`, to text.
+// Usage: `SE-LogDecoder <binary log filepath> [output filepath]`. If no output file is given, the text is written to the console.
+//
+static i32 guarded_main(Span<char*> command_line_arguments)
+{
+    if (!Platform::initialize())
+        return 1;
+
+    if (command_line_arguments.count() < 1 || command_line_arguments.count() > 2)
+    {
+        SE_LOG_ERROR("Usage: SE-LogDecoder <binary log filepath> [output filepath]");
+        Platform::shutdown();
+        return 1;
+    }
+
+    MemoryMappedFile input_file;
+    if (input_file.open(String::create_from_utf8(command_line_arguments[0])) != FileError::Success)
+    {
+        SE_LOG_ERROR("Failed to open the binary log file '{}'!", StringView::create_from_utf8(command_line_arguments[0]));
+        Platform::shutdown();
+        return 1;
+    }
+
+    bool is_decoded;
+    if (command_line_arguments.count() == 2)
+    {
+        // The output file is never rotated, as it only contains the messages of the binary log file.
+        FileLogSink file_log_sink(String::create_from_utf8(command_line_arguments[1]), ~static_cast<u64>(0), 0);
+        is_decoded = decode_binary_log_file(input_file.bytes(), file_log_sink);
+    }
+    else
+    {
+        ConsoleLogSink console_log_sink;
+        is_decoded = decode_binary_log_file(input_file.bytes(), console_log_sink);
+    }
+
+    input_file.close();
+    Platform::shutdown();
+    return is_decoded ? 0 : 1;
+}
+
+} // namespace SE
+
+int main(int argument_count, char** arguments)
+{
+    SE::Span<char*> command_line_arguments(arguments + 1, argument_count - 1);
+    SE::i32 return_code = SE::guarded_main(command_line_arguments);
+    return static_cast<int>(return_code);
+}